@@ -430,10 +430,13 @@ public:
 
   virtual MCPhysReg getX86R11() const { llvm_unreachable("not implemented"); }
 
-  /// Create increment contents of target by 1 for Instrumentation
+  /// Create increment contents of target by 1 for Instrumentation. When
+  /// \p IsAtomic is false, a plain (non bus-locked) increment is emitted;
+  /// concurrent updates may then lose counts, but the heavily contended
+  /// counters no longer serialize on the cache line.
   virtual void createInstrIncMemory(InstructionListType &Instrs,
                                     const MCSymbol *Target, MCContext *Ctx,
-                                    bool IsLeaf) const {
+                                    bool IsLeaf, bool IsAtomic) const {
     llvm_unreachable("not implemented");
   }
 
@@ -1522,7 +1525,7 @@ public:
 
   /// Create instruction to increment contents of target by 1
   virtual bool createIncMemory(MCInst &Inst, const MCSymbol *Target,
-                               MCContext *Ctx) const {
+                               MCContext *Ctx, bool IsAtomic) const {
     llvm_unreachable("not implemented");
     return false;
   }
@@ -317,6 +317,27 @@ private:
   /// Parse and pre-aggregate branch events.
   std::error_code parseBranchEvents();
 
+  /// Counters produced while parsing branch events, kept separately so they
+  /// can be accumulated across the shard parsers and reported once.
+  struct BranchParseStats {
+    uint64_t NumTotalSamples{0};
+    uint64_t NumEntries{0};
+    uint64_t NumSamples{0};
+    uint64_t NumSamplesNoLBR{0};
+    uint64_t NumTraces{0};
+    bool NeedsSkylakeFix{false};
+  };
+
+  /// Tag for the constructor creating lightweight aggregators that parse one
+  /// shard of the perf script output; such aggregators do not launch perf.
+  struct ShardTag {};
+  DataAggregator(ShardTag, StringRef Filename) : DataReader(Filename) {}
+
+  /// Parse branch events from the current parsing buffer, pre-aggregating
+  /// them into this aggregator's intermediate storage. Used both for the
+  /// serial parse and per shard by the parallel parse in parseBranchEvents().
+  std::error_code parseBranchEventsImpl(BranchParseStats &Stats);
+
   /// Process all branch events.
   void processBranchEvents();
 
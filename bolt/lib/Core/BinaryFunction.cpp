@@ -1947,6 +1947,22 @@ bool BinaryFunction::buildCFG(MCPlusBuilder::AllocatorIdTy AllocatorId) {
     }
   };
 
+  // Fall-through labels are created under the global context lock since
+  // MCContext is not thread-safe. Create them in batches to amortize the lock
+  // acquisitions, which otherwise serialize CFG construction across threads
+  // on binaries with many fall-through blocks. Unused leftover labels are
+  // never referenced and are harmless.
+  SmallVector<MCSymbol *, 0> FTLabels;
+  size_t NextFTLabel = 0;
+  auto createFTLabel = [&]() {
+    if (NextFTLabel == FTLabels.size()) {
+      auto L = BC.scopeLock();
+      for (unsigned I = 0; I != 16; ++I)
+        FTLabels.push_back(BC.Ctx->createNamedTempSymbol("FT"));
+    }
+    return FTLabels[NextFTLabel++];
+  };
+
   // For profiling purposes we need to save the offset of the last instruction
   // in the basic block.
   // NOTE: nops always have an Offset annotation. Annotate the last non-nop as
@@ -2011,11 +2027,7 @@ bool BinaryFunction::buildCFG(MCPlusBuilder::AllocatorIdTy AllocatorId) {
         // Temporarily restore inserter basic block.
         InsertBB = PrevBB;
       } else {
-        MCSymbol *Label;
-        {
-          auto L = BC.scopeLock();
-          Label = BC.Ctx->createNamedTempSymbol("FT");
-        }
+        MCSymbol *Label = createFTLabel();
         InsertBB = addBasicBlockAt(Offset, Label);
         if (opts::PreserveBlocksAlignment && IsLastInstrNop)
           InsertBB->setDerivedAlignment();
@@ -74,6 +74,14 @@ cl::opt<bool>
                       cl::init(false), cl::Optional,
                       cl::cat(BoltInstrCategory));
 
+cl::opt<bool> InstrumentationNoAtomicCounterUpdate(
+    "instrumentation-no-atomic-counter-update",
+    cl::desc("don't use atomic increments for updating counters; concurrent "
+             "updates may lose counts, but heavily contended counters no "
+             "longer ping-pong their cache line between threads "
+             "(default: false)"),
+    cl::init(false), cl::Optional, cl::cat(BoltInstrCategory));
+
 cl::opt<bool> InstrumentCalls("instrument-calls",
                               cl::desc("record profile for inter-function "
                                        "control flow activity (default: true)"),
@@ -177,7 +185,8 @@ Instrumentation::createInstrumentationSnippet(BinaryContext &BC, bool IsLeaf) {
   Label = BC.Ctx->createNamedTempSymbol("InstrEntry");
   Summary->Counters.emplace_back(Label);
   InstructionListType CounterInstrs;
-  BC.MIB->createInstrIncMemory(CounterInstrs, Label, &*BC.Ctx, IsLeaf);
+  BC.MIB->createInstrIncMemory(CounterInstrs, Label, &*BC.Ctx, IsLeaf,
+                               !opts::InstrumentationNoAtomicCounterUpdate);
   return CounterInstrs;
 }
 
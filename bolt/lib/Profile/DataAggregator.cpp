@@ -14,6 +14,7 @@
 #include "bolt/Profile/DataAggregator.h"
 #include "bolt/Core/BinaryContext.h"
 #include "bolt/Core/BinaryFunction.h"
+#include "bolt/Core/ParallelUtilities.h"
 #include "bolt/Profile/BoltAddressTranslation.h"
 #include "bolt/Profile/Heatmap.h"
 #include "bolt/Utils/CommandLineOpts.h"
@@ -27,11 +28,14 @@
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Regex.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #define DEBUG_TYPE "aggregator"
 
@@ -1379,20 +1383,11 @@ std::error_code DataAggregator::printLBRHeatMap() {
   return std::error_code();
 }
 
-std::error_code DataAggregator::parseBranchEvents() {
-  outs() << "PERF2BOLT: parse branch events...\n";
-  NamedRegionTimer T("parseBranch", "Parsing branch events", TimerGroupName,
-                     TimerGroupDesc, opts::TimeAggregator);
-
-  uint64_t NumTotalSamples = 0;
-  uint64_t NumEntries = 0;
-  uint64_t NumSamples = 0;
-  uint64_t NumSamplesNoLBR = 0;
-  uint64_t NumTraces = 0;
+std::error_code DataAggregator::parseBranchEventsImpl(BranchParseStats &Stats) {
   bool NeedsSkylakeFix = false;
 
-  while (hasData() && NumTotalSamples < opts::MaxSamples) {
-    ++NumTotalSamples;
+  while (hasData() && Stats.NumTotalSamples < opts::MaxSamples) {
+    ++Stats.NumTotalSamples;
 
     ErrorOr<PerfBranchSample> SampleRes = parseBranchSample();
     if (std::error_code EC = SampleRes.getError()) {
@@ -1400,21 +1395,21 @@ std::error_code DataAggregator::parseBranchEvents() {
         continue;
       return EC;
     }
-    ++NumSamples;
+    ++Stats.NumSamples;
 
     PerfBranchSample &Sample = SampleRes.get();
     if (opts::WriteAutoFDOData)
       ++BasicSamples[Sample.PC];
 
     if (Sample.LBR.empty()) {
-      ++NumSamplesNoLBR;
+      ++Stats.NumSamplesNoLBR;
       continue;
     }
 
-    NumEntries += Sample.LBR.size();
+    Stats.NumEntries += Sample.LBR.size();
     if (BAT && Sample.LBR.size() == 32 && !NeedsSkylakeFix) {
-      errs() << "PERF2BOLT-WARNING: using Intel Skylake bug workaround\n";
       NeedsSkylakeFix = true;
+      Stats.NeedsSkylakeFix = true;
     }
 
     // LBRs are stored in reverse execution order. NextPC refers to the next
@@ -1474,7 +1469,7 @@ std::error_code DataAggregator::parseBranchEvents() {
             ++NumLongRangeTraces;
           }
         }
-        ++NumTraces;
+        ++Stats.NumTraces;
       }
       NextPC = LBR.From;
 
@@ -1492,6 +1487,98 @@ std::error_code DataAggregator::parseBranchEvents() {
     }
   }
 
+  return std::error_code();
+}
+
+std::error_code DataAggregator::parseBranchEvents() {
+  outs() << "PERF2BOLT: parse branch events...\n";
+  NamedRegionTimer T("parseBranch", "Parsing branch events", TimerGroupName,
+                     TimerGroupDesc, opts::TimeAggregator);
+
+  // Samples are independent of each other once the mmap events are known, and
+  // each sample occupies a single line of perf script output, so a large
+  // buffer can be split at line boundaries and parsed by per-shard
+  // aggregators whose pre-aggregated results are merged below. Sharding is
+  // skipped when a sample limit is in effect to keep -max-samples exact.
+  constexpr size_t MinBytesPerShard = 1 << 20;
+  ThreadPool &Pool = ParallelUtilities::getThreadPool();
+  const size_t NumShards =
+      opts::NoThreads || opts::MaxSamples != -1ULL
+          ? 1
+          : std::min<size_t>(Pool.getThreadCount(),
+                             ParsingBuf.size() / MinBytesPerShard);
+
+  BranchParseStats Stats;
+  if (NumShards <= 1) {
+    if (std::error_code EC = parseBranchEventsImpl(Stats))
+      return EC;
+  } else {
+    std::vector<std::unique_ptr<DataAggregator>> Shards;
+    size_t Begin = 0;
+    for (size_t I = 0; I < NumShards && Begin < ParsingBuf.size(); ++I) {
+      size_t End = I + 1 == NumShards ? ParsingBuf.size()
+                                      : ParsingBuf.size() * (I + 1) / NumShards;
+      End = ParsingBuf.find('\n', End);
+      End = End == StringRef::npos ? ParsingBuf.size() : End + 1;
+
+      auto Shard = std::unique_ptr<DataAggregator>(
+          new DataAggregator(ShardTag(), Filename));
+      Shard->BC = BC;
+      Shard->BAT = BAT;
+      Shard->BinaryMMapInfo = BinaryMMapInfo;
+      Shard->setParsingBuffer(ParsingBuf.slice(Begin, End));
+      Shards.push_back(std::move(Shard));
+      Begin = End;
+    }
+
+    std::vector<BranchParseStats> ShardStats(Shards.size());
+    std::vector<std::error_code> ShardECs(Shards.size());
+    for (size_t I = 0; I < Shards.size(); ++I)
+      Pool.async([&, I]() {
+        ShardECs[I] = Shards[I]->parseBranchEventsImpl(ShardStats[I]);
+      });
+    Pool.wait();
+    ParsingBuf = StringRef();
+
+    for (size_t I = 0; I < Shards.size(); ++I) {
+      if (ShardECs[I])
+        return ShardECs[I];
+
+      DataAggregator &Shard = *Shards[I];
+      for (const auto &LBR : Shard.FallthroughLBRs) {
+        FTInfo &Info = FallthroughLBRs[LBR.first];
+        Info.InternCount += LBR.second.InternCount;
+        Info.ExternCount += LBR.second.ExternCount;
+      }
+      for (const auto &LBR : Shard.BranchLBRs) {
+        BranchInfo &Info = BranchLBRs[LBR.first];
+        Info.TakenCount += LBR.second.TakenCount;
+        Info.MispredCount += LBR.second.MispredCount;
+      }
+      for (const std::pair<const uint64_t, uint64_t> &Sample :
+           Shard.BasicSamples)
+        BasicSamples[Sample.first] += Sample.second;
+      NumInvalidTraces += Shard.NumInvalidTraces;
+      NumLongRangeTraces += Shard.NumLongRangeTraces;
+
+      Stats.NumTotalSamples += ShardStats[I].NumTotalSamples;
+      Stats.NumEntries += ShardStats[I].NumEntries;
+      Stats.NumSamples += ShardStats[I].NumSamples;
+      Stats.NumSamplesNoLBR += ShardStats[I].NumSamplesNoLBR;
+      Stats.NumTraces += ShardStats[I].NumTraces;
+      Stats.NeedsSkylakeFix |= ShardStats[I].NeedsSkylakeFix;
+    }
+  }
+
+  const uint64_t NumTotalSamples = Stats.NumTotalSamples;
+  const uint64_t NumEntries = Stats.NumEntries;
+  const uint64_t NumSamples = Stats.NumSamples;
+  const uint64_t NumSamplesNoLBR = Stats.NumSamplesNoLBR;
+  const uint64_t NumTraces = Stats.NumTraces;
+
+  if (Stats.NeedsSkylakeFix)
+    errs() << "PERF2BOLT-WARNING: using Intel Skylake bug workaround\n";
+
   for (const auto &LBR : BranchLBRs) {
     const Trace &Trace = LBR.first;
     if (BinaryFunction *BF = getBinaryFunctionContainingAddress(Trace.From))
@@ -2476,10 +2476,10 @@ public:
     Inst.addOperand(MCOperand::createImm(Imm));
   }
 
-  bool createIncMemory(MCInst &Inst, const MCSymbol *Target,
-                       MCContext *Ctx) const override {
+  bool createIncMemory(MCInst &Inst, const MCSymbol *Target, MCContext *Ctx,
+                       bool IsAtomic) const override {
 
-    Inst.setOpcode(X86::LOCK_INC64m);
+    Inst.setOpcode(IsAtomic ? X86::LOCK_INC64m : X86::INC64m);
     Inst.clear();
     Inst.addOperand(MCOperand::createReg(X86::RIP));        // BaseReg
     Inst.addOperand(MCOperand::createImm(1));               // ScaleAmt
@@ -3186,7 +3186,8 @@ public:
   }
 
   void createInstrIncMemory(InstructionListType &Instrs, const MCSymbol *Target,
-                            MCContext *Ctx, bool IsLeaf) const override {
+                            MCContext *Ctx, bool IsLeaf,
+                            bool IsAtomic) const override {
     unsigned int I = 0;
 
     Instrs.resize(IsLeaf ? 13 : 11);
@@ -3205,8 +3206,8 @@ public:
     createPushRegister(Instrs[I++], X86::RAX, 8);
     createClearRegWithNoEFlagsUpdate(Instrs[I++], X86::RAX, 8);
     createX86SaveOVFlagToRegister(Instrs[I++], X86::AL);
-    // LOCK INC
-    createIncMemory(Instrs[I++], Target, Ctx);
+    // (LOCK) INC
+    createIncMemory(Instrs[I++], Target, Ctx, IsAtomic);
     // POPF
     createAddRegImm(Instrs[I++], X86::AL, 127, 1);
     createPopRegister(Instrs[I++], X86::RAX, 8);
@@ -40,6 +40,7 @@
 #include "clang/Tooling/ReplacementsYaml.h"
 #include "clang/Tooling/Tooling.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
 #include <algorithm>
 #include <utility>
 
@@ -582,6 +583,45 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
   return DiagConsumer.take();
 }
 
+std::vector<ClangTidyError> runParallelClangTidy(
+    llvm::function_ref<std::unique_ptr<ClangTidyContext>()> CreateContext,
+    const CompilationDatabase &Compilations, ArrayRef<std::string> InputFiles,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS,
+    bool ApplyAnyFix, bool EnableCheckProfile,
+    llvm::StringRef StoreCheckProfile, unsigned Threads,
+    ClangTidyStats &Stats) {
+  std::vector<std::vector<ClangTidyError>> FileErrors(InputFiles.size());
+  std::vector<ClangTidyStats> FileStats(InputFiles.size());
+  {
+    llvm::ThreadPool Pool(llvm::hardware_concurrency(Threads));
+    for (size_t I = 0; I < InputFiles.size(); ++I) {
+      Pool.async([&, I] {
+        std::unique_ptr<ClangTidyContext> Context = CreateContext();
+        assert(Context && "CreateContext must not return null");
+        FileErrors[I] =
+            runClangTidy(*Context, Compilations, InputFiles.slice(I, 1),
+                         BaseFS, ApplyAnyFix, EnableCheckProfile,
+                         StoreCheckProfile);
+        FileStats[I] = Context->getStats();
+      });
+    }
+    Pool.wait();
+  }
+
+  std::vector<ClangTidyError> Errors;
+  for (size_t I = 0; I < InputFiles.size(); ++I) {
+    Errors.insert(Errors.end(), std::make_move_iterator(FileErrors[I].begin()),
+                  std::make_move_iterator(FileErrors[I].end()));
+    Stats += FileStats[I];
+  }
+  // A single-context run reports a diagnostic that several TUs hit in a shared
+  // header only once; do the same for the merged stream. Conflicting (rather
+  // than identical) header fixes from different workers survive this and are
+  // rejected when the replacements are applied.
+  sortAndDeduplicateErrors(Errors);
+  return Errors;
+}
+
 void handleErrors(llvm::ArrayRef<ClangTidyError> Errors,
                   ClangTidyContext &Context, FixBehaviour Fix,
                   unsigned &WarningsAsErrorsCount,
@@ -11,6 +11,7 @@
 
 #include "ClangTidyDiagnosticConsumer.h"
 #include "ClangTidyOptions.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/StringSet.h"
 #include <memory>
 #include <vector>
@@ -91,6 +92,23 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
              bool ApplyAnyFix, bool EnableCheckProfile = false,
              llvm::StringRef StoreCheckProfile = StringRef());
 
+/// Run clang-tidy over \p InputFiles on \p Threads worker threads, one
+/// translation unit per task.
+///
+/// Checks, diagnostic state and option caches are not designed for concurrent
+/// use, so each worker runs with its own context obtained from
+/// \p CreateContext, which must be callable from multiple threads and must not
+/// return null. Diagnostics are merged, deduplicated and returned sorted, as a
+/// single-context run over the same files would produce them; the accumulated
+/// counters of all workers are added to \p Stats.
+std::vector<ClangTidyError> runParallelClangTidy(
+    llvm::function_ref<std::unique_ptr<ClangTidyContext>()> CreateContext,
+    const tooling::CompilationDatabase &Compilations,
+    ArrayRef<std::string> InputFiles,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS,
+    bool ApplyAnyFix, bool EnableCheckProfile, llvm::StringRef StoreCheckProfile,
+    unsigned Threads, ClangTidyStats &Stats);
+
 /// Controls what kind of fixes clang-tidy is allowed to apply.
 enum FixBehaviour {
   /// Don't try to apply any fix.
@@ -722,12 +722,17 @@ struct EqualClangTidyError {
 };
 } // end anonymous namespace
 
-std::vector<ClangTidyError> ClangTidyDiagnosticConsumer::take() {
-  finalizeLastError();
-
+void clang::tidy::sortAndDeduplicateErrors(
+    std::vector<ClangTidyError> &Errors) {
   llvm::stable_sort(Errors, LessClangTidyError());
   Errors.erase(std::unique(Errors.begin(), Errors.end(), EqualClangTidyError()),
                Errors.end());
+}
+
+std::vector<ClangTidyError> ClangTidyDiagnosticConsumer::take() {
+  finalizeLastError();
+
+  sortAndDeduplicateErrors(Errors);
   if (RemoveIncompatibleErrors)
     removeIncompatibleErrors();
   return std::move(Errors);
@@ -262,6 +262,15 @@ option is recognized.
 )"),
                                   cl::init(false), cl::cat(ClangTidyCategory));
 
+static cl::opt<unsigned> ParallelJobs("j", cl::desc(R"(
+Number of translation units to process in
+parallel, each on its own worker thread. 0 means
+one per hardware thread. Has no effect with a
+single input file.
+)"),
+                                      cl::value_desc("jobs"), cl::init(1),
+                                      cl::cat(ClangTidyCategory));
+
 namespace clang {
 namespace tidy {
 
@@ -601,9 +610,20 @@ int clangTidyMain(int argc, const char **argv) {
 
   ClangTidyContext Context(std::move(OwningOptionsProvider),
                            AllowEnablingAnalyzerAlphaCheckers);
+  ClangTidyStats ParallelStats;
+  const bool RunInParallel = ParallelJobs != 1 && PathList.size() > 1;
   std::vector<ClangTidyError> Errors =
-      runClangTidy(Context, OptionsParser->getCompilations(), PathList, BaseFS,
-                   FixNotes, EnableCheckProfile, ProfilePrefix);
+      RunInParallel
+          ? runParallelClangTidy(
+                [&] {
+                  return std::make_unique<ClangTidyContext>(
+                      createOptionsProvider(BaseFS),
+                      AllowEnablingAnalyzerAlphaCheckers);
+                },
+                OptionsParser->getCompilations(), PathList, BaseFS, FixNotes,
+                EnableCheckProfile, ProfilePrefix, ParallelJobs, ParallelStats)
+          : runClangTidy(Context, OptionsParser->getCompilations(), PathList,
+                         BaseFS, FixNotes, EnableCheckProfile, ProfilePrefix);
   bool FoundErrors = llvm::any_of(Errors, [](const ClangTidyError &E) {
     return E.DiagLevel == ClangTidyError::Error;
   });
@@ -631,7 +651,7 @@ int clangTidyMain(int argc, const char **argv) {
   }
 
   if (!Quiet) {
-    printStats(Context.getStats());
+    printStats(RunInParallel ? ParallelStats : Context.getStats());
     if (DisableFixes && Behaviour != FB_NoFix)
       llvm::errs()
           << "Found compiler errors, but -fix-errors was not specified.\n"
@@ -64,6 +64,7 @@
 #include "support/Trace.h"
 #include "clang/Frontend/CompilerInvocation.h"
 #include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/FunctionExtras.h"
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/Optional.h"
@@ -83,6 +84,7 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -1849,5 +1851,59 @@ void TUScheduler::profile(MemoryTree &MT) const {
     MT.child("header_includer_cache").addUsage(HeaderIncluders->getUsedBytes());
   }
 }
+
+namespace {
+/// Allows up to Limit preambles to build concurrently.
+/// When a slot frees up, the request that has waited longest gets it.
+class FIFOPreambleThrottler : public PreambleThrottler {
+public:
+  FIFOPreambleThrottler(unsigned Limit) : Limit(Limit) {
+    assert(Limit > 0 && "no preamble could ever build");
+  }
+
+  RequestID acquire(llvm::StringRef Filename, Callback CB) override {
+    // Callbacks are invoked under the lock: this guarantees none fires after
+    // release() returns, as the interface requires. In exchange, callbacks
+    // must not reenter the throttler (TUScheduler's don't).
+    std::lock_guard<std::mutex> Lock(Mu);
+    RequestID ID = NextID++;
+    if (Active.size() < Limit) {
+      Active.insert(ID);
+      CB();
+    } else {
+      Queue.emplace_back(ID, std::move(CB));
+    }
+    return ID;
+  }
+
+  void release(RequestID ID) override {
+    std::lock_guard<std::mutex> Lock(Mu);
+    if (!Active.erase(ID)) {
+      // Abandoning a queued request frees no slot.
+      llvm::erase_if(Queue, [ID](const auto &Req) { return Req.first == ID; });
+      return;
+    }
+    if (!Queue.empty()) {
+      auto Next = std::move(Queue.front());
+      Queue.pop_front();
+      Active.insert(Next.first);
+      Next.second();
+    }
+  }
+
+private:
+  const unsigned Limit;
+  std::mutex Mu;
+  RequestID NextID = 0;
+  /// Requests whose callback has run but which are not yet released.
+  llvm::DenseSet<RequestID> Active;
+  /// Unsatisfied requests, oldest first.
+  std::deque<std::pair<RequestID, Callback>> Queue;
+};
+} // namespace
+
+std::unique_ptr<PreambleThrottler> createFIFOPreambleThrottler(unsigned Limit) {
+  return std::make_unique<FIFOPreambleThrottler>(Limit);
+}
 } // namespace clangd
 } // namespace clang
@@ -22,6 +22,7 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include <chrono>
+#include <memory>
 #include <string>
 
 namespace clang {
@@ -115,6 +116,12 @@ public:
   //        this would allow the throttler to make better scheduling decisions.
 };
 
+/// Returns a PreambleThrottler allowing up to \p Limit preambles to build at
+/// once in this process, satisfying waiting requests in FIFO order.
+/// Preamble builds are CPU- and memory-hungry; capping them below the worker
+/// thread count keeps clangd responsive while many files rebuild at once.
+std::unique_ptr<PreambleThrottler> createFIFOPreambleThrottler(unsigned Limit);
+
 enum class PreambleAction {
   Queued,
   Building,
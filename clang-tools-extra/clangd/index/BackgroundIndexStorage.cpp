@@ -52,7 +52,8 @@ public:
   loadShard(llvm::StringRef ShardIdentifier) const override {
     const std::string ShardPath =
         getShardPathFromFilePath(DiskShardRoot, ShardIdentifier);
-    auto Buffer = llvm::MemoryBuffer::getFile(ShardPath);
+    auto Buffer = llvm::MemoryBuffer::getFile(ShardPath, /*IsText=*/false,
+                                              /*RequiresNullTerminator=*/false);
     if (!Buffer)
       return nullptr;
     if (auto I =
@@ -505,12 +505,26 @@ llvm::Expected<IndexFileIn> readRIFF(llvm::StringRef Data,
 
   if (Chunks.count("symb")) {
     Reader SymbolReader(Chunks.lookup("symb"));
-    SymbolSlab::Builder Symbols;
+    std::vector<Symbol> Symbols;
     while (!SymbolReader.eof())
-      Symbols.insert(readSymbol(SymbolReader, Strings->Strings, Origin));
+      Symbols.push_back(readSymbol(SymbolReader, Strings->Strings, Origin));
     if (SymbolReader.err())
       return error("malformed or truncated symbol");
-    Result.Symbols = std::move(Symbols).build();
+    llvm::stable_sort(Symbols, [](const Symbol &L, const Symbol &R) {
+      return L.ID < R.ID;
+    });
+    // A valid file has no duplicate IDs; if one does, keep the last occurrence
+    // of each, as SymbolSlab::Builder::insert() would have.
+    auto FirstKept = std::unique(
+        Symbols.rbegin(), Symbols.rend(),
+        [](const Symbol &L, const Symbol &R) { return L.ID == R.ID; });
+    Symbols.erase(Symbols.begin(), FirstKept.base());
+    // The symbols' strings point into the string table, so hand its arena to
+    // the slab rather than re-interning every string through a Builder.
+    // (Moving the arena doesn't invalidate Strings->Strings; later sections
+    // still read from it and copy whatever they keep.)
+    Result.Symbols =
+        SymbolSlab::adopt(std::move(Strings->Arena), std::move(Symbols));
   }
   if (Chunks.count("refs")) {
     Reader RefsReader(Chunks.lookup("refs"));
@@ -704,7 +718,10 @@ llvm::Expected<IndexFileIn> readIndexFile(llvm::StringRef Data,
 std::unique_ptr<SymbolIndex> loadIndex(llvm::StringRef SymbolFilename,
                                        SymbolOrigin Origin, bool UseDex) {
   trace::Span OverallTracer("LoadIndex");
-  auto Buffer = llvm::MemoryBuffer::getFile(SymbolFilename);
+  // The reader is bounds-checked and doesn't need a null terminator; waiving
+  // it lets large index files be memory-mapped rather than copied.
+  auto Buffer = llvm::MemoryBuffer::getFile(SymbolFilename, /*IsText=*/false,
+                                            /*RequiresNullTerminator=*/false);
   if (!Buffer) {
     elog("Can't open {0}: {1}", SymbolFilename, Buffer.getError().message());
     return nullptr;
@@ -13,6 +13,7 @@
 #include "index/SymbolLocation.h"
 #include "index/SymbolOrigin.h"
 #include "clang/Index/IndexSymbol.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/StringSaver.h"
 
@@ -182,6 +183,18 @@ public:
 
   SymbolSlab() = default;
 
+  /// Adopts pre-built symbol data without copying it.
+  /// Symbols must be sorted by ID with no duplicates, and their backing
+  /// strings must be null-terminated and owned by Arena.
+  /// Deserialization uses this to share one string arena with the file's
+  /// string table; most callers should use Builder instead.
+  static SymbolSlab adopt(llvm::BumpPtrAllocator Arena,
+                          std::vector<Symbol> Symbols) {
+    assert(llvm::is_sorted(
+        Symbols, [](const Symbol &L, const Symbol &R) { return L.ID < R.ID; }));
+    return SymbolSlab(std::move(Arena), std::move(Symbols));
+  }
+
   const_iterator begin() const { return Symbols.begin(); }
   const_iterator end() const { return Symbols.end(); }
   const_iterator find(const SymbolID &SymID) const;
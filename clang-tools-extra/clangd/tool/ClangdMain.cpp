@@ -343,6 +343,16 @@ opt<unsigned> WorkerThreadsCount{
     init(getDefaultAsyncThreadsCount()),
 };
 
+opt<unsigned> LimitPreambleBuilds{
+    "limit-preamble-builds",
+    cat(Misc),
+    desc("Limit the number of preambles built in parallel. Preamble builds "
+         "are CPU- and memory-intensive; a limit below the worker count (-j) "
+         "keeps clangd responsive while many files rebuild. "
+         "0 means no limit (default=0)"),
+    init(0),
+};
+
 opt<Path> IndexFile{
     "index-file",
     cat(Misc),
@@ -898,6 +908,11 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
   }
   Opts.AsyncThreadsCount = WorkerThreadsCount;
   Opts.MemoryCleanup = getMemoryCleanupFunction();
+  std::unique_ptr<PreambleThrottler> Throttler;
+  if (LimitPreambleBuilds != 0) {
+    Throttler = createFIFOPreambleThrottler(LimitPreambleBuilds);
+    Opts.PreambleThrottler = Throttler.get();
+  }
 
   Opts.CodeComplete.IncludeIneligibleResults = IncludeIneligibleResults;
   Opts.CodeComplete.Limit = LimitResults;
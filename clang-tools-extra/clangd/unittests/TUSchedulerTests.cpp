@@ -1526,6 +1526,23 @@ TEST_F(TUSchedulerTests, PreambleThrottle) {
   EXPECT_THAT(Throttler.Releases, UnorderedElementsAre(1, 0));
 }
 
+TEST_F(TUSchedulerTests, FIFOPreambleThrottler) {
+  auto Throttler = createFIFOPreambleThrottler(/*Limit=*/1);
+  std::vector<unsigned> Satisfied;
+  auto A = Throttler->acquire("a.cc", [&] { Satisfied.push_back(0); });
+  auto B = Throttler->acquire("b.cc", [&] { Satisfied.push_back(1); });
+  auto C = Throttler->acquire("c.cc", [&] { Satisfied.push_back(2); });
+  // Only the first request fits under the limit.
+  EXPECT_THAT(Satisfied, ElementsAre(0));
+  // Abandoning a queued request frees no slot.
+  Throttler->release(B);
+  EXPECT_THAT(Satisfied, ElementsAre(0));
+  // Releasing the active request promotes the oldest waiter.
+  Throttler->release(A);
+  EXPECT_THAT(Satisfied, ElementsAre(0, 2));
+  Throttler->release(C);
+}
+
 } // namespace
 } // namespace clangd
 } // namespace clang
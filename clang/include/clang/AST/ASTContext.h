@@ -53,6 +53,7 @@
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/PointerIntPair.h"
 #include "llvm/ADT/PointerUnion.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
@@ -626,11 +627,21 @@ private:
   /// to decide which entities should be instrumented.
   std::unique_ptr<ProfileList> ProfList;
 
+  /// The arena backing AST allocation.  When arena recycling is enabled (see
+  /// setArenaRecycling()), the slabs are returned to a bounded process-wide
+  /// pool on destruction and reused by later contexts instead of going back
+  /// to the OS.
+  class RecyclableArena : public llvm::BumpPtrAllocator {
+  public:
+    RecyclableArena();
+    ~RecyclableArena();
+  };
+
   /// The allocator used to create AST objects.
   ///
   /// AST objects are never destructed; rather, all memory associated with the
   /// AST objects will be released when the ASTContext itself is destroyed.
-  mutable llvm::BumpPtrAllocator BumpAlloc;
+  mutable RecyclableArena BumpAlloc;
 
   /// Allocator for partial diagnostics.
   PartialDiagnostic::DiagStorageAllocator DiagAllocator;
@@ -762,6 +773,26 @@ public:
     return BumpAlloc.getTotalMemory();
   }
 
+  /// Control whether the arenas backing AST allocation are recycled through a
+  /// bounded process-wide pool instead of being freed when a context is
+  /// destroyed.  Intended for long-running tools that build and tear down
+  /// many ASTContexts (e.g. indexers), where repopulating an already-sized
+  /// arena is much cheaper than growing a fresh one from scratch.  Must not
+  /// be flipped while contexts created under the other setting are alive.
+  static void setArenaRecycling(bool Enable);
+
+  /// Whether AST arena recycling is enabled; see setArenaRecycling().
+  static bool isArenaRecyclingEnabled();
+
+  /// Invoke \p Visitor for each type class with at least one node in this
+  /// context, passing the class name, the node count, and the bytes those
+  /// nodes occupy.  This gives tools a structured way to track AST memory per
+  /// node kind without parsing PrintStats() output.
+  void visitTypeAllocationStats(
+      llvm::function_ref<void(StringRef KindName, unsigned Count,
+                              size_t Bytes)>
+          Visitor) const;
+
   /// Return the total memory used for various side tables.
   size_t getSideTableAllocatedMemory() const;
 
@@ -20,6 +20,8 @@
 #include "clang/Basic/TokenKinds.h"
 #include "llvm/ADT/DenseMapInfo.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Allocator.h"
@@ -553,6 +555,26 @@ class IdentifierTable {
 
   IdentifierInfoLookup* ExternalLookup;
 
+  /// Identifiers partitioned by spelling length, built on first use by
+  /// forEachIdentifierWithLength() and kept up to date by get()/getOwn().
+  /// Bucket I holds the identifiers of length I + 1; the last bucket also
+  /// holds everything longer. Empty until typo correction first asks for it,
+  /// so the lexing fast path normally pays nothing.
+  llvm::SmallVector<llvm::SmallVector<const IdentifierInfo *, 0>, 0>
+      LengthBuckets;
+
+  enum : unsigned { NumLengthBuckets = 64 };
+
+  static unsigned getLengthBucket(size_t Length) {
+    assert(Length > 0 && "Expected a non-empty identifier");
+    return std::min(Length, (size_t)NumLengthBuckets) - 1;
+  }
+
+  void addToLengthBucket(StringRef Name, const IdentifierInfo *II) {
+    if (LLVM_UNLIKELY(!LengthBuckets.empty()))
+      LengthBuckets[getLengthBucket(Name.size())].push_back(II);
+  }
+
 public:
   /// Create the identifier table.
   explicit IdentifierTable(IdentifierInfoLookup *ExternalLookup = nullptr);
@@ -587,8 +609,10 @@ public:
     // No entry; if we have an external lookup, look there first.
     if (ExternalLookup) {
       II = ExternalLookup->get(Name);
-      if (II)
+      if (II) {
+        addToLengthBucket(Name, II);
         return *II;
+      }
     }
 
     // Lookups failed, make a new IdentifierInfo.
@@ -599,6 +623,7 @@ public:
     // contents.
     II->Entry = &Entry;
 
+    addToLengthBucket(Name, II);
     return *II;
   }
 
@@ -634,6 +659,7 @@ public:
     if (Name.equals("import"))
       II->setModulesImport(true);
 
+    addToLengthBucket(Name, II);
     return *II;
   }
 
@@ -646,6 +672,19 @@ public:
 
   iterator find(StringRef Name) const { return HashTable.find(Name); }
 
+  /// Visit the identifiers in the table whose spelling length is between
+  /// \p MinLength and \p MaxLength (both inclusive), skipping the rest.
+  ///
+  /// The first call partitions the table by length; get() keeps the
+  /// partition up to date afterwards. Typo correction uses this to prune
+  /// candidates its edit-distance cutoff would reject anyway, instead of
+  /// scanning every identifier ever lexed. Lengths past the last bucket are
+  /// not distinguished, so callers may be shown identifiers slightly outside
+  /// the requested range and must re-check.
+  void forEachIdentifierWithLength(
+      unsigned MinLength, unsigned MaxLength,
+      llvm::function_ref<void(const IdentifierInfo &)> Visit);
+
   /// Print some statistics to stderr that indicate how well the
   /// hashing is doing.
   void PrintStats() const;
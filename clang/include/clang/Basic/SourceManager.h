@@ -721,6 +721,18 @@ class SourceManager : public RefCountedBase<SourceManager> {
   /// is very common to look up many tokens from the same file.
   mutable FileID LastFileIDLookup;
 
+  /// The amount of SLoc address space covered by each page of
+  /// LocalPageTable.
+  static constexpr unsigned SLocPageShift = 12;
+
+  /// Page table over the local SLoc address space: element P is the index of
+  /// the local SLocEntry containing offset P << SLocPageShift. Since the
+  /// local table is append-only, the entry containing a given offset never
+  /// changes, so the page table is extended lazily by getFileIDLocal() and
+  /// never invalidated. It bounds the search for any offset to the entries
+  /// of a single page.
+  mutable SmallVector<unsigned, 0> LocalPageTable;
+
   /// Holds information for \#line directives.
   ///
   /// This is referenced by indices from SLocEntryTable.
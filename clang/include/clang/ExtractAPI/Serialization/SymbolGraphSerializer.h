@@ -159,6 +159,16 @@ private:
   /// Serialize a typedef record.
   void serializeTypedefRecord(const TypedefRecord &Record);
 
+  /// Serialize all top-level records of the API set that fall into this
+  /// serializer's shard, in their fixed category order.
+  void serializeRecords();
+
+  /// The slice of top-level records this serializer formats. serialize()
+  /// shards large API sets across worker serializers by giving each one a
+  /// contiguous [ShardBegin, ShardEnd) range; the default covers everything.
+  size_t ShardBegin = 0;
+  size_t ShardEnd = ~size_t(0);
+
   /// Push a component to the current path components stack.
   ///
   /// \param Component The component to push onto the path components stack.
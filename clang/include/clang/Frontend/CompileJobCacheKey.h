@@ -34,6 +34,13 @@ llvm::Optional<llvm::cas::CASID>
 createCompileJobCacheKey(llvm::cas::ObjectStore &CAS, DiagnosticsEngine &Diags,
                          const CompilerInvocation &Invocation);
 
+/// Create a cache key for the predefines buffer of the given \c
+/// CompilerInvocation as a \c CASID. Unlike \c createCompileJobCacheKey this
+/// does not include a filesystem root: the predefines buffer is derived
+/// purely from the invocation's options (and the clang version).
+llvm::cas::CASID createPredefinesCacheKey(llvm::cas::ObjectStore &CAS,
+                                          const CompilerInvocation &Invocation);
+
 /// Print the structure of the cache key given by \p Key to \p OS. Returns an
 /// error if the key object does not exist in \p CAS, or is malformed.
 llvm::Error printCompileJobCacheKey(llvm::cas::ObjectStore &CAS,
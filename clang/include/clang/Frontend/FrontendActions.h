@@ -84,10 +84,17 @@ protected:
 };
 
 class GeneratePCHAction : public ASTFrontendAction {
+  /// When the PCH is streamed to disk as it is produced, the path of the
+  /// output file; empty when the output goes through the CompilerInstance's
+  /// buffered output machinery instead.
+  std::string StreamedOutputFile;
+
 protected:
   std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &CI,
                                                  StringRef InFile) override;
 
+  void EndSourceFileAction() override;
+
   TranslationUnitKind getTranslationUnitKind() override {
     return TU_Prefix;
   }
@@ -534,6 +534,11 @@ public:
   /// Path which stores the output files for -ftime-trace
   std::string TimeTracePath;
 
+  /// Sampling interval (in microseconds) for the time profiler's sampling
+  /// mode; collapsed stacks are written instead of a JSON trace. Zero (the
+  /// default) records a full trace.
+  unsigned TimeTraceSampleInterval;
+
 public:
   FrontendOptions()
       : DisableFree(false), RelocatablePCH(false), ShowHelp(false),
@@ -546,7 +551,7 @@ public:
         BuildingImplicitModuleUsesLock(true), ModulesEmbedAllFiles(false),
         IncludeTimestamps(true), UseTemporary(true), CacheCompileJob(false),
         AllowPCMWithCompilerErrors(false), ModulesShareFileManager(true),
-        TimeTraceGranularity(500) {}
+        TimeTraceGranularity(500), TimeTraceSampleInterval(0) {}
 
   /// getInputKindForExtension - Return the appropriate input kind for a file
   /// extension. For example, "c" would return Language::C.
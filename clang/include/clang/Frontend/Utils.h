@@ -32,6 +32,13 @@
 #include <utility>
 #include <vector>
 
+namespace llvm {
+namespace cas {
+class ActionCache;
+class ObjectStore;
+} // namespace cas
+} // namespace llvm
+
 namespace clang {
 
 class ASTReader;
@@ -52,6 +59,19 @@ void InitializePreprocessor(Preprocessor &PP, const PreprocessorOptions &PPOpts,
                             const PCHContainerReader &PCHContainerRdr,
                             const FrontendOptions &FEOpts);
 
+/// Variant of \c InitializePreprocessor that caches the predefines buffer in
+/// \p CAS, keyed by the -cc1 invocation (see \c createPredefinesCacheKey). On
+/// a cache hit the stored buffer is installed directly and none of the
+/// predefined-macro construction runs; on a miss the freshly built buffer is
+/// stored back into the cache. Any CAS failure falls back to building the
+/// buffer normally. Note that diagnostics emitted while building the buffer
+/// (e.g. for malformed -D arguments) are not replayed on a cache hit.
+void InitializePreprocessorWithCachedPredefines(
+    Preprocessor &PP, const PreprocessorOptions &PPOpts,
+    const PCHContainerReader &PCHContainerRdr, const FrontendOptions &FEOpts,
+    const CompilerInvocation &Invocation, llvm::cas::ObjectStore &CAS,
+    llvm::cas::ActionCache &Cache);
+
 /// DoPrintPreprocessedInput - Implement -E mode.
 void DoPrintPreprocessedInput(Preprocessor &PP, raw_ostream *OS,
                               const PreprocessorOutputOptions &Opts);
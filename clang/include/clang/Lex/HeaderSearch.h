@@ -308,6 +308,15 @@ class HeaderSearch {
   /// The mapping between modules and headers.
   mutable ModuleMap ModMap;
 
+  /// Cached top-level listings of normal search directories, used by
+  /// LookupFile to skip directories that cannot contain the requested file.
+  /// Names are stored lower-cased so the probe stays conservative on
+  /// case-folding file systems; a null entry means the directory could not be
+  /// listed (or holds names simple case folding cannot compare) and must
+  /// always be probed.
+  llvm::DenseMap<const DirectoryEntry *, std::unique_ptr<llvm::StringSet<>>>
+      DirectoryFilters;
+
   /// Describes whether a given directory has a module map in it.
   llvm::DenseMap<const DirectoryEntry *, bool> DirectoryHasModuleMap;
 
@@ -773,6 +782,12 @@ private:
   /// search path at index `HitIdx`.
   void noteLookupUsage(unsigned HitIdx, SourceLocation IncludeLoc);
 
+  /// Return the name filter for the normal search directory \p Dir, building
+  /// it from the directory listing on first use. Returns null when filtering
+  /// is disabled for this directory; a miss in a non-null filter guarantees
+  /// the directory cannot satisfy the lookup.
+  const llvm::StringSet<> *getOrBuildDirectoryFilter(const DirectoryEntry *Dir);
+
 public:
   /// Retrieve the module map.
   ModuleMap &getModuleMap() { return ModMap; }
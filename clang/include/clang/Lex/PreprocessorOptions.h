@@ -72,6 +72,10 @@ public:
   /// predefines.
   bool UsePredefines = true;
 
+  /// Cache the predefines buffer in the configured CAS, keyed by the -cc1
+  /// invocation, and reuse it on later invocations instead of rebuilding it.
+  bool CachePredefines = false;
+
   /// Whether we should maintain a detailed record of all macro
   /// definitions and expansions.
   bool DetailedRecord = false;
@@ -12,7 +12,9 @@
 #include "clang/Basic/LLVM.h"
 #include "clang/Rewrite/Core/DeltaTree.h"
 #include "clang/Rewrite/Core/RewriteRope.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
+#include <string>
 
 namespace clang {
 
@@ -88,6 +90,26 @@ public:
   void ReplaceText(unsigned OrigOffset, unsigned OrigLength,
                    StringRef NewStr);
 
+  /// BatchEdit - One pending edit for ApplyEdits.  Offsets are relative to the
+  /// original SourceBuffer, like the incremental methods above.  An edit with
+  /// OrigLength == 0 is an insertion (equivalent to InsertTextAfter), one with
+  /// empty Text is a removal, anything else is a replacement.
+  struct BatchEdit {
+    unsigned OrigOffset;
+    unsigned OrigLength;
+    std::string Text;
+  };
+
+  /// ApplyEdits - Apply all of \p Edits to the buffer in a single merge pass.
+  /// This is equivalent to issuing the edits one by one through the methods
+  /// above, but avoids the per-edit rope splitting and rebalancing, which
+  /// dominates when a tool applies very large numbers of edits to one buffer.
+  /// Edits may be given in any order; edits at the same position are applied
+  /// in the order provided.  Returns true if the edits could not be applied
+  /// (an edit is out of range or two edits overlap); the buffer is left
+  /// unchanged in that case.
+  bool ApplyEdits(ArrayRef<BatchEdit> Edits);
+
 private:
   /// getMappedOffset - Given an offset into the original SourceBuffer that this
   /// RewriteBuffer is based on, map it into the offset space of the
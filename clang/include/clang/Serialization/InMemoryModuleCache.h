@@ -9,6 +9,7 @@
 #ifndef LLVM_CLANG_SERIALIZATION_INMEMORYMODULECACHE_H
 #define LLVM_CLANG_SERIALIZATION_INMEMORYMODULECACHE_H
 
+#include "clang/Basic/Module.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
@@ -36,6 +37,11 @@ class InMemoryModuleCache : public llvm::RefCountedBase<InMemoryModuleCache> {
     /// cache).
     bool IsFinal = false;
 
+    /// The AST file signature scanned out of this buffer's control block, if
+    /// a reader has extracted it already.  Dropped whenever the buffer
+    /// changes.
+    ASTFileSignature Signature;
+
     PCM() = default;
     PCM(std::unique_ptr<llvm::MemoryBuffer> Buffer)
         : Buffer(std::move(Buffer)) {}
@@ -91,6 +97,18 @@ public:
   /// Get a pointer to the pCM if it exists; else nullptr.
   llvm::MemoryBuffer *lookupPCM(llvm::StringRef Filename) const;
 
+  /// Record the AST file signature a reader scanned out of the PCM's control
+  /// block, so that later readers of the same buffer can skip the scan.
+  ///
+  /// \pre state is Tentative or Final.
+  void setPCMSignature(llvm::StringRef Filename, ASTFileSignature Signature);
+
+  /// Get the signature previously recorded for the PCM's current buffer, if
+  /// any.  Returns None if no (valid) signature has been recorded or if the
+  /// buffer has changed since it was.
+  llvm::Optional<ASTFileSignature>
+  lookupPCMSignature(llvm::StringRef Filename) const;
+
   /// Check whether the PCM is final and has been shown to work.
   ///
   /// \return true iff state is Final.
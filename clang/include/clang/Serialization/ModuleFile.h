@@ -305,6 +305,14 @@ public:
   /// IdentifierHashTable.
   void *IdentifierLookupTable = nullptr;
 
+  /// A Bloom filter over the identifier hashes stored in
+  /// IdentifierLookupTable, built lazily on the first identifier lookup into
+  /// this module. Lookups of identifiers this module provably does not
+  /// provide then skip the on-disk hash table entirely, which matters when
+  /// many modules are loaded and most per-module probes are misses. Empty
+  /// until built.
+  llvm::BitVector IdentifierLookupFilter;
+
   /// Offsets of identifiers that we're going to preload within
   /// IdentifierTableData.
   std::vector<unsigned> PreloadIdentifierOffsets;
@@ -57,29 +57,42 @@ class FunctionSummariesTy {
   using MapTy = llvm::DenseMap<const Decl *, FunctionSummary>;
   MapTy Map;
 
-public:
-  MapTy::iterator findOrInsertSummary(const Decl *D) {
-    MapTy::iterator I = Map.find(D);
-    if (I != Map.end())
-      return I;
-
-    using KVPair = std::pair<const Decl *, FunctionSummary>;
+  /// One-entry cache over \c Map. The worklist engine queries the summary of
+  /// the function it is currently exploring on every block edge and call
+  /// evaluation, so lookups arrive in long runs keyed by the same Decl.
+  const Decl *CachedDecl = nullptr;
+  FunctionSummary *CachedSummary = nullptr;
+
+  FunctionSummary &findOrInsertSummary(const Decl *D) {
+    if (D == CachedDecl)
+      return *CachedSummary;
+
+    // Rehashing on insertion may move existing entries, so the cache is only
+    // valid when refreshed after every map access.
+    FunctionSummary &Summary = Map[D];
+    CachedDecl = D;
+    CachedSummary = &Summary;
+    return Summary;
+  }
 
-    I = Map.insert(KVPair(D, FunctionSummary())).first;
-    assert(I != Map.end());
-    return I;
+  const FunctionSummary *findSummary(const Decl *D) const {
+    if (D == CachedDecl)
+      return CachedSummary;
+    MapTy::const_iterator I = Map.find(D);
+    return I == Map.end() ? nullptr : &I->second;
   }
 
+public:
   void markMayInline(const Decl *D) {
-    MapTy::iterator I = findOrInsertSummary(D);
-    I->second.InlineChecked = 1;
-    I->second.MayInline = 1;
+    FunctionSummary &Summary = findOrInsertSummary(D);
+    Summary.InlineChecked = 1;
+    Summary.MayInline = 1;
   }
 
   void markShouldNotInline(const Decl *D) {
-    MapTy::iterator I = findOrInsertSummary(D);
-    I->second.InlineChecked = 1;
-    I->second.MayInline = 0;
+    FunctionSummary &Summary = findOrInsertSummary(D);
+    Summary.InlineChecked = 1;
+    Summary.MayInline = 0;
   }
 
   void markReachedMaxBlockCount(const Decl *D) {
@@ -87,48 +100,44 @@ public:
   }
 
   Optional<bool> mayInline(const Decl *D) {
-    MapTy::const_iterator I = Map.find(D);
-    if (I != Map.end() && I->second.InlineChecked)
-      return I->second.MayInline;
+    if (const FunctionSummary *Summary = findSummary(D))
+      if (Summary->InlineChecked)
+        return Summary->MayInline;
     return None;
   }
 
   void markVisitedBasicBlock(unsigned ID, const Decl* D, unsigned TotalIDs) {
-    MapTy::iterator I = findOrInsertSummary(D);
-    llvm::SmallBitVector &Blocks = I->second.VisitedBasicBlocks;
+    FunctionSummary &Summary = findOrInsertSummary(D);
+    llvm::SmallBitVector &Blocks = Summary.VisitedBasicBlocks;
     assert(ID < TotalIDs);
     if (TotalIDs > Blocks.size()) {
       Blocks.resize(TotalIDs);
-      I->second.TotalBasicBlocks = TotalIDs;
+      Summary.TotalBasicBlocks = TotalIDs;
     }
     Blocks.set(ID);
   }
 
   unsigned getNumVisitedBasicBlocks(const Decl* D) {
-    MapTy::const_iterator I = Map.find(D);
-    if (I != Map.end())
-      return I->second.VisitedBasicBlocks.count();
+    if (const FunctionSummary *Summary = findSummary(D))
+      return Summary->VisitedBasicBlocks.count();
     return 0;
   }
 
   unsigned getNumTimesInlined(const Decl* D) {
-    MapTy::const_iterator I = Map.find(D);
-    if (I != Map.end())
-      return I->second.TimesInlined;
+    if (const FunctionSummary *Summary = findSummary(D))
+      return Summary->TimesInlined;
     return 0;
   }
 
   void bumpNumTimesInlined(const Decl* D) {
-    MapTy::iterator I = findOrInsertSummary(D);
-    I->second.TimesInlined++;
+    findOrInsertSummary(D).TimesInlined++;
   }
 
   /// Get the percentage of the reachable blocks.
   unsigned getPercentBlocksReachable(const Decl *D) {
-    MapTy::const_iterator I = Map.find(D);
-      if (I != Map.end())
-        return ((I->second.VisitedBasicBlocks.count() * 100) /
-                 I->second.TotalBasicBlocks);
+    if (const FunctionSummary *Summary = findSummary(D))
+      return (Summary->VisitedBasicBlocks.count() * 100) /
+             Summary->TotalBasicBlocks;
     return 0;
   }
 
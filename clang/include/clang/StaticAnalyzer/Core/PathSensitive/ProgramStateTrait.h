@@ -16,6 +16,7 @@
 #ifndef LLVM_CLANG_STATICANALYZER_CORE_PATHSENSITIVE_PROGRAMSTATETRAIT_H
 #define LLVM_CLANG_STATICANALYZER_CORE_PATHSENSITIVE_PROGRAMSTATETRAIT_H
 
+#include "llvm/ADT/ImmutableHashedMap.h"
 #include "llvm/ADT/ImmutableList.h"
 #include "llvm/ADT/ImmutableMap.h"
 #include "llvm/ADT/ImmutableSet.h"
@@ -96,6 +97,25 @@ template <typename T, typename Enable = void> struct ProgramStatePartialTrait;
     using Name = llvm::ImmutableMap<Key, Value>; \
     REGISTER_FACTORY_WITH_PROGRAMSTATE(Name)
 
+  /// Helper for registering a hashed map trait; see
+  /// CLANG_ENTO_PROGRAMSTATE_MAP for why the map type cannot be spelled
+  /// directly in the registration macro.
+  #define CLANG_ENTO_PROGRAMSTATE_HASHED_MAP(Key, Value) \
+    llvm::ImmutableHashedMap<Key, Value>
+
+  /// Declares an immutable map of type \p NameTy, implemented using
+  /// llvm::ImmutableHashedMap. The interface in \c ProgramState is the same
+  /// as for REGISTER_MAP_WITH_PROGRAMSTATE; the trade-off is that updates
+  /// path-copy hash-trie nodes instead of rebalancing an ordered tree, which
+  /// favors traits with many bindings and frequent updates but gives up key
+  /// order (iteration is deterministic but unordered).
+  ///
+  /// The macro should not be used inside namespaces, or for traits that must
+  /// be accessible from more than one translation unit.
+  #define REGISTER_HASHED_MAP_WITH_PROGRAMSTATE(Name, Key, Value) \
+    REGISTER_TRAIT_WITH_PROGRAMSTATE( \
+        Name, CLANG_ENTO_PROGRAMSTATE_HASHED_MAP(Key, Value))
+
 
   /// Declares an immutable set of type \p NameTy, suitable for placement into
   /// the ProgramState. This is implementing using llvm::ImmutableSet.
@@ -192,6 +212,56 @@ template <typename T, typename Enable = void> struct ProgramStatePartialTrait;
     }
   };
 
+  // Partial-specialization for ImmutableHashedMap.
+  template <typename Key, typename Data, typename Info>
+  struct ProgramStatePartialTrait<llvm::ImmutableHashedMap<Key, Data, Info>> {
+    using data_type = llvm::ImmutableHashedMap<Key, Data, Info>;
+    using context_type = typename data_type::Factory &;
+    using key_type = Key;
+    using value_type = Data;
+    using lookup_type = const value_type *;
+
+    static data_type MakeData(void *const *p) {
+      return p ? data_type((const typename data_type::NodeTy *) *p)
+               : data_type(nullptr);
+    }
+
+    static void *MakeVoidPtr(data_type B) {
+      // Nodes are uniqued and owned by the factory, so the root needs no
+      // retain to stay live in the GDM.
+      return const_cast<typename data_type::NodeTy *>(B.getRoot());
+    }
+
+    static lookup_type Lookup(data_type B, key_type K) {
+      return B.lookup(K);
+    }
+
+    static data_type Set(data_type B, key_type K, value_type E,
+                         context_type F) {
+      return F.add(B, K, E);
+    }
+
+    static data_type Remove(data_type B, key_type K, context_type F) {
+      return F.remove(B, K);
+    }
+
+    static bool Contains(data_type B, key_type K) {
+      return B.contains(K);
+    }
+
+    static context_type MakeContext(void *p) {
+      return *((typename data_type::Factory *) p);
+    }
+
+    static void *CreateContext(llvm::BumpPtrAllocator &Alloc) {
+      return new typename data_type::Factory(Alloc);
+    }
+
+    static void DeleteContext(void *Ctx) {
+      delete (typename data_type::Factory *) Ctx;
+    }
+  };
+
   // Partial-specialization for ImmutableSet.
   template <typename Key, typename Info>
   struct ProgramStatePartialTrait<llvm::ImmutableSet<Key, Info>> {
@@ -11,6 +11,7 @@
 
 #include "clang/Basic/LLVM.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/CAS/ActionCache.h"
@@ -32,11 +33,40 @@ namespace clang {
 namespace tooling {
 namespace dependencies {
 
+/// A process-wide cache of scanned dependency directives keyed by the CAS ID
+/// of the file's contents.  It is shared by all scanning workers so that each
+/// unique content blob is scanned (or deserialized from the action cache) only
+/// once per build session rather than once per worker.
+class DependencyDirectivesSharedCache {
+public:
+  /// The result of scanning one content blob.  Directives hold references
+  /// into Tokens, so entries are allocated once and never moved.
+  struct ScannedDirectives {
+    SmallVector<dependency_directives_scan::Token, 64> Tokens;
+    SmallVector<dependency_directives_scan::Directive, 16> Directives;
+  };
+
+  /// Get the scanned directives for \p ID if some worker has produced them
+  /// already, otherwise \c nullptr.
+  const ScannedDirectives *get(llvm::cas::ObjectRef ID);
+
+  /// Record the scanned directives for \p ID and return the cached copy.  If
+  /// another worker raced to insert a copy first, that copy wins.
+  const ScannedDirectives *add(llvm::cas::ObjectRef ID,
+                               std::unique_ptr<ScannedDirectives> SD);
+
+private:
+  std::mutex Mutex;
+  llvm::DenseMap<llvm::cas::ObjectRef, std::unique_ptr<ScannedDirectives>>
+      Cache;
+};
+
 class DependencyScanningCASFilesystem : public llvm::cas::ThreadSafeFileSystem {
 public:
   DependencyScanningCASFilesystem(
       IntrusiveRefCntPtr<llvm::cas::CachingOnDiskFileSystem> WorkerFS,
-      llvm::cas::ActionCache &Cache);
+      llvm::cas::ActionCache &Cache,
+      DependencyDirectivesSharedCache &SharedDirectives);
 
   ~DependencyScanningCASFilesystem();
 
@@ -80,8 +110,10 @@ private:
   struct FileEntry {
     std::error_code EC; // If non-zero, caches a stat failure.
     Optional<StringRef> Buffer;
-    SmallVector<dependency_directives_scan::Token, 64> DepTokens;
-    SmallVector<dependency_directives_scan::Directive, 16> DepDirectives;
+    /// The scanned directives for the file's contents, owned by the shared
+    /// directives cache.  Null if the file was not scanned.
+    const DependencyDirectivesSharedCache::ScannedDirectives *Directives =
+        nullptr;
     llvm::vfs::Status Status;
     Optional<llvm::cas::ObjectRef> CASContents;
   };
@@ -94,10 +126,8 @@ private:
     // Only filled if the Entry is nullptr.
     llvm::ErrorOr<llvm::vfs::Status> Status;
   };
-  void scanForDirectives(
-      llvm::cas::ObjectRef InputDataID, StringRef Identifier,
-      SmallVectorImpl<dependency_directives_scan::Token> &DepTokens,
-      SmallVectorImpl<dependency_directives_scan::Directive> &DepDirectives);
+  const DependencyDirectivesSharedCache::ScannedDirectives *
+  scanForDirectives(llvm::cas::ObjectRef InputDataID, StringRef Identifier);
 
   Expected<StringRef> getOriginal(llvm::cas::CASID InputDataID);
 
@@ -107,6 +137,7 @@ private:
 
   llvm::cas::ObjectStore &CAS;
   llvm::cas::ActionCache &Cache;
+  DependencyDirectivesSharedCache &SharedDirectives;
   Optional<llvm::cas::ObjectRef> ClangFullVersionID;
   Optional<llvm::cas::ObjectRef> DepDirectivesID;
   Optional<llvm::cas::ObjectRef> EmptyBlobID;
@@ -13,6 +13,7 @@
 #include "clang/Lex/DependencyDirectivesScanner.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/CAS/CASReference.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/ErrorOr.h"
@@ -177,9 +178,6 @@ public:
     /// The backing storage for cached entries.
     llvm::SpecificBumpPtrAllocator<CachedFileSystemEntry> EntryStorage;
 
-    /// The backing storage for cached contents.
-    llvm::SpecificBumpPtrAllocator<CachedFileContents> ContentsStorage;
-
     /// Returns entry associated with the filename or nullptr if none is found.
     const CachedFileSystemEntry *findEntryByFilename(StringRef Filename) const;
 
@@ -199,8 +197,7 @@ public:
     /// with the unique ID and returns the result.
     const CachedFileSystemEntry &
     getOrEmplaceEntryForUID(llvm::sys::fs::UniqueID UID, llvm::vfs::Status Stat,
-                            std::unique_ptr<llvm::MemoryBuffer> Contents,
-                            Optional<cas::ObjectRef> CASContents);
+                            CachedFileContents *Contents);
 
     /// Returns entry associated with the filename if there is some. Otherwise,
     /// associates the given entry with the filename and returns it.
@@ -215,9 +212,31 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Returns the cached contents for the given file contents, creating a new
+  /// object if none exists yet. Identical contents reached through different
+  /// names or unique IDs share one object, so their directive tokens are
+  /// scanned once and replayed for every other copy of the file.
+  CachedFileContents &
+  getOrCreateContents(std::unique_ptr<llvm::MemoryBuffer> Contents,
+                      Optional<cas::ObjectRef> CASContents);
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+
+  /// The mutex that needs to be locked before mutation of the content-keyed
+  /// members below.
+  mutable std::mutex ContentsLock;
+
+  /// Map from content hash to cached contents, shared across all shards so
+  /// that copies of a file with different unique IDs are only scanned once.
+  /// Buckets hold all contents with the same hash; exact contents are compared
+  /// on lookup.
+  llvm::DenseMap<uint64_t, llvm::TinyPtrVector<CachedFileContents *>>
+      ContentsByHash;
+
+  /// The backing storage for cached contents.
+  llvm::SpecificBumpPtrAllocator<CachedFileContents> ContentsStorage;
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
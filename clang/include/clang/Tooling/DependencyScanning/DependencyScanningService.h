@@ -88,6 +88,12 @@ public:
 
   llvm::cas::CachingOnDiskFileSystem &getSharedFS() { return *SharedFS; }
 
+  DependencyDirectivesSharedCache &getSharedDirectivesCache() {
+    assert(SharedFS && "Expected a CASFS");
+    assert(SharedDirectivesCache && "Expected a shared directives cache");
+    return *SharedDirectivesCache;
+  }
+
   bool useCASScanning() const { return (bool)SharedFS; }
 
 private:
@@ -108,6 +114,10 @@ private:
 
   /// The global file system cache.
   Optional<DependencyScanningFilesystemSharedCache> SharedCache;
+
+  /// The global cache of scanned dependency directives, keyed by the CAS ID
+  /// of the file contents.  Only used when scanning through the CAS.
+  Optional<DependencyDirectivesSharedCache> SharedDirectivesCache;
 };
 
 } // end namespace dependencies
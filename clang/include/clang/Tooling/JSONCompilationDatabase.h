@@ -64,6 +64,12 @@ public:
   ///
   /// Returns NULL and sets ErrorMessage if the database could not be
   /// loaded from the given file.
+  ///
+  /// Large databases are accompanied by a sidecar index file
+  /// ("<FilePath>.idx", written on the first successful full parse) that maps
+  /// each file to the byte range of its entries. When a valid index matching
+  /// the database is present, the database is loaded lazily: only the entries
+  /// a caller asks for through getCompileCommands() are read and parsed.
   static std::unique_ptr<JSONCompilationDatabase>
   loadFromFile(StringRef FilePath, std::string &ErrorMessage,
                JSONCommandLineSyntax Syntax);
@@ -121,9 +127,43 @@ private:
   void getCommands(ArrayRef<CompileCommandRef> CommandsRef,
                    std::vector<CompileCommand> &Commands) const;
 
+  /// Byte range of one database entry's JSON object within the database file.
+  struct EntryRange {
+    uint64_t Offset;
+    uint64_t Length;
+  };
+
+  /// Loads the database lazily through its sidecar index, or returns null if
+  /// no index exists or the index does not match the database on disk.
+  static std::unique_ptr<JSONCompilationDatabase>
+  loadThroughIndex(StringRef FilePath, JSONCommandLineSyntax Syntax);
+
+  /// Best-effort write of the sidecar index next to the database; failures
+  /// (e.g. read-only directories) are silently ignored.
+  void writeIndexFile(StringRef FilePath) const;
+
+  /// Reads the given entry ranges from the database file and parses just
+  /// those entries. Used instead of getCommands() when loaded lazily.
+  std::vector<CompileCommand>
+  getCommandsFromRanges(ArrayRef<EntryRange> Ranges) const;
+
+  /// True when the database was loaded through a sidecar index.
+  bool isLazy() const { return !LazyDatabasePath.empty(); }
+
   // Maps file paths to the compile command lines for that file.
   llvm::StringMap<std::vector<CompileCommandRef>> IndexByFile;
 
+  /// Counterpart of IndexByFile when loaded lazily: maps native file paths to
+  /// the byte ranges of their entries.
+  llvm::StringMap<std::vector<EntryRange>> LazyIndexByFile;
+
+  /// (Native file path, range) for every entry in parse order; filled in by
+  /// parse() so loadFromFile() can emit the sidecar index.
+  std::vector<std::pair<std::string, EntryRange>> ParsedEntryRanges;
+
+  /// Path to the database on disk; only set when loaded lazily.
+  std::string LazyDatabasePath;
+
   /// All the compile commands in the order that they were provided in the
   /// JSON stream.
   std::vector<CompileCommandRef> AllCommands;
@@ -86,15 +86,18 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MD5.h"
+#include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -973,6 +976,66 @@ static bool isAddrSpaceMapManglingEnabled(const TargetInfo &TI,
   llvm_unreachable("getAddressSpaceMapMangling() doesn't cover anything.");
 }
 
+namespace {
+
+/// A bounded process-wide pool of retired AST arenas; see
+/// ASTContext::setArenaRecycling().
+class ASTArenaPool {
+public:
+  llvm::BumpPtrAllocator take() {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (Arenas.empty())
+      return llvm::BumpPtrAllocator();
+    llvm::BumpPtrAllocator Result = std::move(Arenas.back());
+    Arenas.pop_back();
+    return Result;
+  }
+
+  void put(llvm::BumpPtrAllocator &&Arena) {
+    // Keep the pool bounded; an unusually large arena is cheaper to rebuild
+    // than to keep resident for the lifetime of the process.
+    if (Arena.getTotalMemory() > MaxArenaBytes)
+      return;
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (Arenas.size() < MaxArenas)
+      Arenas.push_back(std::move(Arena));
+  }
+
+private:
+  static constexpr size_t MaxArenas = 8;
+  static constexpr size_t MaxArenaBytes = 64 << 20;
+
+  std::mutex Mutex;
+  llvm::SmallVector<llvm::BumpPtrAllocator, 0> Arenas;
+};
+
+} // namespace
+
+static llvm::ManagedStatic<ASTArenaPool> ArenaPool;
+static std::atomic<bool> RecycleASTArenas(false);
+
+void ASTContext::setArenaRecycling(bool Enable) {
+  RecycleASTArenas.store(Enable, std::memory_order_relaxed);
+}
+
+bool ASTContext::isArenaRecyclingEnabled() {
+  return RecycleASTArenas.load(std::memory_order_relaxed);
+}
+
+ASTContext::RecyclableArena::RecyclableArena() {
+  if (isArenaRecyclingEnabled())
+    static_cast<llvm::BumpPtrAllocator &>(*this) = ArenaPool->take();
+}
+
+ASTContext::RecyclableArena::~RecyclableArena() {
+  if (isArenaRecyclingEnabled()) {
+    // Rewind the arena but keep its slabs so the next context starts out with
+    // an already-sized allocation.
+    ResetRetainingSlabs();
+    ArenaPool->put(std::move(static_cast<llvm::BumpPtrAllocator &>(*this)));
+  }
+}
+
 ASTContext::ASTContext(LangOptions &LOpts, SourceManager &SM,
                        IdentifierTable &idents, SelectorTable &sels,
                        Builtin::Context &builtins, TranslationUnitKind TUKind)
@@ -1049,10 +1112,9 @@ ASTContext::setExternalSource(IntrusiveRefCntPtr<ExternalASTSource> Source) {
   ExternalSource = std::move(Source);
 }
 
-void ASTContext::PrintStats() const {
-  llvm::errs() << "\n*** AST Context Stats:\n";
-  llvm::errs() << "  " << Types.size() << " types total.\n";
-
+void ASTContext::visitTypeAllocationStats(
+    llvm::function_ref<void(StringRef KindName, unsigned Count, size_t Bytes)>
+        Visitor) const {
   unsigned counts[] = {
 #define TYPE(Name, Parent) 0,
 #define ABSTRACT_TYPE(Name, Parent)
@@ -1066,17 +1128,26 @@ void ASTContext::PrintStats() const {
   }
 
   unsigned Idx = 0;
-  unsigned TotalBytes = 0;
 #define TYPE(Name, Parent)                                              \
   if (counts[Idx])                                                      \
-    llvm::errs() << "    " << counts[Idx] << " " << #Name               \
-                 << " types, " << sizeof(Name##Type) << " each "        \
-                 << "(" << counts[Idx] * sizeof(Name##Type)             \
-                 << " bytes)\n";                                        \
-  TotalBytes += counts[Idx] * sizeof(Name##Type);                       \
+    Visitor(#Name, counts[Idx], counts[Idx] * sizeof(Name##Type));      \
   ++Idx;
 #define ABSTRACT_TYPE(Name, Parent)
 #include "clang/AST/TypeNodes.inc"
+}
+
+void ASTContext::PrintStats() const {
+  llvm::errs() << "\n*** AST Context Stats:\n";
+  llvm::errs() << "  " << Types.size() << " types total.\n";
+
+  size_t TotalBytes = 0;
+  visitTypeAllocationStats([&](StringRef KindName, unsigned Count,
+                               size_t Bytes) {
+    llvm::errs() << "    " << Count << " " << KindName << " types, "
+                 << Bytes / Count << " each "
+                 << "(" << Bytes << " bytes)\n";
+    TotalBytes += Bytes;
+  });
 
   llvm::errs() << "Total bytes = " << TotalBytes << "\n";
 
@@ -1036,6 +1036,11 @@ private:
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
+    // Whether the node is hidden from matchers under each traversal mode.
+    // This depends only on the node and the matcher's traversal kind, so with
+    // many matchers in the filter compute it once per mode instead of asking
+    // the parent map once per matcher.
+    llvm::Optional<bool> NodeHidden[2];
     for (unsigned short I : Filter) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
@@ -1044,8 +1049,13 @@ private:
 
       {
         TraversalKindScope RAII(getASTContext(), MP.first.getTraversalKind());
-        if (getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
-            DynNode)
+        auto &PMCtx = getASTContext().getParentMapContext();
+        llvm::Optional<bool> &Hidden =
+            NodeHidden[PMCtx.getTraversalKind() ==
+                       TK_IgnoreUnlessSpelledInSource];
+        if (!Hidden)
+          Hidden = PMCtx.traverseIgnored(DynNode) != DynNode;
+        if (*Hidden)
           continue;
       }
 
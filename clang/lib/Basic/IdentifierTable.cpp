@@ -442,6 +442,26 @@ tok::PPKeywordKind IdentifierInfo::getPPKeywordID() const {
   }
 }
 
+void IdentifierTable::forEachIdentifierWithLength(
+    unsigned MinLength, unsigned MaxLength,
+    llvm::function_ref<void(const IdentifierInfo &)> Visit) {
+  assert(MinLength > 0 && "Identifiers are never empty");
+  assert(MinLength <= MaxLength && "Inverted length range");
+  if (LengthBuckets.empty()) {
+    // First use: partition the identifiers seen so far. get() and getOwn()
+    // append new ones as they are created.
+    LengthBuckets.resize(NumLengthBuckets);
+    for (const auto &Entry : HashTable)
+      LengthBuckets[getLengthBucket(Entry.getKeyLength())].push_back(
+          Entry.getValue());
+  }
+  for (unsigned I = getLengthBucket(MinLength),
+                E = getLengthBucket(MaxLength);
+       I <= E; ++I)
+    for (const IdentifierInfo *II : LengthBuckets[I])
+      Visit(*II);
+}
+
 //===----------------------------------------------------------------------===//
 // Stats Implementation
 //===----------------------------------------------------------------------===//
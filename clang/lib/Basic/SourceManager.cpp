@@ -341,6 +341,7 @@ void SourceManager::clearIDTables() {
   LastLineNoFileIDQuery = FileID();
   LastLineNoContentCache = nullptr;
   LastFileIDLookup = FileID();
+  LocalPageTable.clear();
 
   if (LineTable)
     LineTable->clear();
@@ -820,10 +821,31 @@ FileID SourceManager::getFileIDLocal(SourceLocation::UIntTy SLocOffset) const {
   // Convert "I" back into an index.  We know that it is an entry whose index is
   // larger than the offset we are looking for.
   unsigned GreaterIndex = I - LocalSLocEntryTable.begin();
+
+  // Consult the page table to narrow the search down to the entries of a
+  // single page, extending it first if it does not cover this offset yet. The
+  // start of every page up to the one containing SLocOffset is a valid local
+  // offset, so the entry containing it exists and can never change.
+  unsigned PageIndex = SLocOffset >> SLocPageShift;
+  if (PageIndex >= LocalPageTable.size()) {
+    unsigned EntryIndex = LocalPageTable.empty() ? 0 : LocalPageTable.back();
+    for (unsigned P = LocalPageTable.size(); P <= PageIndex; ++P) {
+      SourceLocation::UIntTy PageStart = (SourceLocation::UIntTy)P
+                                         << SLocPageShift;
+      while (EntryIndex + 1 < LocalSLocEntryTable.size() &&
+             LocalSLocEntryTable[EntryIndex + 1].getOffset() <= PageStart)
+        ++EntryIndex;
+      LocalPageTable.push_back(EntryIndex);
+    }
+  }
+
   // LessIndex - This is the lower bound of the range that we're searching.
-  // We know that the offset corresponding to the FileID is is less than
-  // SLocOffset.
-  unsigned LessIndex = 0;
+  // The entry we want is no earlier than the one containing the start of its
+  // page, and no later than the one containing the start of the next covered
+  // page.
+  unsigned LessIndex = LocalPageTable[PageIndex];
+  if (PageIndex + 1 < LocalPageTable.size())
+    GreaterIndex = std::min(GreaterIndex, LocalPageTable[PageIndex + 1] + 1);
   NumProbes = 0;
   while (true) {
     unsigned MiddleIndex = (GreaterIndex-LessIndex)/2+LessIndex;
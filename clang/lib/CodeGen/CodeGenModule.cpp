@@ -66,6 +66,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ConvertUTF.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/SaveAndRestore.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/X86TargetParser.h"
 #include "llvm/Support/xxhash.h"
@@ -2709,10 +2710,14 @@ void CodeGenModule::EmitDeferred() {
     assert(DeferredVTables.empty());
   }
 
-  // Emit CUDA/HIP static device variables referenced by host code only.
+  // Emit CUDA/HIP static device variables referenced by host code only. Do
+  // this only on the outermost invocation: the set is fully populated by the
+  // time code generation starts, and the recursive calls below would
+  // otherwise re-append (and re-query the address of) every variable once per
+  // level of recursion.
   // Note we should not clear CUDADeviceVarODRUsedByHost since it is still
   // needed for further handling.
-  if (getLangOpts().CUDA && getLangOpts().CUDAIsDevice)
+  if (getLangOpts().CUDA && getLangOpts().CUDAIsDevice && !InEmitDeferred)
     llvm::append_range(DeferredDeclsToEmit,
                        getContext().CUDADeviceVarODRUsedByHost);
 
@@ -2720,6 +2725,8 @@ void CodeGenModule::EmitDeferred() {
   if (DeferredDeclsToEmit.empty())
     return;
 
+  llvm::SaveAndRestore<bool> SavedInEmitDeferred(InEmitDeferred, true);
+
   // Grab the list of decls to emit. If EmitGlobalDefinition schedules more
   // work, it will not interfere with this.
   std::vector<GlobalDecl> CurDeclsToEmit;
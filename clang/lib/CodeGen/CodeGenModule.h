@@ -351,6 +351,10 @@ private:
   /// This is a list of deferred decls which we have seen that *are* actually
   /// referenced. These get code generated when the module is done.
   std::vector<GlobalDecl> DeferredDeclsToEmit;
+
+  /// True while EmitDeferred is draining DeferredDeclsToEmit, so that the
+  /// recursive calls it makes can skip the once-per-drain preamble work.
+  bool InEmitDeferred = false;
   void addDeferredDeclToEmit(GlobalDecl GD) {
     DeferredDeclsToEmit.emplace_back(GD);
     addEmittedDeferredDecl(GD);
@@ -11,15 +11,17 @@
 
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/AlignOf.h"
 #include "llvm/Support/Errno.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Path.h"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <iterator>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <vector>
@@ -84,32 +86,43 @@ struct SemaphorePipe {
 class EventQueue {
   std::mutex Mtx;
   std::condition_variable NonEmpty;
-  std::queue<DirectoryWatcher::Event> Events;
+  std::vector<DirectoryWatcher::Event> Events;
+  // Set when a WatchedDirRemoved or WatcherGotInvalidated event is queued so
+  // that pop_all_blocking() never delays its delivery for coalescing.
+  bool HasTerminalEvent = false;
 
 public:
   void push_back(const DirectoryWatcher::Event::EventKind K,
                  StringRef Filename) {
     {
       std::unique_lock<std::mutex> L(Mtx);
-      Events.emplace(K, Filename);
+      Events.emplace_back(K, Filename);
+      if (K == DirectoryWatcher::Event::EventKind::WatchedDirRemoved ||
+          K == DirectoryWatcher::Event::EventKind::WatcherGotInvalidated)
+        HasTerminalEvent = true;
     }
     NonEmpty.notify_one();
   }
 
-  // Blocks on caller thread and uses codition_variable to wait until there's an
-  // event to return.
-  DirectoryWatcher::Event pop_front_blocking() {
+  // Blocks on caller thread until at least one event is available, then moves
+  // all queued events into \p Out. After the first event arrives, keeps
+  // accumulating for up to \p CoalescingWindow so that event bursts (e.g. a
+  // branch switch touching the whole directory) are delivered as one batch
+  // instead of thousands of individual Receiver invocations. Terminal events
+  // are never delayed.
+  void pop_all_blocking(std::vector<DirectoryWatcher::Event> &Out,
+                        std::chrono::milliseconds CoalescingWindow) {
     std::unique_lock<std::mutex> L(Mtx);
-    while (true) {
-      // Since we might have missed all the prior notifications on NonEmpty we
-      // have to check the queue first (under lock).
-      if (!Events.empty()) {
-        DirectoryWatcher::Event Front = Events.front();
-        Events.pop();
-        return Front;
-      }
-      NonEmpty.wait(L, [this]() { return !Events.empty(); });
-    }
+    // Since we might have missed all the prior notifications on NonEmpty we
+    // have to check the queue first (under lock).
+    NonEmpty.wait(L, [this]() { return !Events.empty(); });
+    if (CoalescingWindow.count() > 0 && !HasTerminalEvent)
+      NonEmpty.wait_for(L, CoalescingWindow,
+                        [this]() { return HasTerminalEvent; });
+    Out.insert(Out.end(), std::make_move_iterator(Events.begin()),
+               std::make_move_iterator(Events.end()));
+    Events.clear();
+    HasTerminalEvent = false;
   }
 };
 
@@ -282,14 +295,46 @@ void DirectoryWatcherLinux::InitialScan() {
 }
 
 void DirectoryWatcherLinux::EventReceivingLoop() {
+  // How long to keep accumulating queued events after the first one arrives
+  // before delivering the batch. Long enough to swallow kernel event bursts,
+  // short enough to be unnoticeable for interactive consumers.
+  constexpr std::chrono::milliseconds CoalescingWindow(50);
+
+  std::vector<DirectoryWatcher::Event> Batch;
   while (true) {
-    DirectoryWatcher::Event Event = this->Queue.pop_front_blocking();
-    this->Receiver(Event, false);
-    if (Event.Kind ==
-        DirectoryWatcher::Event::EventKind::WatcherGotInvalidated) {
-      StopWork();
-      return;
+    Batch.clear();
+    Queue.pop_all_blocking(Batch, CoalescingWindow);
+
+    // Coalesce repeated events for the same file, keeping only the most
+    // recent kind. Consumers typically stat every delivered file, so a file
+    // touched many times within the window is reported exactly once.
+    std::vector<DirectoryWatcher::Event> Coalesced;
+    llvm::StringMap<size_t> LastEventForFile;
+    for (DirectoryWatcher::Event &Event : Batch) {
+      if (Event.Kind == DirectoryWatcher::Event::EventKind::Modified ||
+          Event.Kind == DirectoryWatcher::Event::EventKind::Removed) {
+        auto Insertion =
+            LastEventForFile.try_emplace(Event.Filename, Coalesced.size());
+        if (Insertion.second)
+          Coalesced.push_back(std::move(Event));
+        else
+          Coalesced[Insertion.first->second].Kind = Event.Kind;
+        continue;
+      }
+      if (Event.Kind ==
+          DirectoryWatcher::Event::EventKind::WatcherGotInvalidated) {
+        // Deliver everything coalesced so far together with the invalidation,
+        // then shut down.
+        Coalesced.push_back(std::move(Event));
+        this->Receiver(Coalesced, false);
+        StopWork();
+        return;
+      }
+      // WatchedDirRemoved: deliver it in order; the loop keeps running until
+      // the WatcherGotInvalidated that follows it.
+      Coalesced.push_back(std::move(Event));
     }
+    this->Receiver(Coalesced, false);
   }
 }
 
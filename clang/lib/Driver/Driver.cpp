@@ -4632,9 +4632,14 @@ void Driver::BuildJobs(Compilation &C) const {
       C.getJobs().size() == 2 &&
       isa<DepscanJobAction>(C.getJobs().begin()->getSource());
 
-  // If we have more than one job, then disable integrated-cc1 for now. Do this
-  // also when we need to report process execution statistics.
-  if ((C.getJobs().size() > 1 && !ShouldInProcessDepScan) ||
+  // Only one cc1 may run in this process: a second one would observe whatever
+  // global state (cl::opt values, statistics, ...) the first left behind. Jobs
+  // that exec separate binaries (linkers, assemblers, dsymutil) don't care, so
+  // a lone cc1 stays integrated even when such jobs follow it. Also disable
+  // integrated-cc1 when we need to report process execution statistics.
+  unsigned NumInProcessJobs =
+      llvm::count_if(C.getJobs(), [](const Command &J) { return J.InProcess; });
+  if ((NumInProcessJobs > 1 && !ShouldInProcessDepScan) ||
       CCPrintProcessStats) {
     for (auto &J : C.getJobs())
       J.InProcess = false;
@@ -16,9 +16,15 @@
 #include "clang/ExtractAPI/API.h"
 #include "clang/ExtractAPI/DeclarationFragments.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/VersionTuple.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 using namespace clang;
 using namespace clang::extractapi;
@@ -676,39 +682,101 @@ SymbolGraphSerializer::makePathComponentGuard(StringRef Component) {
   return PathComponentGuard(PathComponents, Component);
 }
 
-Object SymbolGraphSerializer::serialize() {
-  Object Root;
-  serializeObject(Root, "metadata", serializeMetadata());
-  serializeObject(Root, "module", serializeModule());
+/// Get the number of top-level records in \p API, i.e. the number of
+/// serializeRecords() work items.
+static size_t getTopLevelRecordCount(const APISet &API) {
+  return API.getGlobalVariables().size() + API.getGlobalFunctions().size() +
+         API.getEnums().size() + API.getStructs().size() +
+         API.getObjCInterfaces().size() + API.getObjCProtocols().size() +
+         API.getMacros().size() + API.getTypedefs().size();
+}
+
+void SymbolGraphSerializer::serializeRecords() {
+  // Visit the top-level records in their fixed category order, only formatting
+  // the ones that fall into this serializer's [ShardBegin, ShardEnd) slice.
+  // For a serial run the slice covers everything.
+  size_t NextRecord = 0;
+  auto InShard = [&]() {
+    size_t Index = NextRecord++;
+    return Index >= ShardBegin && Index < ShardEnd;
+  };
 
   // Serialize global variables in the API set.
   for (const auto &GlobalVar : API.getGlobalVariables())
-    serializeGlobalVariableRecord(*GlobalVar.second);
+    if (InShard())
+      serializeGlobalVariableRecord(*GlobalVar.second);
 
   for (const auto &GlobalFunction : API.getGlobalFunctions())
-    serializeGlobalFunctionRecord(*GlobalFunction.second);
+    if (InShard())
+      serializeGlobalFunctionRecord(*GlobalFunction.second);
 
   // Serialize enum records in the API set.
   for (const auto &Enum : API.getEnums())
-    serializeEnumRecord(*Enum.second);
+    if (InShard())
+      serializeEnumRecord(*Enum.second);
 
   // Serialize struct records in the API set.
   for (const auto &Struct : API.getStructs())
-    serializeStructRecord(*Struct.second);
+    if (InShard())
+      serializeStructRecord(*Struct.second);
 
   // Serialize Objective-C interface records in the API set.
   for (const auto &ObjCInterface : API.getObjCInterfaces())
-    serializeObjCContainerRecord(*ObjCInterface.second);
+    if (InShard())
+      serializeObjCContainerRecord(*ObjCInterface.second);
 
   // Serialize Objective-C protocol records in the API set.
   for (const auto &ObjCProtocol : API.getObjCProtocols())
-    serializeObjCContainerRecord(*ObjCProtocol.second);
+    if (InShard())
+      serializeObjCContainerRecord(*ObjCProtocol.second);
 
   for (const auto &Macro : API.getMacros())
-    serializeMacroDefinitionRecord(*Macro.second);
+    if (InShard())
+      serializeMacroDefinitionRecord(*Macro.second);
 
   for (const auto &Typedef : API.getTypedefs())
-    serializeTypedefRecord(*Typedef.second);
+    if (InShard())
+      serializeTypedefRecord(*Typedef.second);
+}
+
+Object SymbolGraphSerializer::serialize() {
+  Object Root;
+  serializeObject(Root, "metadata", serializeMetadata());
+  serializeObject(Root, "module", serializeModule());
+
+  // Formatting a record only reads the (immutable) API set and writes to
+  // serializer-local state, so large API sets are sharded across worker
+  // serializers, each covering a contiguous slice of the top-level records.
+  // Concatenating the worker outputs in shard order keeps the result
+  // identical to a serial run. Small sets aren't worth the setup cost.
+  constexpr size_t MinRecordsPerShard = 1024;
+  const size_t NumRecords = getTopLevelRecordCount(API);
+  const size_t NumShards = std::min<size_t>(
+      llvm::heavyweight_hardware_concurrency().compute_thread_count(),
+      NumRecords / MinRecordsPerShard);
+  if (NumShards > 1) {
+    const size_t RecordsPerShard = (NumRecords + NumShards - 1) / NumShards;
+    std::vector<std::unique_ptr<SymbolGraphSerializer>> Workers;
+    for (size_t I = 0; I != NumShards; ++I) {
+      Workers.push_back(
+          std::make_unique<SymbolGraphSerializer>(API, ProductName, Options));
+      Workers.back()->ShardBegin = I * RecordsPerShard;
+      Workers.back()->ShardEnd = std::min((I + 1) * RecordsPerShard, NumRecords);
+    }
+    llvm::parallelFor(0, NumShards,
+                      [&](size_t I) { Workers[I]->serializeRecords(); });
+    for (const auto &Worker : Workers) {
+      Symbols.insert(Symbols.end(),
+                     std::make_move_iterator(Worker->Symbols.begin()),
+                     std::make_move_iterator(Worker->Symbols.end()));
+      Relationships.insert(
+          Relationships.end(),
+          std::make_move_iterator(Worker->Relationships.begin()),
+          std::make_move_iterator(Worker->Relationships.end()));
+    }
+  } else {
+    serializeRecords();
+  }
 
   Root["symbols"] = std::move(Symbols);
   Root["relationships"] = std::move(Relationships);
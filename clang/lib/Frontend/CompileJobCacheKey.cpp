@@ -110,6 +110,35 @@ clang::createCompileJobCacheKey(ObjectStore &CAS, DiagnosticsEngine &Diags,
   return createCompileJobCacheKeyForArgs(CAS, Argv, *RootID, IsIncludeTree);
 }
 
+llvm::cas::CASID
+clang::createPredefinesCacheKey(ObjectStore &CAS,
+                                const CompilerInvocation &Invocation) {
+  // Generate a normalized command-line; the predefines buffer depends only on
+  // the invocation's options, not on any input files, so no filesystem root
+  // is part of the key.
+  llvm::BumpPtrAllocator Alloc;
+  llvm::StringSaver Saver(Alloc);
+  llvm::SmallVector<const char *> Argv;
+  Argv.push_back("-cc1");
+  Invocation.generateCC1CommandLine(
+      Argv, [&Saver](const llvm::Twine &T) { return Saver.save(T).data(); });
+
+  SmallString<256> CommandLine;
+  for (StringRef Arg : Argv) {
+    CommandLine.append(Arg);
+    CommandLine.push_back(0);
+  }
+
+  llvm::cas::HierarchicalTreeBuilder Builder;
+  Builder.push(llvm::cantFail(CAS.storeFromString(None, CommandLine)),
+               llvm::cas::TreeEntry::Regular, "command-line");
+  Builder.push(llvm::cantFail(CAS.storeFromString(None, "predefines")),
+               llvm::cas::TreeEntry::Regular, "computation");
+  Builder.push(llvm::cantFail(CAS.storeFromString(None, getClangFullVersion())),
+               llvm::cas::TreeEntry::Regular, "version");
+  return llvm::cantFail(Builder.create(CAS)).getID();
+}
+
 static Error printFileSystem(ObjectStore &CAS, ObjectRef Ref, raw_ostream &OS) {
   Expected<ObjectProxy> Root = CAS.getProxy(Ref);
   if (!Root)
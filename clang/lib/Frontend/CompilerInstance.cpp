@@ -479,8 +479,13 @@ void CompilerInstance::createPreprocessor(TranslationUnitKind TUKind) {
                           PP->getFileManager(), PPOpts);
 
   // Predefine macros and configure the preprocessor.
-  InitializePreprocessor(*PP, PPOpts, getPCHContainerReader(),
-                         getFrontendOpts());
+  if (PPOpts.CachePredefines)
+    InitializePreprocessorWithCachedPredefines(
+        *PP, PPOpts, getPCHContainerReader(), getFrontendOpts(),
+        getInvocation(), getOrCreateObjectStore(), getOrCreateActionCache());
+  else
+    InitializePreprocessor(*PP, PPOpts, getPCHContainerReader(),
+                           getFrontendOpts());
 
   // Initialize the header search object.  In CUDA compilations, we use the aux
   // triple (the host triple) to initialize our header search, since we need to
@@ -118,6 +118,31 @@ ASTViewAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
   return CreateASTViewer();
 }
 
+/// Try to open \p CI's PCH output file for streamed emission, where the AST
+/// writer flushes finished blocks through a seekable stream instead of
+/// accumulating the entire bitstream in memory. This writes to the output
+/// path directly, bypassing the CompilerInstance's output machinery, so it is
+/// limited to the plain case: a raw PCH written to a regular file that is not
+/// also cached in memory and whose bytes no configured output backend needs
+/// to observe. Returns null when streaming does not apply; the caller falls
+/// back to buffered output.
+static std::unique_ptr<llvm::raw_fd_stream>
+tryCreateStreamedPCHOutputFile(CompilerInstance &CI) {
+  if (CI.getPCHContainerWriter().getFormat() != "raw" ||
+      CI.getLangOpts().CacheGeneratedPCH || CI.hasOutputBackend())
+    return nullptr;
+
+  StringRef OutputPath = CI.getFrontendOpts().OutputFile;
+  if (OutputPath.empty() || OutputPath == "-")
+    return nullptr;
+
+  std::error_code EC;
+  auto OS = std::make_unique<llvm::raw_fd_stream>(OutputPath, EC);
+  if (EC)
+    return nullptr;
+  return OS;
+}
+
 std::unique_ptr<ASTConsumer>
 GeneratePCHAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
   std::string Sysroot;
@@ -125,8 +150,17 @@ GeneratePCHAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
     return nullptr;
 
   std::string OutputFile;
-  std::unique_ptr<raw_pwrite_stream> OS =
-      CreateOutputFile(CI, InFile, /*ref*/ OutputFile);
+  llvm::raw_fd_stream *OutputStream = nullptr;
+  std::unique_ptr<raw_pwrite_stream> OS;
+  if (std::unique_ptr<llvm::raw_fd_stream> FDS =
+          tryCreateStreamedPCHOutputFile(CI)) {
+    OutputStream = FDS.get();
+    OS = std::move(FDS);
+    OutputFile = CI.getFrontendOpts().OutputFile;
+    StreamedOutputFile = OutputFile;
+  } else {
+    OS = CreateOutputFile(CI, InFile, /*ref*/ OutputFile);
+  }
   if (!OS)
     return nullptr;
 
@@ -140,7 +174,8 @@ GeneratePCHAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
       CI.getPreprocessor(), CI.getModuleCache(), OutputFile, Sysroot, Buffer,
       FrontendOpts.ModuleFileExtensions,
       CI.getPreprocessorOpts().AllowPCHWithCompilerErrors,
-      FrontendOpts.IncludeTimestamps, +CI.getLangOpts().CacheGeneratedPCH));
+      FrontendOpts.IncludeTimestamps, +CI.getLangOpts().CacheGeneratedPCH,
+      OutputStream));
   Consumers.push_back(CI.getPCHContainerWriter().CreatePCHContainerGenerator(
       CI, std::string(InFile), OutputFile, std::move(OS), Buffer));
 
@@ -171,6 +206,14 @@ GeneratePCHAction::CreateOutputFile(CompilerInstance &CI, StringRef InFile,
   return OS;
 }
 
+void GeneratePCHAction::EndSourceFileAction() {
+  // A streamed output file bypasses the CompilerInstance's output-file
+  // tracking and hence clearOutputFiles(); mirror its cleanup-on-error
+  // behavior here.
+  if (!StreamedOutputFile.empty() && shouldEraseOutputFiles())
+    llvm::sys::fs::remove(StreamedOutputFile);
+}
+
 bool GeneratePCHAction::shouldEraseOutputFiles() {
   if (getCompilerInstance().getPreprocessorOpts().AllowPCHWithCompilerErrors)
     return false;
@@ -16,6 +16,7 @@
 #include "clang/Basic/SyncScope.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Basic/Version.h"
+#include "clang/Frontend/CompileJobCacheKey.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
 #include "clang/Frontend/FrontendOptions.h"
 #include "clang/Frontend/Utils.h"
@@ -24,6 +25,8 @@
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Serialization/ASTReader.h"
 #include "llvm/ADT/APFloat.h"
+#include "llvm/CAS/ActionCache.h"
+#include "llvm/CAS/ObjectStore.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
 using namespace clang;
@@ -1296,13 +1299,11 @@ static void InitializePredefinedMacros(const TargetInfo &TI,
   TI.getTargetDefines(LangOpts, Builder);
 }
 
-/// InitializePreprocessor - Initialize the preprocessor getting it and the
-/// environment ready to process a single file. This returns true on error.
-///
-void clang::InitializePreprocessor(
-    Preprocessor &PP, const PreprocessorOptions &InitOpts,
-    const PCHContainerReader &PCHContainerRdr,
-    const FrontendOptions &FEOpts) {
+/// Build the predefines buffer for \p PP without installing it.
+static std::string buildPredefinesBuffer(Preprocessor &PP,
+                                         const PreprocessorOptions &InitOpts,
+                                         const PCHContainerReader &PCHContainerRdr,
+                                         const FrontendOptions &FEOpts) {
   const LangOptions &LangOpts = PP.getLangOpts();
   std::string PredefineBuffer;
   PredefineBuffer.reserve(4080);
@@ -1383,10 +1384,61 @@ void clang::InitializePreprocessor(
     AddImplicitInclude(Builder, Path);
   }
 
+  Predefines.flush();
+  return PredefineBuffer;
+}
+
+/// InitializePreprocessor - Initialize the preprocessor getting it and the
+/// environment ready to process a single file. This returns true on error.
+///
+void clang::InitializePreprocessor(
+    Preprocessor &PP, const PreprocessorOptions &InitOpts,
+    const PCHContainerReader &PCHContainerRdr,
+    const FrontendOptions &FEOpts) {
   // Instruct the preprocessor to skip the preamble.
   PP.setSkipMainFilePreamble(InitOpts.PrecompiledPreambleBytes.first,
                              InitOpts.PrecompiledPreambleBytes.second);
 
   // Copy PredefinedBuffer into the Preprocessor.
+  PP.setPredefines(
+      buildPredefinesBuffer(PP, InitOpts, PCHContainerRdr, FEOpts));
+}
+
+void clang::InitializePreprocessorWithCachedPredefines(
+    Preprocessor &PP, const PreprocessorOptions &InitOpts,
+    const PCHContainerReader &PCHContainerRdr, const FrontendOptions &FEOpts,
+    const CompilerInvocation &Invocation, llvm::cas::ObjectStore &CAS,
+    llvm::cas::ActionCache &Cache) {
+  // Instruct the preprocessor to skip the preamble.
+  PP.setSkipMainFilePreamble(InitOpts.PrecompiledPreambleBytes.first,
+                             InitOpts.PrecompiledPreambleBytes.second);
+
+  llvm::cas::CASID Key = createPredefinesCacheKey(CAS, Invocation);
+
+  // Look up a previously computed predefines buffer. Failures here are not
+  // errors; fall back to building the buffer from scratch.
+  Optional<llvm::cas::ObjectRef> Result;
+  if (llvm::Error E = Cache.get(llvm::cas::CacheKey(Key)).moveInto(Result))
+    llvm::consumeError(std::move(E));
+  if (Result) {
+    if (auto Blob = CAS.getProxy(*Result)) {
+      PP.setPredefines(Blob->getData().str());
+      return;
+    } else {
+      llvm::consumeError(Blob.takeError());
+    }
+  }
+
+  std::string PredefineBuffer =
+      buildPredefinesBuffer(PP, InitOpts, PCHContainerRdr, FEOpts);
+
+  // Best-effort: store the buffer for future invocations.
+  if (auto BlobRef = CAS.storeFromString(None, PredefineBuffer)) {
+    if (llvm::Error E = Cache.put(llvm::cas::CacheKey(Key), *BlobRef))
+      llvm::consumeError(std::move(E));
+  } else {
+    llvm::consumeError(BlobRef.takeError());
+  }
+
   PP.setPredefines(std::move(PredefineBuffer));
 }
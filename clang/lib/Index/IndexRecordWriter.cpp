@@ -16,6 +16,7 @@
 #include "llvm/Bitstream/BitstreamWriter.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -54,6 +55,41 @@ struct RecordState {
   RecordState(std::string &&RecordPath)
       : RecordPath(std::move(RecordPath)), Stream(Buffer) {}
 };
+
+/// Process-wide cache of record files known to exist on disk and of record
+/// subdirectories known to have been created. Record files are content
+/// addressed and immutable, so once a name has been observed the filesystem
+/// never needs to be consulted for it again. This matters on network
+/// filesystems, where every access()/mkdir() is a metadata server round trip
+/// and the same records recur across the TUs of a build.
+class KnownRecordsCache {
+  llvm::sys::Mutex Mtx;
+  StringSet<> ExistingRecords;
+  StringSet<> CreatedDirs;
+
+public:
+  bool recordExists(StringRef RecordName) {
+    llvm::sys::ScopedLock L(Mtx);
+    return ExistingRecords.contains(RecordName);
+  }
+  void noteRecordExists(StringRef RecordName) {
+    llvm::sys::ScopedLock L(Mtx);
+    ExistingRecords.insert(RecordName);
+  }
+  bool directoryCreated(StringRef DirPath) {
+    llvm::sys::ScopedLock L(Mtx);
+    return CreatedDirs.contains(DirPath);
+  }
+  void noteDirectoryCreated(StringRef DirPath) {
+    llvm::sys::ScopedLock L(Mtx);
+    CreatedDirs.insert(DirPath);
+  }
+
+  static KnownRecordsCache &get() {
+    static KnownRecordsCache Cache;
+    return Cache;
+  }
+};
 } // end anonymous namespace
 
 static void writeBlockInfo(BitstreamWriter &Stream) {
@@ -257,6 +293,9 @@ IndexRecordWriter::beginRecord(StringRef Filename, hash_code RecordHash,
   if (OutRecordFile)
     *OutRecordFile = RecordName;
 
+  if (KnownRecordsCache::get().recordExists(RecordName))
+    return Result::AlreadyExists;
+
   if (std::error_code EC =
           fs::access(RecordPath.c_str(), fs::AccessMode::Exist)) {
     if (EC != errc::no_such_file_or_directory) {
@@ -266,6 +305,7 @@ IndexRecordWriter::beginRecord(StringRef Filename, hash_code RecordHash,
       return Result::Failure;
     }
   } else {
+    KnownRecordsCache::get().noteRecordExists(RecordName);
     return Result::AlreadyExists;
   }
 
@@ -300,10 +340,15 @@ IndexRecordWriter::endRecord(std::string &Error,
     writeDecls(State.Stream, State.Decls, State.Occurrences, GetSymbolForDecl);
   }
 
-  if (std::error_code EC = sys::fs::create_directory(sys::path::parent_path(State.RecordPath))) {
-    llvm::raw_string_ostream Err(Error);
-    Err << "failed to create directory '" << sys::path::parent_path(State.RecordPath) << "': " << EC.message();
-    return Result::Failure;
+  StringRef RecordDir = sys::path::parent_path(State.RecordPath);
+  if (!KnownRecordsCache::get().directoryCreated(RecordDir)) {
+    if (std::error_code EC = sys::fs::create_directory(RecordDir)) {
+      llvm::raw_string_ostream Err(Error);
+      Err << "failed to create directory '" << RecordDir
+          << "': " << EC.message();
+      return Result::Failure;
+    }
+    KnownRecordsCache::get().noteDirectoryCreated(RecordDir);
   }
 
   // Create a unique file to write to so that we can move the result into place
@@ -337,6 +382,9 @@ IndexRecordWriter::endRecord(std::string &Error,
     return Result::Failure;
   }
 
+  KnownRecordsCache::get().noteRecordExists(
+      sys::path::filename(State.RecordPath));
+
   return Result::Success;
 }
 
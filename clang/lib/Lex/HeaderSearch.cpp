@@ -28,6 +28,7 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Allocator.h"
@@ -705,6 +706,51 @@ Optional<FileEntryRef> DirectoryLookup::DoFrameworkLookup(
   return None;
 }
 
+const llvm::StringSet<> *
+HeaderSearch::getOrBuildDirectoryFilter(const DirectoryEntry *Dir) {
+  auto Known = DirectoryFilters.find(Dir);
+  if (Known != DirectoryFilters.end())
+    return Known->second.get();
+
+  // Stay null (filter disabled) unless the whole directory can be listed.
+  std::unique_ptr<llvm::StringSet<>> &Filter = DirectoryFilters[Dir];
+
+  auto Set = std::make_unique<llvm::StringSet<>>();
+  std::error_code EC;
+  llvm::vfs::FileSystem &FS = FileMgr.getVirtualFileSystem();
+  for (llvm::vfs::directory_iterator It = FS.dir_begin(Dir->getName(), EC), E;
+       !EC && It != E; It.increment(EC)) {
+    StringRef Name = llvm::sys::path::filename(It->path());
+    // Bail out on names the ASCII folding below cannot compare faithfully on
+    // case-folding file systems.
+    if (!llvm::all_of(Name, [](char C) { return llvm::isASCII(C); }))
+      return nullptr;
+    Set->insert(Name.lower());
+  }
+  if (EC)
+    return nullptr;
+
+  Filter = std::move(Set);
+  return Filter.get();
+}
+
+/// Compute the lower-cased first path component of \p Filename for probing a
+/// directory name filter, or an empty string when the spelling is one the
+/// filter cannot answer authoritatively (dot-relative, drive-relative or
+/// non-ASCII).
+static SmallString<32> filterNameForLookup(StringRef Filename) {
+  SmallString<32> Result;
+  size_t SlashPos = Filename.find_first_of("/\\");
+  StringRef First =
+      SlashPos == StringRef::npos ? Filename : Filename.take_front(SlashPos);
+  if (First.empty() || First == "." || First == ".." ||
+      First.contains(':') ||
+      !llvm::all_of(First, [](char C) { return llvm::isASCII(C); }))
+    return Result;
+  Result = First.lower();
+  return Result;
+}
+
 void HeaderSearch::cacheLookupSuccess(LookupFileCacheInfo &CacheLookup,
                                       ConstSearchDirIterator HitIt,
                                       SourceLocation Loc) {
@@ -1005,8 +1051,28 @@ Optional<FileEntryRef> HeaderSearch::LookupFile(
 
   SmallString<64> MappedName;
 
+  // Lower-cased first path component of Filename, for probing per-directory
+  // name filters. Recomputed if a header map remaps Filename mid-search.
+  SmallString<32> FilterName;
+  const char *FilterNameFor = nullptr;
+
   // Check each directory in sequence to see if it contains this file.
   for (; It != search_dir_end(); ++It) {
+    // A normal directory whose listing does not contain the first component
+    // of Filename cannot satisfy the lookup; skip it without building the
+    // path and probing the file system.
+    if (It->isNormalDir()) {
+      if (Filename.data() != FilterNameFor) {
+        FilterNameFor = Filename.data();
+        FilterName = filterNameForLookup(Filename);
+      }
+      if (!FilterName.empty())
+        if (const llvm::StringSet<> *Filter =
+                getOrBuildDirectoryFilter(It->getDir()))
+          if (!Filter->contains(FilterName))
+            continue;
+    }
+
     bool InUserSpecifiedSystemFramework = false;
     bool IsInHeaderMap = false;
     bool IsFrameworkFoundInDir = false;
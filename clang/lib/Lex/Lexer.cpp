@@ -48,6 +48,13 @@
 #include <tuple>
 #include <utility>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -1790,6 +1797,32 @@ bool Lexer::LexUnicodeIdentifierStart(Token &Result, uint32_t C,
 
 bool Lexer::LexIdentifierContinue(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched an identifier start.
+#ifdef __SSE2__
+  // Skip over runs of plain ASCII identifier characters 16 bytes at a time.
+  // Any byte the vector classification rejects ('$', UTF-8 lead bytes, the
+  // code-completion NUL, ...) is re-examined by the byte-at-a-time loop below.
+  while (CurPtr + 16 < BufferEnd) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(CurPtr));
+    // Case-fold letters; bytes >= 0x80 stay negative and fail the signed
+    // range compares below.
+    __m128i Folded = _mm_or_si128(Chunk, _mm_set1_epi8(0x20));
+    __m128i Letters =
+        _mm_and_si128(_mm_cmpgt_epi8(Folded, _mm_set1_epi8('a' - 1)),
+                      _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), Folded));
+    __m128i Digits =
+        _mm_and_si128(_mm_cmpgt_epi8(Chunk, _mm_set1_epi8('0' - 1)),
+                      _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), Chunk));
+    __m128i Underscores = _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('_'));
+    int NotContinue = _mm_movemask_epi8(_mm_or_si128(
+                          _mm_or_si128(Letters, Digits), Underscores)) ^
+                      0xffff;
+    if (NotContinue != 0) {
+      CurPtr += llvm::countTrailingZeros<unsigned>(NotContinue);
+      break;
+    }
+    CurPtr += 16;
+  }
+#endif
   while (true) {
     unsigned char C = *CurPtr;
     // Fast path.
@@ -2082,6 +2115,32 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
 
       NulCharacter = CurPtr-1;
     }
+
+#ifdef __SSE2__
+    // Skip the bulk of ordinary string bytes 16 at a time. Any byte that can
+    // terminate the literal or needs phase-1/2 processing - the quote,
+    // backslash, '?' (trigraphs), newlines and NUL - is left for
+    // getAndAdvanceChar below.
+    while (CurPtr + 16 < BufferEnd) {
+      __m128i Chunk =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(CurPtr));
+      __m128i Special = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('"')),
+                       _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\\'))),
+          _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('?')),
+                       _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\n'))));
+      Special = _mm_or_si128(
+          Special,
+          _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\r')),
+                       _mm_cmpeq_epi8(Chunk, _mm_setzero_si128())));
+      int Mask = _mm_movemask_epi8(Special);
+      if (Mask != 0) {
+        CurPtr += llvm::countTrailingZeros<unsigned>(Mask);
+        break;
+      }
+      CurPtr += 16;
+    }
+#endif
     C = getAndAdvanceChar(CurPtr, Result);
   }
 
@@ -2344,6 +2403,28 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
 
   // Skip consecutive spaces efficiently.
   while (true) {
+#ifdef __SSE2__
+    // Long indentation runs are common; skip spaces and tabs 16 bytes at a
+    // time and leave the first other byte (including the rarer \f and \v) to
+    // the byte-at-a-time loop below.
+    if (Char == ' ' || Char == '\t') {
+      while (CurPtr + 16 < BufferEnd) {
+        __m128i Chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(CurPtr));
+        int NotBlank =
+            _mm_movemask_epi8(
+                _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8(' ')),
+                             _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\t')))) ^
+            0xffff;
+        if (NotBlank != 0) {
+          CurPtr += llvm::countTrailingZeros<unsigned>(NotBlank);
+          break;
+        }
+        CurPtr += 16;
+      }
+      Char = *CurPtr;
+    }
+#endif
     // Skip horizontal whitespace very aggressively.
     while (isHorizontalWhitespace(Char))
       Char = *++CurPtr;
@@ -2668,13 +2749,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
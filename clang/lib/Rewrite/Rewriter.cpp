@@ -20,11 +20,14 @@
 #include "clang/Lex/Lexer.h"
 #include "clang/Rewrite/Core/RewriteBuffer.h"
 #include "clang/Rewrite/Core/RewriteRope.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <map>
@@ -136,6 +139,81 @@ void RewriteBuffer::ReplaceText(unsigned OrigOffset, unsigned OrigLength,
     AddReplaceDelta(OrigOffset, NewStr.size() - OrigLength);
 }
 
+bool RewriteBuffer::ApplyEdits(ArrayRef<BatchEdit> Edits) {
+  if (Edits.empty())
+    return false;
+
+  // Map every edit into the current buffer's offset space up front, then
+  // order them by position.  The stable sort keeps edits at the same offset
+  // in the order the caller provided them, matching what repeated
+  // InsertTextAfter calls would produce.
+  struct MappedEdit {
+    unsigned RealOffset;
+    const BatchEdit *Edit;
+  };
+  SmallVector<MappedEdit, 64> Mapped;
+  Mapped.reserve(Edits.size());
+  for (const BatchEdit &E : Edits)
+    Mapped.push_back({getMappedOffset(E.OrigOffset, /*AfterInserts=*/true), &E});
+  llvm::stable_sort(Mapped, [](const MappedEdit &L, const MappedEdit &R) {
+    return L.RealOffset < R.RealOffset;
+  });
+
+  // Reject out-of-range and overlapping edits before touching the buffer.
+  unsigned LastEnd = 0;
+  uint64_t NewSize = size();
+  for (const MappedEdit &M : Mapped) {
+    if (M.RealOffset < LastEnd || M.RealOffset > size() ||
+        M.Edit->OrigLength > size() - M.RealOffset)
+      return true;
+    LastEnd = M.RealOffset + M.Edit->OrigLength;
+    NewSize += M.Edit->Text.size();
+    NewSize -= M.Edit->OrigLength;
+  }
+
+  // Merge the unmodified spans and the replacement texts into a flat string,
+  // walking the rope by pieces as write() does, and install the result as the
+  // new buffer contents in one step.  The rope is never rebalanced per edit.
+  std::string Result;
+  Result.reserve(NewSize);
+  iterator Piece = begin();
+  unsigned PieceStart = 0;
+  unsigned Pos = 0;
+  auto AdvanceTo = [&](unsigned End, bool Copy) {
+    while (Pos < End) {
+      StringRef Text = Piece.piece();
+      unsigned PieceEnd = PieceStart + Text.size();
+      unsigned N = std::min(End, PieceEnd) - Pos;
+      if (Copy)
+        Result.append(Text.data() + (Pos - PieceStart), N);
+      Pos += N;
+      if (Pos == PieceEnd) {
+        Piece.MoveToNextPiece();
+        PieceStart = PieceEnd;
+      }
+    }
+  };
+  for (const MappedEdit &M : Mapped) {
+    AdvanceTo(M.RealOffset, /*Copy=*/true);
+    Result += M.Edit->Text;
+    AdvanceTo(M.RealOffset + M.Edit->OrigLength, /*Copy=*/false);
+  }
+  AdvanceTo(size(), /*Copy=*/true);
+  Buffer.assign(Result.data(), Result.data() + Result.size());
+
+  // Record the deltas so that future changes are offset correctly.
+  for (const MappedEdit &M : Mapped) {
+    const BatchEdit &E = *M.Edit;
+    if (E.OrigLength == 0) {
+      if (!E.Text.empty())
+        AddInsertDelta(E.OrigOffset, E.Text.size());
+    } else if (E.Text.size() != E.OrigLength) {
+      AddReplaceDelta(E.OrigOffset, int(E.Text.size()) - int(E.OrigLength));
+    }
+  }
+  return false;
+}
+
 //===----------------------------------------------------------------------===//
 // Rewriter class
 //===----------------------------------------------------------------------===//
@@ -5247,11 +5247,14 @@ std::unique_ptr<TypoCorrectionConsumer> Sema::makeTypoCorrectionConsumer(
       (IsUnqualifiedLookup || (SS && SS->isSet()));
 
   if (IsUnqualifiedLookup || SearchNamespaces) {
-    // For unqualified lookup, look through all of the names that we have
-    // seen in this translation unit.
-    // FIXME: Re-add the ability to skip very unlikely potential corrections.
-    for (const auto &I : Context.Idents)
-      Consumer->FoundName(I.getKey());
+    // For unqualified lookup, look through the names that we have seen in
+    // this translation unit, skipping (via the table's by-length partition)
+    // the ones the consumer's edit-distance cutoff is guaranteed to reject.
+    StringRef TypoStr = Typo->getName();
+    unsigned MaxLengthDiff = TypoStr.size() / 3;
+    Context.Idents.forEachIdentifierWithLength(
+        TypoStr.size() - MaxLengthDiff, TypoStr.size() + MaxLengthDiff,
+        [&](const IdentifierInfo &II) { Consumer->FoundName(II.getName()); });
 
     // Walk through identifiers in external identifier sources.
     // FIXME: Re-add the ability to skip very unlikely potential corrections.
@@ -6337,6 +6337,12 @@ void Sema::PerformPendingInstantiations(bool LocalOnly) {
                 CurFD->setInstantiationIsPending(false);
             });
       } else {
+        // The queue may hold duplicates: every use of an explicit
+        // instantiation definition enqueues the specialization again. If an
+        // earlier entry already produced the definition, skip the repeat here
+        // instead of rediscovering that in InstantiateFunctionDefinition().
+        if (Function->isDefined() && !Function->instantiationIsPending())
+          continue;
         InstantiateFunctionDefinition(/*FIXME:*/ Inst.second, Function, true,
                                       DefinitionRequired, true);
         if (Function->isDefined())
@@ -1454,13 +1454,18 @@ bool ASTReader::ReadSLocEntry(int ID) {
     unsigned RecCode = MaybeRecCode.get();
 
     if (RecCode == SM_SLOC_BUFFER_BLOB_COMPRESSED) {
-      if (!llvm::compression::zlib::isAvailable()) {
-        Error("zlib is not available");
+      // Inspect the first byte to differentiate zlib (\x78) from zstd
+      // (little-endian 0xFD2FB528).
+      const llvm::compression::Format F =
+          !Blob.empty() && Blob[0] == 0x78 ? llvm::compression::Format::Zlib
+                                           : llvm::compression::Format::Zstd;
+      if (const char *Reason = llvm::compression::getReasonIfUnsupported(F)) {
+        Error(Reason);
         return nullptr;
       }
       SmallVector<uint8_t, 0> Uncompressed;
-      if (llvm::Error E = llvm::compression::zlib::uncompress(
-              llvm::arrayRefFromStringRef(Blob), Uncompressed, Record[0])) {
+      if (llvm::Error E = llvm::compression::decompress(
+              F, llvm::arrayRefFromStringRef(Blob), Uncompressed, Record[0])) {
         Error("could not decompress embedded file contents: " +
               llvm::toString(std::move(E)));
         return nullptr;
@@ -2001,6 +2006,31 @@ void ASTReader::ReadDefinedMacros() {
 
 namespace {
 
+  /// Populate a module's identifier Bloom filter from the hashes stored in
+  /// its on-disk identifier table. Sized at roughly one byte per identifier
+  /// with two probes per query, for a false-positive rate of about 5%.
+  void buildIdentifierLookupFilter(llvm::BitVector &Filter,
+                                   ASTIdentifierLookupTable &IdTable) {
+    uint64_t NumBits = llvm::PowerOf2Ceil(
+        std::max<uint64_t>(64, uint64_t(IdTable.getNumEntries()) * 8));
+    Filter.resize(NumBits);
+    IdTable.forEachItemHash([&](unsigned ItemHash) {
+      uint64_t H = uint64_t(ItemHash) * 0x9E3779B97F4A7C15ULL;
+      Filter.set(H & (NumBits - 1));
+      Filter.set((H >> 32) & (NumBits - 1));
+    });
+  }
+
+  /// Check whether an identifier hash may be present in a module's
+  /// identifier Bloom filter. False positives are possible, false negatives
+  /// are not.
+  bool identifierLookupFilterMayContain(const llvm::BitVector &Filter,
+                                        unsigned NameHash) {
+    uint64_t H = uint64_t(NameHash) * 0x9E3779B97F4A7C15ULL;
+    uint64_t Mask = Filter.size() - 1;
+    return Filter.test(H & Mask) && Filter.test((H >> 32) & Mask);
+  }
+
   /// Visitor class used to look up identifirs in an AST file.
   class IdentifierLookupVisitor {
     StringRef Name;
@@ -2029,6 +2059,14 @@ namespace {
       if (!IdTable)
         return false;
 
+      // Consult the module's Bloom filter before probing the on-disk hash
+      // table; with many modules loaded most per-module probes are misses.
+      if (M.IdentifierLookupFilter.empty())
+        buildIdentifierLookupFilter(M.IdentifierLookupFilter, *IdTable);
+      if (!identifierLookupFilterMayContain(M.IdentifierLookupFilter,
+                                            NameHash))
+        return false;
+
       ASTIdentifierLookupTrait Trait(IdTable->getInfoObj().getReader(), M,
                                      Found);
       ++NumIdentifierLookups;
@@ -25,13 +25,16 @@ PCHGenerator::PCHGenerator(
     StringRef OutputFile, StringRef isysroot, std::shared_ptr<PCHBuffer> Buffer,
     ArrayRef<std::shared_ptr<ModuleFileExtension>> Extensions,
     bool AllowASTWithErrors, bool IncludeTimestamps,
-    bool ShouldCacheASTInMemory)
+    bool ShouldCacheASTInMemory, llvm::raw_fd_stream *OutputStream)
     : PP(PP), OutputFile(OutputFile), isysroot(isysroot.str()),
-      SemaPtr(nullptr), Buffer(std::move(Buffer)), Stream(this->Buffer->Data),
+      SemaPtr(nullptr), Buffer(std::move(Buffer)),
+      Stream(this->Buffer->Data, OutputStream),
       Writer(Stream, this->Buffer->Data, ModuleCache, Extensions,
              IncludeTimestamps),
       AllowASTWithErrors(AllowASTWithErrors),
       ShouldCacheASTInMemory(ShouldCacheASTInMemory) {
+  assert(!(OutputStream && ShouldCacheASTInMemory) &&
+         "caching the AST in memory requires the complete buffer");
   this->Buffer->IsComplete = false;
 }
 
@@ -37,6 +37,8 @@ InMemoryModuleCache::addBuiltPCM(llvm::StringRef Filename,
   assert(!PCM.Buffer && "Trying to override tentative PCM?");
   PCM.Buffer = std::move(Buffer);
   PCM.IsFinal = true;
+  // Any signature recorded for a previous buffer no longer applies.
+  PCM.Signature = ASTFileSignature();
   return *PCM.Buffer;
 }
 
@@ -48,6 +50,22 @@ InMemoryModuleCache::lookupPCM(llvm::StringRef Filename) const {
   return I->second.Buffer.get();
 }
 
+void InMemoryModuleCache::setPCMSignature(llvm::StringRef Filename,
+                                          ASTFileSignature Signature) {
+  auto I = PCMs.find(Filename);
+  assert(I != PCMs.end() && "PCM to annotate is unknown...");
+  assert(I->second.Buffer && "Trying to annotate a dropped PCM...");
+  I->second.Signature = Signature;
+}
+
+llvm::Optional<ASTFileSignature>
+InMemoryModuleCache::lookupPCMSignature(llvm::StringRef Filename) const {
+  auto I = PCMs.find(Filename);
+  if (I == PCMs.end() || !I->second.Signature)
+    return llvm::None;
+  return I->second.Signature;
+}
+
 bool InMemoryModuleCache::isPCMFinal(llvm::StringRef Filename) const {
   return getPCMState(Filename) == Final;
 }
@@ -67,6 +85,7 @@ bool InMemoryModuleCache::tryToDropPCM(llvm::StringRef Filename) {
     return true;
 
   PCM.Buffer.reset();
+  PCM.Signature = ASTFileSignature();
   return false;
 }
 
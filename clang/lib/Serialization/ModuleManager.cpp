@@ -230,10 +230,20 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
   NewModule->Data = PCHContainerRdr.ExtractPCH(*NewModule->Buffer);
 
   // Read the signature eagerly now so that we can check it.  Avoid calling
-  // ReadSignature unless there's something to check though.
-  if (ExpectedSignature && checkSignature(ReadSignature(NewModule->Data),
-                                          ExpectedSignature, ErrorStr))
-    return OutOfDate;
+  // ReadSignature unless there's something to check though.  A reader that
+  // shares the in-memory module cache may already have scanned the signature
+  // out of this buffer; reuse it rather than walking the control block again.
+  if (ExpectedSignature) {
+    ASTFileSignature Signature;
+    if (auto CachedSignature = getModuleCache().lookupPCMSignature(FileName)) {
+      Signature = *CachedSignature;
+    } else {
+      Signature = ReadSignature(NewModule->Data);
+      getModuleCache().setPCMSignature(FileName, Signature);
+    }
+    if (checkSignature(Signature, ExpectedSignature, ErrorStr))
+      return OutOfDate;
+  }
 
   // We're keeping this module.  Store it everywhere.
   Module = Modules[Entry] = NewModule.get();
@@ -34,11 +34,28 @@ static void reportAsFatalIfError(llvm::Error E) {
 
 using llvm::Error;
 
+const DependencyDirectivesSharedCache::ScannedDirectives *
+DependencyDirectivesSharedCache::get(llvm::cas::ObjectRef ID) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto I = Cache.find(ID);
+  if (I == Cache.end())
+    return nullptr;
+  return I->second.get();
+}
+
+const DependencyDirectivesSharedCache::ScannedDirectives *
+DependencyDirectivesSharedCache::add(llvm::cas::ObjectRef ID,
+                                     std::unique_ptr<ScannedDirectives> SD) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return Cache.try_emplace(ID, std::move(SD)).first->second.get();
+}
+
 DependencyScanningCASFilesystem::DependencyScanningCASFilesystem(
     IntrusiveRefCntPtr<llvm::cas::CachingOnDiskFileSystem> WorkerFS,
-    llvm::cas::ActionCache &Cache)
-    : FS(WorkerFS), Entries(EntryAlloc), CAS(WorkerFS->getCAS()), Cache(Cache) {
-}
+    llvm::cas::ActionCache &Cache,
+    DependencyDirectivesSharedCache &SharedDirectives)
+    : FS(WorkerFS), Entries(EntryAlloc), CAS(WorkerFS->getCAS()), Cache(Cache),
+      SharedDirectives(SharedDirectives) {}
 
 DependencyScanningCASFilesystem::~DependencyScanningCASFilesystem() = default;
 
@@ -133,13 +150,16 @@ static Error loadDepDirectives(
   return Error::success();
 }
 
-void DependencyScanningCASFilesystem::scanForDirectives(
-    llvm::cas::ObjectRef InputDataID, StringRef Identifier,
-    SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
-    SmallVectorImpl<dependency_directives_scan::Directive> &Directives) {
+const DependencyDirectivesSharedCache::ScannedDirectives *
+DependencyScanningCASFilesystem::scanForDirectives(
+    llvm::cas::ObjectRef InputDataID, StringRef Identifier) {
   using namespace llvm;
   using namespace llvm::cas;
 
+  // Another worker may already have scanned this content blob.
+  if (const auto *Cached = SharedDirectives.get(InputDataID))
+    return Cached;
+
   // Get a blob for the clang version string.
   if (!ClangFullVersionID)
     ClangFullVersionID =
@@ -165,31 +185,37 @@ void DependencyScanningCASFilesystem::scanForDirectives(
     InputID = reportAsFatalIfError(Builder.create(CAS)).getID();
   }
 
+  // Allocate the result up front; Directives reference Tokens, so the entry
+  // must never move once filled in.
+  auto SD = std::make_unique<DependencyDirectivesSharedCache::ScannedDirectives>();
+
   // Check the result cache.
   if (Optional<ObjectRef> OutputRef =
           reportAsFatalIfError(Cache.get(*InputID))) {
     reportAsFatalIfError(
-        loadDepDirectives(CAS, *OutputRef, Tokens, Directives));
-    return;
+        loadDepDirectives(CAS, *OutputRef, SD->Tokens, SD->Directives));
+    return SharedDirectives.add(InputDataID, std::move(SD));
   }
 
   StringRef InputData =
       reportAsFatalIfError(CAS.getProxy(InputDataID)).getData();
 
-  if (scanSourceForDependencyDirectives(InputData, Tokens, Directives)) {
+  if (scanSourceForDependencyDirectives(InputData, SD->Tokens,
+                                        SD->Directives)) {
     // FIXME: Propagate the diagnostic if desired by the client.
     // Failure. Cache empty directives.
-    Tokens.clear();
-    Directives.clear();
+    SD->Tokens.clear();
+    SD->Directives.clear();
     reportAsFatalIfError(Cache.put(*InputID, *EmptyBlobID));
-    return;
+    return SharedDirectives.add(InputDataID, std::move(SD));
   }
 
   // Success. Add to the CAS and get back persistent output data.
   cas::ObjectRef DirectivesID =
-      reportAsFatalIfError(storeDepDirectives(CAS, Directives));
+      reportAsFatalIfError(storeDepDirectives(CAS, SD->Directives));
   // Cache the computation.
   reportAsFatalIfError(Cache.put(*InputID, DirectivesID));
+  return SharedDirectives.add(InputDataID, std::move(SD));
 }
 
 Expected<StringRef>
@@ -275,8 +301,7 @@ DependencyScanningCASFilesystem::lookupPath(const Twine &Path) {
   }
 
   if (shouldScanForDirectives(PathRef))
-    scanForDirectives(*CAS.getReference(*FileID), PathRef, Entry.DepTokens,
-                      Entry.DepDirectives);
+    Entry.Directives = scanForDirectives(*CAS.getReference(*FileID), PathRef);
 
   Entry.Buffer = std::move(*Buffer);
   Entry.Status = llvm::vfs::Status(
@@ -360,7 +385,7 @@ DependencyScanningCASFilesystem::getDirectiveTokens(const Twine &Path) const {
     return None;
 
   const FileEntry &Entry = I->second;
-  if (Entry.DepDirectives.empty())
+  if (!Entry.Directives || Entry.Directives->Directives.empty())
     return None;
-  return llvm::makeArrayRef(Entry.DepDirectives);
+  return llvm::makeArrayRef(Entry.Directives->Directives);
 }
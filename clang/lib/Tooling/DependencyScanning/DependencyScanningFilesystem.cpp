@@ -10,6 +10,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/xxhash.h"
 
 using namespace clang;
 using namespace tooling;
@@ -141,21 +142,30 @@ DependencyScanningFilesystemSharedCache::CacheShard::
 const CachedFileSystemEntry &
 DependencyScanningFilesystemSharedCache::CacheShard::getOrEmplaceEntryForUID(
     llvm::sys::fs::UniqueID UID, llvm::vfs::Status Stat,
-    std::unique_ptr<llvm::MemoryBuffer> Contents,
-    Optional<cas::ObjectRef> CASContents) {
+    CachedFileContents *Contents) {
   std::lock_guard<std::mutex> LockGuard(CacheLock);
   auto Insertion = EntriesByUID.insert({UID, nullptr});
-  if (Insertion.second) {
-    CachedFileContents *StoredContents = nullptr;
-    if (Contents)
-      StoredContents = new (ContentsStorage.Allocate())
-          CachedFileContents(std::move(Contents), std::move(CASContents));
+  if (Insertion.second)
     Insertion.first->second = new (EntryStorage.Allocate())
-        CachedFileSystemEntry(std::move(Stat), StoredContents);
-  }
+        CachedFileSystemEntry(std::move(Stat), Contents);
   return *Insertion.first->second;
 }
 
+CachedFileContents &DependencyScanningFilesystemSharedCache::getOrCreateContents(
+    std::unique_ptr<llvm::MemoryBuffer> Contents,
+    Optional<cas::ObjectRef> CASContents) {
+  uint64_t Hash = llvm::xxHash64(Contents->getBuffer());
+  std::lock_guard<std::mutex> LockGuard(ContentsLock);
+  llvm::TinyPtrVector<CachedFileContents *> &Bucket = ContentsByHash[Hash];
+  for (CachedFileContents *Existing : Bucket)
+    if (Existing->Original->getBuffer() == Contents->getBuffer())
+      return *Existing;
+  auto *New = new (ContentsStorage.Allocate())
+      CachedFileContents(std::move(Contents), std::move(CASContents));
+  Bucket.push_back(New);
+  return *New;
+}
+
 const CachedFileSystemEntry &
 DependencyScanningFilesystemSharedCache::CacheShard::
     getOrInsertEntryForFilename(StringRef Filename,
@@ -198,10 +208,13 @@ bool DependencyScanningWorkerFilesystem::shouldScanForDirectives(
 const CachedFileSystemEntry &
 DependencyScanningWorkerFilesystem::getOrEmplaceSharedEntryForUID(
     TentativeEntry TEntry) {
+  CachedFileContents *Contents = nullptr;
+  if (TEntry.Contents)
+    Contents = &SharedCache.getOrCreateContents(std::move(TEntry.Contents),
+                                                std::move(TEntry.CASContents));
   auto &Shard = SharedCache.getShardForUID(TEntry.Status.getUniqueID());
-  return Shard.getOrEmplaceEntryForUID(
-      TEntry.Status.getUniqueID(), std::move(TEntry.Status),
-      std::move(TEntry.Contents), std::move(TEntry.CASContents));
+  return Shard.getOrEmplaceEntryForUID(TEntry.Status.getUniqueID(),
+                                       std::move(TEntry.Status), Contents);
 }
 
 const CachedFileSystemEntry *
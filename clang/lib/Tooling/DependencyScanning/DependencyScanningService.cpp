@@ -26,6 +26,8 @@ DependencyScanningService::DependencyScanningService(
       SharedFS(std::move(SharedFS)), EagerLoadModules(EagerLoadModules) {
   if (!this->SharedFS)
     SharedCache.emplace();
+  else
+    SharedDirectivesCache.emplace();
 
   // Initialize targets for object file support.
   llvm::InitializeAllTargets();
@@ -473,8 +473,8 @@ DependencyScanningWorker::DependencyScanningWorker(
 
   if (Service.getMode() == ScanningMode::DependencyDirectivesScan) {
     if (Service.useCASScanning())
-      DepCASFS =
-          new DependencyScanningCASFilesystem(CacheFS, Service.getCache());
+      DepCASFS = new DependencyScanningCASFilesystem(
+          CacheFS, Service.getCache(), Service.getSharedDirectivesCache());
     else
       DepFS = new DependencyScanningWorkerFilesystem(Service.getSharedCache(),
                                                      RealFS);
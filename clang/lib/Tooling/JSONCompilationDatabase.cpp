@@ -24,7 +24,10 @@
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -33,6 +36,7 @@
 #include "llvm/Support/YAMLParser.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <system_error>
@@ -189,10 +193,30 @@ volatile int JSONAnchorSource = 0;
 } // namespace tooling
 } // namespace clang
 
+// Sidecar index file format: a fixed header followed by one record per
+// database entry. All integers are little-endian.
+static const char IndexFileMagic[4] = {'C', 'C', 'I', 'X'};
+static const uint32_t IndexFileVersion = 1;
+
+// Databases smaller than this parse quickly enough that an index is not worth
+// the extra file next to them.
+static const uint64_t MinDatabaseSizeForIndex = 1 << 20;
+
+static uint64_t modificationTimeNanos(const llvm::sys::fs::file_status &S) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             S.getLastModificationTime().time_since_epoch())
+      .count();
+}
+
 std::unique_ptr<JSONCompilationDatabase>
 JSONCompilationDatabase::loadFromFile(StringRef FilePath,
                                       std::string &ErrorMessage,
                                       JSONCommandLineSyntax Syntax) {
+  // A valid sidecar index lets us serve lookups without parsing the whole
+  // database.
+  if (auto Database = loadThroughIndex(FilePath, Syntax))
+    return Database;
+
   // Don't mmap: if we're a long-lived process, the build system may overwrite.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> DatabaseBuffer =
       llvm::MemoryBuffer::getFile(FilePath, /*IsText=*/false,
@@ -206,6 +230,8 @@ JSONCompilationDatabase::loadFromFile(StringRef FilePath,
       new JSONCompilationDatabase(std::move(*DatabaseBuffer), Syntax));
   if (!Database->parse(ErrorMessage))
     return nullptr;
+  if (Database->Database->getBufferSize() >= MinDatabaseSizeForIndex)
+    Database->writeIndexFile(FilePath);
   return Database;
 }
 
@@ -222,6 +248,150 @@ JSONCompilationDatabase::loadFromBuffer(StringRef DatabaseString,
   return Database;
 }
 
+std::unique_ptr<JSONCompilationDatabase>
+JSONCompilationDatabase::loadThroughIndex(StringRef FilePath,
+                                          JSONCommandLineSyntax Syntax) {
+  SmallString<128> IndexPath(FilePath);
+  IndexPath += ".idx";
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> IndexBuffer =
+      llvm::MemoryBuffer::getFile(IndexPath, /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false,
+                                  /*IsVolatile=*/true);
+  if (!IndexBuffer)
+    return nullptr;
+
+  StringRef Data = (*IndexBuffer)->getBuffer();
+  const char *P = Data.begin(), *End = Data.end();
+  auto ReadU32 = [&](uint32_t &V) {
+    if (size_t(End - P) < sizeof(uint32_t))
+      return false;
+    V = llvm::support::endian::read<uint32_t, llvm::support::little,
+                                    llvm::support::unaligned>(P);
+    P += sizeof(uint32_t);
+    return true;
+  };
+  auto ReadU64 = [&](uint64_t &V) {
+    if (size_t(End - P) < sizeof(uint64_t))
+      return false;
+    V = llvm::support::endian::read<uint64_t, llvm::support::little,
+                                    llvm::support::unaligned>(P);
+    P += sizeof(uint64_t);
+    return true;
+  };
+
+  if (size_t(End - P) < sizeof(IndexFileMagic) ||
+      memcmp(P, IndexFileMagic, sizeof(IndexFileMagic)) != 0)
+    return nullptr;
+  P += sizeof(IndexFileMagic);
+
+  uint32_t Version;
+  uint64_t DatabaseSize, DatabaseMTime, NumEntries;
+  if (!ReadU32(Version) || Version != IndexFileVersion ||
+      !ReadU64(DatabaseSize) || !ReadU64(DatabaseMTime) ||
+      !ReadU64(NumEntries))
+    return nullptr;
+
+  // The index is only usable while the database it was built from is
+  // unchanged.
+  llvm::sys::fs::file_status Status;
+  if (llvm::sys::fs::status(FilePath, Status) ||
+      Status.getSize() != DatabaseSize ||
+      modificationTimeNanos(Status) != DatabaseMTime)
+    return nullptr;
+
+  std::unique_ptr<JSONCompilationDatabase> Database(new JSONCompilationDatabase(
+      llvm::MemoryBuffer::getMemBuffer(""), Syntax));
+  Database->LazyDatabasePath = std::string(FilePath);
+  for (uint64_t I = 0; I != NumEntries; ++I) {
+    uint32_t PathLen;
+    EntryRange Range;
+    if (!ReadU32(PathLen) || !ReadU64(Range.Offset) || !ReadU64(Range.Length))
+      return nullptr;
+    if (size_t(End - P) < PathLen || Range.Length > DatabaseSize ||
+        Range.Offset > DatabaseSize - Range.Length)
+      return nullptr;
+    StringRef Path(P, PathLen);
+    P += PathLen;
+    auto &Ranges = Database->LazyIndexByFile[Path];
+    if (Ranges.empty())
+      Database->MatchTrie.insert(Path);
+    Ranges.push_back(Range);
+  }
+  if (P != End)
+    return nullptr;
+  return Database;
+}
+
+void JSONCompilationDatabase::writeIndexFile(StringRef FilePath) const {
+  // Bail out if the source range of some entry could not be determined.
+  if (ParsedEntryRanges.size() != AllCommands.size())
+    return;
+  llvm::sys::fs::file_status Status;
+  if (llvm::sys::fs::status(FilePath, Status))
+    return;
+
+  SmallString<128> IndexPath(FilePath);
+  IndexPath += ".idx";
+  SmallString<128> TempPath(IndexPath);
+  TempPath += ".tmp-%%%%%%";
+  int FD;
+  SmallString<128> ResultPath;
+  if (llvm::sys::fs::createUniqueFile(TempPath, FD, ResultPath))
+    return;
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    llvm::support::endian::Writer W(OS, llvm::support::little);
+    OS.write(IndexFileMagic, sizeof(IndexFileMagic));
+    W.write<uint32_t>(IndexFileVersion);
+    W.write<uint64_t>(Status.getSize());
+    W.write<uint64_t>(modificationTimeNanos(Status));
+    W.write<uint64_t>(ParsedEntryRanges.size());
+    for (const auto &Entry : ParsedEntryRanges) {
+      W.write<uint32_t>(uint32_t(Entry.first.size()));
+      W.write<uint64_t>(Entry.second.Offset);
+      W.write<uint64_t>(Entry.second.Length);
+      OS << Entry.first;
+    }
+    if (OS.has_error()) {
+      OS.clear_error();
+      OS.close();
+      llvm::sys::fs::remove(ResultPath);
+      return;
+    }
+  }
+  // Publish atomically so concurrent tools never see a partial index.
+  if (llvm::sys::fs::rename(ResultPath, IndexPath))
+    llvm::sys::fs::remove(ResultPath);
+}
+
+std::vector<CompileCommand> JSONCompilationDatabase::getCommandsFromRanges(
+    ArrayRef<EntryRange> Ranges) const {
+  std::vector<CompileCommand> Commands;
+  for (const EntryRange &Range : Ranges) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> SliceBuffer =
+        llvm::MemoryBuffer::getFileSlice(LazyDatabasePath, Range.Length,
+                                         Range.Offset, /*IsVolatile=*/true);
+    if (!SliceBuffer)
+      continue;
+    // The range extends to the start of the next entry; strip the object
+    // separator it sweeps in and, for the last entry, the array terminator.
+    StringRef Slice = (*SliceBuffer)->getBuffer().rtrim();
+    Slice.consume_back("]");
+    Slice = Slice.rtrim();
+    Slice.consume_back(",");
+    Slice = Slice.rtrim();
+    if (!Slice.endswith("}"))
+      continue;
+    // Wrap the single object back into an array and reuse the normal parser.
+    std::string Error;
+    auto Entry = loadFromBuffer(("[" + Slice + "]").str(), Error, Syntax);
+    if (!Entry)
+      continue;
+    llvm::append_range(Commands, Entry->getAllCompileCommands());
+  }
+  return Commands;
+}
+
 std::vector<CompileCommand>
 JSONCompilationDatabase::getCompileCommands(StringRef FilePath) const {
   SmallString<128> NativeFilePath;
@@ -232,6 +402,12 @@ JSONCompilationDatabase::getCompileCommands(StringRef FilePath) const {
   StringRef Match = MatchTrie.findEquivalent(NativeFilePath, ES);
   if (Match.empty())
     return {};
+  if (isLazy()) {
+    const auto RangesI = LazyIndexByFile.find(Match);
+    if (RangesI == LazyIndexByFile.end())
+      return {};
+    return getCommandsFromRanges(RangesI->getValue());
+  }
   const auto CommandsRefI = IndexByFile.find(Match);
   if (CommandsRefI == IndexByFile.end())
     return {};
@@ -243,6 +419,11 @@ JSONCompilationDatabase::getCompileCommands(StringRef FilePath) const {
 std::vector<std::string>
 JSONCompilationDatabase::getAllFiles() const {
   std::vector<std::string> Result;
+  if (isLazy()) {
+    for (const auto &Ranges : LazyIndexByFile)
+      Result.push_back(Ranges.first().str());
+    return Result;
+  }
   for (const auto &CommandRef : IndexByFile)
     Result.push_back(CommandRef.first().str());
   return Result;
@@ -250,6 +431,20 @@ JSONCompilationDatabase::getAllFiles() const {
 
 std::vector<CompileCommand>
 JSONCompilationDatabase::getAllCompileCommands() const {
+  if (isLazy()) {
+    // Tools that really want everything pay for the full parse.
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+        llvm::MemoryBuffer::getFile(LazyDatabasePath, /*IsText=*/false,
+                                    /*RequiresNullTerminator=*/true,
+                                    /*IsVolatile=*/true);
+    if (!Buffer)
+      return {};
+    std::string Error;
+    auto Full = loadFromBuffer((*Buffer)->getBuffer(), Error, Syntax);
+    if (!Full)
+      return {};
+    return Full->getAllCompileCommands();
+  }
   std::vector<CompileCommand> Commands;
   getCommands(AllCommands, Commands);
   return Commands;
@@ -431,6 +626,21 @@ bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
     IndexByFile[NativeFilePath].push_back(Cmd);
     AllCommands.push_back(Cmd);
     MatchTrie.insert(NativeFilePath);
+    // Record where this entry starts so loadFromFile() can emit the sidecar
+    // index. Lengths are filled in below: the parser does not track mapping
+    // end positions, so each entry extends to the start of the next one.
+    const char *ObjectStart = NextObject.getSourceRange().Start.getPointer();
+    if (ObjectStart >= Database->getBufferStart() &&
+        ObjectStart < Database->getBufferEnd())
+      ParsedEntryRanges.emplace_back(
+          std::string(NativeFilePath),
+          EntryRange{uint64_t(ObjectStart - Database->getBufferStart()), 0});
+  }
+  for (size_t I = 0, E = ParsedEntryRanges.size(); I != E; ++I) {
+    uint64_t EntryEnd = I + 1 != E ? ParsedEntryRanges[I + 1].second.Offset
+                                   : Database->getBufferSize();
+    ParsedEntryRanges[I].second.Length =
+        EntryEnd - ParsedEntryRanges[I].second.Offset;
   }
   return true;
 }
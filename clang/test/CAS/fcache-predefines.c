@@ -0,0 +1,26 @@
+// RUN: rm -rf %t && mkdir -p %t
+//
+// Cold cache: the predefines buffer is built normally and stored.
+// RUN: %clang -cc1 -triple x86_64-apple-macos11 \
+// RUN:   -fcas-path %t/cas -faction-cache-path %t/cache -fcache-predefines \
+// RUN:   -DCACHED_MACRO=1 -E %s -o %t/cold.i
+//
+// Warm cache: the stored buffer is reused; the output must be identical.
+// RUN: %clang -cc1 -triple x86_64-apple-macos11 \
+// RUN:   -fcas-path %t/cas -faction-cache-path %t/cache -fcache-predefines \
+// RUN:   -DCACHED_MACRO=1 -E %s -o %t/warm.i
+// RUN: diff %t/cold.i %t/warm.i
+//
+// The cached buffer must match what an uncached invocation produces.
+// RUN: %clang -cc1 -triple x86_64-apple-macos11 \
+// RUN:   -DCACHED_MACRO=1 -E %s -o %t/uncached.i
+// RUN: diff %t/uncached.i %t/warm.i
+//
+// A different invocation must not reuse the buffer.
+// RUN: %clang -cc1 -triple x86_64-apple-macos11 \
+// RUN:   -fcas-path %t/cas -faction-cache-path %t/cache -fcache-predefines \
+// RUN:   -DCACHED_MACRO=2 -E %s -o %t/other.i
+// RUN: not diff %t/warm.i %t/other.i
+
+int value = CACHED_MACRO;
+int gnuc = __GNUC__;
@@ -816,10 +816,14 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
                                                     Argv, Diags, Argv0);
 
   if (Clang->getFrontendOpts().TimeTrace ||
-      !Clang->getFrontendOpts().TimeTracePath.empty()) {
+      !Clang->getFrontendOpts().TimeTracePath.empty() ||
+      Clang->getFrontendOpts().TimeTraceSampleInterval != 0) {
     Clang->getFrontendOpts().TimeTrace = 1;
     llvm::timeTraceProfilerInitialize(
         Clang->getFrontendOpts().TimeTraceGranularity, Argv0);
+    if (unsigned SampleInterval =
+            Clang->getFrontendOpts().TimeTraceSampleInterval)
+      llvm::timeTraceProfilerEnableSampling(SampleInterval);
   }
   // --print-supported-cpus takes priority over the actual compilation.
   if (Clang->getFrontendOpts().PrintSupportedCPUs)
@@ -883,7 +887,10 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
 
   if (llvm::timeTraceProfilerEnabled()) {
     SmallString<128> Path(Clang->getFrontendOpts().OutputFile);
-    llvm::sys::path::replace_extension(Path, "json");
+    // Sampling mode emits collapsed stacks rather than a JSON trace.
+    llvm::sys::path::replace_extension(
+        Path, Clang->getFrontendOpts().TimeTraceSampleInterval ? "folded"
+                                                               : "json");
     if (!Clang->getFrontendOpts().TimeTracePath.empty()) {
       // replace the suffix to '.json' directly
       SmallString<128> TracePath(Clang->getFrontendOpts().TimeTracePath);
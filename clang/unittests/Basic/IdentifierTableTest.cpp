@@ -0,0 +1,84 @@
+//===- unittests/Basic/IdentifierTableTest.cpp - IdentifierTable tests ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/IdentifierTable.h"
+#include "llvm/ADT/StringSet.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+
+namespace {
+
+llvm::StringSet<> collectWithLength(IdentifierTable &Table, unsigned MinLength,
+                                    unsigned MaxLength) {
+  llvm::StringSet<> Names;
+  Table.forEachIdentifierWithLength(
+      MinLength, MaxLength,
+      [&](const IdentifierInfo &II) { Names.insert(II.getName()); });
+  return Names;
+}
+
+TEST(IdentifierTableTest, forEachIdentifierWithLength) {
+  IdentifierTable Table;
+  Table.get("a");
+  Table.get("ab");
+  Table.get("abc");
+  Table.get("abcd");
+
+  // Only identifiers in the requested length range are visited.
+  llvm::StringSet<> Names = collectWithLength(Table, 2, 3);
+  EXPECT_EQ(Names.size(), 2u);
+  EXPECT_TRUE(Names.contains("ab"));
+  EXPECT_TRUE(Names.contains("abc"));
+
+  Names = collectWithLength(Table, 1, 1);
+  EXPECT_EQ(Names.size(), 1u);
+  EXPECT_TRUE(Names.contains("a"));
+}
+
+TEST(IdentifierTableTest, forEachIdentifierWithLengthIncremental) {
+  IdentifierTable Table;
+  Table.get("first");
+
+  // Build the partition, then add more identifiers; the partition should see
+  // them without being rebuilt.
+  llvm::StringSet<> Names = collectWithLength(Table, 5, 6);
+  EXPECT_EQ(Names.size(), 1u);
+
+  Table.get("second");
+  Table.getOwn("third");
+  Names = collectWithLength(Table, 5, 6);
+  EXPECT_EQ(Names.size(), 3u);
+  EXPECT_TRUE(Names.contains("first"));
+  EXPECT_TRUE(Names.contains("second"));
+  EXPECT_TRUE(Names.contains("third"));
+
+  // Looking up an existing identifier must not duplicate it.
+  Table.get("first");
+  Names = collectWithLength(Table, 5, 5);
+  EXPECT_EQ(Names.size(), 1u);
+}
+
+TEST(IdentifierTableTest, forEachIdentifierWithLengthLongNames) {
+  IdentifierTable Table;
+  std::string Long(100, 'x');
+  std::string Longer(200, 'y');
+  Table.get(Long);
+  Table.get(Longer);
+  Table.get("short");
+
+  // Lengths past the last bucket are not distinguished from each other, but
+  // are still separated from short identifiers.
+  llvm::StringSet<> Names = collectWithLength(Table, 100, 100);
+  EXPECT_EQ(Names.size(), 2u);
+  EXPECT_TRUE(Names.contains(Long));
+  EXPECT_TRUE(Names.contains(Longer));
+  EXPECT_FALSE(Names.contains("short"));
+}
+
+} // namespace
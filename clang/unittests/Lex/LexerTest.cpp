@@ -659,4 +659,22 @@ TEST_F(LexerTest, RawAndNormalLexSameForLineComments) {
   }
   EXPECT_TRUE(ToksView.empty());
 }
+
+TEST_F(LexerTest, LexLongTokenRuns) {
+  // Exercise the chunked scanning fast paths for identifiers, whitespace
+  // runs and string literals, including runs that are not multiples of the
+  // chunk size and characters that force the byte-at-a-time slow path.
+  std::string LongId(100, 'x');
+  std::string Spaces(50, ' ');
+  std::string LongString = "\"" + std::string(70, 's') + "\"";
+  std::string Source =
+      LongId + Spaces + "\t\v" + LongString + "\n" + LongId + "1_23" + "\n" +
+      "\"esc\\\"aped and long tail aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\"";
+  std::vector<Token> Toks =
+      CheckLex(Source, {tok::identifier, tok::string_literal, tok::identifier,
+                        tok::string_literal});
+  EXPECT_EQ(LongId, getSourceText(Toks[0], Toks[0]));
+  EXPECT_EQ(LongString, getSourceText(Toks[1], Toks[1]));
+  EXPECT_EQ(LongId + "1_23", getSourceText(Toks[2], Toks[2]));
+}
 } // anonymous namespace
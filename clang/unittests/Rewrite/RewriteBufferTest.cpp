@@ -53,6 +53,35 @@ TEST(RewriteBuffer, TagRanges) {
   EXPECT_OUTPUT(Buf, Output);
 }
 
+TEST(RewriteBuffer, ApplyEdits) {
+  StringRef Input = "abc def ghi jkl";
+  RewriteBuffer Buf;
+  Buf.Initialize(Input);
+
+  // Batched edits compose with prior incremental edits.
+  Buf.InsertText(0, ">");
+
+  // Out of order on purpose; replacement, removal and insertion mixed.
+  std::vector<RewriteBuffer::BatchEdit> Edits;
+  Edits.push_back({(unsigned)Input.find("ghi"), 3, "GHI"});
+  Edits.push_back({(unsigned)Input.find("def "), 4, ""});
+  Edits.push_back({(unsigned)Input.size(), 0, "<"});
+  EXPECT_FALSE(Buf.ApplyEdits(Edits));
+  EXPECT_OUTPUT(Buf, ">abc GHI jkl<");
+
+  // Overlapping edits are rejected and leave the buffer untouched.
+  std::vector<RewriteBuffer::BatchEdit> Bad;
+  Bad.push_back({0, 5, "x"});
+  Bad.push_back({4, 5, "y"});
+  EXPECT_TRUE(Buf.ApplyEdits(Bad));
+  EXPECT_OUTPUT(Buf, ">abc GHI jkl<");
+
+  // Later incremental edits see correctly remapped offsets.
+  StringRef TagStr = "jkl";
+  Buf.ReplaceText(Input.find(TagStr), TagStr.size(), "JKL");
+  EXPECT_OUTPUT(Buf, ">abc GHI JKL<");
+}
+
 TEST(RewriteBuffer, DISABLED_RemoveLineIfEmpty_XFAIL) {
   StringRef Input = "def\n"
                     "ghi\n"
@@ -58,6 +58,17 @@ const char *__memprof_default_options(void);
 /// \returns 0 on success.
 int __memprof_profile_dump(void);
 
+/// Appends the profile records accumulated for deallocated memory so far to
+/// the current profile file and drains them from memory. Unlike
+/// __memprof_profile_dump, live allocations are not recorded; they are
+/// profiled when deallocated or at exit. Periodically flushing keeps the
+/// profiler's memory usage bounded in long-running processes, and the
+/// appended chunks are merged when the profile is read. Only meaningful with
+/// the raw binary serialization format.
+///
+/// \returns 0 on success.
+int __memprof_profile_flush(void);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
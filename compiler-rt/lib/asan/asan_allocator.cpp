@@ -336,6 +336,8 @@ struct Allocator {
   void InitLinkerInitialized(const AllocatorOptions &options) {
     SetAllocatorMayReturnNull(options.may_return_null);
     allocator.InitLinkerInitialized(options.release_to_os_interval_ms);
+    if (common_flags()->allocator_percpu_caches)
+      allocator.EnablePerCpuCaches();
     SharedInitCode(options);
     max_user_defined_malloc_size = common_flags()->max_allocation_size_mb
                                        ? common_flags()->max_allocation_size_mb
@@ -22,6 +22,7 @@
 #include "profile/MemProfData.inc"
 #include "sanitizer_common/sanitizer_allocator_checks.h"
 #include "sanitizer_common/sanitizer_allocator_interface.h"
+#include "sanitizer_common/sanitizer_allocator_internal.h"
 #include "sanitizer_common/sanitizer_allocator_report.h"
 #include "sanitizer_common/sanitizer_errno.h"
 #include "sanitizer_common/sanitizer_file.h"
@@ -258,12 +259,19 @@ struct Allocator {
   // Holds the mapping of stack ids to MemInfoBlocks.
   MIBMapTy MIBMap;
 
+  // Timestamp (ms since profiler init) of the last incremental flush.
+  atomic_uint64_t last_flush_time_ms;
+  // Serializes profile writes so that chunks appended to the profile file by
+  // concurrent flushes do not interleave.
+  StaticSpinMutex flush_mutex;
+
   atomic_uint8_t destructing;
   atomic_uint8_t constructed;
   bool print_text;
 
   // ------------------- Initialization ------------------------
   explicit Allocator(LinkerInitialized) : print_text(flags()->print_text) {
+    atomic_store_relaxed(&last_flush_time_ms, 0);
     atomic_store_relaxed(&destructing, 0);
     atomic_store_relaxed(&constructed, 1);
   }
@@ -295,6 +303,7 @@ struct Allocator {
     } else {
       // Serialize the contents to a raw profile. Format documented in
       // memprof_rawprofile.h.
+      SpinMutexLock l(&flush_mutex);
       char *Buffer = nullptr;
 
       MemoryMappingLayout Layout(/*cache_enabled=*/true);
@@ -306,6 +315,37 @@ struct Allocator {
     allocator.ForceUnlock();
   }
 
+  // Appends the MIBs recorded so far to the profile file as a self-contained
+  // raw profile chunk and drains them from memory; the raw profile reader
+  // merges the chunks by stack id. Live chunks are not recorded here, they
+  // are picked up either when they are deallocated or by InsertLiveBlocks at
+  // exit, so flushing any number of times does not double count.
+  void FlushDeallocatedMIBs() {
+    SpinMutexLock l(&flush_mutex);
+    char *Buffer = nullptr;
+
+    MemoryMappingLayout Layout(/*cache_enabled=*/true);
+    u64 BytesSerialized = SerializeToRawProfile(MIBMap, Layout, Buffer);
+    CHECK(Buffer && BytesSerialized && "could not serialize to buffer");
+    report_file.Write(Buffer, BytesSerialized);
+    InternalFree(Buffer);
+  }
+
+  void MaybeFlushAtInterval() {
+    const int interval_ms = flags()->dump_interval_ms;
+    if (interval_ms <= 0 || print_text)
+      return;
+    const u64 now = static_cast<u64>(GetTimestamp());
+    u64 last = atomic_load_relaxed(&last_flush_time_ms);
+    if (now < last + static_cast<u64>(interval_ms))
+      return;
+    // Whichever thread wins the race to bump the timestamp does the flush.
+    if (!atomic_compare_exchange_strong(&last_flush_time_ms, &last, now,
+                                        memory_order_relaxed))
+      return;
+    FlushDeallocatedMIBs();
+  }
+
   // Inserts any blocks which have been allocated but not yet deallocated.
   void InsertLiveBlocks() {
     allocator.ForEachChunk(
@@ -456,6 +496,7 @@ struct Allocator {
       MemInfoBlock newMIB(user_requested_size, c, m->timestamp_ms, curtime,
                           m->cpu_id, GetCpuId());
       InsertOrMerge(m->alloc_context_id, newMIB, MIBMap);
+      MaybeFlushAtInterval();
     }
 
     MemprofStats &thread_stats = GetCurrentThreadStats();
@@ -710,3 +751,10 @@ int __memprof_profile_dump() {
   // detected during the dumping process.
   return 0;
 }
+
+int __memprof_profile_flush() {
+  instance.FlushDeallocatedMIBs();
+  // In the future we may want to return non-zero if there are any errors
+  // detected during the flushing process.
+  return 0;
+}
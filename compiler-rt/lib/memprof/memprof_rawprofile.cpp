@@ -154,8 +154,12 @@ void SerializeMIBInfoToBuffer(MIBMapTy &MIBMap, const Vector<u64> &StackIds,
     const u64 Key = StackIds[i];
     MIBMapTy::Handle h(&MIBMap, Key, /*remove=*/true, /*create=*/false);
     CHECK(h.exists());
+    LockedMemInfoBlock *lmib = *h;
     Ptr = WriteBytes(Key, Ptr);
-    Ptr = WriteBytes((*h)->mib, Ptr);
+    Ptr = WriteBytes(lmib->mib, Ptr);
+    // The entry has been removed from the map above; release its memory so
+    // that repeated incremental flushes keep the memory usage bounded.
+    InternalFree(lmib);
   }
 
   CHECK(ExpectedNumBytes >= static_cast<u64>(Ptr - Buffer) &&
@@ -235,6 +235,220 @@ static int mmapForContinuousMode(uint64_t CurrentFileOffset, FILE *File) {
 }
 #endif
 
+#if defined(__ELF__) && !defined(_WIN32)
+/* Asynchronous counter flushing, layered on top of bias-mode continuous mode.
+ * When LLVM_PROFILE_ASYNC_FLUSH_MS is set together with the %c specifier, the
+ * counters are redirected into an anonymous shadow mapping instead of a
+ * MAP_SHARED view of the profile, and a background thread periodically
+ * flushes the shadow to the profile file: each tick it queues the page
+ * indexes of counter pages that changed since their last flush in a ring
+ * buffer, and drains at most LLVM_PROFILE_ASYNC_FLUSH_PAGES (default 64)
+ * pages from the ring with pwrite(). This bounds the write rate and keeps
+ * dirty-page writeback of the profile off the exit and signal paths.
+ * Counter words may be torn while a page is being copied; as with plain
+ * continuous mode, a later flush of the same page repairs the value. */
+#include <pthread.h>
+
+/* Allow linking without libpthread; if the symbols are unresolved at runtime
+ * the feature is disabled with a warning. */
+#pragma weak pthread_create
+#pragma weak pthread_join
+
+static char *AsyncShadowBegin = NULL; /* Live counters; the bias target. */
+static char *AsyncCleanCopy = NULL;   /* Page contents as last flushed. */
+static uint64_t AsyncCountersSize = 0;
+static uint64_t AsyncNumPages = 0;
+static uint64_t AsyncFileOffset = 0; /* Counter section offset in the file. */
+static int AsyncProfileFd = -1;
+static uint32_t *AsyncRing = NULL; /* Dirty page indexes, oldest first. */
+static unsigned char *AsyncPageInRing = NULL;
+static uint64_t AsyncRingHead = 0; /* Next push position. */
+static uint64_t AsyncRingTail = 0; /* Next pop position. */
+static volatile int AsyncStopRequested = 0;
+static pthread_t AsyncFlushThread;
+
+static unsigned asyncFlushIntervalMs(void) {
+  const char *IntervalStr = getenv("LLVM_PROFILE_ASYNC_FLUSH_MS");
+  if (!IntervalStr || !IntervalStr[0])
+    return 0;
+  int Interval = atoi(IntervalStr);
+  return Interval > 0 ? (unsigned)Interval : 0;
+}
+
+static unsigned asyncFlushMaxPagesPerTick(void) {
+  const char *PagesStr = getenv("LLVM_PROFILE_ASYNC_FLUSH_PAGES");
+  if (PagesStr && PagesStr[0]) {
+    int Pages = atoi(PagesStr);
+    if (Pages > 0)
+      return (unsigned)Pages;
+  }
+  return 64;
+}
+
+static uint64_t asyncPageLength(uint64_t Page, unsigned PageSize) {
+  uint64_t Offset = Page * PageSize;
+  return Offset + PageSize <= AsyncCountersSize ? PageSize
+                                                : AsyncCountersSize - Offset;
+}
+
+/* Queue every page whose contents changed since its last flush. The ring has
+ * one slot per page and AsyncPageInRing prevents duplicates, so pushes cannot
+ * overflow it. */
+static void asyncEnqueueDirtyPages(void) {
+  unsigned PageSize = getpagesize();
+  for (uint64_t Page = 0; Page < AsyncNumPages; ++Page) {
+    if (AsyncPageInRing[Page])
+      continue;
+    uint64_t Offset = Page * PageSize;
+    if (!memcmp(AsyncShadowBegin + Offset, AsyncCleanCopy + Offset,
+                asyncPageLength(Page, PageSize)))
+      continue;
+    AsyncRing[AsyncRingHead % AsyncNumPages] = Page;
+    ++AsyncRingHead;
+    AsyncPageInRing[Page] = 1;
+  }
+}
+
+static void asyncDrainPages(unsigned MaxPages) {
+  unsigned PageSize = getpagesize();
+  while (MaxPages-- && AsyncRingTail != AsyncRingHead) {
+    uint64_t Page = AsyncRing[AsyncRingTail % AsyncNumPages];
+    ++AsyncRingTail;
+    uint64_t Offset = Page * PageSize;
+    uint64_t Length = asyncPageLength(Page, PageSize);
+    /* Snapshot the page first so that updates racing with the write are
+     * picked up by the next scan. */
+    memcpy(AsyncCleanCopy + Offset, AsyncShadowBegin + Offset, Length);
+    AsyncPageInRing[Page] = 0;
+    uint64_t Written = 0;
+    while (Written < Length) {
+      ssize_t Ret = pwrite(AsyncProfileFd, AsyncCleanCopy + Offset + Written,
+                           Length - Written, AsyncFileOffset + Offset + Written);
+      if (Ret < 0) {
+        if (errno == EINTR)
+          continue;
+        PROF_ERR("Unable to flush counter page: %s\n", strerror(errno));
+        return;
+      }
+      Written += Ret;
+    }
+  }
+}
+
+static void *asyncFlushThreadMain(void *Arg) {
+  (void)Arg;
+  unsigned IntervalMs = asyncFlushIntervalMs();
+  unsigned MaxPagesPerTick = asyncFlushMaxPagesPerTick();
+  struct timespec Interval;
+  Interval.tv_sec = IntervalMs / 1000;
+  Interval.tv_nsec = (IntervalMs % 1000) * 1000000L;
+  while (!AsyncStopRequested) {
+    nanosleep(&Interval, NULL);
+    asyncEnqueueDirtyPages();
+    asyncDrainPages(MaxPagesPerTick);
+  }
+  return NULL;
+}
+
+/* Stop the flusher thread and synchronously drain whatever is still dirty.
+ * Only the not-yet-flushed pages are written, so this stays cheap even for
+ * large counter sections. */
+static void asyncFlushAtExit(void) {
+  if (!AsyncShadowBegin)
+    return;
+  AsyncStopRequested = 1;
+  pthread_join(AsyncFlushThread, NULL);
+  asyncEnqueueDirtyPages();
+  asyncDrainPages((unsigned)-1);
+}
+
+/* Redirect the counters into a shadow mapping and start the flusher thread.
+ * \p File is positioned at a freshly written profile whose counter values
+ * seed the shadow. Returns 0 on success; on failure the caller falls back to
+ * mapping the profile directly. */
+static int startAsyncCounterFlush(FILE *File) {
+  const __llvm_profile_data *DataBegin = __llvm_profile_begin_data();
+  const __llvm_profile_data *DataEnd = __llvm_profile_end_data();
+  const char *CountersBegin = __llvm_profile_begin_counters();
+  const char *CountersEnd = __llvm_profile_end_counters();
+  uint64_t DataSize = __llvm_profile_get_data_size(DataBegin, DataEnd);
+  unsigned PageSize = getpagesize();
+
+  if (!pthread_create) {
+    PROF_WARN("%s\n", "asynchronous counter flushing requires libpthread");
+    return 1;
+  }
+
+  AsyncCountersSize =
+      __llvm_profile_get_counters_size(CountersBegin, CountersEnd);
+  uint64_t MappedSize =
+      (AsyncCountersSize + PageSize - 1) & ~(uint64_t)(PageSize - 1);
+  AsyncNumPages = MappedSize / PageSize;
+  AsyncFileOffset =
+      sizeof(__llvm_profile_header) + __llvm_write_binary_ids(NULL) + DataSize;
+
+  AsyncProfileFd = dup(fileno(File));
+  if (AsyncProfileFd < 0) {
+    PROF_ERR("Unable to dup profile fd: %s\n", strerror(errno));
+    return 1;
+  }
+  char *Shadow = (char *)mmap(NULL, MappedSize, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  AsyncCleanCopy = (char *)malloc(MappedSize);
+  AsyncRing = (uint32_t *)malloc(AsyncNumPages * sizeof(uint32_t));
+  AsyncPageInRing = (unsigned char *)calloc(AsyncNumPages, 1);
+  if (Shadow == MAP_FAILED || !AsyncCleanCopy || !AsyncRing ||
+      !AsyncPageInRing) {
+    PROF_ERR("%s\n", "Unable to allocate counter shadow buffers");
+    if (Shadow != MAP_FAILED)
+      (void)munmap(Shadow, MappedSize);
+    free(AsyncCleanCopy);
+    free(AsyncRing);
+    free(AsyncPageInRing);
+    close(AsyncProfileFd);
+    return 1;
+  }
+  /* Seed the shadow with the counter values just written to the profile so
+   * that further updates accumulate on top of them. */
+  uint64_t SeedRead = 0;
+  while (SeedRead < AsyncCountersSize) {
+    ssize_t Ret = pread(AsyncProfileFd, Shadow + SeedRead,
+                        AsyncCountersSize - SeedRead,
+                        AsyncFileOffset + SeedRead);
+    if (Ret <= 0)
+      break;
+    SeedRead += Ret;
+  }
+  memcpy(AsyncCleanCopy, Shadow, MappedSize);
+
+  AsyncShadowBegin = Shadow;
+  INSTR_PROF_PROFILE_COUNTER_BIAS_VAR =
+      (intptr_t)Shadow - (uintptr_t)CountersBegin;
+  /* Return the memory allocated for counters to OS. */
+  lprofReleaseMemoryPagesToOS((uintptr_t)CountersBegin, (uintptr_t)CountersEnd);
+
+  if (pthread_create(&AsyncFlushThread, NULL, asyncFlushThreadMain, NULL)) {
+    PROF_ERR("%s\n", "Unable to start the counter flush thread");
+    INSTR_PROF_PROFILE_COUNTER_BIAS_VAR = 0;
+    AsyncShadowBegin = NULL;
+    (void)munmap(Shadow, MappedSize);
+    free(AsyncCleanCopy);
+    free(AsyncRing);
+    free(AsyncPageInRing);
+    close(AsyncProfileFd);
+    return 1;
+  }
+  atexit(asyncFlushAtExit);
+  return 0;
+}
+#else
+static unsigned asyncFlushIntervalMs(void) { return 0; }
+static int startAsyncCounterFlush(FILE *File) {
+  (void)File;
+  return 1;
+}
+#endif
+
 static int isProfileMergeRequested(void) { return ProfileMergeRequested; }
 static void setProfileMergeRequested(int EnableMerge) {
   ProfileMergeRequested = EnableMerge;
@@ -660,8 +874,19 @@ static void initializeProfileForContinuousMode(void) {
 
   /* mmap() the profile counters so long as there is at least one counter.
    * If there aren't any counters, mmap() would fail with EINVAL. */
-  if (CountersSize > 0)
-    mmapForContinuousMode(CurrentFileOffset, File);
+  if (CountersSize > 0) {
+    int MmapCounters = 1;
+    if (asyncFlushIntervalMs()) {
+      if (doMerging() || !UseBiasVar) {
+        PROF_WARN("%s\n", "asynchronous counter flushing requires bias-mode "
+                          "continuous mode without merging; ignored");
+      } else {
+        MmapCounters = startAsyncCounterFlush(File) != 0;
+      }
+    }
+    if (MmapCounters)
+      mmapForContinuousMode(CurrentFileOffset, File);
+  }
 
   if (doMerging()) {
     lprofUnlockFileHandle(File);
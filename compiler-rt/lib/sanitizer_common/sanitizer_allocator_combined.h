@@ -41,6 +41,8 @@ class CombinedAllocator {
     secondary_.Init();
   }
 
+  void EnablePerCpuCaches() { primary_.EnablePerCpuCaches(); }
+
   void *Allocate(AllocatorCache *cache, uptr size, uptr alignment) {
     // Returning 0 on malloc(0) may break a lot of code.
     if (size == 0)
@@ -137,6 +137,10 @@ class SizeClassAllocator32 {
     // Currently implemented in 64-bit allocator only.
   }
 
+  void EnablePerCpuCaches() {
+    // Currently implemented in 64-bit allocator only.
+  }
+
   void *MapWithCallback(uptr size) {
     void *res = MmapOrDie(size, PrimaryAllocatorName);
     MapUnmapCallback().OnMap((uptr)res, size);
@@ -158,9 +158,18 @@ class SizeClassAllocator64 {
                  memory_order_relaxed);
   }
 
+  // Enables the per-CPU transfer caches (see CpuShard below). Must be called
+  // before the allocator is used from more than one thread, typically right
+  // after Init().
+  void EnablePerCpuCaches() {
+    uptr n = RoundUpToPowerOfTwo(GetNumberOfCPUsCached());
+    atomic_store(&n_cpu_shards_, Min(n, kMaxCpuShards), memory_order_release);
+  }
+
   void ForceReleaseToOS() {
     MemoryMapperT memory_mapper(*this);
     for (uptr class_id = 1; class_id < kNumClasses; class_id++) {
+      DrainCpuShards(&memory_mapper, class_id);
       Lock l(&GetRegionInfo(class_id)->mutex);
       MaybeReleaseToOS(&memory_mapper, class_id, true /*force*/);
     }
@@ -174,32 +183,15 @@ class SizeClassAllocator64 {
   NOINLINE void ReturnToAllocator(MemoryMapperT *memory_mapper,
                                   AllocatorStats *stat, uptr class_id,
                                   const CompactPtrT *chunks, uptr n_chunks) {
-    RegionInfo *region = GetRegionInfo(class_id);
-    uptr region_beg = GetRegionBeginBySizeClass(class_id);
-    CompactPtrT *free_array = GetFreeArray(region_beg);
-
-    Lock l(&region->mutex);
-    uptr old_num_chunks = region->num_freed_chunks;
-    uptr new_num_freed_chunks = old_num_chunks + n_chunks;
-    // Failure to allocate free array space while releasing memory is non
-    // recoverable.
-    if (UNLIKELY(!EnsureFreeArraySpace(region, region_beg,
-                                       new_num_freed_chunks))) {
-      Report("FATAL: Internal error: %s's allocator exhausted the free list "
-             "space for size class %zd (%zd bytes).\n", SanitizerToolName,
-             class_id, ClassIdToSize(class_id));
-      Die();
-    }
-    for (uptr i = 0; i < n_chunks; i++)
-      free_array[old_num_chunks + i] = chunks[i];
-    region->num_freed_chunks = new_num_freed_chunks;
-    region->stats.n_freed += n_chunks;
-
-    MaybeReleaseToOS(memory_mapper, class_id, false /*force*/);
+    if (TryDepositToCpuShard(class_id, chunks, n_chunks))
+      return;
+    ReturnToFreeArray(memory_mapper, class_id, chunks, n_chunks);
   }
 
   NOINLINE bool GetFromAllocator(AllocatorStats *stat, uptr class_id,
                                  CompactPtrT *chunks, uptr n_chunks) {
+    if (TryRefillFromCpuShard(class_id, chunks, n_chunks))
+      return true;
     RegionInfo *region = GetRegionInfo(class_id);
     uptr region_beg = GetRegionBeginBySizeClass(class_id);
     CompactPtrT *free_array = GetFreeArray(region_beg);
@@ -358,9 +350,17 @@ class SizeClassAllocator64 {
     for (uptr i = 0; i < kNumClasses; i++) {
       GetRegionInfo(i)->mutex.Lock();
     }
+    uptr n_shards = atomic_load(&n_cpu_shards_, memory_order_acquire);
+    for (uptr i = 0; i < kNumClasses; i++)
+      for (uptr shard = 0; shard < n_shards; shard++)
+        GetCpuShard(i, shard)->mutex.Lock();
   }
 
   void ForceUnlock() SANITIZER_NO_THREAD_SAFETY_ANALYSIS {
+    uptr n_shards = atomic_load(&n_cpu_shards_, memory_order_acquire);
+    for (int i = (int)kNumClasses - 1; i >= 0; i--)
+      for (int shard = (int)n_shards - 1; shard >= 0; shard--)
+        GetCpuShard(i, shard)->mutex.Unlock();
     for (int i = (int)kNumClasses - 1; i >= 0; i--) {
       GetRegionInfo(i)->mutex.Unlock();
     }
@@ -389,7 +389,8 @@ class SizeClassAllocator64 {
   }
 
   static uptr AdditionalSize() {
-    return RoundUpTo(sizeof(RegionInfo) * kNumClassesRounded,
+    return RoundUpTo(sizeof(RegionInfo) * kNumClassesRounded +
+                         sizeof(CpuShard) * kNumClassesRounded * kMaxCpuShards,
                      GetPageSizeCached());
   }
 
@@ -686,6 +687,112 @@ class SizeClassAllocator64 {
     return &regions[class_id];
   }
 
+  // Optional per-CPU transfer caches sitting between the per-thread caches
+  // and the region free arrays, enabled with EnablePerCpuCaches(). Runs of
+  // freed chunks are parked in the shard of the CPU that freed them, and
+  // cache refills on that CPU pick them up without taking region->mutex.
+  // This keeps heavy thread churn, where every dying thread drains its whole
+  // cache, from serializing all threads on the per-class region mutex.
+  // Chunks parked in a shard remain accounted to the region exactly like
+  // chunks sitting in a per-thread cache. The shard array lives in the
+  // RegionInfo mapping, after the RegionInfo array.
+  static const uptr kMaxCpuShards = 64;
+  static const uptr kCpuShardCapacity = 2 * SizeClassMap::kMaxNumCachedHint;
+
+  struct ALIGNED(SANITIZER_CACHE_LINE_SIZE) CpuShard {
+    StaticSpinMutex mutex;
+    u32 count;
+    CompactPtrT chunks[kCpuShardCapacity];
+  };
+
+  // The number of shards in use; a power of two. Zero means the per-CPU
+  // caches are disabled.
+  atomic_uintptr_t n_cpu_shards_;
+
+  CpuShard *GetCpuShard(uptr class_id, uptr shard) const {
+    DCHECK_LT(class_id, kNumClasses);
+    DCHECK_LT(shard, kMaxCpuShards);
+    CpuShard *shards = reinterpret_cast<CpuShard *>(
+        RegionInfoSpace + sizeof(RegionInfo) * kNumClassesRounded);
+    return &shards[class_id * kMaxCpuShards + shard];
+  }
+
+  bool TryDepositToCpuShard(uptr class_id, const CompactPtrT *chunks,
+                            uptr n_chunks) {
+    uptr n_shards = atomic_load(&n_cpu_shards_, memory_order_acquire);
+    if (LIKELY(!n_shards) || n_chunks > kCpuShardCapacity)
+      return false;
+    CpuShard *shard = GetCpuShard(class_id, GetRunningCpu() & (n_shards - 1));
+    SpinMutexLock l(&shard->mutex);
+    if (shard->count + n_chunks > kCpuShardCapacity)
+      return false;
+    for (uptr i = 0; i < n_chunks; i++)
+      shard->chunks[shard->count + i] = chunks[i];
+    shard->count += n_chunks;
+    return true;
+  }
+
+  bool TryRefillFromCpuShard(uptr class_id, CompactPtrT *chunks,
+                             uptr n_chunks) {
+    uptr n_shards = atomic_load(&n_cpu_shards_, memory_order_acquire);
+    if (LIKELY(!n_shards))
+      return false;
+    CpuShard *shard = GetCpuShard(class_id, GetRunningCpu() & (n_shards - 1));
+    SpinMutexLock l(&shard->mutex);
+    if (shard->count < n_chunks)
+      return false;
+    shard->count -= n_chunks;
+    for (uptr i = 0; i < n_chunks; i++)
+      chunks[i] = shard->chunks[shard->count + i];
+    return true;
+  }
+
+  // Flushes all shards of class_id into the region free array so that
+  // MaybeReleaseToOS sees the parked chunks.
+  void DrainCpuShards(MemoryMapperT *memory_mapper, uptr class_id) {
+    uptr n_shards = atomic_load(&n_cpu_shards_, memory_order_acquire);
+    for (uptr i = 0; i < n_shards; i++) {
+      CpuShard *shard = GetCpuShard(class_id, i);
+      CompactPtrT chunks[kCpuShardCapacity];
+      uptr n_chunks;
+      {
+        SpinMutexLock l(&shard->mutex);
+        n_chunks = shard->count;
+        for (uptr j = 0; j < n_chunks; j++)
+          chunks[j] = shard->chunks[j];
+        shard->count = 0;
+      }
+      if (n_chunks)
+        ReturnToFreeArray(memory_mapper, class_id, chunks, n_chunks);
+    }
+  }
+
+  NOINLINE void ReturnToFreeArray(MemoryMapperT *memory_mapper, uptr class_id,
+                                  const CompactPtrT *chunks, uptr n_chunks) {
+    RegionInfo *region = GetRegionInfo(class_id);
+    uptr region_beg = GetRegionBeginBySizeClass(class_id);
+    CompactPtrT *free_array = GetFreeArray(region_beg);
+
+    Lock l(&region->mutex);
+    uptr old_num_chunks = region->num_freed_chunks;
+    uptr new_num_freed_chunks = old_num_chunks + n_chunks;
+    // Failure to allocate free array space while releasing memory is non
+    // recoverable.
+    if (UNLIKELY(!EnsureFreeArraySpace(region, region_beg,
+                                       new_num_freed_chunks))) {
+      Report("FATAL: Internal error: %s's allocator exhausted the free list "
+             "space for size class %zd (%zd bytes).\n", SanitizerToolName,
+             class_id, ClassIdToSize(class_id));
+      Die();
+    }
+    for (uptr i = 0; i < n_chunks; i++)
+      free_array[old_num_chunks + i] = chunks[i];
+    region->num_freed_chunks = new_num_freed_chunks;
+    region->stats.n_freed += n_chunks;
+
+    MaybeReleaseToOS(memory_mapper, class_id, false /*force*/);
+  }
+
   uptr GetMetadataEnd(uptr region_beg) const {
     return region_beg + kRegionSize - kFreeArraySize;
   }
@@ -1074,6 +1074,15 @@ inline u32 GetNumberOfCPUsCached() {
   return NumberOfCPUsCached;
 }
 
+// Returns the number of the CPU the calling thread most recently ran on. The
+// result may be stale by the time it is used and must only serve as a
+// scheduling hint. Implemented on Linux only; elsewhere always returns 0.
+#if SANITIZER_LINUX
+u32 GetRunningCpu();
+#else
+inline u32 GetRunningCpu() { return 0; }
+#endif
+
 template <typename T>
 class ArrayRef {
  public:
@@ -573,6 +573,15 @@ int TgKill(pid_t pid, tid_t tid, int sig) {
   return thr_kill(tid, sig);
 #endif
 }
+
+#if SANITIZER_LINUX
+u32 GetRunningCpu() {
+  unsigned cpu = 0;
+  if (internal_syscall(SYSCALL(getcpu), (uptr)&cpu, 0, 0))
+    return 0;
+  return cpu;
+}
+#endif
 #endif
 
 #if SANITIZER_GLIBC
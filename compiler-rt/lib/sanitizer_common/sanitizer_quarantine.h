@@ -77,8 +77,7 @@ class Quarantine {
  public:
   typedef QuarantineCache<Callback> Cache;
 
-  explicit Quarantine(LinkerInitialized)
-      : cache_(LINKER_INITIALIZED) {
+  explicit Quarantine(LinkerInitialized) {
   }
 
   void Init(uptr size, uptr cache_size) {
@@ -90,8 +89,10 @@ class Quarantine {
     atomic_store_relaxed(&min_size_, size / 10 * 9);  // 90% of max size.
     atomic_store_relaxed(&max_cache_size_, cache_size);
 
-    cache_mutex_.Init();
-    recycle_mutex_.Init();
+    for (uptr i = 0; i < kShardCount; i++) {
+      shards_[i].cache_mutex.Init();
+      shards_[i].recycle_mutex.Init();
+    }
   }
 
   uptr GetSize() const { return atomic_load_relaxed(&max_size_); }
@@ -113,71 +114,115 @@ class Quarantine {
   }
 
   void NOINLINE Drain(Cache *c, Callback cb) {
+    Shard *s = ShardFor(c);
     {
-      SpinMutexLock l(&cache_mutex_);
-      cache_.Transfer(c);
+      SpinMutexLock l(&s->cache_mutex);
+      s->cache.Transfer(c);
     }
-    if (cache_.Size() > GetSize() && recycle_mutex_.TryLock())
-      Recycle(atomic_load_relaxed(&min_size_), cb);
+    if (TotalSize() > GetSize() && s->recycle_mutex.TryLock())
+      Recycle(s, atomic_load_relaxed(&min_size_), cb);
   }
 
   void NOINLINE DrainAndRecycle(Cache *c, Callback cb) {
+    Shard *s = ShardFor(c);
     {
-      SpinMutexLock l(&cache_mutex_);
-      cache_.Transfer(c);
+      SpinMutexLock l(&s->cache_mutex);
+      s->cache.Transfer(c);
+    }
+    for (uptr i = 0; i < kShardCount; i++) {
+      shards_[i].recycle_mutex.Lock();
+      Recycle(&shards_[i], 0, cb);
     }
-    recycle_mutex_.Lock();
-    Recycle(0, cb);
   }
 
   void PrintStats() const {
     // It assumes that the world is stopped, just as the allocator's PrintStats.
     Printf("Quarantine limits: global: %zdMb; thread local: %zdKb\n",
            GetSize() >> 20, GetCacheSize() >> 10);
-    cache_.PrintStats();
+    for (uptr i = 0; i < kShardCount; i++)
+      shards_[i].cache.PrintStats();
   }
 
  private:
+  // The global quarantine is split into independently locked shards to avoid
+  // serializing all threads on a single mutex pair when thread local caches
+  // overflow. Each thread drains into the shard picked by the address of its
+  // cache, so under a steady thread population a shard sees mostly the same
+  // threads; the quarantine size limit remains global across all shards.
+  static const uptr kShardCount = 8;
+
+  struct Shard {
+    Shard() : cache(LINKER_INITIALIZED) {}
+    StaticSpinMutex cache_mutex;
+    StaticSpinMutex recycle_mutex;
+    Cache cache;
+    char pad[kCacheLineSize];
+  };
+
   // Read-only data.
   char pad0_[kCacheLineSize];
   atomic_uintptr_t max_size_;
   atomic_uintptr_t min_size_;
   atomic_uintptr_t max_cache_size_;
   char pad1_[kCacheLineSize];
-  StaticSpinMutex cache_mutex_;
-  StaticSpinMutex recycle_mutex_;
-  Cache cache_;
-  char pad2_[kCacheLineSize];
+  Shard shards_[kShardCount];
+
+  Shard *ShardFor(const Cache *c) {
+    return &shards_[(reinterpret_cast<uptr>(c) >> 4) % kShardCount];
+  }
+
+  uptr TotalSize() const {
+    uptr total = 0;
+    for (uptr i = 0; i < kShardCount; i++)
+      total += shards_[i].cache.Size();
+    return total;
+  }
 
-  void NOINLINE Recycle(uptr min_size, Callback cb)
-      SANITIZER_REQUIRES(recycle_mutex_) SANITIZER_RELEASE(recycle_mutex_) {
+  // Extracts batches from the given shard into *tmp until either the shard
+  // runs dry or the total quarantined size drops below min_size.
+  void ExtractForRecycle(Shard *s, uptr min_size, Cache *tmp)
+      SANITIZER_REQUIRES(s->recycle_mutex) {
+    SpinMutexLock l(&s->cache_mutex);
+    // Go over the batches and merge partially filled ones to
+    // save some memory, otherwise batches themselves (since the memory used
+    // by them is counted against quarantine limit) can overcome the actual
+    // user's quarantined chunks, which diminishes the purpose of the
+    // quarantine.
+    uptr cache_size = s->cache.Size();
+    uptr overhead_size = s->cache.OverheadSize();
+    CHECK_GE(cache_size, overhead_size);
+    // Do the merge only when overhead exceeds this predefined limit (might
+    // require some tuning). It saves us merge attempt when the batch list
+    // quarantine is unlikely to contain batches suitable for merge.
+    const uptr kOverheadThresholdPercents = 100;
+    if (cache_size > overhead_size &&
+        overhead_size * (100 + kOverheadThresholdPercents) >
+            cache_size * kOverheadThresholdPercents) {
+      s->cache.MergeBatches(tmp);
+    }
+    // Extract enough chunks from the quarantine to get below the max
+    // quarantine size and leave some leeway for the newly quarantined chunks.
+    while (s->cache.Size() && TotalSize() > min_size) {
+      tmp->EnqueueBatch(s->cache.DequeueBatch());
+    }
+  }
+
+  void NOINLINE Recycle(Shard *s, uptr min_size, Callback cb)
+      SANITIZER_REQUIRES(s->recycle_mutex) SANITIZER_RELEASE(s->recycle_mutex) {
     Cache tmp;
-    {
-      SpinMutexLock l(&cache_mutex_);
-      // Go over the batches and merge partially filled ones to
-      // save some memory, otherwise batches themselves (since the memory used
-      // by them is counted against quarantine limit) can overcome the actual
-      // user's quarantined chunks, which diminishes the purpose of the
-      // quarantine.
-      uptr cache_size = cache_.Size();
-      uptr overhead_size = cache_.OverheadSize();
-      CHECK_GE(cache_size, overhead_size);
-      // Do the merge only when overhead exceeds this predefined limit (might
-      // require some tuning). It saves us merge attempt when the batch list
-      // quarantine is unlikely to contain batches suitable for merge.
-      const uptr kOverheadThresholdPercents = 100;
-      if (cache_size > overhead_size &&
-          overhead_size * (100 + kOverheadThresholdPercents) >
-              cache_size * kOverheadThresholdPercents) {
-        cache_.MergeBatches(&tmp);
-      }
-      // Extract enough chunks from the quarantine to get below the max
-      // quarantine size and leave some leeway for the newly quarantined chunks.
-      while (cache_.Size() > min_size) {
-        tmp.EnqueueBatch(cache_.DequeueBatch());
-      }
+    ExtractForRecycle(s, min_size, &tmp);
+    s->recycle_mutex.Unlock();
+    // If this shard ran dry before the quarantine dropped below the watermark
+    // (frees are funneled through few threads while other shards hold the
+    // bulk), spill over to the remaining shards. TryLock skips shards that
+    // another thread is already recycling.
+    for (uptr i = 1; i < kShardCount && TotalSize() > min_size; i++) {
+      Shard *other = &shards_[(s - shards_ + i) % kShardCount];
+      if (!other->recycle_mutex.TryLock())
+        continue;
+      ExtractForRecycle(other, min_size, &tmp);
+      other->recycle_mutex.Unlock();
     }
-    recycle_mutex_.Unlock();
     DoRecycle(&tmp, cb);
   }
 
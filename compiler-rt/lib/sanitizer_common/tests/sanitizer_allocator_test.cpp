@@ -331,6 +331,42 @@ TEST(SanitizerCommon, SizeClassAllocator64Dense) {
 TEST(SanitizerCommon, SizeClassAllocator64VeryCompact) {
   TestSizeClassAllocator<Allocator64VeryCompact>();
 }
+
+TEST(SanitizerCommon, SizeClassAllocator64PerCpuCaches) {
+  Allocator64 *a = new Allocator64;
+  a->Init(kReleaseToOSIntervalNever);
+  a->EnablePerCpuCaches();
+  const uptr class_id = Allocator64::SizeClassMapT::ClassID(128);
+  std::vector<void *> allocated;
+  uptr last_total_allocated = 0;
+  // Simulate thread churn: every round drains the whole cache the way a dying
+  // thread would, and the next round's refills must recycle the chunks parked
+  // in the per-CPU shards without growing the region.
+  for (int round = 0; round < 10; round++) {
+    Allocator64::AllocatorCache cache;
+    memset(&cache, 0, sizeof(cache));
+    cache.Init(0);
+    for (uptr i = 0; i < 4096; i++) {
+      char *x = (char *)cache.Allocate(a, class_id);
+      x[0] = 0;
+      allocated.push_back(x);
+    }
+    for (void *x : allocated) {
+      CHECK_EQ(a->GetSizeClass(x), class_id);
+      cache.Deallocate(a, class_id, x);
+    }
+    allocated.clear();
+    cache.Drain(a);
+    uptr total_allocated = a->TotalMemoryUsed();
+    if (last_total_allocated == 0)
+      last_total_allocated = total_allocated;
+    CHECK_EQ(last_total_allocated, total_allocated);
+  }
+  // Flushes the shards back into the region free arrays.
+  a->ForceReleaseToOS();
+  a->TestOnlyUnmap();
+  delete a;
+}
 #endif
 #endif
 
@@ -0,0 +1,25 @@
+// RUN: %clangxx_memprof %s -o %t
+
+// RUN: %env_memprof_opts=log_path=stdout %run %t > %t.memprofraw
+// RUN: od -c %t.memprofraw | FileCheck %s
+
+#include <sanitizer/memprof_interface.h>
+#include <stdlib.h>
+#include <string.h>
+int main(int argc, char **argv) {
+  char *x = (char *)malloc(10);
+  memset(x, 0, 10);
+  free(x);
+  __memprof_profile_flush();
+  x = (char *)malloc(10);
+  memset(x, 0, 10);
+  free(x);
+  return 0;
+}
+// We should get 2 raw profile chunks appended to the same file, one from the
+// explicit flush request, and one at exit. Each chunk starts with the header
+// magic, which is 8b aligned so it is not split across od output lines. The
+// following checks assume that memprof runs on little endian architectures.
+//
+// CHECK: 201   r   f   o   r   p   m 377
+// CHECK: 201   r   f   o   r   p   m 377
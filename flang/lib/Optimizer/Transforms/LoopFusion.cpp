@@ -0,0 +1,254 @@
+//===- LoopFusion.cpp -- fuse adjacent fir.do_loop operations -------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "flang/Optimizer/Dialect/FIRDialect.h"
+#include "flang/Optimizer/Dialect/FIROps.h"
+#include "flang/Optimizer/Dialect/FIRType.h"
+#include "flang/Optimizer/Transforms/Passes.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+
+namespace fir {
+#define GEN_PASS_DEF_LOOPFUSION
+#include "flang/Optimizer/Transforms/Passes.h.inc"
+} // namespace fir
+
+#define DEBUG_TYPE "fir-loop-fusion"
+
+namespace {
+
+/// The memory touched by one loop nest, summarized per underlying storage
+/// object.
+struct AccessSummary {
+  llvm::SmallPtrSet<mlir::Value, 8> reads;
+  llvm::SmallPtrSet<mlir::Value, 8> writes;
+};
+
+/// Strip the addressing operations off of \p v to recover the object the
+/// access is rooted at.
+static mlir::Value getStorageBase(mlir::Value v) {
+  while (mlir::Operation *op = v.getDefiningOp()) {
+    if (auto coor = mlir::dyn_cast<fir::ArrayCoorOp>(op))
+      v = coor.getMemref();
+    else if (auto coor = mlir::dyn_cast<fir::CoordinateOp>(op))
+      v = coor.getRef();
+    else if (auto conv = mlir::dyn_cast<fir::ConvertOp>(op))
+      v = conv.getValue();
+    else
+      break;
+  }
+  return v;
+}
+
+/// Record the storage objects read and written inside \p loop. Returns false
+/// if the loop contains an operation with unknown memory behavior, such as a
+/// call, in which case no summary can be made.
+static bool summarizeAccesses(fir::DoLoopOp loop, AccessSummary &summary) {
+  auto walkResult = loop.walk([&](mlir::Operation *op) {
+    if (op == loop.getOperation())
+      return mlir::WalkResult::advance();
+    // The bodies of nested structured control flow are visited by the walk.
+    if (mlir::isa<fir::DoLoopOp, fir::IterWhileOp, fir::IfOp, fir::ResultOp>(
+            op))
+      return mlir::WalkResult::advance();
+    if (auto interface = mlir::dyn_cast<mlir::MemoryEffectOpInterface>(op)) {
+      llvm::SmallVector<mlir::MemoryEffects::EffectInstance> effects;
+      interface.getEffects(effects);
+      for (mlir::MemoryEffects::EffectInstance &effect : effects) {
+        mlir::Value v = effect.getValue();
+        // An effect not tied to a value may touch anything.
+        if (!v)
+          return mlir::WalkResult::interrupt();
+        mlir::Value base = getStorageBase(v);
+        if (mlir::isa<mlir::MemoryEffects::Read>(effect.getEffect()))
+          summary.reads.insert(base);
+        else
+          summary.writes.insert(base);
+      }
+      return mlir::WalkResult::advance();
+    }
+    if (op->hasTrait<mlir::OpTrait::HasRecursiveSideEffects>())
+      return mlir::WalkResult::advance();
+    return mlir::WalkResult::interrupt();
+  });
+  return !walkResult.wasInterrupted();
+}
+
+/// Is \p v a local allocation whose address is only ever used for direct
+/// loads, stores, and coordinate computations? Such an object cannot be
+/// reached through any other storage base.
+static bool isNonEscapingAllocation(mlir::Value v) {
+  if (!v.getDefiningOp<fir::AllocaOp>() && !v.getDefiningOp<fir::AllocMemOp>())
+    return false;
+  llvm::SmallVector<mlir::Value> worklist{v};
+  while (!worklist.empty()) {
+    mlir::Value cur = worklist.pop_back_val();
+    for (mlir::Operation *user : cur.getUsers()) {
+      if (auto store = mlir::dyn_cast<fir::StoreOp>(user)) {
+        // Storing the address itself lets it escape.
+        if (store.getValue() == cur)
+          return false;
+        continue;
+      }
+      if (mlir::isa<fir::LoadOp, fir::FreeMemOp>(user))
+        continue;
+      if (mlir::isa<fir::ArrayCoorOp, fir::CoordinateOp, fir::ConvertOp>(
+              user)) {
+        worklist.push_back(user->getResult(0));
+        continue;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+/// May accesses rooted at the storage bases \p a and \p b overlap?
+static bool mayAlias(mlir::Value a, mlir::Value b) {
+  if (a == b)
+    return true;
+  // A non-escaping allocation can only be accessed through its own base.
+  return !isNonEscapingAllocation(a) && !isNonEscapingAllocation(b);
+}
+
+/// Do the accesses of two loops prevent their bodies from being interleaved?
+/// A write in one loop must not overlap anything the other touches; the
+/// iteration-wise interleaving done by fusion would otherwise reorder the
+/// accesses across the whole iteration space.
+static bool accessesConflict(const AccessSummary &first,
+                             const AccessSummary &second) {
+  auto writesConflictWith = [](const llvm::SmallPtrSet<mlir::Value, 8> &writes,
+                               const AccessSummary &other) {
+    for (mlir::Value write : writes) {
+      for (mlir::Value read : other.reads)
+        if (mayAlias(write, read))
+          return true;
+      for (mlir::Value otherWrite : other.writes)
+        if (mayAlias(write, otherWrite))
+          return true;
+    }
+    return false;
+  };
+  return writesConflictWith(first.writes, second) ||
+         writesConflictWith(second.writes, first);
+}
+
+/// Can \p second be folded into \p first? The loops must be adjacent siblings
+/// with an identical iteration space, and \p second must not consume values
+/// produced by \p first.
+static bool canFuse(fir::DoLoopOp first, fir::DoLoopOp second) {
+  if (first->getNextNode() != second.getOperation())
+    return false;
+  if (first.getLowerBound() != second.getLowerBound() ||
+      first.getUpperBound() != second.getUpperBound() ||
+      first.getStep() != second.getStep() ||
+      first.getUnordered() != second.getUnordered())
+    return false;
+  // Loops yielding their final induction value have an extra result which the
+  // merge below does not preserve; these do not come from array lowering.
+  if (first.getFinalValue() || second.getFinalValue())
+    return false;
+  for (mlir::Value result : first.getResults())
+    for (mlir::Operation *user : result.getUsers())
+      if (second.getOperation()->isAncestor(user))
+        return false;
+  AccessSummary firstAccesses, secondAccesses;
+  if (!summarizeAccesses(first, firstAccesses) ||
+      !summarizeAccesses(second, secondAccesses))
+    return false;
+  return !accessesConflict(firstAccesses, secondAccesses);
+}
+
+/// Replace \p first and \p second with a single loop running both bodies,
+/// carrying the concatenation of their iteration arguments.
+static fir::DoLoopOp fuse(fir::DoLoopOp first, fir::DoLoopOp second) {
+  mlir::OpBuilder builder(first);
+  llvm::SmallVector<mlir::Value> iterArgs(first.getInitArgs().begin(),
+                                          first.getInitArgs().end());
+  iterArgs.append(second.getInitArgs().begin(), second.getInitArgs().end());
+  auto fused = builder.create<fir::DoLoopOp>(
+      first.getLoc(), first.getLowerBound(), first.getUpperBound(),
+      first.getStep(), first.getUnordered(), /*finalCountValue=*/false,
+      iterArgs);
+  mlir::Block *body = fused.getBody();
+  // The builder terminates the body itself when there are no iteration
+  // arguments; a fresh terminator is built below either way.
+  if (!body->empty())
+    body->back().erase();
+
+  llvm::SmallVector<mlir::Value> results;
+  auto mergeBody = [&](fir::DoLoopOp loop, unsigned argOffset) {
+    mlir::Block *from = loop.getBody();
+    mlir::Operation *terminator = from->getTerminator();
+    results.append(terminator->operand_begin(), terminator->operand_end());
+    terminator->erase();
+    loop.getInductionVar().replaceAllUsesWith(body->getArgument(0));
+    for (auto arg : llvm::enumerate(loop.getRegionIterArgs()))
+      arg.value().replaceAllUsesWith(
+          body->getArgument(1 + argOffset + arg.index()));
+    body->getOperations().splice(body->end(), from->getOperations());
+  };
+  unsigned numFirstIterArgs = first.getInitArgs().size();
+  mergeBody(first, 0);
+  mergeBody(second, numFirstIterArgs);
+  builder.setInsertionPointToEnd(body);
+  builder.create<fir::ResultOp>(fused.getLoc(), results);
+
+  for (auto result : llvm::enumerate(first.getResults()))
+    result.value().replaceAllUsesWith(fused.getResult(result.index()));
+  for (auto result : llvm::enumerate(second.getResults()))
+    result.value().replaceAllUsesWith(
+        fused.getResult(numFirstIterArgs + result.index()));
+  first.erase();
+  second.erase();
+  return fused;
+}
+
+/// Fuse adjacent conforming fir.do_loop operations.
+///
+/// Lowering emits one elemental loop nest per array assignment, and fusing
+/// the nests that share an iteration space removes the passes over memory
+/// between consecutive statements. Only directly adjacent loops are
+/// considered; the scheduling freedom a general fusion framework buys is not
+/// worth the compile time here since array statement loops are emitted
+/// back-to-back.
+class LoopFusion : public fir::impl::LoopFusionBase<LoopFusion> {
+public:
+  void runOnOperation() override {
+    mlir::func::FuncOp func = getOperation();
+    llvm::SmallVector<fir::DoLoopOp> candidates;
+    func.walk([&](fir::DoLoopOp loop) { candidates.push_back(loop); });
+    // The walk is post-order, so fusing outer loops last allows inner fusion
+    // results to feed the legality checks of their parents.
+    llvm::SmallPtrSet<mlir::Operation *, 8> erased;
+    for (fir::DoLoopOp loop : candidates) {
+      if (erased.count(loop.getOperation()))
+        continue;
+      while (auto next = mlir::dyn_cast_or_null<fir::DoLoopOp>(
+                 loop->getNextNode())) {
+        if (erased.count(next.getOperation()) || !canFuse(loop, next))
+          break;
+        LLVM_DEBUG(llvm::dbgs() << "fusing " << loop << " and " << next
+                                << " in " << func.getName() << '\n');
+        erased.insert(loop.getOperation());
+        erased.insert(next.getOperation());
+        loop = fuse(loop, next);
+      }
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<mlir::Pass> fir::createLoopFusionPass() {
+  return std::make_unique<LoopFusion>();
+}
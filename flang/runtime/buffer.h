@@ -112,6 +112,23 @@ public:
 
   void Flush(IoErrorHandler &handler, std::int64_t keep = 0) {
     if (dirty_) {
+      // Flushes that cover a large contiguous span on a unit that accepts
+      // asynchronous output hand the buffer itself over to the background
+      // writer and start afresh, so that writing a big record (e.g. an
+      // unformatted checkpoint) overlaps with the computation of the next.
+      if (keep == 0 && length_ >= asyncFlushMinBytes &&
+          start_ + length_ <= size_ && Store().MayAsynchronousFlush()) {
+        const char *data{buffer_ + start_};
+        OwningPtr<char> storage{buffer_};
+        FileOffset at{fileOffset_};
+        std::size_t bytes{static_cast<std::size_t>(length_)};
+        buffer_ = nullptr;
+        size_ = 0;
+        Reset(at + bytes);
+        Store().WriteAsynchronouslyOwned(
+            at, std::move(storage), data, bytes, handler);
+        return;
+      }
       while (length_ > keep) {
         std::size_t chunk{
             std::min<std::size_t>(length_ - keep, size_ - start_)};
@@ -138,6 +155,10 @@ public:
   }
 
 private:
+  // Minimum dirty span for which Flush() swaps buffers and writes in the
+  // background rather than blocking.
+  static constexpr std::int64_t asyncFlushMinBytes{1 << 20};
+
   STORE &Store() { return static_cast<STORE &>(*this); }
 
   void Reallocate(std::int64_t bytes, const Terminator &terminator) {
@@ -25,6 +25,14 @@
 
 namespace Fortran::runtime::io {
 
+OpenFile::~OpenFile() {
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  StopWorker(); // completes any queued transfers first
+  ::pthread_cond_destroy(&asyncCond_);
+  ::pthread_mutex_destroy(&asyncMutex_);
+#endif
+}
+
 void OpenFile::set_path(OwningPtr<char> &&path, std::size_t bytes) {
   path_ = std::move(path);
   pathLength_ = bytes;
@@ -66,6 +74,10 @@ void OpenFile::Open(OpenStatus status, std::optional<Action> action,
       (status == OpenStatus::Old || status == OpenStatus::Unknown)) {
     return;
   }
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  DrainAsyncOps(&handler);
+  StopWorker();
+#endif
   CloseFd(handler);
   if (status == OpenStatus::Scratch) {
     if (path_.get()) {
@@ -173,6 +185,10 @@ void OpenFile::Predefine(int fd) {
 }
 
 void OpenFile::Close(CloseStatus status, IoErrorHandler &handler) {
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  DrainAsyncOps(&handler);
+  StopWorker();
+#endif
   pending_.reset();
   knownSize_.reset();
   switch (status) {
@@ -194,6 +210,9 @@ std::size_t OpenFile::Read(FileOffset at, char *buffer, std::size_t minBytes,
     return 0;
   }
   CheckOpen(handler);
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  DrainAsyncOps(&handler);
+#endif
   if (!Seek(at, handler)) {
     return 0;
   }
@@ -223,6 +242,9 @@ std::size_t OpenFile::Write(FileOffset at, const char *buffer,
     return 0;
   }
   CheckOpen(handler);
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  DrainAsyncOps(&handler);
+#endif
   if (!Seek(at, handler)) {
     return 0;
   }
@@ -256,6 +278,9 @@ inline static int openfile_ftruncate(int fd, OpenFile::FileOffset at) {
 
 void OpenFile::Truncate(FileOffset at, IoErrorHandler &handler) {
   CheckOpen(handler);
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  DrainAsyncOps(&handler);
+#endif
   if (!knownSize_ || *knownSize_ != at) {
     if (openfile_ftruncate(fd_, at) != 0) {
       handler.SignalErrno();
@@ -264,12 +289,19 @@ void OpenFile::Truncate(FileOffset at, IoErrorHandler &handler) {
   }
 }
 
-// The operation is performed immediately; the results are saved
-// to be claimed by a later WAIT statement.
-// TODO: True asynchronicity
+// When the background worker is available the transfer is queued to it and
+// performed with pread()/pwrite() while the program continues; its result is
+// claimed by a later WAIT statement.  Otherwise the operation is performed
+// immediately and only its result is deferred.
 int OpenFile::ReadAsynchronously(
     FileOffset at, char *buffer, std::size_t bytes, IoErrorHandler &handler) {
   CheckOpen(handler);
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  if (EnsureWorker()) {
+    return EnqueueAsyncOp(/*isWrite=*/false, at, buffer, nullptr, bytes,
+        OwningPtr<char>{}, handler);
+  }
+#endif
   int iostat{0};
   for (std::size_t got{0}; got < bytes;) {
 #if _XOPEN_SOURCE >= 500 || _POSIX_C_SOURCE >= 200809L
@@ -295,10 +327,18 @@ int OpenFile::ReadAsynchronously(
   return PendingResult(handler, iostat);
 }
 
-// TODO: True asynchronicity
 int OpenFile::WriteAsynchronously(FileOffset at, const char *buffer,
     std::size_t bytes, IoErrorHandler &handler) {
   CheckOpen(handler);
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  if (EnsureWorker()) {
+    if (knownSize_ && at + static_cast<FileOffset>(bytes) > *knownSize_) {
+      knownSize_ = at + bytes;
+    }
+    return EnqueueAsyncOp(/*isWrite=*/true, at, nullptr, buffer, bytes,
+        OwningPtr<char>{}, handler);
+  }
+#endif
   int iostat{0};
   for (std::size_t put{0}; put < bytes;) {
 #if _XOPEN_SOURCE >= 500 || _POSIX_C_SOURCE >= 200809L
@@ -321,8 +361,63 @@ int OpenFile::WriteAsynchronously(FileOffset at, const char *buffer,
   return PendingResult(handler, iostat);
 }
 
+void OpenFile::WriteAsynchronouslyOwned(FileOffset at,
+    OwningPtr<char> &&storage, const char *data, std::size_t bytes,
+    IoErrorHandler &handler) {
+  CheckOpen(handler);
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  if (EnsureWorker()) {
+    if (knownSize_ && at + static_cast<FileOffset>(bytes) > *knownSize_) {
+      knownSize_ = at + bytes;
+    }
+    EnqueueAsyncOp(/*isWrite=*/true, at, nullptr, data, bytes,
+        std::move(storage), handler);
+    return;
+  }
+#endif
+  Write(at, data, bytes, handler); // frees the buffer on return
+}
+
+bool OpenFile::MayAsynchronousFlush() const {
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  // The worker writes at absolute positions, so the file must be
+  // positionable; terminals and Windows text files need the synchronous
+  // paths' special treatment.
+  return mayAsynchronous_ && mayPosition_ && !isTerminal_ &&
+      !isWindowsTextFile_ && fd_ >= 0;
+#else
+  return false;
+#endif
+}
+
 void OpenFile::Wait(int id, IoErrorHandler &handler) {
   std::optional<int> ioStat;
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  ::pthread_mutex_lock(&asyncMutex_);
+  for (;;) {
+    Pending *prev{nullptr};
+    Pending *p{pending_.get()};
+    for (; p; p = (prev = p)->next.get()) {
+      if (p->id == id) {
+        break;
+      }
+    }
+    if (!p) {
+      break;
+    }
+    if (p->completed) {
+      ioStat = p->ioStat;
+      if (prev) {
+        prev->next.reset(p->next.release());
+      } else {
+        pending_.reset(p->next.release());
+      }
+      break;
+    }
+    ::pthread_cond_wait(&asyncCond_, &asyncMutex_); // invalidates prev & p
+  }
+  ::pthread_mutex_unlock(&asyncMutex_);
+#else
   Pending *prev{nullptr};
   for (Pending *p{pending_.get()}; p; p = (prev = p)->next.get()) {
     if (p->id == id) {
@@ -335,12 +430,16 @@ void OpenFile::Wait(int id, IoErrorHandler &handler) {
       break;
     }
   }
+#endif
   if (ioStat) {
     handler.SignalError(*ioStat);
   }
 }
 
 void OpenFile::WaitAll(IoErrorHandler &handler) {
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  DrainAsyncOps(&handler);
+#endif
   while (true) {
     int ioStat;
     if (pending_) {
@@ -406,11 +505,150 @@ bool OpenFile::RawSeekToEnd() {
 }
 
 int OpenFile::PendingResult(const Terminator &terminator, int iostat) {
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  ::pthread_mutex_lock(&asyncMutex_);
+#endif
   int id{nextId_++};
   pending_ = New<Pending>{terminator}(id, iostat, std::move(pending_));
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  ::pthread_mutex_unlock(&asyncMutex_);
+#endif
   return id;
 }
 
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+void *OpenFile::AsyncWorkerMain(void *file) {
+  reinterpret_cast<OpenFile *>(file)->AsyncWorkerLoop();
+  return nullptr;
+}
+
+void OpenFile::AsyncWorkerLoop() {
+  ::pthread_mutex_lock(&asyncMutex_);
+  for (;;) {
+    while (!workerShutdown_ && !workQueue_) {
+      ::pthread_cond_wait(&asyncCond_, &asyncMutex_);
+    }
+    if (!workQueue_) {
+      break; // shutting down and the queue has been drained
+    }
+    OwningPtr<AsyncOp> op{workQueue_.release()};
+    workQueue_.reset(op->next.release());
+    if (!workQueue_) {
+      workQueueTail_ = nullptr;
+    }
+    ::pthread_mutex_unlock(&asyncMutex_);
+    int iostat{0};
+    if (op->isWrite) {
+      for (std::size_t put{0}; put < op->bytes;) {
+        auto chunk{::pwrite(
+            fd_, op->writeBuffer + put, op->bytes - put, op->at + put)};
+        if (chunk >= 0) {
+          put += chunk;
+        } else {
+          auto err{errno};
+          if (err != EAGAIN && err != EWOULDBLOCK && err != EINTR) {
+            iostat = err;
+            break;
+          }
+        }
+      }
+    } else {
+      for (std::size_t got{0}; got < op->bytes;) {
+        auto chunk{
+            ::pread(fd_, op->readBuffer + got, op->bytes - got, op->at + got)};
+        if (chunk == 0) {
+          iostat = FORTRAN_RUNTIME_IOSTAT_END;
+          break;
+        } else if (chunk < 0) {
+          auto err{errno};
+          if (err != EAGAIN && err != EWOULDBLOCK && err != EINTR) {
+            iostat = err;
+            break;
+          }
+        } else {
+          got += chunk;
+        }
+      }
+    }
+    op->storage.reset(); // Pending & AsyncOp are freed without destruction
+    ::pthread_mutex_lock(&asyncMutex_);
+    if (op->pending) {
+      op->pending->ioStat = iostat;
+      op->pending->completed = true;
+    } else if (iostat != 0 && deferredAsyncError_ == 0) {
+      deferredAsyncError_ = iostat;
+    }
+    --inFlight_;
+    ::pthread_cond_broadcast(&asyncCond_);
+  }
+  ::pthread_mutex_unlock(&asyncMutex_);
+}
+
+bool OpenFile::EnsureWorker() {
+  if (!workerRunning_ &&
+      ::pthread_create(&worker_, nullptr, &AsyncWorkerMain, this) == 0) {
+    workerRunning_ = true;
+  }
+  return workerRunning_;
+}
+
+void OpenFile::StopWorker() {
+  if (workerRunning_) {
+    ::pthread_mutex_lock(&asyncMutex_);
+    workerShutdown_ = true;
+    ::pthread_cond_broadcast(&asyncCond_);
+    ::pthread_mutex_unlock(&asyncMutex_);
+    ::pthread_join(worker_, nullptr);
+    workerRunning_ = false;
+    workerShutdown_ = false;
+  }
+}
+
+int OpenFile::EnqueueAsyncOp(bool isWrite, FileOffset at, char *readBuffer,
+    const char *writeBuffer, std::size_t bytes, OwningPtr<char> &&storage,
+    const Terminator &terminator) {
+  bool wantId{!storage};
+  OwningPtr<AsyncOp> op{New<AsyncOp>{terminator}(isWrite, at, readBuffer,
+      writeBuffer, bytes, std::move(storage), nullptr, OwningPtr<AsyncOp>{})};
+  ::pthread_mutex_lock(&asyncMutex_);
+  int id{-1};
+  if (wantId) {
+    id = nextId_++;
+    pending_ = New<Pending>{terminator}(id, 0, std::move(pending_));
+    pending_->completed = false;
+    op->pending = pending_.get();
+  }
+  AsyncOp *raw{op.get()};
+  if (workQueueTail_) {
+    workQueueTail_->next = std::move(op);
+  } else {
+    workQueue_ = std::move(op);
+  }
+  workQueueTail_ = raw;
+  ++inFlight_;
+  ::pthread_cond_broadcast(&asyncCond_);
+  ::pthread_mutex_unlock(&asyncMutex_);
+  return id;
+}
+
+void OpenFile::DrainAsyncOps(IoErrorHandler *handler) {
+  if (workerRunning_) {
+    ::pthread_mutex_lock(&asyncMutex_);
+    while (inFlight_ > 0) {
+      ::pthread_cond_wait(&asyncCond_, &asyncMutex_);
+    }
+    int deferred{deferredAsyncError_};
+    if (handler) {
+      deferredAsyncError_ = 0;
+    }
+    ::pthread_mutex_unlock(&asyncMutex_);
+    if (handler && deferred != 0) {
+      handler->SignalError(deferred);
+    }
+  }
+}
+#endif // FORTRAN_RUNTIME_ASYNC_IO_THREAD
+
 void OpenFile::CloseFd(IoErrorHandler &handler) {
   if (fd_ >= 0) {
     if (fd_ <= 2) {
@@ -16,6 +16,16 @@
 #include <cinttypes>
 #include <optional>
 
+// Genuinely asynchronous transfers need a background thread and positional
+// reads & writes; use pthreads where they and pread/pwrite are available.
+// Otherwise "asynchronous" operations complete synchronously, as before.
+#if !defined(_WIN32) && (_XOPEN_SOURCE >= 500 || _POSIX_C_SOURCE >= 200809L)
+#define FORTRAN_RUNTIME_ASYNC_IO_THREAD 1
+#endif
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+#include <pthread.h>
+#endif
+
 namespace Fortran::runtime::io {
 
 enum class OpenStatus { Old, New, Scratch, Replace, Unknown };
@@ -27,6 +37,8 @@ class OpenFile {
 public:
   using FileOffset = std::int64_t;
 
+  ~OpenFile();
+
   const char *path() const { return path_.get(); }
   std::size_t pathLength() const { return pathLength_; }
   void set_path(OwningPtr<char> &&, std::size_t bytes);
@@ -66,6 +78,17 @@ public:
   void Wait(int id, IoErrorHandler &);
   void WaitAll(IoErrorHandler &);
 
+  // Hands a heap-allocated buffer over to the background writer, which frees
+  // it once the write has completed.  There is no id to WAIT on; errors are
+  // reported on the next operation that has a handler.  Used by FileFrame to
+  // swap buffers on large flushes instead of blocking on the write.
+  void WriteAsynchronouslyOwned(
+      FileOffset, OwningPtr<char> &&, const char *, std::size_t bytes,
+      IoErrorHandler &);
+
+  // Would WriteAsynchronouslyOwned() overlap with computation?
+  bool MayAsynchronousFlush() const;
+
   // INQUIRE(POSITION=)
   Position InquirePosition() const;
 
@@ -74,8 +97,26 @@ private:
     int id;
     int ioStat{0};
     OwningPtr<Pending> next;
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+    bool completed{true}; // false while queued for or on the worker thread
+#endif
   };
 
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  // A queued asynchronous transfer.  The worker thread performs these in
+  // order with pread()/pwrite(), so they never perturb position_.
+  struct AsyncOp {
+    bool isWrite;
+    FileOffset at;
+    char *readBuffer; // target, when !isWrite
+    const char *writeBuffer; // source, when isWrite
+    std::size_t bytes;
+    OwningPtr<char> storage; // owned allocation for buffer-swapping flushes
+    Pending *pending; // result slot; null for flushes with no id
+    OwningPtr<AsyncOp> next;
+  };
+#endif
+
   void CheckOpen(const Terminator &);
   bool Seek(FileOffset, IoErrorHandler &);
   bool RawSeek(FileOffset);
@@ -86,6 +127,22 @@ private:
     openPosition_.reset();
   }
   void CloseFd(IoErrorHandler &);
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  bool EnsureWorker();
+  void StopWorker();
+  // Returns the transfer's id, or -1 when the caller passed ownership of the
+  // buffer (such transfers have no id and cannot be waited for).
+  int EnqueueAsyncOp(bool isWrite, FileOffset, char *readBuffer,
+      const char *writeBuffer, std::size_t, OwningPtr<char> &&storage,
+      const Terminator &);
+  // Blocks until all queued transfers are done; reports any error from an
+  // id-less transfer when a handler is supplied.  Must precede synchronous
+  // reads, writes, truncation, and closing to keep them ordered after the
+  // asynchronous operations already in flight.
+  void DrainAsyncOps(IoErrorHandler *);
+  static void *AsyncWorkerMain(void *);
+  void AsyncWorkerLoop();
+#endif
 
   int fd_{-1};
   OwningPtr<char> path_;
@@ -102,6 +159,20 @@ private:
 
   int nextId_;
   OwningPtr<Pending> pending_;
+
+#if FORTRAN_RUNTIME_ASYNC_IO_THREAD
+  // Guards pending_, the work queue, and the counters below once the worker
+  // thread exists.
+  pthread_mutex_t asyncMutex_ = PTHREAD_MUTEX_INITIALIZER;
+  pthread_cond_t asyncCond_ = PTHREAD_COND_INITIALIZER;
+  pthread_t worker_{};
+  bool workerRunning_{false};
+  bool workerShutdown_{false};
+  int inFlight_{0}; // queued or executing asynchronous transfers
+  int deferredAsyncError_{0}; // first error from an id-less transfer
+  OwningPtr<AsyncOp> workQueue_; // FIFO; head is performed first
+  AsyncOp *workQueueTail_{nullptr};
+#endif
 };
 
 bool IsATerminal(int fd);
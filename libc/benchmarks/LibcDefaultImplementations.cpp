@@ -1,7 +1,14 @@
 #include "LibcFunctionPrototypes.h"
+#include "src/__support/architectures.h"
 #include "llvm/ADT/ArrayRef.h"
 #include <cstddef>
 
+#if defined(LLVM_LIBC_ARCH_X86)
+#include "src/string/memory_utils/cpu_features_x86.h"
+#include "src/string/memory_utils/memcpy_implementations.h"
+#include <vector>
+#endif
+
 namespace __llvm_libc {
 
 extern void *memcpy(void *__restrict, const void *__restrict, size_t);
@@ -21,10 +28,73 @@ using llvm::libc_benchmarks::MemcpyConfiguration;
 using llvm::libc_benchmarks::MemmoveConfiguration;
 using llvm::libc_benchmarks::MemsetConfiguration;
 
+#if defined(LLVM_LIBC_ARCH_X86)
+namespace {
+
+// The per-generation strategies used by the runtime dispatch in
+// src/string/memcpy.cpp, compiled here with their respective target features
+// so a single benchmark run can report which one the dispatcher should select
+// on this machine.
+[[gnu::flatten, gnu::target("sse2")]] void *
+memcpy_x86_sse2(void *__restrict dst, const void *__restrict src,
+                size_t count) {
+  __llvm_libc::x86::inline_memcpy_x86<__llvm_libc::builtin::_32,
+                                      /*USE_128B_HEAD_TAIL=*/false,
+                                      /*REP_MOVS_B_SIZE=*/size_t(-1)>(
+      reinterpret_cast<char *>(dst), reinterpret_cast<const char *>(src),
+      count);
+  return dst;
+}
+
+[[gnu::flatten, gnu::target("avx")]] void *
+memcpy_x86_avx(void *__restrict dst, const void *__restrict src,
+               size_t count) {
+  __llvm_libc::x86::inline_memcpy_x86<__llvm_libc::builtin::_64,
+                                      /*USE_128B_HEAD_TAIL=*/true,
+                                      /*REP_MOVS_B_SIZE=*/size_t(-1)>(
+      reinterpret_cast<char *>(dst), reinterpret_cast<const char *>(src),
+      count);
+  return dst;
+}
+
+[[gnu::flatten, gnu::target("avx512f")]] void *
+memcpy_x86_avx512(void *__restrict dst, const void *__restrict src,
+                  size_t count) {
+  __llvm_libc::x86::inline_memcpy_x86<__llvm_libc::builtin::_64,
+                                      /*USE_128B_HEAD_TAIL=*/true,
+                                      /*REP_MOVS_B_SIZE=*/size_t(-1)>(
+      reinterpret_cast<char *>(dst), reinterpret_cast<const char *>(src),
+      count);
+  return dst;
+}
+
+} // namespace
+#endif // defined(LLVM_LIBC_ARCH_X86)
+
 llvm::ArrayRef<MemcpyConfiguration> getMemcpyConfigurations() {
+#if defined(LLVM_LIBC_ARCH_X86)
+  // Only benchmark the strategies this machine can run, mirroring what the
+  // runtime dispatcher would consider.
+  static const std::vector<MemcpyConfiguration> kMemcpyConfigurations = [] {
+    std::vector<MemcpyConfiguration> Configurations;
+    Configurations.push_back({__llvm_libc::memcpy, "__llvm_libc::memcpy"});
+    const auto Features = __llvm_libc::x86::detect_cpu_features();
+    Configurations.push_back(
+        {memcpy_x86_sse2, "__llvm_libc::memcpy_x86_sse2"});
+    if (Features.avx)
+      Configurations.push_back(
+          {memcpy_x86_avx, "__llvm_libc::memcpy_x86_avx"});
+    if (Features.avx512f)
+      Configurations.push_back(
+          {memcpy_x86_avx512, "__llvm_libc::memcpy_x86_avx512"});
+    return Configurations;
+  }();
+  return llvm::makeArrayRef(kMemcpyConfigurations);
+#else
   static constexpr MemcpyConfiguration kMemcpyConfigurations[] = {
       {__llvm_libc::memcpy, "__llvm_libc::memcpy"}};
   return llvm::makeArrayRef(kMemcpyConfigurations);
+#endif
 }
 llvm::ArrayRef<MemmoveConfiguration> getMemmoveConfigurations() {
   static constexpr MemmoveConfiguration kMemmoveConfigurations[] = {
@@ -10,8 +10,90 @@
 #include "src/__support/common.h"
 #include "src/string/memory_utils/memcpy_implementations.h"
 
+// When LLVM_LIBC_MEMCPY_X86_USE_RUNTIME_DISPATCH is defined, the x86 memcpy is
+// resolved once at load time through an ELF IFUNC instead of being selected
+// when the library is compiled. This lets a single library image serve several
+// cpu generations: the resolver picks the strategy matching the features the
+// host actually has, so AVX-512 machines get 64-byte loop blocks while older
+// machines keep the SSE2 schedule. The per-strategy tunables live in
+// x86::inline_memcpy_x86 (see memcpy_implementations.h).
+#if defined(LLVM_LIBC_ARCH_X86) &&                                             \
+    defined(LLVM_LIBC_MEMCPY_X86_USE_RUNTIME_DISPATCH) && defined(__ELF__)
+#define LLVM_LIBC_MEMCPY_RUNTIME_DISPATCH
+#include "src/string/memory_utils/cpu_features_x86.h"
+#endif
+
 namespace __llvm_libc {
 
+#ifdef LLVM_LIBC_MEMCPY_RUNTIME_DISPATCH
+
+namespace {
+
+constexpr size_t REP_MOVS_B_SIZE =
+#if defined(LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE)
+    LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE;
+#else
+    -1;
+#endif // LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE
+
+// One strategy per deployed cpu generation. [[gnu::flatten]] ensures the
+// element copies are compiled with the target features of their variant.
+[[gnu::flatten, gnu::target("sse2")]] void *
+memcpy_x86_sse2(void *__restrict dst, const void *__restrict src,
+                size_t count) {
+  x86::inline_memcpy_x86<builtin::_32, /*USE_128B_HEAD_TAIL=*/false,
+                         REP_MOVS_B_SIZE>(reinterpret_cast<char *>(dst),
+                                          reinterpret_cast<const char *>(src),
+                                          count);
+  return dst;
+}
+
+[[gnu::flatten, gnu::target("avx")]] void *
+memcpy_x86_avx(void *__restrict dst, const void *__restrict src,
+               size_t count) {
+  x86::inline_memcpy_x86<builtin::_64, /*USE_128B_HEAD_TAIL=*/true,
+                         REP_MOVS_B_SIZE>(reinterpret_cast<char *>(dst),
+                                          reinterpret_cast<const char *>(src),
+                                          count);
+  return dst;
+}
+
+[[gnu::flatten, gnu::target("avx512f")]] void *
+memcpy_x86_avx512(void *__restrict dst, const void *__restrict src,
+                  size_t count) {
+  x86::inline_memcpy_x86<builtin::_64, /*USE_128B_HEAD_TAIL=*/true,
+                         REP_MOVS_B_SIZE>(reinterpret_cast<char *>(dst),
+                                          reinterpret_cast<const char *>(src),
+                                          count);
+  return dst;
+}
+
+} // namespace
+
+// The resolver may run before relocations are processed, so it must not call
+// into other translation units; everything it uses is inline or internal to
+// this one.
+extern "C" void *__llvm_libc_memcpy_resolver() {
+  const x86::CpuFeatures features = x86::detect_cpu_features();
+  if (features.avx512f)
+    return reinterpret_cast<void *>(memcpy_x86_avx512);
+  if (features.avx)
+    return reinterpret_cast<void *>(memcpy_x86_avx);
+  return reinterpret_cast<void *>(memcpy_x86_sse2);
+}
+
+#if defined(LLVM_LIBC_PUBLIC_PACKAGING) && (!defined(__APPLE__))
+LLVM_LIBC_FUNCTION_ATTR decltype(__llvm_libc::memcpy)
+    __memcpy_ifunc__ __asm__("memcpy")
+    __attribute__((ifunc("__llvm_libc_memcpy_resolver")));
+decltype(__llvm_libc::memcpy) memcpy [[gnu::alias("memcpy")]];
+#else
+decltype(__llvm_libc::memcpy)
+    memcpy __attribute__((ifunc("__llvm_libc_memcpy_resolver")));
+#endif
+
+#else // LLVM_LIBC_MEMCPY_RUNTIME_DISPATCH
+
 LLVM_LIBC_FUNCTION(void *, memcpy,
                    (void *__restrict dst, const void *__restrict src,
                     size_t size)) {
@@ -20,4 +102,6 @@ LLVM_LIBC_FUNCTION(void *, memcpy,
   return dst;
 }
 
+#endif // LLVM_LIBC_MEMCPY_RUNTIME_DISPATCH
+
 } // namespace __llvm_libc
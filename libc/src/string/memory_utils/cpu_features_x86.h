@@ -0,0 +1,73 @@
+//===-- Runtime x86 cpu feature detection -----------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STRING_MEMORY_UTILS_CPU_FEATURES_X86_H
+#define LLVM_LIBC_SRC_STRING_MEMORY_UTILS_CPU_FEATURES_X86_H
+
+#include "src/__support/architectures.h"
+#include "src/__support/common.h"
+
+#if defined(LLVM_LIBC_ARCH_X86)
+
+#include <stdint.h> // uint32_t, uint64_t
+
+namespace __llvm_libc {
+namespace x86 {
+
+// The cpu features relevant to selecting a memory function implementation.
+struct CpuFeatures {
+  bool avx = false;
+  bool avx512f = false;
+};
+
+static inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t &eax,
+                         uint32_t &ebx, uint32_t &ecx, uint32_t &edx) {
+  LIBC_INLINE_ASM("cpuid"
+                  : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                  : "a"(leaf), "c"(subleaf));
+}
+
+static inline uint64_t xgetbv(uint32_t index) {
+  uint32_t eax, edx;
+  LIBC_INLINE_ASM("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+  return (uint64_t(edx) << 32) | eax;
+}
+
+// Detects the features of the host cpu. A feature is only reported when both
+// the cpu implements it and the OS saves the associated register state. This
+// is safe to call from an IFUNC resolver: it executes only cpuid/xgetbv and
+// touches no global state.
+static inline CpuFeatures detect_cpu_features() {
+  CpuFeatures features;
+  uint32_t eax, ebx, ecx, edx;
+  cpuid(0, 0, eax, ebx, ecx, edx);
+  const uint32_t max_leaf = eax;
+  if (max_leaf < 1)
+    return features;
+  cpuid(1, 0, eax, ebx, ecx, edx);
+  const bool has_osxsave = ecx & (1u << 27);
+  const bool has_avx = ecx & (1u << 28);
+  if (!has_osxsave)
+    return features;
+  const uint64_t xcr0 = xgetbv(0);
+  const bool ymm_enabled = (xcr0 & 0x6) == 0x6;   // XMM and YMM state.
+  const bool zmm_enabled = (xcr0 & 0xe6) == 0xe6; // Plus opmask and ZMM state.
+  features.avx = has_avx && ymm_enabled;
+  if (max_leaf < 7 || !zmm_enabled)
+    return features;
+  cpuid(7, 0, eax, ebx, ecx, edx);
+  features.avx512f = ebx & (1u << 16);
+  return features;
+}
+
+} // namespace x86
+} // namespace __llvm_libc
+
+#endif // defined(LLVM_LIBC_ARCH_X86)
+
+#endif // LLVM_LIBC_SRC_STRING_MEMORY_UTILS_CPU_FEATURES_X86_H
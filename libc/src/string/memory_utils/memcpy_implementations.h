@@ -37,38 +37,26 @@
 
 namespace __llvm_libc {
 
-static inline void inline_memcpy(char *__restrict dst,
-                                 const char *__restrict src, size_t count) {
-  using namespace __llvm_libc::builtin;
 #if defined(LLVM_LIBC_ARCH_X86)
-  /////////////////////////////////////////////////////////////////////////////
-  // LLVM_LIBC_ARCH_X86
-  /////////////////////////////////////////////////////////////////////////////
+namespace x86 {
 
-  // Whether to use only rep;movsb.
-  constexpr bool USE_ONLY_REP_MOVSB =
-      LLVM_LIBC_IS_DEFINED(LLVM_LIBC_MEMCPY_X86_USE_ONLY_REPMOVSB);
-
-  // kRepMovsBSize == -1 : Only CopyAligned is used.
-  // kRepMovsBSize ==  0 : Only RepMovsb is used.
-  // else CopyAligned is used up to kRepMovsBSize and then RepMovsb.
-  constexpr size_t REP_MOVS_B_SIZE =
-#if defined(LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE)
-      LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE;
-#else
-      -1;
-#endif // LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE
-
-  // Whether target supports AVX instructions.
-  constexpr bool HAS_AVX = LLVM_LIBC_IS_DEFINED(__AVX__);
-
-#if defined(__AVX__)
-  using LoopBlockSize = _64;
-#else
-  using LoopBlockSize = _32;
-#endif
-
-  if (USE_ONLY_REP_MOVSB)
+// The x86 copy strategy with its tunables lifted into template parameters so
+// that several variants can coexist in one binary (see the runtime dispatch
+// in src/string/memcpy.cpp):
+// - LoopBlockSize is the block size of the aligned copy loop.
+// - USE_128B_HEAD_TAIL enables the 128-byte head/tail size class, which is
+//   only profitable when wide loads and stores are available.
+// - REP_MOVS_B_SIZE selects when rep;movsb takes over:
+//   REP_MOVS_B_SIZE == -1 : Only CopyAligned is used.
+//   REP_MOVS_B_SIZE ==  0 : Only RepMovsb is used.
+//   else CopyAligned is used up to REP_MOVS_B_SIZE and then RepMovsb.
+template <typename LoopBlockSize, bool USE_128B_HEAD_TAIL,
+          size_t REP_MOVS_B_SIZE>
+static inline void inline_memcpy_x86(char *__restrict dst,
+                                     const char *__restrict src,
+                                     size_t count) {
+  using namespace __llvm_libc::builtin;
+  if (REP_MOVS_B_SIZE == 0)
     return copy<x86::Accelerator>(dst, src, count);
 
   if (count == 0)
@@ -91,12 +79,48 @@ static inline void inline_memcpy(char *__restrict dst,
     return copy<HeadTail<_32>>(dst, src, count);
   if (count < 128)
     return copy<HeadTail<_64>>(dst, src, count);
-  if (HAS_AVX && count < 256)
+  if (USE_128B_HEAD_TAIL && count < 256)
     return copy<HeadTail<_128>>(dst, src, count);
   if (count <= REP_MOVS_B_SIZE)
     return copy<Align<_32, Arg::Dst>::Then<Loop<LoopBlockSize>>>(dst, src,
                                                                  count);
   return copy<x86::Accelerator>(dst, src, count);
+}
+
+} // namespace x86
+#endif // defined(LLVM_LIBC_ARCH_X86)
+
+static inline void inline_memcpy(char *__restrict dst,
+                                 const char *__restrict src, size_t count) {
+  using namespace __llvm_libc::builtin;
+#if defined(LLVM_LIBC_ARCH_X86)
+  /////////////////////////////////////////////////////////////////////////////
+  // LLVM_LIBC_ARCH_X86
+  /////////////////////////////////////////////////////////////////////////////
+
+  // Whether to use only rep;movsb.
+  constexpr bool USE_ONLY_REP_MOVSB =
+      LLVM_LIBC_IS_DEFINED(LLVM_LIBC_MEMCPY_X86_USE_ONLY_REPMOVSB);
+
+  constexpr size_t REP_MOVS_B_SIZE =
+#if defined(LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE)
+      LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE;
+#else
+      -1;
+#endif // LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE
+
+  // Whether target supports AVX instructions.
+  constexpr bool HAS_AVX = LLVM_LIBC_IS_DEFINED(__AVX__);
+
+#if defined(__AVX__)
+  using LoopBlockSize = _64;
+#else
+  using LoopBlockSize = _32;
+#endif
+
+  return x86::inline_memcpy_x86<LoopBlockSize, HAS_AVX,
+                                USE_ONLY_REP_MOVSB ? 0 : REP_MOVS_B_SIZE>(
+      dst, src, count);
 #elif defined(LLVM_LIBC_ARCH_AARCH64)
   /////////////////////////////////////////////////////////////////////////////
   // LLVM_LIBC_ARCH_AARCH64
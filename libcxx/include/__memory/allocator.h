@@ -116,7 +116,10 @@ public:
 #if _LIBCPP_STD_VER > 20
     [[nodiscard]] _LIBCPP_HIDE_FROM_ABI constexpr
     allocation_result<_Tp*> allocate_at_least(size_t __n) {
-        return {allocate(__n), __n};
+        _Tp* __ptr = allocate(__n);
+        if (!__libcpp_is_constant_evaluated())
+            return {__ptr, _VSTD::__libcpp_usable_size(__ptr, __n * sizeof(_Tp)) / sizeof(_Tp)};
+        return {__ptr, __n};
     }
 #endif
 
@@ -257,6 +260,20 @@ public:
 #endif
 };
 
+#if _LIBCPP_STD_VER <= 20
+// Overload of the internal allocate_at_least helper for std::allocator, so
+// that the containers' growth paths see the allocation's true usable size in
+// all dialects, not just when the C++23 allocate_at_least member is available.
+template <class _Tp>
+_LIBCPP_NODISCARD _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20
+__allocation_result<_Tp*> __allocate_at_least(allocator<_Tp>& __alloc, size_t __n) {
+    _Tp* __ptr = __alloc.allocate(__n);
+    if (!__libcpp_is_constant_evaluated())
+        return {__ptr, _VSTD::__libcpp_usable_size(__ptr, __n * sizeof(_Tp)) / sizeof(_Tp)};
+    return {__ptr, __n};
+}
+#endif
+
 template <class _Tp, class _Up>
 inline _LIBCPP_INLINE_VISIBILITY _LIBCPP_CONSTEXPR_SINCE_CXX20
 bool operator==(const allocator<_Tp>&, const allocator<_Up>&) _NOEXCEPT {return true;}
@@ -742,8 +742,9 @@ __search_substring(const _CharT *__first1, const _CharT *__last1,
   if (__len1 < __len2)
     return __last1;
 
-  // First element of __first2 is loop invariant.
+  // First and last elements of __first2 are loop invariant.
   _CharT __f2 = *__first2;
+  _CharT __l2 = __first2[__len2 - 1];
   while (true) {
     __len1 = __last1 - __first1;
     // Check whether __first1 still has at least __len2 bytes.
@@ -755,12 +756,18 @@ __search_substring(const _CharT *__first1, const _CharT *__last1,
     if (__first1 == nullptr)
       return __last1;
 
+    // Check the last byte of the candidate window before comparing the whole
+    // pattern: on periodic haystacks most candidates found by the first-byte
+    // scan differ in their tail, and this rejects them without paying for a
+    // full comparison.
+    //
     // It is faster to compare from the first byte of __first1 even if we
     // already know that it matches the first byte of __first2: this is because
     // __first2 is most likely aligned, as it is user's "pattern" string, and
     // __first1 + 1 is most likely not aligned, as the match is in the middle of
     // the string.
-    if (_Traits::compare(__first1, __first2, __len2) == 0)
+    if (_Traits::eq(__first1[__len2 - 1], __l2) &&
+        _Traits::compare(__first1, __first2, __len2) == 0)
       return __first1;
 
     ++__first1;
@@ -813,15 +820,21 @@ inline _SizeT _LIBCPP_CONSTEXPR_SINCE_CXX14 _LIBCPP_INLINE_VISIBILITY
 __str_rfind(const _CharT *__p, _SizeT __sz,
         const _CharT* __s, _SizeT __pos, _SizeT __n) _NOEXCEPT
 {
-    __pos = _VSTD::min(__pos, __sz);
-    if (__n < __sz - __pos)
-        __pos += __n;
-    else
-        __pos = __sz;
-    const _CharT* __r = std::__find_end_classic(__p, __p + __pos, __s, __s + __n, _Traits::eq);
-    if (__n > 0 && __r == __p + __pos)
+    if (__n == 0)
+        return _VSTD::min(__pos, __sz);
+    if (__n > __sz)
         return __npos;
-    return static_cast<_SizeT>(__r - __p);
+    // Walk candidate positions from the back, checking the first character
+    // before comparing the whole pattern so that _Traits::compare (and thus
+    // memcmp for the byte-sized character types) does the heavy lifting.
+    const _CharT __f = *__s;
+    for (const _CharT* __ps = __p + _VSTD::min(__pos, __sz - __n);; --__ps)
+    {
+        if (_Traits::eq(*__ps, __f) && _Traits::compare(__ps, __s, __n) == 0)
+            return static_cast<_SizeT>(__ps - __p);
+        if (__ps == __p)
+            return __npos;
+    }
 }
 
 // __str_find_first_of
@@ -832,6 +845,19 @@ __str_find_first_of(const _CharT *__p, _SizeT __sz,
 {
     if (__pos >= __sz || __n == 0)
         return __npos;
+    // For byte-sized characters, a table of the characters to look for makes
+    // the scan O(__sz + __n) instead of O(__sz * __n). Building the table is
+    // only worth it once the set holds more than a few characters.
+    if (sizeof(_CharT) == 1 && __n > 4)
+    {
+        bool __table[256] = {};
+        for (_SizeT __i = 0; __i != __n; ++__i)
+            __table[static_cast<unsigned char>(__s[__i])] = true;
+        for (const _CharT* __ps = __p + __pos; __ps != __p + __sz; ++__ps)
+            if (__table[static_cast<unsigned char>(*__ps)])
+                return static_cast<_SizeT>(__ps - __p);
+        return __npos;
+    }
     const _CharT* __r = _VSTD::__find_first_of_ce
         (__p + __pos, __p + __sz, __s, __s + __n, _Traits::eq );
     if (__r == __p + __sz)
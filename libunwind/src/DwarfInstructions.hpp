@@ -22,6 +22,10 @@
 #include "dwarf2.h"
 #include "libunwind_ext.h"
 
+#if defined(_LIBUNWIND_USE_DWARF_PROLOG_CACHE)
+#include "DwarfPrologCache.hpp"
+#endif
+
 
 namespace libunwind {
 
@@ -52,6 +56,8 @@ private:
   typedef typename CFI_Parser<A>::FDE_Info          FDE_Info;
   typedef typename CFI_Parser<A>::CIE_Info          CIE_Info;
 
+  static bool getUnwindPlan(A &addressSpace, pint_t pc, pint_t fdeStart,
+                            CIE_Info &cieInfo, PrologInfo &prolog);
   static pint_t evaluateExpression(pint_t expression, A &addressSpace,
                                    const R &registers,
                                    pint_t initialStackValue);
@@ -187,123 +193,145 @@ bool DwarfInstructions<A, R>::getRA_SIGN_STATE(A &addressSpace, R registers,
 }
 #endif
 
+/// Produce the decoded unwind plan (the PrologInfo row and CIE info) for
+/// \p pc, consulting the per-process cache when it is enabled so repeated
+/// unwinds through hot frames skip the FDE/CFI decoding.
+template <typename A, typename R>
+bool DwarfInstructions<A, R>::getUnwindPlan(A &addressSpace, pint_t pc,
+                                            pint_t fdeStart, CIE_Info &cieInfo,
+                                            PrologInfo &prolog) {
+#if defined(_LIBUNWIND_USE_DWARF_PROLOG_CACHE)
+  if (DwarfPrologCache<A>::find(pc, fdeStart, &prolog, &cieInfo))
+    return true;
+#endif
+  FDE_Info fdeInfo;
+  if (CFI_Parser<A>::decodeFDE(addressSpace, fdeStart, &fdeInfo, &cieInfo) !=
+      NULL)
+    return false;
+  if (!CFI_Parser<A>::parseFDEInstructions(addressSpace, fdeInfo, cieInfo, pc,
+                                           R::getArch(), &prolog))
+    return false;
+#if defined(_LIBUNWIND_USE_DWARF_PROLOG_CACHE)
+  DwarfPrologCache<A>::add(pc, fdeStart, prolog, cieInfo);
+#endif
+  return true;
+}
+
 template <typename A, typename R>
 int DwarfInstructions<A, R>::stepWithDwarf(A &addressSpace, pint_t pc,
                                            pint_t fdeStart, R &registers,
                                            bool &isSignalFrame) {
-  FDE_Info fdeInfo;
   CIE_Info cieInfo;
-  if (CFI_Parser<A>::decodeFDE(addressSpace, fdeStart, &fdeInfo,
-                               &cieInfo) == NULL) {
-    PrologInfo prolog;
-    if (CFI_Parser<A>::parseFDEInstructions(addressSpace, fdeInfo, cieInfo, pc,
-                                            R::getArch(), &prolog)) {
-      // get pointer to cfa (architecture specific)
-      pint_t cfa = getCFA(addressSpace, prolog, registers);
-
-       // restore registers that DWARF says were saved
-      R newRegisters = registers;
-
-      // Typically, the CFA is the stack pointer at the call site in
-      // the previous frame. However, there are scenarios in which this is not
-      // true. For example, if we switched to a new stack. In that case, the
-      // value of the previous SP might be indicated by a CFI directive.
-      //
-      // We set the SP here to the CFA, allowing for it to be overridden
-      // by a CFI directive later on.
-      newRegisters.setSP(cfa);
-
-      pint_t returnAddress = 0;
-      constexpr int lastReg = R::lastDwarfRegNum();
-      static_assert(static_cast<int>(CFI_Parser<A>::kMaxRegisterNumber) >=
-                        lastReg,
-                    "register range too large");
-      assert(lastReg >= (int)cieInfo.returnAddressRegister &&
-             "register range does not contain return address register");
-      for (int i = 0; i <= lastReg; ++i) {
-        if (prolog.savedRegisters[i].location !=
-            CFI_Parser<A>::kRegisterUnused) {
-          if (registers.validFloatRegister(i))
-            newRegisters.setFloatRegister(
-                i, getSavedFloatRegister(addressSpace, registers, cfa,
-                                         prolog.savedRegisters[i]));
-          else if (registers.validVectorRegister(i))
-            newRegisters.setVectorRegister(
-                i, getSavedVectorRegister(addressSpace, registers, cfa,
-                                          prolog.savedRegisters[i]));
-          else if (i == (int)cieInfo.returnAddressRegister)
-            returnAddress = getSavedRegister(addressSpace, registers, cfa,
-                                             prolog.savedRegisters[i]);
-          else if (registers.validRegister(i))
-            newRegisters.setRegister(
-                i, getSavedRegister(addressSpace, registers, cfa,
-                                    prolog.savedRegisters[i]));
-          else
-            return UNW_EBADREG;
-        } else if (i == (int)cieInfo.returnAddressRegister) {
-            // Leaf function keeps the return address in register and there is no
-            // explicit instructions how to restore it.
-            returnAddress = registers.getRegister(cieInfo.returnAddressRegister);
-        }
-      }
+  PrologInfo prolog;
+  if (!getUnwindPlan(addressSpace, pc, fdeStart, cieInfo, prolog))
+    return UNW_EBADFRAME;
+
+  // get pointer to cfa (architecture specific)
+  pint_t cfa = getCFA(addressSpace, prolog, registers);
+
+   // restore registers that DWARF says were saved
+  R newRegisters = registers;
+
+  // Typically, the CFA is the stack pointer at the call site in
+  // the previous frame. However, there are scenarios in which this is not
+  // true. For example, if we switched to a new stack. In that case, the
+  // value of the previous SP might be indicated by a CFI directive.
+  //
+  // We set the SP here to the CFA, allowing for it to be overridden
+  // by a CFI directive later on.
+  newRegisters.setSP(cfa);
+
+  pint_t returnAddress = 0;
+  constexpr int lastReg = R::lastDwarfRegNum();
+  static_assert(static_cast<int>(CFI_Parser<A>::kMaxRegisterNumber) >=
+                    lastReg,
+                "register range too large");
+  assert(lastReg >= (int)cieInfo.returnAddressRegister &&
+         "register range does not contain return address register");
+  for (int i = 0; i <= lastReg; ++i) {
+    if (prolog.savedRegisters[i].location !=
+        CFI_Parser<A>::kRegisterUnused) {
+      if (registers.validFloatRegister(i))
+        newRegisters.setFloatRegister(
+            i, getSavedFloatRegister(addressSpace, registers, cfa,
+                                     prolog.savedRegisters[i]));
+      else if (registers.validVectorRegister(i))
+        newRegisters.setVectorRegister(
+            i, getSavedVectorRegister(addressSpace, registers, cfa,
+                                      prolog.savedRegisters[i]));
+      else if (i == (int)cieInfo.returnAddressRegister)
+        returnAddress = getSavedRegister(addressSpace, registers, cfa,
+                                         prolog.savedRegisters[i]);
+      else if (registers.validRegister(i))
+        newRegisters.setRegister(
+            i, getSavedRegister(addressSpace, registers, cfa,
+                                prolog.savedRegisters[i]));
+      else
+        return UNW_EBADREG;
+    } else if (i == (int)cieInfo.returnAddressRegister) {
+        // Leaf function keeps the return address in register and there is no
+        // explicit instructions how to restore it.
+        returnAddress = registers.getRegister(cieInfo.returnAddressRegister);
+    }
+  }
 
-      isSignalFrame = cieInfo.isSignalFrame;
+  isSignalFrame = cieInfo.isSignalFrame;
 
 #if defined(_LIBUNWIND_TARGET_AARCH64)
-      // If the target is aarch64 then the return address may have been signed
-      // using the v8.3 pointer authentication extensions. The original
-      // return address needs to be authenticated before the return address is
-      // restored. autia1716 is used instead of autia as autia1716 assembles
-      // to a NOP on pre-v8.3a architectures.
-      if ((R::getArch() == REGISTERS_ARM64) &&
-          getRA_SIGN_STATE(addressSpace, registers, cfa, prolog) &&
-          returnAddress != 0) {
+  // If the target is aarch64 then the return address may have been signed
+  // using the v8.3 pointer authentication extensions. The original
+  // return address needs to be authenticated before the return address is
+  // restored. autia1716 is used instead of autia as autia1716 assembles
+  // to a NOP on pre-v8.3a architectures.
+  if ((R::getArch() == REGISTERS_ARM64) &&
+      getRA_SIGN_STATE(addressSpace, registers, cfa, prolog) &&
+      returnAddress != 0) {
 #if !defined(_LIBUNWIND_IS_NATIVE_ONLY)
-        return UNW_ECROSSRASIGNING;
+    return UNW_ECROSSRASIGNING;
 #else
-        register unsigned long long x17 __asm("x17") = returnAddress;
-        register unsigned long long x16 __asm("x16") = cfa;
-
-        // These are the autia1716/autib1716 instructions. The hint instructions
-        // are used here as gcc does not assemble autia1716/autib1716 for pre
-        // armv8.3a targets.
-        if (cieInfo.addressesSignedWithBKey)
-          asm("hint 0xe" : "+r"(x17) : "r"(x16)); // autib1716
-        else
-          asm("hint 0xc" : "+r"(x17) : "r"(x16)); // autia1716
-        returnAddress = x17;
+    register unsigned long long x17 __asm("x17") = returnAddress;
+    register unsigned long long x16 __asm("x16") = cfa;
+
+    // These are the autia1716/autib1716 instructions. The hint instructions
+    // are used here as gcc does not assemble autia1716/autib1716 for pre
+    // armv8.3a targets.
+    if (cieInfo.addressesSignedWithBKey)
+      asm("hint 0xe" : "+r"(x17) : "r"(x16)); // autib1716
+    else
+      asm("hint 0xc" : "+r"(x17) : "r"(x16)); // autia1716
+    returnAddress = x17;
 #endif
-      }
+  }
 #endif
 
 #if defined(_LIBUNWIND_IS_NATIVE_ONLY) && defined(_LIBUNWIND_TARGET_ARM) &&    \
     defined(__ARM_FEATURE_PAUTH)
-      if ((R::getArch() == REGISTERS_ARM) &&
-          prolog.savedRegisters[UNW_ARM_RA_AUTH_CODE].value) {
-        pint_t pac =
-            getSavedRegister(addressSpace, registers, cfa,
-                             prolog.savedRegisters[UNW_ARM_RA_AUTH_CODE]);
-        __asm__ __volatile__("autg %0, %1, %2"
-                             :
-                             : "r"(pac), "r"(returnAddress), "r"(cfa)
-                             :);
-      }
+  if ((R::getArch() == REGISTERS_ARM) &&
+      prolog.savedRegisters[UNW_ARM_RA_AUTH_CODE].value) {
+    pint_t pac =
+        getSavedRegister(addressSpace, registers, cfa,
+                         prolog.savedRegisters[UNW_ARM_RA_AUTH_CODE]);
+    __asm__ __volatile__("autg %0, %1, %2"
+                         :
+                         : "r"(pac), "r"(returnAddress), "r"(cfa)
+                         :);
+  }
 #endif
 
 #if defined(_LIBUNWIND_TARGET_SPARC)
-      if (R::getArch() == REGISTERS_SPARC) {
-        // Skip call site instruction and delay slot
-        returnAddress += 8;
-        // Skip unimp instruction if function returns a struct
-        if ((addressSpace.get32(returnAddress) & 0xC1C00000) == 0)
-          returnAddress += 4;
-      }
+  if (R::getArch() == REGISTERS_SPARC) {
+    // Skip call site instruction and delay slot
+    returnAddress += 8;
+    // Skip unimp instruction if function returns a struct
+    if ((addressSpace.get32(returnAddress) & 0xC1C00000) == 0)
+      returnAddress += 4;
+  }
 #endif
 
 #if defined(_LIBUNWIND_TARGET_SPARC64)
-      // Skip call site instruction and delay slot.
-      if (R::getArch() == REGISTERS_SPARC64)
-        returnAddress += 8;
+  // Skip call site instruction and delay slot.
+  if (R::getArch() == REGISTERS_SPARC64)
+    returnAddress += 8;
 #endif
 
 #if defined(_LIBUNWIND_TARGET_PPC64)
@@ -311,37 +339,34 @@ int DwarfInstructions<A, R>::stepWithDwarf(A &addressSpace, pint_t pc,
 #define PPC64_ELFV1_R2_OFFSET 40
 #define PPC64_ELFV2_R2_LOAD_INST_ENCODING 0xe8410018u // ld r2,24(r1)
 #define PPC64_ELFV2_R2_OFFSET 24
-      // If the instruction at return address is a TOC (r2) restore,
-      // then r2 was saved and needs to be restored.
-      // ELFv2 ABI specifies that the TOC Pointer must be saved at SP + 24,
-      // while in ELFv1 ABI it is saved at SP + 40.
-      if (R::getArch() == REGISTERS_PPC64 && returnAddress != 0) {
-        pint_t sp = newRegisters.getRegister(UNW_REG_SP);
-        pint_t r2 = 0;
-        switch (addressSpace.get32(returnAddress)) {
-        case PPC64_ELFV1_R2_LOAD_INST_ENCODING:
-          r2 = addressSpace.get64(sp + PPC64_ELFV1_R2_OFFSET);
-          break;
-        case PPC64_ELFV2_R2_LOAD_INST_ENCODING:
-          r2 = addressSpace.get64(sp + PPC64_ELFV2_R2_OFFSET);
-          break;
-        }
-        if (r2)
-          newRegisters.setRegister(UNW_PPC64_R2, r2);
-      }
+  // If the instruction at return address is a TOC (r2) restore,
+  // then r2 was saved and needs to be restored.
+  // ELFv2 ABI specifies that the TOC Pointer must be saved at SP + 24,
+  // while in ELFv1 ABI it is saved at SP + 40.
+  if (R::getArch() == REGISTERS_PPC64 && returnAddress != 0) {
+    pint_t sp = newRegisters.getRegister(UNW_REG_SP);
+    pint_t r2 = 0;
+    switch (addressSpace.get32(returnAddress)) {
+    case PPC64_ELFV1_R2_LOAD_INST_ENCODING:
+      r2 = addressSpace.get64(sp + PPC64_ELFV1_R2_OFFSET);
+      break;
+    case PPC64_ELFV2_R2_LOAD_INST_ENCODING:
+      r2 = addressSpace.get64(sp + PPC64_ELFV2_R2_OFFSET);
+      break;
+    }
+    if (r2)
+      newRegisters.setRegister(UNW_PPC64_R2, r2);
+  }
 #endif
 
-      // Return address is address after call site instruction, so setting IP to
-      // that does simulates a return.
-      newRegisters.setIP(returnAddress);
+  // Return address is address after call site instruction, so setting IP to
+  // that does simulates a return.
+  newRegisters.setIP(returnAddress);
 
-      // Simulate the step by replacing the register set with the new ones.
-      registers = newRegisters;
+  // Simulate the step by replacing the register set with the new ones.
+  registers = newRegisters;
 
-      return UNW_STEP_SUCCESS;
-    }
-  }
-  return UNW_EBADFRAME;
+  return UNW_STEP_SUCCESS;
 }
 
 template <typename A, typename R>
@@ -0,0 +1,131 @@
+//===-DwarfPrologCache.hpp ------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Cache decoded DWARF unwind plans so that repeatedly unwinding through the
+// same hot frames does not re-run the FDE/CFI instructions on every step.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef __DWARFPROLOG_CACHE_HPP__
+#define __DWARFPROLOG_CACHE_HPP__
+
+#include <stdint.h>
+
+#include "DwarfParser.hpp"
+#include "RWMutex.hpp"
+#include "config.h"
+
+namespace libunwind {
+
+/// Per-process cache of decoded unwind plans, keyed by exact PC. Unlike
+/// DwarfFDECache, which only remembers where an FDE lives, this caches the
+/// result of running the CFI instructions (the PrologInfo row and the CIE
+/// fields the stepper consumes), so a cache hit skips DWARF decoding
+/// entirely. Profilers that unwind the same stacks over and over hit the
+/// same return addresses, so exact-PC keying has a high hit rate.
+///
+/// Readers are lock-free: each entry carries a sequence number that is odd
+/// while the entry is being written (a seqlock). A reader that races with a
+/// writer, or that interrupted the writer from a signal handler on the same
+/// thread, simply misses and falls back to decoding the FDE. Writers are
+/// serialized by a mutex that readers never take, so lookups are safe from
+/// signal handlers.
+template <typename A>
+class _LIBUNWIND_HIDDEN DwarfPrologCache {
+  typedef typename A::pint_t pint_t;
+  typedef typename CFI_Parser<A>::PrologInfo PrologInfo;
+  typedef typename CFI_Parser<A>::CIE_Info CIE_Info;
+
+public:
+  static bool find(pint_t pc, pint_t fdeStart, PrologInfo *prolog,
+                   CIE_Info *cieInfo);
+  static void add(pint_t pc, pint_t fdeStart, const PrologInfo &prolog,
+                  const CIE_Info &cieInfo);
+  static void removeAll();
+
+private:
+  struct entry {
+    uint32_t sequence; // Odd while the entry is being (re)written.
+    pint_t pc;
+    pint_t fdeStart;
+    PrologInfo prolog;
+    CIE_Info cieInfo;
+  };
+
+  static size_t hash(pint_t pc) {
+    // Drop the low bits; return addresses of adjacent call sites share them.
+    return (size_t)(pc >> 2) % kCacheEntryCount;
+  }
+
+  // These fields are all static to avoid needing an initializer.
+  // There is only one instance of this class per process.
+  static const size_t kCacheEntryCount = 64;
+  static RWMutex _writeLock;
+  static entry _entries[kCacheEntryCount];
+};
+
+template <typename A>
+RWMutex DwarfPrologCache<A>::_writeLock;
+
+template <typename A>
+typename DwarfPrologCache<A>::entry
+    DwarfPrologCache<A>::_entries[kCacheEntryCount];
+
+template <typename A>
+bool DwarfPrologCache<A>::find(pint_t pc, pint_t fdeStart, PrologInfo *prolog,
+                               CIE_Info *cieInfo) {
+  entry &e = _entries[hash(pc)];
+  uint32_t sequence = __atomic_load_n(&e.sequence, __ATOMIC_RELAXED);
+  if (sequence & 1)
+    return false;
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  if (e.pc != pc || e.fdeStart != fdeStart)
+    return false;
+  // A torn read here is fine: the trailing sequence check rejects the copy
+  // if a writer touched the entry while it was being copied out.
+  *prolog = e.prolog;
+  *cieInfo = e.cieInfo;
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  return __atomic_load_n(&e.sequence, __ATOMIC_RELAXED) == sequence;
+}
+
+template <typename A>
+void DwarfPrologCache<A>::add(pint_t pc, pint_t fdeStart,
+                              const PrologInfo &prolog,
+                              const CIE_Info &cieInfo) {
+  entry &e = _entries[hash(pc)];
+  _LIBUNWIND_LOG_IF_FALSE(_writeLock.lock());
+  // The full fence keeps the payload stores from being hoisted above the
+  // odd sequence store that marks the entry as in flux.
+  __atomic_store_n(&e.sequence, e.sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  e.pc = pc;
+  e.fdeStart = fdeStart;
+  e.prolog = prolog;
+  e.cieInfo = cieInfo;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&e.sequence, e.sequence + 1, __ATOMIC_RELAXED);
+  _LIBUNWIND_LOG_IF_FALSE(_writeLock.unlock());
+}
+
+template <typename A>
+void DwarfPrologCache<A>::removeAll() {
+  _LIBUNWIND_LOG_IF_FALSE(_writeLock.lock());
+  for (size_t i = 0; i < kCacheEntryCount; ++i) {
+    entry &e = _entries[i];
+    __atomic_store_n(&e.sequence, e.sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    e.pc = 0;
+    e.fdeStart = 0;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&e.sequence, e.sequence + 1, __ATOMIC_RELAXED);
+  }
+  _LIBUNWIND_LOG_IF_FALSE(_writeLock.unlock());
+}
+
+} // namespace libunwind
+
+#endif // __DWARFPROLOG_CACHE_HPP__
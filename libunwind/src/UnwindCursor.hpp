@@ -42,6 +42,9 @@
 #include "CompactUnwinder.hpp"
 #include "config.h"
 #include "DwarfInstructions.hpp"
+#if defined(_LIBUNWIND_USE_DWARF_PROLOG_CACHE)
+#include "DwarfPrologCache.hpp"
+#endif
 #include "EHHeaderParser.hpp"
 #include "libunwind.h"
 #include "libunwind_ext.h"
@@ -197,6 +200,11 @@ void DwarfFDECache<A>::add(pint_t mh, pint_t ip_start, pint_t ip_end,
 
 template <typename A>
 void DwarfFDECache<A>::removeAllIn(pint_t mh) {
+#if defined(_LIBUNWIND_USE_DWARF_PROLOG_CACHE)
+  // Unwind plans decoded from the unloaded image are now stale, and the
+  // prolog cache is not segmented by image, so drop all of them.
+  DwarfPrologCache<A>::removeAll();
+#endif
   _LIBUNWIND_LOG_IF_FALSE(_lock.lock());
   entry *d = _buffer;
   for (const entry *s = _buffer; s < _bufferUsed; ++s) {
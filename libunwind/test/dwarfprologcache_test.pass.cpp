@@ -0,0 +1,76 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// The other libunwind tests don't test internal interfaces, so the include path
+// is a little wonky.
+#include "../src/config.h"
+
+// Only run this test under supported configurations.
+
+#if defined(_LIBUNWIND_SUPPORT_DWARF_UNWIND) &&                                \
+    defined(_LIBUNWIND_USE_DWARF_PROLOG_CACHE)
+
+#include <stdlib.h>
+
+// This file defines the address space and parser types needed here, and
+// includes DwarfPrologCache.hpp as well.
+#include "../src/UnwindCursor.hpp"
+
+#define kPC ((LocalAddressSpace::pint_t)0xFFF010)
+#define kFDE ((LocalAddressSpace::pint_t)0xAAA000)
+
+using namespace libunwind;
+
+typedef DwarfPrologCache<LocalAddressSpace> Cache;
+typedef CFI_Parser<LocalAddressSpace> Parser;
+
+int main(int, char**) {
+  Parser::PrologInfo Prolog;
+  Parser::CIE_Info CIE;
+  memset(&CIE, 0, sizeof(CIE));
+  Prolog.cfaRegister = 7;
+  Prolog.cfaRegisterOffset = 16;
+  CIE.returnAddressRegister = 16;
+
+  Parser::PrologInfo FoundProlog;
+  Parser::CIE_Info FoundCIE;
+  // Nothing present, shouldn't find.
+  if (Cache::find(kPC, kFDE, &FoundProlog, &FoundCIE))
+    abort();
+  Cache::add(kPC, kFDE, Prolog, CIE);
+  // Just added. Should find, and the copy should round-trip.
+  if (!Cache::find(kPC, kFDE, &FoundProlog, &FoundCIE))
+    abort();
+  if (FoundProlog.cfaRegister != 7 || FoundProlog.cfaRegisterOffset != 16 ||
+      FoundCIE.returnAddressRegister != 16)
+    abort();
+  // Same PC but a different FDE is a different plan. Shouldn't find.
+  if (Cache::find(kPC, kFDE + 8, &FoundProlog, &FoundCIE))
+    abort();
+  // A PC that was never added shouldn't be found, even one that hashes to
+  // the occupied slot.
+  if (Cache::find(kPC + 1024, kFDE, &FoundProlog, &FoundCIE))
+    abort();
+  // Replacing the entry for a PC should serve the new plan.
+  Prolog.cfaRegisterOffset = 32;
+  Cache::add(kPC, kFDE, Prolog, CIE);
+  if (!Cache::find(kPC, kFDE, &FoundProlog, &FoundCIE))
+    abort();
+  if (FoundProlog.cfaRegisterOffset != 32)
+    abort();
+  // Flushed entries shouldn't be found.
+  Cache::removeAll();
+  if (Cache::find(kPC, kFDE, &FoundProlog, &FoundCIE))
+    abort();
+  return 0;
+}
+
+#else
+int main(int, char**) { return 0;}
+#endif
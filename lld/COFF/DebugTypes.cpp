@@ -25,9 +25,12 @@
 #include "llvm/DebugInfo/PDB/Native/PDBFile.h"
 #include "llvm/DebugInfo/PDB/Native/TpiHashing.h"
 #include "llvm/DebugInfo/PDB/Native/TpiStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/xxhash.h"
 
 using namespace llvm;
 using namespace llvm::codeview;
@@ -545,15 +548,72 @@ Error UsePrecompSource::mergeDebugT(TypeMerger *m) {
 // Parellel GHash type merging implementation.
 //===----------------------------------------------------------------------===//
 
+// /lldghashcache support. Hashing .debug$T for objects that were built
+// without .debug$H is pure recomputation: the hashes only depend on the type
+// record bytes. Persist them in a sidecar directory keyed by the content hash
+// of the raw .debug$T payload, so an unchanged object never gets re-hashed by
+// a later link. A changed object simply misses the cache; stale entries are
+// never matched and are left for the user to prune.
+static std::string getGHashCachePath(ArrayRef<uint8_t> debugTypes) {
+  SmallString<128> path(config->ghashCache);
+  sys::path::append(path, "ghash-" + utohexstr(xxHash64(debugTypes)) + ".bin");
+  return std::string(path.str());
+}
+
+static bool loadCachedGHashes(ArrayRef<uint8_t> debugTypes,
+                              std::vector<GloballyHashedType> &hashVec) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> buf = MemoryBuffer::getFile(
+      getGHashCachePath(debugTypes), /*IsText=*/false,
+      /*RequiresNullTerminator=*/false);
+  if (!buf)
+    return false;
+  StringRef data = (*buf)->getBuffer();
+  if (data.empty() || data.size() % sizeof(GloballyHashedType) != 0)
+    return false;
+  hashVec.resize(data.size() / sizeof(GloballyHashedType));
+  memcpy(hashVec.data(), data.data(), data.size());
+  return true;
+}
+
+static void saveCachedGHashes(ArrayRef<uint8_t> debugTypes,
+                              ArrayRef<GloballyHashedType> hashVec) {
+  if (hashVec.empty())
+    return;
+  std::string path = getGHashCachePath(debugTypes);
+  if (sys::fs::exists(path))
+    return;
+  // Several sources may be hashing in parallel, and two objects can share
+  // identical type streams. Write to a unique temporary and rename it into
+  // place so readers never observe a partial entry.
+  sys::fs::create_directories(config->ghashCache);
+  int fd;
+  SmallString<128> tmpPath;
+  if (sys::fs::createUniqueFile(path + ".tmp%%%%%%", fd, tmpPath))
+    return;
+  raw_fd_ostream(fd, /*shouldClose=*/true)
+      .write(reinterpret_cast<const char *>(hashVec.data()),
+             hashVec.size() * sizeof(GloballyHashedType));
+  if (sys::fs::rename(tmpPath, path))
+    sys::fs::remove(tmpPath);
+}
+
 void TpiSource::loadGHashes() {
   if (Optional<ArrayRef<uint8_t>> debugH = getDebugH(file)) {
     ghashes = getHashesFromDebugH(*debugH);
     ownedGHashes = false;
   } else {
-    CVTypeArray types;
-    BinaryStreamReader reader(file->debugTypes, support::little);
-    cantFail(reader.readArray(types, reader.getLength()));
-    assignGHashesFromVector(GloballyHashedType::hashTypes(types));
+    std::vector<GloballyHashedType> hashVec;
+    bool cached = !config->ghashCache.empty() &&
+                  loadCachedGHashes(file->debugTypes, hashVec);
+    if (!cached) {
+      CVTypeArray types;
+      BinaryStreamReader reader(file->debugTypes, support::little);
+      cantFail(reader.readArray(types, reader.getLength()));
+      hashVec = GloballyHashedType::hashTypes(types);
+      if (!config->ghashCache.empty())
+        saveCachedGHashes(file->debugTypes, hashVec);
+    }
+    assignGHashesFromVector(std::move(hashVec));
   }
 
   fillIsItemIndexFromDebugT();
@@ -1793,6 +1793,10 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   if (args.hasArg(OPT_kill_at))
     config->killAt = true;
 
+  // Handle /lldghashcache
+  if (auto *arg = args.getLastArg(OPT_lldghashcache))
+    config->ghashCache = arg->getValue();
+
   // Handle /lldltocache
   if (auto *arg = args.getLastArg(OPT_lldltocache))
     config->ltoCache = arg->getValue();
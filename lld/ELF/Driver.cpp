@@ -51,6 +51,7 @@
 #include "llvm/LTO/LTO.h"
 #include "llvm/Object/Archive.h"
 #include "llvm/Remarks/HotnessThresholdParser.h"
+#include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/FileSystem.h"
@@ -1162,6 +1163,7 @@ static void readConfigs(opt::InputArgList &args) {
   config->printSymbolOrder =
       args.getLastArgValue(OPT_print_symbol_order);
   config->relax = args.hasFlag(OPT_relax, OPT_no_relax, true);
+  config->relinkCache = args.getLastArgValue(OPT_relink_cache);
   config->rpath = getRpath(args);
   config->relocatable = args.hasArg(OPT_relocatable);
 
@@ -2436,6 +2438,64 @@ static void postParseObjectFile(ELFFileBase *file) {
 
 // Do actual linking. Note that when this function is called,
 // all linker scripts have already been parsed.
+// Computes a digest of everything that determines the output of the link: the
+// linker version, the canonicalized command line, and the contents of every
+// file read so far. Must be called after all input files have been parsed so
+// that archive members and dependent libraries are included.
+static std::string computeRelinkDigest(opt::InputArgList &args) {
+  // A few files are read only later in the link. Read them now so that their
+  // contents participate in the digest, like --reproduce does.
+  if (auto *arg = args.getLastArg(OPT_call_graph_ordering_file))
+    readFile(arg->getValue());
+  if (!config->ltoSampleProfile.empty())
+    readFile(config->ltoSampleProfile);
+
+  BLAKE3 hasher;
+  auto addString = [&](StringRef s) {
+    // Prefix each string with its size so that concatenations can't collide.
+    uint64_t size = s.size();
+    hasher.update(ArrayRef<uint8_t>(reinterpret_cast<uint8_t *>(&size),
+                                    sizeof(size)));
+    hasher.update(s);
+  };
+  addString(getLLDVersion());
+  addString(createResponseFile(args));
+  for (const std::unique_ptr<MemoryBuffer> &mb : ctx->memoryBuffers) {
+    addString(mb->getBufferIdentifier());
+    addString(mb->getBuffer());
+  }
+  return toHex(hasher.final());
+}
+
+// Returns true if the cache file written by a previous successful link holds
+// the same digest, meaning the output on disk is already up to date.
+static bool relinkCacheIsValid(StringRef digest) {
+  // A random build id makes otherwise identical links produce different
+  // outputs, so the previous output can't be reused.
+  if (config->buildId == BuildIdKind::Uuid)
+    return false;
+  auto mbOrErr = MemoryBuffer::getFile(config->relinkCache);
+  if (!mbOrErr || (*mbOrErr)->getBuffer().trim() != digest)
+    return false;
+  if (!fs::exists(config->outputFile))
+    return false;
+  if (!config->mapFile.empty() && config->mapFile != "-" &&
+      !fs::exists(config->mapFile))
+    return false;
+  return true;
+}
+
+static void writeRelinkCache(StringRef digest) {
+  std::error_code ec;
+  raw_fd_ostream os(config->relinkCache, ec, sys::fs::OF_None);
+  if (ec) {
+    error("cannot open --relink-cache= file " + config->relinkCache + ": " +
+          ec.message());
+    return;
+  }
+  os << digest << "\n";
+}
+
 void LinkerDriver::link(opt::InputArgList &args) {
   llvm::TimeTraceScope timeScope("Link", StringRef("LinkerDriver::Link"));
   // If a --hash-style option was not given, set to a default value,
@@ -2497,6 +2557,19 @@ void LinkerDriver::link(opt::InputArgList &args) {
     }
   }
 
+  // Now that every input file has been read, we can tell whether anything has
+  // changed since the previous successful link. If not, the output on disk is
+  // already correct and the rest of the link can be skipped.
+  std::string relinkDigest;
+  if (!config->relinkCache.empty() && !errorCount()) {
+    llvm::TimeTraceScope timeScope("Relink cache");
+    relinkDigest = computeRelinkDigest(args);
+    if (relinkCacheIsValid(relinkDigest)) {
+      log("--relink-cache: inputs unchanged, keeping " + config->outputFile);
+      return;
+    }
+  }
+
   // Now that we have every file, we can decide if we will need a
   // dynamic symbol table.
   // We need one if we were asked to export dynamic symbols or if we are
@@ -2819,4 +2892,9 @@ void LinkerDriver::link(opt::InputArgList &args) {
 
   // Write the result to the file.
   invokeELFT(writeResult);
+
+  // Remember what went into this link so that an identical relink can be
+  // skipped next time.
+  if (!config->relinkCache.empty() && !errorCount())
+    writeRelinkCache(relinkDigest);
 }
@@ -47,7 +47,9 @@
 // 3. If we split an equivalence class in step 2, two relocations
 //    previously target the same equivalence class may now target
 //    different equivalence classes. Therefore, we repeat step 2 until a
-//    convergence is obtained.
+//    convergence is obtained. A repetition only needs to revisit classes
+//    whose relocation targets changed class in the previous repetition;
+//    classes that have converged are carried over unchanged.
 //
 // 4. For each equivalence class C, pick an arbitrary section in C, and
 //    merge all the other sections in C with it.
@@ -80,6 +82,7 @@
 #include "SymbolTable.h"
 #include "Symbols.h"
 #include "SyntheticSections.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/BinaryFormat/ELF.h"
 #include "llvm/Object/ELF.h"
 #include "llvm/Support/Parallel.h"
@@ -87,6 +90,7 @@
 #include "llvm/Support/xxhash.h"
 #include <algorithm>
 #include <atomic>
+#include <memory>
 
 using namespace llvm;
 using namespace llvm::ELF;
@@ -100,7 +104,12 @@ public:
   void run();
 
 private:
-  void segregate(size_t begin, size_t end, uint32_t eqClassBase, bool constant);
+  void segregate(size_t begin, size_t end, bool constant);
+
+  template <class RelTy>
+  void cacheRelocTargets(InputSection *isec, ArrayRef<RelTy> rels);
+
+  bool isClassDirty(size_t begin, size_t end);
 
   template <class RelTy>
   bool constantEq(const InputSection *a, ArrayRef<RelTy> relsA,
@@ -122,6 +131,25 @@ private:
 
   SmallVector<InputSection *, 0> sections;
 
+  // Base offset for the equivalence class IDs assigned by segregate(), so
+  // that they do not overlap the unique IDs assigned in run().
+  uint32_t eqClassBase = 0;
+
+  // The defined InputSection relocation targets of each section in
+  // `sections`, resolved once in run(). Relocation hash propagation and the
+  // dirty class tracking below only need the targets, and re-resolving every
+  // relocation symbol on each round is a significant cost on large inputs.
+  llvm::DenseMap<const InputSection *, SmallVector<InputSection *, 0>>
+      relocTargets;
+
+  // One flag per equivalence class ID (offset by eqClassBase), recording
+  // whether the class was created or split during the previous (`dirty`) or
+  // the current (`nextDirty`) refinement round. A class none of whose
+  // relocation targets changed class in the previous round cannot be split by
+  // another round of segregation, so it is carried over unchanged.
+  std::unique_ptr<std::atomic<bool>[]> dirty;
+  std::unique_ptr<std::atomic<bool>[]> nextDirty;
+
   // We repeat the main loop while `Repeat` is true.
   std::atomic<bool> repeat;
 
@@ -195,8 +223,7 @@ static bool isEligible(InputSection *s) {
 
 // Split an equivalence class into smaller classes.
 template <class ELFT>
-void ICF<ELFT>::segregate(size_t begin, size_t end, uint32_t eqClassBase,
-                          bool constant) {
+void ICF<ELFT>::segregate(size_t begin, size_t end, bool constant) {
   // This loop rearranges sections in [Begin, End) so that all sections
   // that are equal in terms of equals{Constant,Variable} are contiguous
   // in [Begin, End).
@@ -224,14 +251,53 @@ void ICF<ELFT>::segregate(size_t begin, size_t end, uint32_t eqClassBase,
     for (size_t i = begin; i < mid; ++i)
       sections[i]->eqClass[next] = eqClassBase + mid;
 
-    // If we created a group, we need to iterate the main loop again.
-    if (mid != end)
+    // If we created a group, we need to iterate the main loop again. Mark
+    // both the new group and the remainder dirty so that classes targeting
+    // them are revisited in the next round.
+    if (mid != end) {
       repeat = true;
+      if (nextDirty) {
+        nextDirty[mid].store(true, std::memory_order_relaxed);
+        nextDirty[end].store(true, std::memory_order_relaxed);
+      }
+    }
 
     begin = mid;
   }
 }
 
+// Resolve and cache the defined InputSection relocation targets of Isec.
+template <class ELFT>
+template <class RelTy>
+void ICF<ELFT>::cacheRelocTargets(InputSection *isec, ArrayRef<RelTy> rels) {
+  SmallVector<InputSection *, 0> &targets = relocTargets.find(isec)->second;
+  for (const RelTy &rel : rels) {
+    Symbol &s = isec->template getFile<ELFT>()->getRelocTargetSym(rel);
+    if (auto *d = dyn_cast<Defined>(&s))
+      if (auto *relSec = dyn_cast_or_null<InputSection>(d->section))
+        targets.push_back(relSec);
+  }
+}
+
+// Returns true if another round of segregation may split the equivalence
+// class [Begin, End), i.e. if the class itself or the class of any of its
+// relocation targets changed during the previous round.
+template <class ELFT> bool ICF<ELFT>::isClassDirty(size_t begin, size_t end) {
+  if (dirty[sections[begin]->eqClass[current] - eqClassBase].load(
+          std::memory_order_relaxed))
+    return true;
+  for (size_t i = begin; i < end; ++i)
+    for (InputSection *target : relocTargets.find(sections[i])->second) {
+      uint32_t id = target->eqClass[current];
+      // IDs not above eqClassBase identify ineligible sections and never
+      // change.
+      if (id > eqClassBase &&
+          dirty[id - eqClassBase].load(std::memory_order_relaxed))
+        return true;
+    }
+  return false;
+}
+
 // Compare two lists of relocations.
 template <class ELFT>
 template <class RelTy>
@@ -433,22 +499,6 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   ++cnt;
 }
 
-// Combine the hashes of the sections referenced by the given section into its
-// hash.
-template <class ELFT, class RelTy>
-static void combineRelocHashes(unsigned cnt, InputSection *isec,
-                               ArrayRef<RelTy> rels) {
-  uint32_t hash = isec->eqClass[cnt % 2];
-  for (RelTy rel : rels) {
-    Symbol &s = isec->template getFile<ELFT>()->getRelocTargetSym(rel);
-    if (auto *d = dyn_cast<Defined>(&s))
-      if (auto *relSec = dyn_cast_or_null<InputSection>(d->section))
-        hash += relSec->eqClass[cnt % 2];
-  }
-  // Set MSB to 1 to avoid collisions with unique IDs.
-  isec->eqClass[(cnt + 1) % 2] = hash | (1U << 31);
-}
-
 static void print(const Twine &s) {
   if (config->printIcfSections)
     message(s);
@@ -489,6 +539,20 @@ template <class ELFT> void ICF<ELFT>::run() {
     }
   }
 
+  // Resolve the defined InputSection relocation targets of each candidate
+  // once up front. The keys are all inserted before the parallel fill so that
+  // each task only mutates its own pre-allocated value.
+  relocTargets.reserve(sections.size());
+  for (InputSection *s : sections)
+    relocTargets.try_emplace(s);
+  parallelForEach(sections, [&](InputSection *s) {
+    const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+    if (rels.areRelocsRel())
+      cacheRelocTargets(s, rels.rels);
+    else
+      cacheRelocTargets(s, rels.relas);
+  });
+
   // Initially, we use hash values to partition sections.
   parallelForEach(sections, [&](InputSection *s) {
     // Set MSB to 1 to avoid collisions with unique IDs.
@@ -500,11 +564,11 @@ template <class ELFT> void ICF<ELFT>::run() {
   // a large time complexity will have less work to do.
   for (unsigned cnt = 0; cnt != 2; ++cnt) {
     parallelForEach(sections, [&](InputSection *s) {
-      const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
-      if (rels.areRelocsRel())
-        combineRelocHashes<ELFT>(cnt, s, rels.rels);
-      else
-        combineRelocHashes<ELFT>(cnt, s, rels.relas);
+      uint32_t hash = s->eqClass[cnt % 2];
+      for (InputSection *target : relocTargets.find(s)->second)
+        hash += target->eqClass[cnt % 2];
+      // Set MSB to 1 to avoid collisions with unique IDs.
+      s->eqClass[(cnt + 1) % 2] = hash | (1U << 31);
     });
   }
 
@@ -517,17 +581,34 @@ template <class ELFT> void ICF<ELFT>::run() {
   // Compare static contents and assign unique equivalence class IDs for each
   // static content. Use a base offset for these IDs to ensure no overlap with
   // the unique IDs already assigned.
-  uint32_t eqClassBase = ++uniqueId;
-  forEachClass([&](size_t begin, size_t end) {
-    segregate(begin, end, eqClassBase, true);
-  });
+  eqClassBase = ++uniqueId;
+  forEachClass([&](size_t begin, size_t end) { segregate(begin, end, true); });
+
+  // Split groups by comparing relocations until convergence is obtained. Only
+  // classes whose relocation targets changed class in the previous round can
+  // be split further; the rest are carried over unchanged, so late rounds
+  // touch little more than the classes that are still being refined.
+  size_t numClassIds = sections.size() + 1;
+  dirty = std::make_unique<std::atomic<bool>[]>(numClassIds);
+  nextDirty = std::make_unique<std::atomic<bool>[]>(numClassIds);
+  // All classes were just formed by the constant segregation and must be
+  // examined at least once.
+  for (size_t i = 0; i != numClassIds; ++i)
+    dirty[i].store(true, std::memory_order_relaxed);
 
-  // Split groups by comparing relocations until convergence is obtained.
   do {
     repeat = false;
     forEachClass([&](size_t begin, size_t end) {
-      segregate(begin, end, eqClassBase, false);
+      if (end - begin == 1 || !isClassDirty(begin, end)) {
+        for (size_t i = begin; i < end; ++i)
+          sections[i]->eqClass[next] = sections[i]->eqClass[current];
+        return;
+      }
+      segregate(begin, end, false);
     });
+    std::swap(dirty, nextDirty);
+    for (size_t i = 0; i != numClassIds; ++i)
+      nextDirty[i].store(false, std::memory_order_relaxed);
   } while (repeat);
 
   log("ICF needed " + Twine(cnt) + " iterations");
@@ -205,6 +205,12 @@ Optional<MemoryBufferRef> elf::readFile(StringRef path) {
     return None;
   }
 
+  // Hint the kernel to start readahead on mmapped inputs now. Symbol
+  // resolution and section parsing will touch the whole file shortly, and on
+  // a cold cache the readahead overlaps with parsing the files opened before
+  // this one instead of stalling on major faults.
+  (*mbOrErr)->willNeedIfMmap();
+
   MemoryBufferRef mbref = (*mbOrErr)->getMemBufferRef();
   ctx->memoryBuffers.push_back(std::move(*mbOrErr)); // take MB ownership
 
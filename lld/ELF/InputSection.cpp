@@ -24,6 +24,10 @@
 #include <mutex>
 #include <vector>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace llvm;
 using namespace llvm::ELF;
 using namespace llvm::object;
@@ -1365,12 +1369,41 @@ void MergeInputSection::splitStrings(StringRef s, size_t entSize) {
   if (!std::all_of(end - entSize, end, [](char c) { return c == 0; }))
     fatal(toString(this) + ": string is not null terminated");
   if (entSize == 1) {
+#ifdef __SSE2__
+    // Optimize the common case: scan for terminators 16 bytes at a time and
+    // carve out a piece at each one. This touches every byte exactly once,
+    // unlike the strlen-per-string loop below, which restarts at each
+    // terminator.
+    const char *start = p;
+    const __m128i zero = _mm_setzero_si128();
+    for (; p + 16 <= end; p += 16) {
+      int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), zero));
+      while (mask) {
+        const char *nul = p + countTrailingZeros((unsigned)mask);
+        pieces.emplace_back(start - s.begin(),
+                            xxHash64(StringRef(start, nul - start)), live);
+        start = nul + 1;
+        mask &= mask - 1;
+      }
+    }
+    for (; p != end; ++p) {
+      if (*p == 0) {
+        pieces.emplace_back(start - s.begin(),
+                            xxHash64(StringRef(start, p - start)), live);
+        start = p + 1;
+      }
+    }
+    // The section is null-terminated, so the last piece ends at `end`.
+    assert(start == end);
+#else
     // Optimize the common case.
     do {
       size_t size = strlen(p);
       pieces.emplace_back(p - s.begin(), xxHash64(StringRef(p, size)), live);
       p += size + 1;
     } while (p != end);
+#endif
   } else {
     do {
       size_t size = findNull(StringRef(p, end - p), entSize);
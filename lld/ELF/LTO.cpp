@@ -330,6 +330,9 @@ std::vector<InputFile *> BitcodeCompiler::compile() {
                            files[task] = std::move(mb);
                          }));
 
+  uint64_t cacheHitsBefore = localCacheHits();
+  uint64_t cacheMissesBefore = localCacheMisses();
+
   if (!ctx->bitcodeFiles.empty())
     checkError(ltoObj->run(
         [&](size_t task) {
@@ -338,6 +341,10 @@ std::vector<InputFile *> BitcodeCompiler::compile() {
         },
         cache));
 
+  if (!config->thinLTOCacheDir.empty())
+    log("ThinLTO cache: " + Twine(localCacheHits() - cacheHitsBefore) +
+        " hits, " + Twine(localCacheMisses() - cacheMissesBefore) + " misses");
+
   // Emit empty index files for non-indexed files but not in single-module mode.
   if (config->thinLTOModulesToCompile.empty()) {
     for (StringRef s : thinIndices) {
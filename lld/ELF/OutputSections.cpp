@@ -336,10 +336,26 @@ template <class ELFT> void OutputSection::maybeCompress() {
       parallel::TaskGroup tg;
       writeTo<ELFT>(buf.get(), tg);
     }
-    compressed.shards = std::make_unique<SmallVector<uint8_t, 0>[]>(1);
-    compression::zstd::compress(makeArrayRef(buf.get(), size),
-                                compressed.shards[0]);
-    size = sizeof(Elf_Chdr) + compressed.shards[0].size();
+    // Split input into 1-MiB shards and compress them independently. Each
+    // shard is a complete zstd frame, and decompressors handle concatenated
+    // frames, so the compressed shards just need to be placed back to back.
+    constexpr size_t shardSize = 1 << 20;
+    auto shardsIn = split(makeArrayRef<uint8_t>(buf.get(), size), shardSize);
+    const size_t numShards = shardsIn.size();
+    auto shardsOut = std::make_unique<SmallVector<uint8_t, 0>[]>(numShards);
+    // Compress with the default level by default. If -O2 is given, spend more
+    // time for a higher compression ratio, mirroring the zlib path below.
+    const int level =
+        config->optimize >= 2 ? 9 : compression::zstd::DefaultCompression;
+    parallelFor(0, numShards, [&](size_t i) {
+      compression::zstd::compress(shardsIn[i], shardsOut[i], level);
+    });
+
+    size = sizeof(Elf_Chdr);
+    for (size_t i = 0; i != numShards; ++i)
+      size += shardsOut[i].size();
+    compressed.shards = std::move(shardsOut);
+    compressed.numShards = numShards;
     flags |= SHF_COMPRESSED;
     return;
   }
@@ -418,7 +434,15 @@ void OutputSection::writeTo(uint8_t *buf, parallel::TaskGroup &tg) {
     buf += sizeof(*chdr);
     if (config->compressDebugSections == DebugCompressionType::Zstd) {
       chdr->ch_type = ELFCOMPRESS_ZSTD;
-      memcpy(buf, compressed.shards[0].data(), compressed.shards[0].size());
+      // Compute shard offsets and copy the zstd frames back to back.
+      auto offsets = std::make_unique<size_t[]>(compressed.numShards);
+      offsets[0] = 0;
+      for (size_t i = 1; i != compressed.numShards; ++i)
+        offsets[i] = offsets[i - 1] + compressed.shards[i - 1].size();
+      parallelFor(0, compressed.numShards, [&](size_t i) {
+        memcpy(buf + offsets[i], compressed.shards[i].data(),
+               compressed.shards[i].size());
+      });
       return;
     }
     chdr->ch_type = ELFCOMPRESS_ZLIB;
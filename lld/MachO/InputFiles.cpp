@@ -67,6 +67,7 @@
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -1115,10 +1116,13 @@ template <class LP> void ObjFile::parse() {
   }
 
   // The relocations may refer to the symbols, so we parse them after we have
-  // parsed all the symbols.
-  for (size_t i = 0, n = sections.size(); i < n; ++i)
+  // parsed all the symbols. Relocations for distinct sections only mutate
+  // their own section's subsections (cross-section references are read-only
+  // lookups), so the sections can be processed in parallel.
+  parallelFor(0, sections.size(), [&](size_t i) {
     if (!sections[i]->subsections.empty())
       parseRelocations(sectionHeaders, sectionHeaders[i], *sections[i]);
+  });
 
   if (!config->ignoreOptimizationHints)
     if (auto *cmd = findCommand<linkedit_data_command>(
@@ -68,6 +68,8 @@ public:
 
   ThreadPool threadPool;
   std::unique_ptr<FileOutputBuffer> &buffer;
+  std::vector<uint64_t> chunkHashes;
+  std::vector<std::shared_future<void>> chunkHashFutures;
   uint64_t addr = 0;
   uint64_t fileOff = 0;
   MachHeaderSection *header = nullptr;
@@ -1067,36 +1069,49 @@ void Writer::writeSections() {
   for (const OutputSegment *seg : outputSegments)
     append_range(osecs, seg->getSections());
 
-  parallelForEach(osecs.begin(), osecs.end(), [&](const OutputSection *osec) {
+  // The UUID is a hash of the output (see writeUuid()). Instead of re-reading
+  // the whole file once all sections have been written, hash each section's
+  // bytes in chunks as soon as that section lands in the buffer, overlapping
+  // the hashing with the remaining writes. Alignment padding between sections
+  // is always zero and is left out of the hash.
+  unsigned chunkCount = parallel::strategy.compute_thread_count() * 10;
+  // Round-up integer division
+  size_t chunkSize = (fileOff + chunkCount - 1) / chunkCount;
+  std::vector<size_t> chunkIdx(osecs.size());
+  size_t numChunks = 0;
+  for (size_t i = 0; i < osecs.size(); ++i) {
+    chunkIdx[i] = numChunks;
+    numChunks += (osecs[i]->getFileSize() + chunkSize - 1) / chunkSize;
+  }
+  chunkHashes.resize(numChunks);
+  chunkHashFutures.resize(numChunks);
+
+  parallelFor(0, osecs.size(), [&](size_t i) {
+    const OutputSection *osec = osecs[i];
     osec->writeTo(buf + osec->fileOff);
+    ArrayRef<uint8_t> data(buf + osec->fileOff, osec->getFileSize());
+    size_t idx = chunkIdx[i];
+    for (ArrayRef<uint8_t> chunk : split(data, chunkSize)) {
+      chunkHashFutures[idx] = threadPool.async(
+          [this, chunk](size_t j) { chunkHashes[j] = xxHash64(chunk); }, idx);
+      ++idx;
+    }
   });
 }
 
-// In order to utilize multiple cores, we first split the buffer into chunks,
-// compute a hash for each chunk, and then compute a hash value of the hash
-// values.
+// In order to utilize multiple cores, writeSections() splits the output into
+// chunks and hashes each chunk as soon as it has been written; here we wait
+// for those hashes and compute a hash value of the hash values.
 void Writer::writeUuid() {
   TimeTraceScope timeScope("Computing UUID");
 
-  ArrayRef<uint8_t> data{buffer->getBufferStart(), buffer->getBufferEnd()};
-  unsigned chunkCount = parallel::strategy.compute_thread_count() * 10;
-  // Round-up integer division
-  size_t chunkSize = (data.size() + chunkCount - 1) / chunkCount;
-  std::vector<ArrayRef<uint8_t>> chunks = split(data, chunkSize);
-  // Leave one slot for filename
-  std::vector<uint64_t> hashes(chunks.size() + 1);
-  SmallVector<std::shared_future<void>> threadFutures;
-  threadFutures.reserve(chunks.size());
-  for (size_t i = 0; i < chunks.size(); ++i)
-    threadFutures.emplace_back(threadPool.async(
-        [&](size_t j) { hashes[j] = xxHash64(chunks[j]); }, i));
-  for (std::shared_future<void> &future : threadFutures)
+  for (std::shared_future<void> &future : chunkHashFutures)
     future.wait();
   // Append the output filename so that identical binaries with different names
   // don't get the same UUID.
-  hashes[chunks.size()] = xxHash64(sys::path::filename(config->finalOutput));
-  uint64_t digest = xxHash64({reinterpret_cast<uint8_t *>(hashes.data()),
-                              hashes.size() * sizeof(uint64_t)});
+  chunkHashes.push_back(xxHash64(sys::path::filename(config->finalOutput)));
+  uint64_t digest = xxHash64({reinterpret_cast<uint8_t *>(chunkHashes.data()),
+                              chunkHashes.size() * sizeof(uint64_t)});
   uuidCommand->writeUuid(digest);
 }
 
@@ -79,9 +79,11 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  // Write code section bodies. Relocations only read finalized symbol state
+  // and each function writes to a disjoint slice of the output, so the bodies
+  // can be copied and relocated in parallel.
+  parallelForEach(functions,
+                  [&](const InputChunk *chunk) { chunk->writeTo(buf); });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -183,9 +185,10 @@ void DataSection::writeTo(uint8_t *buf) {
     uint8_t *segStart = buf + segment->sectionOffset;
     memcpy(segStart, segment->header.data(), segment->header.size());
 
-    // Write segment data payload
-    for (const InputChunk *chunk : segment->inputSegments)
-      chunk->writeTo(buf);
+    // Write segment data payload. As with the code section, input segments
+    // cover disjoint ranges of the output, so write them in parallel.
+    parallelForEach(segment->inputSegments,
+                    [&](const InputChunk *chunk) { chunk->writeTo(buf); });
   }
 }
 
@@ -14,6 +14,8 @@
 
 #include "lldb/Breakpoint/BreakpointResolver.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace lldb_private {
 
@@ -59,6 +61,8 @@ public:
 
   ~BreakpointResolverName() override = default;
 
+  void ResolveBreakpoint(SearchFilter &filter) override;
+
   Searcher::CallbackReturn SearchCallback(SearchFilter &filter,
                                           SymbolContext &context,
                                           Address *addr) override;
@@ -90,6 +94,19 @@ protected:
 
   void AddNameLookup(ConstString name,
                      lldb::FunctionNameType name_type_mask);
+
+private:
+  /// Find the functions in \a module matching this resolver's names or
+  /// regular expression, pruned by the filter's compile unit restrictions and
+  /// the resolver's language.  Each module's symbol and debug info accesses
+  /// are independent, so this is safe to run for several modules at once.
+  void FindMatchingFunctions(SearchFilter &filter, Module &module,
+                             SymbolContextList &func_list);
+
+  /// Function lookups prefetched on the thread pool by ResolveBreakpoint,
+  /// keyed by module.  SearchCallback consumes these instead of searching
+  /// again while it merges locations serially.
+  llvm::DenseMap<Module *, SymbolContextList> m_prefetched_matches;
 };
 
 } // namespace lldb_private
@@ -14,6 +14,8 @@
 
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/RegularExpression.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 
 namespace lldb_private {
 
@@ -181,6 +183,51 @@ public:
     });
   }
 
+  /// Append the entries of the given maps, each of which must already be
+  /// sorted with the same comparators, and merge them so that this map ends
+  /// up sorted. Any existing contents of this map must be sorted as well.
+  /// Merging the pre-sorted runs is considerably cheaper than appending all
+  /// of the entries and sorting the result from scratch.
+  template <typename TCompare>
+  void MergeSortedMaps(llvm::ArrayRef<const UniqueCStringMap<T> *> maps,
+                       TCompare tc) {
+    Compare c;
+    auto less = [&](const Entry &lhs, const Entry &rhs) -> bool {
+      int result = c.ThreeWay(lhs.cstring, rhs.cstring);
+      if (result == 0)
+        return tc(lhs.value, rhs.value);
+      return result < 0;
+    };
+    // Append each map, remembering the boundaries of the sorted runs:
+    // [bounds[i], bounds[i+1]) is the i'th run.
+    llvm::SmallVector<size_t, 64> bounds;
+    bounds.push_back(0);
+    bounds.push_back(m_map.size());
+    size_t total_size = m_map.size();
+    for (const UniqueCStringMap<T> *map : maps)
+      total_size += map->m_map.size();
+    m_map.reserve(total_size);
+    for (const UniqueCStringMap<T> *map : maps) {
+      m_map.insert(m_map.end(), map->m_map.begin(), map->m_map.end());
+      bounds.push_back(m_map.size());
+    }
+    // Merge adjacent runs pairwise until a single sorted run remains.
+    while (bounds.size() > 2) {
+      llvm::SmallVector<size_t, 64> merged;
+      merged.push_back(bounds[0]);
+      for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+        std::inplace_merge(m_map.begin() + bounds[i],
+                           m_map.begin() + bounds[i + 1],
+                           m_map.begin() + bounds[i + 2], less);
+        merged.push_back(bounds[i + 2]);
+      }
+      // An odd number of runs leaves the last run untouched in this pass.
+      if (merged.back() != bounds.back())
+        merged.push_back(bounds.back());
+      bounds = std::move(merged);
+    }
+  }
+
   // Since we are using a vector to contain our items it will always double its
   // memory consumption as things are added to the vector, so if you intend to
   // keep a UniqueCStringMap around and have a lot of entries in the map, you
@@ -12,6 +12,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -200,6 +201,8 @@ public:
 
   bool GetEnableNotifyAboutFixIts() const;
 
+  bool GetCacheUserExpressions() const;
+
   FileSpec GetSaveJITObjectsDir() const;
 
   bool GetEnableSyntheticValue() const;
@@ -1301,6 +1304,21 @@ public:
       const EvaluateExpressionOptions &options = EvaluateExpressionOptions(),
       std::string *fixed_expression = nullptr, ValueObject *ctx_obj = nullptr);
 
+  /// Look up a compiled user expression cached by a previous evaluation. The
+  /// key encodes the expression text and the parse-relevant options; whether
+  /// the evaluation context still matches is for the caller to check via
+  /// UserExpression::MatchesContext(). Returns an empty pointer on a miss.
+  lldb::UserExpressionSP FindCachedUserExpression(llvm::StringRef key);
+
+  /// Remember a successfully evaluated user expression for later reuse.
+  void CacheUserExpression(llvm::StringRef key,
+                           lldb::UserExpressionSP user_expression_sp);
+
+  /// Drop all cached user expressions. Called whenever the process or the
+  /// loaded modules change, since the JITted code is only valid within the
+  /// process instance it was compiled for.
+  void ClearUserExpressionCache();
+
   // Look up a symbol by name and type in both the target's symbols and the
   // persistent symbols from the
   // expression parser.  The symbol_type is ignored in that case, for now we
@@ -1628,6 +1646,12 @@ protected:
   typedef std::map<lldb::LanguageType, lldb::REPLSP> REPLMap;
   REPLMap m_repl_map;
 
+  /// Compiled user expressions from earlier evaluations, keyed by expression
+  /// text and parse-relevant options. See \a FindCachedUserExpression().
+  typedef std::map<std::string, lldb::UserExpressionSP> UserExpressionCache;
+  UserExpressionCache m_user_expression_cache;
+  std::mutex m_user_expression_cache_mutex;
+
   lldb::SourceManagerUP m_source_manager_up;
 
   typedef std::map<lldb::user_id_t, StopHookSP> StopHookCollection;
@@ -10,6 +10,7 @@
 
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Core/Architecture.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/Function.h"
@@ -20,6 +21,7 @@
 #include "lldb/Utility/LLDBLog.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
+#include "llvm/Support/ThreadPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -249,18 +251,10 @@ void BreakpointResolverName::AddNameLookup(ConstString name,
 // accelerate function lookup.  At that point, we should switch the depth to
 // CompileUnit, and look in these tables.
 
-Searcher::CallbackReturn
-BreakpointResolverName::SearchCallback(SearchFilter &filter,
-                                       SymbolContext &context, Address *addr) {
+void BreakpointResolverName::FindMatchingFunctions(
+    SearchFilter &filter, Module &module, SymbolContextList &func_list) {
   Log *log = GetLog(LLDBLog::Breakpoints);
 
-  if (m_class_name) {
-    if (log)
-      log->Warning("Class/method function specification not supported yet.\n");
-    return Searcher::eCallbackReturnStop;
-  }
-
-  SymbolContextList func_list;
   bool filter_by_cu =
       (filter.GetFilterRequiredItems() & eSymbolContextCompUnit) != 0;
   bool filter_by_language = (m_language != eLanguageTypeUnknown);
@@ -271,23 +265,19 @@ BreakpointResolverName::SearchCallback(SearchFilter &filter,
 
   switch (m_match_type) {
   case Breakpoint::Exact:
-    if (context.module_sp) {
-      for (const auto &lookup : m_lookups) {
-        const size_t start_func_idx = func_list.GetSize();
-        context.module_sp->FindFunctions(lookup, CompilerDeclContext(),
-                                         function_options, func_list);
+    for (const auto &lookup : m_lookups) {
+      const size_t start_func_idx = func_list.GetSize();
+      module.FindFunctions(lookup, CompilerDeclContext(), function_options,
+                           func_list);
 
-        const size_t end_func_idx = func_list.GetSize();
+      const size_t end_func_idx = func_list.GetSize();
 
-        if (start_func_idx < end_func_idx)
-          lookup.Prune(func_list, start_func_idx);
-      }
+      if (start_func_idx < end_func_idx)
+        lookup.Prune(func_list, start_func_idx);
     }
     break;
   case Breakpoint::Regexp:
-    if (context.module_sp) {
-      context.module_sp->FindFunctions(m_regex, function_options, func_list);
-    }
+    module.FindFunctions(m_regex, function_options, func_list);
     break;
   case Breakpoint::Glob:
     if (log)
@@ -325,6 +315,65 @@ BreakpointResolverName::SearchCallback(SearchFilter &filter,
       }
     }
   }
+}
+
+void BreakpointResolverName::ResolveBreakpoint(SearchFilter &filter) {
+  // The function lookups only touch state that is per-module (the symbol
+  // table and the debug info indexes), so run them for all interesting
+  // modules on the thread pool up front.  The search below then merges the
+  // prefetched results into locations serially, which keeps the breakpoint's
+  // location list manipulation single-threaded.
+  BreakpointSP breakpoint_sp = GetBreakpoint();
+  if (breakpoint_sp && !m_class_name) {
+    std::vector<ModuleSP> modules;
+    for (const ModuleSP &module_sp :
+         breakpoint_sp->GetTarget().GetImages().Modules()) {
+      if (module_sp && filter.ModulePasses(module_sp))
+        modules.push_back(module_sp);
+    }
+
+    // A single module isn't worth the scheduling overhead.
+    if (modules.size() > 1) {
+      std::vector<SymbolContextList> func_lists(modules.size());
+      llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+      auto find_in_module = [&](size_t idx) {
+        FindMatchingFunctions(filter, *modules[idx], func_lists[idx]);
+      };
+      for (size_t idx = 0; idx < modules.size(); idx++)
+        task_group.async(find_in_module, idx);
+      task_group.wait();
+
+      for (size_t idx = 0; idx < modules.size(); idx++)
+        m_prefetched_matches[modules[idx].get()] = std::move(func_lists[idx]);
+    }
+  }
+
+  BreakpointResolver::ResolveBreakpoint(filter);
+  m_prefetched_matches.clear();
+}
+
+Searcher::CallbackReturn
+BreakpointResolverName::SearchCallback(SearchFilter &filter,
+                                       SymbolContext &context, Address *addr) {
+  Log *log = GetLog(LLDBLog::Breakpoints);
+
+  if (m_class_name) {
+    if (log)
+      log->Warning("Class/method function specification not supported yet.\n");
+    return Searcher::eCallbackReturnStop;
+  }
+
+  SymbolContextList func_list;
+  if (context.module_sp) {
+    // Use the results that ResolveBreakpoint prefetched in parallel if this
+    // module was part of that search; otherwise (e.g. when resolving against
+    // newly loaded modules) search it here.
+    auto prefetched = m_prefetched_matches.find(context.module_sp.get());
+    if (prefetched != m_prefetched_matches.end())
+      func_list = std::move(prefetched->second);
+    else
+      FindMatchingFunctions(filter, *context.module_sp, func_list);
+  }
 
   BreakpointSP breakpoint_sp = GetBreakpoint();
   Breakpoint &breakpoint = *breakpoint_sp;
@@ -246,18 +246,42 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
-  if (error.Fail()) {
-    LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
-             error.AsCString());
-    return lldb::eExpressionSetupError;
+  // When enabled, reuse the compiled code of a previous evaluation of the
+  // same expression if the context it was parsed in still matches. A cached
+  // expression records the process and frame PC it was built for, so
+  // MatchesContext() only accepts an exact repeat -- the watch window and
+  // conditional breakpoint patterns this cache is aimed at.
+  std::string expression_cache_key;
+  lldb::UserExpressionSP cached_expression_sp;
+  if (target->GetCacheUserExpressions() && !ctx_obj &&
+      !options.GetREPLEnabled() && !options.GetGenerateDebugInfo() &&
+      execution_policy != eExecutionPolicyTopLevel) {
+    llvm::raw_string_ostream key_strm(expression_cache_key);
+    key_strm << static_cast<int>(language) << ':'
+             << static_cast<int>(desired_type) << ':' << full_prefix << '\0'
+             << expr;
+    key_strm.flush();
+    cached_expression_sp = target->FindCachedUserExpression(expression_cache_key);
+    if (cached_expression_sp && !cached_expression_sp->MatchesContext(exe_ctx))
+      cached_expression_sp.reset();
+    if (cached_expression_sp)
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Reusing cached compiled "
+                    "expression ==");
   }
 
-  LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
-           expr.str());
+  lldb::UserExpressionSP user_expression_sp = cached_expression_sp;
+  if (!user_expression_sp) {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, ctx_obj, error));
+    if (error.Fail()) {
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
+               error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
+
+    LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
+             expr.str());
+  }
 
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
@@ -272,6 +296,7 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      cached_expression_sp ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
 
@@ -405,6 +430,15 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
     }
   }
 
+  // Remember expressions that compiled and ran successfully so a later
+  // evaluation in a matching context can skip the parse and JIT entirely.
+  // Expressions that needed a fix-it are not cached: the cached object would
+  // hold the rewritten text and the caller would no longer be told about it.
+  if (!expression_cache_key.empty() && !cached_expression_sp &&
+      execution_results == lldb::eExpressionCompleted &&
+      fixed_expression->empty())
+    target->CacheUserExpression(expression_cache_key, user_expression_sp);
+
   if (options.InvokeCancelCallback(lldb::eExpressionEvaluationComplete)) {
     error.SetExpressionError(
         lldb::eExpressionInterrupted,
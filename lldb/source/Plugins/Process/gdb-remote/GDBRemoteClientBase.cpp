@@ -194,6 +194,59 @@ GDBRemoteClientBase::SendPacketAndWaitForResponse(
   return SendPacketAndWaitForResponseNoLock(payload, response);
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteClientBase::SendPacketsAndWaitForResponses(
+    llvm::ArrayRef<std::string> payloads,
+    std::vector<StringExtractorGDBRemote> &responses,
+    std::chrono::seconds interrupt_timeout) {
+  responses.clear();
+  Lock lock(*this, interrupt_timeout);
+  if (!lock) {
+    if (Log *log = GetLog(GDBRLog::Process))
+      LLDB_LOGF(log,
+                "GDBRemoteClientBase::%s failed to get mutex, not sending "
+                "%zu packets",
+                __FUNCTION__, payloads.size());
+    return PacketResult::ErrorSendFailed;
+  }
+
+  return SendPacketsAndWaitForResponsesNoLock(payloads, responses);
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteClientBase::SendPacketsAndWaitForResponsesNoLock(
+    llvm::ArrayRef<std::string> payloads,
+    std::vector<StringExtractorGDBRemote> &responses) {
+  // Write the whole burst out before reading anything back. Responses arrive
+  // in the order the requests were sent, so the sequence costs one round trip
+  // rather than one per packet.
+  for (llvm::StringRef payload : payloads) {
+    PacketResult packet_result = SendPacketNoLock(payload);
+    if (packet_result != PacketResult::Success)
+      return packet_result;
+  }
+
+  responses.resize(payloads.size());
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    StringExtractorGDBRemote &response = responses[i];
+    PacketResult packet_result = ReadPacket(response, GetPacketTimeout(), true);
+    if (packet_result != PacketResult::Success)
+      return packet_result;
+    // Unlike the single packet case we cannot resynchronize by waiting for
+    // another response: every in-flight response would be off by one from
+    // then on.
+    if (!response.ValidateResponse()) {
+      Log *log = GetLog(GDBRLog::Packets);
+      LLDB_LOGF(
+          log,
+          "error: packet with payload \"%s\" got invalid response \"%s\"",
+          payloads[i].c_str(), response.GetStringRef().data());
+      return PacketResult::ErrorReplyInvalid;
+    }
+  }
+  return PacketResult::Success;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteClientBase::SendPacketAndReceiveResponseWithOutputSupport(
     llvm::StringRef payload, StringExtractorGDBRemote &response,
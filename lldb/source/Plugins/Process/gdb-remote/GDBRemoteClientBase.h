@@ -58,6 +58,15 @@ public:
       llvm::StringRef payload, StringExtractorGDBRemote &response,
       std::chrono::seconds interrupt_timeout = std::chrono::seconds(0));
 
+  // Send all payloads in one burst before reading any response back, so a
+  // sequence of small requests costs a single round trip instead of one per
+  // packet. Responses are filled in the order the payloads were sent. On
+  // error, responses beyond the failing packet are left empty.
+  PacketResult SendPacketsAndWaitForResponses(
+      llvm::ArrayRef<std::string> payloads,
+      std::vector<StringExtractorGDBRemote> &responses,
+      std::chrono::seconds interrupt_timeout = std::chrono::seconds(0));
+
   PacketResult SendPacketAndReceiveResponseWithOutputSupport(
       llvm::StringRef payload, StringExtractorGDBRemote &response,
       std::chrono::seconds interrupt_timeout,
@@ -96,6 +105,10 @@ protected:
   SendPacketAndWaitForResponseNoLock(llvm::StringRef payload,
                                      StringExtractorGDBRemote &response);
 
+  PacketResult SendPacketsAndWaitForResponsesNoLock(
+      llvm::ArrayRef<std::string> payloads,
+      std::vector<StringExtractorGDBRemote> &responses);
+
   virtual void OnRunPacketSent(bool first);
 
 private:
@@ -3476,6 +3476,51 @@ DataBufferSP GDBRemoteCommunicationClient::ReadRegister(lldb::tid_t tid,
   return buffer_sp;
 }
 
+std::vector<DataBufferSP>
+GDBRemoteCommunicationClient::ReadRegisters(lldb::tid_t tid,
+                                            llvm::ArrayRef<uint32_t> regs) {
+  std::vector<DataBufferSP> buffers(regs.size());
+  Lock lock(*this);
+  if (!lock) {
+    if (Log *log = GetLog(GDBRLog::Process | GDBRLog::Packets))
+      LLDB_LOGF(log,
+                "GDBRemoteCommunicationClient::%s: Didn't get sequence mutex "
+                "for %zu 'p' packets.",
+                __FUNCTION__, regs.size());
+    return buffers;
+  }
+
+  const bool thread_suffix_supported = GetThreadSuffixSupported();
+  if (!thread_suffix_supported && !SetCurrentThread(tid))
+    return buffers;
+
+  std::vector<std::string> payloads;
+  payloads.reserve(regs.size());
+  for (uint32_t reg : regs) {
+    StreamString payload;
+    payload.Printf("p%x", reg);
+    if (thread_suffix_supported)
+      payload.Printf(";thread:%4.4" PRIx64 ";", tid);
+    payloads.push_back(std::string(payload.GetString()));
+  }
+
+  std::vector<StringExtractorGDBRemote> responses;
+  if (SendPacketsAndWaitForResponsesNoLock(payloads, responses) !=
+      PacketResult::Success)
+    return buffers;
+
+  for (size_t i = 0; i < regs.size(); ++i) {
+    StringExtractorGDBRemote &response = responses[i];
+    if (!response.IsNormalResponse())
+      continue;
+    WritableDataBufferSP buffer_sp(
+        new DataBufferHeap(response.GetStringRef().size() / 2, 0));
+    response.GetHexBytes(buffer_sp->GetData(), '\xcc');
+    buffers[i] = buffer_sp;
+  }
+  return buffers;
+}
+
 DataBufferSP GDBRemoteCommunicationClient::ReadAllRegisters(lldb::tid_t tid) {
   StreamString payload;
   payload.PutChar('g');
@@ -409,6 +409,15 @@ public:
       uint32_t
           reg_num); // Must be the eRegisterKindProcessPlugin register number
 
+  /// Read several registers with pipelined 'p' packets: all requests go out
+  /// in one burst and the responses are collected afterwards, so reading N
+  /// registers costs one round trip instead of N. The result vector is
+  /// parallel to \a regs; entries whose read failed are null.
+  std::vector<lldb::DataBufferSP> ReadRegisters(
+      lldb::tid_t tid,
+      llvm::ArrayRef<uint32_t>
+          regs); // Must be eRegisterKindProcessPlugin register numbers
+
   lldb::DataBufferSP ReadAllRegisters(lldb::tid_t tid);
 
   bool
@@ -253,10 +253,13 @@ bool GDBRemoteRegisterContext::ReadRegisterBytes(const RegisterInfo *reg_info) {
     }
     if (reg_info->value_regs) {
       // Process this composite register request by delegating to the
-      // constituent primordial registers.
-
-      // Index of the primordial register.
+      // constituent primordial registers. Collect the ones that still need
+      // reading and fetch them in one pipelined burst, so a composite made of
+      // N primordial registers costs one round trip rather than N.
       bool success = true;
+      std::vector<uint32_t> missing_lldb_regs;
+      std::vector<uint32_t> missing_remote_regs;
+      // Index of the primordial register.
       for (uint32_t idx = 0; success; ++idx) {
         const uint32_t prim_reg = reg_info->value_regs[idx];
         if (prim_reg == LLDB_INVALID_REGNUM)
@@ -265,12 +268,24 @@ bool GDBRemoteRegisterContext::ReadRegisterBytes(const RegisterInfo *reg_info) {
         // corresponding register info.
         const RegisterInfo *prim_reg_info =
             GetRegisterInfo(eRegisterKindLLDB, prim_reg);
-        if (prim_reg_info == nullptr)
+        if (prim_reg_info == nullptr) {
           success = false;
-        else {
-          // Read the containing register if it hasn't already been read
-          if (!GetRegisterIsValid(prim_reg))
-            success = GetPrimordialRegister(prim_reg_info, gdb_comm);
+        } else if (!GetRegisterIsValid(prim_reg)) {
+          missing_lldb_regs.push_back(prim_reg);
+          missing_remote_regs.push_back(
+              prim_reg_info->kinds[eRegisterKindProcessPlugin]);
+        }
+      }
+      if (success && !missing_remote_regs.empty()) {
+        std::vector<DataBufferSP> buffers = gdb_comm.ReadRegisters(
+            m_thread.GetProtocolID(), missing_remote_regs);
+        for (size_t idx = 0; idx < buffers.size(); ++idx) {
+          if (!buffers[idx] ||
+              !PrivateSetRegisterValue(
+                  missing_lldb_regs[idx],
+                  llvm::ArrayRef<uint8_t>(buffers[idx]->GetBytes(),
+                                          buffers[idx]->GetByteSize())))
+            success = false;
         }
       }
 
@@ -544,8 +559,12 @@ bool GDBRemoteRegisterContext::ReadAllRegisterValues(
       }
     }
 
-    // We're going to read each register
-    // individually and store them as binary data in a buffer.
+    // We're going to read each register individually and store them as binary
+    // data in a buffer. Pipeline the reads into one burst so this costs a
+    // single round trip instead of one per register.
+    InvalidateIfNeeded(false);
+    std::vector<uint32_t> missing_lldb_regs;
+    std::vector<uint32_t> missing_remote_regs;
     const RegisterInfo *reg_info;
 
     for (uint32_t i = 0; (reg_info = GetRegisterInfoAtIndex(i)) != nullptr;
@@ -553,9 +572,21 @@ bool GDBRemoteRegisterContext::ReadAllRegisterValues(
       if (reg_info
               ->value_regs) // skip registers that are slices of real registers
         continue;
-      ReadRegisterBytes(reg_info);
-      // ReadRegisterBytes saves the contents of the register in to the
-      // m_reg_data buffer
+      if (GetRegisterIsValid(reg_info->kinds[eRegisterKindLLDB]))
+        continue;
+      missing_lldb_regs.push_back(reg_info->kinds[eRegisterKindLLDB]);
+      missing_remote_regs.push_back(
+          reg_info->kinds[eRegisterKindProcessPlugin]);
+    }
+    std::vector<DataBufferSP> buffers =
+        gdb_comm.ReadRegisters(m_thread.GetProtocolID(), missing_remote_regs);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      if (buffers[i])
+        PrivateSetRegisterValue(
+            missing_lldb_regs[i],
+            llvm::ArrayRef<uint8_t>(buffers[i]->GetBytes(),
+                                    buffers[i]->GetByteSize()));
+      // The register contents end up in the m_reg_data buffer.
     }
     data_sp = std::make_shared<DataBufferHeap>(
         m_reg_data.GetDataStart(), m_reg_info_sp->GetRegisterDataByteSize());
@@ -85,6 +85,16 @@ void ManualDWARFIndex::Index() {
       units_to_index.size());
   auto parser_fn = [&](size_t cu_idx) {
     IndexUnit(*units_to_index[cu_idx], dwp_dwarf, sets[cu_idx]);
+    // Sort the per-unit maps now, while each unit still has its own task, so
+    // that the finalize step below only has to merge sorted runs instead of
+    // sorting the merged contents of all units on a single thread.
+    IndexSet &set = sets[cu_idx];
+    for (NameToDIE *map :
+         {&set.function_basenames, &set.function_fullnames,
+          &set.function_methods, &set.function_selectors,
+          &set.objc_class_selectors, &set.globals, &set.types,
+          &set.namespaces})
+      map->Sort();
     progress.Increment();
   };
 
@@ -117,9 +127,11 @@ void ManualDWARFIndex::Index() {
 
   auto finalize_fn = [this, &sets, &progress](NameToDIE(IndexSet::*index)) {
     NameToDIE &result = m_set.*index;
+    llvm::SmallVector<const NameToDIE *, 32> maps;
+    maps.reserve(sets.size());
     for (auto &set : sets)
-      result.Append(set.*index);
-    result.Finalize();
+      maps.push_back(&(set.*index));
+    result.MergeSorted(maps);
     progress.Increment();
   };
 
@@ -25,6 +25,17 @@ void NameToDIE::Finalize() {
   m_map.SizeToFit();
 }
 
+void NameToDIE::Sort() { m_map.Sort(std::less<DIERef>()); }
+
+void NameToDIE::MergeSorted(llvm::ArrayRef<const NameToDIE *> maps) {
+  llvm::SmallVector<const UniqueCStringMap<DIERef> *, 64> cstr_maps;
+  cstr_maps.reserve(maps.size());
+  for (const NameToDIE *map : maps)
+    cstr_maps.push_back(&map->m_map);
+  m_map.MergeSortedMaps(cstr_maps, std::less<DIERef>());
+  m_map.SizeToFit();
+}
+
 void NameToDIE::Insert(ConstString name, const DIERef &die_ref) {
   m_map.Append(name, die_ref);
 }
@@ -15,6 +15,7 @@
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
 #include "lldb/lldb-defines.h"
+#include "llvm/ADT/ArrayRef.h"
 
 class DWARFUnit;
 
@@ -32,6 +33,14 @@ public:
 
   void Finalize();
 
+  /// Sort the entries by name. Called on the per-unit maps so that merging
+  /// them with MergeSorted() only has to merge sorted runs.
+  void Sort();
+
+  /// Append the entries of the given maps, each of which must have been
+  /// sorted with Sort(), and merge them so that this map is finalized.
+  void MergeSorted(llvm::ArrayRef<const NameToDIE *> maps);
+
   bool Find(lldb_private::ConstString name,
             llvm::function_ref<bool(DIERef ref)> callback) const;
 
@@ -6,10 +6,12 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <atomic>
 #include <map>
 #include <set>
 
 #include "lldb/Core/DataFileCache.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/RichManglingContext.h"
 #include "lldb/Core/Section.h"
@@ -27,6 +29,7 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/DJB.h"
+#include "llvm/Support/ThreadPool.h"
 
 #ifdef LLDB_ENABLE_SWIFT
 #include "Plugins/LanguageRuntime/Swift/SwiftLanguageRuntime.h"
@@ -1362,13 +1365,38 @@ bool Symtab::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
   { // Scope for "elapsed" object below so it can measure the time to index.
     ElapsedTime elapsed(m_objfile->GetModule()->GetSymtabIndexTime());
     const uint8_t num_cstr_maps = data.GetU8(offset_ptr);
+    // Compute the extent of each C string map first. The map entries have a
+    // fixed size encoding, so each map can be located without decoding its
+    // contents. This allows the maps to be decoded in parallel below, since
+    // interning and sorting the names dominates the cache load time for
+    // large symbol tables.
+    llvm::SmallVector<std::pair<UniqueCStringMap<uint32_t> *, lldb::offset_t>,
+                      16>
+        cstr_maps;
     for (uint8_t i=0; i<num_cstr_maps; ++i) {
       uint8_t type = data.GetU8(offset_ptr);
-      UniqueCStringMap<uint32_t> &cstr_map =
-          GetNameToSymbolIndexMap((lldb::FunctionNameType)type);
-      if (!DecodeCStrMap(data, offset_ptr, strtab, cstr_map))
+      cstr_maps.emplace_back(
+          &GetNameToSymbolIndexMap((lldb::FunctionNameType)type), *offset_ptr);
+      llvm::StringRef identifier((const char *)data.GetData(offset_ptr, 4), 4);
+      if (identifier != kIdentifierCStrMap)
         return false;
+      const uint32_t count = data.GetU32(offset_ptr);
+      // Each entry is a pair of U32 values (string offset and symbol index).
+      if (count > 0 && data.GetData(offset_ptr, (size_t)count * 8) == nullptr)
+        return false;
+    }
+    std::atomic<bool> success(true);
+    llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+    for (auto &map_and_offset : cstr_maps) {
+      task_group.async([&data, &strtab, &success, &map_and_offset]() {
+        lldb::offset_t offset = map_and_offset.second;
+        if (!DecodeCStrMap(data, &offset, strtab, *map_and_offset.first))
+          success = false;
+      });
     }
+    task_group.wait();
+    if (!success)
+      return false;
     m_name_indexes_computed = true;
   }
   return true;
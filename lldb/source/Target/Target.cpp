@@ -189,6 +189,8 @@ void Target::CleanupProcess() {
   DisableAllWatchpoints(false);
   ClearAllWatchpointHitCounts();
   ClearAllWatchpointHistoricValues();
+  // Cached expressions hold JITted code in the process we are tearing down.
+  ClearUserExpressionCache();
   m_latest_stop_hook_id = 0;
 }
 
@@ -1711,6 +1713,8 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
     UnloadModuleSections(module_list);
+    // Cached expressions may reference symbols in the unloaded modules.
+    ClearUserExpressionCache();
     BroadcastEvent(eBroadcastBitModulesUnloaded,
                    new TargetEventData(this->shared_from_this(), module_list));
     m_breakpoint_list.UpdateBreakpoints(module_list, false, delete_locations);
@@ -2843,6 +2847,25 @@ ExpressionResults Target::EvaluateExpression(
   return execution_results;
 }
 
+lldb::UserExpressionSP Target::FindCachedUserExpression(llvm::StringRef key) {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  auto pos = m_user_expression_cache.find(std::string(key));
+  if (pos == m_user_expression_cache.end())
+    return lldb::UserExpressionSP();
+  return pos->second;
+}
+
+void Target::CacheUserExpression(llvm::StringRef key,
+                                 lldb::UserExpressionSP user_expression_sp) {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  m_user_expression_cache[std::string(key)] = std::move(user_expression_sp);
+}
+
+void Target::ClearUserExpressionCache() {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  m_user_expression_cache.clear();
+}
+
 lldb::ExpressionVariableSP Target::GetPersistentVariable(ConstString name) {
   lldb::ExpressionVariableSP variable_sp;
   m_scratch_type_system_map.ForEach(
@@ -4824,6 +4847,12 @@ bool TargetProperties::GetEnableNotifyAboutFixIts() const {
       nullptr, idx, g_target_properties[idx].default_uint_value != 0);
 }
 
+bool TargetProperties::GetCacheUserExpressions() const {
+  const uint32_t idx = ePropertyCacheUserExpressions;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 FileSpec TargetProperties::GetSaveJITObjectsDir() const {
   const uint32_t idx = ePropertySaveObjectsDir;
   return m_collection_sp->GetPropertyAtIndexAsFileSpec(nullptr, idx);
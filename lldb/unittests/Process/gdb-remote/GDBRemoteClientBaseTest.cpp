@@ -342,6 +342,30 @@ TEST_F(GDBRemoteClientBaseTest, InterruptNoResponse) {
   ASSERT_EQ(eStateInvalid, continue_state.get());
 }
 
+TEST_F(GDBRemoteClientBaseTest, SendPacketsAndWaitForResponses) {
+  // Queue up the responses ahead of time; the client is expected to write the
+  // whole burst before it starts reading them back.
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("1122"));
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("3344"));
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("5566"));
+
+  std::vector<std::string> payloads = {"p0", "p1", "p2"};
+  std::vector<StringExtractorGDBRemote> responses;
+  ASSERT_EQ(PacketResult::Success,
+            client.SendPacketsAndWaitForResponses(payloads, responses));
+  ASSERT_EQ(3u, responses.size());
+  EXPECT_EQ("1122", responses[0].GetStringRef());
+  EXPECT_EQ("3344", responses[1].GetStringRef());
+  EXPECT_EQ("5566", responses[2].GetStringRef());
+
+  // The requests must have gone out in order as well.
+  for (const std::string &payload : payloads) {
+    StringExtractorGDBRemote request;
+    ASSERT_EQ(PacketResult::Success, server.GetPacket(request));
+    EXPECT_EQ(payload, request.GetStringRef());
+  }
+}
+
 TEST_F(GDBRemoteClientBaseTest, SendPacketAndReceiveResponseWithOutputSupport) {
   StringExtractorGDBRemote response;
   StreamString command_output;
@@ -0,0 +1,69 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/APInt.h"
+
+using llvm::APInt;
+
+// Constant folding is dominated by small widths: one word (<= 64 bits), two
+// words (i128), and the occasional wider type. Track each band separately so
+// regressions in the small-value fast paths are visible.
+
+static APInt makeValue(unsigned Bits, uint64_t Seed) {
+  APInt V(Bits, Seed | 1);
+  // Spread bits across all words so multi-word paths do real work.
+  for (unsigned I = 64; I < Bits; I += 64)
+    V |= APInt(Bits, Seed * (I + 0x9e3779b97f4a7c15ull) | 1).shl(I);
+  return V;
+}
+
+template <unsigned Bits> static void BM_APIntMul(benchmark::State &State) {
+  APInt A = makeValue(Bits, 0x123456789abcdefull);
+  APInt B = makeValue(Bits, 0xfedcba987654321ull);
+  for (auto _ : State) {
+    APInt R = A * B;
+    benchmark::DoNotOptimize(R);
+  }
+}
+BENCHMARK_TEMPLATE(BM_APIntMul, 64);
+BENCHMARK_TEMPLATE(BM_APIntMul, 128);
+BENCHMARK_TEMPLATE(BM_APIntMul, 256);
+
+template <unsigned Bits> static void BM_APIntUDiv(benchmark::State &State) {
+  APInt A = makeValue(Bits, 0x123456789abcdefull);
+  APInt B = makeValue(Bits, 0xff254ull).lshr(Bits / 2);
+  if (B.isZero())
+    B = APInt(Bits, 3);
+  for (auto _ : State) {
+    APInt R = A.udiv(B);
+    benchmark::DoNotOptimize(R);
+  }
+}
+BENCHMARK_TEMPLATE(BM_APIntUDiv, 64);
+BENCHMARK_TEMPLATE(BM_APIntUDiv, 128);
+BENCHMARK_TEMPLATE(BM_APIntUDiv, 256);
+
+template <unsigned Bits> static void BM_APIntURem(benchmark::State &State) {
+  APInt A = makeValue(Bits, 0x123456789abcdefull);
+  APInt B = makeValue(Bits, 0xff254ull).lshr(Bits / 2);
+  if (B.isZero())
+    B = APInt(Bits, 3);
+  for (auto _ : State) {
+    APInt R = A.urem(B);
+    benchmark::DoNotOptimize(R);
+  }
+}
+BENCHMARK_TEMPLATE(BM_APIntURem, 64);
+BENCHMARK_TEMPLATE(BM_APIntURem, 128);
+BENCHMARK_TEMPLATE(BM_APIntURem, 256);
+
+template <unsigned Bits> static void BM_APIntGetSplat(benchmark::State &State) {
+  APInt V(8, 0xa5);
+  for (auto _ : State) {
+    APInt R = APInt::getSplat(Bits, V);
+    benchmark::DoNotOptimize(R);
+  }
+}
+BENCHMARK_TEMPLATE(BM_APIntGetSplat, 64);
+BENCHMARK_TEMPLATE(BM_APIntGetSplat, 128);
+BENCHMARK_TEMPLATE(BM_APIntGetSplat, 256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+//===- BitstreamBench.cpp - Benchmark bitstream cursor reads --------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Benchmarks for SimpleBitstreamCursor and BitstreamCursor, built over
+// synthetic streams shaped like bitcode: fixed-width fields, VBR6 values and
+// abbreviated records. These are the primitives that dominate bitcode-heavy
+// thin links.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Bitstream/BitstreamReader.h"
+#include "llvm/Bitstream/BitstreamWriter.h"
+#include "benchmark/benchmark.h"
+
+using namespace llvm;
+
+static const unsigned TestBlockID = bitc::FIRST_APPLICATION_BLOCKID;
+
+// Emit NumValues VBR6-encoded values and pad out the final word.
+static SmallString<0> buildVBRStream(unsigned NumValues) {
+  SmallString<0> Buffer;
+  BitstreamWriter Writer(Buffer);
+  for (unsigned I = 0; I != NumValues; ++I)
+    Writer.EmitVBR64(uint64_t(I) * 977, 6);
+  Writer.FlushToWord();
+  return Buffer;
+}
+
+// Emit a block containing NumRecords records using a [Fixed8, VBR6, VBR6]
+// abbreviation.
+static SmallString<0> buildRecordStream(unsigned NumRecords) {
+  SmallString<0> Buffer;
+  BitstreamWriter Writer(Buffer);
+  Writer.EnterSubblock(TestBlockID, /*CodeLen=*/4);
+  auto Abbrev = std::make_shared<BitCodeAbbrev>();
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 8));
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6));
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6));
+  unsigned AbbrevID = Writer.EmitAbbrev(std::move(Abbrev));
+  for (unsigned I = 0; I != NumRecords; ++I) {
+    uint64_t Record[] = {I & 0x7f, I, uint64_t(I) * 977};
+    Writer.EmitRecordWithAbbrev(AbbrevID, makeArrayRef(Record));
+  }
+  Writer.ExitBlock();
+  return Buffer;
+}
+
+static void BM_ReadFixed(benchmark::State &State) {
+  const unsigned NumBits = unsigned(State.range(0));
+  SmallString<0> Buffer = buildVBRStream(64 * 1024);
+  const unsigned NumReads = unsigned(Buffer.size() * 8 / NumBits) - 1;
+  for (auto _ : State) {
+    SimpleBitstreamCursor Cursor(Buffer.str());
+    uint64_t Sum = 0;
+    for (unsigned I = 0; I != NumReads; ++I)
+      Sum += cantFail(Cursor.Read(NumBits));
+    benchmark::DoNotOptimize(Sum);
+  }
+}
+BENCHMARK(BM_ReadFixed)->Arg(6)->Arg(13)->Arg(32);
+
+static void BM_ReadVBR64(benchmark::State &State) {
+  const unsigned NumValues = 64 * 1024;
+  SmallString<0> Buffer = buildVBRStream(NumValues);
+  for (auto _ : State) {
+    SimpleBitstreamCursor Cursor(Buffer.str());
+    uint64_t Sum = 0;
+    for (unsigned I = 0; I != NumValues; ++I)
+      Sum += cantFail(Cursor.ReadVBR64(6));
+    benchmark::DoNotOptimize(Sum);
+  }
+}
+BENCHMARK(BM_ReadVBR64);
+
+static void BM_ReadAbbreviatedRecords(benchmark::State &State) {
+  SmallString<0> Buffer = buildRecordStream(16 * 1024);
+  SmallVector<uint64_t, 8> Values;
+  for (auto _ : State) {
+    BitstreamCursor Cursor(Buffer.str());
+    BitstreamEntry Entry = cantFail(Cursor.advance());
+    assert(Entry.Kind == BitstreamEntry::SubBlock && Entry.ID == TestBlockID);
+    cantFail(Cursor.EnterSubBlock(Entry.ID));
+    uint64_t Sum = 0;
+    while (true) {
+      Entry = cantFail(Cursor.advance());
+      if (Entry.Kind != BitstreamEntry::Record)
+        break;
+      Values.clear();
+      Sum += cantFail(Cursor.readRecord(Entry.ID, Values));
+      Sum += Values.back();
+    }
+    benchmark::DoNotOptimize(Sum);
+  }
+}
+BENCHMARK(BM_ReadAbbreviatedRecords);
+
+BENCHMARK_MAIN();
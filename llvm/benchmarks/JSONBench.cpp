@@ -0,0 +1,62 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+#include <string>
+
+// LSP-shaped payloads: semanticTokens responses are dominated by one huge
+// array of small integers, completion lists by arrays of objects with short
+// string fields.
+
+static std::string semanticTokensPayload() {
+  std::string S;
+  llvm::raw_string_ostream OS(S);
+  OS << R"({"jsonrpc":"2.0","id":1,"result":{"data":[)";
+  for (unsigned I = 0; I < 100000; ++I) {
+    if (I)
+      OS << ',';
+    OS << (I % 3 ? 0 : 1) << ',' << I % 120 << ',' << I % 16 << ',' << I % 22
+       << ",0";
+  }
+  OS << "]}}";
+  return S;
+}
+
+static std::string completionListPayload() {
+  std::string S;
+  llvm::raw_string_ostream OS(S);
+  OS << R"({"jsonrpc":"2.0","id":2,"result":{"isIncomplete":false,"items":[)";
+  for (unsigned I = 0; I < 5000; ++I) {
+    if (I)
+      OS << ',';
+    OS << R"({"label":"member)" << I
+       << R"(","kind":5,"detail":"int","sortText":")" << I
+       << R"(","insertText":"member)" << I
+       << R"(","documentation":"Returns the état of member )" << I
+       << R"( of the object under the cursor."})";
+  }
+  OS << "]}}";
+  return S;
+}
+
+static void benchmarkParse(benchmark::State &State, const std::string &Payload) {
+  for (auto _ : State) {
+    llvm::Expected<llvm::json::Value> V = llvm::json::parse(Payload);
+    benchmark::DoNotOptimize(V);
+    if (!V)
+      llvm::consumeError(V.takeError());
+  }
+  State.SetBytesProcessed(State.iterations() * Payload.size());
+}
+
+static void BM_JSONParseSemanticTokens(benchmark::State &State) {
+  benchmarkParse(State, semanticTokensPayload());
+}
+BENCHMARK(BM_JSONParseSemanticTokens);
+
+static void BM_JSONParseCompletionList(benchmark::State &State) {
+  benchmarkParse(State, completionListPayload());
+}
+BENCHMARK(BM_JSONParseCompletionList);
+
+BENCHMARK_MAIN();
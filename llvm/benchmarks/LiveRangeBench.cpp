@@ -0,0 +1,267 @@
+//===- LiveRangeBench.cpp - LiveRange bulk update benchmarks --------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Benchmarks the LiveRange update paths that dominate register coalescing:
+// many small segments inserted into an already large live range. Compares
+// one-at-a-time addSegment() against the batched addSegments() /
+// LiveRangeUpdater paths.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/CodeGen/LiveInterval.h"
+#include "llvm/CodeGen/MachineFrameInfo.h"
+#include "llvm/CodeGen/MachineFunction.h"
+#include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/SlotIndexes.h"
+#include "llvm/CodeGen/TargetFrameLowering.h"
+#include "llvm/CodeGen/TargetInstrInfo.h"
+#include "llvm/CodeGen/TargetLowering.h"
+#include "llvm/CodeGen/TargetRegisterInfo.h"
+#include "llvm/CodeGen/TargetSubtargetInfo.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Target/TargetMachine.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+// A few Bogus backend classes so we can create a MachineFunction (and with it
+// real SlotIndexes) without depending on a registered target. This mirrors
+// the approach of unittests/CodeGen/MFCommon.inc.
+
+class BogusTargetLowering : public TargetLowering {
+public:
+  BogusTargetLowering(TargetMachine &TM) : TargetLowering(TM) {}
+};
+
+class BogusFrameLowering : public TargetFrameLowering {
+public:
+  BogusFrameLowering()
+      : TargetFrameLowering(TargetFrameLowering::StackGrowsDown, Align(4), 4) {}
+
+  void emitPrologue(MachineFunction &MF,
+                    MachineBasicBlock &MBB) const override {}
+  void emitEpilogue(MachineFunction &MF,
+                    MachineBasicBlock &MBB) const override {}
+  bool hasFP(const MachineFunction &MF) const override { return false; }
+};
+
+TargetRegisterClass *const BogusRegisterClasses[] = {nullptr};
+
+class BogusRegisterInfo : public TargetRegisterInfo {
+public:
+  BogusRegisterInfo()
+      : TargetRegisterInfo(nullptr, BogusRegisterClasses, BogusRegisterClasses,
+                           nullptr, nullptr, LaneBitmask(~0u), nullptr) {
+    InitMCRegisterInfo(nullptr, 0, 0, 0, nullptr, 0, nullptr, 0, nullptr,
+                       nullptr, nullptr, nullptr, nullptr, 0, nullptr, nullptr);
+  }
+
+  const MCPhysReg *
+  getCalleeSavedRegs(const MachineFunction *MF) const override {
+    return nullptr;
+  }
+  ArrayRef<const uint32_t *> getRegMasks() const override { return None; }
+  ArrayRef<const char *> getRegMaskNames() const override { return None; }
+  BitVector getReservedRegs(const MachineFunction &MF) const override {
+    return BitVector();
+  }
+  const RegClassWeight &
+  getRegClassWeight(const TargetRegisterClass *RC) const override {
+    static RegClassWeight Bogus{1, 16};
+    return Bogus;
+  }
+  unsigned getRegUnitWeight(unsigned RegUnit) const override { return 1; }
+  unsigned getNumRegPressureSets() const override { return 0; }
+  const char *getRegPressureSetName(unsigned Idx) const override {
+    return "bogus";
+  }
+  unsigned getRegPressureSetLimit(const MachineFunction &MF,
+                                  unsigned Idx) const override {
+    return 0;
+  }
+  const int *
+  getRegClassPressureSets(const TargetRegisterClass *RC) const override {
+    static const int Bogus[] = {0, -1};
+    return &Bogus[0];
+  }
+  const int *getRegUnitPressureSets(unsigned RegUnit) const override {
+    static const int Bogus[] = {0, -1};
+    return &Bogus[0];
+  }
+
+  Register getFrameRegister(const MachineFunction &MF) const override {
+    return 0;
+  }
+  void eliminateFrameIndex(MachineBasicBlock::iterator MI, int SPAdj,
+                           unsigned FIOperandNum,
+                           RegScavenger *RS = nullptr) const override {}
+};
+
+class BogusSubtarget : public TargetSubtargetInfo {
+public:
+  BogusSubtarget(TargetMachine &TM)
+      : TargetSubtargetInfo(Triple(""), "", "", "", {}, {}, nullptr, nullptr,
+                            nullptr, nullptr, nullptr, nullptr),
+        TL(TM) {}
+  ~BogusSubtarget() override {}
+
+  const TargetFrameLowering *getFrameLowering() const override { return &FL; }
+  const TargetLowering *getTargetLowering() const override { return &TL; }
+  const TargetInstrInfo *getInstrInfo() const override { return &TII; }
+  const TargetRegisterInfo *getRegisterInfo() const override { return &TRI; }
+
+private:
+  BogusFrameLowering FL;
+  BogusRegisterInfo TRI;
+  BogusTargetLowering TL;
+  TargetInstrInfo TII;
+};
+
+class BogusTargetMachine : public LLVMTargetMachine {
+public:
+  BogusTargetMachine()
+      : LLVMTargetMachine(Target(), "", Triple(""), "", "", TargetOptions(),
+                          Reloc::Static, CodeModel::Small,
+                          CodeGenOpt::Default),
+        ST(*this) {}
+  ~BogusTargetMachine() override {}
+
+  const TargetSubtargetInfo *getSubtargetImpl(const Function &) const override {
+    return &ST;
+  }
+
+private:
+  BogusSubtarget ST;
+};
+
+// Holds a MachineFunction made of empty basic blocks, whose only purpose is
+// to let SlotIndexes mint a long, ordered list of indexes to build segments
+// from. One block yields one usable [base, dead) index pair.
+struct IndexPool {
+  LLVMContext Ctx;
+  Module Mod;
+  BogusTargetMachine TM;
+  MachineModuleInfo MMI;
+  std::unique_ptr<MachineFunction> MF;
+  SlotIndexes Indexes;
+  std::vector<SlotIndex> BlockStarts;
+
+  explicit IndexPool(unsigned NumBlocks)
+      : Mod("livrange-bench", Ctx), MMI(&TM) {
+    auto *FTy = FunctionType::get(Type::getVoidTy(Ctx), false);
+    auto *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "f", &Mod);
+    MF = std::make_unique<MachineFunction>(*F, TM, *TM.getSubtargetImpl(*F), 0,
+                                           MMI);
+    for (unsigned I = 0; I < NumBlocks; ++I)
+      MF->push_back(MF->CreateMachineBasicBlock());
+    Indexes.runOnMachineFunction(*MF);
+    for (MachineBasicBlock &MBB : *MF)
+      BlockStarts.push_back(Indexes.getMBBStartIdx(&MBB));
+  }
+
+  // The live-in interval of block I: [block start, register slot).
+  LiveRange::Segment evenSegment(unsigned I, VNInfo *VNI) const {
+    SlotIndex S = BlockStarts[I];
+    return LiveRange::Segment(S.getBaseIndex(), S.getRegSlot(), VNI);
+  }
+
+  // The interval the coalescer copies in for block I: [register slot, dead
+  // slot). Abuts evenSegment(I) so the two merge, like a coalesced copy.
+  LiveRange::Segment oddSegment(unsigned I, VNInfo *VNI) const {
+    SlotIndex S = BlockStarts[I];
+    return LiveRange::Segment(S.getRegSlot(), S.getDeadSlot(), VNI);
+  }
+};
+
+IndexPool &getPool() {
+  static IndexPool Pool(/*NumBlocks=*/8192);
+  return Pool;
+}
+
+// Build the "destination" range: a segment in every block.
+void buildBaseRange(LiveRange &LR, const IndexPool &Pool, unsigned NumSegments,
+                    VNInfo *VNI) {
+  for (unsigned I = 0; I < NumSegments; ++I)
+    LR.addSegment(Pool.evenSegment(I, VNI));
+}
+
+// The storm the coalescer produces: one new segment abutting every existing
+// one, presented in shuffled order.
+std::vector<unsigned> stormOrder(unsigned NumSegments) {
+  std::vector<unsigned> Order(NumSegments);
+  for (unsigned I = 0; I < NumSegments; ++I)
+    Order[I] = I;
+  std::shuffle(Order.begin(), Order.end(), std::mt19937(42));
+  return Order;
+}
+
+void BM_LiveRangeAddSegment(benchmark::State &State) {
+  IndexPool &Pool = getPool();
+  const unsigned NumSegments = State.range(0);
+  std::vector<unsigned> Order = stormOrder(NumSegments);
+  for (auto _ : State) {
+    VNInfo::Allocator Alloc;
+    LiveRange LR;
+    VNInfo *VNI = LR.getNextValue(Pool.BlockStarts[0], Alloc);
+    buildBaseRange(LR, Pool, NumSegments, VNI);
+    for (unsigned I : Order)
+      LR.addSegment(Pool.oddSegment(I, VNI));
+    benchmark::DoNotOptimize(LR.size());
+  }
+}
+
+void BM_LiveRangeAddSegments(benchmark::State &State) {
+  IndexPool &Pool = getPool();
+  const unsigned NumSegments = State.range(0);
+  std::vector<unsigned> Order = stormOrder(NumSegments);
+  for (auto _ : State) {
+    VNInfo::Allocator Alloc;
+    LiveRange LR;
+    VNInfo *VNI = LR.getNextValue(Pool.BlockStarts[0], Alloc);
+    buildBaseRange(LR, Pool, NumSegments, VNI);
+    SmallVector<LiveRange::Segment, 32> Batch;
+    for (unsigned I : Order)
+      Batch.push_back(Pool.oddSegment(I, VNI));
+    LR.addSegments(Batch);
+    benchmark::DoNotOptimize(LR.size());
+  }
+}
+
+void BM_LiveRangeUpdater(benchmark::State &State) {
+  IndexPool &Pool = getPool();
+  const unsigned NumSegments = State.range(0);
+  for (auto _ : State) {
+    VNInfo::Allocator Alloc;
+    LiveRange LR;
+    VNInfo *VNI = LR.getNextValue(Pool.BlockStarts[0], Alloc);
+    buildBaseRange(LR, Pool, NumSegments, VNI);
+    // In-order updates, the updater's fast path.
+    LiveRangeUpdater Updater(&LR);
+    for (unsigned I = 0; I < NumSegments; ++I)
+      Updater.add(Pool.oddSegment(I, VNI));
+    Updater.flush();
+    benchmark::DoNotOptimize(LR.size());
+  }
+}
+
+} // end anonymous namespace
+
+BENCHMARK(BM_LiveRangeAddSegment)->Arg(256)->Arg(1024)->Arg(8192);
+BENCHMARK(BM_LiveRangeAddSegments)->Arg(256)->Arg(1024)->Arg(8192);
+BENCHMARK(BM_LiveRangeUpdater)->Arg(256)->Arg(1024)->Arg(8192);
+
+BENCHMARK_MAIN();
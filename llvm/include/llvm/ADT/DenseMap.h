@@ -120,7 +120,22 @@ public:
 
     const KeyT EmptyKey = getEmptyKey(), TombstoneKey = getTombstoneKey();
     if (std::is_trivially_destructible<ValueT>::value) {
-      // Use a simpler loop when values don't need destruction.
+      // Use a simpler loop when values don't need destruction, or a memset
+      // when additionally the empty key is a splat of one byte (see
+      // initEmpty).
+      if constexpr (std::is_trivially_copyable<KeyT>::value) {
+        const auto *Bytes = reinterpret_cast<const unsigned char *>(&EmptyKey);
+        bool IsSplat = true;
+        for (size_t I = 1; I < sizeof(KeyT); ++I)
+          IsSplat &= Bytes[I] == Bytes[0];
+        if (IsSplat) {
+          std::memset(static_cast<void *>(getBuckets()), Bytes[0],
+                      sizeof(BucketT) * getNumBuckets());
+          setNumEntries(0);
+          setNumTombstones(0);
+          return;
+        }
+      }
       for (BucketT *P = getBuckets(), *E = getBucketsEnd(); P != E; ++P)
         P->getFirst() = EmptyKey;
     } else {
@@ -377,6 +392,21 @@ protected:
     assert((getNumBuckets() & (getNumBuckets()-1)) == 0 &&
            "# initial buckets must be a power of two!");
     const KeyT EmptyKey = getEmptyKey();
+    // Many common keys (unsigned, char, ...) use an all-ones empty key. When
+    // every byte of the empty key is the same, the whole table can be filled
+    // with a single memset instead of a store per bucket; the value halves of
+    // the buckets hold no live objects yet, so scribbling over them is fine.
+    if constexpr (std::is_trivially_copyable<KeyT>::value) {
+      const auto *Bytes = reinterpret_cast<const unsigned char *>(&EmptyKey);
+      bool IsSplat = true;
+      for (size_t I = 1; I < sizeof(KeyT); ++I)
+        IsSplat &= Bytes[I] == Bytes[0];
+      if (IsSplat) {
+        std::memset(static_cast<void *>(getBuckets()), Bytes[0],
+                    sizeof(BucketT) * getNumBuckets());
+        return;
+      }
+    }
     for (BucketT *B = getBuckets(), *E = getBucketsEnd(); B != E; ++B)
       ::new (&B->getFirst()) KeyT(EmptyKey);
   }
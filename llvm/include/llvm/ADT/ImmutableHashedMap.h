@@ -0,0 +1,593 @@
+//===--- ImmutableHashedMap.h - Immutable hashed map interface --*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the ImmutableHashedMap class, a persistent (functional)
+/// map implemented as a hash array mapped trie.  Unlike ImmutableMap, which
+/// rebalances an AVL tree and canonicalizes whole trees by walking their
+/// elements, an ImmutableHashedMap places each entry at a position determined
+/// solely by the hash of its key and interns every node in a FoldingSet as it
+/// is built.  The structure of a map is therefore a function of its contents
+/// alone: equal maps share one root pointer, updates path-copy at most one
+/// 32-way node per hash chunk, and no post-hoc canonicalization pass exists.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_IMMUTABLEHASHEDMAP_H
+#define LLVM_ADT_IMMUTABLEHASHEDMAP_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/ImmutableMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/MathExtras.h"
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace llvm {
+
+/// ImutHashedKeyValueInfo - Traits class used by ImmutableHashedMap.  Extends
+/// the ordering-free subset of ImutKeyValueInfo with the key hash used to
+/// place entries in the trie.  The hash must be a pure function of the key's
+/// profile.
+template <typename T, typename S>
+struct ImutHashedKeyValueInfo : ImutKeyValueInfo<T, S> {
+  using key_type_ref = typename ImutKeyValueInfo<T, S>::key_type_ref;
+
+  static void ProfileKey(FoldingSetNodeID &ID, key_type_ref K) {
+    ImutContainerInfo<T>::Profile(ID, K);
+  }
+
+  static uint32_t getHash(key_type_ref K) {
+    FoldingSetNodeID ID;
+    ProfileKey(ID, K);
+    return ID.ComputeHash();
+  }
+};
+
+template <typename ImutInfo> class ImutHamtFactory;
+
+/// ImutHamtNode - An interior or exterior node of a hash array mapped trie.
+/// Nodes are immutable once created, are uniqued by the owning factory, and
+/// live for the lifetime of that factory; they are never reference counted.
+template <typename ImutInfo>
+class ImutHamtNode : public FoldingSetNode {
+public:
+  using value_type = typename ImutInfo::value_type;
+  using value_type_ref = typename ImutInfo::value_type_ref;
+
+  /// Entries are stored without the top-level const of \c value_type so that
+  /// they can be kept in ArrayRefs and rearranged while nodes are assembled.
+  using stored_value_type = std::remove_const_t<value_type>;
+
+  enum NodeKind : uint8_t {
+    /// A single entry, addressed by the full hash of its key.
+    LeafKind,
+    /// Up to 32 children, one per 5-bit chunk of the hash at this depth.
+    BranchKind,
+    /// Two or more entries whose keys share one full 32-bit hash.
+    CollisionKind
+  };
+
+private:
+  friend class ImutHamtFactory<ImutInfo>;
+
+  NodeKind Kind;
+
+  /// The full key hash for leaves and collisions, or the bitmap of occupied
+  /// child slots for branches.
+  uint32_t HashOrBitmap;
+
+  /// The entries stored here: one for a leaf, two or more (in a deterministic
+  /// order) for a collision, none for a branch.
+  ArrayRef<stored_value_type> Values;
+
+  /// The children of a branch, ordered by ascending chunk index.
+  ArrayRef<const ImutHamtNode *> Children;
+
+  ImutHamtNode(NodeKind Kind, uint32_t HashOrBitmap,
+               ArrayRef<stored_value_type> Values,
+               ArrayRef<const ImutHamtNode *> Children)
+      : Kind(Kind), HashOrBitmap(HashOrBitmap), Values(Values),
+        Children(Children) {}
+
+public:
+  NodeKind getKind() const { return Kind; }
+  bool isLeafOrCollision() const { return Kind != BranchKind; }
+
+  uint32_t getHash() const {
+    assert(isLeafOrCollision() && "Branches are not addressed by one hash");
+    return HashOrBitmap;
+  }
+
+  uint32_t getBitmap() const {
+    assert(Kind == BranchKind && "Only branches carry a bitmap");
+    return HashOrBitmap;
+  }
+
+  ArrayRef<stored_value_type> values() const { return Values; }
+  ArrayRef<const ImutHamtNode *> children() const { return Children; }
+
+  static void Profile(FoldingSetNodeID &ID, NodeKind Kind,
+                      uint32_t HashOrBitmap, ArrayRef<stored_value_type> Values,
+                      ArrayRef<const ImutHamtNode *> Children) {
+    ID.AddInteger(static_cast<unsigned>(Kind));
+    ID.AddInteger(HashOrBitmap);
+    for (value_type_ref V : Values)
+      ImutInfo::Profile(ID, V);
+    for (const ImutHamtNode *C : Children)
+      ID.AddPointer(C);
+  }
+
+  void Profile(FoldingSetNodeID &ID) const {
+    Profile(ID, Kind, HashOrBitmap, Values, Children);
+  }
+};
+
+/// ImutHamtFactory - Builds and uniques the nodes of ImmutableHashedMaps.
+/// Because children are themselves uniqued before their parent is profiled,
+/// interning each node by content makes structurally equal maps pointer-equal
+/// without ever walking a finished tree.
+template <typename ImutInfo>
+class ImutHamtFactory {
+public:
+  using NodeTy = ImutHamtNode<ImutInfo>;
+  using value_type = typename NodeTy::value_type;
+  using value_type_ref = typename NodeTy::value_type_ref;
+  using key_type_ref = typename ImutInfo::key_type_ref;
+
+private:
+  using NodeKind = typename NodeTy::NodeKind;
+  using stored_value_type = typename NodeTy::stored_value_type;
+
+  /// The number of hash bits consumed per trie level.
+  static constexpr unsigned BitsPerLevel = 5;
+  static constexpr unsigned BranchFactor = 1u << BitsPerLevel;
+
+  FoldingSet<NodeTy> Cache;
+  uintptr_t Allocator;
+
+  bool ownsAllocator() const { return (Allocator & 0x1) == 0; }
+
+  BumpPtrAllocator &getAllocator() const {
+    return *reinterpret_cast<BumpPtrAllocator *>(Allocator & ~0x1);
+  }
+
+public:
+  ImutHamtFactory()
+      : Allocator(reinterpret_cast<uintptr_t>(new BumpPtrAllocator())) {}
+
+  ImutHamtFactory(BumpPtrAllocator &Alloc)
+      : Allocator(reinterpret_cast<uintptr_t>(&Alloc) | 0x1) {}
+
+  ImutHamtFactory(const ImutHamtFactory &) = delete;
+  ImutHamtFactory &operator=(const ImutHamtFactory &) = delete;
+
+  ~ImutHamtFactory() {
+    if (ownsAllocator())
+      delete &getAllocator();
+  }
+
+  const NodeTy *getEmptyTree() const { return nullptr; }
+
+  const NodeTy *add(const NodeTy *Root, value_type_ref V) {
+    return insert(Root, ImutInfo::getHash(ImutInfo::KeyOfValue(V)), V,
+                  /*Shift=*/0);
+  }
+
+  const NodeTy *remove(const NodeTy *Root, key_type_ref K) {
+    return removeImpl(Root, ImutInfo::getHash(K), K, /*Shift=*/0);
+  }
+
+  static const value_type *find(const NodeTy *N, key_type_ref K) {
+    uint32_t Hash = ImutInfo::getHash(K);
+    unsigned Shift = 0;
+    while (N) {
+      switch (N->getKind()) {
+      case NodeTy::LeafKind: {
+        value_type_ref V = N->values().front();
+        if (N->getHash() == Hash &&
+            ImutInfo::isEqual(K, ImutInfo::KeyOfValue(V)))
+          return &N->values().front();
+        return nullptr;
+      }
+      case NodeTy::CollisionKind: {
+        if (N->getHash() != Hash)
+          return nullptr;
+        for (value_type_ref V : N->values())
+          if (ImutInfo::isEqual(K, ImutInfo::KeyOfValue(V)))
+            return &V;
+        return nullptr;
+      }
+      case NodeTy::BranchKind: {
+        uint32_t Bit = chunkBit(Hash, Shift);
+        if (!(N->getBitmap() & Bit))
+          return nullptr;
+        N = N->children()[slotIndex(N->getBitmap(), Bit)];
+        Shift += BitsPerLevel;
+        break;
+      }
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  static uint32_t chunkBit(uint32_t Hash, unsigned Shift) {
+    return 1u << ((Hash >> Shift) & (BranchFactor - 1));
+  }
+
+  /// The index of the child selected by \p Bit within a branch's dense child
+  /// array: the number of occupied slots below it.
+  static unsigned slotIndex(uint32_t Bitmap, uint32_t Bit) {
+    return countPopulation(Bitmap & (Bit - 1));
+  }
+
+  /// Keys that share a full hash have no intrinsic order, but collision
+  /// entries must still be stored deterministically for interning to equate
+  /// maps with identical contents.  Order them by their key profiles.
+  static bool orderedBefore(value_type_ref L, value_type_ref R) {
+    FoldingSetNodeID LID, RID;
+    ImutInfo::ProfileKey(LID, ImutInfo::KeyOfValue(L));
+    ImutInfo::ProfileKey(RID, ImutInfo::KeyOfValue(R));
+    return LID < RID;
+  }
+
+  ArrayRef<stored_value_type> copyValues(ArrayRef<stored_value_type> Values) {
+    if (Values.empty())
+      return {};
+    auto *Array =
+        getAllocator().template Allocate<stored_value_type>(Values.size());
+    for (size_t I = 0, E = Values.size(); I != E; ++I)
+      new (&Array[I]) stored_value_type(Values[I]);
+    return makeArrayRef(Array, Values.size());
+  }
+
+  ArrayRef<const NodeTy *> copyChildren(ArrayRef<const NodeTy *> Children) {
+    if (Children.empty())
+      return {};
+    auto *Array =
+        getAllocator().template Allocate<const NodeTy *>(Children.size());
+    std::copy(Children.begin(), Children.end(), Array);
+    return makeArrayRef(Array, Children.size());
+  }
+
+  const NodeTy *getNode(NodeKind Kind, uint32_t HashOrBitmap,
+                        ArrayRef<stored_value_type> Values,
+                        ArrayRef<const NodeTy *> Children) {
+    FoldingSetNodeID ID;
+    NodeTy::Profile(ID, Kind, HashOrBitmap, Values, Children);
+    void *InsertPos;
+    if (NodeTy *N = Cache.FindNodeOrInsertPos(ID, InsertPos))
+      return N;
+
+    auto *N = getAllocator().template Allocate<NodeTy>();
+    new (N) NodeTy(Kind, HashOrBitmap, copyValues(Values),
+                   copyChildren(Children));
+    Cache.InsertNode(N, InsertPos);
+    return N;
+  }
+
+  const NodeTy *makeLeaf(uint32_t Hash, value_type_ref V) {
+    return getNode(NodeTy::LeafKind, Hash, V, None);
+  }
+
+  const NodeTy *makeCollision(uint32_t Hash,
+                              ArrayRef<stored_value_type> Values) {
+    assert(Values.size() >= 2 && "Collisions hold at least two entries");
+    return getNode(NodeTy::CollisionKind, Hash, Values, None);
+  }
+
+  const NodeTy *makeBranch(uint32_t Bitmap,
+                           ArrayRef<const NodeTy *> Children) {
+    assert(countPopulation(Bitmap) == Children.size() &&
+           "Bitmap does not match the child array");
+    return getNode(NodeTy::BranchKind, Bitmap, None, Children);
+  }
+
+  /// Build the branch (or chain of single-child branches) distinguishing two
+  /// leaf-or-collision nodes whose hashes first differ at or below \p Shift.
+  const NodeTy *combine(const NodeTy *A, const NodeTy *B, unsigned Shift) {
+    assert(A->getHash() != B->getHash() && "Nodes must be separable");
+    uint32_t ABit = chunkBit(A->getHash(), Shift);
+    uint32_t BBit = chunkBit(B->getHash(), Shift);
+    if (ABit == BBit) {
+      const NodeTy *Child = combine(A, B, Shift + BitsPerLevel);
+      return makeBranch(ABit, Child);
+    }
+    const NodeTy *Children[2] = {A, B};
+    if (BBit < ABit)
+      std::swap(Children[0], Children[1]);
+    return makeBranch(ABit | BBit, Children);
+  }
+
+  const NodeTy *insertIntoCollision(const NodeTy *N, value_type_ref V) {
+    SmallVector<stored_value_type, 4> Values(N->values().begin(),
+                                             N->values().end());
+    for (size_t I = 0, E = Values.size(); I != E; ++I) {
+      if (ImutInfo::isEqual(ImutInfo::KeyOfValue(V),
+                            ImutInfo::KeyOfValue(Values[I]))) {
+        if (ImutInfo::isDataEqual(ImutInfo::DataOfValue(V),
+                                  ImutInfo::DataOfValue(Values[I])))
+          return N;
+        Values[I] = V;
+        return makeCollision(N->getHash(), Values);
+      }
+    }
+    auto *Pos = Values.begin();
+    while (Pos != Values.end() && orderedBefore(*Pos, V))
+      ++Pos;
+    Values.insert(Pos, V);
+    return makeCollision(N->getHash(), Values);
+  }
+
+  const NodeTy *insert(const NodeTy *N, uint32_t Hash, value_type_ref V,
+                       unsigned Shift) {
+    if (!N)
+      return makeLeaf(Hash, V);
+
+    switch (N->getKind()) {
+    case NodeTy::LeafKind: {
+      value_type_ref Old = N->values().front();
+      if (N->getHash() == Hash) {
+        if (ImutInfo::isEqual(ImutInfo::KeyOfValue(V),
+                              ImutInfo::KeyOfValue(Old))) {
+          if (ImutInfo::isDataEqual(ImutInfo::DataOfValue(V),
+                                    ImutInfo::DataOfValue(Old)))
+            return N;
+          return makeLeaf(Hash, V);
+        }
+        stored_value_type Values[2] = {Old, V};
+        if (orderedBefore(V, Old))
+          std::swap(Values[0], Values[1]);
+        return makeCollision(Hash, Values);
+      }
+      return combine(N, makeLeaf(Hash, V), Shift);
+    }
+    case NodeTy::CollisionKind:
+      if (N->getHash() == Hash)
+        return insertIntoCollision(N, V);
+      return combine(N, makeLeaf(Hash, V), Shift);
+    case NodeTy::BranchKind: {
+      uint32_t Bitmap = N->getBitmap();
+      uint32_t Bit = chunkBit(Hash, Shift);
+      unsigned Slot = slotIndex(Bitmap, Bit);
+      SmallVector<const NodeTy *, 8> Children(N->children().begin(),
+                                              N->children().end());
+      if (Bitmap & Bit) {
+        const NodeTy *NewChild =
+            insert(Children[Slot], Hash, V, Shift + BitsPerLevel);
+        if (NewChild == Children[Slot])
+          return N;
+        Children[Slot] = NewChild;
+        return makeBranch(Bitmap, Children);
+      }
+      Children.insert(Children.begin() + Slot, makeLeaf(Hash, V));
+      return makeBranch(Bitmap | Bit, Children);
+    }
+    }
+    llvm_unreachable("Unknown ImutHamtNode kind");
+  }
+
+  const NodeTy *removeImpl(const NodeTy *N, uint32_t Hash, key_type_ref K,
+                           unsigned Shift) {
+    if (!N)
+      return nullptr;
+
+    switch (N->getKind()) {
+    case NodeTy::LeafKind:
+      if (N->getHash() == Hash &&
+          ImutInfo::isEqual(K, ImutInfo::KeyOfValue(N->values().front())))
+        return nullptr;
+      return N;
+    case NodeTy::CollisionKind: {
+      if (N->getHash() != Hash)
+        return N;
+      SmallVector<stored_value_type, 4> Values(N->values().begin(),
+                                               N->values().end());
+      for (size_t I = 0, E = Values.size(); I != E; ++I) {
+        if (ImutInfo::isEqual(K, ImutInfo::KeyOfValue(Values[I]))) {
+          Values.erase(Values.begin() + I);
+          if (Values.size() == 1)
+            return makeLeaf(Hash, Values.front());
+          return makeCollision(Hash, Values);
+        }
+      }
+      return N;
+    }
+    case NodeTy::BranchKind: {
+      uint32_t Bitmap = N->getBitmap();
+      uint32_t Bit = chunkBit(Hash, Shift);
+      if (!(Bitmap & Bit))
+        return N;
+      unsigned Slot = slotIndex(Bitmap, Bit);
+      const NodeTy *Child = N->children()[Slot];
+      const NodeTy *NewChild = removeImpl(Child, Hash, K, Shift + BitsPerLevel);
+      if (NewChild == Child)
+        return N;
+
+      SmallVector<const NodeTy *, 8> Children(N->children().begin(),
+                                              N->children().end());
+      if (!NewChild) {
+        Children.erase(Children.begin() + Slot);
+        if (Children.empty())
+          return nullptr;
+        // A lone remaining entry no longer needs this branch to tell it
+        // apart from the removed one; hoist it so the result matches the
+        // shape insertion would have built.
+        if (Children.size() == 1 && Children.front()->isLeafOrCollision())
+          return Children.front();
+        return makeBranch(Bitmap & ~Bit, Children);
+      }
+      if (Children.size() == 1 && NewChild->isLeafOrCollision())
+        return NewChild;
+      Children[Slot] = NewChild;
+      return makeBranch(Bitmap, Children);
+    }
+    }
+    llvm_unreachable("Unknown ImutHamtNode kind");
+  }
+};
+
+/// ImmutableHashedMap - A persistent map with the same functional interface
+/// as ImmutableMap but backed by a hash array mapped trie.  Maps with equal
+/// contents built through one factory share a single root node, so map
+/// equality and profiling are pointer operations and no whole-tree
+/// canonicalization step is required.  Key ordering is never consulted, so
+/// iteration order is deterministic but unrelated to operator<.
+template <typename KeyT, typename ValT,
+          typename ValInfo = ImutHashedKeyValueInfo<KeyT, ValT>>
+class ImmutableHashedMap {
+public:
+  using value_type = typename ValInfo::value_type;
+  using value_type_ref = typename ValInfo::value_type_ref;
+  using key_type = typename ValInfo::key_type;
+  using key_type_ref = typename ValInfo::key_type_ref;
+  using data_type = typename ValInfo::data_type;
+  using data_type_ref = typename ValInfo::data_type_ref;
+  using NodeTy = ImutHamtNode<ValInfo>;
+
+private:
+  const NodeTy *Root;
+
+public:
+  /// Constructs a map from a trie root.  As with ImmutableMap, maps should
+  /// normally be obtained from a Factory; this is public for code that
+  /// round-trips roots through opaque storage.
+  explicit ImmutableHashedMap(const NodeTy *R) : Root(R) {}
+
+  class Factory {
+    ImutHamtFactory<ValInfo> F;
+
+  public:
+    Factory() = default;
+    Factory(BumpPtrAllocator &Alloc) : F(Alloc) {}
+
+    Factory(const Factory &) = delete;
+    Factory &operator=(const Factory &) = delete;
+
+    ImmutableHashedMap getEmptyMap() {
+      return ImmutableHashedMap(F.getEmptyTree());
+    }
+
+    [[nodiscard]] ImmutableHashedMap add(ImmutableHashedMap Old,
+                                         key_type_ref K, data_type_ref D) {
+      return ImmutableHashedMap(
+          F.add(Old.Root, std::pair<key_type, data_type>(K, D)));
+    }
+
+    [[nodiscard]] ImmutableHashedMap remove(ImmutableHashedMap Old,
+                                            key_type_ref K) {
+      return ImmutableHashedMap(F.remove(Old.Root, K));
+    }
+  };
+
+  bool isEmpty() const { return !Root; }
+
+  bool contains(key_type_ref K) const {
+    return ImutHamtFactory<ValInfo>::find(Root, K) != nullptr;
+  }
+
+  data_type *lookup(key_type_ref K) const {
+    if (const value_type *V = ImutHamtFactory<ValInfo>::find(Root, K))
+      return &V->second;
+    return nullptr;
+  }
+
+  /// Equal contents imply equal roots, so comparison needs no tree walk.
+  bool operator==(const ImmutableHashedMap &RHS) const {
+    return Root == RHS.Root;
+  }
+  bool operator!=(const ImmutableHashedMap &RHS) const {
+    return Root != RHS.Root;
+  }
+
+  const NodeTy *getRoot() const { return Root; }
+
+  //===--------------------------------------------------===//
+  // Iterators.
+  //===--------------------------------------------------===//
+
+  /// Iterates over the entries of the trie in deterministic (hash) order.
+  class iterator {
+    friend class ImmutableHashedMap;
+
+    /// The path from the root: branches paired with the index of the child
+    /// being visited; the top entry is a leaf or collision paired with the
+    /// index of the current value.
+    SmallVector<std::pair<const NodeTy *, unsigned>, 8> Path;
+
+    iterator() = default;
+
+    explicit iterator(const NodeTy *Root) {
+      if (Root)
+        descend(Root);
+    }
+
+    void descend(const NodeTy *N) {
+      while (!N->isLeafOrCollision()) {
+        Path.push_back({N, 0});
+        N = N->children().front();
+      }
+      Path.push_back({N, 0});
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = value_type_ref;
+
+    value_type_ref operator*() const {
+      return Path.back().first->values()[Path.back().second];
+    }
+    pointer operator->() const { return &operator*(); }
+
+    key_type_ref getKey() const { return (*this)->first; }
+    data_type_ref getData() const { return (*this)->second; }
+
+    iterator &operator++() {
+      if (++Path.back().second < Path.back().first->values().size())
+        return *this;
+      Path.pop_back();
+      while (!Path.empty()) {
+        const NodeTy *Branch = Path.back().first;
+        unsigned NextChild = ++Path.back().second;
+        if (NextChild < Branch->children().size()) {
+          descend(Branch->children()[NextChild]);
+          return *this;
+        }
+        Path.pop_back();
+      }
+      return *this;
+    }
+
+    bool operator==(const iterator &RHS) const { return Path == RHS.Path; }
+    bool operator!=(const iterator &RHS) const { return !(*this == RHS); }
+  };
+
+  iterator begin() const { return iterator(Root); }
+  iterator end() const { return iterator(); }
+
+  //===--------------------------------------------------===//
+  // Utility methods.
+  //===--------------------------------------------------===//
+
+  static void Profile(FoldingSetNodeID &ID, const ImmutableHashedMap &M) {
+    ID.AddPointer(M.Root);
+  }
+
+  void Profile(FoldingSetNodeID &ID) const { Profile(ID, *this); }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_IMMUTABLEHASHEDMAP_H
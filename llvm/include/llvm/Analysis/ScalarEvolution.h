@@ -1287,6 +1287,21 @@ private:
   /// predicate by splitting it into a set of independent predicates.
   bool ProvingSplitPredicate = false;
 
+  /// Remaining number of recursive arithmetic simplification steps the
+  /// current top-level getAddExpr/getMulExpr request may still spend.
+  /// Refilled on every depth-zero call; once exhausted, expressions are
+  /// created without further simplification, like the depth cutoffs. Starts
+  /// out effectively unlimited for nested calls that are reached before any
+  /// top-level add/mul request.
+  unsigned ArithSimplifyBudget = ~0u;
+
+  /// Refill \c ArithSimplifyBudget at the start of a top-level request.
+  void refillArithBudget();
+
+  /// Charge one simplification step against \c ArithSimplifyBudget.
+  /// Returns false once the budget is exhausted.
+  bool consumeArithBudget();
+
   /// Memoized values for the GetMinTrailingZeros
   DenseMap<const SCEV *, uint32_t> MinTrailingZerosCache;
 
@@ -55,6 +55,11 @@ namespace llvm {
 
     typedef SMLoc LocTy;
     LocTy getLoc() const { return SMLoc::getFromPointer(TokStart); }
+
+    /// Reposition the lexer so that the next Lex() call lexes the token
+    /// starting at \p Loc.  Used to reparse lazily skipped function bodies.
+    void setLoc(LocTy Loc) { CurPtr = Loc.getPointer(); }
+
     lltok::Kind getKind() const { return CurKind; }
     const std::string &getStrVal() const { return StrVal; }
     Type *getTyVal() const { return TyVal; }
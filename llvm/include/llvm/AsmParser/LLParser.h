@@ -43,6 +43,7 @@ namespace llvm {
   class MDString;
   class MDNode;
   struct SlotMapping;
+  class StructType;
 
   /// ValID - Represents a reference of a definition of some sort with no type.
   /// There are several cases where we have to parse the value but where the
@@ -153,19 +154,47 @@ namespace llvm {
     /// UpgradeDebuginfo so it can generate broken bitcode.
     bool UpgradeDebugInfo;
 
+    /// When true, function bodies are skipped during the initial parse and
+    /// recorded in DeferredFunctionInfo so that they can be parsed on demand
+    /// through materializeFunction().
+    bool LazyLoadFunctions;
+
+    /// In lazy-loading mode, maps each deferred function to the location of
+    /// its body and its slot number if it is unnamed.
+    std::map<Function *, std::pair<LocTy, int>> DeferredFunctionInfo;
+
+    /// Set once the initial top-level parse has finished.  Functions
+    /// materialized after this point run the per-function cleanups that
+    /// validateEndOfModule performs for eagerly parsed bodies.
+    bool ParsedAllTopLevelEntities = false;
+
     std::string SourceFileName;
 
   public:
     LLParser(StringRef F, SourceMgr &SM, SMDiagnostic &Err, Module *M,
              ModuleSummaryIndex *Index, LLVMContext &Context,
-             SlotMapping *Slots = nullptr)
+             SlotMapping *Slots = nullptr, bool LazyLoadFunctions = false)
         : Context(Context), OPLex(F, SM, Err, Context),
           Lex(F, SM, Err, Context), M(M), Index(Index), Slots(Slots),
-          BlockAddressPFS(nullptr) {}
+          BlockAddressPFS(nullptr), LazyLoadFunctions(LazyLoadFunctions) {}
     bool Run(
         bool UpgradeDebugInfo, DataLayoutCallbackTy DataLayoutCallback =
                                    [](StringRef) { return None; });
 
+    /// Parse the body of a function that was skipped during the initial lazy
+    /// parse.  This is a no-op for functions that have already been
+    /// materialized; the lexer position is preserved, so it is safe to call
+    /// while other entities are being parsed.
+    bool materializeFunction(Function &F);
+
+    /// Parse all function bodies that are still deferred and run the
+    /// module-level upgrades that validateEndOfModule skips in lazy mode.
+    bool materializeModule();
+
+    /// Return the identified struct types created while parsing, for use by
+    /// GVMaterializer clients such as the IRMover.
+    std::vector<StructType *> getIdentifiedStructTypes() const;
+
     bool parseStandaloneConstantValue(Constant *&C, const SlotMapping *Slots);
 
     bool parseTypeAtBeginning(Type *&Ty, unsigned &Read,
@@ -300,6 +329,9 @@ namespace llvm {
     // Top-Level Entities
     bool parseTopLevelEntities();
     bool validateEndOfModule(bool UpgradeDebugInfo);
+    void resolveForwardRefAttrGroups();
+    bool resolveDeferredBlockAddresses();
+    bool parseDeferredFunctionBodies();
     bool validateEndOfIndex();
     bool parseTargetDefinitions();
     bool parseTargetDefinition();
@@ -554,7 +586,8 @@ namespace llvm {
     };
     bool parseArgumentList(SmallVectorImpl<ArgInfo> &ArgList, bool &IsVarArg);
     bool parseFunctionHeader(Function *&Fn, bool IsDefine);
-    bool parseFunctionBody(Function &Fn);
+    bool parseFunctionBody(Function &Fn, int FunctionNumber);
+    bool skipFunctionBody(Function &Fn, int FunctionNumber);
     bool parseBasicBlock(PerFunctionState &PFS);
 
     enum TailCallType { TCT_None, TCT_Tail, TCT_MustTail };
@@ -23,6 +23,7 @@ namespace llvm {
 
 class Constant;
 class LLVMContext;
+class MemoryBuffer;
 class MemoryBufferRef;
 class Module;
 class ModuleSummaryIndex;
@@ -64,6 +65,30 @@ std::unique_ptr<Module> parseAssemblyString(StringRef AsmString,
                                             LLVMContext &Context,
                                             SlotMapping *Slots = nullptr);
 
+/// Parse LLVM Assembly from a MemoryBuffer, lazily deferring function bodies.
+///
+/// This is the textual analogue of getLazyBitcodeModule: the initial parse
+/// indexes function bodies without constructing their instructions, and the
+/// returned Module owns a GVMaterializer that parses each body the first time
+/// it is needed.  Intrinsic and debug info upgrades that must see the parsed
+/// bodies are deferred as well, so the Module has to be fully materialized
+/// before it is verified or written out.
+/// \param F The MemoryBuffer containing assembly; ownership is transferred to
+///          the returned Module.
+/// \param Err Error result info.
+/// \param Context Context in which to allocate globals info.
+std::unique_ptr<Module> parseAssemblyLazy(std::unique_ptr<MemoryBuffer> F,
+                                          SMDiagnostic &Err,
+                                          LLVMContext &Context);
+
+/// parseAssemblyLazy wrapper that reads the assembly from a file.
+/// \param Filename The name of the file to parse
+/// \param Err Error result info.
+/// \param Context Context in which to allocate globals info.
+std::unique_ptr<Module> parseAssemblyFileLazy(StringRef Filename,
+                                              SMDiagnostic &Err,
+                                              LLVMContext &Context);
+
 /// Holds the Module and ModuleSummaryIndex returned by the interfaces
 /// that parse both.
 struct ParsedModuleAndIndex {
@@ -35,6 +35,13 @@ class ModuleSummaryIndex;
 typedef llvm::function_ref<Optional<std::string>(StringRef)>
     DataLayoutCallbackTy;
 
+/// Filter applied while reading a module summary index: given a summary's
+/// GUID (GlobalValue::GUID), return true to materialize that summary. A
+/// default-constructed (null) filter materializes everything. Summaries the
+/// filter rejects are decoded just far enough to be skipped, so thin links
+/// that only resolve a subset of GUIDs avoid building the rest.
+typedef llvm::function_ref<bool(uint64_t)> SummaryGUIDFilterTy;
+
   // These functions are for converting Expected/Error values to
   // ErrorOr/std::error_code for compatibility with legacy clients. FIXME:
   // Remove these functions once no longer needed by the C and libLTO APIs.
@@ -113,12 +120,15 @@ typedef llvm::function_ref<Optional<std::string>(StringRef)>
     Expected<BitcodeLTOInfo> getLTOInfo();
 
     /// Parse the specified bitcode buffer, returning the module summary index.
-    Expected<std::unique_ptr<ModuleSummaryIndex>> getSummary();
+    /// Summaries whose GUID \p GUIDFilter rejects are skipped.
+    Expected<std::unique_ptr<ModuleSummaryIndex>>
+    getSummary(SummaryGUIDFilterTy GUIDFilter = {});
 
     /// Parse the specified bitcode buffer and merge its module summary index
-    /// into CombinedIndex.
+    /// into CombinedIndex. Summaries whose GUID \p GUIDFilter rejects are
+    /// skipped.
     Error readSummary(ModuleSummaryIndex &CombinedIndex, StringRef ModulePath,
-                      uint64_t ModuleId);
+                      uint64_t ModuleId, SummaryGUIDFilterTy GUIDFilter = {});
   };
 
   struct BitcodeFileContents {
@@ -179,13 +189,19 @@ typedef llvm::function_ref<Optional<std::string>(StringRef)>
   Expected<BitcodeLTOInfo> getBitcodeLTOInfo(MemoryBufferRef Buffer);
 
   /// Parse the specified bitcode buffer, returning the module summary index.
+  /// If \p GUIDFilter is non-null, only summaries whose GUID it accepts are
+  /// materialized (the index still records every value GUID seen).
   Expected<std::unique_ptr<ModuleSummaryIndex>>
-  getModuleSummaryIndex(MemoryBufferRef Buffer);
+  getModuleSummaryIndex(MemoryBufferRef Buffer,
+                        SummaryGUIDFilterTy GUIDFilter = {});
 
   /// Parse the specified bitcode buffer and merge the index into CombinedIndex.
+  /// If \p GUIDFilter is non-null, only summaries whose GUID it accepts are
+  /// merged.
   Error readModuleSummaryIndex(MemoryBufferRef Buffer,
                                ModuleSummaryIndex &CombinedIndex,
-                               uint64_t ModuleId);
+                               uint64_t ModuleId,
+                               SummaryGUIDFilterTy GUIDFilter = {});
 
   /// Parse the module summary index out of an IR file and return the module
   /// summary index object if found, or an empty summary if not. If Path refers
@@ -9,7 +9,9 @@
 #ifndef LLVM_CAS_CASACTIONCACHE_H
 #define LLVM_CAS_CASACTIONCACHE_H
 
+#include "llvm/ADT/FunctionExtras.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/CAS/CASReference.h"
 #include "llvm/Support/Error.h"
@@ -67,6 +69,31 @@ public:
   Expected<ObjectRef> getOrCompute(const CacheKey &ActionKey,
                                    function_ref<Expected<ObjectRef>()> Compute);
 
+  /// Get previously computed results for a group of keys in one call.
+  /// Returns one (optional) result per key, in order.
+  Expected<SmallVector<Optional<ObjectRef>, 0>>
+  getBatch(ArrayRef<CacheKey> ActionKeys) const;
+
+  /// Cache a group of key/result pairs in one call.
+  ///
+  /// Backends that pay a per-put durability cost (e.g. a synchronous on-disk
+  /// transaction) can override \a putBatchImpl() to amortize it across the
+  /// whole group. Failures for individual entries are joined into the
+  /// returned error; the remaining entries are still written.
+  ///
+  /// \pre ActionKeys and Results have the same size.
+  Error putBatch(ArrayRef<CacheKey> ActionKeys, ArrayRef<ObjectRef> Results);
+
+  /// Fire-and-forget flavor of \a putBatch(): \p OnDone is called with the
+  /// batch's (joined) error once all entries are durable. The base
+  /// implementation completes synchronously before returning; backends with
+  /// an asynchronous write path can override \a putBatchAsyncImpl() to
+  /// return immediately and complete in the background.
+  ///
+  /// \pre ActionKeys and Results have the same size.
+  void putBatchAsync(ArrayRef<CacheKey> ActionKeys, ArrayRef<ObjectRef> Results,
+                     unique_function<void(Error)> OnDone);
+
   virtual ~ActionCache() = default;
 
 protected:
@@ -75,6 +102,17 @@ protected:
   virtual Error putImpl(ArrayRef<uint8_t> ResolvedKey,
                         const ObjectRef &Result) = 0;
 
+  /// Batch entry points, overridable so backends can amortize per-call costs
+  /// (durability, round-trips) across a group of entries. The base
+  /// implementations simply loop over \a getImpl() / \a putImpl().
+  virtual Expected<SmallVector<Optional<ObjectRef>, 0>>
+  getBatchImpl(ArrayRef<CacheKey> ActionKeys) const;
+  virtual Error putBatchImpl(ArrayRef<CacheKey> ActionKeys,
+                             ArrayRef<ObjectRef> Results);
+  virtual void putBatchAsyncImpl(ArrayRef<CacheKey> ActionKeys,
+                                 ArrayRef<ObjectRef> Results,
+                                 unique_function<void(Error)> OnDone);
+
   ActionCache(ObjectStore &CAS) : CAS(CAS) {}
 
   ObjectStore &getCAS() const { return CAS; }
@@ -13,6 +13,7 @@
 #include "llvm/ADT/FunctionExtras.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/CAS/CASReference.h"
 #include "llvm/CAS/HashMappedTrie.h"
 #include "llvm/CAS/ThreadSafeAllocator.h"
@@ -344,6 +345,22 @@ public:
   }
 
   void add(DirectoryEntry &Entry) { Entries.insert(&Entry); }
+
+  /// Returns true if \p Name was previously looked up and found to be absent.
+  /// Only meaningful while the directory is incomplete; complete directories
+  /// answer misses from the entries themselves.
+  bool isKnownMissing(StringRef Name) const {
+    return NegativeEntries.contains(Name);
+  }
+
+  /// Record that \p Name is absent so later lookups can fail without
+  /// reloading the backing tree. Requires a Writer lock, like add().
+  void addNegative(StringRef Name) { NegativeEntries.insert(Name); }
+
+  /// Drop the negative-lookup cache. Called when the directory becomes
+  /// complete, at which point the cache is redundant.
+  void clearNegatives() { NegativeEntries.clear(); }
+
   void getKnownEntries(SmallVectorImpl<DirectoryEntry *> &Result) const {
     Result.resize(Entries.size());
     llvm::copy(Entries, Result.begin());
@@ -371,6 +388,7 @@ private:
   std::atomic<bool> IsWriting;
   std::atomic<int> NumReaders;
   DenseSet<DirectoryEntry *, DirectoryListingInfo> Entries;
+  StringSet<> NegativeEntries;
   sys::fs::UniqueID UniqueID;
 };
 
@@ -17,6 +17,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h" // FIXME: Split out sys::fs::file_status.
 #include <cstddef>
+#include <memory>
 
 namespace llvm {
 
@@ -354,6 +355,17 @@ std::unique_ptr<ObjectStore> createInMemoryCAS();
 /// client should handle this logic, if/when desired.
 Expected<std::unique_ptr<ObjectStore>> createOnDiskCAS(const Twine &Path);
 
+/// Create an ObjectStore that layers \p LocalCAS in front of \p UpstreamCAS.
+///
+/// Stores are written through to both layers. Loads that miss \p LocalCAS
+/// ingest the requested object and its transitive closure from \p UpstreamCAS
+/// into \p LocalCAS, so repeated scans of shared content only pay the
+/// (potentially remote) upstream cost once. Both stores must use the same
+/// hash schema.
+Expected<std::unique_ptr<ObjectStore>>
+createWriteThroughCAS(std::shared_ptr<ObjectStore> LocalCAS,
+                      std::shared_ptr<ObjectStore> UpstreamCAS);
+
 /// Set \p Path to a reasonable default on-disk path for a persistent CAS for
 /// the current user.
 void getDefaultOnDiskCASPath(SmallVectorImpl<char> &Path);
@@ -12,10 +12,12 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MathExtras.h"
 #include <atomic>
 #include <mutex>
 
@@ -307,6 +309,93 @@ private:
   std::unique_ptr<ImplType> Impl;
 };
 
+/// Sharded variant of \a OnDiskHashMappedTrie.
+///
+/// Splits one logical trie into 2^NumShardBits independent sub-tries selected
+/// by the top bits of the hash. Each shard lives in its own database file with
+/// its own mapped region and bump-ptr allocation path, so concurrent \a
+/// insertLazy() calls that land in different shards do not contend on a shared
+/// allocator. With normally-distributed hashes (the expected use), parallel
+/// ingestion spreads evenly across shards.
+///
+/// \a FileOffset values are local to a shard; recover them through the shard
+/// returned by \a getShard() for the same hash.
+class ShardedOnDiskHashMappedTrie {
+public:
+  using ConstValueProxy = OnDiskHashMappedTrie::ConstValueProxy;
+  using ValueProxy = OnDiskHashMappedTrie::ValueProxy;
+  using const_pointer = OnDiskHashMappedTrie::const_pointer;
+  using pointer = OnDiskHashMappedTrie::pointer;
+  using LazyInsertOnConstructCB = OnDiskHashMappedTrie::LazyInsertOnConstructCB;
+  using LazyInsertOnLeakCB = OnDiskHashMappedTrie::LazyInsertOnLeakCB;
+
+  size_t getNumShards() const { return Shards.size(); }
+
+  /// Get the shard responsible for \p Hash.
+  OnDiskHashMappedTrie &getShard(ArrayRef<uint8_t> Hash) {
+    return Shards[getShardIndex(Hash)];
+  }
+  const OnDiskHashMappedTrie &getShard(ArrayRef<uint8_t> Hash) const {
+    return Shards[getShardIndex(Hash)];
+  }
+
+  /// Get shard \p I. Useful for iterating over all shards.
+  OnDiskHashMappedTrie &getShard(size_t I) { return Shards[I]; }
+  const OnDiskHashMappedTrie &getShard(size_t I) const { return Shards[I]; }
+
+  const_pointer find(ArrayRef<uint8_t> Hash) const {
+    return getShard(Hash).find(Hash);
+  }
+  pointer find(ArrayRef<uint8_t> Hash) { return getShard(Hash).find(Hash); }
+
+  pointer insertLazy(const_pointer Hint, ArrayRef<uint8_t> Hash,
+                     LazyInsertOnConstructCB OnConstruct = nullptr,
+                     LazyInsertOnLeakCB OnLeak = nullptr) {
+    return getShard(Hash).insertLazy(Hint, Hash, OnConstruct, OnLeak);
+  }
+  pointer insertLazy(ArrayRef<uint8_t> Hash,
+                     LazyInsertOnConstructCB OnConstruct = nullptr,
+                     LazyInsertOnLeakCB OnLeak = nullptr) {
+    return insertLazy(const_pointer(), Hash, OnConstruct, OnLeak);
+  }
+
+  pointer insert(const ConstValueProxy &Value) {
+    return getShard(Value.Hash).insert(Value);
+  }
+
+  /// Gets or creates the shard files "<Path>.shard.<N>", each holding an \a
+  /// OnDiskHashMappedTrie named \p TrieName; see \a
+  /// OnDiskHashMappedTrie::create() for the remaining parameters, which apply
+  /// to each shard individually (in particular, \p MaxFileSize limits each
+  /// shard's file).
+  ///
+  /// \pre NumShardBits is no bigger than 8, so the shard is selected by the
+  /// hash's top byte.
+  static Expected<ShardedOnDiskHashMappedTrie>
+  create(const Twine &Path, const Twine &TrieName, size_t NumShardBits,
+         size_t NumHashBits, uint64_t DataSize, uint64_t MaxFileSize,
+         Optional<uint64_t> NewFileInitialSize,
+         Optional<size_t> NewTableNumRootBits = None,
+         Optional<size_t> NewTableNumSubtrieBits = None);
+
+  ShardedOnDiskHashMappedTrie(ShardedOnDiskHashMappedTrie &&RHS) = default;
+  ShardedOnDiskHashMappedTrie &
+  operator=(ShardedOnDiskHashMappedTrie &&RHS) = default;
+
+private:
+  explicit ShardedOnDiskHashMappedTrie(
+      SmallVector<OnDiskHashMappedTrie, 16> Shards)
+      : Shards(std::move(Shards)) {}
+
+  size_t getShardIndex(ArrayRef<uint8_t> Hash) const {
+    assert(!Hash.empty() && "Expected a hash");
+    // Shards.size() is a power of 2; select the top bits of the top byte.
+    return Hash[0] >> (8 - Log2_64(Shards.size()));
+  }
+
+  SmallVector<OnDiskHashMappedTrie, 16> Shards;
+};
+
 /// Sink for data. Stores variable length data with 8-byte alignment. Does not
 /// track size of data, which is assumed to known from context, or embedded.
 /// Uses 0-padding but does not guarantee 0-termination.
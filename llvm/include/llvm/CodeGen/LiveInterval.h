@@ -479,6 +479,13 @@ namespace llvm {
     /// may have grown since it was inserted).
     iterator addSegment(Segment S);
 
+    /// Add all of \p Segments to this range in a single pass, merging
+    /// segments as appropriate. The segments may be given in any order.
+    /// This is equivalent to calling addSegment() on each element but avoids
+    /// repeatedly shifting the segment vector, which matters for the update
+    /// storms the coalescer produces on large live ranges.
+    void addSegments(ArrayRef<Segment> Segments);
+
     /// Attempt to extend a value defined after @p StartIdx to include @p Use.
     /// Both @p StartIdx and @p Use should be in the same basic block. In case
     /// of subranges, an extension could be prevented by an explicit "undef"
@@ -45,6 +45,10 @@ class LiveRegMatrix : public MachineFunctionPass {
   // UserTag changes whenever virtual registers have been modified.
   unsigned UserTag = 0;
 
+  // ModificationCount increments whenever the matrix contents change, i.e. on
+  // every assignment and eviction.
+  uint64_t ModificationCount = 0;
+
   // The matrix is represented as a LiveIntervalUnion per register unit.
   LiveIntervalUnion::Allocator LIUAlloc;
   LiveIntervalUnion::Array Matrix;
@@ -80,6 +84,13 @@ public:
   /// caches are invalidated.
   void invalidateVirtRegs() { ++UserTag; }
 
+  /// Return a counter that increments every time the matrix contents change,
+  /// i.e. when a virtual register is assigned or unassigned. Clients may use
+  /// it to invalidate caches of interference results. Unlike the user tag,
+  /// this does not change between allocation rounds that leave the matrix
+  /// untouched.
+  uint64_t getModificationCount() const { return ModificationCount; }
+
   enum InterferenceKind {
     /// No interference, go ahead and assign.
     IK_Free = 0,
@@ -338,6 +338,16 @@ public:
   }
 };
 
+/// A pressure set paired with the pressure values it held before a speculative
+/// query. RegPressureTracker logs one of these for every pressure set entry
+/// changed by bumpUpwardPressure/bumpDownwardPressure so the query can be
+/// rolled back without replaying the region.
+struct PressureSnapshotEntry {
+  unsigned PSet;
+  unsigned CurrPressure;
+  unsigned MaxPressure;
+};
+
 /// Track the current register pressure at some position in the instruction
 /// stream, and remember the high water mark within the region traversed. This
 /// does not automatically consider live-through ranges. The client may
@@ -393,6 +403,13 @@ class RegPressureTracker {
   /// Live-through pressure.
   std::vector<unsigned> LiveThruPressure;
 
+  /// Prior values of the pressure sets changed by an in-flight speculative
+  /// query, in mutation order. Empty unless SnapshotActive.
+  SmallVector<PressureSnapshotEntry, 8> SnapshotLog;
+
+  /// True while a speculative query is logging pressure changes.
+  bool SnapshotActive = false;
+
 public:
   RegPressureTracker(IntervalPressure &rp) : P(rp), RequireIntervals(true) {}
   RegPressureTracker(RegionPressure &rp) : P(rp), RequireIntervals(false) {}
@@ -557,6 +574,17 @@ protected:
   void bumpUpwardPressure(const MachineInstr *MI);
   void bumpDownwardPressure(const MachineInstr *MI);
 
+  /// Start logging pressure changes so a speculative query can be rolled back
+  /// in time proportional to the number of pressure sets it changes.
+  void beginPressureSnapshot();
+
+  /// Return the sets changed since beginPressureSnapshot() in ascending PSet
+  /// order, each with the pressure values it held when the snapshot began.
+  ArrayRef<PressureSnapshotEntry> pressureSnapshotChanges();
+
+  /// Undo all pressure changes logged since beginPressureSnapshot().
+  void rollbackPressureSnapshot();
+
   void discoverLiveInOrOut(RegisterMaskPair Pair,
                            SmallVectorImpl<RegisterMaskPair> &LiveInOrOut);
 
@@ -158,6 +158,15 @@ namespace llvm {
     /// scheduling region is mapped to an SUnit.
     DenseMap<MachineInstr*, SUnit*> MISUnitMap;
 
+    /// Cursor into the SUnit pool. Slots below SUnits.size() are left over
+    /// from the previous region and get overwritten by newSUnit() instead of
+    /// deallocated, which reuses their heap-allocated edge vectors.
+    unsigned NextSUnit = 0;
+
+    /// Average number of edges per node in the previous region, used to
+    /// pre-size the edge vectors of SUnits created from scratch.
+    unsigned PrevRegionAvgEdges = 0;
+
     // State internal to DAG building.
     // -------------------------------
 
@@ -363,6 +372,7 @@ namespace llvm {
 
   protected:
     void initSUnits();
+    void resetDAGForRegion();
     void addPhysRegDataDeps(SUnit *SU, unsigned OperIdx);
     void addPhysRegDeps(SUnit *SU, unsigned OperIdx);
     void addVRegDefDeps(SUnit *SU, unsigned OperIdx);
@@ -378,13 +388,29 @@ namespace llvm {
 
   /// Creates a new SUnit and return a ptr to it.
   inline SUnit *ScheduleDAGInstrs::newSUnit(MachineInstr *MI) {
+    if (NextSUnit < SUnits.size()) {
+      // Recycle a slot left over from the previous region. Assigning over it
+      // reuses the slot's heap-allocated edge vectors, since SmallVector
+      // assignment never shrinks capacity.
+      SUnit &SU = SUnits[NextSUnit];
+      SU = SUnit(MI, NextSUnit);
+      ++NextSUnit;
+      return &SU;
+    }
 #ifndef NDEBUG
     const SUnit *Addr = SUnits.empty() ? nullptr : &SUnits[0];
 #endif
     SUnits.emplace_back(MI, (unsigned)SUnits.size());
     assert((Addr == nullptr || Addr == &SUnits[0]) &&
            "SUnits std::vector reallocated on the fly!");
-    return &SUnits.back();
+    SUnit &SU = SUnits.back();
+    // Pre-size the edge vectors based on the previous region's edge density.
+    if (PrevRegionAvgEdges > SU.Preds.capacity()) {
+      SU.Preds.reserve(PrevRegionAvgEdges);
+      SU.Succs.reserve(PrevRegionAvgEdges);
+    }
+    ++NextSUnit;
+    return &SU;
   }
 
   /// Returns an existing SUnit for this MI, or nullptr.
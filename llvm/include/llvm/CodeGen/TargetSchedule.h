@@ -37,6 +37,11 @@ class TargetSchedModel {
 
   SmallVector<unsigned, 16> ResourceFactors;
 
+  // Flattened per-scheduling-class latency, filled in lazily from the write
+  // latency entries. The scheduler resolves the same classes over and over;
+  // ~0u marks a class that has not been computed yet.
+  mutable SmallVector<unsigned, 0> SchedClassLatencies;
+
   // Multiply to normalize microops to resource units.
   unsigned MicroOpFactor = 0;
 
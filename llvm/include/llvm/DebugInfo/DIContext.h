@@ -198,6 +198,9 @@ struct DIDumpOptions {
   bool SummarizeTypes = false;
   bool Verbose = false;
   bool DisplayRawContents = false;
+  /// When verifying, only run the per-unit checks and skip the expensive
+  /// cross-unit DIE reference verification.
+  bool VerifyQuick = false;
 
   /// Return default option set for printing a single DIE without children.
   static DIDumpOptions getForSingleDIE() {
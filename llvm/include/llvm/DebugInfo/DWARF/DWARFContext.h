@@ -91,7 +91,13 @@ class DWARFContext : public DIContext {
   /// Read compile units from the debug_info section (if necessary)
   /// and type units from the debug_types sections (if necessary)
   /// and store them in NormalUnits.
-  void parseNormalUnits();
+  /// If \p Lazy is true, only build an index of the unit boundaries in the
+  /// debug_info section; units are materialized on demand by offset-keyed
+  /// lookups, and the debug_types sections are left untouched until a full
+  /// parse is requested.
+  void parseNormalUnits(bool Lazy = false);
+  bool NormalUnitsParsed = false;
+  bool NormalUnitsLazyIndexed = false;
 
   /// Read compile units from the debug_info.dwo section (if necessary)
   /// and type units from the debug_types.dwo section (if necessary)
@@ -9,6 +9,7 @@
 #ifndef LLVM_DEBUGINFO_DWARF_DWARFDEBUGLINE_H
 #define LLVM_DEBUGINFO_DWARF_DWARFDEBUGLINE_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Dwarf.h"
@@ -254,12 +255,13 @@ public:
     /// In Dwarf 4, the files are 1-indexed and the current compilation file
     /// name is not represented in the list. In DWARF v5, the files are
     /// 0-indexed and the primary source file has the index 0.
+    /// Unlike the raw Prologue method, materialized paths are cached and
+    /// shared between queries, since symbolizing many addresses in a unit
+    /// resolves the same few file indices over and over.
     /// Returns true on success.
     bool getFileNameByIndex(uint64_t FileIndex, StringRef CompDir,
                             DILineInfoSpecifier::FileLineInfoKind Kind,
-                            std::string &Result) const {
-      return Prologue.getFileNameByIndex(FileIndex, CompDir, Kind, Result);
-    }
+                            std::string &Result) const;
 
     /// Fills the Result argument with the file and line information
     /// corresponding to Address. Returns true on success.
@@ -297,6 +299,15 @@ public:
 
     bool lookupAddressRangeImpl(object::SectionedAddress Address, uint64_t Size,
                                 std::vector<uint32_t> &Result) const;
+
+    /// Paths materialized by getFileNameByIndex(), keyed by file index. The
+    /// cache is only valid for one (CompDir, Kind) combination at a time --
+    /// in practice both are fixed for a given unit -- and is rebuilt when
+    /// either changes.
+    mutable DenseMap<uint64_t, std::string> PathCache;
+    mutable std::string PathCacheCompDir;
+    mutable DILineInfoSpecifier::FileLineInfoKind PathCacheKind =
+        DILineInfoSpecifier::FileLineInfoKind::None;
   };
 
   const LineTable *getLineTable(uint64_t Offset) const;
@@ -127,6 +127,10 @@ class DWARFUnitVector final : public SmallVector<std::unique_ptr<DWARFUnit>, 1>
                                            const DWARFUnitIndex::Entry *)>
       Parser;
   int NumInfoUnits = -1;
+  /// Start offsets of the units in a lazily indexed .debug_info section, in
+  /// section order. Populated by addUnitsForSection when \p Lazy is set;
+  /// units are materialized on demand by the non-const getUnitForOffset.
+  SmallVector<uint64_t, 0> LazyUnitOffsets;
 
 public:
   using UnitVector = SmallVectorImpl<std::unique_ptr<DWARFUnit>>;
@@ -137,14 +141,21 @@ public:
       decltype(make_filter_range(std::declval<iterator_range>(), isCompileUnit));
 
   DWARFUnit *getUnitForOffset(uint64_t Offset) const;
+  /// Like the const overload, but when the section was added with \p Lazy set,
+  /// materializes the unit containing \p Offset on demand using the boundary
+  /// index.
+  DWARFUnit *getUnitForOffset(uint64_t Offset);
   DWARFUnit *getUnitForIndexEntry(const DWARFUnitIndex::Entry &E);
 
   /// Read units from a .debug_info or .debug_types section.  Calls made
   /// before finishedInfoUnits() are assumed to be for .debug_info sections,
   /// calls after finishedInfoUnits() are for .debug_types sections.  Caller
   /// must not mix calls to addUnitsForSection and addUnitsForDWOSection.
+  /// If \p Lazy is true, only an index of unit boundaries is built by reading
+  /// the initial length field of each unit header; full header parsing and
+  /// unit construction are deferred until a unit is requested by offset.
   void addUnitsForSection(DWARFContext &C, const DWARFSection &Section,
-                          DWARFSectionKind SectionKind);
+                          DWARFSectionKind SectionKind, bool Lazy = false);
   /// Read units from a .debug_info.dwo or .debug_types.dwo section.  Calls
   /// made before finishedInfoUnits() are assumed to be for .debug_info.dwo
   /// sections, calls after finishedInfoUnits() are for .debug_types.dwo
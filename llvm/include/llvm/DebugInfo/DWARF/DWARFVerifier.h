@@ -155,6 +155,11 @@ private:
   ///
   /// \returns The number of errors that occurred during verification.
   unsigned verifyUnitSection(const DWARFSection &S);
+
+  /// Verifies the contents of all units in \p Units. Units are verified
+  /// concurrently on a thread pool, with each unit's diagnostics buffered and
+  /// emitted in unit order. Cross-unit DIE references are verified at the end
+  /// unless DumpOpts.VerifyQuick is set.
   unsigned verifyUnits(const DWARFUnitVector &Units);
 
   unsigned verifyIndexes(const DWARFObject &DObj);
@@ -188,6 +188,12 @@ private:
   /// Update the LRU cache order when a binary is accessed.
   void recordAccess(CachedBinary &Bin);
 
+  /// Returns DemangleName(Name, DbiModuleDescriptor), memoizing the result.
+  /// Batch symbolization sees the same mangled names over and over; demangling
+  /// each occurrence from scratch dominates the per-frame cost.
+  std::string demangleNameCached(const std::string &Name,
+                                 const SymbolizableModule *DbiModuleDescriptor);
+
   std::map<std::string, std::unique_ptr<SymbolizableModule>, std::less<>>
       Modules;
   StringMap<std::string> BuildIDPaths;
@@ -209,6 +215,10 @@ private:
   std::map<std::pair<std::string, std::string>, std::unique_ptr<ObjectFile>>
       ObjectForUBPathAndArch;
 
+  /// Contains cached results of demangleNameCached(). Microsoft-mangled names
+  /// are not cached because their demangling depends on the module.
+  StringMap<std::string> DemangledNames;
+
   Options Opts;
 
   SmallVector<std::unique_ptr<DIFetcher>> DIFetchers;
@@ -245,6 +255,15 @@ private:
 
 Optional<ArrayRef<uint8_t>> getBuildID(const ELFObjectFileBase *Obj);
 
+/// Opt in to symbolizing crash stack traces in-process (see
+/// sys::setInProcessSymbolizer) instead of launching an external
+/// llvm-symbolizer binary, and pre-warm the main executable's debug info so
+/// the first crash report does not pay for parsing it. In-process
+/// symbolization keeps working when the crashing process can no longer exec,
+/// e.g. under resource exhaustion. Idempotent; the symbolizer it installs
+/// lives until process exit.
+void enableInProcessSymbolization();
+
 } // end namespace symbolize
 } // end namespace llvm
 
@@ -52,6 +52,11 @@ Expected<std::string> getDefaultDebuginfodCacheDirectory();
 /// DEBUGINFOD_TIMEOUT environment variable, default is 90 seconds (90000 ms).
 std::chrono::milliseconds getDefaultDebuginfodTimeout();
 
+/// Finds the default number of concurrent connections used to download an
+/// artifact whose server supports HTTP range requests. Checks the
+/// DEBUGINFOD_CONNECTIONS environment variable, default is 4.
+unsigned getDefaultDebuginfodConnections();
+
 /// Fetches a specified source file by searching the default local cache
 /// directory and server URLs.
 Expected<std::string> getCachedOrDownloadSource(BuildIDRef ID,
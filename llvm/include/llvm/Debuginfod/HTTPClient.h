@@ -27,6 +27,9 @@ enum class HTTPMethod { GET };
 /// A stateless description of an outbound HTTP request.
 struct HTTPRequest {
   SmallString<128> Url;
+  /// Additional headers to send with the request, each a full "Name: Value"
+  /// line, e.g. "Range: bytes=0-1023".
+  SmallVector<std::string, 0> Headers;
   HTTPMethod Method = HTTPMethod::GET;
   bool FollowRedirects = true;
   HTTPRequest(StringRef Url);
@@ -39,6 +42,12 @@ bool operator==(const HTTPRequest &A, const HTTPRequest &B);
 /// of its methods.
 class HTTPResponseHandler {
 public:
+  /// Processes one line of the HTTP response header, including its trailing
+  /// newline. Called once per header line before any body chunk is handled.
+  virtual Error handleHeaderLine(StringRef HeaderLine) {
+    return Error::success();
+  }
+
   /// Processes an additional chunk of bytes of the HTTP response body.
   virtual Error handleBodyChunk(StringRef BodyChunk) = 0;
 
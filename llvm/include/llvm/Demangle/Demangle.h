@@ -82,9 +82,13 @@ struct ItaniumPartialDemangler {
   ItaniumPartialDemangler &operator=(ItaniumPartialDemangler &&Other);
 
   /// Demangle into an AST. Subsequent calls to the rest of the member functions
-  /// implicitly operate on the AST this produces.
+  /// implicitly operate on the AST this produces. The parser arena is reused
+  /// between calls, so a long-lived demangler amortizes allocations across
+  /// many names. With \p ParseParams == false the function signature is not
+  /// parsed at all: the name queries below still work, but the parameter,
+  /// return type and function qualifier queries come back empty.
   /// \return true on error, false otherwise
-  bool partialDemangle(const char *MangledName);
+  bool partialDemangle(const char *MangledName, bool ParseParams = true);
 
   /// Just print the entire mangled name into Buf. Buf and N behave like the
   /// second and third parameters to itaniumDemangle.
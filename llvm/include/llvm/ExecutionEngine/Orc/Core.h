@@ -24,6 +24,7 @@
 #include "llvm/ExecutionEngine/Orc/TaskDispatch.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ExtensibleRTTI.h"
+#include "llvm/Support/MSVCErrorWorkarounds.h"
 
 #include <atomic>
 #include <future>
@@ -1532,6 +1533,24 @@ public:
                              RegisterDependenciesFunction RegisterDependencies =
                                  NoDependenciesToRegister);
 
+  /// Future-returning version of the asynchronous lookup above. The calling
+  /// thread is not blocked: materialization proceeds via the session's
+  /// dispatcher, and the returned future becomes ready once all requested
+  /// symbols reach the required state (or an error occurs). This lets clients
+  /// overlap other work with a cold lookup and only synchronize at the point
+  /// of use. Clients that want continuation-style chaining instead of a
+  /// future should use the callback-based lookup overload directly.
+  ///
+  /// Note that if the session dispatches tasks in-place (e.g. with the
+  /// default InPlaceTaskDispatcher on a single thread) the future will
+  /// already be ready when this function returns.
+  std::future<MSVCPExpected<SymbolMap>>
+  lookupAsync(const JITDylibSearchOrder &SearchOrder, SymbolLookupSet Symbols,
+              LookupKind K = LookupKind::Static,
+              SymbolState RequiredState = SymbolState::Ready,
+              RegisterDependenciesFunction RegisterDependencies =
+                  NoDependenciesToRegister);
+
   /// Convenience version of blocking lookup.
   /// Searches each of the JITDylibs in the search order in turn for the given
   /// symbol.
@@ -80,9 +80,14 @@ public:
 
 class InProcessMemoryMapper : public MemoryMapper {
 public:
-  InProcessMemoryMapper(size_t PageSize);
+  /// If \p UseHugePages is true, reservations are requested with
+  /// sys::Memory::MF_HUGE_HINT so the OS can back the slab with huge pages
+  /// where supported. This reduces TLB pressure for JITs that emit many small
+  /// functions; it is only a hint and small pages remain the fallback.
+  InProcessMemoryMapper(size_t PageSize, bool UseHugePages = false);
 
-  static Expected<std::unique_ptr<InProcessMemoryMapper>> Create();
+  static Expected<std::unique_ptr<InProcessMemoryMapper>>
+  Create(bool UseHugePages = false);
 
   unsigned int getPageSize() override { return PageSize; }
 
@@ -118,6 +123,7 @@ private:
   AllocationMap Allocations;
 
   size_t PageSize;
+  bool UseHugePages;
 };
 
 class SharedMemoryMapper final : public MemoryMapper {
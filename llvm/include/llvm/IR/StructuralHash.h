@@ -1,4 +1,4 @@
-//===- llvm/IR/StructuralHash.h - IR Hash for expensive checks --*- C++ -*-===//
+//===- llvm/IR/StructuralHash.h - IR Hashing --------------------*- C++ -*-===//
 //
 // Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
 // See https://llvm.org/LICENSE.txt for license information.
@@ -7,28 +7,34 @@
 //===----------------------------------------------------------------------===//
 //
 // This file provides hashing of the LLVM IR structure to be used to check
-// Passes modification status.
+// Passes modification status, and to key content-addressed caches on
+// function bodies.
 //
 //===----------------------------------------------------------------------===//
 
 #ifndef LLVM_IR_STRUCTURALHASH_H
 #define LLVM_IR_STRUCTURALHASH_H
 
-#ifdef EXPENSIVE_CHECKS
-
 #include <cstdint>
 
-// This header is only meant to be used when -DEXPENSIVE_CHECKS is set
 namespace llvm {
 
 class Function;
 class Module;
 
-uint64_t StructuralHash(const Function &F);
-uint64_t StructuralHash(const Module &M);
+/// Returns a hash of the function \p F.
+///
+/// By default only the control-flow skeleton and instruction opcodes are
+/// hashed, which is cheap and is what the pass managers' change detection
+/// uses. If \p DetailedHash is set, the hash also covers instruction and
+/// operand types, constant integer operands and callee names, making
+/// collisions between different function bodies far less likely; use this
+/// form when the hash keys a cache of per-function results.
+uint64_t StructuralHash(const Function &F, bool DetailedHash = false);
 
-} // end namespace llvm
+/// Returns a hash of the module \p M, combining the hashes of its functions.
+uint64_t StructuralHash(const Module &M, bool DetailedHash = false);
 
-#endif
+} // end namespace llvm
 
 #endif // LLVM_IR_STRUCTURALHASH_H
@@ -83,7 +83,17 @@ public:
 private:
   Module &Composite;
   IdentifiedStructTypeSet IdentifiedStructTypes;
-  MDMapT SharedMDs; ///< A Metadata map to use for all calls to \a move().
+  /// A Metadata map shared by all calls to \a move().
+  ///
+  /// Metadata mappings are accumulated here across source modules, so a
+  /// subtree that has already been mapped into the composite module (for
+  /// example a DICompileUnit reached again through an ODR-uniqued type) is
+  /// reused rather than cloned and remapped a second time. The map cannot be
+  /// shared more widely than a single IRMover: metadata nodes are owned by
+  /// the LLVMContext of the composite module and may still be RAUW'd while
+  /// later modules are linked, so the mappings are only meaningful for this
+  /// context and destination.
+  MDMapT SharedMDs;
 };
 
 } // End llvm namespace
@@ -29,8 +29,28 @@ namespace llvm {
 class MCAsmInfo;
 class MCContext;
 class MCSection;
+class MCSymbol;
 class raw_ostream;
 
+/// The entry value of MCContext's symbol table.  Keeping the uniqued symbol,
+/// the suffix counter used to disambiguate temporary names, and the "used"
+/// flag together in one map avoids hashing each symbol name several times.
+struct MCSymbolTableValue {
+  /// The symbol registered under the name, if any.
+  MCSymbol *Symbol = nullptr;
+
+  /// The next counter value to try when adding a numeric suffix to produce a
+  /// unique name for a temporary symbol.
+  unsigned NextUniqueID = 0;
+
+  /// Whether the name is used by a non-section symbol.  A section symbol does
+  /// not claim the name, so a non-section symbol registered later may still
+  /// take it over.
+  bool Used = false;
+};
+
+using MCSymbolTableEntry = StringMapEntry<MCSymbolTableValue>;
+
 /// MCSymbol - Instances of this class represent a symbol name in the MC file,
 /// and MCSymbols are created and uniqued by the MCContext class.  MCSymbols
 /// should only be constructed with valid names for the object file.
@@ -149,11 +169,11 @@ protected:
   /// system, the name is a pointer so isn't going to satisfy the 8 byte
   /// alignment of uint64_t.  Account for that here.
   using NameEntryStorageTy = union {
-    const StringMapEntry<bool> *NameEntry;
+    const MCSymbolTableEntry *NameEntry;
     uint64_t AlignmentPadding;
   };
 
-  MCSymbol(SymbolKind Kind, const StringMapEntry<bool> *Name, bool isTemporary)
+  MCSymbol(SymbolKind Kind, const MCSymbolTableEntry *Name, bool isTemporary)
       : IsTemporary(isTemporary), IsRedefinable(false), IsUsed(false),
         IsRegistered(false), IsExternal(false), IsPrivateExtern(false),
         Kind(Kind), IsUsedInReloc(false), SymbolContents(SymContentsUnset),
@@ -166,8 +186,7 @@ protected:
 
   // Provide custom new/delete as we will only allocate space for a name
   // if we need one.
-  void *operator new(size_t s, const StringMapEntry<bool> *Name,
-                     MCContext &Ctx);
+  void *operator new(size_t s, const MCSymbolTableEntry *Name, MCContext &Ctx);
 
 private:
   void operator delete(void *);
@@ -181,12 +200,12 @@ private:
   }
 
   /// Get a reference to the name field.  Requires that we have a name
-  const StringMapEntry<bool> *&getNameEntryPtr() {
+  const MCSymbolTableEntry *&getNameEntryPtr() {
     assert(FragmentAndHasName.getInt() && "Name is required");
     NameEntryStorageTy *Name = reinterpret_cast<NameEntryStorageTy *>(this);
     return (*(Name - 1)).NameEntry;
   }
-  const StringMapEntry<bool> *&getNameEntryPtr() const {
+  const MCSymbolTableEntry *&getNameEntryPtr() const {
     return const_cast<MCSymbol*>(this)->getNameEntryPtr();
   }
 
@@ -19,7 +19,7 @@ namespace llvm {
 
 class MCSymbolGOFF : public MCSymbol {
 public:
-  MCSymbolGOFF(const StringMapEntry<bool> *Name, bool IsTemporary)
+  MCSymbolGOFF(const MCSymbolTableEntry *Name, bool IsTemporary)
       : MCSymbol(SymbolKindGOFF, Name, IsTemporary) {}
   static bool classof(const MCSymbol *S) { return S->isGOFF(); }
 };
@@ -9,11 +9,13 @@
 #ifndef LLVM_MC_STRINGTABLEBUILDER_H
 #define LLVM_MC_STRINGTABLEBUILDER_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/CachedHashString.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 namespace llvm {
 
@@ -43,6 +45,8 @@ private:
 
   void finalizeStringTable(bool Optimize);
   void initSize();
+  size_t assignOffsets(ArrayRef<std::pair<CachedHashStringRef, size_t> *> Strings,
+                       size_t Base);
 
 public:
   StringTableBuilder(Kind K, unsigned Alignment = 1);
@@ -54,6 +58,14 @@ public:
   size_t add(CachedHashStringRef S);
   size_t add(StringRef S) { return add(CachedHashStringRef(S)); }
 
+  /// Add a batch of strings produced by one input shard. Equivalent to
+  /// calling add() on each element, but reserves space for the whole batch
+  /// up front. Intended for callers that collect strings per input file and
+  /// feed them to the builder as parsing completes rather than adding them
+  /// one at a time just before finalization. Positions are only meaningful
+  /// after finalize(), so unlike add() none are returned.
+  void add(ArrayRef<CachedHashStringRef> Shard);
+
   /// Analyze the strings and build the final table. No more strings can
   /// be added after this point.
   void finalize();
@@ -60,7 +60,8 @@ class Pipeline {
 
   /// An ordered list of stages that define this instruction pipeline.
   SmallVector<std::unique_ptr<Stage>, 8> Stages;
-  std::set<HWEventListener *> Listeners;
+  /// Listeners in registration order; addEventListener() ignores duplicates.
+  SmallVector<HWEventListener *, 8> Listeners;
   unsigned Cycles;
 
   Error runCycle();
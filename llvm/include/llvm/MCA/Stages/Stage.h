@@ -15,9 +15,10 @@
 #ifndef LLVM_MCA_STAGES_STAGE_H
 #define LLVM_MCA_STAGES_STAGE_H
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/MCA/HWEventListener.h"
 #include "llvm/Support/Error.h"
-#include <set>
 
 namespace llvm {
 namespace mca {
@@ -26,13 +27,16 @@ class InstRef;
 
 class Stage {
   Stage *NextInSequence;
-  std::set<HWEventListener *> Listeners;
+  /// Listeners in registration order. Notifications are emitted once per
+  /// cycle per event, so this is kept as a dense vector for fast iteration;
+  /// addListener() ignores duplicate registrations.
+  SmallVector<HWEventListener *, 8> Listeners;
 
   Stage(const Stage &Other) = delete;
   Stage &operator=(const Stage &Other) = delete;
 
 protected:
-  const std::set<HWEventListener *> &getListeners() const { return Listeners; }
+  ArrayRef<HWEventListener *> getListeners() const { return Listeners; }
 
 public:
   Stage() : NextInSequence(nullptr) {}
@@ -15,6 +15,7 @@
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/ADT/iterator_range.h"
@@ -269,6 +270,15 @@ protected:
   const Elf_Shdr *DotSymtabSec = nullptr; // Symbol table section.
   const Elf_Shdr *DotSymtabShndxSec = nullptr; // SHT_SYMTAB_SHNDX section.
 
+  /// Memoized string tables, keyed by symbol table section index. Every
+  /// symbol in a table resolves the same string table, so caching it here
+  /// avoids repeating the section and string table lookups per symbol when a
+  /// tool iterates a symbol table. Not thread-safe, like the rest of the
+  /// lazily initialized state of this class.
+  mutable SmallVector<std::pair<uint32_t, StringRef>, 2> SymbolStringTables;
+
+  Expected<StringRef> getSymbolTableStringTable(uint32_t SymTabIndex) const;
+
   Error initContent() override;
 
   void moveSymbolNext(DataRefImpl &Symb) const override;
@@ -501,19 +511,30 @@ template <class ELFT> Error ELFObjectFile<ELFT>::initContent() {
 }
 
 template <class ELFT>
-Expected<StringRef> ELFObjectFile<ELFT>::getSymbolName(DataRefImpl Sym) const {
-  Expected<const Elf_Sym *> SymOrErr = getSymbol(Sym);
-  if (!SymOrErr)
-    return SymOrErr.takeError();
-  auto SymTabOrErr = EF.getSection(Sym.d.a);
+Expected<StringRef>
+ELFObjectFile<ELFT>::getSymbolTableStringTable(uint32_t SymTabIndex) const {
+  for (const auto &Entry : SymbolStringTables)
+    if (Entry.first == SymTabIndex)
+      return Entry.second;
+  auto SymTabOrErr = EF.getSection(SymTabIndex);
   if (!SymTabOrErr)
     return SymTabOrErr.takeError();
-  const Elf_Shdr *SymTableSec = *SymTabOrErr;
-  auto StrTabOrErr = EF.getSection(SymTableSec->sh_link);
+  auto StrTabOrErr = EF.getSection((*SymTabOrErr)->sh_link);
   if (!StrTabOrErr)
     return StrTabOrErr.takeError();
-  const Elf_Shdr *StringTableSec = *StrTabOrErr;
-  auto SymStrTabOrErr = EF.getStringTable(*StringTableSec);
+  auto SymStrTabOrErr = EF.getStringTable(**StrTabOrErr);
+  if (!SymStrTabOrErr)
+    return SymStrTabOrErr.takeError();
+  SymbolStringTables.emplace_back(SymTabIndex, *SymStrTabOrErr);
+  return *SymStrTabOrErr;
+}
+
+template <class ELFT>
+Expected<StringRef> ELFObjectFile<ELFT>::getSymbolName(DataRefImpl Sym) const {
+  Expected<const Elf_Sym *> SymOrErr = getSymbol(Sym);
+  if (!SymOrErr)
+    return SymOrErr.takeError();
+  Expected<StringRef> SymStrTabOrErr = getSymbolTableStringTable(Sym.d.a);
   if (!SymStrTabOrErr)
     return SymStrTabOrErr.takeError();
   Expected<StringRef> Name = (*SymOrErr)->getName(*SymStrTabOrErr);
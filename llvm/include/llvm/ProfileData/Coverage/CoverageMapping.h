@@ -603,9 +603,17 @@ public:
   /// Load the coverage mapping from the given object files and profile. If
   /// \p Arches is non-empty, it must specify an architecture for each object.
   /// Ignores non-instrumented object files unless all are not instrumented.
+  ///
+  /// If \p SourceFilenamesFilter is non-empty, only function records that
+  /// reference at least one of those filenames are decoded and loaded, and
+  /// queries for any other file report no data. Filenames must match the
+  /// coverage mapping exactly, as with getCoverageForFile(). Clients which
+  /// query a few files out of a large binary can use this to avoid paying for
+  /// a full decode.
   static Expected<std::unique_ptr<CoverageMapping>>
   load(ArrayRef<StringRef> ObjectFilenames, StringRef ProfileFilename,
-       ArrayRef<StringRef> Arches = None, StringRef CompilationDir = "");
+       ArrayRef<StringRef> Arches = None, StringRef CompilationDir = "",
+       ArrayRef<StringRef> SourceFilenamesFilter = None);
 
   /// The number of functions that couldn't have their profiles mapped.
   ///
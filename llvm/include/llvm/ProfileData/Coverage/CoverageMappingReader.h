@@ -16,6 +16,7 @@
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/ProfileData/Coverage/CoverageMapping.h"
 #include "llvm/ProfileData/InstrProf.h"
 #include "llvm/Support/Error.h"
@@ -195,6 +196,11 @@ private:
   // D69471, which can split up function records into multiple sections on ELF.
   FuncRecordsStorage FuncRecords;
 
+  // When non-empty, function records whose translation unit references none
+  // of these filenames are skipped by readNextRecord() without decoding their
+  // counters or regions.
+  StringSet<> SourceFilenamesFilter;
+
   BinaryCoverageReader(FuncRecordsStorage &&FuncRecords)
       : FuncRecords(std::move(FuncRecords)) {}
 
@@ -215,6 +221,14 @@ public:
                                  support::endianness Endian,
                                  StringRef CompilationDir = "");
 
+  /// Restrict readNextRecord() to function records that reference at least
+  /// one of \p SourceFilenames. Filenames are compared exactly as they appear
+  /// in the coverage mapping, i.e. after compilation-dir expansion, matching
+  /// the lookup done by CoverageMapping::getCoverageForFile(). Skipped records
+  /// are never decoded, which makes loading coverage for a handful of files
+  /// out of a large binary substantially cheaper.
+  void setSourceFilenamesFilter(ArrayRef<StringRef> SourceFilenames);
+
   Error readNextRecord(CoverageMappingRecord &Record) override;
 };
 
@@ -87,11 +87,13 @@ public:
       : AllocTy(std::move(Old.getAllocator())), CurPtr(Old.CurPtr),
         End(Old.End), Slabs(std::move(Old.Slabs)),
         CustomSizedSlabs(std::move(Old.CustomSizedSlabs)),
-        BytesAllocated(Old.BytesAllocated), RedZoneSize(Old.RedZoneSize) {
+        BytesAllocated(Old.BytesAllocated), RedZoneSize(Old.RedZoneSize),
+        CurSlab(Old.CurSlab) {
     Old.CurPtr = Old.End = nullptr;
     Old.BytesAllocated = 0;
     Old.Slabs.clear();
     Old.CustomSizedSlabs.clear();
+    Old.CurSlab = 0;
   }
 
   ~BumpPtrAllocatorImpl() {
@@ -109,12 +111,14 @@ public:
     RedZoneSize = RHS.RedZoneSize;
     Slabs = std::move(RHS.Slabs);
     CustomSizedSlabs = std::move(RHS.CustomSizedSlabs);
+    CurSlab = RHS.CurSlab;
     AllocTy::operator=(std::move(RHS.getAllocator()));
 
     RHS.CurPtr = RHS.End = nullptr;
     RHS.BytesAllocated = 0;
     RHS.Slabs.clear();
     RHS.CustomSizedSlabs.clear();
+    RHS.CurSlab = 0;
     return *this;
   }
 
@@ -136,6 +140,28 @@ public:
     __asan_poison_memory_region(*Slabs.begin(), computeSlabSize(0));
     DeallocateSlabs(std::next(Slabs.begin()), Slabs.end());
     Slabs.erase(std::next(Slabs.begin()), Slabs.end());
+    CurSlab = 0;
+  }
+
+  /// Reset the allocator like Reset(), but retain all standard slabs so they
+  /// can be refilled instead of returning them to the underlying allocator.
+  /// Custom-sized slabs are still deallocated. This is useful when an arena of
+  /// roughly the same eventual size is about to be rebuilt, e.g. when
+  /// recycling an allocator across compilations in a long-lived process.
+  void ResetRetainingSlabs() {
+    DeallocateCustomSizedSlabs();
+    CustomSizedSlabs.clear();
+    BytesAllocated = 0;
+
+    if (Slabs.empty())
+      return;
+
+    CurSlab = 0;
+    CurPtr = (char *)Slabs.front();
+    End = CurPtr + SlabSize;
+
+    for (size_t Idx = 0, E = Slabs.size(); Idx != E; ++Idx)
+      __asan_poison_memory_region(Slabs[Idx], computeSlabSize(Idx));
   }
 
   /// Allocate space at the specified alignment.
@@ -322,6 +348,11 @@ private:
   /// a sanitizer.
   size_t RedZoneSize = 1;
 
+  /// The index of the slab CurPtr points into.  This trails Slabs.size() - 1
+  /// only after ResetRetainingSlabs(), when later slabs are kept around to be
+  /// refilled by StartNewSlab().
+  size_t CurSlab = 0;
+
   static size_t computeSlabSize(unsigned SlabIdx) {
     // Scale the actual allocated slab size based on the number of slabs
     // allocated. Every GrowthDelay slabs allocated, we double
@@ -334,6 +365,14 @@ private:
   /// Allocate a new slab and move the bump pointers over into the new
   /// slab, modifying CurPtr and End.
   void StartNewSlab() {
+    // Refill the next retained slab, if ResetRetainingSlabs() left one.
+    if (CurSlab + 1 < Slabs.size()) {
+      ++CurSlab;
+      CurPtr = (char *)Slabs[CurSlab];
+      End = CurPtr + computeSlabSize(CurSlab);
+      return;
+    }
+
     size_t AllocatedSlabSize = computeSlabSize(Slabs.size());
 
     void *NewSlab = this->getAllocator().Allocate(AllocatedSlabSize,
@@ -343,6 +382,7 @@ private:
     __asan_poison_memory_region(NewSlab, AllocatedSlabSize);
 
     Slabs.push_back(NewSlab);
+    CurSlab = Slabs.size() - 1;
     CurPtr = (char *)(NewSlab);
     End = ((char *)NewSlab) + AllocatedSlabSize;
   }
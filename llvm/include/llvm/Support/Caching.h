@@ -71,6 +71,14 @@ Expected<FileCache> localCache(
     Twine CacheNameRef, Twine TempFilePrefixRef, Twine CacheDirectoryPathRef,
     AddBufferFn AddBuffer = [](size_t Task, std::unique_ptr<MemoryBuffer> MB) {
     });
+
+/// Running totals of queries answered from, respectively missing in, every
+/// cache created by localCache in this process. Clients that want per-run
+/// numbers (e.g. to report a ThinLTO cache hit rate at the end of a link)
+/// should snapshot the counters before and after the run.
+uint64_t localCacheHits();
+uint64_t localCacheMisses();
+
 } // namespace llvm
 
 #endif
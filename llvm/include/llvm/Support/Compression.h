@@ -14,6 +14,7 @@
 #define LLVM_SUPPORT_COMPRESSION_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/DataTypes.h"
 
 namespace llvm {
@@ -73,6 +74,54 @@ Error uncompress(ArrayRef<uint8_t> Input,
                  SmallVectorImpl<uint8_t> &UncompressedBuffer,
                  size_t UncompressedSize);
 
+/// A compression dictionary trained on a corpus of similar inputs, held
+/// together with its digested forms so that repeated compressions and
+/// decompressions do not re-process the raw dictionary bytes. Immutable once
+/// constructed and safe to share across threads.
+class Dictionary {
+  SmallVector<uint8_t, 0> Buffer;
+  void *CDict = nullptr; ///< Digested ZSTD_CDict, null if zstd is unavailable.
+  void *DDict = nullptr; ///< Digested ZSTD_DDict, null if zstd is unavailable.
+
+public:
+  /// Digest \p Data for compression at \p Level. The level is fixed at
+  /// construction because the digested form depends on it.
+  explicit Dictionary(SmallVector<uint8_t, 0> Data,
+                      int Level = DefaultCompression);
+  ~Dictionary();
+  Dictionary(const Dictionary &) = delete;
+  Dictionary &operator=(const Dictionary &) = delete;
+
+  /// The raw dictionary bytes, e.g. for persisting next to the artifacts
+  /// compressed against it.
+  ArrayRef<uint8_t> data() const { return Buffer; }
+
+  friend void compress(ArrayRef<uint8_t> Input,
+                       SmallVectorImpl<uint8_t> &CompressedBuffer,
+                       const Dictionary &Dict);
+  friend Error uncompress(ArrayRef<uint8_t> Input,
+                          SmallVectorImpl<uint8_t> &UncompressedBuffer,
+                          size_t UncompressedSize, const Dictionary &Dict);
+};
+
+/// Train a dictionary of at most \p MaxDictSize bytes on a corpus of sample
+/// artifacts. \p SampleData is the concatenation of all samples and
+/// \p SampleSizes the size of each one, in order. The trained bytes are
+/// written to \p Dictionary.
+Error trainDictionary(ArrayRef<uint8_t> SampleData, ArrayRef<size_t> SampleSizes,
+                      size_t MaxDictSize, SmallVectorImpl<uint8_t> &Dictionary);
+
+/// Compress Input against \p Dict at the level the dictionary was digested
+/// for.
+void compress(ArrayRef<uint8_t> Input,
+              SmallVectorImpl<uint8_t> &CompressedBuffer,
+              const Dictionary &Dict);
+
+/// Decompress Input that was compressed against \p Dict.
+Error uncompress(ArrayRef<uint8_t> Input,
+                 SmallVectorImpl<uint8_t> &UncompressedBuffer,
+                 size_t UncompressedSize, const Dictionary &Dict);
+
 } // End of namespace zstd
 
 enum class Format {
@@ -18,7 +18,9 @@
 namespace llvm {
 class MallocAllocator;
 class StringRef;
-template <typename ValueTy, typename AllocatorTy> class StringMap;
+struct StringMapQuadraticProbing;
+template <typename ValueTy, typename AllocatorTy, typename ProbingPolicy>
+class StringMap;
 
 namespace sys {
 
@@ -52,7 +54,8 @@ namespace sys {
   /// all valid LLVM feature names.
   ///
   /// \return - True on success.
-  bool getHostCPUFeatures(StringMap<bool, MallocAllocator> &Features);
+  bool getHostCPUFeatures(
+      StringMap<bool, MallocAllocator, StringMapQuadraticProbing> &Features);
 
   /// Get the number of physical cores (as opposed to logical cores returned
   /// from thread::hardware_concurrency(), which includes hyperthreads).
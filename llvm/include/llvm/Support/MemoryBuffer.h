@@ -81,6 +81,12 @@ public:
   /// function should not be called on a writable buffer.
   virtual void dontNeedIfMmap() {}
 
+  /// For read-only MemoryBuffer_MMap, hint that the buffer will be read
+  /// shortly so the kernel can start readahead now instead of stalling on
+  /// major faults later. This calls madvise(MADV_WILLNEED) on read-only file
+  /// mappings on *NIX systems and is a no-op elsewhere.
+  virtual void willNeedIfMmap() {}
+
   /// Open the specified file as a MemoryBuffer, returning a new MemoryBuffer
   /// if successful, otherwise returning null.
   ///
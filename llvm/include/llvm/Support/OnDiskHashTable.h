@@ -402,6 +402,35 @@ public:
 
   iterator end() const { return iterator(); }
 
+  /// Visit the stored hash value of every item in the table, without
+  /// deserializing keys or data. This walks the table's buckets in order, so
+  /// it is suitable for building in-memory filters in front of the table.
+  template <typename CallbackT>
+  void forEachItemHash(CallbackT Callback) const {
+    using namespace llvm::support;
+
+    for (offset_type I = 0; I != NumBuckets; ++I) {
+      const unsigned char *Bucket = Buckets + sizeof(offset_type) * I;
+      offset_type Offset =
+          endian::readNext<offset_type, little, aligned>(Bucket);
+      if (Offset == 0)
+        continue; // Empty bucket.
+      const unsigned char *Items = Base + Offset;
+
+      // 'Items' starts with a 16-bit unsigned integer representing the
+      // number of items in this bucket.
+      unsigned Len = endian::readNext<uint16_t, little, unaligned>(Items);
+      for (unsigned J = 0; J < Len; ++J) {
+        hash_value_type ItemHash =
+            endian::readNext<hash_value_type, little, unaligned>(Items);
+        const std::pair<offset_type, offset_type> &L =
+            Info::ReadKeyDataLength(Items);
+        Items += L.first + L.second;
+        Callback(ItemHash);
+      }
+    }
+  }
+
   Info &getInfoObj() { return InfoObj; }
 
   /// Create the hash table.
@@ -50,6 +50,14 @@ public:
   template<class SubClass>
   void Deallocate(SubClass* E) { return Base.Deallocate(Allocator, E); }
 
+  /// Reset - Release all storage at once and forget the recycled free list.
+  /// This is only meaningful for wrapped allocators that release their memory
+  /// wholesale, such as BumpPtrAllocator.
+  void Reset() {
+    Base.clear(Allocator);
+    Allocator.Reset();
+  }
+
   void PrintStats() {
     Allocator.PrintStats();
     Base.PrintStats();
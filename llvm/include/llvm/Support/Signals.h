@@ -55,6 +55,23 @@ namespace sys {
   ///        specified, the entire frame is printed.
   void PrintStackTrace(raw_ostream &OS, int Depth = 0);
 
+  /// A function that symbolizes a captured stack trace in-process. For each
+  /// frame, \p Modules holds the path of the object file containing the PC
+  /// (null if the frame could not be attributed to a loaded object) and
+  /// \p Offsets the PC's offset within that object. Returns true if the
+  /// trace was printed to \p OS.
+  using InProcessSymbolizerFn = bool (*)(void **StackTrace, int Depth,
+                                         const char **Modules,
+                                         const intptr_t *Offsets,
+                                         raw_ostream &OS);
+
+  /// Install a symbolizer tried by PrintStackTrace before it shells out to
+  /// an external llvm-symbolizer binary. This lets higher layers (e.g.
+  /// DebugInfo/Symbolize) opt in to in-process symbolization, which keeps
+  /// working when the crashing process can no longer exec. Pass null to
+  /// remove the current symbolizer.
+  void setInProcessSymbolizer(InProcessSymbolizerFn Symbolizer);
+
   // Run all registered signal handlers.
   void RunSignalHandlers();
 
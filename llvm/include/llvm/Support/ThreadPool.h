@@ -21,6 +21,7 @@
 
 #include <future>
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <functional>
@@ -154,14 +155,34 @@ private:
     auto R = createTaskAndFuture(Task);
 
     int requestedThreads;
-    {
+    if (!WorkerQueues.empty()) {
+      // Work-stealing mode: push onto a per-worker deque. QueueLock is only
+      // taken for group bookkeeping; ungrouped tasks stay off the central
+      // lock entirely.
+      assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
+      if (Group != nullptr) {
+        std::lock_guard<std::mutex> LockGuard(QueueLock);
+        ++PendingGroupTasks[Group];
+      }
+      // Count the task before publishing it: a worker may steal it the
+      // moment it lands in the deque, and must never claim more tasks than
+      // have been counted or wait() can return early.
+      requestedThreads = ActiveThreads + ++PendingTasks;
+      WorkerQueue &Queue = pickWorkerQueue();
+      {
+        std::lock_guard<std::mutex> LockGuard(Queue.Mutex);
+        Queue.Deque.emplace_back(std::move(R.first), Group);
+      }
+    } else {
       // Lock the queue and push the new task
       std::unique_lock<std::mutex> LockGuard(QueueLock);
 
       // Don't allow enqueueing after disabling the pool
       assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
+      if (Group != nullptr)
+        ++PendingGroupTasks[Group];
       Tasks.emplace_back(std::make_pair(std::move(R.first), Group));
-      requestedThreads = ActiveThreads + Tasks.size();
+      requestedThreads = ActiveThreads + ++PendingTasks;
     }
     QueueCondition.notify_one();
     grow(requestedThreads);
@@ -178,21 +199,54 @@ private:
 #endif
   }
 
+  /// A task in a queue: the callable plus the group it belongs to (nullptr
+  /// for no group).
+  using QueueTaskTy = std::pair<std::function<void()>, ThreadPoolTaskGroup *>;
+
 #if LLVM_ENABLE_THREADS
   // Grow to ensure that we have at least `requested` Threads, but do not go
   // over MaxThreadCount.
   void grow(int requested);
 
   void processTasks(ThreadPoolTaskGroup *WaitingForGroup);
+
+  /// A per-worker task deque for the work-stealing mode. The owning worker
+  /// pushes and pops at the back; thieves take the oldest task at the front.
+  struct WorkerQueue {
+    std::mutex Mutex;
+    std::deque<QueueTaskTy> Deque;
+  };
+
+  /// Pick the deque to push a new task onto: a worker thread of this pool
+  /// uses its own deque; external submitters round-robin over all of them.
+  WorkerQueue &pickWorkerQueue();
+
+  /// Claim a task for worker \p WorkerIndex: its own deque first, then try to
+  /// steal from the others. Returns false if every deque turned out empty.
+  bool popTask(unsigned WorkerIndex, QueueTaskTy &Task);
+
+  /// Account for a claimed task. QueueLock must be held.
+  void claimTaskUnlocked(ThreadPoolTaskGroup *Group);
 #endif
 
+  /// Returns true if any queue holds an unclaimed task.
+  bool hasPendingTasksUnlocked() const { return PendingTasks != 0; }
+
   /// Threads in flight
   std::vector<llvm::thread> Threads;
   /// Lock protecting access to the Threads vector.
   mutable llvm::sys::RWMutex ThreadsLock;
 
-  /// Tasks waiting for execution in the pool.
-  std::deque<std::pair<std::function<void()>, ThreadPoolTaskGroup *>> Tasks;
+  /// Tasks waiting for execution in the pool (central queue mode).
+  std::deque<QueueTaskTy> Tasks;
+
+#if LLVM_ENABLE_THREADS
+  /// Per-worker task deques; non-empty exactly when the strategy enables work
+  /// stealing. Sized to MaxThreadCount up front so no resizing races exist.
+  std::vector<std::unique_ptr<WorkerQueue>> WorkerQueues;
+  /// Round-robin cursor for external task submission in work-stealing mode.
+  std::atomic<unsigned> NextQueueIndex{0};
+#endif
 
   /// Locking and signaling for accessing the Tasks queue.
   std::mutex QueueLock;
@@ -201,10 +255,17 @@ private:
   /// Signaling for job completion (all tasks or all tasks in a group).
   std::condition_variable CompletionCondition;
 
-  /// Keep track of the number of thread actually busy
-  unsigned ActiveThreads = 0;
+  /// Keep track of the number of thread actually busy. Mutated with QueueLock
+  /// held; atomic so the work-stealing submission path can read it unlocked.
+  std::atomic<unsigned> ActiveThreads{0};
+  /// Number of tasks pushed and not yet claimed by a worker. Mutated without
+  /// QueueLock on the work-stealing submission path.
+  std::atomic<unsigned> PendingTasks{0};
   /// Number of threads active for tasks in the given group (only non-zero).
   DenseMap<ThreadPoolTaskGroup *, unsigned> ActiveGroups;
+  /// Number of unclaimed tasks per group (only non-zero). Guarded by
+  /// QueueLock.
+  DenseMap<ThreadPoolTaskGroup *, unsigned> PendingGroupTasks;
 
 #if LLVM_ENABLE_THREADS // avoids warning for unused variable
   /// Signal for the destruction of the pool, asking thread to exit.
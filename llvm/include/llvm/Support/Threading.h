@@ -129,6 +129,13 @@ constexpr bool llvm_is_multithreaded() { return LLVM_ENABLE_THREADS; }
     // threads, or hardware cores.
     bool Limit = false;
 
+    // If set, a ThreadPool built from this strategy distributes its tasks
+    // over per-worker deques with work stealing instead of a single
+    // mutex-protected queue. Helps fine-grained task workloads on many-core
+    // machines; tasks may run in any order (the pool makes no ordering
+    // guarantee either way).
+    bool UseWorkStealing = false;
+
     /// Retrieves the max available threads for the current strategy. This
     /// accounts for affinity masks and takes advantage of all CPU sockets.
     unsigned compute_thread_count() const;
@@ -188,6 +195,16 @@ constexpr bool llvm_is_multithreaded() { return LLVM_ENABLE_THREADS; }
     return S;
   }
 
+  /// Returns a strategy like hardware_concurrency(), but with work stealing
+  /// enabled: the ThreadPool uses per-worker deques instead of one
+  /// mutex-protected queue. Prefer this for large numbers of small tasks.
+  inline ThreadPoolStrategy work_stealing_concurrency(unsigned ThreadCount = 0) {
+    ThreadPoolStrategy S;
+    S.ThreadsRequested = ThreadCount;
+    S.UseWorkStealing = true;
+    return S;
+  }
+
   /// Returns an optimal thread strategy to execute specified amount of tasks.
   /// This strategy should prevent us from creating too many threads if we
   /// occasionaly have an unexpectedly small amount of tasks.
@@ -25,6 +25,17 @@ TimeTraceProfiler *getTimeTraceProfilerInstance();
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
                                  StringRef ProcName);
 
+/// Switch the time trace profiler into sampling mode. Instead of recording
+/// every time section, the profiler attributes wall time to the stack of
+/// currently open sections at most once per \p SampleIntervalUs microseconds,
+/// and timeTraceProfilerWrite emits one collapsed-stack line per observed
+/// stack ("Outer;Inner <total us>"), suitable for flamegraph tools, instead
+/// of a JSON trace. This bounds both the overhead and the output size when
+/// full tracing at section granularity is too expensive. Affects the calling
+/// thread's instance and instances initialized afterwards, so call this right
+/// after timeTraceProfilerInitialize, before any sections are entered.
+void timeTraceProfilerEnableSampling(unsigned SampleIntervalUs);
+
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
 
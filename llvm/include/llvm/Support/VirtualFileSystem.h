@@ -416,6 +416,15 @@ IntrusiveRefCntPtr<FileSystem> getRealFileSystem();
 /// that of the process.
 std::unique_ptr<FileSystem> createPhysicalFileSystem();
 
+/// Wraps \p FS in a layer that caches the result of every status() call,
+/// including failed ones. The cache is thread-safe, keyed by the path exactly
+/// as spelled, and never invalidated: use this only over trees that do not
+/// change for the lifetime of the cache, and discard it when they might (for
+/// example at a build-session boundary). All other operations, including
+/// reads, pass through uncached.
+IntrusiveRefCntPtr<FileSystem>
+createStatCachingFileSystem(IntrusiveRefCntPtr<FileSystem> FS);
+
 /// A file system that allows overlaying one \p AbstractFileSystem on top
 /// of another.
 ///
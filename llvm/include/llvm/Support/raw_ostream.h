@@ -21,6 +21,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -454,9 +455,6 @@ class raw_fd_ostream : public raw_pwrite_stream {
 
   uint64_t pos = 0;
 
-  /// See raw_ostream::write_impl.
-  void write_impl(const char *Ptr, size_t Size) override;
-
   void pwrite_impl(const char *Ptr, size_t Size, uint64_t Offset) override;
 
   /// Return the current position within the stream, not counting the bytes
@@ -469,6 +467,9 @@ class raw_fd_ostream : public raw_pwrite_stream {
   void anchor() override;
 
 protected:
+  /// See raw_ostream::write_impl.
+  void write_impl(const char *Ptr, size_t Size) override;
+
   /// Set the flag indicating that an output error has been encountered.
   void error_detected(std::error_code EC) { this->EC = EC; }
 
@@ -616,6 +617,61 @@ public:
   static bool classof(const raw_ostream *OS);
 };
 
+/// A raw_fd_ostream that overlaps producing output with writing it out.
+///
+/// The stream's buffer and a second "back" buffer are flipped on each flush:
+/// the full buffer is handed to a background flusher thread while the caller
+/// keeps formatting into the other one, so large artifact writes (object
+/// files, PCMs, bitcode) are not serialized behind file I/O.  Positioned
+/// writes via the raw_pwrite_stream interface quiesce the flusher first, so
+/// backpatching remains safe.  If LLVM is built without threads the stream
+/// degrades to a plain raw_fd_ostream.
+///
+/// Write errors from the flusher are reported through the usual
+/// has_error()/error() mechanism, but only become visible once the next
+/// buffer is handed off, the stream is closed, or the stream is destroyed.
+class raw_fd_flip_ostream : public raw_fd_ostream {
+  struct FlipBufferState;
+
+  /// State shared with the background flusher thread; null when the flusher
+  /// is not running (threads disabled, open failed, or already joined).
+  std::unique_ptr<FlipBufferState> State;
+
+  /// See raw_ostream::write_impl.
+  void write_impl(const char *Ptr, size_t Size) override;
+
+  void pwrite_impl(const char *Ptr, size_t Size, uint64_t Offset) override;
+
+  size_t preferred_buffer_size() const override;
+
+  /// Wait until the flusher has no write in flight, propagating any error it
+  /// hit into this stream.
+  void drain();
+
+  /// Drain outstanding writes and join the flusher thread.  Afterwards the
+  /// stream writes synchronously.
+  void joinFlusher();
+
+  void startFlusher();
+  void flushLoop();
+
+public:
+  /// Open the specified file for writing.  If an error occurs, information
+  /// about the error is put into EC, and the stream should be immediately
+  /// destroyed.
+  raw_fd_flip_ostream(StringRef Filename, std::error_code &EC);
+
+  /// FD is the file descriptor that this writes to.  If ShouldClose is true,
+  /// this closes the file when the stream is destroyed.
+  raw_fd_flip_ostream(int fd, bool shouldClose);
+
+  ~raw_fd_flip_ostream() override;
+
+  /// Wait for all outstanding writes, then flush the stream and close the
+  /// file.  Note that this does not call fsync.
+  void close();
+};
+
 //===----------------------------------------------------------------------===//
 // Output Stream Adaptors
 //===----------------------------------------------------------------------===//
@@ -24,6 +24,11 @@ using TableGenMainFn = bool (raw_ostream &OS, RecordKeeper &Records);
 
 int TableGenMain(const char *argv0, TableGenMainFn *MainFn);
 
+/// As above, but receives the full command line. Drivers that use this entry
+/// point additionally support the --cache-dir option, whose cache entries are
+/// keyed on the verbatim command line.
+int TableGenMain(int argc, const char *const *argv, TableGenMainFn *MainFn);
+
 } // end namespace llvm
 
 #endif // LLVM_TABLEGEN_MAIN_H
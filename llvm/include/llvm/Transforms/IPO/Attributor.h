@@ -2222,6 +2222,11 @@ private:
   /// registerForUpdate.
   SmallSetVector<AbstractAttribute *, 16> QueryAAsAwaitingUpdate;
 
+  /// Number of `AbstractAttribute::update` calls issued per abstract attribute
+  /// class. Only populated if update statistics were requested on the command
+  /// line, and printed at the end of `Attributor::run`.
+  std::map<std::string, unsigned> NumUpdatesPerKind;
+
   /// User provided configuration for this Attributor instance.
   const AttributorConfig Configuration;
 
@@ -204,6 +204,7 @@ public:
     bool exists(Value *V) const;
     void add(Value *V, uint32_t num);
     void clear();
+    void reserve(uint32_t NumValues);
     void erase(Value *v);
     void setAliasAnalysis(AAResults *A) { AA = A; }
     AAResults *getAliasAnalysis() const { return AA; }
@@ -170,6 +170,13 @@ ModuleToPostOrderCGSCCPassAdaptor::run(Module &M, ModuleAnalysisManager &AM) {
 
   PreservedAnalyses PA = PreservedAnalyses::all();
   CG.buildRefSCCs();
+  // Note: sibling RefSCCs with no ref edges between them are semantically
+  // independent, but they cannot be visited concurrently from here: all SCCs
+  // share one LLVMContext (constant/type uniquing, value use-lists and
+  // metadata are mutated without locks), one LazyCallGraph, and one set of
+  // analysis managers. Until those become thread-safe, any parallelism over
+  // a module has to happen by splitting it across contexts (as ThinLTO
+  // does), not by scheduling this loop.
   for (LazyCallGraph::RefSCC &RC :
        llvm::make_early_inc_range(CG.postorder_ref_sccs())) {
     assert(RCWorklist.empty() &&
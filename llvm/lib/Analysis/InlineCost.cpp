@@ -50,6 +50,12 @@ using namespace llvm;
 #define DEBUG_TYPE "inline-cost"
 
 STATISTIC(NumCallsAnalyzed, "Number of call sites analyzed");
+STATISTIC(NumCallsDecidedByAttributes,
+          "Number of call sites decided by attributes alone");
+STATISTIC(NumCallsDecidedByCostBenefit,
+          "Number of call sites decided by cost-benefit analysis");
+STATISTIC(NumCallsDecidedByCostThreshold,
+          "Number of call sites decided by cost-threshold comparison");
 
 static cl::opt<int>
     DefaultThreshold("inlinedefault-threshold", cl::Hidden, cl::init(225),
@@ -2941,6 +2947,7 @@ InlineCost llvm::getInlineCost(
       llvm::getAttributeBasedInliningDecision(Call, Callee, CalleeTTI, GetTLI);
 
   if (UserDecision) {
+    ++NumCallsDecidedByAttributes;
     if (UserDecision->isSuccess())
       return llvm::InlineCost::getAlways("always inline attribute");
     return llvm::InlineCost::getNever(UserDecision->getFailureReason());
@@ -2960,6 +2967,7 @@ InlineCost llvm::getInlineCost(
   // We use always/never here since threshold is not meaningful,
   // as it's not what drives cost-benefit analysis.
   if (CA.wasDecidedByCostBenefit()) {
+    ++NumCallsDecidedByCostBenefit;
     if (ShouldInline.isSuccess())
       return InlineCost::getAlways("benefit over cost",
                                    CA.getCostBenefitPair());
@@ -2967,8 +2975,10 @@ InlineCost llvm::getInlineCost(
       return InlineCost::getNever("cost over benefit", CA.getCostBenefitPair());
   }
 
-  if (CA.wasDecidedByCostThreshold())
+  if (CA.wasDecidedByCostThreshold()) {
+    ++NumCallsDecidedByCostThreshold;
     return InlineCost::get(CA.getCost(), CA.getThreshold());
+  }
 
   // No details on how the decision was made, simply return always or never.
   return ShouldInline.isSuccess()
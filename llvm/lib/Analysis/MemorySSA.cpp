@@ -1779,6 +1779,16 @@ MemoryUseOrDef *MemorySSA::createNewAccess(Instruction *I,
     UseCheck = isRefSet(ModRef);
     assert(Def == DefCheck && (Def || Use == UseCheck) && "Invalid template");
 #endif
+  } else if (auto *LI = dyn_cast<LoadInst>(I)) {
+    // Plain loads and stores dominate construction time, and their modref
+    // behavior with no location is fixed: no AA implementation is consulted
+    // for them, so skip the AA dispatch and mirror what
+    // AAResults::getModRefInfo plus the isOrdered adjustment below compute.
+    Def = !LI->isUnordered();
+    Use = true;
+  } else if (auto *SI = dyn_cast<StoreInst>(I)) {
+    Def = true;
+    Use = isStrongerThan(SI->getOrdering(), AtomicOrdering::Unordered);
   } else {
     // Find out what affect this instruction has on memory.
     ModRefInfo ModRef = AAP->getModRefInfo(I, None);
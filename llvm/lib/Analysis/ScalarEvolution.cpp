@@ -142,6 +142,8 @@ STATISTIC(NumTripCountsNotComputed,
           "Number of loops without predictable loop counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumArithBudgetExhausted,
+          "Number of SCEV canonicalizations cut short by the arith budget");
 
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifySCEV = true;
@@ -202,6 +204,13 @@ static cl::opt<unsigned>
                   cl::desc("Maximum depth of recursive arithmetics"),
                   cl::init(32));
 
+static cl::opt<unsigned> MaxArithBudget(
+    "scalar-evolution-max-arith-budget", cl::Hidden,
+    cl::desc("Maximum total number of recursive arithmetic simplification "
+             "steps spent on one top-level add/mul canonicalization "
+             "(0 = unlimited)"),
+    cl::init(65536));
+
 static cl::opt<unsigned> MaxConstantEvolvingDepth(
     "scalar-evolution-max-constant-evolving-depth", cl::Hidden,
     cl::desc("Maximum depth of recursive constant evolving"), cl::init(32));
@@ -922,6 +931,24 @@ static bool hasHugeExpression(ArrayRef<const SCEV *> Ops) {
   });
 }
 
+void ScalarEvolution::refillArithBudget() {
+  // A budget of zero disables the limit.
+  ArithSimplifyBudget = MaxArithBudget ? MaxArithBudget.getValue() : UINT_MAX;
+}
+
+bool ScalarEvolution::consumeArithBudget() {
+  if (ArithSimplifyBudget == 0)
+    return false;
+  if (--ArithSimplifyBudget == 0) {
+    // Only count the transition, i.e. one exhaustion per top-level request,
+    // so the statistic points at pathological expressions rather than at the
+    // amount of work refused afterwards.
+    ++NumArithBudgetExhausted;
+    return false;
+  }
+  return true;
+}
+
 //===----------------------------------------------------------------------===//
 //                      Simple SCEV method implementations
 //===----------------------------------------------------------------------===//
@@ -2532,8 +2559,12 @@ const SCEV *ScalarEvolution::getAddExpr(SmallVectorImpl<const SCEV *> &Ops,
     return StrengthenNoWrapFlags(this, scAddExpr, Ops, OrigFlags);
   };
 
-  // Limit recursion calls depth.
-  if (Depth > MaxArithDepth || hasHugeExpression(Ops))
+  // Limit recursion calls depth, and the total amount of simplification
+  // work spent on behalf of one top-level request. Either way the result is
+  // still correct, just not maximally simplified.
+  if (Depth == 0)
+    refillArithBudget();
+  if (Depth > MaxArithDepth || hasHugeExpression(Ops) || !consumeArithBudget())
     return getOrCreateAddExpr(Ops, ComputeFlags(Ops));
 
   if (SCEV *S = findExistingSCEVInCache(scAddExpr, Ops)) {
@@ -3132,8 +3163,11 @@ const SCEV *ScalarEvolution::getMulExpr(SmallVectorImpl<const SCEV *> &Ops,
     return StrengthenNoWrapFlags(this, scMulExpr, Ops, OrigFlags);
   };
 
-  // Limit recursion calls depth.
-  if (Depth > MaxArithDepth || hasHugeExpression(Ops))
+  // Limit recursion calls depth and the shared simplification budget, as in
+  // getAddExpr.
+  if (Depth == 0)
+    refillArithBudget();
+  if (Depth > MaxArithDepth || hasHugeExpression(Ops) || !consumeArithBudget())
     return getOrCreateMulExpr(Ops, ComputeFlags(Ops));
 
   if (SCEV *S = findExistingSCEVInCache(scMulExpr, Ops)) {
@@ -100,8 +100,15 @@ bool LLParser::Run(bool UpgradeDebugInfo,
       M->setDataLayout(*LayoutOverride);
   }
 
-  return parseTopLevelEntities() || validateEndOfModule(UpgradeDebugInfo) ||
-         validateEndOfIndex();
+  // Remember whether debug info upgrades were requested; in lazy-loading
+  // mode they run when the module is materialized rather than here.
+  this->UpgradeDebugInfo = UpgradeDebugInfo;
+
+  if (parseTopLevelEntities())
+    return true;
+  ParsedAllTopLevelEntities = true;
+
+  return validateEndOfModule(UpgradeDebugInfo) || validateEndOfIndex();
 }
 
 bool LLParser::parseStandaloneConstantValue(Constant *&C,
@@ -146,12 +153,8 @@ void LLParser::restoreParsingState(const SlotMapping *Slots) {
         std::make_pair(I.first, std::make_pair(I.second, LocTy())));
 }
 
-/// validateEndOfModule - Do final validity and basic correctness checks at the
-/// end of the module.
-bool LLParser::validateEndOfModule(bool UpgradeDebugInfo) {
-  if (!M)
-    return false;
-  // Handle any function attribute group forward references.
+/// Handle any function attribute group forward references.
+void LLParser::resolveForwardRefAttrGroups() {
   for (const auto &RAG : ForwardRefAttrGroups) {
     Value *V = RAG.first;
     const std::vector<unsigned> &Attrs = RAG.second;
@@ -208,6 +211,21 @@ bool LLParser::validateEndOfModule(bool UpgradeDebugInfo) {
       llvm_unreachable("invalid object with forward attribute group reference");
     }
   }
+  ForwardRefAttrGroups.clear();
+}
+
+/// validateEndOfModule - Do final validity and basic correctness checks at the
+/// end of the module.
+bool LLParser::validateEndOfModule(bool UpgradeDebugInfo) {
+  if (!M)
+    return false;
+
+  resolveForwardRefAttrGroups();
+
+  // A blockaddress may reference a function whose body was lazily skipped;
+  // parse such bodies now so that the references can be resolved.
+  if (resolveDeferredBlockAddresses())
+    return true;
 
   // If there are entries in ForwardRefBlockAddresses at this point, the
   // function was never defined.
@@ -260,23 +278,28 @@ bool LLParser::validateEndOfModule(bool UpgradeDebugInfo) {
       Inst->setMetadata(LLVMContext::MD_tbaa, UpgradedMD);
   }
 
-  // Look for intrinsic functions and CallInst that need to be upgraded.  We use
-  // make_early_inc_range here because we may remove some functions.
-  for (Function &F : llvm::make_early_inc_range(*M))
-    UpgradeCallsToIntrinsic(&F);
-
-  // Some types could be renamed during loading if several modules are
-  // loaded in the same LLVMContext (LTO scenario). In this case we should
-  // remangle intrinsics names as well.
-  for (Function &F : llvm::make_early_inc_range(*M)) {
-    if (auto Remangled = Intrinsic::remangleIntrinsicFunction(&F)) {
-      F.replaceAllUsesWith(*Remangled);
-      F.eraseFromParent();
+  // The intrinsic and debug info upgrades need to see the parsed function
+  // bodies; in lazy-loading mode they run in materializeModule once all
+  // bodies have been parsed.
+  if (!LazyLoadFunctions) {
+    // Look for intrinsic functions and CallInst that need to be upgraded.  We
+    // use make_early_inc_range here because we may remove some functions.
+    for (Function &F : llvm::make_early_inc_range(*M))
+      UpgradeCallsToIntrinsic(&F);
+
+    // Some types could be renamed during loading if several modules are
+    // loaded in the same LLVMContext (LTO scenario). In this case we should
+    // remangle intrinsics names as well.
+    for (Function &F : llvm::make_early_inc_range(*M)) {
+      if (auto Remangled = Intrinsic::remangleIntrinsicFunction(&F)) {
+        F.replaceAllUsesWith(*Remangled);
+        F.eraseFromParent();
+      }
     }
-  }
 
-  if (UpgradeDebugInfo)
-    llvm::UpgradeDebugInfo(*M);
+    if (UpgradeDebugInfo)
+      llvm::UpgradeDebugInfo(*M);
+  }
 
   UpgradeModuleFlags(*M);
   UpgradeSectionAttributes(*M);
@@ -296,6 +319,141 @@ bool LLParser::validateEndOfModule(bool UpgradeDebugInfo) {
   return false;
 }
 
+/// Materialize any deferred function that is referenced by a pending
+/// blockaddress, mirroring the eager materialization the bitcode reader
+/// performs for forward block address references.  Entries that do not name
+/// a deferred function are left for validateEndOfModule to diagnose.
+bool LLParser::resolveDeferredBlockAddresses() {
+  bool Progress = true;
+  while (Progress && !ForwardRefBlockAddresses.empty()) {
+    Progress = false;
+    for (const auto &Entry : ForwardRefBlockAddresses) {
+      GlobalValue *GV = nullptr;
+      if (Entry.first.Kind == ValID::t_GlobalName)
+        GV = M->getNamedValue(Entry.first.StrVal);
+      else if (Entry.first.UIntVal < NumberedVals.size())
+        GV = NumberedVals[Entry.first.UIntVal];
+      auto *F = dyn_cast_or_null<Function>(GV);
+      if (!F || !DeferredFunctionInfo.count(F))
+        continue;
+      if (materializeFunction(*F))
+        return true;
+      // Parsing the body resolved (and erased) this entry and may have added
+      // new ones; restart the scan.
+      Progress = true;
+      break;
+    }
+  }
+  return false;
+}
+
+/// Parse the body of \p F at the location recorded when it was skipped.  This
+/// is a no-op for functions that have already been materialized.
+bool LLParser::materializeFunction(Function &F) {
+  auto DFI = DeferredFunctionInfo.find(&F);
+  if (DFI == DeferredFunctionInfo.end())
+    return false;
+  LocTy BodyLoc = DFI->second.first;
+  int FunctionNumber = DFI->second.second;
+  // Erase the entry first so that blockaddress references back to this
+  // function do not try to materialize it again.
+  DeferredFunctionInfo.erase(DFI);
+  F.setIsMaterializable(false);
+
+  // Reparse the body from its recorded location, then restore the lexer so
+  // that materialization can be triggered while other entities are being
+  // parsed.
+  LocTy SavedLoc = Lex.getLoc();
+  Lex.setLoc(BodyLoc);
+  Lex.Lex();
+  bool Failed = parseFunctionBody(F, FunctionNumber);
+  Lex.setLoc(SavedLoc);
+  Lex.Lex();
+  if (Failed)
+    return true;
+
+  // During the initial parse validateEndOfModule performs the per-function
+  // cleanups; afterwards they are our responsibility.
+  if (!ParsedAllTopLevelEntities)
+    return false;
+
+  resolveForwardRefAttrGroups();
+
+  if (!ForwardRefVals.empty())
+    return error(ForwardRefVals.begin()->second.second,
+                 "use of undefined value '@" + ForwardRefVals.begin()->first +
+                     "'");
+
+  if (!ForwardRefValIDs.empty())
+    return error(ForwardRefValIDs.begin()->second.second,
+                 "use of undefined value '@" +
+                     Twine(ForwardRefValIDs.begin()->first) + "'");
+
+  if (!ForwardRefMDNodes.empty())
+    return error(ForwardRefMDNodes.begin()->second.second,
+                 "use of undefined metadata '!" +
+                     Twine(ForwardRefMDNodes.begin()->first) + "'");
+
+  for (auto *Inst : InstsWithTBAATag) {
+    MDNode *MD = Inst->getMetadata(LLVMContext::MD_tbaa);
+    assert(MD && "UpgradeInstWithTBAATag should have a TBAA tag");
+    auto *UpgradedMD = UpgradeTBAANode(*MD);
+    if (MD != UpgradedMD)
+      Inst->setMetadata(LLVMContext::MD_tbaa, UpgradedMD);
+  }
+  InstsWithTBAATag.clear();
+
+  // A blockaddress in this body may reference a function whose body is still
+  // deferred; materialize it so that the reference resolves.
+  return resolveDeferredBlockAddresses();
+}
+
+/// Parse every function body that is still deferred.
+bool LLParser::parseDeferredFunctionBodies() {
+  while (!DeferredFunctionInfo.empty())
+    if (materializeFunction(*DeferredFunctionInfo.begin()->first))
+      return true;
+  return false;
+}
+
+/// Parse all remaining deferred function bodies and run the module-level
+/// upgrades that validateEndOfModule skips in lazy-loading mode.
+bool LLParser::materializeModule() {
+  if (parseDeferredFunctionBodies())
+    return true;
+
+  // Look for intrinsic functions and CallInst that need to be upgraded.  We
+  // use make_early_inc_range here because we may remove some functions.
+  for (Function &F : llvm::make_early_inc_range(*M))
+    UpgradeCallsToIntrinsic(&F);
+
+  // Some types could be renamed during loading if several modules are
+  // loaded in the same LLVMContext (LTO scenario). In this case we should
+  // remangle intrinsics names as well.
+  for (Function &F : llvm::make_early_inc_range(*M)) {
+    if (auto Remangled = Intrinsic::remangleIntrinsicFunction(&F)) {
+      F.replaceAllUsesWith(*Remangled);
+      F.eraseFromParent();
+    }
+  }
+
+  if (UpgradeDebugInfo)
+    llvm::UpgradeDebugInfo(*M);
+
+  return false;
+}
+
+std::vector<StructType *> LLParser::getIdentifiedStructTypes() const {
+  std::vector<StructType *> Ret;
+  for (const auto &Entry : NamedTypes)
+    if (auto *ST = dyn_cast_or_null<StructType>(Entry.second.first))
+      Ret.push_back(ST);
+  for (const auto &Entry : NumberedTypes)
+    if (auto *ST = dyn_cast_or_null<StructType>(Entry.second.first))
+      Ret.push_back(ST);
+  return Ret;
+}
+
 /// Do final validity and basic correctness checks at the end of the index.
 bool LLParser::validateEndOfIndex() {
   if (!Index)
@@ -564,8 +722,17 @@ bool LLParser::parseDefine() {
   Lex.Lex();
 
   Function *F;
-  return parseFunctionHeader(F, true) || parseOptionalFunctionMetadata(*F) ||
-         parseFunctionBody(*F);
+  if (parseFunctionHeader(F, true) || parseOptionalFunctionMetadata(*F))
+    return true;
+
+  int FunctionNumber = -1;
+  if (!F->hasName())
+    FunctionNumber = NumberedVals.size() - 1;
+
+  if (LazyLoadFunctions)
+    return skipFunctionBody(*F, FunctionNumber);
+
+  return parseFunctionBody(*F, FunctionNumber);
 }
 
 /// parseGlobalType
@@ -3335,7 +3502,12 @@ bool LLParser::parseValID(ValID &ID, PerFunctionState *PFS, Type *ExpectedTy) {
       if (!isa<Function>(GV))
         return error(Fn.Loc, "expected function name in blockaddress");
       F = cast<Function>(GV);
-      if (F->isDeclaration())
+      if (DeferredFunctionInfo.count(F)) {
+        // The body of this function was lazily skipped, so its blocks do not
+        // exist yet; treat the reference like a forward reference and resolve
+        // it when the function is materialized.
+        F = nullptr;
+      } else if (F->isDeclaration())
         return error(Fn.Loc, "cannot take blockaddress inside a declaration");
     }
 
@@ -5840,16 +6012,61 @@ bool LLParser::PerFunctionState::resolveForwardRefBlockAddresses() {
   return false;
 }
 
+/// When lazily loading function bodies, record where the body of \p Fn starts
+/// and skip its tokens without constructing any IR; the body is parsed again
+/// when the function is materialized.  Bodies containing blockaddress
+/// constants are parsed eagerly because the forward reference machinery
+/// expects to see them in source order.
+bool LLParser::skipFunctionBody(Function &Fn, int FunctionNumber) {
+  if (Lex.getKind() != lltok::lbrace)
+    return tokError("expected '{' in function body");
+
+  LocTy BodyLoc = Lex.getLoc();
+
+  // Skip to the matching '}'.  The lexer has already consumed any braces in
+  // string constants, so counting brace depth is sufficient; nested braces
+  // only come from struct types and constants, which are always balanced.
+  bool SawBlockAddress = false;
+  unsigned BraceDepth = 0;
+  do {
+    switch (Lex.getKind()) {
+    case lltok::Eof:
+      return tokError("expected '}' at end of function body");
+    case lltok::Error:
+      return true;
+    case lltok::lbrace:
+      ++BraceDepth;
+      break;
+    case lltok::rbrace:
+      --BraceDepth;
+      break;
+    case lltok::kw_blockaddress:
+      SawBlockAddress = true;
+      break;
+    default:
+      break;
+    }
+    Lex.Lex();
+  } while (BraceDepth);
+
+  if (SawBlockAddress) {
+    Lex.setLoc(BodyLoc);
+    Lex.Lex();
+    return parseFunctionBody(Fn, FunctionNumber);
+  }
+
+  DeferredFunctionInfo[&Fn] = std::make_pair(BodyLoc, FunctionNumber);
+  Fn.setIsMaterializable(true);
+  return false;
+}
+
 /// parseFunctionBody
 ///   ::= '{' BasicBlock+ UseListOrderDirective* '}'
-bool LLParser::parseFunctionBody(Function &Fn) {
+bool LLParser::parseFunctionBody(Function &Fn, int FunctionNumber) {
   if (Lex.getKind() != lltok::lbrace)
     return tokError("expected '{' in function body");
   Lex.Lex();  // eat the {.
 
-  int FunctionNumber = -1;
-  if (!Fn.hasName()) FunctionNumber = NumberedVals.size()-1;
-
   PerFunctionState PFS(*this, Fn, FunctionNumber);
 
   // Resolve block addresses and allow basic blocks to be forward-declared
@@ -7767,6 +7984,12 @@ bool LLParser::parseUseListOrderIndexes(SmallVectorImpl<unsigned> &Indexes) {
 ///   ::= 'uselistorder' Type Value ',' UseListOrderIndexes
 bool LLParser::parseUseListOrder(PerFunctionState *PFS) {
   SMLoc Loc = Lex.getLoc();
+
+  // A module-level directive may order uses that live in function bodies;
+  // parse any lazily skipped bodies so every use is visible.
+  if (!PFS && !DeferredFunctionInfo.empty() && parseDeferredFunctionBodies())
+    return true;
+
   if (parseToken(lltok::kw_uselistorder, "expected uselistorder directive"))
     return true;
 
@@ -7785,6 +8008,12 @@ bool LLParser::parseUseListOrder(PerFunctionState *PFS) {
 bool LLParser::parseUseListOrderBB() {
   assert(Lex.getKind() == lltok::kw_uselistorder_bb);
   SMLoc Loc = Lex.getLoc();
+
+  // Use-list directives describe positions in fully constructed use lists;
+  // parse any lazily skipped function bodies before applying them.
+  if (!DeferredFunctionInfo.empty() && parseDeferredFunctionBodies())
+    return true;
+
   Lex.Lex();
 
   ValID Fn, Label;
@@ -12,10 +12,13 @@
 
 #include "llvm/AsmParser/Parser.h"
 #include "llvm/AsmParser/LLParser.h"
+#include "llvm/IR/GVMaterializer.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ModuleSummaryIndex.h"
+#include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
 #include <system_error>
 
 using namespace llvm;
@@ -55,6 +58,97 @@ llvm::parseAssembly(MemoryBufferRef F, SMDiagnostic &Err, LLVMContext &Context,
   return M;
 }
 
+namespace {
+
+/// Keeps the LLParser (and the buffer it lexes from) alive after the initial
+/// lazy parse so that skipped function bodies can be parsed on demand.
+class LLLazyParserMaterializer : public GVMaterializer {
+  std::unique_ptr<MemoryBuffer> Buf;
+  SourceMgr SM;
+  SMDiagnostic Err;
+  LLParser Parser;
+
+  /// Convert the parser's pending SMDiagnostic into an Error.
+  Error makeError() {
+    std::string Msg;
+    raw_string_ostream OS(Msg);
+    Err.print(/*ProgName=*/nullptr, OS, /*ShowColors=*/false);
+    return createStringError(inconvertibleErrorCode(), "%s", OS.str().c_str());
+  }
+
+public:
+  LLLazyParserMaterializer(std::unique_ptr<MemoryBuffer> F, Module *M)
+      : Buf(std::move(F)),
+        Parser(Buf->getBuffer(), SM, Err, M, /*Index=*/nullptr,
+               M->getContext(), /*Slots=*/nullptr,
+               /*LazyLoadFunctions=*/true) {
+    SM.AddNewSourceBuffer(MemoryBuffer::getMemBuffer(Buf->getMemBufferRef()),
+                          SMLoc());
+  }
+
+  /// Run the initial body-skipping parse, reporting failures through
+  /// \p OutErr.
+  bool run(SMDiagnostic &OutErr) {
+    if (!Parser.Run(/*UpgradeDebugInfo=*/true, [](StringRef) { return None; }))
+      return false;
+    OutErr = Err;
+    return true;
+  }
+
+  Error materialize(GlobalValue *GV) override {
+    auto *F = dyn_cast<Function>(GV);
+    if (!F || !Parser.materializeFunction(*F))
+      return Error::success();
+    return makeError();
+  }
+
+  Error materializeModule() override {
+    if (!Parser.materializeModule())
+      return Error::success();
+    return makeError();
+  }
+
+  // Metadata is always parsed eagerly from textual IR.
+  Error materializeMetadata() override { return Error::success(); }
+  void setStripDebugInfo() override {}
+
+  std::vector<StructType *> getIdentifiedStructTypes() const override {
+    return Parser.getIdentifiedStructTypes();
+  }
+};
+
+} // end anonymous namespace
+
+std::unique_ptr<Module> llvm::parseAssemblyLazy(std::unique_ptr<MemoryBuffer> F,
+                                                SMDiagnostic &Err,
+                                                LLVMContext &Context) {
+  auto M = std::make_unique<Module>(F->getBufferIdentifier(), Context);
+
+  // The module owns the materializer, which in turn owns the parser state
+  // needed to parse the deferred function bodies later.
+  auto *Materializer = new LLLazyParserMaterializer(std::move(F), M.get());
+  M->setMaterializer(Materializer);
+
+  if (Materializer->run(Err))
+    return nullptr;
+
+  return M;
+}
+
+std::unique_ptr<Module> llvm::parseAssemblyFileLazy(StringRef Filename,
+                                                    SMDiagnostic &Err,
+                                                    LLVMContext &Context) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> FileOrErr =
+      MemoryBuffer::getFileOrSTDIN(Filename, /*IsText=*/true);
+  if (std::error_code EC = FileOrErr.getError()) {
+    Err = SMDiagnostic(Filename, SourceMgr::DK_Error,
+                       "Could not open input file: " + EC.message());
+    return nullptr;
+  }
+
+  return parseAssemblyLazy(std::move(FileOrErr.get()), Err, Context);
+}
+
 std::unique_ptr<Module> llvm::parseAssemblyFile(StringRef Filename,
                                                 SMDiagnostic &Err,
                                                 LLVMContext &Context,
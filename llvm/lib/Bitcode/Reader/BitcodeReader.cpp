@@ -905,10 +905,15 @@ class ModuleSummaryIndexBitcodeReader : public BitcodeReaderBase {
   /// this module by the client.
   unsigned ModuleId;
 
+  /// If non-null, only summaries whose GUID this filter accepts are
+  /// materialized; rejected records are decoded and dropped.
+  function_ref<bool(GlobalValue::GUID)> GUIDFilter;
+
 public:
-  ModuleSummaryIndexBitcodeReader(BitstreamCursor Stream, StringRef Strtab,
-                                  ModuleSummaryIndex &TheIndex,
-                                  StringRef ModulePath, unsigned ModuleId);
+  ModuleSummaryIndexBitcodeReader(
+      BitstreamCursor Stream, StringRef Strtab, ModuleSummaryIndex &TheIndex,
+      StringRef ModulePath, unsigned ModuleId,
+      function_ref<bool(GlobalValue::GUID)> GUIDFilter = {});
 
   Error parseModule();
 
@@ -6578,9 +6583,10 @@ std::vector<StructType *> BitcodeReader::getIdentifiedStructTypes() const {
 
 ModuleSummaryIndexBitcodeReader::ModuleSummaryIndexBitcodeReader(
     BitstreamCursor Cursor, StringRef Strtab, ModuleSummaryIndex &TheIndex,
-    StringRef ModulePath, unsigned ModuleId)
+    StringRef ModulePath, unsigned ModuleId,
+    function_ref<bool(GlobalValue::GUID)> GUIDFilter)
     : BitcodeReaderBase(std::move(Cursor), Strtab), TheIndex(TheIndex),
-      ModulePath(ModulePath), ModuleId(ModuleId) {}
+      ModulePath(ModulePath), ModuleId(ModuleId), GUIDFilter(GUIDFilter) {}
 
 void ModuleSummaryIndexBitcodeReader::addThisModule() {
   TheIndex.addModule(ModulePath, ModuleId);
@@ -7041,6 +7047,9 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
   // "OriginalName" attachement.
   GlobalValueSummary *LastSeenSummary = nullptr;
   GlobalValue::GUID LastSeenGUID = 0;
+  // Whether the last combined summary record was dropped by the GUID filter,
+  // so that a following FS_COMBINED_ORIGINAL_NAME can be dropped with it.
+  bool LastSeenSkipped = false;
 
   // We can expect to see any number of type ID information records before
   // each function summary records; these variables store the information
@@ -7052,6 +7061,23 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
       PendingTypeCheckedLoadConstVCalls;
   std::vector<FunctionSummary::ParamAccess> PendingParamAccesses;
 
+  // Returns true if the summary for the value with the given ID should not be
+  // materialized because the client's GUID filter rejected it.
+  auto ShouldSkipSummary = [&](unsigned ValueID) {
+    return GUIDFilter &&
+           !GUIDFilter(getValueInfoFromValueId(ValueID).first.getGUID());
+  };
+  // The pending records above attach to the next function summary record;
+  // drop them when that summary is skipped.
+  auto DropPendingRecords = [&]() {
+    PendingTypeTests.clear();
+    PendingTypeTestAssumeVCalls.clear();
+    PendingTypeCheckedLoadVCalls.clear();
+    PendingTypeTestAssumeConstVCalls.clear();
+    PendingTypeCheckedLoadConstVCalls.clear();
+    PendingParamAccesses.clear();
+  };
+
   while (true) {
     Expected<BitstreamEntry> MaybeEntry = Stream.advanceSkippingSubblocks();
     if (!MaybeEntry)
@@ -7106,6 +7132,10 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     case bitc::FS_PERMODULE_RELBF:
     case bitc::FS_PERMODULE_PROFILE: {
       unsigned ValueID = Record[0];
+      if (ShouldSkipSummary(ValueID)) {
+        DropPendingRecords();
+        break;
+      }
       uint64_t RawFlags = Record[1];
       unsigned InstCount = Record[2];
       uint64_t RawFunFlags = 0;
@@ -7162,6 +7192,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     // they expect all aliasee summaries to be available.
     case bitc::FS_ALIAS: {
       unsigned ValueID = Record[0];
+      if (ShouldSkipSummary(ValueID))
+        break;
       uint64_t RawFlags = Record[1];
       unsigned AliaseeID = Record[2];
       auto Flags = getDecodedGVSummaryFlags(RawFlags, Version);
@@ -7175,8 +7207,13 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
 
       auto AliaseeVI = getValueInfoFromValueId(AliaseeID).first;
       auto AliaseeInModule = TheIndex.findSummaryInModule(AliaseeVI, ModulePath);
-      if (!AliaseeInModule)
+      if (!AliaseeInModule) {
+        // If the aliasee's summary was dropped by the GUID filter, drop the
+        // alias as well rather than requiring clients to close over aliases.
+        if (GUIDFilter)
+          break;
         return error("Alias expects aliasee summary to be parsed");
+      }
       AS->setAliasee(AliaseeVI, AliaseeInModule);
 
       auto GUID = getValueInfoFromValueId(ValueID);
@@ -7187,6 +7224,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     // FS_PERMODULE_GLOBALVAR_INIT_REFS: [valueid, flags, varflags, n x valueid]
     case bitc::FS_PERMODULE_GLOBALVAR_INIT_REFS: {
       unsigned ValueID = Record[0];
+      if (ShouldSkipSummary(ValueID))
+        break;
       uint64_t RawFlags = Record[1];
       unsigned RefArrayStart = 2;
       GlobalVarSummary::GVarFlags GVF(/* ReadOnly */ false,
@@ -7213,6 +7252,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     //                        n x (valueid, offset)]
     case bitc::FS_PERMODULE_VTABLE_GLOBALVAR_INIT_REFS: {
       unsigned ValueID = Record[0];
+      if (ShouldSkipSummary(ValueID))
+        break;
       uint64_t RawFlags = Record[1];
       GlobalVarSummary::GVarFlags GVF = getDecodedGVarFlags(Record[2]);
       unsigned NumRefs = Record[3];
@@ -7243,6 +7284,12 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     case bitc::FS_COMBINED:
     case bitc::FS_COMBINED_PROFILE: {
       unsigned ValueID = Record[0];
+      if (ShouldSkipSummary(ValueID)) {
+        DropPendingRecords();
+        LastSeenSummary = nullptr;
+        LastSeenSkipped = true;
+        break;
+      }
       uint64_t ModuleId = Record[1];
       uint64_t RawFlags = Record[2];
       unsigned InstCount = Record[3];
@@ -7296,6 +7343,7 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
           std::move(PendingParamAccesses));
       LastSeenSummary = FS.get();
       LastSeenGUID = VI.getGUID();
+      LastSeenSkipped = false;
       FS->setModulePath(ModuleIdMap[ModuleId]);
       TheIndex.addGlobalValueSummary(VI, std::move(FS));
       break;
@@ -7305,12 +7353,18 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     // they expect all aliasee summaries to be available.
     case bitc::FS_COMBINED_ALIAS: {
       unsigned ValueID = Record[0];
+      if (ShouldSkipSummary(ValueID)) {
+        LastSeenSummary = nullptr;
+        LastSeenSkipped = true;
+        break;
+      }
       uint64_t ModuleId = Record[1];
       uint64_t RawFlags = Record[2];
       unsigned AliaseeValueId = Record[3];
       auto Flags = getDecodedGVSummaryFlags(RawFlags, Version);
       auto AS = std::make_unique<AliasSummary>(Flags);
       LastSeenSummary = AS.get();
+      LastSeenSkipped = false;
       AS->setModulePath(ModuleIdMap[ModuleId]);
 
       auto AliaseeVI = getValueInfoFromValueId(AliaseeValueId).first;
@@ -7325,6 +7379,11 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     // FS_COMBINED_GLOBALVAR_INIT_REFS: [valueid, modid, flags, n x valueid]
     case bitc::FS_COMBINED_GLOBALVAR_INIT_REFS: {
       unsigned ValueID = Record[0];
+      if (ShouldSkipSummary(ValueID)) {
+        LastSeenSummary = nullptr;
+        LastSeenSkipped = true;
+        break;
+      }
       uint64_t ModuleId = Record[1];
       uint64_t RawFlags = Record[2];
       unsigned RefArrayStart = 3;
@@ -7342,6 +7401,7 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
       auto FS =
           std::make_unique<GlobalVarSummary>(Flags, GVF, std::move(Refs));
       LastSeenSummary = FS.get();
+      LastSeenSkipped = false;
       FS->setModulePath(ModuleIdMap[ModuleId]);
       ValueInfo VI = getValueInfoFromValueId(ValueID).first;
       LastSeenGUID = VI.getGUID();
@@ -7351,6 +7411,11 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     // FS_COMBINED_ORIGINAL_NAME: [original_name]
     case bitc::FS_COMBINED_ORIGINAL_NAME: {
       uint64_t OriginalName = Record[0];
+      if (LastSeenSkipped) {
+        // Attached to a combined record the GUID filter dropped.
+        LastSeenSkipped = false;
+        break;
+      }
       if (!LastSeenSummary)
         return error("Name attachment that does not follow a combined record");
       LastSeenSummary->setOriginalName(OriginalName);
@@ -7739,25 +7804,27 @@ BitcodeModule::getLazyModule(LLVMContext &Context, bool ShouldLazyLoadMetadata,
 // module path used in the combined summary (e.g. when reading summaries for
 // regular LTO modules).
 Error BitcodeModule::readSummary(ModuleSummaryIndex &CombinedIndex,
-                                 StringRef ModulePath, uint64_t ModuleId) {
+                                 StringRef ModulePath, uint64_t ModuleId,
+                                 SummaryGUIDFilterTy GUIDFilter) {
   BitstreamCursor Stream(Buffer);
   if (Error JumpFailed = Stream.JumpToBit(ModuleBit))
     return JumpFailed;
 
   ModuleSummaryIndexBitcodeReader R(std::move(Stream), Strtab, CombinedIndex,
-                                    ModulePath, ModuleId);
+                                    ModulePath, ModuleId, GUIDFilter);
   return R.parseModule();
 }
 
 // Parse the specified bitcode buffer, returning the function info index.
-Expected<std::unique_ptr<ModuleSummaryIndex>> BitcodeModule::getSummary() {
+Expected<std::unique_ptr<ModuleSummaryIndex>>
+BitcodeModule::getSummary(SummaryGUIDFilterTy GUIDFilter) {
   BitstreamCursor Stream(Buffer);
   if (Error JumpFailed = Stream.JumpToBit(ModuleBit))
     return std::move(JumpFailed);
 
   auto Index = std::make_unique<ModuleSummaryIndex>(/*HaveGVs=*/false);
   ModuleSummaryIndexBitcodeReader R(std::move(Stream), Strtab, *Index,
-                                    ModuleIdentifier, 0);
+                                    ModuleIdentifier, 0, GUIDFilter);
 
   if (Error Err = R.parseModule())
     return std::move(Err);
@@ -7938,21 +8005,24 @@ Expected<std::string> llvm::getBitcodeProducerString(MemoryBufferRef Buffer) {
 
 Error llvm::readModuleSummaryIndex(MemoryBufferRef Buffer,
                                    ModuleSummaryIndex &CombinedIndex,
-                                   uint64_t ModuleId) {
+                                   uint64_t ModuleId,
+                                   SummaryGUIDFilterTy GUIDFilter) {
   Expected<BitcodeModule> BM = getSingleModule(Buffer);
   if (!BM)
     return BM.takeError();
 
-  return BM->readSummary(CombinedIndex, BM->getModuleIdentifier(), ModuleId);
+  return BM->readSummary(CombinedIndex, BM->getModuleIdentifier(), ModuleId,
+                         GUIDFilter);
 }
 
 Expected<std::unique_ptr<ModuleSummaryIndex>>
-llvm::getModuleSummaryIndex(MemoryBufferRef Buffer) {
+llvm::getModuleSummaryIndex(MemoryBufferRef Buffer,
+                            SummaryGUIDFilterTy GUIDFilter) {
   Expected<BitcodeModule> BM = getSingleModule(Buffer);
   if (!BM)
     return BM.takeError();
 
-  return BM->getSummary();
+  return BM->getSummary(GUIDFilter);
 }
 
 Expected<BitcodeLTOInfo> llvm::getBitcodeLTOInfo(MemoryBufferRef Buffer) {
@@ -37,3 +37,55 @@ ActionCache::getOrCompute(const CacheKey &ActionKey,
     return std::move(E);
   return *Result;
 }
+
+Expected<SmallVector<Optional<ObjectRef>, 0>>
+ActionCache::getBatch(ArrayRef<CacheKey> ActionKeys) const {
+  return getBatchImpl(ActionKeys);
+}
+
+Error ActionCache::putBatch(ArrayRef<CacheKey> ActionKeys,
+                            ArrayRef<ObjectRef> Results) {
+  assert(ActionKeys.size() == Results.size() &&
+         "Expected one result per key");
+  return putBatchImpl(ActionKeys, Results);
+}
+
+void ActionCache::putBatchAsync(ArrayRef<CacheKey> ActionKeys,
+                                ArrayRef<ObjectRef> Results,
+                                unique_function<void(Error)> OnDone) {
+  assert(ActionKeys.size() == Results.size() &&
+         "Expected one result per key");
+  putBatchAsyncImpl(ActionKeys, Results, std::move(OnDone));
+}
+
+Expected<SmallVector<Optional<ObjectRef>, 0>>
+ActionCache::getBatchImpl(ArrayRef<CacheKey> ActionKeys) const {
+  SmallVector<Optional<ObjectRef>, 0> Results;
+  Results.reserve(ActionKeys.size());
+  for (const CacheKey &ActionKey : ActionKeys) {
+    Expected<Optional<ObjectRef>> Result =
+        getImpl(arrayRefFromStringRef(ActionKey.getKey()));
+    if (!Result)
+      return Result.takeError();
+    Results.push_back(std::move(*Result));
+  }
+  return std::move(Results);
+}
+
+Error ActionCache::putBatchImpl(ArrayRef<CacheKey> ActionKeys,
+                                ArrayRef<ObjectRef> Results) {
+  // Write every entry even if some fail, joining the errors; a poisoned or
+  // failed entry should not block the rest of the batch.
+  Error AllErrors = Error::success();
+  for (size_t I = 0, E = ActionKeys.size(); I != E; ++I)
+    AllErrors = joinErrors(
+        std::move(AllErrors),
+        putImpl(arrayRefFromStringRef(ActionKeys[I].getKey()), Results[I]));
+  return AllErrors;
+}
+
+void ActionCache::putBatchAsyncImpl(ArrayRef<CacheKey> ActionKeys,
+                                    ArrayRef<ObjectRef> Results,
+                                    unique_function<void(Error)> OnDone) {
+  OnDone(putBatchImpl(ActionKeys, Results));
+}
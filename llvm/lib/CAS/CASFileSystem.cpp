@@ -39,12 +39,23 @@ public:
   Error loadFile(DirectoryEntry &Entry);
   Error loadSymlink(DirectoryEntry &Entry);
 
+  /// Load the single entry named \p Name from \p Parent's tree, without
+  /// materializing sibling entries. Misses are remembered in the parent's
+  /// negative-lookup cache so they don't reload the tree.
+  Expected<DirectoryEntry *> loadDirectoryEntry(DirectoryEntry &Parent,
+                                                StringRef Name);
+
   /// Look up a directory entry in the CAS, navigating trees and resolving
   /// symlinks in the parent path. If \p FollowSymlinks is true, also follows
   /// symlinks in the filename.
   Expected<DirectoryEntry *> lookupPath(StringRef Path,
                                         bool FollowSymlinks = true);
 
+  /// Create the cached entry for \p NewEntry under \p Parent. Requires a
+  /// writer lock on \p Parent's directory.
+  DirectoryEntry &makeCachedEntryAlreadyLocked(DirectoryEntry &Parent,
+                                               const NamedTreeEntry &NewEntry);
+
   ErrorOr<vfs::Status> status(const Twine &Path) final;
   ErrorOr<std::unique_ptr<vfs::File>> openFileForRead(const Twine &Path) final;
 
@@ -154,31 +165,30 @@ std::error_code CASFileSystem::setCurrentWorkingDirectory(const Twine &Path) {
   return std::error_code();
 }
 
+FileSystemCache::DirectoryEntry &
+CASFileSystem::makeCachedEntryAlreadyLocked(DirectoryEntry &Parent,
+                                            const NamedTreeEntry &NewEntry) {
+  SmallString<128> Path = Parent.getTreePath();
+  sys::path::append(Path, sys::path::Style::posix, NewEntry.getName());
+  switch (NewEntry.getKind()) {
+  case TreeEntry::Regular:
+  case TreeEntry::Executable:
+    return Cache->makeLazyFileAlreadyLocked(Parent, Path, NewEntry.getRef(),
+                                            NewEntry.getKind() ==
+                                                TreeEntry::Executable);
+  case TreeEntry::Symlink:
+    return Cache->makeLazySymlinkAlreadyLocked(Parent, Path, NewEntry.getRef());
+  case TreeEntry::Tree:
+    return Cache->makeDirectoryAlreadyLocked(Parent, Path, NewEntry.getRef());
+  }
+  llvm_unreachable("invalid tree type");
+}
+
 Error CASFileSystem::loadDirectory(DirectoryEntry &Parent) {
   Directory &D = Parent.asDirectory();
   if (D.isComplete())
     return Error::success();
 
-  SmallString<128> Path = Parent.getTreePath();
-  size_t ParentPathSize = Path.size();
-  auto makeCachedEntry =
-      [&](const NamedTreeEntry &NewEntry) -> DirectoryEntry & {
-    Path.resize(ParentPathSize);
-    sys::path::append(Path, sys::path::Style::posix, NewEntry.getName());
-    switch (NewEntry.getKind()) {
-    case TreeEntry::Regular:
-    case TreeEntry::Executable:
-      return Cache->makeLazyFileAlreadyLocked(Parent, Path, NewEntry.getRef(),
-                                              NewEntry.getKind() ==
-                                                  TreeEntry::Executable);
-    case TreeEntry::Symlink:
-      return Cache->makeLazySymlinkAlreadyLocked(Parent, Path,
-                                                 NewEntry.getRef());
-    case TreeEntry::Tree:
-      return Cache->makeDirectoryAlreadyLocked(Parent, Path, NewEntry.getRef());
-    }
-    llvm_unreachable("invalid tree type");
-  };
   Expected<ObjectProxy> Object = DB.getProxy(*Parent.getRef());
   if (!Object)
     return Object.takeError();
@@ -199,14 +209,65 @@ Error CASFileSystem::loadDirectory(DirectoryEntry &Parent) {
     return Tree.takeError();
 
   if (Error E = Tree->forEachEntry([&](const NamedTreeEntry &NewEntry) {
-        D.add(makeCachedEntry(NewEntry));
+        // Skip entries already materialized by loadDirectoryEntry().
+        if (!D.lookup(NewEntry.getName()))
+          D.add(makeCachedEntryAlreadyLocked(Parent, NewEntry));
         return Error::success();
       }))
     return E;
   D.IsComplete = true;
+  D.clearNegatives();
   return Error::success();
 }
 
+Expected<CASFileSystem::DirectoryEntry *>
+CASFileSystem::loadDirectoryEntry(DirectoryEntry &Parent, StringRef Name) {
+  Directory &D = Parent.asDirectory();
+
+  {
+    Directory::Reader R(D);
+    if (DirectoryEntry *Existing = D.lookup(Name))
+      return Existing;
+    if (D.isComplete() || D.isKnownMissing(Name))
+      return errorCodeToError(
+          std::make_error_code(std::errc::no_such_file_or_directory));
+  }
+
+  Expected<ObjectProxy> Object = DB.getProxy(*Parent.getRef());
+  if (!Object)
+    return Object.takeError();
+
+  TreeSchema Schema(DB);
+  if (!Schema.isNode(*Object))
+    report_fatal_error(createStringError(
+        inconvertibleErrorCode(),
+        "invalid tree '" + Object->getID().toString() + "'"));
+
+  Expected<TreeProxy> Tree = Schema.load(*Object);
+  if (!Tree)
+    return Tree.takeError();
+
+  // Single-entry lookup. This binary-searches the encoded tree and only
+  // deserializes the entry we need, not its siblings.
+  Optional<NamedTreeEntry> NewEntry = Tree->lookup(Name);
+
+  // Lock and check for a race.
+  Directory::Writer W(D);
+  if (DirectoryEntry *Existing = D.lookup(Name))
+    return Existing;
+  if (!NewEntry) {
+    // Remember the miss so the next lookup of this name (common during
+    // header search) doesn't reload the tree.
+    D.addNegative(Name);
+    return errorCodeToError(
+        std::make_error_code(std::errc::no_such_file_or_directory));
+  }
+
+  DirectoryEntry &Entry = makeCachedEntryAlreadyLocked(Parent, *NewEntry);
+  D.add(Entry);
+  return &Entry;
+}
+
 Error CASFileSystem::loadFile(DirectoryEntry &Entry) {
   assert(Entry.isFile());
 
@@ -313,19 +374,7 @@ private:
 
   Expected<DirectoryEntry *> requestDirectoryEntry(DirectoryEntry &Parent,
                                                    StringRef Name) override {
-    if (Parent.asDirectory().isComplete())
-      return errorCodeToError(
-          std::make_error_code(std::errc::no_such_file_or_directory));
-
-    if (Error E = FS.loadDirectory(Parent))
-      return std::move(E);
-
-    CASFileSystem::Directory &D = Parent.asDirectory();
-    assert(D.isComplete() && "Loaded directory should be complete");
-    if (DirectoryEntry *Entry = D.lookup(Name))
-      return Entry;
-    return errorCodeToError(
-        std::make_error_code(std::errc::no_such_file_or_directory));
+    return FS.loadDirectoryEntry(Parent, Name);
   }
   Error requestSymlinkTarget(DirectoryEntry &Symlink) override {
     return FS.loadSymlink(Symlink);
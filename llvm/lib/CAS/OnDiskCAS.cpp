@@ -54,6 +54,12 @@ public:
     /// extra null character ('\0'). File size is 1 bigger than the data size.
     /// No refs.
     StandaloneLeaf0 = 12,
+
+    /// vX.<TrieRecordOffset>.chunks: standalone, a list of chunk references
+    /// (format of \a ChunkListHandle). The data lives in separate chunk
+    /// objects, split at content-defined boundaries, and is reassembled on
+    /// load. No refs.
+    StandaloneChunked = 13,
   };
 
   enum class ObjectKind : uint8_t {
@@ -67,6 +73,20 @@ public:
   enum Limits : int64_t {
     // Saves files bigger than 64KB standalone instead of embedding them.
     MaxEmbeddedSize = 64LL * 1024LL - 1,
+
+    // Splits leaves at least this big into content-defined chunks so
+    // near-duplicate blobs (PCMs, object files) share chunk storage instead
+    // of occupying full duplicate space.
+    ChunkedObjectThreshold = 1LL * 1024LL * 1024LL,
+
+    // Content-defined chunk boundary parameters: minimum and maximum chunk
+    // sizes, and the number of rolling-hash bits that must be zero at a cut
+    // point (giving ~16KB average chunks). MaxChunkSize stays within
+    // MaxEmbeddedSize so chunks land in the main data pool instead of
+    // spawning standalone files.
+    MinChunkSize = 8LL * 1024LL,
+    AvgChunkSizeLog2 = 14,
+    MaxChunkSize = 48LL * 1024LL,
   };
 
   struct Data {
@@ -586,6 +606,55 @@ private:
   const Header *H = nullptr;
 };
 
+/// Chunk list for a chunked standalone blob: 16B + chunks
+/// - 8-bytes: NumChunks
+/// - 8-bytes: TotalSize       (sum of all chunk sizes)
+/// - NumChunks*16-bytes: {TrieRecordOffset, Size} per chunk, in blob order
+struct ChunkListHandle {
+  struct Header {
+    uint64_t NumChunks;
+    uint64_t TotalSize;
+  };
+
+  struct Entry {
+    uint64_t TrieRecordOffset;
+    uint64_t Size;
+  };
+
+  uint64_t getNumChunks() const { return H->NumChunks; }
+  uint64_t getTotalSize() const { return H->TotalSize; }
+
+  ArrayRef<Entry> getChunks() const {
+    assert(H && "Expected valid handle");
+    return makeArrayRef(reinterpret_cast<const Entry *>(H + 1), getNumChunks());
+  }
+
+  static uint64_t getTotalFileSize(uint64_t NumChunks) {
+    return sizeof(Header) + NumChunks * sizeof(Entry);
+  }
+
+  static ChunkListHandle construct(char *Mem, ArrayRef<Entry> Chunks,
+                                   uint64_t TotalSize) {
+    Header *H = new (Mem) Header{(uint64_t)Chunks.size(), TotalSize};
+    llvm::copy(Chunks, reinterpret_cast<Entry *>(Mem + sizeof(Header)));
+    return ChunkListHandle(*H);
+  }
+
+  static ChunkListHandle get(const char *Mem) {
+    return ChunkListHandle(
+        *reinterpret_cast<const ChunkListHandle::Header *>(Mem));
+  }
+
+  explicit operator bool() const { return H; }
+  const Header &getHeader() const { return *H; }
+
+  ChunkListHandle() = default;
+  explicit ChunkListHandle(const Header &H) : H(&H) {}
+
+private:
+  const Header *H = nullptr;
+};
+
 struct OnDiskContent;
 class StandaloneDataInMemory {
 public:
@@ -606,6 +675,7 @@ public:
     case TrieRecord::StorageKind::Standalone:
     case TrieRecord::StorageKind::StandaloneLeaf:
     case TrieRecord::StorageKind::StandaloneLeaf0:
+    case TrieRecord::StorageKind::StandaloneChunked:
       IsStandalone = true;
       break;
     default:
@@ -746,6 +816,7 @@ public:
   static constexpr StringLiteral FileSuffixData = ".data";
   static constexpr StringLiteral FileSuffixLeaf = ".leaf";
   static constexpr StringLiteral FileSuffixLeaf0 = ".leaf+0";
+  static constexpr StringLiteral FileSuffixChunks = ".chunks";
 
   class TempFile;
   class MappedTempFile;
@@ -760,6 +831,8 @@ public:
                                 ArrayRef<char> Data) final;
 
   Expected<ObjectRef> createStandaloneLeaf(IndexProxy &I, ArrayRef<char> Data);
+  Expected<ObjectRef> createStandaloneChunked(IndexProxy &I,
+                                              ArrayRef<char> Data);
 
   Expected<ObjectRef>
   loadOrCreateDataRecord(IndexProxy &I, TrieRecord::ObjectKind OK,
@@ -776,6 +849,9 @@ public:
   Expected<InternalHandle> loadContentForRef(const IndexProxy &I,
                                              TrieRecord::Data Object,
                                              InternalRef Ref);
+  Expected<InternalHandle>
+  loadChunkedContent(const IndexProxy &I, InternalRef Ref,
+                     std::unique_ptr<MemoryBuffer> ChunkList);
   OnDiskContent getContentFromHandle(InternalHandle Ref) const;
 
   InternalRef getInternalRef(ObjectRef Ref) const {
@@ -912,6 +988,7 @@ constexpr StringLiteral OnDiskCAS::FilePrefix;
 constexpr StringLiteral OnDiskCAS::FileSuffixData;
 constexpr StringLiteral OnDiskCAS::FileSuffixLeaf;
 constexpr StringLiteral OnDiskCAS::FileSuffixLeaf0;
+constexpr StringLiteral OnDiskCAS::FileSuffixChunks;
 
 template <size_t N>
 const StandaloneDataInMemory &
@@ -1365,6 +1442,9 @@ void OnDiskCAS::print(raw_ostream &OS) const {
     case TrieRecord::StorageKind::StandaloneLeaf0:
       OS << "standalone-leaf+0";
       break;
+    case TrieRecord::StorageKind::StandaloneChunked:
+      OS << "standalone-chunks";
+      break;
     }
     OS << " Offset=" << (void *)D.Offset.get();
   });
@@ -1537,6 +1617,7 @@ OnDiskCAS::makeInternalRef(FileOffset IndexOffset,
   case TrieRecord::StorageKind::Standalone:
   case TrieRecord::StorageKind::StandaloneLeaf:
   case TrieRecord::StorageKind::StandaloneLeaf0:
+  case TrieRecord::StorageKind::StandaloneChunked:
     return InternalRef::getFromOffset(InternalRef::OffsetKind::IndexRecord,
                                       IndexOffset);
   }
@@ -1559,6 +1640,9 @@ void OnDiskCAS::getStandalonePath(TrieRecord::StorageKind SK,
   case TrieRecord::StorageKind::StandaloneLeaf:
     Suffix = FileSuffixLeaf;
     break;
+  case TrieRecord::StorageKind::StandaloneChunked:
+    Suffix = FileSuffixChunks;
+    break;
   }
 
   Path.assign(RootPath.begin(), RootPath.end());
@@ -1587,6 +1671,7 @@ Expected<InternalHandle> OnDiskCAS::loadContentForRef(const IndexProxy &I,
   case TrieRecord::StorageKind::Standalone:
   case TrieRecord::StorageKind::StandaloneLeaf0:
   case TrieRecord::StorageKind::StandaloneLeaf:
+  case TrieRecord::StorageKind::StandaloneChunked:
     break;
   }
 
@@ -1602,10 +1687,70 @@ Expected<InternalHandle> OnDiskCAS::loadContentForRef(const IndexProxy &I,
   if (!OwnedBuffer)
     return createCorruptObjectError(getID(I));
 
+  if (Object.SK == TrieRecord::StorageKind::StandaloneChunked)
+    return loadChunkedContent(I, Ref, std::move(*OwnedBuffer));
+
   return InternalHandle(
       StandaloneData.insert(I.Hash, Ref, Object.SK, std::move(*OwnedBuffer)));
 }
 
+Expected<InternalHandle>
+OnDiskCAS::loadChunkedContent(const IndexProxy &I, InternalRef Ref,
+                              std::unique_ptr<MemoryBuffer> ChunkList) {
+  StringRef Bytes = ChunkList->getBuffer();
+  if (Bytes.size() < sizeof(ChunkListHandle::Header))
+    return createCorruptObjectError(getID(I));
+  ChunkListHandle List = ChunkListHandle::get(Bytes.data());
+  if (Bytes.size() != ChunkListHandle::getTotalFileSize(List.getNumChunks()))
+    return createCorruptObjectError(getID(I));
+
+  // Reassemble the blob from its chunk objects. The buffer from
+  // getNewUninitMemBuffer() is null-terminated, which getContent() relies on.
+  std::unique_ptr<WritableMemoryBuffer> Data =
+      WritableMemoryBuffer::getNewUninitMemBuffer(List.getTotalSize());
+  if (!Data)
+    return errorCodeToError(
+        std::make_error_code(std::errc::not_enough_memory));
+
+  char *Next = Data->getBufferStart();
+  uint64_t Remaining = List.getTotalSize();
+  for (const ChunkListHandle::Entry &Chunk : List.getChunks()) {
+    if (Chunk.Size > Remaining)
+      return createCorruptObjectError(getID(I));
+
+    OnDiskHashMappedTrie::const_pointer P =
+        Index.recoverFromFileOffset(FileOffset(Chunk.TrieRecordOffset));
+    if (!P)
+      return createCorruptObjectError(getID(I));
+    IndexProxy ChunkI = getIndexProxyFromPointer(P);
+    TrieRecord::Data ChunkObject = ChunkI.Ref.load();
+    Optional<InternalRef> ChunkRef =
+        makeInternalRef(ChunkI.Offset, ChunkObject);
+    if (!ChunkRef)
+      return createCorruptObjectError(getID(I));
+
+    Optional<InternalHandle> ChunkHandle;
+    if (Error E = loadContentForRef(ChunkI, ChunkObject, *ChunkRef)
+                      .moveInto(ChunkHandle))
+      return std::move(E);
+    OnDiskContent Content = getContentFromHandle(*ChunkHandle);
+    ArrayRef<char> ChunkData =
+        Content.Bytes ? *Content.Bytes : Content.Record->getData();
+    if (ChunkData.size() != Chunk.Size)
+      return createCorruptObjectError(getID(I));
+
+    llvm::copy(ChunkData, Next);
+    Next += ChunkData.size();
+    Remaining -= ChunkData.size();
+  }
+  if (Remaining)
+    return createCorruptObjectError(getID(I));
+
+  return InternalHandle(StandaloneData.insert(
+      I.Hash, Ref, TrieRecord::StorageKind::StandaloneChunked,
+      std::move(Data)));
+}
+
 OnDiskContent OnDiskCAS::getContentFromHandle(InternalHandle Handle) const {
   if (Handle.SDIM)
     return Handle.SDIM->getContent();
@@ -1645,6 +1790,11 @@ OnDiskContent StandaloneDataInMemory::getContent() const {
   case TrieRecord::StorageKind::StandaloneLeaf:
     Leaf = true;
     break;
+  case TrieRecord::StorageKind::StandaloneChunked:
+    // Region is the reassembled, null-terminated blob from
+    // loadChunkedContent(), which behaves just like a leaf.
+    Leaf = true;
+    break;
   }
 
   if (Leaf) {
@@ -1727,6 +1877,103 @@ Expected<ObjectRef> OnDiskCAS::createStandaloneLeaf(IndexProxy &I,
   return getExternalReference(*makeInternalRef(I.Offset, Existing));
 }
 
+/// Byte-mixing table for the Gear rolling hash used to pick chunk boundaries.
+/// Filled deterministically (splitmix64) so boundaries are stable across runs
+/// and processes; changing the constants would silently defeat deduplication
+/// against existing chunk objects.
+static ArrayRef<uint64_t> getGearTable() {
+  static const std::array<uint64_t, 256> Table = [] {
+    std::array<uint64_t, 256> T;
+    uint64_t State = 0;
+    for (uint64_t &Value : T) {
+      State += 0x9e3779b97f4a7c15ULL;
+      uint64_t Z = State;
+      Z = (Z ^ (Z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      Z = (Z ^ (Z >> 27)) * 0x94d049bb133111ebULL;
+      Value = Z ^ (Z >> 31);
+    }
+    return T;
+  }();
+  return makeArrayRef(Table);
+}
+
+/// Returns the size of the first content-defined chunk of \p Data, at least
+/// TrieRecord::MinChunkSize and at most TrieRecord::MaxChunkSize. A boundary
+/// is placed where the low AvgChunkSizeLog2 bits of the rolling hash are all
+/// zero, so an insertion or deletion only shifts boundaries until the hash
+/// resynchronizes and the remaining chunks dedupe against prior ingestions.
+static size_t findChunkBoundary(ArrayRef<char> Data) {
+  if (Data.size() <= (size_t)TrieRecord::MinChunkSize)
+    return Data.size();
+  ArrayRef<uint64_t> Gear = getGearTable();
+  size_t End = std::min(Data.size(), (size_t)TrieRecord::MaxChunkSize);
+  constexpr uint64_t Mask =
+      (uint64_t(1) << TrieRecord::AvgChunkSizeLog2) - 1;
+  uint64_t Hash = 0;
+  for (size_t I = TrieRecord::MinChunkSize; I != End; ++I) {
+    Hash = (Hash << 1) + Gear[(uint8_t)Data[I]];
+    if ((Hash & Mask) == 0)
+      return I + 1;
+  }
+  return End;
+}
+
+Expected<ObjectRef> OnDiskCAS::createStandaloneChunked(IndexProxy &I,
+                                                       ArrayRef<char> Data) {
+  assert(Data.size() >= (uint64_t)TrieRecord::ChunkedObjectThreshold &&
+         "Expected a blob big enough to be worth chunking...");
+
+  // Store each chunk as an ordinary (pooled) leaf object, hashing only the
+  // chunk itself. Chunks shared with previously ingested blobs hit the index
+  // and cost no new storage.
+  SmallVector<ChunkListHandle::Entry, 64> Chunks;
+  for (ArrayRef<char> Rest = Data; !Rest.empty();) {
+    ArrayRef<char> ChunkData = Rest.take_front(findChunkBoundary(Rest));
+    Rest = Rest.drop_front(ChunkData.size());
+
+    HashType ChunkHash =
+        BuiltinObjectHasher<HasherT>::hashObject(*this, None, ChunkData);
+    Optional<ObjectRef> Chunk;
+    if (Error E = storeImpl(ChunkHash, None, ChunkData).moveInto(Chunk))
+      return std::move(E);
+    Optional<FileOffset> ChunkIndexOffset =
+        getIndexOffset(getInternalRef(*Chunk));
+    assert(ChunkIndexOffset && "Expected chunk to have an index record");
+    Chunks.push_back(
+        {(uint64_t)ChunkIndexOffset->get(), (uint64_t)ChunkData.size()});
+  }
+
+  TrieRecord::StorageKind SK = TrieRecord::StorageKind::StandaloneChunked;
+  SmallString<256> Path;
+  getStandalonePath(SK, I, Path);
+
+  // Write the chunk list. As with leaves, don't reuse the read/write mapping;
+  // let load() pull up a read-only one.
+  Expected<MappedTempFile> File =
+      createTempFile(Path, ChunkListHandle::getTotalFileSize(Chunks.size()));
+  if (!File)
+    return File.takeError();
+  ChunkListHandle::construct(File->data(), Chunks, Data.size());
+  if (Error E = File->keep(Path))
+    return std::move(E);
+
+  // Store the object reference.
+  TrieRecord::Data Existing;
+  {
+    TrieRecord::Data Chunked{SK, TrieRecord::ObjectKind::Object, FileOffset()};
+    if (I.Ref.compare_exchange_strong(Existing, Chunked))
+      return getExternalReference(*makeInternalRef(I.Offset, Chunked));
+  }
+
+  // If there was a race, confirm that the new value has valid storage.
+  if (Existing.SK == TrieRecord::StorageKind::Unknown ||
+      Existing.OK != TrieRecord::ObjectKind::Object)
+    return createCorruptObjectError(getID(I));
+
+  // Get and return the inserted node.
+  return getExternalReference(*makeInternalRef(I.Offset, Existing));
+}
+
 Expected<ObjectRef> OnDiskCAS::storeImpl(ArrayRef<uint8_t> ComputedHash,
                                          ArrayRef<ObjectRef> Refs,
                                          ArrayRef<char> Data) {
@@ -1741,9 +1988,12 @@ Expected<ObjectRef> OnDiskCAS::storeImpl(ArrayRef<uint8_t> ComputedHash,
       return createCorruptObjectError(getID(I));
   }
 
-  // Big leaf nodes.
-  if (Refs.empty() && Data.size() > TrieRecord::MaxEmbeddedSize)
+  // Big leaf nodes. The biggest are chunked so near-duplicates share storage.
+  if (Refs.empty() && Data.size() > TrieRecord::MaxEmbeddedSize) {
+    if (Data.size() >= (uint64_t)TrieRecord::ChunkedObjectThreshold)
+      return createStandaloneChunked(I, Data);
     return createStandaloneLeaf(I, Data);
+  }
 
   // TODO: Check whether it's worth checking the index for an already existing
   // object (like storeTreeImpl() does) before building up the
@@ -1125,6 +1125,38 @@ OnDiskHashMappedTrie &
 OnDiskHashMappedTrie::operator=(OnDiskHashMappedTrie &&RHS) = default;
 OnDiskHashMappedTrie::~OnDiskHashMappedTrie() = default;
 
+Expected<ShardedOnDiskHashMappedTrie> ShardedOnDiskHashMappedTrie::create(
+    const Twine &PathTwine, const Twine &TrieNameTwine, size_t NumShardBits,
+    size_t NumHashBits, uint64_t DataSize, uint64_t MaxFileSize,
+    Optional<uint64_t> NewFileInitialSize, Optional<size_t> NewTableNumRootBits,
+    Optional<size_t> NewTableNumSubtrieBits) {
+  SmallString<128> PathStorage;
+  StringRef Path = PathTwine.toStringRef(PathStorage);
+  SmallString<128> TrieNameStorage;
+  StringRef TrieName = TrieNameTwine.toStringRef(TrieNameStorage);
+
+  // The shard is selected by the hash's top byte; more than 256 shards cannot
+  // be addressed (and would be of dubious value anyway).
+  if (NumShardBits > 8)
+    return createStringError(make_error_code(std::errc::argument_out_of_domain),
+                             "sharded trie: too many shard bits: " +
+                                 Twine(NumShardBits) + " (max: 8)");
+
+  size_t NumShards = (size_t)1 << NumShardBits;
+  SmallVector<OnDiskHashMappedTrie, 16> Shards;
+  Shards.reserve(NumShards);
+  for (size_t I = 0; I != NumShards; ++I) {
+    Expected<OnDiskHashMappedTrie> Shard = OnDiskHashMappedTrie::create(
+        Path + ".shard." + Twine(I), TrieName, NumHashBits, DataSize,
+        MaxFileSize, NewFileInitialSize, NewTableNumRootBits,
+        NewTableNumSubtrieBits);
+    if (!Shard)
+      return Shard.takeError();
+    Shards.push_back(std::move(*Shard));
+  }
+  return ShardedOnDiskHashMappedTrie(std::move(Shards));
+}
+
 //===----------------------------------------------------------------------===//
 // DataAllocator data structures.
 //===----------------------------------------------------------------------===//
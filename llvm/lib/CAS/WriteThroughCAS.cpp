@@ -0,0 +1,333 @@
+//===- WriteThroughCAS.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// A layered \a ObjectStore that chains a fast local CAS in front of a slower
+// upstream one. Stores are written through to both layers; loads that miss
+// the local CAS ingest the transitive closure of the requested object from
+// upstream, so a cold scan fetches shared content (e.g. an SDK tree) once per
+// node instead of once per invocation.
+//
+// The upstream store is any \a ObjectStore with the same hash schema. A
+// networked implementation plugs in here: \a ingestFromUpstream() is the walk
+// a remote backend would overlap with pipelined batch requests.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/CAS/ObjectStore.h"
+#include "llvm/Support/Error.h"
+#include <mutex>
+
+using namespace llvm;
+using namespace llvm::cas;
+
+namespace {
+
+class WriteThroughCAS : public ObjectStore {
+public:
+  WriteThroughCAS(std::shared_ptr<ObjectStore> Local,
+                  std::shared_ptr<ObjectStore> Upstream)
+      : Local(std::move(Local)), Upstream(std::move(Upstream)) {}
+
+  StringRef getHashSchemaIdentifier() const final {
+    return Local->getHashSchemaIdentifier();
+  }
+
+  Expected<CASID> parseID(StringRef ID) final { return Local->parseID(ID); }
+
+  Expected<ObjectRef> store(ArrayRef<ObjectRef> Refs,
+                            ArrayRef<char> Data) final;
+
+  CASID getID(ObjectRef Ref) const final {
+    return getEntry(Ref.getInternalRef(*this)).ID;
+  }
+  CASID getID(ObjectHandle Handle) const final {
+    return getEntry(Handle.getInternalRef(*this)).ID;
+  }
+
+  Optional<ObjectRef> getReference(const CASID &ID) const final;
+  Optional<ObjectRef> getReference(ArrayRef<uint8_t> Hash) const final;
+
+  Error validate(const CASID &ID) final {
+    if (Local->getReference(ID))
+      return Local->validate(ID);
+    return Upstream->validate(ID);
+  }
+
+private:
+  /// Every ref/handle handed out wraps an index into \a Entries, so objects
+  /// that only exist upstream can be referenced before they are fetched.
+  struct Entry {
+    CASID ID;
+
+    /// Ref in the local CAS; set once the object has been stored or ingested
+    /// there.
+    Optional<ObjectRef> LocalRef;
+
+    /// Loaded proxy for the local object; set by \a load().
+    Optional<ObjectProxy> Loaded;
+  };
+
+  ObjectRef getReference(ObjectHandle Handle) const final {
+    return makeObjectRef(Handle.getInternalRef(*this));
+  }
+
+  Expected<ObjectHandle> load(ObjectRef Ref) final;
+
+  uint64_t getDataSize(ObjectHandle Node) const final {
+    return getLoadedProxy(Node).getData().size();
+  }
+  ArrayRef<char> getData(ObjectHandle Node,
+                         bool RequiresNullTerminator) const final {
+    return arrayRefFromStringRef<char>(getLoadedProxy(Node).getData());
+  }
+  size_t getNumRefs(ObjectHandle Node) const final {
+    return getLoadedProxy(Node).getNumReferences();
+  }
+  ObjectRef readRef(ObjectHandle Node, size_t I) const final {
+    ObjectRef LocalChild = getLoadedProxy(Node).getReference(I);
+    return makeObjectRef(getOrCreateEntry(Local->getID(LocalChild), LocalChild));
+  }
+  Error forEachRef(ObjectHandle Node,
+                   function_ref<Error(ObjectRef)> Callback) const final {
+    return getLoadedProxy(Node).forEachReference([&](ObjectRef LocalChild) {
+      return Callback(makeObjectRef(
+          getOrCreateEntry(Local->getID(LocalChild), LocalChild)));
+    });
+  }
+
+  Expected<ObjectRef>
+  storeFromOpenFileImpl(sys::fs::file_t FD,
+                        Optional<sys::fs::file_status> Status) final;
+
+  /// No CASIDs are minted with this context; they all come from the local
+  /// CAS, whose context handles hashing and printing.
+  ArrayRef<uint8_t> getHashImpl(const CASID &ID) const final {
+    llvm_unreachable("WriteThroughCAS does not mint CASIDs");
+  }
+  void printIDImpl(raw_ostream &OS, const CASID &ID) const final {
+    llvm_unreachable("WriteThroughCAS does not mint CASIDs");
+  }
+
+  /// Get the index of the entry for \p ID, creating one if necessary. If
+  /// \p LocalRef is provided, it is recorded on the entry.
+  uint64_t getOrCreateEntry(CASID ID, Optional<ObjectRef> LocalRef) const;
+  Entry &getEntry(uint64_t Index) const;
+  ObjectProxy getLoadedProxy(ObjectHandle Node) const;
+
+  /// Get the local ref for one of our refs, ingesting the object (and its
+  /// transitive closure) from upstream if the local CAS doesn't have it yet.
+  Expected<ObjectRef> getOrFetchLocalRef(ObjectRef Ref);
+
+  /// Copy \p UpstreamRef (bottom-up, with its transitive closure) into the
+  /// local CAS. Subtrees already known locally are skipped, since an object's
+  /// refs always exist wherever the object does. This walk is where a remote
+  /// backend pipelines its fetches.
+  Expected<ObjectRef> ingestFromUpstream(ObjectRef UpstreamRef);
+
+  /// Copy \p LocalRef (bottom-up, with its transitive closure) upstream,
+  /// skipping subtrees the upstream already has.
+  Expected<ObjectRef> copyToUpstream(ObjectRef LocalRef);
+
+  std::shared_ptr<ObjectStore> Local;
+  std::shared_ptr<ObjectStore> Upstream;
+
+  mutable std::mutex EntriesMutex;
+  mutable SmallVector<std::unique_ptr<Entry>> Entries;
+  mutable DenseMap<CASID, uint64_t> EntryIndex;
+};
+
+} // end anonymous namespace
+
+uint64_t WriteThroughCAS::getOrCreateEntry(CASID ID,
+                                           Optional<ObjectRef> LocalRef) const {
+  std::lock_guard<std::mutex> Lock(EntriesMutex);
+  auto Insertion = EntryIndex.try_emplace(ID, Entries.size());
+  if (Insertion.second)
+    Entries.push_back(std::make_unique<Entry>(Entry{ID, LocalRef, None}));
+  else if (LocalRef && !Entries[Insertion.first->second]->LocalRef)
+    Entries[Insertion.first->second]->LocalRef = LocalRef;
+  return Insertion.first->second;
+}
+
+WriteThroughCAS::Entry &WriteThroughCAS::getEntry(uint64_t Index) const {
+  std::lock_guard<std::mutex> Lock(EntriesMutex);
+  assert(Index < Entries.size() && "Invalid reference");
+  return *Entries[Index];
+}
+
+ObjectProxy WriteThroughCAS::getLoadedProxy(ObjectHandle Node) const {
+  Entry &E = getEntry(Node.getInternalRef(*this));
+  assert(E.Loaded && "Expected handle only for loaded objects");
+  return *E.Loaded;
+}
+
+Optional<ObjectRef> WriteThroughCAS::getReference(const CASID &ID) const {
+  {
+    std::lock_guard<std::mutex> Lock(EntriesMutex);
+    auto I = EntryIndex.find(ID);
+    if (I != EntryIndex.end())
+      return makeObjectRef(I->second);
+  }
+  if (Optional<ObjectRef> LocalRef = Local->getReference(ID))
+    return makeObjectRef(getOrCreateEntry(ID, LocalRef));
+  if (Upstream->getReference(ID))
+    return makeObjectRef(getOrCreateEntry(ID, None));
+  return None;
+}
+
+Optional<ObjectRef>
+WriteThroughCAS::getReference(ArrayRef<uint8_t> Hash) const {
+  if (Optional<ObjectRef> LocalRef = Local->getReference(Hash))
+    return makeObjectRef(getOrCreateEntry(Local->getID(*LocalRef), LocalRef));
+  if (Optional<ObjectRef> UpstreamRef = Upstream->getReference(Hash))
+    return makeObjectRef(
+        getOrCreateEntry(Upstream->getID(*UpstreamRef), None));
+  return None;
+}
+
+Expected<ObjectRef> WriteThroughCAS::ingestFromUpstream(ObjectRef UpstreamRef) {
+  CASID ID = Upstream->getID(UpstreamRef);
+  if (Optional<ObjectRef> Existing = Local->getReference(ID))
+    return *Existing;
+
+  Expected<ObjectProxy> Node = Upstream->getProxy(UpstreamRef);
+  if (!Node)
+    return Node.takeError();
+
+  SmallVector<ObjectRef> LocalRefs;
+  if (Error E = Node->forEachReference([&](ObjectRef Child) -> Error {
+        Expected<ObjectRef> LocalChild = ingestFromUpstream(Child);
+        if (!LocalChild)
+          return LocalChild.takeError();
+        LocalRefs.push_back(*LocalChild);
+        return Error::success();
+      }))
+    return std::move(E);
+
+  return Local->storeFromString(LocalRefs, Node->getData());
+}
+
+Expected<ObjectRef> WriteThroughCAS::copyToUpstream(ObjectRef LocalRef) {
+  CASID ID = Local->getID(LocalRef);
+  if (Optional<ObjectRef> Existing = Upstream->getReference(ID))
+    return *Existing;
+
+  Expected<ObjectProxy> Node = Local->getProxy(LocalRef);
+  if (!Node)
+    return Node.takeError();
+
+  SmallVector<ObjectRef> UpstreamRefs;
+  if (Error E = Node->forEachReference([&](ObjectRef Child) -> Error {
+        Expected<ObjectRef> UpstreamChild = copyToUpstream(Child);
+        if (!UpstreamChild)
+          return UpstreamChild.takeError();
+        UpstreamRefs.push_back(*UpstreamChild);
+        return Error::success();
+      }))
+    return std::move(E);
+
+  return Upstream->storeFromString(UpstreamRefs, Node->getData());
+}
+
+Expected<ObjectRef> WriteThroughCAS::getOrFetchLocalRef(ObjectRef Ref) {
+  Entry &E = getEntry(Ref.getInternalRef(*this));
+  {
+    std::lock_guard<std::mutex> Lock(EntriesMutex);
+    if (E.LocalRef)
+      return *E.LocalRef;
+  }
+
+  Optional<ObjectRef> UpstreamRef = Upstream->getReference(E.ID);
+  if (!UpstreamRef)
+    return createUnknownObjectError(E.ID);
+
+  Expected<ObjectRef> LocalRef = ingestFromUpstream(*UpstreamRef);
+  if (!LocalRef)
+    return LocalRef.takeError();
+
+  std::lock_guard<std::mutex> Lock(EntriesMutex);
+  if (!E.LocalRef)
+    E.LocalRef = *LocalRef;
+  return *E.LocalRef;
+}
+
+Expected<ObjectRef> WriteThroughCAS::store(ArrayRef<ObjectRef> Refs,
+                                           ArrayRef<char> Data) {
+  SmallVector<ObjectRef> LocalRefs;
+  for (ObjectRef Ref : Refs) {
+    Expected<ObjectRef> LocalRef = getOrFetchLocalRef(Ref);
+    if (!LocalRef)
+      return LocalRef.takeError();
+    LocalRefs.push_back(*LocalRef);
+  }
+
+  Expected<ObjectRef> LocalRef = Local->store(LocalRefs, Data);
+  if (!LocalRef)
+    return LocalRef.takeError();
+
+  if (Expected<ObjectRef> UpstreamRef = copyToUpstream(*LocalRef))
+    ; // Written through.
+  else
+    return UpstreamRef.takeError();
+
+  return makeObjectRef(getOrCreateEntry(Local->getID(*LocalRef), *LocalRef));
+}
+
+Expected<ObjectRef>
+WriteThroughCAS::storeFromOpenFileImpl(sys::fs::file_t FD,
+                                       Optional<sys::fs::file_status> Status) {
+  Expected<ObjectRef> LocalRef = Local->storeFromOpenFile(FD, Status);
+  if (!LocalRef)
+    return LocalRef.takeError();
+
+  if (Expected<ObjectRef> UpstreamRef = copyToUpstream(*LocalRef))
+    ; // Written through.
+  else
+    return UpstreamRef.takeError();
+
+  return makeObjectRef(getOrCreateEntry(Local->getID(*LocalRef), *LocalRef));
+}
+
+Expected<ObjectHandle> WriteThroughCAS::load(ObjectRef Ref) {
+  uint64_t Index = Ref.getInternalRef(*this);
+  {
+    Entry &E = getEntry(Index);
+    std::lock_guard<std::mutex> Lock(EntriesMutex);
+    if (E.Loaded)
+      return makeObjectHandle(Index);
+  }
+
+  Expected<ObjectRef> LocalRef = getOrFetchLocalRef(Ref);
+  if (!LocalRef)
+    return LocalRef.takeError();
+
+  Expected<ObjectProxy> Loaded = Local->getProxy(*LocalRef);
+  if (!Loaded)
+    return Loaded.takeError();
+
+  Entry &E = getEntry(Index);
+  std::lock_guard<std::mutex> Lock(EntriesMutex);
+  if (!E.Loaded)
+    E.Loaded = *Loaded;
+  return makeObjectHandle(Index);
+}
+
+Expected<std::unique_ptr<ObjectStore>>
+cas::createWriteThroughCAS(std::shared_ptr<ObjectStore> LocalCAS,
+                           std::shared_ptr<ObjectStore> UpstreamCAS) {
+  if (LocalCAS->getHashSchemaIdentifier() !=
+      UpstreamCAS->getHashSchemaIdentifier())
+    return createStringError(
+        std::make_error_code(std::errc::invalid_argument),
+        "write-through CAS requires matching hash schemas");
+  return std::make_unique<WriteThroughCAS>(std::move(LocalCAS),
+                                           std::move(UpstreamCAS));
+}
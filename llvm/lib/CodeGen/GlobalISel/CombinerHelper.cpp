@@ -5819,11 +5819,19 @@ bool CombinerHelper::matchAddSubSameReg(MachineInstr &MI, Register &Src) {
 }
 
 bool CombinerHelper::tryCombine(MachineInstr &MI) {
-  if (tryCombineCopy(MI))
-    return true;
-  if (tryCombineExtendingLoads(MI))
-    return true;
-  if (tryCombineIndexedLoadStore(MI))
-    return true;
-  return false;
+  // Dispatch on the opcode first so each instruction only pays for the
+  // combines that can possibly match it, the same way the tblgen-erated
+  // combiners partition their rules by opcode.
+  switch (MI.getOpcode()) {
+  case TargetOpcode::COPY:
+    return tryCombineCopy(MI);
+  case TargetOpcode::G_LOAD:
+  case TargetOpcode::G_SEXTLOAD:
+  case TargetOpcode::G_ZEXTLOAD:
+    return tryCombineExtendingLoads(MI) || tryCombineIndexedLoadStore(MI);
+  case TargetOpcode::G_STORE:
+    return tryCombineIndexedLoadStore(MI);
+  default:
+    return false;
+  }
 }
@@ -540,6 +540,28 @@ LiveRange::iterator LiveRange::addSegment(Segment S) {
   return CalcLiveRangeUtilVector(this).addSegment(S);
 }
 
+void LiveRange::addSegments(ArrayRef<Segment> Segments) {
+  if (Segments.empty())
+    return;
+  // Fall back to one-at-a-time insertion while the segment set is active;
+  // it already gives cheap insertions during initial computation.
+  if (segmentSet != nullptr) {
+    for (const Segment &S : Segments)
+      addSegmentToSet(S);
+    return;
+  }
+  // Present the segments to the updater in start order so every add hits its
+  // fast path, and let it merge them into the vector in a single pass.
+  SmallVector<Segment, 16> Sorted(Segments.begin(), Segments.end());
+  llvm::sort(Sorted, [](const Segment &A, const Segment &B) {
+    return A.start < B.start;
+  });
+  LiveRangeUpdater Updater(this);
+  for (const Segment &S : Sorted)
+    Updater.add(S);
+  // The updater flushes on destruction.
+}
+
 void LiveRange::append(const Segment S) {
   // Check that the segment belongs to the back of the list.
   assert(segments.empty() || segments.back().end <= S.start);
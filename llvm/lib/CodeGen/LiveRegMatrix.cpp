@@ -115,6 +115,7 @@ void LiveRegMatrix::assign(const LiveInterval &VirtReg, MCRegister PhysReg) {
       });
 
   ++NumAssigned;
+  ++ModificationCount;
   LLVM_DEBUG(dbgs() << '\n');
 }
 
@@ -132,6 +133,7 @@ void LiveRegMatrix::unassign(const LiveInterval &VirtReg) {
               });
 
   ++NumUnassigned;
+  ++ModificationCount;
   LLVM_DEBUG(dbgs() << '\n');
 }
 
@@ -31,6 +31,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/MachineInstr.h"
 #include "llvm/CodeGen/MachineRegisterInfo.h"
 #include "llvm/CodeGen/Passes.h"
@@ -41,6 +42,13 @@
 #include <algorithm>
 using namespace llvm;
 
+#define DEBUG_TYPE "livevars"
+
+STATISTIC(NumAliveBlockElements,
+          "Number of 128-bit elements backing AliveBlocks sets");
+STATISTIC(NumAliveBlockIntervals,
+          "Number of intervals an interval set encoding AliveBlocks would use");
+
 char LiveVariables::ID = 0;
 char &llvm::LiveVariablesID = LiveVariables::ID;
 INITIALIZE_PASS_BEGIN(LiveVariables, "livevars",
@@ -660,6 +668,29 @@ bool LiveVariables::runOnMachineFunction(MachineFunction &mf) {
     assert(Visited.contains(&MBB) && "unreachable basic block found");
 #endif
 
+  // Account the footprint of the per-virtreg AliveBlocks sets, both as
+  // SparseBitVector stores them (one heap-allocated element per 128-block
+  // chunk with a live block) and as the number of contiguous block-number
+  // intervals an interval-set representation would store instead. The latter
+  // quantifies what switching representation would save on a given workload
+  // before committing to a migration of all AliveBlocks clients.
+  if (AreStatisticsEnabled()) {
+    // Must match the default ElementSize of SparseBitVector.
+    constexpr unsigned BlocksPerElement = 128;
+    for (unsigned I = 0, E = VirtRegInfo.size(); I != E; ++I) {
+      const VarInfo &VI = VirtRegInfo[Register::index2VirtReg(I)];
+      unsigned PrevBlock = ~0u;
+      for (unsigned BBNum : VI.AliveBlocks) {
+        if (PrevBlock == ~0u || BBNum / BlocksPerElement !=
+                                    PrevBlock / BlocksPerElement)
+          ++NumAliveBlockElements;
+        if (PrevBlock == ~0u || BBNum != PrevBlock + 1)
+          ++NumAliveBlockIntervals;
+        PrevBlock = BBNum;
+      }
+    }
+  }
+
   PhysRegDef.clear();
   PhysRegUse.clear();
   PHIVarInfo.clear();
@@ -60,6 +60,7 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
 #include "llvm/CodeGen/LivePhysRegs.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
 #include "llvm/CodeGen/MachineOptimizationRemarkEmitter.h"
@@ -113,6 +114,19 @@ static cl::opt<unsigned> OutlinerReruns(
     cl::desc(
         "Number of times to rerun the outliner after the initial outline"));
 
+/// With profile data, skip mapping functions whose entry count is hot. Hot
+/// code rarely pays for the call overhead of outlining, and keeping it out of
+/// the suffix tree shrinks the tree for large modules.
+static cl::opt<bool> OutlinerSkipHotFunctions(
+    "machine-outliner-skip-hot-functions", cl::init(false), cl::Hidden,
+    cl::desc("Do not map profile-hot functions into the outliner's "
+             "suffix tree"));
+
+static cl::opt<unsigned> OutlinerBenefitThreshold(
+    "outliner-benefit-threshold", cl::init(1), cl::Hidden,
+    cl::desc(
+        "The minimum size in bytes before an outlining candidate is accepted"));
+
 namespace {
 
 /// Maps \p MachineInstrs to unsigned integers and stores the mappings.
@@ -368,6 +382,7 @@ struct MachineOutliner : public ModulePass {
   void getAnalysisUsage(AnalysisUsage &AU) const override {
     AU.addRequired<MachineModuleInfoWrapperPass>();
     AU.addPreserved<MachineModuleInfoWrapperPass>();
+    AU.addRequired<ProfileSummaryInfoWrapperPass>();
     AU.setPreservesAll();
     ModulePass::getAnalysisUsage(AU);
   }
@@ -463,8 +478,11 @@ ModulePass *createMachineOutlinerPass(bool RunOnAllFunctions) {
 
 } // namespace llvm
 
-INITIALIZE_PASS(MachineOutliner, DEBUG_TYPE, "Machine Function Outliner", false,
-                false)
+INITIALIZE_PASS_BEGIN(MachineOutliner, DEBUG_TYPE, "Machine Function Outliner",
+                      false, false)
+INITIALIZE_PASS_DEPENDENCY(ProfileSummaryInfoWrapperPass)
+INITIALIZE_PASS_END(MachineOutliner, DEBUG_TYPE, "Machine Function Outliner",
+                    false, false)
 
 void MachineOutliner::emitNotOutliningCheaperRemark(
     unsigned StringLen, std::vector<Candidate> &CandidatesForRepeatedSeq,
@@ -597,7 +615,7 @@ void MachineOutliner::findCandidates(
       continue;
 
     // Is it better to outline this candidate than not?
-    if (OF.getBenefit() < 1) {
+    if (OF.getBenefit() < OutlinerBenefitThreshold) {
       emitNotOutliningCheaperRemark(StringLen, CandidatesForRepeatedSeq, OF);
       continue;
     }
@@ -875,6 +893,9 @@ bool MachineOutliner::outline(Module &M,
 
 void MachineOutliner::populateMapper(InstructionMapper &Mapper, Module &M,
                                      MachineModuleInfo &MMI) {
+  ProfileSummaryInfo *PSI =
+      &getAnalysis<ProfileSummaryInfoWrapperPass>().getPSI();
+
   // Build instruction mappings for each function in the module. Start by
   // iterating over each Function in M.
   for (Function &F : M) {
@@ -884,6 +905,13 @@ void MachineOutliner::populateMapper(InstructionMapper &Mapper, Module &M,
     if (F.empty())
       continue;
 
+    // Hot functions are unlikely to be worth the call overhead of outlining,
+    // and skipping them early keeps their instructions out of the suffix
+    // tree entirely.
+    if (OutlinerSkipHotFunctions && PSI->hasProfileSummary() &&
+        PSI->isFunctionEntryHot(&F))
+      continue;
+
     // There's something in F. Check if it has a MachineFunction associated with
     // it.
     MachineFunction *MF = MMI.getMachineFunction(F);
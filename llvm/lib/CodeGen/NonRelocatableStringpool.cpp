@@ -7,7 +7,6 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/CodeGen/NonRelocatableStringpool.h"
-#include "llvm/ADT/STLExtras.h"
 
 namespace llvm {
 
@@ -40,15 +39,14 @@ StringRef NonRelocatableStringpool::internString(StringRef S) {
 
 std::vector<DwarfStringPoolEntryRef>
 NonRelocatableStringpool::getEntriesForEmission() const {
-  std::vector<DwarfStringPoolEntryRef> Result;
-  Result.reserve(Strings.size());
+  // Indexes are assigned from a dense counter in insertion order, so the
+  // entries can be placed directly instead of being sorted.
+  std::vector<DwarfStringPoolEntryRef> Result(NumEntries);
   for (const auto &E : Strings)
-    if (E.getValue().isIndexed())
-      Result.emplace_back(E);
-  llvm::sort(Result, [](const DwarfStringPoolEntryRef A,
-                        const DwarfStringPoolEntryRef B) {
-    return A.getIndex() < B.getIndex();
-  });
+    if (E.getValue().isIndexed()) {
+      assert(E.getValue().Index < NumEntries && "unexpected entry index");
+      Result[E.getValue().Index] = DwarfStringPoolEntryRef(E);
+    }
   return Result;
 }
 
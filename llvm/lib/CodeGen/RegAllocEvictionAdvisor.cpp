@@ -13,6 +13,7 @@
 #include "RegAllocEvictionAdvisor.h"
 #include "AllocationOrder.h"
 #include "RegAllocGreedy.h"
+#include "llvm/ADT/bit.h"
 #include "llvm/CodeGen/LiveRegMatrix.h"
 #include "llvm/CodeGen/MachineFunction.h"
 #include "llvm/CodeGen/RegisterClassInfo.h"
@@ -43,6 +44,13 @@ static cl::opt<bool> EnableLocalReassignment(
              "may be compile time intensive"),
     cl::init(false));
 
+static cl::opt<bool> EnableEvictionCostCache(
+    "regalloc-eviction-cost-cache", cl::Hidden,
+    cl::desc("Cache eviction cost evaluations until the interference matrix "
+             "changes. This avoids rescoring the same candidates when large "
+             "functions cycle through the priority queue."),
+    cl::init(true));
+
 cl::opt<unsigned> EvictInterferenceCutoff(
     "regalloc-eviction-max-interference-cutoff", cl::Hidden,
     cl::desc("Number of interferences after which we declare "
@@ -185,6 +193,45 @@ bool DefaultEvictionAdvisor::canEvictHintInterference(
 bool DefaultEvictionAdvisor::canEvictInterferenceBasedOnCost(
     const LiveInterval &VirtReg, MCRegister PhysReg, bool IsHint,
     EvictionCost &MaxCost, const SmallVirtRegSet &FixedRegisters) const {
+  // Evaluations made during last-chance recoloring depend on FixedRegisters
+  // and are not worth caching.
+  if (!EnableEvictionCostCache || !FixedRegisters.empty())
+    return canEvictInterferenceBasedOnCostImpl(VirtReg, PhysReg, IsHint,
+                                               MaxCost, FixedRegisters);
+
+  // Cached verdicts depend on the current assignments, cascade numbers, and
+  // hint satisfaction. All of those only change together with the matrix
+  // contents, so a change of its modification count invalidates the cache.
+  if (CachedModCount != Matrix->getModificationCount()) {
+    EvictionCostCache.clear();
+    CachedModCount = Matrix->getModificationCount();
+  }
+
+  // The verdict also depends on the thresholds in MaxCost, so they are part
+  // of the key.
+  EvictionCostCacheKey Key(
+      (uint64_t(VirtReg.reg().id()) << 32) | (uint64_t(PhysReg.id()) << 1) |
+          IsHint,
+      (uint64_t(llvm::bit_cast<uint32_t>(MaxCost.MaxWeight)) << 32) |
+          MaxCost.BrokenHints);
+
+  auto It = EvictionCostCache.find(Key);
+  if (It != EvictionCostCache.end()) {
+    ++NumSavedCostEvaluations;
+    if (It->second.CanEvict)
+      MaxCost = It->second.Cost;
+    return It->second.CanEvict;
+  }
+
+  bool CanEvict = canEvictInterferenceBasedOnCostImpl(VirtReg, PhysReg, IsHint,
+                                                      MaxCost, FixedRegisters);
+  EvictionCostCache[Key] = {MaxCost, CanEvict};
+  return CanEvict;
+}
+
+bool DefaultEvictionAdvisor::canEvictInterferenceBasedOnCostImpl(
+    const LiveInterval &VirtReg, MCRegister PhysReg, bool IsHint,
+    EvictionCost &MaxCost, const SmallVirtRegSet &FixedRegisters) const {
   // It is only possible to evict virtual register interference.
   if (Matrix->checkInterference(VirtReg, PhysReg) > LiveRegMatrix::IK_VirtReg)
     return false;
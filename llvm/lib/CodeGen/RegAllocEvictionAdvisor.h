@@ -10,6 +10,7 @@
 #define LLVM_CODEGEN_REGALLOCEVICTIONADVISOR_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/StringRef.h"
@@ -119,6 +120,10 @@ public:
   /// not been used for allocation yet.
   bool isUnusedCalleeSavedReg(MCRegister PhysReg) const;
 
+  /// Number of interference-cost evaluations this advisor was able to skip,
+  /// e.g. by caching. The allocator reports this as an optimization remark.
+  virtual unsigned getNumSavedCostEvaluations() const { return 0; }
+
 protected:
   RegAllocEvictionAdvisor(const MachineFunction &MF, const RAGreedy &RA);
 
@@ -214,8 +219,29 @@ private:
   bool canEvictInterferenceBasedOnCost(const LiveInterval &, MCRegister, bool,
                                        EvictionCost &,
                                        const SmallVirtRegSet &) const;
+  bool canEvictInterferenceBasedOnCostImpl(const LiveInterval &, MCRegister,
+                                           bool, EvictionCost &,
+                                           const SmallVirtRegSet &) const;
   bool shouldEvict(const LiveInterval &A, bool, const LiveInterval &B,
                    bool) const;
+
+  unsigned getNumSavedCostEvaluations() const override {
+    return NumSavedCostEvaluations;
+  }
+
+  /// Cached canEvictInterferenceBasedOnCost() evaluations, keyed by the
+  /// registers involved and the query thresholds. The verdicts are only valid
+  /// while the interference matrix is unchanged; CachedModCount tracks the
+  /// matrix state the cache was filled for.
+  using EvictionCostCacheKey = std::pair<uint64_t, uint64_t>;
+  struct EvictionCostCacheEntry {
+    EvictionCost Cost;
+    bool CanEvict;
+  };
+  mutable DenseMap<EvictionCostCacheKey, EvictionCostCacheEntry>
+      EvictionCostCache;
+  mutable uint64_t CachedModCount = ~uint64_t(0);
+  mutable unsigned NumSavedCostEvaluations = 0;
 };
 } // namespace llvm
 
@@ -2652,6 +2652,20 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   postOptimization();
   reportStats();
 
+  if (unsigned NumSaved = EvictAdvisor->getNumSavedCostEvaluations()) {
+    ORE->emit([&]() {
+      DebugLoc Loc;
+      if (auto *SP = MF->getFunction().getSubprogram())
+        Loc = DILocation::get(SP->getContext(), SP->getLine(), 1, SP);
+      MachineOptimizationRemarkAnalysis R(DEBUG_TYPE, "EvictionCostCache", Loc,
+                                          &MF->front());
+      R << "eviction cost cache saved "
+        << ore::NV("NumSavedCostEvaluations", NumSaved)
+        << " interference evaluations";
+      return R;
+    });
+  }
+
   releaseMemory();
   return true;
 }
@@ -161,6 +161,9 @@ void RegPressureTracker::increaseRegPressure(Register RegUnit,
   PSetIterator PSetI = MRI->getPressureSets(RegUnit);
   unsigned Weight = PSetI.getWeight();
   for (; PSetI.isValid(); ++PSetI) {
+    if (SnapshotActive)
+      SnapshotLog.push_back(
+          {*PSetI, CurrSetPressure[*PSetI], P.MaxSetPressure[*PSetI]});
     CurrSetPressure[*PSetI] += Weight;
     P.MaxSetPressure[*PSetI] =
         std::max(P.MaxSetPressure[*PSetI], CurrSetPressure[*PSetI]);
@@ -170,7 +173,21 @@ void RegPressureTracker::increaseRegPressure(Register RegUnit,
 void RegPressureTracker::decreaseRegPressure(Register RegUnit,
                                              LaneBitmask PreviousMask,
                                              LaneBitmask NewMask) {
-  decreaseSetPressure(CurrSetPressure, *MRI, RegUnit, PreviousMask, NewMask);
+  if (!SnapshotActive) {
+    decreaseSetPressure(CurrSetPressure, *MRI, RegUnit, PreviousMask, NewMask);
+    return;
+  }
+  if (NewMask.any() || PreviousMask.none())
+    return;
+
+  PSetIterator PSetI = MRI->getPressureSets(RegUnit);
+  unsigned Weight = PSetI.getWeight();
+  for (; PSetI.isValid(); ++PSetI) {
+    assert(CurrSetPressure[*PSetI] >= Weight && "register pressure underflow");
+    SnapshotLog.push_back(
+        {*PSetI, CurrSetPressure[*PSetI], P.MaxSetPressure[*PSetI]});
+    CurrSetPressure[*PSetI] -= Weight;
+  }
 }
 
 /// Clear the result so it can be used for another round of pressure tracking.
@@ -255,6 +272,8 @@ void RegPressureTracker::reset() {
 
   LiveRegs.clear();
   UntiedDefs.clear();
+  SnapshotLog.clear();
+  SnapshotActive = false;
 }
 
 /// Setup the RegPressureTracker.
@@ -956,15 +975,50 @@ void RegPressureTracker::advance() {
   advance(RegOpers);
 }
 
-/// Find the max change in excess pressure across all sets.
-static void computeExcessPressureDelta(ArrayRef<unsigned> OldPressureVec,
+void RegPressureTracker::beginPressureSnapshot() {
+  assert(!SnapshotActive && "cannot nest pressure snapshots");
+  SnapshotLog.clear();
+  SnapshotActive = true;
+}
+
+ArrayRef<PressureSnapshotEntry> RegPressureTracker::pressureSnapshotChanges() {
+  assert(SnapshotActive && "no pressure snapshot in flight");
+  // An instruction may change the same set several times (e.g. a kill followed
+  // by a def); only the first log entry per set holds the pre-snapshot values.
+  llvm::stable_sort(SnapshotLog, [](const PressureSnapshotEntry &A,
+                                    const PressureSnapshotEntry &B) {
+    return A.PSet < B.PSet;
+  });
+  SnapshotLog.erase(std::unique(SnapshotLog.begin(), SnapshotLog.end(),
+                                [](const PressureSnapshotEntry &A,
+                                   const PressureSnapshotEntry &B) {
+                                  return A.PSet == B.PSet;
+                                }),
+                    SnapshotLog.end());
+  return SnapshotLog;
+}
+
+void RegPressureTracker::rollbackPressureSnapshot() {
+  assert(SnapshotActive && "no pressure snapshot in flight");
+  // Walking backwards makes repeated entries for one set undo in the right
+  // order; after pressureSnapshotChanges() the direction no longer matters.
+  for (const PressureSnapshotEntry &E : llvm::reverse(SnapshotLog)) {
+    CurrSetPressure[E.PSet] = E.CurrPressure;
+    P.MaxSetPressure[E.PSet] = E.MaxPressure;
+  }
+  SnapshotActive = false;
+}
+
+/// Find the max change in excess pressure across the changed sets.
+static void computeExcessPressureDelta(ArrayRef<PressureSnapshotEntry> Changes,
                                        ArrayRef<unsigned> NewPressureVec,
                                        RegPressureDelta &Delta,
                                        const RegisterClassInfo *RCI,
                                        ArrayRef<unsigned> LiveThruPressureVec) {
   Delta.Excess = PressureChange();
-  for (unsigned i = 0, e = OldPressureVec.size(); i < e; ++i) {
-    unsigned POld = OldPressureVec[i];
+  for (const PressureSnapshotEntry &E : Changes) {
+    unsigned i = E.PSet;
+    unsigned POld = E.CurrPressure;
     unsigned PNew = NewPressureVec[i];
     int PDiff = (int)PNew - (int)POld;
     if (!PDiff) // No change in this set in the common case.
@@ -991,12 +1045,9 @@ static void computeExcessPressureDelta(ArrayRef<unsigned> OldPressureVec,
 }
 
 /// Find the max change in max pressure that either surpasses a critical PSet
-/// limit or exceeds the current MaxPressureLimit.
-///
-/// FIXME: comparing each element of the old and new MaxPressure vectors here is
-/// silly. It's done now to demonstrate the concept but will go away with a
-/// RegPressureTracker API change to work with pressure differences.
-static void computeMaxPressureDelta(ArrayRef<unsigned> OldMaxPressureVec,
+/// limit or exceeds the current MaxPressureLimit. \p Changes must be sorted by
+/// ascending PSet to match the order of \p CriticalPSets.
+static void computeMaxPressureDelta(ArrayRef<PressureSnapshotEntry> Changes,
                                     ArrayRef<unsigned> NewMaxPressureVec,
                                     ArrayRef<PressureChange> CriticalPSets,
                                     ArrayRef<unsigned> MaxPressureLimit,
@@ -1005,8 +1056,9 @@ static void computeMaxPressureDelta(ArrayRef<unsigned> OldMaxPressureVec,
   Delta.CurrentMax = PressureChange();
 
   unsigned CritIdx = 0, CritEnd = CriticalPSets.size();
-  for (unsigned i = 0, e = OldMaxPressureVec.size(); i < e; ++i) {
-    unsigned POld = OldMaxPressureVec[i];
+  for (const PressureSnapshotEntry &E : Changes) {
+    unsigned i = E.PSet;
+    unsigned POld = E.MaxPressure;
     unsigned PNew = NewMaxPressureVec[i];
     if (PNew == POld) // No change in this set in the common case.
       continue;
@@ -1096,24 +1148,21 @@ getMaxUpwardPressureDelta(const MachineInstr *MI, PressureDiff *PDiff,
                           RegPressureDelta &Delta,
                           ArrayRef<PressureChange> CriticalPSets,
                           ArrayRef<unsigned> MaxPressureLimit) {
-  // Snapshot Pressure.
-  // FIXME: The snapshot heap space should persist. But I'm planning to
-  // summarize the pressure effect so we don't need to snapshot at all.
-  std::vector<unsigned> SavedPressure = CurrSetPressure;
-  std::vector<unsigned> SavedMaxPressure = P.MaxSetPressure;
+  // Checkpoint pressure so the bump can be rolled back afterwards.
+  beginPressureSnapshot();
 
   bumpUpwardPressure(MI);
 
-  computeExcessPressureDelta(SavedPressure, CurrSetPressure, Delta, RCI,
+  ArrayRef<PressureSnapshotEntry> Changes = pressureSnapshotChanges();
+  computeExcessPressureDelta(Changes, CurrSetPressure, Delta, RCI,
                              LiveThruPressure);
-  computeMaxPressureDelta(SavedMaxPressure, P.MaxSetPressure, CriticalPSets,
+  computeMaxPressureDelta(Changes, P.MaxSetPressure, CriticalPSets,
                           MaxPressureLimit, Delta);
   assert(Delta.CriticalMax.getUnitInc() >= 0 &&
          Delta.CurrentMax.getUnitInc() >= 0 && "cannot decrease max pressure");
 
   // Restore the tracker's state.
-  P.MaxSetPressure.swap(SavedMaxPressure);
-  CurrSetPressure.swap(SavedPressure);
+  rollbackPressureSnapshot();
 
 #ifndef NDEBUG
   if (!PDiff)
@@ -1344,22 +1393,21 @@ void RegPressureTracker::
 getMaxDownwardPressureDelta(const MachineInstr *MI, RegPressureDelta &Delta,
                             ArrayRef<PressureChange> CriticalPSets,
                             ArrayRef<unsigned> MaxPressureLimit) {
-  // Snapshot Pressure.
-  std::vector<unsigned> SavedPressure = CurrSetPressure;
-  std::vector<unsigned> SavedMaxPressure = P.MaxSetPressure;
+  // Checkpoint pressure so the bump can be rolled back afterwards.
+  beginPressureSnapshot();
 
   bumpDownwardPressure(MI);
 
-  computeExcessPressureDelta(SavedPressure, CurrSetPressure, Delta, RCI,
+  ArrayRef<PressureSnapshotEntry> Changes = pressureSnapshotChanges();
+  computeExcessPressureDelta(Changes, CurrSetPressure, Delta, RCI,
                              LiveThruPressure);
-  computeMaxPressureDelta(SavedMaxPressure, P.MaxSetPressure, CriticalPSets,
+  computeMaxPressureDelta(Changes, P.MaxSetPressure, CriticalPSets,
                           MaxPressureLimit, Delta);
   assert(Delta.CriticalMax.getUnitInc() >= 0 &&
          Delta.CurrentMax.getUnitInc() >= 0 && "cannot decrease max pressure");
 
   // Restore the tracker's state.
-  P.MaxSetPressure.swap(SavedMaxPressure);
-  CurrSetPressure.swap(SavedPressure);
+  rollbackPressureSnapshot();
 }
 
 /// Get the pressure of each PSet after traversing this instruction bottom-up.
@@ -556,6 +556,24 @@ void ScheduleDAGInstrs::addChainDependency (SUnit *SUa, SUnit *SUb,
 ///
 /// MachineScheduler relies on initSUnits numbering the nodes by their order in
 /// the original instruction list.
+/// Prepares the DAG storage for a new region. Unlike clearDAG(), the SUnit
+/// array from the previous region is kept as a pool: newSUnit() assigns over
+/// the old slots, reusing their heap-allocated edge vectors. Rebuilding those
+/// vectors from the heap for every region is a major source of allocation
+/// traffic when scheduling.
+void ScheduleDAGInstrs::resetDAGForRegion() {
+  // Remember the edge density of the retiring region so the next one can
+  // pre-size the edge vectors of SUnits created from scratch.
+  unsigned NumEdges = 0;
+  for (const SUnit &SU : SUnits)
+    NumEdges += SU.Preds.size();
+  PrevRegionAvgEdges = SUnits.empty() ? 0 : NumEdges / SUnits.size() + 1;
+
+  NextSUnit = 0;
+  EntrySU = SUnit();
+  ExitSU = SUnit();
+}
+
 void ScheduleDAGInstrs::initSUnits() {
   // We'll be allocating one SUnit for each real instruction in the region,
   // which is contained within a basic block.
@@ -600,6 +618,11 @@ void ScheduleDAGInstrs::initSUnits() {
       }
     }
   }
+
+  // Drop any pool slots left over from a larger previous region so the node
+  // count matches this region again. This only destroys elements; pointers to
+  // the surviving SUnits stay valid.
+  SUnits.resize(NextSUnit);
 }
 
 class ScheduleDAGInstrs::Value2SUsMap : public MapVector<ValueType, SUList> {
@@ -731,7 +754,7 @@ void ScheduleDAGInstrs::buildSchedGraph(AAResults *AA,
 
   this->TrackLaneMasks = TrackLaneMasks;
   MISUnitMap.clear();
-  ScheduleDAG::clearDAG();
+  resetDAGForRegion();
 
   // Create an SUnit for each real instruction.
   initSUnits();
@@ -104,6 +104,11 @@ static cl::opt<int> MaxLdStGlue("ldstmemcpy-glue-max",
        cl::desc("Number limit for gluing ld/st of memcpy."),
        cl::Hidden, cl::init(0));
 
+static cl::opt<bool> EnableArenaClear("sdag-arena-clear",
+       cl::Hidden, cl::init(false),
+       cl::desc("Release all SelectionDAG nodes wholesale in clear() instead "
+                "of returning each node to the recycler free lists"));
+
 static void NewSDValueDbgMsg(SDValue V, StringRef Msg, SelectionDAG *G) {
   LLVM_DEBUG(dbgs() << Msg; V.getNode()->dump(G););
 }
@@ -1350,7 +1355,20 @@ SDNode *SelectionDAG::FindNodeOrInsertPos(const FoldingSetNodeID &ID,
 }
 
 void SelectionDAG::clear() {
-  allnodes_clear();
+  if (EnableArenaClear) {
+    // Drop every node at once. The per-node teardown in allnodes_clear() only
+    // maintains the recycler free lists, use lists and side tables, all of
+    // which are reset wholesale below; node and operand memory is reclaimed
+    // by resetting the underlying bump allocators.
+    assert(&*AllNodes.begin() == &EntryNode);
+    AllNodes.clearAndLeakNodesUnsafely();
+    NodeAllocator.Reset();
+#ifndef NDEBUG
+    NextPersistentId = 0;
+#endif
+  } else {
+    allnodes_clear();
+  }
   OperandRecycler.clear(OperandAllocator);
   OperandAllocator.Reset();
   CSEMap.clear();
@@ -63,6 +63,9 @@ void TargetSchedModel::init(const TargetSubtargetInfo *TSInfo) {
     unsigned NumUnits = SchedModel.getProcResource(Idx)->NumUnits;
     ResourceFactors[Idx] = NumUnits ? (ResourceLCM / NumUnits) : 0;
   }
+
+  SchedClassLatencies.assign(
+      SchedModel.hasInstrSchedModel() ? SchedModel.NumSchedClasses : 0, ~0u);
 }
 
 /// Returns true only if instruction is specified as single issue.
@@ -238,6 +241,18 @@ unsigned TargetSchedModel::computeOperandLatency(
 
 unsigned
 TargetSchedModel::computeInstrLatency(const MCSchedClassDesc &SCDesc) const {
+  // Resolved (non-variant) class latencies are constant for the lifetime of
+  // this model; serve them from the flattened table instead of re-walking the
+  // write latency entries on every query.
+  if (!SchedClassLatencies.empty()) {
+    size_t SCIdx = &SCDesc - SchedModel.getSchedClassDesc(0);
+    if (SCIdx < SchedClassLatencies.size()) {
+      unsigned &Latency = SchedClassLatencies[SCIdx];
+      if (Latency == ~0u)
+        Latency = capLatency(MCSchedModel::computeInstrLatency(*STI, SCDesc));
+      return Latency;
+    }
+  }
   return capLatency(MCSchedModel::computeInstrLatency(*STI, SCDesc));
 }
 
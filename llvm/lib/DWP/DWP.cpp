@@ -18,6 +18,7 @@
 #include "llvm/Object/Decompressor.h"
 #include "llvm/Object/ELFObjectFile.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include <limits>
 
 using namespace llvm;
@@ -584,17 +585,41 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs) {
 
   std::deque<SmallString<32>> UncompressedSections;
 
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
-    if (!ErrOrObj) {
-      return handleErrors(ErrOrObj.takeError(),
-                          [&](std::unique_ptr<ECError> EC) -> Error {
-                            return createFileError(Input, Error(std::move(EC)));
-                          });
-    }
-
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+  // Reading and parsing the input files is independent per file, so do it up
+  // front in parallel. The merge loop below runs in input order, which keeps
+  // the emitted sections and the index deterministic.
+  std::vector<OwningBinary<object::ObjectFile>> ParsedObjects(Inputs.size());
+  std::vector<Error> ParseErrors;
+  ParseErrors.reserve(Inputs.size());
+  for (size_t I = 0, E = Inputs.size(); I != E; ++I)
+    ParseErrors.push_back(Error::success());
+  parallelFor(0, Inputs.size(), [&](size_t I) {
+    auto ErrOrObj = object::ObjectFile::createObjectFile(Inputs[I]);
+    if (ErrOrObj)
+      ParsedObjects[I] = std::move(*ErrOrObj);
+    else
+      ParseErrors[I] = ErrOrObj.takeError();
+  });
+  // Report parse failures in input order, and make sure every error is
+  // consumed.
+  Error ParseError = Error::success();
+  for (size_t I = 0, E = Inputs.size(); I != E; ++I) {
+    if (!ParseErrors[I])
+      continue;
+    Error Err = handleErrors(
+        std::move(ParseErrors[I]), [&](std::unique_ptr<ECError> EC) -> Error {
+          return createFileError(Inputs[I], Error(std::move(EC)));
+        });
+    ParseError = joinErrors(std::move(ParseError), std::move(Err));
+  }
+  if (ParseError)
+    return ParseError;
+
+  for (size_t InputIdx = 0, InputEnd = Inputs.size(); InputIdx != InputEnd;
+       ++InputIdx) {
+    const auto &Input = Inputs[InputIdx];
+    auto &Obj = *ParsedObjects[InputIdx].getBinary();
+    Objects.push_back(std::move(ParsedObjects[InputIdx]));
 
     UnitIndexEntry CurEntry = {};
 
@@ -758,7 +758,7 @@ DWARFCompileUnit *DWARFContext::getDWOCompileUnitForHash(uint64_t Hash) {
 }
 
 DWARFDie DWARFContext::getDIEForOffset(uint64_t Offset) {
-  parseNormalUnits();
+  parseNormalUnits(LazyParse);
   if (auto *CU = NormalUnits.getUnitForOffset(Offset))
     return CU->getDIEForOffset(Offset);
   return DWARFDie();
@@ -1019,9 +1019,25 @@ void DWARFContext::clearLineTableForUnit(DWARFUnit *U) {
   Line->clearLineTable(stmtOffset);
 }
 
-void DWARFContext::parseNormalUnits() {
-  if (!NormalUnits.empty())
+void DWARFContext::parseNormalUnits(bool Lazy) {
+  if (NormalUnitsParsed)
     return;
+  if (Lazy) {
+    if (NormalUnitsLazyIndexed)
+      return;
+    // Offset-keyed lookup assumes a single debug_info section; fall back to
+    // eager parsing in the rare multi-section case.
+    unsigned NumInfoSections = 0;
+    DObj->forEachInfoSections([&](const DWARFSection &S) { ++NumInfoSections; });
+    if (NumInfoSections == 1) {
+      DObj->forEachInfoSections([&](const DWARFSection &S) {
+        NormalUnits.addUnitsForSection(*this, S, DW_SECT_INFO, LazyParse);
+      });
+      NormalUnits.finishedInfoUnits();
+      NormalUnitsLazyIndexed = true;
+      return;
+    }
+  }
   DObj->forEachInfoSections([&](const DWARFSection &S) {
     NormalUnits.addUnitsForSection(*this, S, DW_SECT_INFO);
   });
@@ -1029,6 +1045,7 @@ void DWARFContext::parseNormalUnits() {
   DObj->forEachTypesSections([&](const DWARFSection &S) {
     NormalUnits.addUnitsForSection(*this, S, DW_SECT_EXT_TYPES);
   });
+  NormalUnitsParsed = true;
 }
 
 void DWARFContext::parseDWOUnits(bool Lazy) {
@@ -1044,7 +1061,7 @@ void DWARFContext::parseDWOUnits(bool Lazy) {
 }
 
 DWARFCompileUnit *DWARFContext::getCompileUnitForOffset(uint64_t Offset) {
-  parseNormalUnits();
+  parseNormalUnits(LazyParse);
   return dyn_cast_or_null<DWARFCompileUnit>(
       NormalUnits.getUnitForOffset(Offset));
 }
@@ -534,6 +534,9 @@ void DWARFDebugLine::LineTable::clear() {
   Prologue.clear();
   Rows.clear();
   Sequences.clear();
+  PathCache.clear();
+  PathCacheCompDir.clear();
+  PathCacheKind = DILineInfoSpecifier::FileLineInfoKind::None;
 }
 
 DWARFDebugLine::ParsingState::ParsingState(
@@ -1401,6 +1404,30 @@ bool DWARFDebugLine::Prologue::getFileNameByIndex(
   return true;
 }
 
+bool DWARFDebugLine::LineTable::getFileNameByIndex(
+    uint64_t FileIndex, StringRef CompDir, FileLineInfoKind Kind,
+    std::string &Result) const {
+  // Symbolizing many addresses in the same unit keeps resolving a handful of
+  // file indices, but building the path walks the include directory table and
+  // concatenates strings every time. Memoize the materialized paths. CompDir
+  // and Kind rarely (if ever) change for a given table; when they do, drop
+  // the cache rather than keying on them.
+  if (Kind != PathCacheKind || CompDir != PathCacheCompDir) {
+    PathCache.clear();
+    PathCacheCompDir = std::string(CompDir);
+    PathCacheKind = Kind;
+  }
+  auto It = PathCache.find(FileIndex);
+  if (It != PathCache.end()) {
+    Result = It->second;
+    return true;
+  }
+  if (!Prologue.getFileNameByIndex(FileIndex, CompDir, Kind, Result))
+    return false;
+  PathCache.try_emplace(FileIndex, Result);
+  return true;
+}
+
 bool DWARFDebugLine::LineTable::getFileLineInfoForAddress(
     object::SectionedAddress Address, const char *CompDir,
     FileLineInfoKind Kind, DILineInfo &Result) const {
@@ -41,12 +41,13 @@ using namespace dwarf;
 
 void DWARFUnitVector::addUnitsForSection(DWARFContext &C,
                                          const DWARFSection &Section,
-                                         DWARFSectionKind SectionKind) {
+                                         DWARFSectionKind SectionKind,
+                                         bool Lazy) {
   const DWARFObject &D = C.getDWARFObj();
   addUnitsImpl(C, D, Section, C.getDebugAbbrev(), &D.getRangesSection(),
                &D.getLocSection(), D.getStrSection(),
                D.getStrOffsetsSection(), &D.getAddrSection(),
-               D.getLineSection(), D.isLittleEndian(), false, false,
+               D.getLineSection(), D.isLittleEndian(), false, Lazy,
                SectionKind);
 }
 
@@ -109,8 +110,24 @@ void DWARFUnitVector::addUnitsImpl(
       return U;
     };
   }
-  if (Lazy)
+  if (Lazy) {
+    // For DWO sections, units are found through the unit index. For normal
+    // sections, build an index of unit boundaries by reading just the initial
+    // length field of each header so a unit can later be materialized by
+    // offset without parsing every header in the section.
+    if (!IsDWO) {
+      uint64_t Offset = 0;
+      while (Data.isValidOffset(Offset)) {
+        uint64_t UnitOffset = Offset;
+        uint64_t Length = Data.getInitialLength(&Offset).first;
+        if (!Length)
+          break;
+        LazyUnitOffsets.push_back(UnitOffset);
+        Offset += Length;
+      }
+    }
     return;
+  }
   // Find a reasonable insertion point within the vector.  We skip over
   // (a) units from a different section, (b) units from the same section
   // but with lower offset-within-section.  This keeps units in order
@@ -121,6 +138,10 @@ void DWARFUnitVector::addUnitsImpl(
   while (Data.isValidOffset(Offset)) {
     if (I != this->end() &&
         (&(*I)->getInfoSection() != &Section || (*I)->getOffset() == Offset)) {
+      // Skip over units that were already materialized from a lazy boundary
+      // index, continuing the scan at the following unit.
+      if (&(*I)->getInfoSection() == &Section)
+        Offset = (*I)->getNextUnitOffset();
       ++I;
       continue;
     }
@@ -154,6 +175,37 @@ DWARFUnit *DWARFUnitVector::getUnitForOffset(uint64_t Offset) const {
   return nullptr;
 }
 
+DWARFUnit *DWARFUnitVector::getUnitForOffset(uint64_t Offset) {
+  if (DWARFUnit *U =
+          static_cast<const DWARFUnitVector &>(*this).getUnitForOffset(Offset))
+    return U;
+
+  if (!Parser || LazyUnitOffsets.empty())
+    return nullptr;
+
+  // Find the start of the unit that would contain Offset in the boundary
+  // index and materialize just that unit.
+  auto Boundary = llvm::upper_bound(LazyUnitOffsets, Offset);
+  if (Boundary == LazyUnitOffsets.begin())
+    return nullptr;
+  uint64_t UnitOffset = *std::prev(Boundary);
+  auto U = Parser(UnitOffset, DW_SECT_INFO, nullptr, nullptr);
+  if (!U || Offset >= U->getNextUnitOffset())
+    return nullptr;
+
+  auto end = begin() + getNumInfoUnits();
+  auto I =
+      std::upper_bound(begin(), end, UnitOffset,
+                       [](uint64_t LHS, const std::unique_ptr<DWARFUnit> &RHS) {
+                         return LHS < RHS->getNextUnitOffset();
+                       });
+  auto *NewU = U.get();
+  this->insert(I, std::move(U));
+  if (NumInfoUnits != -1)
+    ++NumInfoUnits;
+  return NewU;
+}
+
 DWARFUnit *
 DWARFUnitVector::getUnitForIndexEntry(const DWARFUnitIndex::Entry &E) {
   const auto *CUOff = E.getContribution(DW_SECT_INFO);
@@ -29,6 +29,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
 #include <map>
@@ -335,23 +336,60 @@ bool DWARFVerifier::handleDebugAbbrev() {
 
 unsigned DWARFVerifier::verifyUnits(const DWARFUnitVector &Units) {
   unsigned NumDebugInfoErrors = 0;
-  ReferenceMap CrossUnitReferences;
+  unsigned NumUnits = Units.getNumUnits();
 
-  unsigned Index = 1;
+  // Extracting a unit's DIEs populates caches that are shared between units:
+  // the abbreviation declaration sets and the context's line tables. Force
+  // extraction up front, while we are still single-threaded, so the per-unit
+  // verification below only reads shared state.
   for (const auto &Unit : Units) {
-    OS << "Verifying unit: " << Index << " / " << Units.getNumUnits();
-    if (const char* Name = Unit->getUnitDIE(true).getShortName())
-      OS << ", \"" << Name << '\"';
-    OS << '\n';
-    OS.flush();
-    ReferenceMap UnitLocalReferences;
-    NumDebugInfoErrors +=
-        verifyUnitContents(*Unit, UnitLocalReferences, CrossUnitReferences);
-    NumDebugInfoErrors += verifyDebugInfoReferences(
-        UnitLocalReferences, [&](uint64_t Offset) { return Unit.get(); });
-    ++Index;
+    Unit->getUnitDIE(false);
+    DCtx.getLineTableForUnit(Unit.get());
+  }
+
+  // Units are independent of one another until the cross-unit reference check
+  // at the end, so verify them concurrently. Each task writes its diagnostics
+  // through a verifier of its own into a per-unit buffer; the buffers are
+  // emitted in unit order afterwards, matching the serial output.
+  struct UnitResult {
+    SmallString<0> Output;
+    ReferenceMap CrossUnitReferences;
+    unsigned NumErrors = 0;
+  };
+  std::vector<UnitResult> Results(NumUnits);
+
+  ThreadPool Pool;
+  for (unsigned I = 0; I < NumUnits; ++I) {
+    Pool.async([&, I]() {
+      DWARFUnit &Unit = *Units[I];
+      UnitResult &Result = Results[I];
+      raw_svector_ostream UnitOS(Result.Output);
+      UnitOS << "Verifying unit: " << (I + 1) << " / " << NumUnits;
+      if (const char *Name = Unit.getUnitDIE(true).getShortName())
+        UnitOS << ", \"" << Name << '\"';
+      UnitOS << '\n';
+      DWARFVerifier UnitVerifier(UnitOS, DCtx, DumpOpts);
+      ReferenceMap UnitLocalReferences;
+      Result.NumErrors += UnitVerifier.verifyUnitContents(
+          Unit, UnitLocalReferences, Result.CrossUnitReferences);
+      Result.NumErrors += UnitVerifier.verifyDebugInfoReferences(
+          UnitLocalReferences, [&](uint64_t Offset) { return &Unit; });
+    });
+  }
+  Pool.wait();
+
+  ReferenceMap CrossUnitReferences;
+  for (UnitResult &Result : Results) {
+    OS << Result.Output;
+    NumDebugInfoErrors += Result.NumErrors;
+    for (const auto &Ref : Result.CrossUnitReferences)
+      CrossUnitReferences[Ref.first].insert(Ref.second.begin(),
+                                            Ref.second.end());
   }
 
+  if (DumpOpts.VerifyQuick)
+    return NumDebugInfoErrors;
+
   NumDebugInfoErrors += verifyDebugInfoReferences(
       CrossUnitReferences, [&](uint64_t Offset) -> DWARFUnit * {
         if (DWARFUnit *U = Units.getUnitForOffset(Offset))
@@ -28,8 +28,12 @@
 #include "llvm/Support/DataExtractor.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Signals.h"
+#include <cmath>
 #include <algorithm>
 #include <cassert>
 #include <cstring>
@@ -74,7 +78,7 @@ LLVMSymbolizer::symbolizeCodeCommon(const T &ModuleSpecifier,
       ModuleOffset, DILineInfoSpecifier(Opts.PathStyle, Opts.PrintFunctions),
       Opts.UseSymbolTable);
   if (Opts.Demangle)
-    LineInfo.FunctionName = DemangleName(LineInfo.FunctionName, Info);
+    LineInfo.FunctionName = demangleNameCached(LineInfo.FunctionName, Info);
   return LineInfo;
 }
 
@@ -121,7 +125,7 @@ Expected<DIInliningInfo> LLVMSymbolizer::symbolizeInlinedCodeCommon(
   if (Opts.Demangle) {
     for (int i = 0, n = InlinedContext.getNumberOfFrames(); i < n; i++) {
       auto *Frame = InlinedContext.getMutableFrame(i);
-      Frame->FunctionName = DemangleName(Frame->FunctionName, Info);
+      Frame->FunctionName = demangleNameCached(Frame->FunctionName, Info);
     }
   }
   return InlinedContext;
@@ -168,7 +172,7 @@ LLVMSymbolizer::symbolizeDataCommon(const T &ModuleSpecifier,
 
   DIGlobal Global = Info->symbolizeData(ModuleOffset);
   if (Opts.Demangle)
-    Global.Name = DemangleName(Global.Name, Info);
+    Global.Name = demangleNameCached(Global.Name, Info);
   return Global;
 }
 
@@ -239,6 +243,7 @@ void LLVMSymbolizer::flush() {
   ObjectPairForPathArch.clear();
   Modules.clear();
   BuildIDPaths.clear();
+  DemangledNames.clear();
 }
 
 namespace {
@@ -746,6 +751,21 @@ LLVMSymbolizer::DemangleName(const std::string &Name,
   return Name;
 }
 
+std::string LLVMSymbolizer::demangleNameCached(
+    const std::string &Name, const SymbolizableModule *DbiModuleDescriptor) {
+  // Microsoft demangling depends on the module the name came from, so names
+  // from Win32 modules cannot be memoized in a per-symbolizer cache.
+  if ((!Name.empty() && Name.front() == '?') ||
+      (DbiModuleDescriptor && DbiModuleDescriptor->isWin32Module()))
+    return DemangleName(Name, DbiModuleDescriptor);
+  auto I = DemangledNames.find(Name);
+  if (I == DemangledNames.end())
+    I = DemangledNames
+            .try_emplace(Name, DemangleName(Name, DbiModuleDescriptor))
+            .first;
+  return I->second;
+}
+
 void LLVMSymbolizer::recordAccess(CachedBinary &Bin) {
   if (Bin->getBinary())
     LRUBinaries.splice(LRUBinaries.end(), LRUBinaries, Bin.getIterator());
@@ -764,6 +784,85 @@ void LLVMSymbolizer::pruneCache() {
   }
 }
 
+// The symbolizer used for in-process crash symbolization. Created once by
+// enableInProcessSymbolization and intentionally never destroyed: it must
+// stay usable from the signal handler until process exit.
+static LLVMSymbolizer *InProcessCrashSymbolizer = nullptr;
+
+static bool symbolizeStackTraceInProcess(void **StackTrace, int Depth,
+                                         const char **Modules,
+                                         const intptr_t *Offsets,
+                                         raw_ostream &OS) {
+  LLVMSymbolizer *Symbolizer = InProcessCrashSymbolizer;
+  if (!Symbolizer)
+    return false;
+
+  // This report format matches the one Support/Signals.cpp produces from
+  // llvm-symbolizer output.
+  int FrameNo = 0;
+  auto PrintLineHeader = [&](void *PC) {
+    OS << right_justify(formatv("#{0}", FrameNo++).str(),
+                        std::log10(Depth) + 2)
+       << ' ' << format_hex((uint64_t)PC, 2 + 2 * sizeof(void *)) << ' ';
+  };
+  auto PrintRawLocation = [&](int I) {
+    OS << '(' << Modules[I] << '+' << format_hex(Offsets[I], 0) << ")\n";
+  };
+
+  for (int I = 0; I < Depth; ++I) {
+    if (!Modules[I]) {
+      PrintLineHeader(StackTrace[I]);
+      OS << '\n';
+      continue;
+    }
+    Expected<DIInliningInfo> InfoOrErr = Symbolizer->symbolizeInlinedCode(
+        std::string(Modules[I]),
+        {(uint64_t)Offsets[I], object::SectionedAddress::UndefSection});
+    if (!InfoOrErr) {
+      consumeError(InfoOrErr.takeError());
+      PrintLineHeader(StackTrace[I]);
+      PrintRawLocation(I);
+      continue;
+    }
+    if (InfoOrErr->getNumberOfFrames() == 0) {
+      PrintLineHeader(StackTrace[I]);
+      PrintRawLocation(I);
+      continue;
+    }
+    for (uint32_t F = 0, E = InfoOrErr->getNumberOfFrames(); F != E; ++F) {
+      const DILineInfo &Frame = InfoOrErr->getFrame(F);
+      PrintLineHeader(StackTrace[I]);
+      if (Frame.FunctionName != DILineInfo::BadString)
+        OS << Frame.FunctionName << ' ';
+      if (Frame.FileName != DILineInfo::BadString)
+        OS << Frame.FileName << ':' << Frame.Line << ':' << Frame.Column
+           << '\n';
+      else
+        PrintRawLocation(I);
+    }
+  }
+  return true;
+}
+
+void enableInProcessSymbolization() {
+  if (InProcessCrashSymbolizer)
+    return;
+  InProcessCrashSymbolizer = new LLVMSymbolizer();
+
+  // Pre-warm the index for our own image: parsing its debug info on first use
+  // is the expensive part of symbolization, and doing it now means it is
+  // already resident when a crash report is produced.
+  std::string MainExecutableName = sys::fs::getMainExecutable(nullptr, nullptr);
+  if (!MainExecutableName.empty()) {
+    Expected<DILineInfo> Info = InProcessCrashSymbolizer->symbolizeCode(
+        MainExecutableName, {0, object::SectionedAddress::UndefSection});
+    if (!Info)
+      consumeError(Info.takeError());
+  }
+
+  sys::setInProcessSymbolizer(symbolizeStackTraceInProcess);
+}
+
 void CachedBinary::pushEvictor(std::function<void()> NewEvictor) {
   if (Evictor) {
     this->Evictor = [OldEvictor = std::move(this->Evictor),
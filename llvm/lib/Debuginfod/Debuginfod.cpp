@@ -37,9 +37,11 @@
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/xxhash.h"
 
 #include <atomic>
+#include <mutex>
 #include <thread>
 
 namespace llvm {
@@ -85,6 +87,17 @@ std::chrono::milliseconds getDefaultDebuginfodTimeout() {
   return std::chrono::milliseconds(90 * 1000);
 }
 
+unsigned getDefaultDebuginfodConnections() {
+  unsigned Connections;
+  const char *DebuginfodConnectionsEnv = std::getenv("DEBUGINFOD_CONNECTIONS");
+  if (DebuginfodConnectionsEnv &&
+      to_integer(StringRef(DebuginfodConnectionsEnv).trim(), Connections, 10) &&
+      Connections > 0)
+    return std::min(Connections, 16u);
+
+  return 4;
+}
+
 /// The following functions fetch a debuginfod artifact to a file in a local
 /// cache and return the cached file path. They first search the local cache,
 /// followed by the debuginfod servers.
@@ -134,37 +147,66 @@ Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
 
 namespace {
 
-/// A simple handler which streams the returned data to a cache file. The cache
-/// file is only created if a 200 OK status is observed.
-class StreamedHTTPResponseHandler : public HTTPResponseHandler {
-  using CreateStreamFn =
-      std::function<Expected<std::unique_ptr<CachedFileStream>>()>;
-  CreateStreamFn CreateStream;
-  HTTPClient &Client;
-  std::unique_ptr<CachedFileStream> FileStream;
+/// A simple handler which streams the response body to a chunk file, recording
+/// the total artifact size when the server reports it via Content-Range.
+class ChunkedHTTPResponseHandler : public HTTPResponseHandler {
+  raw_fd_ostream &OS;
 
 public:
-  StreamedHTTPResponseHandler(CreateStreamFn CreateStream, HTTPClient &Client)
-      : CreateStream(CreateStream), Client(Client) {}
-  virtual ~StreamedHTTPResponseHandler() = default;
+  /// Total size of the complete artifact, per the Content-Range header of a
+  /// 206 Partial Content response.
+  Optional<uint64_t> TotalSize;
+
+  explicit ChunkedHTTPResponseHandler(raw_fd_ostream &OS) : OS(OS) {}
+  virtual ~ChunkedHTTPResponseHandler() = default;
+
+  Error handleHeaderLine(StringRef HeaderLine) override {
+    // "Content-Range: bytes <first>-<last>/<total>" carries the size of the
+    // complete artifact.
+    auto NameAndValue = HeaderLine.split(':');
+    if (!NameAndValue.first.trim().equals_insensitive("content-range"))
+      return Error::success();
+    StringRef Total = NameAndValue.second.rsplit('/').second.trim();
+    uint64_t Size;
+    if (Total != "*" && to_integer(Total, Size, 10))
+      TotalSize = Size;
+    return Error::success();
+  }
 
-  Error handleBodyChunk(StringRef BodyChunk) override;
+  Error handleBodyChunk(StringRef BodyChunk) override {
+    OS << BodyChunk;
+    return Error::success();
+  }
 };
 
 } // namespace
 
-Error StreamedHTTPResponseHandler::handleBodyChunk(StringRef BodyChunk) {
-  if (!FileStream) {
-    if (Client.responseCode() != 200)
-      return Error::success();
-    Expected<std::unique_ptr<CachedFileStream>> FileStreamOrError =
-        CreateStream();
-    if (!FileStreamOrError)
-      return FileStreamOrError.takeError();
-    FileStream = std::move(*FileStreamOrError);
-  }
-  *FileStream->OS << BodyChunk;
-  return Error::success();
+/// Artifacts larger than one chunk are downloaded with several concurrent
+/// ranged requests and reassembled; servers without range support stream the
+/// whole artifact in response to the first request.
+static constexpr uint64_t DownloadChunkSize = 64 * 1024 * 1024;
+
+/// Downloads the byte range [Offset, Offset+Size) of ArtifactUrl to ChunkPath.
+/// On success sets ResponseCode and returns the total artifact size if the
+/// server reported one via Content-Range.
+static Expected<Optional<uint64_t>>
+downloadChunk(StringRef ArtifactUrl, uint64_t Offset, uint64_t Size,
+              StringRef ChunkPath, std::chrono::milliseconds Timeout,
+              unsigned &ResponseCode) {
+  std::error_code EC;
+  raw_fd_ostream OS(ChunkPath, EC);
+  if (EC)
+    return errorCodeToError(EC);
+  HTTPClient Client;
+  Client.setTimeout(Timeout);
+  ChunkedHTTPResponseHandler Handler(OS);
+  HTTPRequest Request(ArtifactUrl);
+  Request.Headers.push_back("Range: bytes=" + utostr(Offset) + "-" +
+                            utostr(Offset + Size - 1));
+  if (Error Err = Client.perform(Request, Handler))
+    return std::move(Err);
+  ResponseCode = Client.responseCode();
+  return Handler.TotalSize;
 }
 
 Expected<std::string> getCachedOrDownloadArtifact(
@@ -201,23 +243,101 @@ Expected<std::string> getCachedOrDownloadArtifact(
         "allow Debuginfod to make HTTP requests, call HTTPClient::initialize() "
         "at the beginning of main.");
 
-  HTTPClient Client;
-  Client.setTimeout(Timeout);
   for (StringRef ServerUrl : DebuginfodUrls) {
     SmallString<64> ArtifactUrl;
     sys::path::append(ArtifactUrl, sys::path::Style::posix, ServerUrl, UrlPath);
 
-    // Perform the HTTP request and if successful, write the response body to
-    // the cache.
-    StreamedHTTPResponseHandler Handler([&]() { return CacheAddStream(Task); },
-                                        Client);
-    HTTPRequest Request(ArtifactUrl);
-    Error Err = Client.perform(Request, Handler);
-    if (Err)
-      return std::move(Err);
-
-    if (Client.responseCode() != 200)
+    auto ChunkPath = [&](uint64_t I) {
+      SmallString<64> Path = AbsCachedArtifactPath;
+      Path += ".chunk";
+      Path += utostr(I);
+      return Path;
+    };
+
+    // Request the first chunk. Servers that ignore the Range header stream
+    // the entire artifact in this response; servers with range support answer
+    // 206 and report the total artifact size, allowing the remaining chunks
+    // to be fetched concurrently.
+    unsigned Code = 0;
+    Expected<Optional<uint64_t>> TotalSizeOrErr = downloadChunk(
+        ArtifactUrl, 0, DownloadChunkSize, ChunkPath(0), Timeout, Code);
+    if (!TotalSizeOrErr)
+      return TotalSizeOrErr.takeError();
+    if (Code != 200 && Code != 206) {
+      sys::fs::remove(ChunkPath(0));
       continue;
+    }
+
+    uint64_t NumChunks = 1;
+    uint64_t TotalSize = 0;
+    if (Code == 206) {
+      // A 206 response without a total size is malformed; try the next
+      // server.
+      if (!*TotalSizeOrErr) {
+        sys::fs::remove(ChunkPath(0));
+        continue;
+      }
+      TotalSize = **TotalSizeOrErr;
+      NumChunks = std::max<uint64_t>(
+          1, (TotalSize + DownloadChunkSize - 1) / DownloadChunkSize);
+    }
+
+    if (NumChunks > 1) {
+      // Fetch the remaining chunks concurrently. Chunks of the expected size
+      // left over from an interrupted download of the same artifact are
+      // reused without refetching.
+      std::mutex ErrMutex;
+      Error ChunkErr = Error::success();
+      ThreadPool Pool(hardware_concurrency(getDefaultDebuginfodConnections()));
+      for (uint64_t I = 1; I < NumChunks; ++I)
+        Pool.async([&, I] {
+          uint64_t Offset = I * DownloadChunkSize;
+          uint64_t Size = std::min(DownloadChunkSize, TotalSize - Offset);
+          uint64_t ExistingSize;
+          if (!sys::fs::file_size(ChunkPath(I), ExistingSize) &&
+              ExistingSize == Size)
+            return;
+          unsigned ChunkCode = 0;
+          Expected<Optional<uint64_t>> R = downloadChunk(
+              ArtifactUrl, Offset, Size, ChunkPath(I), Timeout, ChunkCode);
+          Error Err = Error::success();
+          if (!R)
+            Err = R.takeError();
+          else if (ChunkCode != 206)
+            Err = createStringError(
+                errc::io_error, "unexpected response code %u for range request",
+                ChunkCode);
+          if (Err) {
+            std::lock_guard<std::mutex> Guard(ErrMutex);
+            ChunkErr = joinErrors(std::move(ChunkErr), std::move(Err));
+          }
+        });
+      Pool.wait();
+      // Leave any downloaded chunks on disk so an interrupted download can
+      // resume.
+      if (ChunkErr)
+        return std::move(ChunkErr);
+    }
+
+    // All chunks are on disk; stream them into the cache in order. The stream
+    // commits the cache file on destruction.
+    {
+      Expected<std::unique_ptr<CachedFileStream>> FileStreamOrErr =
+          CacheAddStream(Task);
+      if (!FileStreamOrErr)
+        return FileStreamOrErr.takeError();
+      std::unique_ptr<CachedFileStream> FileStream =
+          std::move(*FileStreamOrErr);
+      for (uint64_t I = 0; I < NumChunks; ++I) {
+        ErrorOr<std::unique_ptr<MemoryBuffer>> ChunkOrErr =
+            MemoryBuffer::getFile(ChunkPath(I));
+        if (!ChunkOrErr)
+          return errorCodeToError(ChunkOrErr.getError());
+        *FileStream->OS << (*ChunkOrErr)->getBuffer();
+      }
+    }
+    for (uint64_t I = 0; I < NumChunks; ++I)
+      sys::fs::remove(ChunkPath(I));
 
     // Return the path to the artifact on disk.
     return std::string(AbsCachedArtifactPath);
@@ -418,11 +418,12 @@ operator=(ItaniumPartialDemangler &&Other) {
 }
 
 // Demangle MangledName into an AST, storing it into this->RootNode.
-bool ItaniumPartialDemangler::partialDemangle(const char *MangledName) {
+bool ItaniumPartialDemangler::partialDemangle(const char *MangledName,
+                                              bool ParseParams) {
   Demangler *Parser = static_cast<Demangler *>(Context);
   size_t Len = std::strlen(MangledName);
   Parser->reset(MangledName, MangledName + Len);
-  RootNode = Parser->parse();
+  RootNode = Parser->parse(ParseParams);
   return RootNode == nullptr;
 }
 
@@ -2156,6 +2156,24 @@ ExecutionSession::lookup(const JITDylibSearchOrder &SearchOrder,
 #endif
 }
 
+std::future<MSVCPExpected<SymbolMap>> ExecutionSession::lookupAsync(
+    const JITDylibSearchOrder &SearchOrder, SymbolLookupSet Symbols,
+    LookupKind K, SymbolState RequiredState,
+    RegisterDependenciesFunction RegisterDependencies) {
+  std::promise<MSVCPExpected<SymbolMap>> PromisedResult;
+  auto ResultFuture = PromisedResult.get_future();
+
+  lookup(
+      K, SearchOrder, std::move(Symbols), RequiredState,
+      [PromisedResult = std::move(PromisedResult)](
+          Expected<SymbolMap> R) mutable {
+        PromisedResult.set_value(std::move(R));
+      },
+      std::move(RegisterDependencies));
+
+  return ResultFuture;
+}
+
 Expected<JITEvaluatedSymbol>
 ExecutionSession::lookup(const JITDylibSearchOrder &SearchOrder,
                          SymbolStringPtr Name, SymbolState RequiredState) {
@@ -1225,15 +1225,144 @@ void Pattern::AddBackrefToRegEx(unsigned BackrefNum) {
   RegExStr += Backref;
 }
 
+std::unique_ptr<FixedStringIndex>
+FixedStringIndex::build(ArrayRef<FileCheckString> CheckStrings,
+                        StringRef Input) {
+  SmallVector<StringRef, 64> Fixed;
+  auto AddPattern = [&](const Pattern &Pat) {
+    if (!Pat.getFixedStr().empty() && !Pat.ignoresCase())
+      Fixed.push_back(Pat.getFixedStr());
+  };
+  for (const FileCheckString &CheckStr : CheckStrings) {
+    AddPattern(CheckStr.Pat);
+    for (const Pattern &Pat : CheckStr.DagNotStrings)
+      AddPattern(Pat);
+  }
+  if (Fixed.size() < MinIndexedPatterns)
+    return nullptr;
+
+  // Build the trie over the unique fixed strings.
+  auto Index = std::make_unique<FixedStringIndex>();
+  Index->InputBegin = Input.data();
+  Index->InputSize = Input.size();
+  Index->States.emplace_back();
+  for (StringRef Str : Fixed) {
+    auto Slot = Index->Slots.try_emplace(Str, Index->Occurrences.size());
+    if (!Slot.second)
+      continue;
+    Index->Occurrences.emplace_back();
+    Index->Lengths.push_back(Str.size());
+    uint32_t Cur = 0;
+    for (unsigned char C : Str) {
+      auto Edge = Index->States[Cur].Next.try_emplace(C, Index->States.size());
+      if (Edge.second)
+        Index->States.emplace_back();
+      Cur = Edge.first->second;
+    }
+    Index->States[Cur].Slot = Slot.first->second;
+  }
+  Index->Overflowed.resize(Index->Occurrences.size());
+
+  // Compute failure and dictionary links in breadth-first order, so that the
+  // links of shallower states are available when their children are visited.
+  SmallVector<uint32_t, 64> Queue;
+  for (const auto &Edge : Index->States[0].Next)
+    Queue.push_back(Edge.second);
+  for (size_t I = 0; I != Queue.size(); ++I) {
+    uint32_t Cur = Queue[I];
+    for (const auto &Edge : Index->States[Cur].Next) {
+      uint32_t Child = Edge.second;
+      uint32_t Fail = Index->States[Cur].Fail;
+      while (true) {
+        auto It = Index->States[Fail].Next.find(Edge.first);
+        if (It != Index->States[Fail].Next.end()) {
+          Index->States[Child].Fail = It->second;
+          break;
+        }
+        if (Fail == 0)
+          break;
+        Fail = Index->States[Fail].Fail;
+      }
+      uint32_t FailState = Index->States[Child].Fail;
+      Index->States[Child].Dict = Index->States[FailState].Slot >= 0
+                                      ? FailState
+                                      : Index->States[FailState].Dict;
+      Queue.push_back(Child);
+    }
+  }
+
+  // Scan the input once, recording where each string occurs.
+  uint32_t Cur = 0;
+  for (uint64_t I = 0, E = Input.size(); I != E; ++I) {
+    unsigned C = (unsigned char)Input[I];
+    while (true) {
+      auto It = Index->States[Cur].Next.find(C);
+      if (It != Index->States[Cur].Next.end()) {
+        Cur = It->second;
+        break;
+      }
+      if (Cur == 0)
+        break;
+      Cur = Index->States[Cur].Fail;
+    }
+    uint32_t Node =
+        Index->States[Cur].Slot >= 0 ? Cur : Index->States[Cur].Dict;
+    for (; Node != 0; Node = Index->States[Node].Dict) {
+      int32_t Slot = Index->States[Node].Slot;
+      if (Index->Overflowed.test(Slot))
+        continue;
+      std::vector<uint64_t> &Occ = Index->Occurrences[Slot];
+      if (Occ.size() == MaxOccurrencesPerString) {
+        // Discard the occurrences; lookups for this string fall back to a
+        // plain scan.
+        Index->Overflowed.set(Slot);
+        std::vector<uint64_t>().swap(Occ);
+      } else {
+        Occ.push_back(I + 1 - Index->Lengths[Slot]);
+      }
+    }
+  }
+  return Index;
+}
+
+bool FixedStringIndex::findFirst(StringRef FixedStr, StringRef Buffer,
+                                 size_t &Pos) const {
+  auto It = Slots.find(FixedStr);
+  if (It == Slots.end() || Overflowed.test(It->second))
+    return false;
+  // Matching happens on substrings of the indexed input; be defensive about
+  // any other buffer.
+  if (Buffer.data() < InputBegin ||
+      Buffer.data() + Buffer.size() > InputBegin + InputSize)
+    return false;
+  const std::vector<uint64_t> &Occ = Occurrences[It->second];
+  uint64_t From = Buffer.data() - InputBegin;
+  auto OccIt = std::lower_bound(Occ.begin(), Occ.end(), From);
+  if (OccIt == Occ.end() || *OccIt + FixedStr.size() > From + Buffer.size())
+    Pos = StringRef::npos;
+  else
+    Pos = *OccIt - From;
+  return true;
+}
+
 Pattern::MatchResult Pattern::match(StringRef Buffer,
                                     const SourceMgr &SM) const {
   // If this is the EOF pattern, match it immediately.
   if (CheckTy == Check::CheckEOF)
     return MatchResult(Buffer.size(), 0, Error::success());
 
-  // If this is a fixed string pattern, just match it now.
+  // If this is a fixed string pattern, just match it now, using the
+  // precomputed occurrence index when it covers this pattern.
   if (!FixedStr.empty()) {
-    size_t Pos =
+    size_t Pos;
+    if (const FixedStringIndex *Index = Context->getFixedStringIndex()) {
+      if (!IgnoreCase && Index->findFirst(FixedStr, Buffer, Pos)) {
+        if (Pos == StringRef::npos)
+          return make_error<NotFoundError>();
+        return MatchResult(Pos, /*MatchLen=*/FixedStr.size(), Error::success());
+      }
+    }
+    Pos =
         IgnoreCase ? Buffer.find_insensitive(FixedStr) : Buffer.find(FixedStr);
     if (Pos == StringRef::npos)
       return make_error<NotFoundError>();
@@ -2802,6 +2931,10 @@ bool FileCheck::checkInput(SourceMgr &SM, StringRef Buffer,
                            std::vector<FileCheckDiag> *Diags) {
   bool ChecksFailed = false;
 
+  // With many directives, locate all fixed string patterns in a single pass
+  // over the input up front instead of scanning it once per directive.
+  PatternContext->buildFixedStringIndex(*CheckStrings, Buffer);
+
   unsigned i = 0, j = 0, e = CheckStrings->size();
   while (true) {
     StringRef CheckRegion;
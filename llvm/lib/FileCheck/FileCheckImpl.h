@@ -15,6 +15,8 @@
 #ifndef LLVM_LIB_FILECHECK_FILECHECKIMPL_H
 #define LLVM_LIB_FILECHECK_FILECHECKIMPL_H
 
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
@@ -453,6 +455,74 @@ public:
 // Pattern handling code.
 //===----------------------------------------------------------------------===//
 
+struct FileCheckString;
+
+/// Index of the occurrences in the input of every fixed string pattern of the
+/// check file. All fixed strings are compiled into a single Aho-Corasick
+/// automaton and located in one pass over the input, so that matching many
+/// directives does not rescan the input once per directive. Patterns that
+/// need a regex or case-insensitive match are not indexed and keep using
+/// their own scan.
+class FixedStringIndex {
+  /// A state of the Aho-Corasick automaton. Trie edges are stored sparsely;
+  /// missing edges are resolved through the failure links while scanning.
+  struct State {
+    SmallDenseMap<unsigned, uint32_t, 2> Next;
+
+    /// State for the longest proper suffix of this state that is also a
+    /// prefix of some pattern.
+    uint32_t Fail = 0;
+
+    /// Nearest state reachable through failure links at which a pattern
+    /// ends, or 0 if there is none.
+    uint32_t Dict = 0;
+
+    /// Slot of the pattern ending at this state, or -1.
+    int32_t Slot = -1;
+  };
+
+  /// Automaton states; state 0 is the root.
+  std::vector<State> States;
+
+  /// Maps each unique fixed string to its slot in Occurrences.
+  StringMap<uint32_t> Slots;
+
+  /// Length of each slot's string.
+  std::vector<uint32_t> Lengths;
+
+  /// Sorted start offsets of each slot's occurrences in the input.
+  std::vector<std::vector<uint64_t>> Occurrences;
+
+  /// Slots whose strings occurred more than MaxOccurrencesPerString times.
+  /// Their occurrences are discarded and lookups fall back to a plain scan.
+  BitVector Overflowed;
+
+  /// Bounds of the indexed input buffer.
+  const char *InputBegin = nullptr;
+  size_t InputSize = 0;
+
+public:
+  /// Occurrence limit per fixed string, bounding the memory used by very
+  /// frequent short strings.
+  static constexpr size_t MaxOccurrencesPerString = 1 << 16;
+
+  /// Minimum number of fixed string patterns for an index to pay off; with
+  /// fewer patterns the per-directive scan is cheap enough.
+  static constexpr size_t MinIndexedPatterns = 16;
+
+  /// Builds an index of the fixed string patterns of \p CheckStrings over
+  /// \p Input, or returns null if too few patterns would be indexed.
+  static std::unique_ptr<FixedStringIndex>
+  build(ArrayRef<FileCheckString> CheckStrings, StringRef Input);
+
+  /// If \p FixedStr is indexed, sets \p Pos to the start of its first
+  /// occurrence fully inside \p Buffer, relative to \p Buffer (or npos if
+  /// there is none) and returns true. \p Buffer must be a substring of the
+  /// indexed input; \returns false if \p FixedStr is not covered by the
+  /// index and the caller must scan for it itself.
+  bool findFirst(StringRef FixedStr, StringRef Buffer, size_t &Pos) const;
+};
+
 /// Class holding the Pattern global state, shared by all patterns: tables
 /// holding values of variables and whether they are defined or not at any
 /// given time in the matching process.
@@ -493,7 +563,23 @@ private:
   /// them once they are guaranteed to no longer be used.
   std::vector<std::unique_ptr<Substitution>> Substitutions;
 
+  /// Index of fixed string pattern occurrences in the current input, if one
+  /// was built. Only consulted by Pattern::match as a fast path.
+  std::unique_ptr<FixedStringIndex> FixedIndex;
+
 public:
+  /// (Re)builds the fixed string occurrence index used when matching the
+  /// patterns of \p CheckStrings against \p Buffer.
+  void buildFixedStringIndex(ArrayRef<FileCheckString> CheckStrings,
+                             StringRef Buffer) {
+    FixedIndex = FixedStringIndex::build(CheckStrings, Buffer);
+  }
+
+  /// \returns the fixed string occurrence index, or null if none was built.
+  const FixedStringIndex *getFixedStringIndex() const {
+    return FixedIndex.get();
+  }
+
   /// \returns the value of string variable \p VarName or an error if no such
   /// variable has been defined.
   Expected<StringRef> getPatternVarValue(StringRef VarName);
@@ -772,6 +858,13 @@ public:
 
   int getCount() const { return CheckTy.getCount(); }
 
+  /// \returns the fixed string to match, or an empty string if this pattern
+  /// requires a regex match.
+  StringRef getFixedStr() const { return FixedStr; }
+
+  /// \returns whether this pattern matches case-insensitively.
+  bool ignoresCase() const { return IgnoreCase; }
+
 private:
   bool AddRegExToRegEx(StringRef RS, unsigned &CurParen, SourceMgr &SM);
   void AddBackrefToRegEx(unsigned BackrefNum);
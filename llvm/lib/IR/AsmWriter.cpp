@@ -73,7 +73,9 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/FormattedStream.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -2536,6 +2538,7 @@ class AssemblyWriter {
   SetVector<const Comdat *> Comdats;
   bool IsForDebug;
   bool ShouldPreserveUseListOrder;
+  bool PrintFunctionsInParallel = false;
   UseListOrderMap UseListOrders;
   SmallVector<StringRef, 8> MDNames;
   /// Synchronization scope names registered with LLVMContext.
@@ -2593,6 +2596,10 @@ public:
   void printUseListOrder(const Value *V, const std::vector<unsigned> &Shuffle);
   void printUseLists(const Function *F);
 
+  /// Enable printing function bodies on multiple threads; see
+  /// printFunctionsInParallel() for the preconditions.
+  void setPrintFunctionsInParallel(bool V) { PrintFunctionsInParallel = V; }
+
   void printModuleSummaryIndex();
   void printSummaryInfo(unsigned Slot, const ValueInfo &VI);
   void printSummary(const GlobalValueSummary &Summary);
@@ -2614,6 +2621,10 @@ public:
                    const char *Tag);
 
 private:
+  /// Print the module's function bodies on multiple threads, stitching the
+  /// per-shard output together in source order.
+  void printFunctionsInParallel(const Module *M);
+
   /// Print out metadata attachments.
   void printMetadataAttachments(
       const SmallVectorImpl<std::pair<unsigned, MDNode *>> &MDs,
@@ -2759,6 +2770,15 @@ void AssemblyWriter::writeOperandBundles(const CallBase *Call) {
   Out << " ]";
 }
 
+/// Number of shards to print a module's function bodies on. Zero or one means
+/// printing in parallel is not worthwhile (or threading is disabled).
+static size_t numFunctionPrintingShards(const Module &M) {
+  constexpr size_t MinFunctionsPerShard = 64;
+  return std::min<size_t>(
+      heavyweight_hardware_concurrency().compute_thread_count(),
+      M.size() / MinFunctionsPerShard);
+}
+
 void AssemblyWriter::printModule(const Module *M) {
   Machine.initializeIfNeeded();
 
@@ -2828,9 +2848,14 @@ void AssemblyWriter::printModule(const Module *M) {
     printIFunc(&GI);
 
   // Output all of the functions.
-  for (const Function &F : *M) {
-    Out << '\n';
-    printFunction(&F);
+  if (PrintFunctionsInParallel && !AnnotationWriter &&
+      !ShouldPreserveUseListOrder && numFunctionPrintingShards(*M) > 1) {
+    printFunctionsInParallel(M);
+  } else {
+    for (const Function &F : *M) {
+      Out << '\n';
+      printFunction(&F);
+    }
   }
 
   // Output global use-lists.
@@ -2855,6 +2880,38 @@ void AssemblyWriter::printModule(const Module *M) {
   }
 }
 
+void AssemblyWriter::printFunctionsInParallel(const Module *M) {
+  // Each shard gets its own SlotTracker and AssemblyWriter printing into a
+  // string buffer; the buffers are concatenated in source order afterwards.
+  // Module-level slot numbering is deterministic, so every shard computes the
+  // same numbers our own Machine holds — provided Machine was created with
+  // ShouldInitializeAllMetadata, since otherwise metadata referenced only
+  // from function bodies would be numbered lazily in printing order. The
+  // caller (Module::print) guarantees that before enabling this path.
+  SmallVector<const Function *, 64> Fns;
+  for (const Function &F : *M)
+    Fns.push_back(&F);
+
+  const size_t NumShards = numFunctionPrintingShards(*M);
+  std::vector<std::string> Buffers(NumShards);
+  parallelFor(0, NumShards, [&](size_t Idx) {
+    raw_string_ostream SOS(Buffers[Idx]);
+    formatted_raw_ostream FOS(SOS);
+    SlotTracker ShardMachine(M, /*ShouldInitializeAllMetadata=*/true);
+    AssemblyWriter ShardWriter(FOS, ShardMachine, M, /*AAW=*/nullptr,
+                               IsForDebug);
+    const size_t Begin = Fns.size() * Idx / NumShards;
+    const size_t End = Fns.size() * (Idx + 1) / NumShards;
+    for (size_t I = Begin; I != End; ++I) {
+      FOS << '\n';
+      ShardWriter.printFunction(Fns[I]);
+    }
+  });
+
+  for (const std::string &Buffer : Buffers)
+    Out << Buffer;
+}
+
 void AssemblyWriter::printModuleSummaryIndex() {
   assert(TheIndex);
   int NumSlots = Machine.initializeIndexIfNeeded();
@@ -4510,10 +4567,18 @@ void BasicBlock::print(raw_ostream &ROS, AssemblyAnnotationWriter *AAW,
 
 void Module::print(raw_ostream &ROS, AssemblyAnnotationWriter *AAW,
                    bool ShouldPreserveUseListOrder, bool IsForDebug) const {
-  SlotTracker SlotTable(this);
+  // Print function bodies on multiple threads when the module is big enough.
+  // The annotation writer is caller-provided code we cannot assume to be
+  // thread-safe, and use-list order prediction is stateful across functions,
+  // so both force the serial path. Full metadata initialization keeps the
+  // module-level numbering identical across the per-shard slot trackers.
+  const bool PrintInParallel = !AAW && !ShouldPreserveUseListOrder &&
+                               numFunctionPrintingShards(*this) > 1;
+  SlotTracker SlotTable(this, /*ShouldInitializeAllMetadata=*/PrintInParallel);
   formatted_raw_ostream OS(ROS);
   AssemblyWriter W(OS, SlotTable, this, AAW, IsForDebug,
                    ShouldPreserveUseListOrder);
+  W.setPrintFunctionsInParallel(PrintInParallel);
   W.printModule(this);
 }
 
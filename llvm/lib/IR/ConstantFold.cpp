@@ -17,8 +17,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/IR/ConstantFold.h"
+#include "LLVMContextImpl.h"
 #include "llvm/ADT/APSInt.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
@@ -33,6 +35,21 @@
 using namespace llvm;
 using namespace llvm::PatternMatch;
 
+#define DEBUG_TYPE "constantfold"
+
+STATISTIC(NumFoldCacheHits, "Number of constant fold cache hits");
+STATISTIC(NumFoldCacheMisses, "Number of constant fold cache misses");
+
+// Scalar folds over ConstantInt and ConstantFP are pure functions of the
+// opcode, the operands and the destination type, and both constant kinds are
+// uniqued for the whole lifetime of their LLVMContext, so (opcode, operands,
+// type) -> result can be memoized per context without any invalidation.
+// Other constant kinds (expressions, aggregates, undef) can be destroyed
+// early via destroyConstant and must not appear in the table.
+static bool isFoldCacheable(const Constant *C) {
+  return isa<ConstantInt>(C) || isa<ConstantFP>(C);
+}
+
 //===----------------------------------------------------------------------===//
 //                ConstantFold*Instruction Implementations
 //===----------------------------------------------------------------------===//
@@ -347,8 +364,8 @@ static Constant *ExtractConstantBytes(Constant *C, unsigned ByteStart,
   }
 }
 
-Constant *llvm::ConstantFoldCastInstruction(unsigned opc, Constant *V,
-                                            Type *DestTy) {
+static Constant *ConstantFoldCastInstImpl(unsigned opc, Constant *V,
+                                          Type *DestTy) {
   if (isa<PoisonValue>(V))
     return PoisonValue::get(DestTy);
 
@@ -518,6 +535,29 @@ Constant *llvm::ConstantFoldCastInstruction(unsigned opc, Constant *V,
   }
 }
 
+Constant *llvm::ConstantFoldCastInstruction(unsigned opc, Constant *V,
+                                            Type *DestTy) {
+  if (!isFoldCacheable(V))
+    return ConstantFoldCastInstImpl(opc, V, DestTy);
+
+  auto &Cache = V->getContext().pImpl->ConstantFoldCache;
+  std::tuple<unsigned, Constant *, Constant *, Type *> Key(opc, V, nullptr,
+                                                           DestTy);
+  auto It = Cache.find(Key);
+  if (It != Cache.end()) {
+    ++NumFoldCacheHits;
+    return It->second;
+  }
+  ++NumFoldCacheMisses;
+
+  Constant *Res = ConstantFoldCastInstImpl(opc, V, DestTy);
+  // "No fold" is just as pure as a successful fold; remember it too. Results
+  // that are not themselves uniqued-forever constants are not remembered.
+  if (!Res || isFoldCacheable(Res))
+    Cache.try_emplace(Key, Res);
+  return Res;
+}
+
 Constant *llvm::ConstantFoldSelectInstruction(Constant *Cond,
                                               Constant *V1, Constant *V2) {
   // Check for i1 and vector true/false conditions.
@@ -870,8 +910,8 @@ Constant *llvm::ConstantFoldUnaryInstruction(unsigned Opcode, Constant *C) {
   return nullptr;
 }
 
-Constant *llvm::ConstantFoldBinaryInstruction(unsigned Opcode, Constant *C1,
-                                              Constant *C2) {
+static Constant *ConstantFoldBinaryInstImpl(unsigned Opcode, Constant *C1,
+                                            Constant *C2) {
   assert(Instruction::isBinaryOp(Opcode) && "Non-binary instruction detected");
 
   // Simplify BinOps with their identity values first. They are no-ops and we
@@ -1306,6 +1346,27 @@ Constant *llvm::ConstantFoldBinaryInstruction(unsigned Opcode, Constant *C1,
   return nullptr;
 }
 
+Constant *llvm::ConstantFoldBinaryInstruction(unsigned Opcode, Constant *C1,
+                                              Constant *C2) {
+  if (!isFoldCacheable(C1) || !isFoldCacheable(C2))
+    return ConstantFoldBinaryInstImpl(Opcode, C1, C2);
+
+  auto &Cache = C1->getContext().pImpl->ConstantFoldCache;
+  std::tuple<unsigned, Constant *, Constant *, Type *> Key(Opcode, C1, C2,
+                                                           nullptr);
+  auto It = Cache.find(Key);
+  if (It != Cache.end()) {
+    ++NumFoldCacheHits;
+    return It->second;
+  }
+  ++NumFoldCacheMisses;
+
+  Constant *Res = ConstantFoldBinaryInstImpl(Opcode, C1, C2);
+  if (!Res || isFoldCacheable(Res))
+    Cache.try_emplace(Key, Res);
+  return Res;
+}
+
 /// This function determines if there is anything we can decide about the two
 /// constants provided. This doesn't need to handle simple things like
 /// ConstantFP comparisons, but should instead handle ConstantExprs.
@@ -23,8 +23,10 @@
 #include "llvm/IR/PassManager.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/PassRegistry.h"
+#include "llvm/ADT/Twine.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <cassert>
@@ -41,6 +43,12 @@ static cl::opt<bool, true>
     VerifyDomInfoX("verify-dom-info", cl::location(VerifyDomInfo), cl::Hidden,
                    cl::desc("Verify dominator info (time consuming)"));
 
+static cl::opt<bool> AssertIncrementalDomInfo(
+    "assert-incremental-dom-info", cl::Hidden,
+    cl::desc("Report a fatal error when a pass invalidates a dominator tree "
+             "instead of scheduling a full recalculation. Used to catch "
+             "passes that bypass incremental DomTreeUpdater updates."));
+
 #ifdef EXPENSIVE_CHECKS
 static constexpr bool ExpensiveChecksEnabled = true;
 #else
@@ -115,8 +123,14 @@ bool DominatorTree::invalidate(Function &F, const PreservedAnalyses &PA,
   // Check whether the analysis, all analyses on functions, or the function's
   // CFG have been preserved.
   auto PAC = PA.getChecker<DominatorTreeAnalysis>();
-  return !(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Function>>() ||
-           PAC.preservedSet<CFGAnalyses>());
+  bool Invalidate =
+      !(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Function>>() ||
+        PAC.preservedSet<CFGAnalyses>());
+  if (Invalidate && AssertIncrementalDomInfo)
+    report_fatal_error(Twine("dominator tree for '") + F.getName() +
+                       "' invalidated; a pass mutated the CFG without "
+                       "updating the tree through DomTreeUpdater");
+  return Invalidate;
 }
 
 bool DominatorTree::dominates(const BasicBlock *BB, const Use &U) const {
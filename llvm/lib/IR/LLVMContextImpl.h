@@ -1411,6 +1411,13 @@ public:
       DenseMap<APFloat, std::unique_ptr<ConstantFP>, DenseMapAPFloatKeyInfo>;
   FPMapTy FPConstants;
 
+  /// Memoized results of scalar constant folds over ConstantInt/ConstantFP
+  /// operands, keyed by (opcode, LHS, RHS, destination type). Only constants
+  /// that are uniqued for the lifetime of the context may appear as keys or
+  /// values, so entries never need invalidation. See ConstantFold.cpp.
+  DenseMap<std::tuple<unsigned, Constant *, Constant *, Type *>, Constant *>
+      ConstantFoldCache;
+
   FoldingSet<AttributeImpl> AttrsSet;
   FoldingSet<AttributeListImpl> AttrsLists;
   FoldingSet<AttributeSetNode> AttrsSetNodes;
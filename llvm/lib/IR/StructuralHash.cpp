@@ -1,41 +1,66 @@
-//===-- StructuralHash.cpp - IR Hash for expensive checks -------*- C++ -*-===//
+//===-- StructuralHash.cpp - IR Hashing -------------------------*- C++ -*-===//
 //
 // Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
 // See https://llvm.org/LICENSE.txt for license information.
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
 //===----------------------------------------------------------------------===//
-//
-
-#ifdef EXPENSIVE_CHECKS
 
 #include "llvm/IR/StructuralHash.h"
+#include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Module.h"
 
 using namespace llvm;
 
 namespace {
-namespace details {
 
-// Basic hashing mechanism to detect structural change to the IR, used to verify
-// pass return status consistency with actual change. Loosely copied from
+// Basic hashing mechanism to detect structural change to the IR, used to
+// verify pass return status consistency with actual change. In detailed mode
+// it also folds in type, constant and callee information so the hash
+// identifies a function body closely enough to key caches of per-function
+// results. Loosely copied from
 // llvm/lib/Transforms/Utils/FunctionComparator.cpp
 
-class StructuralHash {
+class StructuralHashImpl {
   uint64_t Hash = 0x6acaa36bef8325c5ULL;
 
-  void update(uint64_t V) { Hash = hashing::detail::hash_16_bytes(Hash, V); }
+  const bool DetailedHash;
+
+  void hash(uint64_t V) { Hash = hashing::detail::hash_16_bytes(Hash, V); }
+
+  void hash(const Type *Ty) { hash(Ty->getTypeID()); }
+
+  void update(const Instruction &Inst) {
+    hash(Inst.getOpcode());
+    if (!DetailedHash)
+      return;
+
+    hash(Inst.getType());
+    hash(Inst.getNumOperands());
+    for (const Value *Op : Inst.operands()) {
+      // Basic block operands are covered by the CFG walk: successor order is
+      // reflected in the order blocks are visited and hashed.
+      if (isa<BasicBlock>(Op))
+        continue;
+      hash(Op->getType());
+      if (const auto *CI = dyn_cast<ConstantInt>(Op))
+        hash(CI->getValue().getLimitedValue());
+      else if (const auto *Callee = dyn_cast<Function>(Op))
+        for (unsigned char C : Callee->getName())
+          hash(C);
+    }
+  }
 
 public:
-  StructuralHash() = default;
+  explicit StructuralHashImpl(bool DetailedHash) : DetailedHash(DetailedHash) {}
 
   void update(const Function &F) {
     if (F.empty())
       return;
 
-    update(F.isVarArg());
-    update(F.arg_size());
+    hash(F.isVarArg());
+    hash(F.arg_size());
 
     SmallVector<const BasicBlock *, 8> BBs;
     SmallPtrSet<const BasicBlock *, 16> VisitedBBs;
@@ -44,9 +69,9 @@ public:
     VisitedBBs.insert(BBs[0]);
     while (!BBs.empty()) {
       const BasicBlock *BB = BBs.pop_back_val();
-      update(45798); // Block header
+      hash(45798); // Block header
       for (auto &Inst : *BB)
-        update(Inst.getOpcode());
+        update(Inst);
 
       const Instruction *Term = BB->getTerminator();
       for (unsigned i = 0, e = Term->getNumSuccessors(); i != e; ++i) {
@@ -65,20 +90,16 @@ public:
   uint64_t getHash() const { return Hash; }
 };
 
-} // namespace details
-
 } // namespace
 
-uint64_t llvm::StructuralHash(const Function &F) {
-  details::StructuralHash H;
+uint64_t llvm::StructuralHash(const Function &F, bool DetailedHash) {
+  StructuralHashImpl H(DetailedHash);
   H.update(F);
   return H.getHash();
 }
 
-uint64_t llvm::StructuralHash(const Module &M) {
-  details::StructuralHash H;
+uint64_t llvm::StructuralHash(const Module &M, bool DetailedHash) {
+  StructuralHashImpl H(DetailedHash);
   H.update(M);
   return H.getHash();
 }
-
-#endif
@@ -104,6 +104,8 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -440,6 +442,29 @@ public:
     return !Broken;
   }
 
+  /// Merge the cross-function state gathered by \p Other while it verified a
+  /// shard of this module's functions. The module-level checks that span
+  /// functions (llvm.localescape/localrecover indices, !dbg subprogram
+  /// attachments, visited compile units) must observe the union of what all
+  /// shards saw; see verifyModule().
+  void mergeCrossFunctionState(const Verifier &Other) {
+    for (const auto &Counts : Other.FrameEscapeInfo) {
+      std::pair<unsigned, unsigned> &Info = FrameEscapeInfo[Counts.first];
+      Info.first = std::max(Info.first, Counts.second.first);
+      Info.second = std::max(Info.second, Counts.second.second);
+    }
+    for (const auto &Attachment : Other.DISubprogramAttachments) {
+      const Function *&AttachedTo = DISubprogramAttachments[Attachment.first];
+      if (AttachedTo && AttachedTo != Attachment.second)
+        DebugInfoCheckFailed("DISubprogram attached to more than one function",
+                             Attachment.first, Attachment.second);
+      else
+        AttachedTo = Attachment.second;
+    }
+    CUVisited.insert(Other.CUVisited.begin(), Other.CUVisited.end());
+    BrokenDebugInfo |= Other.BrokenDebugInfo;
+  }
+
 private:
   /// Whether a metadata node is allowed to be, or contain, a DILocation.
   enum class AreDebugLocsAllowed { No, Yes };
@@ -6372,8 +6397,55 @@ bool llvm::verifyModule(const Module &M, raw_ostream *OS,
   Verifier V(OS, /*ShouldTreatBrokenDebugInfoAsError=*/!BrokenDebugInfo, M);
 
   bool Broken = false;
-  for (const Function &F : M)
-    Broken |= !V.verify(F);
+
+  // Function bodies dominate verification time on large modules and are
+  // independent of one another, so shard them across threads. Each shard runs
+  // its own Verifier instance and buffers its diagnostics; afterwards the
+  // logs are flushed in shard order and the cross-function state is merged
+  // into the main Verifier so that the serial module-level pass below sees
+  // everything. Only worth it when there is enough work per thread.
+  constexpr size_t MinFunctionsPerShard = 64;
+  const size_t NumShards =
+      std::min<size_t>(heavyweight_hardware_concurrency().compute_thread_count(),
+                       M.size() / MinFunctionsPerShard);
+  if (NumShards > 1) {
+    SmallVector<const Function *, 64> Fns;
+    for (const Function &F : M)
+      Fns.push_back(&F);
+
+    struct Shard {
+      std::string Log;
+      std::unique_ptr<raw_string_ostream> LogOS;
+      std::unique_ptr<Verifier> V;
+      bool Broken = false;
+    };
+    std::vector<Shard> Shards(NumShards);
+    for (Shard &S : Shards) {
+      if (OS)
+        S.LogOS = std::make_unique<raw_string_ostream>(S.Log);
+      S.V = std::make_unique<Verifier>(
+          S.LogOS.get(), /*ShouldTreatBrokenDebugInfoAsError=*/!BrokenDebugInfo,
+          M);
+    }
+
+    parallelFor(0, NumShards, [&](size_t Idx) {
+      Shard &S = Shards[Idx];
+      const size_t Begin = Fns.size() * Idx / NumShards;
+      const size_t End = Fns.size() * (Idx + 1) / NumShards;
+      for (size_t I = Begin; I != End; ++I)
+        S.Broken |= !S.V->verify(*Fns[I]);
+    });
+
+    for (Shard &S : Shards) {
+      if (OS)
+        *OS << S.LogOS->str();
+      V.mergeCrossFunctionState(*S.V);
+      Broken |= S.Broken;
+    }
+  } else {
+    for (const Function &F : M)
+      Broken |= !V.verify(F);
+  }
 
   Broken |= !V.verify();
   if (BrokenDebugInfo)
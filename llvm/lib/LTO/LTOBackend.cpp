@@ -14,6 +14,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/LTO/LTOBackend.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/CGSCCPassManager.h"
 #include "llvm/Analysis/ModuleSummaryAnalysis.h"
@@ -72,6 +73,11 @@ static cl::opt<bool> ThinLTOAssumeMerged(
     cl::desc("Assume the input has already undergone ThinLTO function "
              "importing and the other pre-optimization pipeline changes."));
 
+static cl::opt<bool> ThinLTOParallelImportPrefetch(
+    "thinlto-parallel-import-prefetch", cl::init(true), cl::Hidden,
+    cl::desc("Read and scan cross-module import sources in parallel before "
+             "importing"));
+
 namespace llvm {
 extern cl::opt<bool> NoPGOWarnMismatch;
 }
@@ -608,6 +614,39 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
       !Conf.PostInternalizeModuleHook(Task, Mod))
     return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
 
+  // When importing from files, read the source modules and scan them for
+  // their ThinLTO module in parallel up front. The actual deserialization
+  // must stay on this thread: the lazy modules share the destination
+  // module's LLVMContext, which is not thread-safe, and IRMover cannot
+  // splice modules across contexts. The buffer loading and bitcode scanning
+  // below are context-free, though, and typically I/O bound. The prefetch is
+  // best-effort; a failed or missing entry falls back to the synchronous
+  // path in the loader, which also reports any error.
+  StringMap<std::pair<std::unique_ptr<MemoryBuffer>, BitcodeModule>>
+      PrefetchedModules;
+  if (!ModuleMap && ThinLTOParallelImportPrefetch && ImportList.size() > 1) {
+    std::mutex PrefetchMutex;
+    ThreadPool PrefetchPool(optimal_concurrency(ImportList.size()));
+    for (const auto &FunctionsToImportPerModule : ImportList) {
+      StringRef Identifier = FunctionsToImportPerModule.first();
+      PrefetchPool.async([&, Identifier] {
+        ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+            MemoryBuffer::getFile(Identifier);
+        if (!MBOrErr)
+          return;
+        Expected<BitcodeModule> BMOrErr = findThinLTOModule(**MBOrErr);
+        if (!BMOrErr) {
+          consumeError(BMOrErr.takeError());
+          return;
+        }
+        std::lock_guard<std::mutex> Lock(PrefetchMutex);
+        PrefetchedModules.try_emplace(Identifier, std::move(*MBOrErr),
+                                      std::move(*BMOrErr));
+      });
+    }
+    PrefetchPool.wait();
+  }
+
   auto ModuleLoader = [&](StringRef Identifier) {
     assert(Mod.getContext().isODRUniquingDebugTypes() &&
            "ODR Type uniquing should be enabled on the context");
@@ -619,6 +658,17 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
                                      /*IsImporting*/ true);
     }
 
+    auto Prefetched = PrefetchedModules.find(Identifier);
+    if (Prefetched != PrefetchedModules.end()) {
+      Expected<std::unique_ptr<Module>> MOrErr =
+          Prefetched->second.second.getLazyModule(Mod.getContext(),
+                                                  /*ShouldLazyLoadMetadata=*/true,
+                                                  /*IsImporting*/ true);
+      if (MOrErr)
+        (*MOrErr)->setOwnedMemoryBuffer(std::move(Prefetched->second.first));
+      return MOrErr;
+    }
+
     ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> MBOrErr =
         llvm::MemoryBuffer::getFile(Identifier);
     if (!MBOrErr)
@@ -392,7 +392,14 @@ class IRLinker {
   GlobalValueMaterializer GValMaterializer;
   LocalValueMaterializer LValMaterializer;
 
-  /// A metadata map that's shared between IRLinker instances.
+  /// A metadata map that's shared between IRLinker instances. It is moved
+  /// into ValueMap for the duration of this link and moved back out by the
+  /// destructor, so mappings made while linking earlier source modules are
+  /// visible here and metadata subtrees that were already mapped into DstM
+  /// are not cloned and remapped again. Note that metadata reached through
+  /// the indirect symbol mapping context is deliberately not memoized here:
+  /// it may embed local-value materializations that are only correct for
+  /// the aliasee copy being created.
   MDMapT &SharedMDs;
 
   /// Mapping of values from what they used to be in Src, to what they are now
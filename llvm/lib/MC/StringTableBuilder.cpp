@@ -14,6 +14,7 @@
 #include "llvm/BinaryFormat/COFF.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
 #include <cstddef>
@@ -134,6 +135,39 @@ void StringTableBuilder::finalizeInOrder() {
   finalizeStringTable(/*Optimize=*/false);
 }
 
+/// Assign offsets to the sorted \p Strings, merging each string that is a
+/// suffix of its predecessor.  \p Base is the offset of the first string and
+/// must be aligned to the table alignment.  Returns the offset one past the
+/// last assigned string.
+size_t StringTableBuilder::assignOffsets(ArrayRef<StringPair *> Strings,
+                                         size_t Base) {
+  size_t Pos = Base;
+  StringRef Previous;
+  for (StringPair *P : Strings) {
+    StringRef S = P->first.val();
+    if (Previous.endswith(S)) {
+      size_t At = Pos - S.size() - (K != RAW);
+      if (!(At & (Alignment - 1))) {
+        P->second = At;
+        continue;
+      }
+    }
+
+    Pos = alignTo(Pos, Alignment);
+    P->second = Pos;
+
+    Pos += S.size();
+    if (K != RAW)
+      ++Pos;
+    Previous = S;
+  }
+  return Pos;
+}
+
+// Only parallelize the sort and suffix-merge phases for tables large enough
+// to amortize the bucketing passes and task startup.
+static constexpr size_t ParallelThreshold = 4096;
+
 void StringTableBuilder::finalizeStringTable(bool Optimize) {
   Finalized = true;
 
@@ -143,27 +177,51 @@ void StringTableBuilder::finalizeStringTable(bool Optimize) {
     for (StringPair &P : StringIndexMap)
       Strings.push_back(&P);
 
-    multikeySort(Strings, 0);
-    initSize();
+    if (Strings.size() < ParallelThreshold) {
+      multikeySort(Strings, 0);
+      initSize();
+      Size = assignOffsets(Strings, Size);
+    } else {
+      // A string can only be a suffix of another string if both end in the
+      // same byte, so bucketing by trailing byte splits the problem into
+      // shards that can be sorted and suffix-merged independently.  Shard 0
+      // holds the empty string, which can merge into any terminator and is
+      // laid out against the final running offset below.
+      constexpr size_t NumShards = 257;
+      std::vector<std::vector<StringPair *>> Shards(NumShards);
+      for (StringPair *P : Strings)
+        Shards[charTailAt(P, 0) + 1].push_back(P);
+
+      // Sort each shard and assign offsets relative to the shard base.
+      size_t ShardSizes[NumShards];
+      parallelFor(1, NumShards, [&](size_t I) {
+        multikeySort(Shards[I], 0);
+        ShardSizes[I] = assignOffsets(Shards[I], 0);
+      });
 
-    StringRef Previous;
-    for (StringPair *P : Strings) {
-      StringRef S = P->first.val();
-      if (Previous.endswith(S)) {
-        size_t Pos = Size - S.size() - (K != RAW);
-        if (!(Pos & (Alignment - 1))) {
-          P->second = Pos;
+      // Lay the shards out in the order the serial sort would have produced
+      // (descending trailing byte).  Aligning each shard base keeps the
+      // relative alignment checks above valid.
+      initSize();
+      size_t ShardBases[NumShards];
+      for (size_t I = NumShards - 1; I >= 1; --I) {
+        if (Shards[I].empty())
           continue;
-        }
+        Size = alignTo(Size, Alignment);
+        ShardBases[I] = Size;
+        Size += ShardSizes[I];
       }
 
-      Size = alignTo(Size, Alignment);
-      P->second = Size;
+      // Shift the relative offsets to their final positions.
+      parallelFor(1, NumShards, [&](size_t I) {
+        for (StringPair *P : Shards[I])
+          P->second += ShardBases[I];
+      });
 
-      Size += S.size();
-      if (K != RAW)
-        ++Size;
-      Previous = S;
+      // The empty string merges into the terminator of the last emitted
+      // string, exactly as in the serial pass.
+      if (!Shards[0].empty())
+        Size = assignOffsets(Shards[0], Size);
     }
   }
 
@@ -211,3 +269,10 @@ size_t StringTableBuilder::add(CachedHashStringRef S) {
   }
   return P.first->second;
 }
+
+void StringTableBuilder::add(ArrayRef<CachedHashStringRef> Shard) {
+  assert(!isFinalized());
+  StringIndexMap.reserve(StringIndexMap.size() + Shard.size());
+  for (CachedHashStringRef S : Shard)
+    add(S);
+}
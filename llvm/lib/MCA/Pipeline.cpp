@@ -22,8 +22,8 @@ namespace mca {
 #define DEBUG_TYPE "llvm-mca"
 
 void Pipeline::addEventListener(HWEventListener *Listener) {
-  if (Listener)
-    Listeners.insert(Listener);
+  if (Listener && !llvm::is_contained(Listeners, Listener))
+    Listeners.push_back(Listener);
   for (auto &S : Stages)
     S->addListener(Listener);
 }
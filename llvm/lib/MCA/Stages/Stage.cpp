@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/MCA/Stages/Stage.h"
+#include "llvm/ADT/STLExtras.h"
 
 namespace llvm {
 namespace mca {
@@ -21,7 +22,8 @@ namespace mca {
 Stage::~Stage() = default;
 
 void Stage::addListener(HWEventListener *Listener) {
-  Listeners.insert(Listener);
+  if (!llvm::is_contained(Listeners, Listener))
+    Listeners.push_back(Listener);
 }
 
 char InstStreamPause::ID = 0;
@@ -25,6 +25,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -2059,35 +2060,6 @@ template <class ELFT> Error ELFWriter<ELFT>::writeSectionData() {
   return Error::success();
 }
 
-template <class ELFT> void ELFWriter<ELFT>::writeSegmentData() {
-  for (Segment &Seg : Obj.segments()) {
-    size_t Size = std::min<size_t>(Seg.FileSize, Seg.getContents().size());
-    std::memcpy(Buf->getBufferStart() + Seg.Offset, Seg.getContents().data(),
-                Size);
-  }
-
-  for (auto it : Obj.getUpdatedSections()) {
-    SectionBase *Sec = it.first;
-    ArrayRef<uint8_t> Data = it.second;
-
-    auto *Parent = Sec->ParentSegment;
-    assert(Parent && "This section should've been part of a segment.");
-    uint64_t Offset =
-        Sec->OriginalOffset - Parent->OriginalOffset + Parent->Offset;
-    llvm::copy(Data, Buf->getBufferStart() + Offset);
-  }
-
-  // Iterate over removed sections and overwrite their old data with zeroes.
-  for (auto &Sec : Obj.removedSections()) {
-    Segment *Parent = Sec.ParentSegment;
-    if (Parent == nullptr || Sec.Type == SHT_NOBITS || Sec.Size == 0)
-      continue;
-    uint64_t Offset =
-        Sec.OriginalOffset - Parent->OriginalOffset + Parent->Offset;
-    std::memset(Buf->getBufferStart() + Offset, 0, Sec.Size);
-  }
-}
-
 template <class ELFT>
 ELFWriter<ELFT>::ELFWriter(Object &Obj, raw_ostream &Buf, bool WSH,
                            bool OnlyKeepDebug)
@@ -2459,20 +2431,135 @@ template <class ELFT> size_t ELFWriter<ELFT>::totalSize() const {
   return Obj.SHOff + ShdrCount * sizeof(Elf_Shdr);
 }
 
+namespace {
+/// Plans the output file as a set of disjoint byte ranges, each sourced either
+/// from the input mapping (spliced segment data) or from the writer's buffer
+/// (rewritten metadata). Later insertions override earlier ones, mirroring the
+/// order in which the buffer-based writer used to overwrite bytes.
+class OutputRangePlan {
+  struct Range {
+    uint64_t End;
+    /// Source bytes for the range, or nullptr to read from the buffer.
+    const uint8_t *Data;
+  };
+  /// Disjoint ranges keyed by their start offset.
+  std::map<uint64_t, Range> Ranges;
+
+public:
+  void insert(uint64_t Begin, uint64_t End, const uint8_t *Data) {
+    if (Begin >= End)
+      return;
+    // Trim a range that straddles Begin, keeping any tail beyond End.
+    auto I = Ranges.lower_bound(Begin);
+    if (I != Ranges.begin()) {
+      auto Prev = std::prev(I);
+      if (Prev->second.End > Begin) {
+        Range Tail = Prev->second;
+        uint64_t TailBegin = Prev->first;
+        Prev->second.End = Begin;
+        if (Tail.End > End)
+          Ranges.emplace(
+              End, Range{Tail.End,
+                         Tail.Data ? Tail.Data + (End - TailBegin) : nullptr});
+      }
+    }
+    // Drop ranges that begin within [Begin, End), keeping any tail.
+    I = Ranges.lower_bound(Begin);
+    while (I != Ranges.end() && I->first < End) {
+      uint64_t RBegin = I->first;
+      Range R = I->second;
+      I = Ranges.erase(I);
+      if (R.End > End)
+        I = Ranges
+                .emplace(End, Range{R.End, R.Data ? R.Data + (End - RBegin)
+                                                  : nullptr})
+                .first;
+    }
+    Ranges.emplace(Begin, Range{End, Data});
+  }
+
+  /// Visits every byte of [0, Size) in file order; Data is nullptr for ranges
+  /// whose bytes come from the buffer.
+  template <typename CallbackTy>
+  void forEachRange(uint64_t Size, CallbackTy Callback) const {
+    uint64_t Cursor = 0;
+    for (const auto &KV : Ranges) {
+      if (Cursor < KV.first)
+        Callback(Cursor, KV.first, nullptr);
+      Callback(KV.first, KV.second.End, KV.second.Data);
+      Cursor = KV.second.End;
+    }
+    if (Cursor < Size)
+      Callback(Cursor, Size, nullptr);
+  }
+};
+} // namespace
+
 template <class ELFT> Error ELFWriter<ELFT>::write() {
-  // Segment data must be written first, so that the ELF header and program
-  // header tables can overwrite it, if covered by a segment.
-  writeSegmentData();
+  // Plan the output as disjoint byte ranges and emit them in file order,
+  // splicing unmodified segment bytes directly from the input mapping instead
+  // of staging them in Buf. Only rewritten metadata goes through Buf -- the
+  // ELF header, the program and section header tables, sections outside any
+  // segment, updated section contents and the zeroed bytes of removed
+  // sections -- so writing an output no longer dirties memory proportional to
+  // its size.
+  OutputRangePlan Plan;
+  // Segment data is planned first, so that the ELF header and program header
+  // tables can overwrite it, if covered by a segment.
+  for (const Segment &Seg : Obj.segments())
+    Plan.insert(Seg.Offset,
+                Seg.Offset +
+                    std::min<uint64_t>(Seg.FileSize, Seg.getContents().size()),
+                Seg.getContents().data());
+
+  // Contents of updated sections are staged in Buf, overriding the segment
+  // bytes they replace.
+  for (auto It : Obj.getUpdatedSections()) {
+    SectionBase *Sec = It.first;
+    ArrayRef<uint8_t> Data = It.second;
+
+    auto *Parent = Sec->ParentSegment;
+    assert(Parent && "This section should've been part of a segment.");
+    uint64_t Offset =
+        Sec->OriginalOffset - Parent->OriginalOffset + Parent->Offset;
+    llvm::copy(Data, Buf->getBufferStart() + Offset);
+    Plan.insert(Offset, Offset + Data.size(), nullptr);
+  }
+
+  // Removed sections are overwritten with zeroes; the corresponding pages of
+  // Buf are never written and so already read as zero.
+  for (auto &Sec : Obj.removedSections()) {
+    Segment *Parent = Sec.ParentSegment;
+    if (Parent == nullptr || Sec.Type == SHT_NOBITS || Sec.Size == 0)
+      continue;
+    uint64_t Offset =
+        Sec.OriginalOffset - Parent->OriginalOffset + Parent->Offset;
+    Plan.insert(Offset, Offset + Sec.Size, nullptr);
+  }
+
   writeEhdr();
+  Plan.insert(0, sizeof(Elf_Ehdr), nullptr);
   writePhdrs();
+  Plan.insert(Obj.ProgramHdrSegment.Offset,
+              Obj.ProgramHdrSegment.Offset +
+                  llvm::size(Obj.segments()) * sizeof(Elf_Phdr),
+              nullptr);
   if (Error E = writeSectionData())
     return E;
-  if (WriteSectionHeaders)
+  for (const SectionBase &Sec : Obj.sections())
+    if (Sec.ParentSegment == nullptr && Sec.Type != SHT_NOBITS)
+      Plan.insert(Sec.Offset, Sec.Offset + Sec.Size, nullptr);
+  if (WriteSectionHeaders) {
     writeShdrs();
+    Plan.insert(Obj.SHOff, totalSize(), nullptr);
+  }
 
-  // TODO: Implement direct writing to the output stream (without intermediate
-  // memory buffer Buf).
-  Out.write(Buf->getBufferStart(), Buf->getBufferSize());
+  const char *BufStart = Buf->getBufferStart();
+  Plan.forEachRange(Buf->getBufferSize(), [&](uint64_t Begin, uint64_t End,
+                                              const uint8_t *Data) {
+    Out.write(Data ? reinterpret_cast<const char *>(Data) : BufStart + Begin,
+              End - Begin);
+  });
   return Error::success();
 }
 
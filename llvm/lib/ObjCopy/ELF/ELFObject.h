@@ -334,7 +334,6 @@ private:
   void writePhdrs();
   void writeShdrs();
   Error writeSectionData();
-  void writeSegmentData();
 
   void assignOffsets();
 
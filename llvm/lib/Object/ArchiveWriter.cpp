@@ -12,6 +12,7 @@
 
 #include "llvm/Object/ArchiveWriter.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
@@ -29,6 +30,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -547,9 +549,42 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
+  // Extract symbols from all members up front in parallel: reading each
+  // member's symbol table dominates the cost of writing large archives. Each
+  // member's symbol names are written to a private buffer and spliced into
+  // the shared name buffer in member order below, so the resulting symbol
+  // table is identical to what serial extraction produced.
+  std::vector<std::vector<unsigned>> MemberSymbols(NewMembers.size());
+  std::vector<SmallString<0>> MemberSymNames(NewMembers.size());
+  std::vector<char> MemberHasObject(NewMembers.size(), 0);
+  if (NeedSymbols) {
+    std::vector<Optional<Expected<std::vector<unsigned>>>> Results(
+        NewMembers.size());
+    parallelFor(0, NewMembers.size(), [&](size_t I) {
+      raw_svector_ostream MemberSymNamesOS(MemberSymNames[I]);
+      bool MemberObject = false;
+      Results[I].emplace(getSymbols(NewMembers[I].Buf->getMemBufferRef(),
+                                    MemberSymNamesOS, MemberObject));
+      MemberHasObject[I] = MemberObject;
+    });
+    // Report the first failing member, as serial extraction did.
+    for (size_t I = 0, E = Results.size(); I != E; ++I) {
+      if (!*Results[I]) {
+        Error Err =
+            createFileError(NewMembers[I].MemberName, Results[I]->takeError());
+        for (size_t J = I + 1; J != E; ++J)
+          if (!*Results[J])
+            consumeError(Results[J]->takeError());
+        return std::move(Err);
+      }
+      MemberSymbols[I] = std::move(**Results[I]);
+    }
+  }
+
   // The big archive format needs to know the offset of the previous member
   // header.
   unsigned PrevOffset = 0;
+  size_t MemberI = 0;
   for (const NewArchiveMember &M : NewMembers) {
     std::string Header;
     raw_string_ostream Out(Header);
@@ -596,12 +631,16 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     std::vector<unsigned> Symbols;
     if (NeedSymbols) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(Buf, SymNames, HasObject);
-      if (!SymbolsOrErr)
-        return createFileError(M.MemberName, SymbolsOrErr.takeError());
-      Symbols = std::move(*SymbolsOrErr);
+      // Rebase the name offsets computed against the member's private buffer
+      // and splice its names into the shared buffer.
+      Symbols = std::move(MemberSymbols[MemberI]);
+      uint64_t SymNamesBase = SymNames.tell();
+      for (unsigned &SymOffset : Symbols)
+        SymOffset += SymNamesBase;
+      SymNames << MemberSymNames[MemberI];
+      HasObject |= MemberHasObject[MemberI];
     }
+    ++MemberI;
 
     Pos += Header.size() + Data.size() + Padding.size();
     Ret.push_back({std::move(Symbols), std::move(Header), Data, Padding});
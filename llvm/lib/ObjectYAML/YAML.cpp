@@ -13,9 +13,12 @@
 
 #include "llvm/ObjectYAML/YAML.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <vector>
 
 using namespace llvm;
 
@@ -36,18 +39,46 @@ StringRef yaml::ScalarTraits<yaml::BinaryRef>::input(StringRef Scalar, void *,
   return {};
 }
 
+// Hex conversion is performed chunk-wise into pre-sized buffers instead of
+// going through the stream one byte at a time. Contents of at least
+// ParallelThreshold bytes are converted in parallel; each byte is independent
+// so the chunks can be processed in any order.
+static constexpr uint64_t ChunkSize = 4096;
+static constexpr uint64_t ParallelThreshold = 1 << 20;
+
 void yaml::BinaryRef::writeAsBinary(raw_ostream &OS, uint64_t N) const {
   if (!DataIsHexString) {
     OS.write((const char *)Data.data(), std::min<uint64_t>(N, Data.size()));
     return;
   }
 
-  for (uint64_t I = 0, E = std::min<uint64_t>(N, Data.size() / 2); I != E;
-       ++I) {
-    uint8_t Byte = llvm::hexDigitValue(Data[I * 2]);
-    Byte <<= 4;
-    Byte |= llvm::hexDigitValue(Data[I * 2 + 1]);
-    OS.write(Byte);
+  const uint64_t Bytes = std::min<uint64_t>(N, Data.size() / 2);
+  const auto DecodeChunk = [this](uint64_t Begin, uint64_t End, char *Out) {
+    for (uint64_t I = Begin; I != End; ++I) {
+      uint8_t Byte = llvm::hexDigitValue(Data[I * 2]);
+      Byte <<= 4;
+      Byte |= llvm::hexDigitValue(Data[I * 2 + 1]);
+      *Out++ = static_cast<char>(Byte);
+    }
+  };
+
+  if (Bytes >= ParallelThreshold) {
+    std::vector<char> Buffer(Bytes);
+    const uint64_t NumChunks = (Bytes + ChunkSize - 1) / ChunkSize;
+    parallelFor(0, NumChunks, [&](size_t C) {
+      const uint64_t Begin = C * ChunkSize;
+      DecodeChunk(Begin, std::min(Begin + ChunkSize, Bytes),
+                  Buffer.data() + Begin);
+    });
+    OS.write(Buffer.data(), Bytes);
+    return;
+  }
+
+  char Buffer[ChunkSize];
+  for (uint64_t Begin = 0; Begin < Bytes; Begin += ChunkSize) {
+    const uint64_t End = std::min(Begin + ChunkSize, Bytes);
+    DecodeChunk(Begin, End, Buffer);
+    OS.write(Buffer, End - Begin);
   }
 }
 
@@ -58,6 +89,31 @@ void yaml::BinaryRef::writeAsHex(raw_ostream &OS) const {
     OS.write((const char *)Data.data(), Data.size());
     return;
   }
-  for (uint8_t Byte : Data)
-    OS << hexdigit(Byte >> 4) << hexdigit(Byte & 0xf);
+
+  const uint64_t Bytes = Data.size();
+  const auto EncodeChunk = [this](uint64_t Begin, uint64_t End, char *Out) {
+    for (uint64_t I = Begin; I != End; ++I) {
+      *Out++ = hexdigit(Data[I] >> 4);
+      *Out++ = hexdigit(Data[I] & 0xf);
+    }
+  };
+
+  if (Bytes >= ParallelThreshold) {
+    std::vector<char> Buffer(2 * Bytes);
+    const uint64_t NumChunks = (Bytes + ChunkSize - 1) / ChunkSize;
+    parallelFor(0, NumChunks, [&](size_t C) {
+      const uint64_t Begin = C * ChunkSize;
+      EncodeChunk(Begin, std::min(Begin + ChunkSize, Bytes),
+                  Buffer.data() + 2 * Begin);
+    });
+    OS.write(Buffer.data(), Buffer.size());
+    return;
+  }
+
+  char Buffer[2 * ChunkSize];
+  for (uint64_t Begin = 0; Begin < Bytes; Begin += ChunkSize) {
+    const uint64_t End = std::min(Begin + ChunkSize, Bytes);
+    EncodeChunk(Begin, End, Buffer);
+    OS.write(Buffer, 2 * (End - Begin));
+  }
 }
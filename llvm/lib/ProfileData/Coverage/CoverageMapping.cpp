@@ -26,6 +26,8 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -343,10 +345,57 @@ static Error handleMaybeNoDataFoundError(Error E) {
       });
 }
 
+namespace {
+
+/// The buffers and readers created for one object file. The buffers must
+/// outlive the readers, which can reference memory they own.
+struct ObjectFileReaders {
+  SmallVector<std::unique_ptr<MemoryBuffer>, 4> Buffers;
+  SmallVector<std::unique_ptr<CoverageMappingReader>, 4> Readers;
+  Error Err = Error::success();
+};
+
+} // end anonymous namespace
+
+/// Open \p Filename and create coverage mapping readers for it. This is the
+/// I/O and decompression heavy part of loading an object file, and is safe to
+/// run concurrently for distinct files.
+static void createReadersForFile(StringRef Filename, StringRef Arch,
+                                 StringRef CompilationDir,
+                                 ArrayRef<StringRef> SourceFilenamesFilter,
+                                 ObjectFileReaders &Result) {
+  auto CovMappingBufOrErr = MemoryBuffer::getFileOrSTDIN(
+      Filename, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+  if (std::error_code EC = CovMappingBufOrErr.getError()) {
+    Result.Err = createFileError(Filename, errorCodeToError(EC));
+    return;
+  }
+  MemoryBufferRef CovMappingBufRef =
+      CovMappingBufOrErr.get()->getMemBufferRef();
+  auto CoverageReadersOrErr = BinaryCoverageReader::create(
+      CovMappingBufRef, Arch, Result.Buffers, CompilationDir);
+  if (Error E = CoverageReadersOrErr.takeError()) {
+    E = handleMaybeNoDataFoundError(std::move(E));
+    if (E)
+      Result.Err = createFileError(Filename, std::move(E));
+    // Otherwise E == success (originally a no_data_found error).
+    return;
+  }
+  for (auto &Reader : CoverageReadersOrErr.get()) {
+    if (!SourceFilenamesFilter.empty())
+      Reader->setSourceFilenamesFilter(SourceFilenamesFilter);
+    Result.Readers.push_back(std::move(Reader));
+  }
+  // The readers may reference the object file buffer directly, so keep it
+  // alive alongside the buffers BinaryCoverageReader::create produced.
+  Result.Buffers.push_back(std::move(CovMappingBufOrErr.get()));
+}
+
 Expected<std::unique_ptr<CoverageMapping>>
 CoverageMapping::load(ArrayRef<StringRef> ObjectFilenames,
                       StringRef ProfileFilename, ArrayRef<StringRef> Arches,
-                      StringRef CompilationDir) {
+                      StringRef CompilationDir,
+                      ArrayRef<StringRef> SourceFilenamesFilter) {
   auto ProfileReaderOrErr = IndexedInstrProfReader::create(ProfileFilename);
   if (Error E = ProfileReaderOrErr.takeError())
     return createFileError(ProfileFilename, std::move(E));
@@ -354,32 +403,45 @@ CoverageMapping::load(ArrayRef<StringRef> ObjectFilenames,
   auto Coverage = std::unique_ptr<CoverageMapping>(new CoverageMapping());
   bool DataFound = false;
 
+  // Creating the readers does the file reading and decompression; do it in
+  // parallel, one task per object file. Loading the records into the shared
+  // CoverageMapping mutates it, so that stays serial and in input order to
+  // keep the resulting mapping deterministic.
+  std::vector<ObjectFileReaders> FileReaders(ObjectFilenames.size());
+  auto CreateReaders = [&](size_t Index) {
+    StringRef Arch = Arches.empty() ? StringRef() : Arches[Index];
+    createReadersForFile(ObjectFilenames[Index], Arch, CompilationDir,
+                         SourceFilenamesFilter, FileReaders[Index]);
+  };
+  if (ObjectFilenames.size() > 1) {
+    ThreadPool Pool(heavyweight_hardware_concurrency(ObjectFilenames.size()));
+    for (size_t I = 0, E = ObjectFilenames.size(); I < E; ++I)
+      Pool.async(CreateReaders, I);
+    Pool.wait();
+  } else if (!ObjectFilenames.empty()) {
+    CreateReaders(0);
+  }
+
+  Error FirstError = Error::success();
   for (const auto &File : llvm::enumerate(ObjectFilenames)) {
-    auto CovMappingBufOrErr = MemoryBuffer::getFileOrSTDIN(
-        File.value(), /*IsText=*/false, /*RequiresNullTerminator=*/false);
-    if (std::error_code EC = CovMappingBufOrErr.getError())
-      return createFileError(File.value(), errorCodeToError(EC));
-    StringRef Arch = Arches.empty() ? StringRef() : Arches[File.index()];
-    MemoryBufferRef CovMappingBufRef =
-        CovMappingBufOrErr.get()->getMemBufferRef();
-    SmallVector<std::unique_ptr<MemoryBuffer>, 4> Buffers;
-    auto CoverageReadersOrErr = BinaryCoverageReader::create(
-        CovMappingBufRef, Arch, Buffers, CompilationDir);
-    if (Error E = CoverageReadersOrErr.takeError()) {
-      E = handleMaybeNoDataFoundError(std::move(E));
-      if (E)
-        return createFileError(File.value(), std::move(E));
-      // E == success (originally a no_data_found error).
+    ObjectFileReaders &Result = FileReaders[File.index()];
+    if (Result.Err) {
+      // Report the first failure; the errors for the remaining files must
+      // still be consumed.
+      if (FirstError)
+        consumeError(std::move(Result.Err));
+      else
+        FirstError = std::move(Result.Err);
       continue;
     }
-
-    SmallVector<std::unique_ptr<CoverageMappingReader>, 4> Readers;
-    for (auto &Reader : CoverageReadersOrErr.get())
-      Readers.push_back(std::move(Reader));
-    DataFound |= !Readers.empty();
-    if (Error E = loadFromReaders(Readers, *ProfileReader, *Coverage))
-      return createFileError(File.value(), std::move(E));
+    if (FirstError)
+      continue;
+    DataFound |= !Result.Readers.empty();
+    if (Error E = loadFromReaders(Result.Readers, *ProfileReader, *Coverage))
+      FirstError = createFileError(File.value(), std::move(E));
   }
+  if (FirstError)
+    return std::move(FirstError);
   // If no readers were created, either no objects were provided or none of them
   // had coverage data. Return an error in the latter case.
   if (!DataFound && !ObjectFilenames.empty())
@@ -1153,7 +1153,28 @@ BinaryCoverageReader::create(
   return std::move(Readers);
 }
 
+void BinaryCoverageReader::setSourceFilenamesFilter(
+    ArrayRef<StringRef> SourceFilenames) {
+  SourceFilenamesFilter.clear();
+  for (StringRef Filename : SourceFilenames)
+    SourceFilenamesFilter.insert(Filename);
+}
+
 Error BinaryCoverageReader::readNextRecord(CoverageMappingRecord &Record) {
+  // Skip records whose translation unit cannot mention any of the filtered
+  // filenames. Their counters and regions are left undecoded. The per-TU
+  // filename tables were decoded up front, so the check is a set lookup.
+  if (!SourceFilenamesFilter.empty())
+    while (CurrentRecord < MappingRecords.size()) {
+      auto &R = MappingRecords[CurrentRecord];
+      auto F = makeArrayRef(Filenames).slice(R.FilenamesBegin, R.FilenamesSize);
+      if (llvm::any_of(F, [&](const std::string &Filename) {
+            return SourceFilenamesFilter.contains(Filename);
+          }))
+        break;
+      ++CurrentRecord;
+    }
+
   if (CurrentRecord >= MappingRecords.size())
     return make_error<CoverageMapError>(coveragemap_error::eof);
 
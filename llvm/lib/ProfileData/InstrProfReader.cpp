@@ -14,6 +14,7 @@
 #include "llvm/ProfileData/InstrProfReader.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/ProfileSummary.h"
@@ -29,6 +30,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <system_error>
@@ -62,10 +64,19 @@ static InstrProfKind getProfileKindFromVersion(uint64_t Version) {
   return ProfileKind;
 }
 
+/// Read a profile file into a memory buffer.
+///
+/// When \p IsText is false, the file is opened in binary mode and without
+/// requiring a null terminator, which allows the contents to be memory-mapped
+/// instead of copied onto the heap. This keeps the resident memory needed to
+/// merge many large profiles bounded. Text profiles must be read with a null
+/// terminator (and CRLF translation on Windows) since the line-based reader
+/// requires both.
 static Expected<std::unique_ptr<MemoryBuffer>>
-setupMemoryBuffer(const Twine &Path) {
+setupMemoryBuffer(const Twine &Path, bool IsText) {
   ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
-      MemoryBuffer::getFileOrSTDIN(Path, /*IsText=*/true);
+      MemoryBuffer::getFileOrSTDIN(Path, IsText,
+                                   /*RequiresNullTerminator=*/IsText);
   if (std::error_code EC = BufferOrErr.getError())
     return errorCodeToError(EC);
   return std::move(BufferOrErr.get());
@@ -78,11 +89,36 @@ static Error initializeReader(InstrProfReader &Reader) {
 Expected<std::unique_ptr<InstrProfReader>>
 InstrProfReader::create(const Twine &Path,
                         const InstrProfCorrelator *Correlator) {
-  // Set up the buffer to read.
-  auto BufferOrError = setupMemoryBuffer(Path);
+  // Standard input cannot be reopened, so read it in text mode up front; the
+  // resulting buffer is heap-allocated and null-terminated either way.
+  SmallString<64> PathStorage;
+  if (Path.toStringRef(PathStorage) == "-") {
+    auto BufferOrError = setupMemoryBuffer(Path, /*IsText=*/true);
+    if (Error E = BufferOrError.takeError())
+      return std::move(E);
+    return InstrProfReader::create(std::move(BufferOrError.get()), Correlator);
+  }
+
+  // Set up the buffer to read, assuming a binary format so that the file can
+  // be memory-mapped.
+  auto BufferOrError = setupMemoryBuffer(Path, /*IsText=*/false);
   if (Error E = BufferOrError.takeError())
     return std::move(E);
-  return InstrProfReader::create(std::move(BufferOrError.get()), Correlator);
+  std::unique_ptr<MemoryBuffer> Buffer = std::move(BufferOrError.get());
+
+  // If the contents are not in one of the binary formats, reopen the file in
+  // text mode for the text reader.
+  if (Buffer->getBufferSize() != 0 &&
+      !IndexedInstrProfReader::hasFormat(*Buffer) &&
+      !RawInstrProfReader64::hasFormat(*Buffer) &&
+      !RawInstrProfReader32::hasFormat(*Buffer)) {
+    auto TextBufferOrError = setupMemoryBuffer(Path, /*IsText=*/true);
+    if (Error E = TextBufferOrError.takeError())
+      return std::move(E);
+    Buffer = std::move(TextBufferOrError.get());
+  }
+
+  return InstrProfReader::create(std::move(Buffer), Correlator);
 }
 
 Expected<std::unique_ptr<InstrProfReader>>
@@ -117,16 +153,19 @@ InstrProfReader::create(std::unique_ptr<MemoryBuffer> Buffer,
 
 Expected<std::unique_ptr<IndexedInstrProfReader>>
 IndexedInstrProfReader::create(const Twine &Path, const Twine &RemappingPath) {
-  // Set up the buffer to read.
-  auto BufferOrError = setupMemoryBuffer(Path);
+  // Set up the buffer to read. Indexed profiles are binary, so the file can
+  // be memory-mapped.
+  auto BufferOrError = setupMemoryBuffer(Path, /*IsText=*/false);
   if (Error E = BufferOrError.takeError())
     return std::move(E);
 
-  // Set up the remapping buffer if requested.
+  // Set up the remapping buffer if requested. The remapping file is parsed
+  // line by line and must be read in text mode.
   std::unique_ptr<MemoryBuffer> RemappingBuffer;
   std::string RemappingPathStr = RemappingPath.str();
   if (!RemappingPathStr.empty()) {
-    auto RemappingBufferOrError = setupMemoryBuffer(RemappingPathStr);
+    auto RemappingBufferOrError =
+        setupMemoryBuffer(RemappingPathStr, /*IsText=*/true);
     if (Error E = RemappingBufferOrError.takeError())
       return std::move(E);
     RemappingBuffer = std::move(RemappingBufferOrError.get());
@@ -683,9 +722,19 @@ data_type InstrProfLookupTrait::ReadData(StringRef K, const unsigned char *D,
       return data_type();
 
     CounterBuffer.clear();
-    CounterBuffer.reserve(CountsSize);
-    for (uint64_t J = 0; J < CountsSize; ++J)
-      CounterBuffer.push_back(endian::readNext<uint64_t, little, unaligned>(D));
+    if (sys::IsLittleEndianHost && CountsSize > 0) {
+      // The counters are stored little-endian, so on a little-endian host
+      // they can be copied in bulk out of the (possibly memory-mapped)
+      // buffer.
+      CounterBuffer.resize(CountsSize);
+      memcpy(CounterBuffer.data(), D, CountsSize * sizeof(uint64_t));
+      D += CountsSize * sizeof(uint64_t);
+    } else {
+      CounterBuffer.reserve(CountsSize);
+      for (uint64_t J = 0; J < CountsSize; ++J)
+        CounterBuffer.push_back(
+            endian::readNext<uint64_t, little, unaligned>(D));
+    }
 
     DataBuffer.emplace_back(K, Hash, std::move(CounterBuffer));
 
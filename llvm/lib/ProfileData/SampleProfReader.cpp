@@ -801,6 +801,50 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncOffsetTable() {
   if (std::error_code EC = Size.getError())
     return EC;
 
+  // When the reader has been given a module and the name table is fixed
+  // length MD5, the offset table can be filtered while it is scanned: the
+  // MD5 of each entry is read directly out of the mmapped name table, so
+  // there is no need to materialize name strings or map entries for the
+  // parts of the profile this module will never look at. Context-sensitive
+  // profiles are excluded because they load callee contexts beyond the
+  // functions defined in the module.
+  if (FixedLengthMD5 && !ProfileIsCS && collectFuncsFromModule()) {
+    DenseSet<uint64_t> FuncGuidsToUse;
+    for (StringRef Name : FuncsToUse)
+      FuncGuidsToUse.insert(MD5Hash(Name));
+
+    for (uint64_t I = 0; I < *Size; ++I) {
+      auto Idx = readStringIndex(NameTable);
+      if (std::error_code EC = Idx.getError())
+        return EC;
+
+      auto Offset = readNumber<uint64_t>();
+      if (std::error_code EC = Offset.getError())
+        return EC;
+
+      const uint8_t *SavedData = Data;
+      Data = MD5NameMemStart + ((*Idx) * sizeof(uint64_t));
+      auto FID = readUnencodedNumber<uint64_t>();
+      Data = SavedData;
+      if (std::error_code EC = FID.getError())
+        return EC;
+
+      if (!FuncGuidsToUse.count(*FID))
+        continue;
+
+      // Materialize the name of the retained entry the same way
+      // readStringFromTable does for names that are actually referenced.
+      StringRef &SR = NameTable[*Idx];
+      if (SR.empty()) {
+        MD5StringBuf->push_back(std::to_string(*FID));
+        SR = MD5StringBuf->back();
+      }
+      FuncOffsetTable[SampleContext(SR)] = *Offset;
+    }
+
+    return sampleprof_error::success;
+  }
+
   FuncOffsetTable.reserve(*Size);
 
   if (FuncOffsetsOrdered) {
@@ -228,6 +228,21 @@ APInt APInt::operator*(const APInt& RHS) const {
     return APInt(BitWidth, U.VAL * RHS.U.VAL);
 
   APInt Result(getMemory(getNumWords()), getBitWidth());
+#if defined(__SIZEOF_INT128__)
+  // Truncating two-word multiply as a native 128-bit operation; the generic
+  // word-by-word loop below costs several carries and branches per part.
+  if (getNumWords() == 2) {
+    unsigned __int128 lhs =
+        (static_cast<unsigned __int128>(U.pVal[1]) << 64) | U.pVal[0];
+    unsigned __int128 rhs =
+        (static_cast<unsigned __int128>(RHS.U.pVal[1]) << 64) | RHS.U.pVal[0];
+    unsigned __int128 res = lhs * rhs;
+    Result.U.pVal[0] = static_cast<uint64_t>(res);
+    Result.U.pVal[1] = static_cast<uint64_t>(res >> 64);
+    Result.clearUnusedBits();
+    return Result;
+  }
+#endif
   tcMultiply(Result.U.pVal, U.pVal, RHS.U.pVal, getNumWords());
   Result.clearUnusedBits();
   return Result;
@@ -612,8 +627,26 @@ APInt APInt::getLoBits(unsigned numBits) const {
 APInt APInt::getSplat(unsigned NewLen, const APInt &V) {
   assert(NewLen >= V.getBitWidth() && "Can't splat to smaller bit width!");
 
+  // When the element packs evenly into a 64-bit word, build the repeating
+  // word once and broadcast it across the result, rather than doubling the
+  // value with shift-or operations that each materialize a temporary APInt.
+  unsigned VBits = V.getBitWidth();
+  if (VBits && VBits <= 64 && 64 % VBits == 0) {
+    uint64_t Pattern = 0;
+    for (unsigned I = 0; I != 64; I += VBits)
+      Pattern |= V.U.VAL << I;
+    APInt Val(NewLen, 0);
+    if (Val.isSingleWord())
+      Val.U.VAL = Pattern;
+    else
+      for (unsigned I = 0, E = Val.getNumWords(); I != E; ++I)
+        Val.U.pVal[I] = Pattern;
+    Val.clearUnusedBits();
+    return Val;
+  }
+
   APInt Val = V.zext(NewLen);
-  for (unsigned I = V.getBitWidth(); I < NewLen; I <<= 1)
+  for (unsigned I = VBits; I < NewLen; I <<= 1)
     Val |= Val << I;
 
   return Val;
@@ -1449,6 +1482,32 @@ void APInt::divide(const WordType *LHS, unsigned lhsWords, const WordType *RHS,
                    unsigned rhsWords, WordType *Quotient, WordType *Remainder) {
   assert(lhsWords >= rhsWords && "Fractional result");
 
+#if defined(__SIZEOF_INT128__)
+  // Two-word operands are by far the most common multi-word case (i128/u128
+  // constant folding). When the compiler provides a native 128-bit integer
+  // type the division maps to a short libgcc/compiler-rt sequence, which is
+  // much cheaper than decomposing into 32-bit words for Knuth below.
+  if (lhsWords == 2 && rhsWords <= 2) {
+    unsigned __int128 lhs =
+        (static_cast<unsigned __int128>(LHS[1]) << 64) | LHS[0];
+    unsigned __int128 rhs =
+        rhsWords == 2 ? (static_cast<unsigned __int128>(RHS[1]) << 64) | RHS[0]
+                      : static_cast<unsigned __int128>(RHS[0]);
+    unsigned __int128 q = lhs / rhs;
+    if (Quotient) {
+      Quotient[0] = static_cast<uint64_t>(q);
+      Quotient[1] = static_cast<uint64_t>(q >> 64);
+    }
+    if (Remainder) {
+      unsigned __int128 r = lhs - q * rhs;
+      Remainder[0] = static_cast<uint64_t>(r);
+      if (rhsWords == 2)
+        Remainder[1] = static_cast<uint64_t>(r >> 64);
+    }
+    return;
+  }
+#endif
+
   // First, compose the values into an array of 32-bit words instead of
   // 64-bit words. This is a necessity of both the "short division" algorithm
   // and the Knuth "classical algorithm" which requires there to be native
@@ -17,6 +17,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include <atomic>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -26,6 +27,13 @@
 
 using namespace llvm;
 
+// Cache queries may run concurrently from the ThinLTO backend threads.
+static std::atomic<uint64_t> CacheHits(0);
+static std::atomic<uint64_t> CacheMisses(0);
+
+uint64_t llvm::localCacheHits() { return CacheHits.load(); }
+uint64_t llvm::localCacheMisses() { return CacheMisses.load(); }
+
 Expected<FileCache> llvm::localCache(Twine CacheNameRef,
                                      Twine TempFilePrefixRef,
                                      Twine CacheDirectoryPathRef,
@@ -54,6 +62,7 @@ Expected<FileCache> llvm::localCache(Twine CacheNameRef,
                                     /*RequiresNullTerminator=*/false);
       sys::fs::closeFile(*FDOrErr);
       if (MBOrErr) {
+        ++CacheHits;
         AddBuffer(Task, std::move(*MBOrErr));
         return AddStreamFn();
       }
@@ -72,6 +81,8 @@ Expected<FileCache> llvm::localCache(Twine CacheNameRef,
       return createStringError(EC, Twine("Failed to open cache file ") +
                                        EntryPath + ": " + EC.message() + "\n");
 
+    ++CacheMisses;
+
     // This file stream is responsible for commiting the resulting file to the
     // cache and calling AddBuffer to add it to the link.
     struct CacheStream : CachedFileStream {
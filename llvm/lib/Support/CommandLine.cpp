@@ -160,6 +160,12 @@ public:
   // ParseCommandLineOptions actually runs.
   SmallVector<Option*, 4> DefaultOptions;
 
+  // Options queued by Option::addArgument during static initialization. The
+  // per-subcommand option maps are built from this list on first use, so
+  // processes that never look at their options do not pay for hundreds of
+  // StringMap insertions before main.
+  SmallVector<Option *, 0> PendingOptions;
+
   // This collects the different option categories that have been registered.
   SmallPtrSet<OptionCategory *, 16> RegisteredOptionCategories;
 
@@ -253,6 +259,19 @@ public:
     }
   }
 
+  void addPendingOption(Option *O) { PendingOptions.push_back(O); }
+
+  // Register all queued options. Duplicate-registration errors surface here,
+  // on first use of the option maps, instead of during static initialization.
+  void flushPendingOptions() {
+    if (PendingOptions.empty())
+      return;
+    SmallVector<Option *, 0> Pending = std::move(PendingOptions);
+    PendingOptions.clear();
+    for (Option *O : Pending)
+      addOption(O);
+  }
+
   void addOption(Option *O, bool ProcessDefaultOption = false) {
     if (!ProcessDefaultOption && O->isDefaultOption()) {
       DefaultOptions.push_back(O);
@@ -301,6 +320,11 @@ public:
   }
 
   void removeOption(Option *O) {
+    // An option that is still queued was never added to any map.
+    if (llvm::is_contained(PendingOptions, O)) {
+      llvm::erase_value(PendingOptions, O);
+      return;
+    }
     if (O->Subs.empty())
       removeOption(O, &SubCommand::getTopLevel());
     else {
@@ -340,6 +364,10 @@ public:
   }
 
   void updateArgStr(Option *O, StringRef NewName) {
+    // A queued option is not in any map yet; it will be registered under its
+    // updated name when the maps are built.
+    if (llvm::is_contained(PendingOptions, O))
+      return;
     if (O->Subs.empty())
       updateArgStr(O, NewName, &SubCommand::getTopLevel());
     else {
@@ -415,6 +443,7 @@ public:
     registerSubCommand(&SubCommand::getAll());
 
     DefaultOptions.clear();
+    PendingOptions.clear();
   }
 
 private:
@@ -444,7 +473,7 @@ extrahelp::extrahelp(StringRef Help) : morehelp(Help) {
 }
 
 void Option::addArgument() {
-  GlobalParser->addOption(this);
+  GlobalParser->addPendingOption(this);
   FullyInitialized = true;
 }
 
@@ -1436,6 +1465,7 @@ bool CommandLineParser::ParseCommandLineOptions(int argc,
                                                 StringRef Overview,
                                                 raw_ostream *Errs,
                                                 bool LongOptionsUseDoubleDash) {
+  flushPendingOptions();
   assert(hasOptions() && "No options specified!");
 
   // Expand response files.
@@ -2678,6 +2708,7 @@ void CommandLineParser::printOptionValues() {
 
 // Utility function for printing the help message.
 void cl::PrintHelpMessage(bool Hidden, bool Categorized) {
+  GlobalParser->flushPendingOptions();
   if (!Hidden && !Categorized)
     CommonOptions->UncategorizedNormalPrinter.printHelp();
   else if (!Hidden && Categorized)
@@ -2703,6 +2734,7 @@ void cl::AddExtraVersionPrinter(VersionPrinterTy func) {
 
 StringMap<Option *> &cl::getRegisteredOptions(SubCommand &Sub) {
   initCommonOptions();
+  GlobalParser->flushPendingOptions();
   auto &Subs = GlobalParser->RegisteredSubCommands;
   (void)Subs;
   assert(is_contained(Subs, &Sub));
@@ -2716,6 +2748,7 @@ cl::getRegisteredSubcommands() {
 
 void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
   initCommonOptions();
+  GlobalParser->flushPendingOptions();
   for (auto &I : Sub.OptionsMap) {
     bool Unrelated = true;
     for (auto &Cat : I.second->Categories) {
@@ -2730,6 +2763,7 @@ void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
 void cl::HideUnrelatedOptions(ArrayRef<const cl::OptionCategory *> Categories,
                               SubCommand &Sub) {
   initCommonOptions();
+  GlobalParser->flushPendingOptions();
   for (auto &I : Sub.OptionsMap) {
     bool Unrelated = true;
     for (auto &Cat : I.second->Categories) {
@@ -21,6 +21,7 @@
 #include <zlib.h>
 #endif
 #if LLVM_ENABLE_ZSTD
+#include <zdict.h>
 #include <zstd.h>
 #endif
 
@@ -154,13 +155,32 @@ Error zlib::uncompress(ArrayRef<uint8_t> Input,
 
 bool zstd::isAvailable() { return true; }
 
+// Creating a zstd context is not free, and compressing many small artifacts
+// (PCMs, bitcode blobs) one-shot pays for it every call. Keep one context of
+// each kind per thread and reuse it. The contexts are intentionally leaked at
+// thread exit; they are small and this avoids ordering problems with other
+// thread_local destructors.
+static ZSTD_CCtx *getCCtx() {
+  static thread_local ZSTD_CCtx *CCtx = nullptr;
+  if (!CCtx)
+    CCtx = ::ZSTD_createCCtx();
+  return CCtx;
+}
+
+static ZSTD_DCtx *getDCtx() {
+  static thread_local ZSTD_DCtx *DCtx = nullptr;
+  if (!DCtx)
+    DCtx = ::ZSTD_createDCtx();
+  return DCtx;
+}
+
 void zstd::compress(ArrayRef<uint8_t> Input,
                     SmallVectorImpl<uint8_t> &CompressedBuffer, int Level) {
   unsigned long CompressedBufferSize = ::ZSTD_compressBound(Input.size());
   CompressedBuffer.resize_for_overwrite(CompressedBufferSize);
-  unsigned long CompressedSize =
-      ::ZSTD_compress((char *)CompressedBuffer.data(), CompressedBufferSize,
-                      (const char *)Input.data(), Input.size(), Level);
+  unsigned long CompressedSize = ::ZSTD_compressCCtx(
+      getCCtx(), (char *)CompressedBuffer.data(), CompressedBufferSize,
+      (const char *)Input.data(), Input.size(), Level);
   if (ZSTD_isError(CompressedSize))
     report_bad_alloc_error("Allocation failed");
   // Tell MemorySanitizer that zstd output buffer is fully initialized.
@@ -173,8 +193,8 @@ void zstd::compress(ArrayRef<uint8_t> Input,
 Error zstd::uncompress(ArrayRef<uint8_t> Input, uint8_t *UncompressedBuffer,
                        size_t &UncompressedSize) {
   const size_t Res =
-      ::ZSTD_decompress(UncompressedBuffer, UncompressedSize,
-                        (const uint8_t *)Input.data(), Input.size());
+      ::ZSTD_decompressDCtx(getDCtx(), UncompressedBuffer, UncompressedSize,
+                            (const uint8_t *)Input.data(), Input.size());
   UncompressedSize = Res;
   // Tell MemorySanitizer that zstd output buffer is fully initialized.
   // This avoids a false report when running LLVM with uninstrumented ZLib.
@@ -184,6 +204,64 @@ Error zstd::uncompress(ArrayRef<uint8_t> Input, uint8_t *UncompressedBuffer,
                            : Error::success();
 }
 
+zstd::Dictionary::Dictionary(SmallVector<uint8_t, 0> Data, int Level)
+    : Buffer(std::move(Data)) {
+  CDict = ::ZSTD_createCDict(Buffer.data(), Buffer.size(), Level);
+  DDict = ::ZSTD_createDDict(Buffer.data(), Buffer.size());
+}
+
+zstd::Dictionary::~Dictionary() {
+  ::ZSTD_freeCDict(static_cast<ZSTD_CDict *>(CDict));
+  ::ZSTD_freeDDict(static_cast<ZSTD_DDict *>(DDict));
+}
+
+Error zstd::trainDictionary(ArrayRef<uint8_t> SampleData,
+                            ArrayRef<size_t> SampleSizes, size_t MaxDictSize,
+                            SmallVectorImpl<uint8_t> &Dictionary) {
+  Dictionary.resize_for_overwrite(MaxDictSize);
+  size_t Res =
+      ::ZDICT_trainFromBuffer(Dictionary.data(), MaxDictSize, SampleData.data(),
+                              SampleSizes.data(), SampleSizes.size());
+  if (ZDICT_isError(Res))
+    return make_error<StringError>(ZDICT_getErrorName(Res),
+                                   inconvertibleErrorCode());
+  __msan_unpoison(Dictionary.data(), Res);
+  Dictionary.truncate(Res);
+  return Error::success();
+}
+
+void zstd::compress(ArrayRef<uint8_t> Input,
+                    SmallVectorImpl<uint8_t> &CompressedBuffer,
+                    const Dictionary &Dict) {
+  unsigned long CompressedBufferSize = ::ZSTD_compressBound(Input.size());
+  CompressedBuffer.resize_for_overwrite(CompressedBufferSize);
+  unsigned long CompressedSize = ::ZSTD_compress_usingCDict(
+      getCCtx(), (char *)CompressedBuffer.data(), CompressedBufferSize,
+      (const char *)Input.data(), Input.size(),
+      static_cast<const ZSTD_CDict *>(Dict.CDict));
+  if (ZSTD_isError(CompressedSize))
+    report_bad_alloc_error("Allocation failed");
+  __msan_unpoison(CompressedBuffer.data(), CompressedSize);
+  if (CompressedSize < CompressedBuffer.size())
+    CompressedBuffer.truncate(CompressedSize);
+}
+
+Error zstd::uncompress(ArrayRef<uint8_t> Input,
+                       SmallVectorImpl<uint8_t> &UncompressedBuffer,
+                       size_t UncompressedSize, const Dictionary &Dict) {
+  UncompressedBuffer.resize_for_overwrite(UncompressedSize);
+  const size_t Res = ::ZSTD_decompress_usingDDict(
+      getDCtx(), UncompressedBuffer.data(), UncompressedSize, Input.data(),
+      Input.size(), static_cast<const ZSTD_DDict *>(Dict.DDict));
+  if (ZSTD_isError(Res))
+    return make_error<StringError>(ZSTD_getErrorName(Res),
+                                   inconvertibleErrorCode());
+  __msan_unpoison(UncompressedBuffer.data(), Res);
+  if (Res < UncompressedBuffer.size())
+    UncompressedBuffer.truncate(Res);
+  return Error::success();
+}
+
 Error zstd::uncompress(ArrayRef<uint8_t> Input,
                        SmallVectorImpl<uint8_t> &UncompressedBuffer,
                        size_t UncompressedSize) {
@@ -210,4 +288,22 @@ Error zstd::uncompress(ArrayRef<uint8_t> Input,
                        size_t UncompressedSize) {
   llvm_unreachable("zstd::uncompress is unavailable");
 }
+zstd::Dictionary::Dictionary(SmallVector<uint8_t, 0> Data, int Level)
+    : Buffer(std::move(Data)) {}
+zstd::Dictionary::~Dictionary() = default;
+Error zstd::trainDictionary(ArrayRef<uint8_t> SampleData,
+                            ArrayRef<size_t> SampleSizes, size_t MaxDictSize,
+                            SmallVectorImpl<uint8_t> &Dictionary) {
+  llvm_unreachable("zstd::trainDictionary is unavailable");
+}
+void zstd::compress(ArrayRef<uint8_t> Input,
+                    SmallVectorImpl<uint8_t> &CompressedBuffer,
+                    const Dictionary &Dict) {
+  llvm_unreachable("zstd::compress is unavailable");
+}
+Error zstd::uncompress(ArrayRef<uint8_t> Input,
+                       SmallVectorImpl<uint8_t> &UncompressedBuffer,
+                       size_t UncompressedSize, const Dictionary &Dict) {
+  llvm_unreachable("zstd::uncompress is unavailable");
+}
 #endif
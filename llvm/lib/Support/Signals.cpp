@@ -127,6 +127,15 @@ static bool findModulesAndOffsets(void **StackTrace, int Depth,
                                   const char *MainExecutableName,
                                   StringSaver &StrPool);
 
+// An optional in-process symbolizer, tried before shelling out to an external
+// llvm-symbolizer binary. Stored atomically because a crash on another thread
+// may read it while it is being installed.
+static std::atomic<sys::InProcessSymbolizerFn> InProcessSymbolizer(nullptr);
+
+void sys::setInProcessSymbolizer(InProcessSymbolizerFn Symbolizer) {
+  InProcessSymbolizer.store(Symbolizer);
+}
+
 /// Format a pointer value as hexadecimal. Zero pad it out so its always the
 /// same width.
 static FormattedNumber format_ptr(void *PC) {
@@ -142,6 +151,25 @@ static bool printSymbolizedStackTrace(StringRef Argv0, void **StackTrace,
   if (DisableSymbolicationFlag || getenv(DisableSymbolizationEnv))
     return false;
 
+  // If we don't know argv0 or the address of main() at this point, try
+  // to guess it anyway (it's possible on some platforms).
+  std::string MainExecutableName =
+      sys::fs::exists(Argv0) ? (std::string)std::string(Argv0)
+                             : sys::fs::getMainExecutable(nullptr, nullptr);
+  BumpPtrAllocator Allocator;
+  StringSaver StrPool(Allocator);
+  std::vector<const char *> Modules(Depth, nullptr);
+  std::vector<intptr_t> Offsets(Depth, 0);
+  if (!findModulesAndOffsets(StackTrace, Depth, Modules.data(), Offsets.data(),
+                             MainExecutableName.c_str(), StrPool))
+    return false;
+
+  // An installed in-process symbolizer takes precedence over launching an
+  // external one; it keeps working when the process can no longer exec.
+  if (sys::InProcessSymbolizerFn Symbolizer = InProcessSymbolizer.load())
+    if (Symbolizer(StackTrace, Depth, Modules.data(), Offsets.data(), OS))
+      return true;
+
   // Don't recursively invoke the llvm-symbolizer binary.
   if (Argv0.find("llvm-symbolizer") != std::string::npos)
     return false;
@@ -164,18 +192,6 @@ static bool printSymbolizedStackTrace(StringRef Argv0, void **StackTrace,
     return false;
   const std::string &LLVMSymbolizerPath = *LLVMSymbolizerPathOrErr;
 
-  // If we don't know argv0 or the address of main() at this point, try
-  // to guess it anyway (it's possible on some platforms).
-  std::string MainExecutableName =
-      sys::fs::exists(Argv0) ? (std::string)std::string(Argv0)
-                             : sys::fs::getMainExecutable(nullptr, nullptr);
-  BumpPtrAllocator Allocator;
-  StringSaver StrPool(Allocator);
-  std::vector<const char *> Modules(Depth, nullptr);
-  std::vector<intptr_t> Offsets(Depth, 0);
-  if (!findModulesAndOffsets(StackTrace, Depth, Modules.data(), Offsets.data(),
-                             MainExecutableName.c_str(), StrPool))
-    return false;
   int InputFD;
   SmallString<32> InputFile, OutputFile;
   sys::fs::createTemporaryFile("symbolizer-input", "", InputFD, InputFile);
@@ -13,6 +13,11 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/DJB.h"
 #include "llvm/Support/MathExtras.h"
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace llvm;
 
@@ -28,8 +33,11 @@ static inline unsigned getMinBucketToReserveForEntries(unsigned NumEntries) {
 }
 
 static inline StringMapEntryBase **createTable(unsigned NewNumBuckets) {
-  auto **Table = static_cast<StringMapEntryBase **>(safe_calloc(
-      NewNumBuckets + 1, sizeof(StringMapEntryBase **) + sizeof(unsigned)));
+  // The hash value array is followed by one control byte per bucket; the
+  // zero-initialization from safe_calloc marks every bucket empty.
+  auto **Table = static_cast<StringMapEntryBase **>(
+      safe_calloc(NewNumBuckets + 1, sizeof(StringMapEntryBase **) +
+                                         sizeof(unsigned) + sizeof(uint8_t)));
 
   // Allocate one extra bucket, set it to look filled so the iterators stop at
   // end.
@@ -42,8 +50,32 @@ static inline unsigned *getHashTable(StringMapEntryBase **TheTable,
   return reinterpret_cast<unsigned *>(TheTable + NumBuckets + 1);
 }
 
-StringMapImpl::StringMapImpl(unsigned InitSize, unsigned itemSize) {
+/// Return a bitmask with one bit per bucket of the 16-byte control group at
+/// \p Group, set when the control byte equals \p Byte.
+static inline uint32_t matchControlBytes(const uint8_t *Group, uint8_t Byte) {
+#if defined(__SSE2__)
+  __m128i Ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Group));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(Ctrl, _mm_set1_epi8(char(Byte))));
+#else
+  // Portable bit-parallel fallback (also reasonable on NEON targets): detect
+  // matching bytes within each 64-bit half, then gather the per-byte high
+  // bits into the low byte of the product.
+  uint32_t Mask = 0;
+  for (unsigned Half = 0; Half != 2; ++Half) {
+    uint64_t Word;
+    memcpy(&Word, Group + Half * 8, 8);
+    uint64_t X = Word ^ (0x0101010101010101ULL * Byte);
+    uint64_t Match = (X - 0x0101010101010101ULL) & ~X & 0x8080808080808080ULL;
+    Mask |= uint32_t((Match * 0x0002040810204081ULL) >> 56) << (Half * 8);
+  }
+  return Mask;
+#endif
+}
+
+StringMapImpl::StringMapImpl(unsigned InitSize, unsigned itemSize,
+                             bool GroupProbing) {
   ItemSize = itemSize;
+  this->GroupProbing = GroupProbing;
 
   // If a size is specified, initialize the table with that many buckets.
   if (InitSize) {
@@ -84,6 +116,8 @@ unsigned StringMapImpl::LookupBucketFor(StringRef Name) {
   // Hash table unallocated so far?
   if (NumBuckets == 0)
     init(16);
+  if (GroupProbing)
+    return LookupBucketForGrouped(Name);
   unsigned FullHashValue = djbHash(Name, 0);
   unsigned BucketNo = FullHashValue & (NumBuckets - 1);
   unsigned *HashTable = getHashTable(TheTable, NumBuckets);
@@ -139,6 +173,8 @@ unsigned StringMapImpl::LookupBucketFor(StringRef Name) {
 int StringMapImpl::FindKey(StringRef Key) const {
   if (NumBuckets == 0)
     return -1; // Really empty table?
+  if (GroupProbing)
+    return FindKeyGrouped(Key);
   unsigned FullHashValue = djbHash(Key, 0);
   unsigned BucketNo = FullHashValue & (NumBuckets - 1);
   unsigned *HashTable = getHashTable(TheTable, NumBuckets);
@@ -176,6 +212,90 @@ int StringMapImpl::FindKey(StringRef Key) const {
   }
 }
 
+/// LookupBucketForGrouped - Group-probing flavor of LookupBucketFor: probe
+/// aligned groups of GroupSize buckets, scanning each group's control bytes
+/// in one step. Groups are aligned, so they never straddle the table end.
+unsigned StringMapImpl::LookupBucketForGrouped(StringRef Name) {
+  unsigned FullHashValue = djbHash(Name, 0);
+  unsigned *HashTable = getHashTable(TheTable, NumBuckets);
+  uint8_t *ControlTable = getControlTable();
+  uint8_t MatchByte = uint8_t(0x80 | (FullHashValue & 0x7f));
+
+  unsigned GroupBase = FullHashValue & (NumBuckets - 1) & ~(GroupSize - 1);
+  int FirstTombstone = -1;
+  while (true) {
+    uint32_t Matches = matchControlBytes(ControlTable + GroupBase, MatchByte);
+    while (Matches) {
+      unsigned BucketNo = GroupBase + countTrailingZeros(Matches);
+      Matches &= Matches - 1;
+      if (HashTable[BucketNo] != FullHashValue)
+        continue;
+
+      // Do the comparison like this because Name isn't necessarily
+      // null-terminated!
+      StringMapEntryBase *BucketItem = TheTable[BucketNo];
+      char *ItemStr = (char *)BucketItem + ItemSize;
+      if (Name == StringRef(ItemStr, BucketItem->getKeyLength()))
+        return BucketNo;
+    }
+
+    uint32_t Empties = matchControlBytes(ControlTable + GroupBase, ControlEmpty);
+    if (Empties) {
+      // If we passed a tombstone, reuse it instead of an empty bucket. This
+      // reduces probing.
+      if (FirstTombstone != -1) {
+        HashTable[FirstTombstone] = FullHashValue;
+        return FirstTombstone;
+      }
+
+      unsigned BucketNo = GroupBase + countTrailingZeros(Empties);
+      HashTable[BucketNo] = FullHashValue;
+      return BucketNo;
+    }
+
+    if (FirstTombstone == -1)
+      if (uint32_t Tombstones =
+              matchControlBytes(ControlTable + GroupBase, ControlTombstone))
+        FirstTombstone = GroupBase + countTrailingZeros(Tombstones);
+
+    // No match and no empty bucket in this group; move to the next one.
+    GroupBase = (GroupBase + GroupSize) & (NumBuckets - 1);
+  }
+}
+
+/// FindKeyGrouped - Group-probing flavor of FindKey. This does not modify the
+/// map.
+int StringMapImpl::FindKeyGrouped(StringRef Key) const {
+  unsigned FullHashValue = djbHash(Key, 0);
+  unsigned *HashTable = getHashTable(TheTable, NumBuckets);
+  uint8_t *ControlTable = getControlTable();
+  uint8_t MatchByte = uint8_t(0x80 | (FullHashValue & 0x7f));
+
+  unsigned GroupBase = FullHashValue & (NumBuckets - 1) & ~(GroupSize - 1);
+  while (true) {
+    uint32_t Matches = matchControlBytes(ControlTable + GroupBase, MatchByte);
+    while (Matches) {
+      unsigned BucketNo = GroupBase + countTrailingZeros(Matches);
+      Matches &= Matches - 1;
+      if (HashTable[BucketNo] != FullHashValue)
+        continue;
+
+      // Do the comparison like this because Key isn't necessarily
+      // null-terminated!
+      StringMapEntryBase *BucketItem = TheTable[BucketNo];
+      char *ItemStr = (char *)BucketItem + ItemSize;
+      if (Key == StringRef(ItemStr, BucketItem->getKeyLength()))
+        return BucketNo;
+    }
+
+    // An empty bucket terminates the probe sequence.
+    if (matchControlBytes(ControlTable + GroupBase, ControlEmpty))
+      return -1;
+
+    GroupBase = (GroupBase + GroupSize) & (NumBuckets - 1);
+  }
+}
+
 /// RemoveKey - Remove the specified StringMapEntry from the table, but do not
 /// delete it.  This aborts if the value isn't in the table.
 void StringMapImpl::RemoveKey(StringMapEntryBase *V) {
@@ -194,6 +314,8 @@ StringMapEntryBase *StringMapImpl::RemoveKey(StringRef Key) {
 
   StringMapEntryBase *Result = TheTable[Bucket];
   TheTable[Bucket] = getTombstoneVal();
+  if (GroupProbing)
+    getControlTable()[Bucket] = ControlTombstone;
   --NumItems;
   ++NumTombstones;
   assert(NumItems + NumTombstones <= NumBuckets);
@@ -220,6 +342,8 @@ unsigned StringMapImpl::RehashTable(unsigned BucketNo) {
   unsigned NewBucketNo = BucketNo;
   auto **NewTableArray = createTable(NewSize);
   unsigned *NewHashArray = getHashTable(NewTableArray, NewSize);
+  uint8_t *NewControlArray =
+      reinterpret_cast<uint8_t *>(NewHashArray + NewSize + 1);
   unsigned *HashTable = getHashTable(TheTable, NumBuckets);
 
   // Rehash all the items into their new buckets.  Luckily :) we already have
@@ -227,10 +351,25 @@ unsigned StringMapImpl::RehashTable(unsigned BucketNo) {
   for (unsigned I = 0, E = NumBuckets; I != E; ++I) {
     StringMapEntryBase *Bucket = TheTable[I];
     if (Bucket && Bucket != getTombstoneVal()) {
-      // If the bucket is not available, probe for a spot.
       unsigned FullHash = HashTable[I];
       unsigned NewBucket = FullHash & (NewSize - 1);
-      if (NewTableArray[NewBucket]) {
+      if (GroupProbing) {
+        // Place the item in the first free bucket along its group probe
+        // sequence so that grouped lookups can find it.
+        NewBucket &= ~(GroupSize - 1);
+        while (true) {
+          unsigned J = 0;
+          while (J != GroupSize && NewTableArray[NewBucket + J])
+            ++J;
+          if (J != GroupSize) {
+            NewBucket += J;
+            break;
+          }
+          NewBucket = (NewBucket + GroupSize) & (NewSize - 1);
+        }
+        NewControlArray[NewBucket] = uint8_t(0x80 | (FullHash & 0x7f));
+      } else if (NewTableArray[NewBucket]) {
+        // If the bucket is not available, probe for a spot.
         unsigned ProbeSize = 1;
         do {
           NewBucket = (NewBucket + ProbeSize++) & (NewSize - 1);
@@ -33,7 +33,19 @@ using namespace llvm;
 // pointer.
 
 ThreadPool::ThreadPool(ThreadPoolStrategy S)
-    : Strategy(S), MaxThreadCount(S.compute_thread_count()) {}
+    : Strategy(S), MaxThreadCount(S.compute_thread_count()) {
+  if (S.UseWorkStealing) {
+    WorkerQueues.reserve(MaxThreadCount);
+    for (unsigned I = 0; I != MaxThreadCount; ++I)
+      WorkerQueues.push_back(std::make_unique<WorkerQueue>());
+  }
+}
+
+// The pool the current worker thread belongs to, and its index in the pool.
+// Only meaningful on worker threads; used to find the thread's own deque in
+// work-stealing mode. processTasks() only ever runs on this pool's workers.
+static LLVM_THREAD_LOCAL ThreadPool *CurrentWorkerPool = nullptr;
+static LLVM_THREAD_LOCAL unsigned CurrentWorkerIndex = 0;
 
 void ThreadPool::grow(int requested) {
   llvm::sys::ScopedWriter LockGuard(ThreadsLock);
@@ -43,12 +55,56 @@ void ThreadPool::grow(int requested) {
   while (static_cast<int>(Threads.size()) < newThreadCount) {
     int ThreadID = Threads.size();
     Threads.emplace_back([this, ThreadID] {
+      CurrentWorkerPool = this;
+      CurrentWorkerIndex = ThreadID;
       Strategy.apply_thread_strategy(ThreadID);
       processTasks(nullptr);
     });
   }
 }
 
+ThreadPool::WorkerQueue &ThreadPool::pickWorkerQueue() {
+  if (CurrentWorkerPool == this)
+    return *WorkerQueues[CurrentWorkerIndex];
+  return *WorkerQueues[NextQueueIndex++ % WorkerQueues.size()];
+}
+
+bool ThreadPool::popTask(unsigned WorkerIndex, QueueTaskTy &Task) {
+  {
+    WorkerQueue &Own = *WorkerQueues[WorkerIndex];
+    std::lock_guard<std::mutex> LockGuard(Own.Mutex);
+    if (!Own.Deque.empty()) {
+      Task = std::move(Own.Deque.back());
+      Own.Deque.pop_back();
+      return true;
+    }
+  }
+  // Nothing of our own left; steal the oldest task from another worker.
+  for (unsigned I = 1, E = WorkerQueues.size(); I != E; ++I) {
+    WorkerQueue &Victim = *WorkerQueues[(WorkerIndex + I) % E];
+    std::lock_guard<std::mutex> LockGuard(Victim.Mutex);
+    if (!Victim.Deque.empty()) {
+      Task = std::move(Victim.Deque.front());
+      Victim.Deque.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::claimTaskUnlocked(ThreadPoolTaskGroup *Group) {
+  --PendingTasks;
+  if (Group != nullptr) {
+    // Need to count active threads in each group separately, ActiveThreads
+    // would never be 0 if waiting for another group inside a wait.
+    ++ActiveGroups[Group]; // Increment or set to 1 if new item
+    auto Pending = PendingGroupTasks.find(Group);
+    assert(Pending != PendingGroupTasks.end() && "Claimed an uncounted task");
+    if (--(Pending->second) == 0)
+      PendingGroupTasks.erase(Pending);
+  }
+}
+
 #ifndef NDEBUG
 // The group of the tasks run by the current thread.
 static LLVM_THREAD_LOCAL std::vector<ThreadPoolTaskGroup *>
@@ -57,21 +113,24 @@ static LLVM_THREAD_LOCAL std::vector<ThreadPoolTaskGroup *>
 
 // WaitingForGroup == nullptr means all tasks regardless of their group.
 void ThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
+  const bool WorkStealing = !WorkerQueues.empty();
+  assert((!WorkStealing || CurrentWorkerPool == this) &&
+         "Expected to run on a worker thread of this pool");
   while (true) {
-    std::function<void()> Task;
+    QueueTaskTy Task;
     ThreadPoolTaskGroup *GroupOfTask;
     {
       std::unique_lock<std::mutex> LockGuard(QueueLock);
       bool workCompletedForGroup = false; // Result of workCompletedUnlocked()
       // Wait for tasks to be pushed in the queue
       QueueCondition.wait(LockGuard, [&] {
-        return !EnableFlag || !Tasks.empty() ||
+        return !EnableFlag || hasPendingTasksUnlocked() ||
                (WaitingForGroup != nullptr &&
                 (workCompletedForGroup =
                      workCompletedUnlocked(WaitingForGroup)));
       });
       // Exit condition
-      if (!EnableFlag && Tasks.empty())
+      if (!EnableFlag && !hasPendingTasksUnlocked())
         return;
       if (WaitingForGroup != nullptr && workCompletedForGroup)
         return;
@@ -81,14 +140,27 @@ void ThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
       // in order for wait() to properly detect that even if the queue is
       // empty, there is still a task in flight.
       ++ActiveThreads;
-      Task = std::move(Tasks.front().first);
-      GroupOfTask = Tasks.front().second;
-      // Need to count active threads in each group separately, ActiveThreads
-      // would never be 0 if waiting for another group inside a wait.
-      if (GroupOfTask != nullptr)
-        ++ActiveGroups[GroupOfTask]; // Increment or set to 1 if new item
-      Tasks.pop_front();
+      if (!WorkStealing) {
+        Task = std::move(Tasks.front());
+        Tasks.pop_front();
+        claimTaskUnlocked(Task.second);
+      }
     }
+    if (WorkStealing) {
+      // Claim a task from the per-worker deques, outside of QueueLock. It may
+      // already be gone: pending tasks can be claimed by any worker that saw
+      // the counter, so losing the race just means going back to sleep.
+      if (!popTask(CurrentWorkerIndex, Task)) {
+        std::lock_guard<std::mutex> LockGuard(QueueLock);
+        --ActiveThreads;
+        if (workCompletedUnlocked(nullptr))
+          CompletionCondition.notify_all();
+        continue;
+      }
+      std::lock_guard<std::mutex> LockGuard(QueueLock);
+      claimTaskUnlocked(Task.second);
+    }
+    GroupOfTask = Task.second;
 #ifndef NDEBUG
     if (CurrentThreadTaskGroups == nullptr)
       CurrentThreadTaskGroups = new std::vector<ThreadPoolTaskGroup *>;
@@ -96,7 +168,7 @@ void ThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
 #endif
 
     // Run the task we just grabbed
-    Task();
+    Task.first();
 
 #ifndef NDEBUG
     CurrentThreadTaskGroups->pop_back();
@@ -134,10 +206,8 @@ void ThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
 
 bool ThreadPool::workCompletedUnlocked(ThreadPoolTaskGroup *Group) const {
   if (Group == nullptr)
-    return !ActiveThreads && Tasks.empty();
-  return ActiveGroups.count(Group) == 0 &&
-         !llvm::any_of(Tasks,
-                       [Group](const auto &T) { return T.second == Group; });
+    return !ActiveThreads && !hasPendingTasksUnlocked();
+  return ActiveGroups.count(Group) == 0 && PendingGroupTasks.count(Group) == 0;
 }
 
 void ThreadPool::wait() {
@@ -18,6 +18,7 @@
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Threading.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <mutex>
@@ -44,6 +45,11 @@ TimeTraceProfilerInstances &getTimeTraceProfilerInstances() {
 // Per Thread instance
 static LLVM_THREAD_LOCAL TimeTraceProfiler *TimeTraceProfilerInstance = nullptr;
 
+// Sampling interval in microseconds; nonzero switches instances into sampling
+// mode. Worker threads initialize their own profiler instances, so this is
+// process-global rather than a constructor argument.
+static std::atomic<unsigned> SamplingIntervalUs;
+
 TimeTraceProfiler *llvm::getTimeTraceProfilerInstance() {
   return TimeTraceProfilerInstance;
 }
@@ -86,19 +92,30 @@ struct llvm::TimeTraceProfiler {
   TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "")
       : BeginningOfTime(system_clock::now()), StartTime(steady_clock::now()),
         ProcName(ProcName), Pid(sys::Process::getProcessId()),
-        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity) {
+        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity),
+        SampleIntervalUs(SamplingIntervalUs.load(std::memory_order_relaxed)),
+        LastSampleTime(StartTime) {
     llvm::get_thread_name(ThreadName);
   }
 
   void begin(std::string Name, llvm::function_ref<std::string()> Detail) {
     Stack.emplace_back(steady_clock::now(), TimePointType(), std::move(Name),
                        Detail());
+    if (SampleIntervalUs)
+      sample(Stack.back().Start);
   }
 
   void end() {
     assert(!Stack.empty() && "Must call begin() first");
     Entry &E = Stack.back();
     E.End = steady_clock::now();
+    if (SampleIntervalUs) {
+      // Sampling mode keeps only the folded samples; skip per-event storage so
+      // memory stays bounded regardless of how many sections are entered.
+      sample(E.End);
+      Stack.pop_back();
+      return;
+    }
 
     // Check that end times monotonically increase.
     assert((Entries.empty() ||
@@ -129,6 +146,46 @@ struct llvm::TimeTraceProfiler {
     Stack.pop_back();
   }
 
+  // Attribute the wall time since the previous sample to the stack of
+  // currently open sections. Sampling piggybacks on section boundaries, so it
+  // costs one clock comparison per section instead of a timer thread; sections
+  // longer than the interval are still fully accounted because the elapsed
+  // time, not a fixed quantum, is added to the sample.
+  void sample(TimePointType Now) {
+    auto ElapsedUs = duration_cast<microseconds>(Now - LastSampleTime).count();
+    if (ElapsedUs < SampleIntervalUs)
+      return;
+    SmallString<256> Folded;
+    for (const Entry &E : Stack) {
+      if (!Folded.empty())
+        Folded.push_back(';');
+      Folded.append(E.Name);
+    }
+    FoldedSamples[Folded] += ElapsedUs;
+    LastSampleTime = Now;
+  }
+
+  // Write folded stacks from this TimeTraceProfilerInstance and
+  // ThreadTimeTraceProfilerInstances, one "Outer;Inner <total us>" line per
+  // observed stack.
+  void writeFoldedSamples(raw_pwrite_stream &OS,
+                          ArrayRef<TimeTraceProfiler *> Instances) {
+    StringMap<uint64_t> AllSamples = FoldedSamples;
+    for (const TimeTraceProfiler *TTP : Instances)
+      for (const auto &Sample : TTP->FoldedSamples)
+        AllSamples[Sample.getKey()] += Sample.getValue();
+
+    // Sort for deterministic output; flamegraph tools accept any order.
+    std::vector<StringRef> Stacks;
+    Stacks.reserve(AllSamples.size());
+    for (const auto &Sample : AllSamples)
+      Stacks.push_back(Sample.getKey());
+    llvm::sort(Stacks);
+
+    for (StringRef Stack : Stacks)
+      OS << Stack << ' ' << AllSamples[Stack] << '\n';
+  }
+
   // Write events from this TimeTraceProfilerInstance and
   // ThreadTimeTraceProfilerInstances.
   void write(raw_pwrite_stream &OS) {
@@ -141,6 +198,9 @@ struct llvm::TimeTraceProfiler {
                         [](const auto &TTP) { return TTP->Stack.empty(); }) &&
            "All profiler sections should be ended when calling write");
 
+    if (SampleIntervalUs)
+      return writeFoldedSamples(OS, Instances.List);
+
     json::OStream J(OS);
     J.objectBegin();
     J.attributeBegin("traceEvents");
@@ -267,6 +327,12 @@ struct llvm::TimeTraceProfiler {
 
   // Minimum time granularity (in microseconds)
   const unsigned TimeTraceGranularity;
+
+  // Sampling interval (in microseconds); nonzero selects sampling mode. See
+  // timeTraceProfilerEnableSampling.
+  unsigned SampleIntervalUs;
+  TimePointType LastSampleTime;
+  StringMap<uint64_t> FoldedSamples;
 };
 
 void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
@@ -277,6 +343,12 @@ void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
       TimeTraceGranularity, llvm::sys::path::filename(ProcName));
 }
 
+void llvm::timeTraceProfilerEnableSampling(unsigned SampleIntervalUs) {
+  SamplingIntervalUs.store(SampleIntervalUs, std::memory_order_relaxed);
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->SampleIntervalUs = SampleIntervalUs;
+}
+
 // Removes all TimeTraceProfilerInstances.
 // Called from main thread.
 void llvm::timeTraceProfilerCleanup() {
@@ -19,6 +19,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/Twine.h"
@@ -47,6 +48,7 @@
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -432,6 +434,55 @@ directory_iterator RealFileSystem::dir_begin(const Twine &Dir,
       std::make_shared<RealFSDirIter>(adjustPath(Dir, Storage), EC));
 }
 
+//===-----------------------------------------------------------------------===/
+// StatCachingFileSystem implementation
+//===-----------------------------------------------------------------------===/
+
+namespace {
+
+/// A stat-caching layer over another file system; see
+/// \c vfs::createStatCachingFileSystem().
+class StatCachingFileSystem : public ProxyFileSystem {
+public:
+  explicit StatCachingFileSystem(IntrusiveRefCntPtr<FileSystem> FS)
+      : ProxyFileSystem(std::move(FS)) {}
+
+  ErrorOr<Status> status(const Twine &Path) override {
+    SmallString<256> Storage;
+    StringRef Key = Path.toStringRef(Storage);
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      auto It = StatCache.find(Key);
+      if (It != StatCache.end())
+        return It->second;
+    }
+    // Issue the underlying stat without holding the lock. Concurrent calls for
+    // the same path may both stat; the first inserted result wins.
+    ErrorOr<Status> S = getUnderlyingFS().status(Path);
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return StatCache.try_emplace(Key, std::move(S)).first->second;
+  }
+
+protected:
+  void printImpl(raw_ostream &OS, PrintType Type,
+                 unsigned IndentLevel) const override {
+    printIndent(OS, IndentLevel);
+    OS << "StatCachingFileSystem\n";
+  }
+
+private:
+  std::mutex Mutex;
+  StringMap<ErrorOr<Status>> StatCache;
+};
+
+} // namespace
+
+IntrusiveRefCntPtr<FileSystem>
+vfs::createStatCachingFileSystem(IntrusiveRefCntPtr<FileSystem> FS) {
+  return IntrusiveRefCntPtr<FileSystem>(
+      new StatCachingFileSystem(std::move(FS)));
+}
+
 //===-----------------------------------------------------------------------===/
 // OverlayFileSystem implementation
 //===-----------------------------------------------------------------------===/
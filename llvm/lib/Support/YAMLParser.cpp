@@ -1135,6 +1135,13 @@ void Scanner::skipComment() {
   if (Current == End || *Current != '#')
     return;
   while (true) {
+    // Bulk-skip printable ASCII, which makes up almost all comment text; each
+    // such byte is a single-column nb-char.
+    while (Current != End &&
+           (*Current == 0x09 || (*Current >= 0x20 && *Current <= 0x7E))) {
+      ++Current;
+      ++Column;
+    }
     // This may skip more than one byte, thus Column is only incremented
     // for code points.
     StringRef::iterator I = skip_nb_char(Current);
@@ -1383,6 +1390,16 @@ bool Scanner::scanFlowScalar(bool IsDoubleQuoted) {
   } else {
     skip(1);
     while (Current != End) {
+      // Bulk-skip printable ASCII other than the quote; everything else
+      // (quotes, breaks, multi-byte sequences) falls through to the checks
+      // below.
+      while (Current != End && *Current != '\'' &&
+             (*Current == 0x09 || (*Current >= 0x20 && *Current <= 0x7E))) {
+        ++Current;
+        ++Column;
+      }
+      if (Current == End)
+        break;
       // Skip a ' followed by another '.
       if (Current + 1 < End && *Current == '\'' && *(Current + 1) == '\'') {
         skip(2);
@@ -1435,6 +1452,18 @@ bool Scanner::scanPlainScalar() {
       break;
 
     while (Current != End && !isBlankOrBreak(Current)) {
+      // Bulk-skip printable ASCII characters with no special meaning here; the
+      // checks below only need to see ':' (which requires lookahead), flow
+      // indicators in flow context, blanks, breaks and multi-byte sequences.
+      while (Current != End && *Current != ':' && *Current > 0x20 &&
+             *Current <= 0x7E &&
+             !(FlowLevel && StringRef(Current, 1).find_first_of(",?[]{}") !=
+                                StringRef::npos)) {
+        ++Current;
+        ++Column;
+      }
+      if (Current == End || isBlankOrBreak(Current))
+        break;
       if (FlowLevel && *Current == ':' &&
           (Current + 1 == End ||
            !(isBlankOrBreak(Current + 1) || *(Current + 1) == ','))) {
@@ -28,6 +28,12 @@
 #include <cstdio>
 #include <sys/stat.h>
 
+#if LLVM_ENABLE_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 // <fcntl.h> may provide O_BINARY.
 #if defined(HAVE_FCNTL_H)
 # include <fcntl.h>
@@ -732,18 +738,10 @@ static bool write_console_impl(int FD, StringRef Data) {
 }
 #endif
 
-void raw_fd_ostream::write_impl(const char *Ptr, size_t Size) {
-  assert(FD >= 0 && "File already closed.");
-  pos += Size;
-
-#if defined(_WIN32)
-  // If this is a Windows console device, try re-encoding from UTF-8 to UTF-16
-  // and using WriteConsoleW. If that fails, fall back to plain write().
-  if (IsWindowsConsole)
-    if (write_console_impl(FD, StringRef(Ptr, Size)))
-      return;
-#endif
-
+/// Write \p Size bytes starting at \p Ptr to \p FD, splitting oversized
+/// writes and retrying recoverable errors. Returns the first non-recoverable
+/// error, if any.
+static std::error_code writeToFD(int FD, const char *Ptr, size_t Size) {
   // The maximum write size is limited to INT32_MAX. A write
   // greater than SSIZE_MAX is implementation-defined in POSIX,
   // and Windows _write requires 32 bit input.
@@ -775,9 +773,8 @@ void raw_fd_ostream::write_impl(const char *Ptr, size_t Size) {
           )
         continue;
 
-      // Otherwise it's a non-recoverable error. Note it and quit.
-      error_detected(std::error_code(errno, std::generic_category()));
-      break;
+      // Otherwise it's a non-recoverable error.
+      return std::error_code(errno, std::generic_category());
     }
 
     // The write may have written some or all of the data. Update the
@@ -786,6 +783,24 @@ void raw_fd_ostream::write_impl(const char *Ptr, size_t Size) {
     Ptr += ret;
     Size -= ret;
   } while (Size > 0);
+
+  return std::error_code();
+}
+
+void raw_fd_ostream::write_impl(const char *Ptr, size_t Size) {
+  assert(FD >= 0 && "File already closed.");
+  pos += Size;
+
+#if defined(_WIN32)
+  // If this is a Windows console device, try re-encoding from UTF-8 to UTF-16
+  // and using WriteConsoleW. If that fails, fall back to plain write().
+  if (IsWindowsConsole)
+    if (write_console_impl(FD, StringRef(Ptr, Size)))
+      return;
+#endif
+
+  if (std::error_code EC = writeToFD(FD, Ptr, Size))
+    error_detected(EC);
 }
 
 void raw_fd_ostream::close() {
@@ -930,6 +945,153 @@ bool raw_fd_stream::classof(const raw_ostream *OS) {
   return OS->get_kind() == OStreamKind::OK_FDStream;
 }
 
+//===----------------------------------------------------------------------===//
+//  raw_fd_flip_ostream
+//===----------------------------------------------------------------------===//
+
+#if LLVM_ENABLE_THREADS
+struct raw_fd_flip_ostream::FlipBufferState {
+  std::mutex Mutex;
+  std::condition_variable CV;
+  /// The "back" buffer: bytes handed off to the flusher. Owned exclusively
+  /// by the flusher while HasWork is set; keeps its allocation across
+  /// handoffs.
+  SmallVector<char, 0> BackBuffer;
+  bool HasWork = false;
+  bool Done = false;
+  /// First write error hit by the flusher, pending propagation into the
+  /// stream's error state.
+  std::error_code EC;
+  std::thread Flusher;
+};
+#else
+struct raw_fd_flip_ostream::FlipBufferState {};
+#endif
+
+raw_fd_flip_ostream::raw_fd_flip_ostream(StringRef Filename,
+                                         std::error_code &EC)
+    : raw_fd_ostream(Filename, EC) {
+  if (!EC)
+    startFlusher();
+}
+
+raw_fd_flip_ostream::raw_fd_flip_ostream(int fd, bool shouldClose)
+    : raw_fd_ostream(fd, shouldClose) {
+  startFlusher();
+}
+
+raw_fd_flip_ostream::~raw_fd_flip_ostream() {
+  flush();
+  joinFlusher();
+}
+
+void raw_fd_flip_ostream::startFlusher() {
+#if LLVM_ENABLE_THREADS
+  State = std::make_unique<FlipBufferState>();
+  State->Flusher = std::thread([this] { flushLoop(); });
+#endif
+}
+
+void raw_fd_flip_ostream::flushLoop() {
+#if LLVM_ENABLE_THREADS
+  std::unique_lock<std::mutex> Lock(State->Mutex);
+  while (true) {
+    State->CV.wait(Lock, [&] { return State->HasWork || State->Done; });
+    if (!State->HasWork)
+      break; // Done, and every handed-off buffer has been written.
+
+    // Drop the lock for the blocking write; the producer will not touch
+    // BackBuffer until HasWork clears.
+    Lock.unlock();
+    std::error_code EC =
+        writeToFD(get_fd(), State->BackBuffer.data(), State->BackBuffer.size());
+    Lock.lock();
+    if (EC && !State->EC)
+      State->EC = EC;
+    State->HasWork = false;
+    State->CV.notify_all();
+  }
+#endif
+}
+
+void raw_fd_flip_ostream::write_impl(const char *Ptr, size_t Size) {
+#if LLVM_ENABLE_THREADS
+  if (State) {
+    assert(get_fd() >= 0 && "File already closed.");
+    {
+      std::unique_lock<std::mutex> Lock(State->Mutex);
+      State->CV.wait(Lock, [&] { return !State->HasWork; });
+      if (State->EC) {
+        error_detected(State->EC);
+        State->EC = std::error_code();
+      }
+      // Flip: hand the just-produced bytes to the flusher and return so the
+      // caller can keep filling the stream's buffer while they are written.
+      State->BackBuffer.assign(Ptr, Ptr + Size);
+      State->HasWork = true;
+    }
+    State->CV.notify_all();
+    inc_pos(Size);
+    return;
+  }
+#endif
+  raw_fd_ostream::write_impl(Ptr, Size);
+}
+
+void raw_fd_flip_ostream::pwrite_impl(const char *Ptr, size_t Size,
+                                      uint64_t Offset) {
+  // Quiesce the flusher before repositioning the descriptor: an in-flight
+  // sequential write would otherwise race with the seeks below.
+  flush();
+  drain();
+  uint64_t Pos = tell();
+  seek(Offset);
+  write(Ptr, Size);
+  flush();
+  drain();
+  seek(Pos);
+}
+
+size_t raw_fd_flip_ostream::preferred_buffer_size() const {
+  // Use a large buffer so each handoff to the flusher amortizes the locking
+  // and covers a substantial chunk of I/O.
+  return 1 << 20;
+}
+
+void raw_fd_flip_ostream::drain() {
+#if LLVM_ENABLE_THREADS
+  if (!State)
+    return;
+  std::unique_lock<std::mutex> Lock(State->Mutex);
+  State->CV.wait(Lock, [&] { return !State->HasWork; });
+  if (State->EC) {
+    error_detected(State->EC);
+    State->EC = std::error_code();
+  }
+#endif
+}
+
+void raw_fd_flip_ostream::joinFlusher() {
+#if LLVM_ENABLE_THREADS
+  if (!State)
+    return;
+  drain();
+  {
+    std::lock_guard<std::mutex> Lock(State->Mutex);
+    State->Done = true;
+  }
+  State->CV.notify_all();
+  State->Flusher.join();
+  State.reset();
+#endif
+}
+
+void raw_fd_flip_ostream::close() {
+  flush();
+  joinFlusher();
+  raw_fd_ostream::close();
+}
+
 //===----------------------------------------------------------------------===//
 //  raw_string_ostream
 //===----------------------------------------------------------------------===//
@@ -16,9 +16,12 @@
 
 #include "llvm/TableGen/Main.h"
 #include "TGParser.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/TableGen/Error.h"
 #include "llvm/TableGen/Record.h"
@@ -57,6 +60,13 @@ static cl::opt<bool> NoWarnOnUnusedTemplateArgs(
     "no-warn-on-unused-template-args",
     cl::desc("Disable unused template argument warnings."));
 
+static cl::opt<std::string> CacheDir(
+    "cache-dir",
+    cl::desc("Cache the output in this directory, keyed by the command line "
+             "and the contents of all TableGen inputs, and skip record "
+             "evaluation when a matching entry exists"),
+    cl::value_desc("directory"));
+
 static int reportError(const char *ProgName, Twine Msg) {
   errs() << ProgName << ": " << Msg;
   errs().flush();
@@ -67,7 +77,8 @@ static int reportError(const char *ProgName, Twine Msg) {
 ///
 /// This functionality is really only for the benefit of the build system.
 /// It is similar to GCC's `-M*` family of options.
-static int createDependencyFile(const TGParser &Parser, const char *argv0) {
+static int createDependencyFile(const std::vector<std::string> &Dependencies,
+                                const char *argv0) {
   if (OutputFilename == "-")
     return reportError(argv0, "the option -d must be used together with -o\n");
 
@@ -77,7 +88,7 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
     return reportError(argv0, "error opening " + DependFilename + ":" +
                                   EC.message() + "\n");
   DepOut.os() << OutputFilename << ":";
-  for (const auto &Dep : Parser.getDependencies()) {
+  for (const auto &Dep : Dependencies) {
     DepOut.os() << ' ' << Dep;
   }
   DepOut.os() << "\n";
@@ -85,7 +96,162 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   return 0;
 }
 
+/// Write \p Output to the `-o` output file, honoring -write-if-changed.
+static int writeOutputFile(StringRef Output, const char *argv0) {
+  bool WriteFile = true;
+  if (WriteIfChanged) {
+    // Only updates the real output file if there are any differences.
+    // This prevents recompilation of all the files depending on it if there
+    // aren't any.
+    if (auto ExistingOrErr =
+            MemoryBuffer::getFile(OutputFilename, /*IsText=*/true))
+      if (std::move(ExistingOrErr.get())->getBuffer() == Output)
+        WriteFile = false;
+  }
+  if (WriteFile) {
+    std::error_code EC;
+    ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_Text);
+    if (EC)
+      return reportError(argv0, "error opening " + OutputFilename + ": " +
+                                    EC.message() + "\n");
+    OutFile.os() << Output;
+    if (ErrorsPrinted == 0)
+      OutFile.keep();
+  }
+  return 0;
+}
+
+static std::string hashBuffer(StringRef Buffer) {
+  BLAKE3 Hasher;
+  Hasher.update(Buffer);
+  return toHex(Hasher.final());
+}
+
+static Optional<std::string> hashFile(StringRef Path) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> FileOrErr =
+      MemoryBuffer::getFile(Path, /*IsText=*/true);
+  if (!FileOrErr)
+    return None;
+  return hashBuffer((*FileOrErr)->getBuffer());
+}
+
+/// Compute the key of a `--cache-dir` entry from the verbatim command line.
+/// The tool's executable path, size and modification time take part in the
+/// key so that rebuilding TableGen conservatively invalidates the cache.
+static std::string hashCommandLine(int argc, const char *const *argv) {
+  BLAKE3 Hasher;
+  auto AddString = [&](StringRef Str) {
+    // Prefix each string with its size so concatenations can't collide.
+    uint64_t Size = Str.size();
+    Hasher.update(
+        ArrayRef<uint8_t>(reinterpret_cast<uint8_t *>(&Size), sizeof(Size)));
+    Hasher.update(Str);
+  };
+  std::string Exe = sys::fs::getMainExecutable(
+      argv[0], (void *)(intptr_t)&hashCommandLine);
+  AddString(Exe);
+  sys::fs::file_status Status;
+  if (!sys::fs::status(Exe, Status)) {
+    uint64_t ExeStamp[2] = {
+        Status.getSize(),
+        (uint64_t)Status.getLastModificationTime().time_since_epoch().count()};
+    Hasher.update(ArrayRef<uint8_t>(reinterpret_cast<uint8_t *>(ExeStamp),
+                                    sizeof(ExeStamp)));
+  }
+  for (int I = 1; I != argc; ++I)
+    AddString(argv[I]);
+  return toHex(Hasher.final());
+}
+
+/// Try to reuse the output of a previous run with the same key. A cache entry
+/// consists of a manifest (the hash of the main input followed by the hash
+/// and path of every included file) and the backend output. The entry only
+/// matches if every recorded file still hashes the same. \returns true if the
+/// entry matched and the output and dependency files were written, with the
+/// exit code in \p Ret.
+static bool tryReuseCachedOutput(StringRef Key, StringRef InputHash,
+                                 const char *argv0, int &Ret) {
+  SmallString<128> ManifestPath(CacheDir);
+  sys::path::append(ManifestPath, Key + ".deps");
+  ErrorOr<std::unique_ptr<MemoryBuffer>> ManifestOrErr =
+      MemoryBuffer::getFile(ManifestPath, /*IsText=*/true);
+  if (!ManifestOrErr)
+    return false;
+
+  SmallVector<StringRef, 32> Lines;
+  (*ManifestOrErr)->getBuffer().split(Lines, '\n', /*MaxSplit=*/-1,
+                                      /*KeepEmpty=*/false);
+  if (Lines.empty() || Lines[0] != InputHash)
+    return false;
+  std::vector<std::string> Dependencies;
+  for (StringRef Line : makeArrayRef(Lines).drop_front()) {
+    auto [Hash, Path] = Line.split(' ');
+    Optional<std::string> FileHash = hashFile(Path);
+    if (!FileHash || *FileHash != Hash)
+      return false;
+    Dependencies.push_back(Path.str());
+  }
+
+  SmallString<128> OutPath(CacheDir);
+  sys::path::append(OutPath, Key + ".out");
+  ErrorOr<std::unique_ptr<MemoryBuffer>> OutOrErr =
+      MemoryBuffer::getFile(OutPath, /*IsText=*/true);
+  if (!OutOrErr)
+    return false;
+
+  // Always write the depfile; see the comment in TableGenMain.
+  if (!DependFilename.empty()) {
+    if ((Ret = createDependencyFile(Dependencies, argv0)))
+      return true;
+  }
+  Ret = writeOutputFile((*OutOrErr)->getBuffer(), argv0);
+  return true;
+}
+
+/// Record a successful run in the cache. Best effort: failures only mean the
+/// next run can't skip evaluation.
+static void storeCachedOutput(StringRef Key, StringRef InputHash,
+                              const std::vector<std::string> &Dependencies,
+                              StringRef Output) {
+  if (sys::fs::create_directories(CacheDir))
+    return;
+
+  std::string Manifest = InputHash.str() + "\n";
+  for (const std::string &Dep : Dependencies) {
+    Optional<std::string> FileHash = hashFile(Dep);
+    if (!FileHash)
+      return;
+    Manifest += *FileHash + " " + Dep + "\n";
+  }
+
+  // Write the output before the manifest so a partially written entry can
+  // never match.
+  std::error_code EC;
+  SmallString<128> OutPath(CacheDir);
+  sys::path::append(OutPath, Key + ".out");
+  raw_fd_ostream OutFile(OutPath, EC, sys::fs::OF_Text);
+  if (EC)
+    return;
+  OutFile << Output;
+  OutFile.close();
+  if (OutFile.has_error())
+    return;
+
+  SmallString<128> ManifestPath(CacheDir);
+  sys::path::append(ManifestPath, Key + ".deps");
+  raw_fd_ostream ManifestFile(ManifestPath, EC, sys::fs::OF_Text);
+  if (EC)
+    return;
+  ManifestFile << Manifest;
+}
+
 int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
+  return TableGenMain(1, &argv0, MainFn);
+}
+
+int llvm::TableGenMain(int argc, const char *const *argv,
+                       TableGenMainFn *MainFn) {
+  const char *argv0 = argv[0];
   RecordKeeper Records;
 
   if (TimePhases)
@@ -100,6 +266,21 @@ int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
     return reportError(argv0, "Could not open input file '" + InputFilename +
                                   "': " + EC.message() + "\n");
 
+  // With --cache-dir, skip record evaluation entirely when a previous run
+  // with the same command line and the same input closure left its output in
+  // the cache.
+  std::string CacheKey, InputHash;
+  if (!CacheDir.empty()) {
+    if (argc < 2)
+      return reportError(argv0,
+                         "--cache-dir is not supported by this driver\n");
+    CacheKey = hashCommandLine(argc, argv);
+    InputHash = hashBuffer((*FileOrErr)->getBuffer());
+    int Ret = 0;
+    if (tryReuseCachedOutput(CacheKey, InputHash, argv0, Ret))
+      return Ret;
+  }
+
   Records.saveInputFilename(InputFilename);
 
   // Tell SrcMgr about this buffer, which is what TGParser will pick up.
@@ -124,37 +305,24 @@ int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
   if (status)
     return 1;
 
+  const std::vector<std::string> Dependencies(Parser.getDependencies().begin(),
+                                              Parser.getDependencies().end());
+
   // Always write the depfile, even if the main output hasn't changed.
   // If it's missing, Ninja considers the output dirty.  If this was below
   // the early exit below and someone deleted the .inc.d file but not the .inc
   // file, tablegen would never write the depfile.
   if (!DependFilename.empty()) {
-    if (int Ret = createDependencyFile(Parser, argv0))
+    if (int Ret = createDependencyFile(Dependencies, argv0))
       return Ret;
   }
 
   Records.startTimer("Write output");
-  bool WriteFile = true;
-  if (WriteIfChanged) {
-    // Only updates the real output file if there are any differences.
-    // This prevents recompilation of all the files depending on it if there
-    // aren't any.
-    if (auto ExistingOrErr =
-            MemoryBuffer::getFile(OutputFilename, /*IsText=*/true))
-      if (std::move(ExistingOrErr.get())->getBuffer() == Out.str())
-        WriteFile = false;
-  }
-  if (WriteFile) {
-    std::error_code EC;
-    ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_Text);
-    if (EC)
-      return reportError(argv0, "error opening " + OutputFilename + ": " +
-                                    EC.message() + "\n");
-    OutFile.os() << Out.str();
-    if (ErrorsPrinted == 0)
-      OutFile.keep();
-  }
-  
+  if (int Ret = writeOutputFile(Out.str(), argv0))
+    return Ret;
+  if (!CacheDir.empty() && ErrorsPrinted == 0)
+    storeCachedOutput(CacheKey, InputHash, Dependencies, Out.str());
+
   Records.stopTimer();
   Records.stopPhaseTiming();
 
@@ -458,21 +458,21 @@ template <> struct MappingTraits<const InterfaceFile *> {
       if (!File->umbrellas().empty())
         ParentUmbrella = File->umbrellas().begin()->second;
 
-      std::set<ArchitectureSet> ArchSet;
+      // Bucket the symbols by architecture set up front; scanning the whole
+      // symbol list once per emitted section is quadratic on libraries with
+      // many distinct architecture sets.
+      std::map<ArchitectureSet, std::vector<const Symbol *>> ArchSetToSymbols;
       for (const auto &Library : File->allowableClients())
-        ArchSet.insert(Library.getArchitectures());
+        (void)ArchSetToSymbols[Library.getArchitectures()];
 
       for (const auto &Library : File->reexportedLibraries())
-        ArchSet.insert(Library.getArchitectures());
+        (void)ArchSetToSymbols[Library.getArchitectures()];
 
-      std::map<const Symbol *, ArchitectureSet> SymbolToArchSet;
-      for (const auto *Symbol : File->exports()) {
-        auto Architectures = Symbol->getArchitectures();
-        SymbolToArchSet[Symbol] = Architectures;
-        ArchSet.insert(Architectures);
-      }
+      for (const auto *Symbol : File->exports())
+        ArchSetToSymbols[Symbol->getArchitectures()].emplace_back(Symbol);
 
-      for (auto Architectures : ArchSet) {
+      for (const auto &SymbolsForArch : ArchSetToSymbols) {
+        ArchitectureSet Architectures = SymbolsForArch.first;
         ExportSection Section;
         Section.Architectures = Architectures;
 
@@ -484,11 +484,7 @@ template <> struct MappingTraits<const InterfaceFile *> {
           if (Library.getArchitectures() == Architectures)
             Section.ReexportedLibraries.emplace_back(Library.getInstallName());
 
-        for (const auto &SymArch : SymbolToArchSet) {
-          if (SymArch.second != Architectures)
-            continue;
-
-          const auto *Symbol = SymArch.first;
+        for (const auto *Symbol : SymbolsForArch.second) {
           switch (Symbol->getKind()) {
           case SymbolKind::GlobalSymbol:
             if (Symbol->isWeakDefined())
@@ -530,24 +526,16 @@ template <> struct MappingTraits<const InterfaceFile *> {
         Exports.emplace_back(std::move(Section));
       }
 
-      ArchSet.clear();
-      SymbolToArchSet.clear();
+      ArchSetToSymbols.clear();
 
-      for (const auto *Symbol : File->undefineds()) {
-        auto Architectures = Symbol->getArchitectures();
-        SymbolToArchSet[Symbol] = Architectures;
-        ArchSet.insert(Architectures);
-      }
+      for (const auto *Symbol : File->undefineds())
+        ArchSetToSymbols[Symbol->getArchitectures()].emplace_back(Symbol);
 
-      for (auto Architectures : ArchSet) {
+      for (const auto &SymbolsForArch : ArchSetToSymbols) {
         UndefinedSection Section;
-        Section.Architectures = Architectures;
-
-        for (const auto &SymArch : SymbolToArchSet) {
-          if (SymArch.second != Architectures)
-            continue;
+        Section.Architectures = SymbolsForArch.first;
 
-          const auto *Symbol = SymArch.first;
+        for (const auto *Symbol : SymbolsForArch.second) {
           switch (Symbol->getKind()) {
           case SymbolKind::GlobalSymbol:
             if (Symbol->isWeakReferenced())
@@ -159,6 +159,11 @@ static cl::opt<bool>
                    cl::desc("Print Attributor's internal call graph"),
                    cl::init(false));
 
+static cl::opt<bool> PrintUpdateStats(
+    "attributor-print-update-stats", cl::Hidden,
+    cl::desc("Print the number of update calls per abstract attribute class"),
+    cl::init(false));
+
 static cl::opt<bool> SimplifyAllLoads("attributor-simplify-all-loads",
                                       cl::Hidden,
                                       cl::desc("Try to simplify all loads."),
@@ -2251,6 +2256,12 @@ ChangeStatus Attributor::run() {
   if (PrintCallGraph)
     ACallGraph.print();
 
+  if (PrintUpdateStats) {
+    errs() << "[Attributor] Update calls per abstract attribute class:\n";
+    for (const auto &It : NumUpdatesPerKind)
+      errs() << "  " << It.first << ": " << It.second << "\n";
+  }
+
   return ManifestChange | CleanupChange;
 }
 
@@ -2261,6 +2272,9 @@ ChangeStatus Attributor::updateAA(AbstractAttribute &AA) {
   assert(Phase == AttributorPhase::UPDATE &&
          "We can update AA only in the update stage!");
 
+  if (PrintUpdateStats)
+    ++NumUpdatesPerKind[AA.getName()];
+
   // Use a new dependence vector for this update.
   DependenceVector DV;
   DependenceStack.push_back(&DV);
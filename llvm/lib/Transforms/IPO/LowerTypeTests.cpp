@@ -66,6 +66,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TrailingObjects.h"
 #include "llvm/Support/YAMLTraits.h"
 #include "llvm/Support/raw_ostream.h"
@@ -1097,10 +1098,18 @@ void LowerTypeTestsModule::lowerTypeTestCalls(
     const DenseMap<GlobalTypeMember *, uint64_t> &GlobalLayout) {
   CombinedGlobalAddr = ConstantExpr::getBitCast(CombinedGlobalAddr, Int8PtrTy);
 
+  // Building a bitset only reads the layout and the members' type metadata,
+  // so the construction for all type identifiers in this disjoint set can run
+  // in parallel. Only the IR lowering below needs to stay serial.
+  std::vector<BitSetInfo> BitSets(TypeIds.size());
+  parallelFor(0, TypeIds.size(), [&](size_t I) {
+    BitSets[I] = buildBitSet(TypeIds[I], GlobalLayout);
+  });
+
   // For each type identifier in this disjoint set...
-  for (Metadata *TypeId : TypeIds) {
-    // Build the bitset.
-    BitSetInfo BSI = buildBitSet(TypeId, GlobalLayout);
+  for (size_t Index = 0; Index != TypeIds.size(); ++Index) {
+    Metadata *TypeId = TypeIds[Index];
+    BitSetInfo &BSI = BitSets[Index];
     LLVM_DEBUG({
       if (auto MDS = dyn_cast<MDString>(TypeId))
         dbgs() << MDS->getString() << ": ";
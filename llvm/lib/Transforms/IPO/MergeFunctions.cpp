@@ -117,6 +117,7 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/Utils/FunctionComparator.h"
@@ -422,10 +423,18 @@ bool MergeFunctions::runOnModule(Module &M) {
     HashedFuncs;
   for (Function &Func : M) {
     if (isEligibleForMerging(Func)) {
-      HashedFuncs.push_back({FunctionComparator::functionHash(Func), &Func});
+      HashedFuncs.push_back({0, &Func});
     }
   }
 
+  // Hashing dominates the pass at full-LTO scale and only reads the IR, so
+  // compute the bucket hashes in parallel. The exact FunctionComparator runs
+  // later and only between candidates whose hashes collide.
+  parallelFor(0, HashedFuncs.size(), [&](size_t I) {
+    HashedFuncs[I].first =
+        FunctionComparator::functionHash(*HashedFuncs[I].second);
+  });
+
   llvm::stable_sort(HashedFuncs, less_first());
 
   auto S = HashedFuncs.begin();
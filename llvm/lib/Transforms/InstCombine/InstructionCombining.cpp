@@ -38,10 +38,13 @@
 #include "llvm/ADT/APInt.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/BasicAliasAnalysis.h"
@@ -90,13 +93,16 @@
 #include "llvm/IR/Value.h"
 #include "llvm/IR/ValueHandle.h"
 #include "llvm/InitializePasses.h"
+#include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/DebugCounter.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/KnownBits.h"
+#include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/InstCombine/InstCombine.h"
 #include "llvm/Transforms/Utils/Local.h"
@@ -104,6 +110,7 @@
 #include <cassert>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -117,6 +124,8 @@ STATISTIC(NumWorklistIterations,
           "Number of instruction combining iterations performed");
 
 STATISTIC(NumCombined , "Number of insts combined");
+STATISTIC(NumFixpointCacheHits,
+          "Number of functions skipped by the fixpoint memo");
 STATISTIC(NumConstProp, "Number of constant folds");
 STATISTIC(NumDeadInst , "Number of dead inst eliminated");
 STATISTIC(NumSunkInst , "Number of instructions sunk");
@@ -157,6 +166,11 @@ static cl::opt<unsigned>
 MaxArraySize("instcombine-maxarray-size", cl::init(1024),
              cl::desc("Maximum array size considered when doing a combine"));
 
+static cl::opt<bool> MemoizeFixpoints(
+    "instcombine-memoize-fixpoints", cl::init(false), cl::Hidden,
+    cl::desc("Remember hashes of function bodies that are already at an "
+             "instcombine fixpoint and skip re-running on identical bodies"));
+
 // FIXME: Remove this flag when it is no longer necessary to convert
 // llvm.dbg.declare to avoid inaccurate debug info. Setting this to false
 // increases variable availability at the cost of accuracy. Variables that
@@ -4634,8 +4648,44 @@ InstCombinePass::InstCombinePass() : MaxIterations(LimitMaxIterations) {}
 InstCombinePass::InstCombinePass(unsigned MaxIterations)
     : MaxIterations(MaxIterations) {}
 
+namespace {
+/// Process-wide set of function-body hashes known to already be at an
+/// instcombine fixpoint. See the -instcombine-memoize-fixpoints flag.
+struct FixpointHashSet {
+  std::mutex Lock;
+  DenseSet<std::pair<uint64_t, uint64_t>> Hashes;
+};
+} // namespace
+
+static ManagedStatic<FixpointHashSet> FixpointHashes;
+
+/// Hash the textual form of \p F, together with the data layout and the
+/// iteration limit, so that only byte-identical bodies hit the memo. A
+/// collision can only suppress folds, never miscompile: skipping instcombine
+/// is always semantically safe.
+static std::pair<uint64_t, uint64_t> computeFixpointHash(const Function &F,
+                                                         unsigned MaxIterations) {
+  SmallString<4096> Body;
+  raw_svector_ostream OS(Body);
+  OS << F.getParent()->getDataLayoutStr() << '\n' << MaxIterations << '\n';
+  F.print(OS);
+  BLAKE3Result<16> Digest = BLAKE3::hash<16>(arrayRefFromStringRef(OS.str()));
+  return {llvm::support::endian::read64le(Digest.data()),
+          llvm::support::endian::read64le(Digest.data() + 8)};
+}
+
 PreservedAnalyses InstCombinePass::run(Function &F,
                                        FunctionAnalysisManager &AM) {
+  Optional<std::pair<uint64_t, uint64_t>> BodyHash;
+  if (MemoizeFixpoints) {
+    BodyHash = computeFixpointHash(F, MaxIterations);
+    std::lock_guard<std::mutex> Guard(FixpointHashes->Lock);
+    if (FixpointHashes->Hashes.count(*BodyHash)) {
+      ++NumFixpointCacheHits;
+      return PreservedAnalyses::all();
+    }
+  }
+
   auto &AC = AM.getResult<AssumptionAnalysis>(F);
   auto &DT = AM.getResult<DominatorTreeAnalysis>(F);
   auto &TLI = AM.getResult<TargetLibraryAnalysis>(F);
@@ -4652,9 +4702,16 @@ PreservedAnalyses InstCombinePass::run(Function &F,
       &AM.getResult<BlockFrequencyAnalysis>(F) : nullptr;
 
   if (!combineInstructionsOverFunction(F, Worklist, AA, AC, TLI, TTI, DT, ORE,
-                                       BFI, PSI, MaxIterations, LI))
+                                       BFI, PSI, MaxIterations, LI)) {
+    // No changes: the body is at a fixpoint. Remember it so later runs over
+    // an identical body skip the worklist entirely.
+    if (BodyHash) {
+      std::lock_guard<std::mutex> Guard(FixpointHashes->Lock);
+      FixpointHashes->Hashes.insert(*BodyHash);
+    }
     // No changes, all analyses are preserved.
     return PreservedAnalyses::all();
+  }
 
   // Mark all the analyses that instcombine updates as preserved.
   PreservedAnalyses PA;
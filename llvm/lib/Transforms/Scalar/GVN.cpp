@@ -669,6 +669,13 @@ void GVNPass::ValueTable::clear() {
   nextExprNumber = 0;
 }
 
+/// Pre-allocate space for roughly \p NumValues values, so that numbering a
+/// large function does not repeatedly grow and rehash the underlying tables.
+void GVNPass::ValueTable::reserve(uint32_t NumValues) {
+  valueNumbering.reserve(NumValues);
+  expressionNumbering.reserve(NumValues);
+}
+
 /// Remove a value from the value numbering.
 void GVNPass::ValueTable::erase(Value *V) {
   uint32_t Num = valueNumbering.lookup(V);
@@ -2999,6 +3006,12 @@ bool GVNPass::splitCriticalEdges() {
 bool GVNPass::iterateOnFunction(Function &F) {
   cleanupGlobalSets();
 
+  // Pre-size the numbering tables: on very large functions, growing and
+  // rehashing them during the walk is a significant fraction of GVN time.
+  unsigned NumInstructions = F.getInstructionCount();
+  VN.reserve(NumInstructions);
+  LeaderTable.reserve(NumInstructions);
+
   // Top-down walk of the dominator tree
   bool Changed = false;
   // Needed for value numbering with phi construction to work.
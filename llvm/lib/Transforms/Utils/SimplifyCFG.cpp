@@ -92,10 +92,9 @@ using namespace PatternMatch;
 #define DEBUG_TYPE "simplifycfg"
 
 cl::opt<bool> llvm::RequireAndPreserveDomTree(
-    "simplifycfg-require-and-preserve-domtree", cl::Hidden,
-
-    cl::desc("Temorary development switch used to gradually uplift SimplifyCFG "
-             "into preserving DomTree,"));
+    "simplifycfg-require-and-preserve-domtree", cl::Hidden, cl::init(true),
+    cl::desc("Require SimplifyCFG to update the DominatorTree incrementally "
+             "through DomTreeUpdater instead of invalidating it."));
 
 // Chosen as 2 so as to be cheap, but still to have enough power to fold
 // a select, so the "clamp" idiom (of a min followed by a max) will be caught.
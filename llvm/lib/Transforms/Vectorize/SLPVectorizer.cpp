@@ -2085,6 +2085,11 @@ public:
     return any_of(MustGather, [&](Value *V) { return Vals.contains(V); });
   }
 
+  /// \returns the number of times a vectorizable tree was built for this
+  /// function so far. Overlapping seed bundles make this grow much faster
+  /// than the number of vectorized trees.
+  unsigned getTreeBuildCount() const { return NumTreeBuilds; }
+
   ~BoUpSLP();
 
 private:
@@ -2686,6 +2691,16 @@ private:
   /// Set of hashes for the list of reduction values already being analyzed.
   DenseSet<size_t> AnalyzedReductionVals;
 
+  /// Cache of gather costs keyed by the hash of the gathered value list.
+  /// The cost depends only on the values and their types, so entries remain
+  /// valid across tree builds and let overlapping seed bundles share the
+  /// scalarization-overhead queries. Scalars are not actually deleted until
+  /// BoUpSLP is destructed, so hashed pointers cannot be reused in between.
+  mutable DenseMap<size_t, InstructionCost> GatherCostCache;
+
+  /// Number of times a vectorizable tree was built for this function.
+  unsigned NumTreeBuilds = 0;
+
   /// A list of values that need to extracted out of the tree.
   /// This list holds pairs of (Internal Scalar : External User). External User
   /// can be nullptr, it means that this Internal Scalar will be used later,
@@ -4506,6 +4521,7 @@ BoUpSLP::findExternalStoreUsersReorderIndices(TreeEntry *TE) const {
 void BoUpSLP::buildTree(ArrayRef<Value *> Roots,
                         const SmallDenseSet<Value *> &UserIgnoreLst) {
   deleteTree();
+  ++NumTreeBuilds;
   UserIgnoreList = &UserIgnoreLst;
   if (!allSameType(Roots))
     return;
@@ -4514,6 +4530,7 @@ void BoUpSLP::buildTree(ArrayRef<Value *> Roots,
 
 void BoUpSLP::buildTree(ArrayRef<Value *> Roots) {
   deleteTree();
+  ++NumTreeBuilds;
   if (!allSameType(Roots))
     return;
   buildTree_rec(Roots, 0, EdgeInfo());
@@ -7508,6 +7525,10 @@ InstructionCost BoUpSLP::getGatherCost(FixedVectorType *Ty,
 }
 
 InstructionCost BoUpSLP::getGatherCost(ArrayRef<Value *> VL) const {
+  size_t Key = hash_value(VL);
+  auto It = GatherCostCache.find(Key);
+  if (It != GatherCostCache.end())
+    return It->second;
   // Find the type of the operands in VL.
   Type *ScalarTy = VL[0]->getType();
   if (StoreInst *SI = dyn_cast<StoreInst>(VL[0]))
@@ -7532,7 +7553,10 @@ InstructionCost BoUpSLP::getGatherCost(ArrayRef<Value *> VL) const {
       ShuffledElements.setBit(Idx);
     }
   }
-  return getGatherCost(VecTy, ShuffledElements, DuplicateNonConst);
+  InstructionCost Cost =
+      getGatherCost(VecTy, ShuffledElements, DuplicateNonConst);
+  GatherCostCache.try_emplace(Key, Cost);
+  return Cost;
 }
 
 // Perform operand reordering on the instructions in VL and return the reordered
@@ -10178,6 +10202,17 @@ bool SLPVectorizerPass::runImpl(Function &F, ScalarEvolution *SE_,
     R.optimizeGatherSequence();
     LLVM_DEBUG(dbgs() << "SLP: vectorized \"" << F.getName() << "\"\n");
   }
+
+  // Surface how many trees were built for the function. Overlapping seed
+  // bundles make this grow much faster than the number of vectorized trees,
+  // so it is the first thing to check when SLP compile time regresses.
+  if (R.getTreeBuildCount())
+    ORE_->emit([&]() {
+      return OptimizationRemarkAnalysis(SV_NAME, "TreeBuilds",
+                                        F.getSubprogram(), &F.getEntryBlock())
+             << "built " << ore::NV("NumTreeBuilds", R.getTreeBuildCount())
+             << " SLP trees";
+    });
   return Changed;
 }
 
@@ -61,6 +61,10 @@ Error loadNaiveFormatLog(StringRef Data, bool IsLittleEndian,
   //   (4)   uint32 : thread id
   //   (4)   uint32 : process id
   //   (8)   -      : padding
+  //
+  // The record count is known up front, so grab all the memory at once rather
+  // than letting the vector double its way up and overshoot the peak.
+  Records.reserve((Data.size() - 32) / 32);
   while (Reader.isValidOffset(OffsetPtr)) {
     if (!Reader.isValidOffsetForDataOfSize(OffsetPtr, 32))
       return createStringError(
@@ -22,6 +22,7 @@
 #include "llvm/CodeGen/MIRParser/MIRParser.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
 #include "llvm/IR/AutoUpgrade.h"
@@ -84,6 +85,12 @@ TimeCompilations("time-compilations", cl::Hidden, cl::init(1u),
                  cl::value_desc("N"),
                  cl::desc("Repeat compilation N times for timing"));
 
+static cl::opt<unsigned> SplitCodeGenParts(
+    "split-codegen", cl::init(1u), cl::value_desc("N"),
+    cl::desc("Split the module into N parts and run code generation for the "
+             "parts on parallel threads, writing one output file <output>.<N> "
+             "per part"));
+
 static cl::opt<bool> TimeTrace("time-trace", cl::desc("Record time trace"));
 
 static cl::opt<unsigned> TimeTraceGranularity(
@@ -656,6 +663,52 @@ static int compileModule(char **argv, LLVMContext &Context) {
     WithColor::warning(errs(), argv[0])
         << ": warning: ignoring -mc-relax-all because filetype != obj";
 
+  // Split the module and compile the parts on parallel threads, each in its
+  // own LLVMContext and with its own TargetMachine. The parts are emitted to
+  // numbered output files in deterministic (part-index) order.
+  if (SplitCodeGenParts > 1) {
+    if (MIR || !getRunPassNames().empty() || CompileTwice ||
+        !SplitDwarfOutputFile.empty())
+      reportError("-split-codegen cannot be combined with MIR input, "
+                  "-run-pass, -compile-twice or -split-dwarf-output",
+                  InputFilename);
+    if (Out->outputFilename() == "-")
+      reportError("-split-codegen requires an output filename", InputFilename);
+
+    std::vector<std::unique_ptr<ToolOutputFile>> PartOuts;
+    SmallVector<raw_pwrite_stream *, 8> OSs;
+    for (unsigned I = 0; I != SplitCodeGenParts; ++I) {
+      std::string PartFilename =
+          Out->outputFilename() + "." + std::to_string(I);
+      std::error_code EC;
+      auto PartOut =
+          std::make_unique<ToolOutputFile>(PartFilename, EC, sys::fs::OF_None);
+      if (EC)
+        reportError(EC.message(), PartFilename);
+      OSs.push_back(&PartOut->os());
+      PartOuts.push_back(std::move(PartOut));
+    }
+
+    splitCodeGen(
+        *M, OSs, {},
+        [&]() {
+          return std::unique_ptr<TargetMachine>(TheTarget->createTargetMachine(
+              TheTriple.getTriple(), CPUStr, FeaturesStr, Options, RM, CM,
+              OLvl));
+        },
+        codegen::getFileType());
+
+    auto HasError =
+        ((const LLCDiagnosticHandler *)(Context.getDiagHandlerPtr()))->HasError;
+    if (*HasError)
+      return 1;
+
+    for (std::unique_ptr<ToolOutputFile> &PartOut : PartOuts)
+      PartOut->keep();
+    // The unsplit output file is intentionally left empty and removed.
+    return 0;
+  }
+
   {
     raw_pwrite_stream *OS = &Out->os();
 
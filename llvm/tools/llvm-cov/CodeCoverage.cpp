@@ -20,14 +20,18 @@
 #include "CoverageViewOptions.h"
 #include "RenderingSupport.h"
 #include "SourceCoverageView.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/ProfileData/Coverage/CoverageMapping.h"
 #include "llvm/ProfileData/InstrProfReader.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
@@ -38,6 +42,7 @@
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/xxhash.h"
 
 #include <functional>
 #include <map>
@@ -126,6 +131,25 @@ private:
   void writeSourceFileView(StringRef SourceFile, CoverageMapping *Coverage,
                            CoveragePrinter *Printer, bool ShowFilenames);
 
+  /// Compute a stable hash of the coverage records for \p SourceFile, used to
+  /// detect files whose coverage changed between runs.
+  static uint64_t hashSourceFileCoverage(const CoverageMapping &Coverage,
+                                         StringRef SourceFile);
+
+  /// Compute a hash of the view options that affect rendered output.
+  uint64_t getRenderOptionsHash() const;
+
+  /// Return the path of the render state file in the output directory.
+  std::string getRenderStatePath() const;
+
+  /// Load per-file coverage hashes written by a previous -incremental run
+  /// into \p PreviousFileHashes. Return false if there is no state file or it
+  /// cannot be reused.
+  bool loadRenderState();
+
+  /// Write out the per-file coverage hashes for this run.
+  void saveRenderState(const StringMap<uint64_t> &FileHashes);
+
   typedef llvm::function_ref<int(int, const char **)> CommandLineParserType;
 
   int doShow(int argc, const char **argv,
@@ -178,6 +202,9 @@ private:
 
   /// Allowlist from -name-allowlist to be used for filtering.
   std::unique_ptr<SpecialCaseList> NameAllowlist;
+
+  /// Per-file coverage hashes from the previous run, in -incremental mode.
+  StringMap<uint64_t> PreviousFileHashes;
 };
 }
 
@@ -614,6 +641,130 @@ void CodeCoverageTool::writeSourceFileView(StringRef SourceFile,
   Printer->closeViewFile(std::move(OS));
 }
 
+namespace {
+// The render state file records, per source file, a hash of the coverage
+// records that were rendered, so that -incremental runs can skip files whose
+// coverage did not change.
+const uint64_t RenderStateMagic = 0x6c6c766d63767374; // "llvmcvst"
+const uint32_t RenderStateVersion = 1;
+} // namespace
+
+/// Fold \p Value into \p Hash with a mixing function that is stable across
+/// processes, unlike hash_combine.
+static uint64_t updateHash(uint64_t Hash, uint64_t Value) {
+  return hashing::detail::hash_16_bytes(Hash, Value);
+}
+
+uint64_t CodeCoverageTool::hashSourceFileCoverage(
+    const CoverageMapping &Coverage, StringRef SourceFile) {
+  uint64_t Hash = xxHash64(SourceFile);
+  auto HashRegions = [&](ArrayRef<CountedRegion> Regions) {
+    for (const auto &CR : Regions) {
+      Hash = updateHash(Hash, ((uint64_t)CR.FileID << 32) | CR.Kind);
+      Hash = updateHash(Hash, ((uint64_t)CR.LineStart << 32) | CR.ColumnStart);
+      Hash = updateHash(Hash, ((uint64_t)CR.LineEnd << 32) | CR.ColumnEnd);
+      Hash = updateHash(Hash, CR.ExecutionCount);
+      Hash = updateHash(Hash, CR.FalseExecutionCount);
+    }
+  };
+  for (const auto &Function : Coverage.getCoveredFunctions(SourceFile)) {
+    Hash = updateHash(Hash, xxHash64(Function.Name));
+    Hash = updateHash(Hash, Function.ExecutionCount);
+    HashRegions(Function.CountedRegions);
+    HashRegions(Function.CountedBranchRegions);
+  }
+  return Hash;
+}
+
+uint64_t CodeCoverageTool::getRenderOptionsHash() const {
+  uint64_t Bools = 0;
+  for (bool B : {ViewOpts.ShowLineNumbers, ViewOpts.ShowLineStats,
+                 ViewOpts.ShowRegionMarkers, ViewOpts.ShowExpandedRegions,
+                 ViewOpts.ShowBranchCounts, ViewOpts.ShowBranchPercents,
+                 ViewOpts.ShowFunctionInstantiations})
+    Bools = (Bools << 1) | B;
+  uint64_t Hash = updateHash(RenderStateMagic, (uint64_t)ViewOpts.Format);
+  Hash = updateHash(Hash, Bools);
+  Hash = updateHash(Hash, ViewOpts.TabSize);
+  Hash = updateHash(Hash, DoubleToBits(ViewOpts.HighCovWatermark));
+  Hash = updateHash(Hash, DoubleToBits(ViewOpts.LowCovWatermark));
+  Hash = updateHash(Hash, xxHash64(ViewOpts.ProjectTitle));
+  return Hash;
+}
+
+std::string CodeCoverageTool::getRenderStatePath() const {
+  SmallString<256> Path(ViewOpts.ShowOutputDirectory);
+  sys::path::append(Path, ".llvm-cov.state");
+  return std::string(Path);
+}
+
+bool CodeCoverageTool::loadRenderState() {
+  auto BufOrErr = MemoryBuffer::getFile(getRenderStatePath());
+  if (!BufOrErr)
+    return false;
+  StringRef Data = BufOrErr.get()->getBuffer();
+  const char *Cur = Data.begin(), *End = Data.end();
+  auto ReadU64 = [&](uint64_t &V) {
+    if (End - Cur < 8)
+      return false;
+    V = support::endian::read64le(Cur);
+    Cur += 8;
+    return true;
+  };
+  auto ReadU32 = [&](uint32_t &V) {
+    if (End - Cur < 4)
+      return false;
+    V = support::endian::read32le(Cur);
+    Cur += 4;
+    return true;
+  };
+
+  uint64_t Magic, OptionsHash, NumEntries;
+  uint32_t Version;
+  if (!ReadU64(Magic) || Magic != RenderStateMagic)
+    return false;
+  if (!ReadU32(Version) || Version != RenderStateVersion)
+    return false;
+  // If the options that affect rendering changed, every view is stale.
+  if (!ReadU64(OptionsHash) || OptionsHash != getRenderOptionsHash())
+    return false;
+  if (!ReadU64(NumEntries))
+    return false;
+  for (uint64_t I = 0; I < NumEntries; ++I) {
+    uint32_t PathLen;
+    if (!ReadU32(PathLen) || (uint64_t)(End - Cur) < (uint64_t)PathLen + 8) {
+      PreviousFileHashes.clear();
+      return false;
+    }
+    StringRef Path(Cur, PathLen);
+    Cur += PathLen;
+    uint64_t Hash;
+    (void)ReadU64(Hash);
+    PreviousFileHashes[Path] = Hash;
+  }
+  return true;
+}
+
+void CodeCoverageTool::saveRenderState(const StringMap<uint64_t> &FileHashes) {
+  std::error_code EC;
+  raw_fd_ostream OS(getRenderStatePath(), EC, sys::fs::OF_None);
+  if (EC) {
+    warning("Could not write render state: " + EC.message(),
+            getRenderStatePath());
+    return;
+  }
+  support::endian::Writer W(OS, support::little);
+  W.write<uint64_t>(RenderStateMagic);
+  W.write<uint32_t>(RenderStateVersion);
+  W.write<uint64_t>(getRenderOptionsHash());
+  W.write<uint64_t>(FileHashes.size());
+  for (const auto &Entry : FileHashes) {
+    W.write<uint32_t>(Entry.getKey().size());
+    OS << Entry.getKey();
+    W.write<uint64_t>(Entry.getValue());
+  }
+}
+
 int CodeCoverageTool::run(Command Cmd, int argc, const char **argv) {
   cl::opt<std::string> CovFilename(
       cl::Positional, cl::desc("Covered executable or object file."));
@@ -947,6 +1098,11 @@ int CodeCoverageTool::doShow(int argc, const char **argv,
   cl::alias ShowOutputDirectoryA("o", cl::desc("Alias for --output-dir"),
                                  cl::aliasopt(ShowOutputDirectory));
 
+  cl::opt<bool> Incremental(
+      "incremental", cl::Optional, cl::init(false),
+      cl::desc("Only regenerate source file views whose coverage records "
+               "changed since the previous run (requires -output-dir)"));
+
   cl::opt<uint32_t> TabSize(
       "tab-size", cl::init(2),
       cl::desc(
@@ -1025,6 +1181,11 @@ int CodeCoverageTool::doShow(int argc, const char **argv,
   ViewOpts.TabSize = TabSize;
   ViewOpts.ProjectTitle = ProjectTitle;
 
+  if (Incremental && !ViewOpts.hasOutputDirectory()) {
+    error("-incremental requires an output directory");
+    return 1;
+  }
+
   if (ViewOpts.hasOutputDirectory()) {
     if (auto E = sys::fs::create_directories(ViewOpts.ShowOutputDirectory)) {
       error("Could not create output directory!", E.message());
@@ -1109,27 +1270,49 @@ int CodeCoverageTool::doShow(int argc, const char **argv,
       (SourceFiles.size() != 1) || ViewOpts.hasOutputDirectory() ||
       (ViewOpts.Format == CoverageViewOptions::OutputFormat::HTML);
 
+  // In -incremental mode, skip re-rendering files whose coverage records are
+  // unchanged since the previous run and whose view file still exists.
+  std::vector<std::string> FilesToRender;
+  StringMap<uint64_t> FileHashes;
+  if (Incremental) {
+    bool HaveState = loadRenderState();
+    for (const std::string &SourceFile : SourceFiles) {
+      uint64_t Hash = hashSourceFileCoverage(*Coverage, SourceFile);
+      FileHashes[SourceFile] = Hash;
+      auto It = PreviousFileHashes.find(SourceFile);
+      if (HaveState && It != PreviousFileHashes.end() && It->second == Hash &&
+          Printer->viewFileExists(SourceFile, /*InToplevel=*/false))
+        continue;
+      FilesToRender.push_back(SourceFile);
+    }
+  } else {
+    FilesToRender = SourceFiles;
+  }
+
   ThreadPoolStrategy S = hardware_concurrency(ViewOpts.NumThreads);
   if (ViewOpts.NumThreads == 0) {
     // If NumThreads is not specified, create one thread for each input, up to
     // the number of hardware cores.
-    S = heavyweight_hardware_concurrency(SourceFiles.size());
+    S = heavyweight_hardware_concurrency(FilesToRender.size());
     S.Limit = true;
   }
 
   if (!ViewOpts.hasOutputDirectory() || S.ThreadsRequested == 1) {
-    for (const std::string &SourceFile : SourceFiles)
+    for (const std::string &SourceFile : FilesToRender)
       writeSourceFileView(SourceFile, Coverage.get(), Printer.get(),
                           ShowFilenames);
   } else {
     // In -output-dir mode, it's safe to use multiple threads to print files.
     ThreadPool Pool(S);
-    for (const std::string &SourceFile : SourceFiles)
+    for (const std::string &SourceFile : FilesToRender)
       Pool.async(&CodeCoverageTool::writeSourceFileView, this, SourceFile,
                  Coverage.get(), Printer.get(), ShowFilenames);
     Pool.wait();
   }
 
+  if (Incremental)
+    saveRenderState(FileHashes);
+
   return 0;
 }
 
@@ -51,6 +51,14 @@ std::string CoveragePrinter::getOutputPath(StringRef Path, StringRef Extension,
   return std::string(FullPath.str());
 }
 
+bool CoveragePrinter::viewFileExists(StringRef Path, bool InToplevel) const {
+  if (!Opts.hasOutputDirectory())
+    return false;
+  StringRef Extension =
+      Opts.Format == CoverageViewOptions::OutputFormat::HTML ? "html" : "txt";
+  return sys::fs::exists(getOutputPath(Path, Extension, InToplevel, false));
+}
+
 Expected<CoveragePrinter::OwnedStream>
 CoveragePrinter::createOutputStream(StringRef Path, StringRef Extension,
                                     bool InToplevel) const {
@@ -118,6 +118,10 @@ public:
 
   virtual ~CoveragePrinter() {}
 
+  /// Return true if a view file for \p Path already exists in the output
+  /// directory.
+  bool viewFileExists(StringRef Path, bool InToplevel) const;
+
   /// @name File Creation Interface
   /// @{
 
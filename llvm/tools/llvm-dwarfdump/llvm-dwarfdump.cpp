@@ -256,6 +256,11 @@ static opt<bool> Verify("verify", desc("Verify the DWARF debug info."),
                         cat(DwarfDumpCategory));
 static opt<bool> Quiet("quiet", desc("Use with -verify to not emit to STDOUT."),
                        cat(DwarfDumpCategory));
+static opt<bool> VerifyQuick("verify-quick",
+                             desc("Use with -verify to only run the per-unit "
+                                  "checks and skip the expensive cross-unit "
+                                  "DIE reference verification."),
+                             cat(DwarfDumpCategory));
 static opt<bool> DumpUUID("uuid", desc("Show the UUID for each architecture."),
                           cat(DwarfDumpCategory));
 static alias DumpUUIDAlias("u", desc("Alias for --uuid."), aliasopt(DumpUUID),
@@ -304,6 +309,7 @@ static DIDumpOptions getDumpOpts(DWARFContext &C) {
   // In -verify mode, print DIEs without children in error messages.
   if (Verify) {
     DumpOpts.Verbose = true;
+    DumpOpts.VerifyQuick = VerifyQuick;
     return DumpOpts.noImplicitRecursion();
   }
   return DumpOpts;
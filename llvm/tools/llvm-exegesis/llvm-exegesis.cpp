@@ -22,6 +22,7 @@
 #include "lib/SnippetRepetitor.h"
 #include "lib/Target.h"
 #include "lib/TargetSelect.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/MC/MCInstBuilder.h"
@@ -39,6 +40,7 @@
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include <algorithm>
+#include <cmath>
 #include <string>
 
 namespace llvm {
@@ -129,6 +131,24 @@ static cl::opt<unsigned> MaxConfigsPerOpcode(
         "allow to snippet generator to generate at most that many configs"),
     cl::cat(BenchmarkOptions), cl::init(1));
 
+static cl::opt<bool> ResumeBenchmarks(
+    "resume",
+    cl::desc("skip opcodes that already have a result in the benchmarks "
+             "file, so an interrupted sweep picks up where it stopped"),
+    cl::cat(BenchmarkOptions), cl::init(false));
+
+static cl::opt<unsigned> CrossCheckRuns(
+    "cross-check-runs",
+    cl::desc("measure each configuration that many times and report runs "
+             "that disagree beyond -cross-check-tolerance"),
+    cl::cat(BenchmarkOptions), cl::init(1));
+
+static cl::opt<double> CrossCheckTolerance(
+    "cross-check-tolerance",
+    cl::desc("maximum relative deviation between cross-check runs before a "
+             "measurement is reported as unstable"),
+    cl::cat(BenchmarkOptions), cl::init(0.1));
+
 static cl::opt<bool> IgnoreInvalidSchedClass(
     "ignore-invalid-sched-class",
     cl::desc("ignore instructions that do not define a sched class"),
@@ -319,6 +339,21 @@ void benchmarkMain() {
 
   const auto Opcodes = getOpcodesOrDie(State.getInstrInfo());
 
+  // With -resume, collect the opcodes that already have a result in the
+  // benchmarks file so an interrupted sweep does not redo them. Results that
+  // recorded an error are measured again.
+  DenseSet<unsigned> MeasuredOpcodes;
+  if (ResumeBenchmarks) {
+    if (BenchmarkFile.empty() || BenchmarkFile == "-")
+      ExitWithError("-resume requires -benchmarks-file pointing to a file");
+    if (sys::fs::exists(BenchmarkFile))
+      for (const InstructionBenchmark &IB : ExitOnFileError(
+               BenchmarkFile,
+               InstructionBenchmark::readYamls(State, BenchmarkFile)))
+        if (IB.Error.empty() && !IB.Key.Instructions.empty())
+          MeasuredOpcodes.insert(IB.keyInstruction().getOpcode());
+  }
+
   SmallVector<std::unique_ptr<const SnippetRepetitor>, 2> Repetitors;
   if (RepetitionMode != InstructionBenchmark::RepetitionModeE::AggregateMin)
     Repetitors.emplace_back(SnippetRepetitor::Create(RepetitionMode, State));
@@ -348,6 +383,9 @@ void benchmarkMain() {
         continue;
       }
 
+      if (MeasuredOpcodes.contains(Opcode))
+        continue;
+
       auto ConfigsForInstr = generateSnippets(State, Opcode, AllReservedRegs);
       if (!ConfigsForInstr) {
         logAllUnhandledErrors(
@@ -374,6 +412,32 @@ void benchmarkMain() {
   for (const BenchmarkCode &Conf : Configurations) {
     InstructionBenchmark Result = ExitOnErr(Runner->runConfiguration(
         Conf, NumRepetitions, LoopBodySize, Repetitors, DumpObjectToDisk));
+    // Re-measure the configuration when cross-checking is requested and
+    // report runs that disagree; a noisy result is otherwise written to the
+    // output file indistinguishable from a stable one.
+    for (unsigned Run = 1; Run < CrossCheckRuns; ++Run) {
+      const InstructionBenchmark CrossCheck =
+          ExitOnErr(Runner->runConfiguration(Conf, NumRepetitions, LoopBodySize,
+                                             Repetitors, DumpObjectToDisk));
+      for (size_t I = 0, End = std::min(Result.Measurements.size(),
+                                        CrossCheck.Measurements.size());
+           I != End; ++I) {
+        const double Reference = Result.Measurements[I].PerInstructionValue;
+        const double Repeated = CrossCheck.Measurements[I].PerInstructionValue;
+        const double Magnitude =
+            std::max(std::abs(Reference), std::abs(Repeated));
+        if (Magnitude == 0.0 ||
+            std::abs(Reference - Repeated) / Magnitude <= CrossCheckTolerance)
+          continue;
+        const StringRef Name =
+            Result.Key.Instructions.empty()
+                ? StringRef("<snippet>")
+                : State.getInstrInfo().getName(
+                      Result.keyInstruction().getOpcode());
+        errs() << Name << ": unstable " << Result.Measurements[I].Key
+               << " measurement: " << Reference << " vs " << Repeated << "\n";
+      }
+    }
     ExitOnFileError(BenchmarkFile, Result.writeYaml(State, BenchmarkFile));
   }
   exegesis::pfm::pfmTerminate();
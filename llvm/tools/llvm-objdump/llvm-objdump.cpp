@@ -1376,6 +1376,10 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
   // Multiple symbols can have the same address. Use a stable sort to stabilize
   // the output.
   StringSet<> FoundDisasmSymbolSet;
+
+  // Branch targets repeat (one entry per call site); memoize the demangled
+  // names so each target symbol is demangled at most once per object.
+  StringMap<std::string> DemangledTargetNames;
   for (std::pair<const SectionRef, SectionSymbolsTy> &SecSyms : AllSymbols)
     llvm::stable_sort(SecSyms.second);
   llvm::stable_sort(AbsoluteSymbols);
@@ -1479,7 +1483,7 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
     uint64_t Size;
     uint64_t Index;
     bool PrintedSection = false;
-    std::vector<RelocationRef> Rels = RelocMap[Section];
+    std::vector<RelocationRef> &Rels = RelocMap[Section];
     std::vector<RelocationRef>::const_iterator RelCur = Rels.begin();
     std::vector<RelocationRef>::const_iterator RelEnd = Rels.end();
 
@@ -1859,8 +1863,12 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
                 uint64_t TargetAddress = TargetSym->Addr;
                 uint64_t Disp = Target - TargetAddress;
                 std::string TargetName = TargetSym->Name.str();
-                if (Demangle)
-                  TargetName = demangle(TargetName);
+                if (Demangle) {
+                  auto It = DemangledTargetNames.try_emplace(TargetName);
+                  if (It.second)
+                    It.first->second = demangle(TargetName);
+                  TargetName = It.first->second;
+                }
 
                 *TargetOS << " <";
                 if (!Disp) {
@@ -54,6 +54,26 @@ static cl::opt<std::string>
                          "default, run all delta passes."),
                 cl::cat(LLVMReduceOptions));
 
+static cl::opt<bool> WriteCheckpoints(
+    "checkpoint",
+    cl::desc("Update the output file after each delta pass finishes, so an "
+             "interrupted reduction can be restarted from the partially "
+             "reduced file"),
+    cl::init(false), cl::cat(LLVMReduceOptions));
+
+void writeOutput(ReducerWorkItem &M, StringRef Message);
+
+/// If requested, persist the current program after a finished delta pass. The
+/// checkpoint is the regular textual output, so resuming is just rerunning
+/// llvm-reduce on it with the same command line.
+static void writeCheckpoint(TestRunner &Tester, StringRef PassName) {
+  if (!WriteCheckpoints)
+    return;
+  std::string Message =
+      (Twine("Saved checkpoint after ") + PassName + ": ").str();
+  writeOutput(Tester.getProgram(), Message);
+}
+
 #define DELTA_PASSES                                                           \
   do {                                                                         \
     DELTA_PASS("functions", reduceFunctionsDeltaPass)                          \
@@ -96,7 +116,11 @@ static cl::opt<std::string>
   } while (false)
 
 static void runAllDeltaPasses(TestRunner &Tester) {
-#define DELTA_PASS(NAME, FUNC) FUNC(Tester);
+#define DELTA_PASS(NAME, FUNC)                                                 \
+  {                                                                            \
+    FUNC(Tester);                                                              \
+    writeCheckpoint(Tester, NAME);                                             \
+  }
   if (Tester.getProgram().isMIR()) {
     DELTA_PASSES_MIR;
   } else {
@@ -109,6 +133,7 @@ static void runDeltaPassName(TestRunner &Tester, StringRef PassName) {
 #define DELTA_PASS(NAME, FUNC)                                                 \
   if (PassName == NAME) {                                                      \
     FUNC(Tester);                                                              \
+    writeCheckpoint(Tester, NAME);                                             \
     return;                                                                    \
   }
   if (Tester.getProgram().isMIR()) {
@@ -35,6 +35,9 @@ static cl::SubCommand
 static cl::SubCommand
     Bitstream2YAML("bitstream2yaml",
                    "Convert bitstream remarks to YAML remarks");
+static cl::SubCommand
+    Filter("filter",
+           "Stream remarks matching a function or pass name to YAML");
 } // namespace subopts
 
 // Conversions have the same command line options. AFAIK there is no way to
@@ -63,6 +66,25 @@ static constexpr Format OutputFormat = Format::YAML;
 CONVERSION_COMMAND_LINE_OPTIONS(subopts::Bitstream2YAML)
 } // namespace bitstream2yaml
 
+namespace filter {
+/// Remark format to output.
+static constexpr Format OutputFormat = Format::YAML;
+CONVERSION_COMMAND_LINE_OPTIONS(subopts::Filter)
+static cl::opt<Format> InputFormat(
+    "parser", cl::Required, cl::cat(RemarkUtilCategory),
+    cl::sub(subopts::Filter), cl::desc("Input remark format to parse"),
+    cl::values(clEnumValN(Format::YAML, "yaml", "YAML"),
+               clEnumValN(Format::Bitstream, "bitstream", "Bitstream")));
+static cl::opt<std::string>
+    FunctionName("function", cl::cat(RemarkUtilCategory),
+                 cl::sub(subopts::Filter), cl::value_desc("name"),
+                 cl::desc("Only keep remarks for this function"));
+static cl::opt<std::string>
+    PassName("pass", cl::cat(RemarkUtilCategory), cl::sub(subopts::Filter),
+             cl::value_desc("name"),
+             cl::desc("Only keep remarks emitted by this pass"));
+} // namespace filter
+
 /// \returns A MemoryBuffer for the input file on success, and an Error
 /// otherwise.
 static Expected<std::unique_ptr<MemoryBuffer>>
@@ -186,6 +208,49 @@ static Error tryBitstream2YAML() {
 }
 } // namespace bitstream2yaml
 
+namespace filter {
+/// Stream remarks from the input file and reserialize the ones matching the
+/// requested function and pass names as YAML. Remarks are emitted as they are
+/// parsed, so memory use stays bounded regardless of the input size.
+/// \returns An Error if parsing or reserialization fails, or Error::success()
+/// on success.
+static Error tryFilter() {
+  auto MaybeOF = getOutputFile(OutputFileName, OutputFormat);
+  if (!MaybeOF)
+    return MaybeOF.takeError();
+  auto OF = std::move(*MaybeOF);
+  auto MaybeSerializer = createRemarkSerializer(
+      OutputFormat, SerializerMode::Standalone, OF->os());
+  if (!MaybeSerializer)
+    return MaybeSerializer.takeError();
+  auto Serializer = std::move(*MaybeSerializer);
+
+  auto MaybeBuf = getInputMemoryBuffer(InputFileName);
+  if (!MaybeBuf)
+    return MaybeBuf.takeError();
+  auto MaybeParser = createRemarkParser(InputFormat, (*MaybeBuf)->getBuffer());
+  if (!MaybeParser)
+    return MaybeParser.takeError();
+  auto &Parser = **MaybeParser;
+
+  auto MaybeRemark = Parser.next();
+  for (; MaybeRemark; MaybeRemark = Parser.next()) {
+    const Remark &Remark = **MaybeRemark;
+    if (!FunctionName.empty() && Remark.FunctionName != FunctionName)
+      continue;
+    if (!PassName.empty() && Remark.PassName != PassName)
+      continue;
+    Serializer->emit(Remark);
+  }
+  auto E = MaybeRemark.takeError();
+  if (!E.isA<EndOfFileError>())
+    return E;
+  consumeError(std::move(E));
+  OF->keep();
+  return Error::success();
+}
+} // namespace filter
+
 /// Handle user-specified suboptions (e.g. yaml2bitstream, bitstream2yaml).
 /// \returns An Error if the specified suboption fails or if no suboption was
 /// specified. Otherwise, Error::success().
@@ -194,6 +259,8 @@ static Error handleSuboptions() {
     return bitstream2yaml::tryBitstream2YAML();
   if (subopts::YAML2Bitstream)
     return yaml2bitstream::tryYAML2Bitstream();
+  if (subopts::Filter)
+    return filter::tryFilter();
   return make_error<StringError>(
       "Please specify a subcommand. (See -help for options)",
       inconvertibleErrorCode());
@@ -0,0 +1,163 @@
+//===-- llvm-time-trace-merge.cpp - Aggregate -ftime-trace output ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Merges the per-process JSON files written by -ftime-trace (see
+// llvm/Support/TimeProfiler.h) into a single build-level report. Complete
+// ("ph":"X") events are summed by section name, and optionally by per-event
+// detail, so the time spent parsing one header or running one pass can be
+// attributed across every compile in a build without external scripting.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static cl::OptionCategory TimeTraceMergeCategory("llvm-time-trace-merge Options");
+
+static cl::list<std::string> InputFilenames(cl::Positional,
+                                            cl::desc("<trace files>"),
+                                            cl::OneOrMore,
+                                            cl::cat(TimeTraceMergeCategory));
+
+static cl::opt<std::string> OutputFilename("o", cl::desc("Output filename"),
+                                           cl::value_desc("filename"),
+                                           cl::init("-"),
+                                           cl::cat(TimeTraceMergeCategory));
+
+static cl::opt<bool> ReportDetails(
+    "details",
+    cl::desc("Also aggregate by event detail (source files, symbols, passes)"),
+    cl::cat(TimeTraceMergeCategory));
+
+static cl::opt<unsigned>
+    Top("top", cl::desc("Print only the N largest rows per table (0 = all)"),
+        cl::init(0), cl::cat(TimeTraceMergeCategory));
+
+namespace {
+struct EventStats {
+  double DurUs = 0;
+  uint64_t Count = 0;
+};
+} // namespace
+
+static Error aggregateFile(StringRef Path, StringMap<EventStats> &ByName,
+                           StringMap<EventStats> &ByDetail) {
+  auto BufOrErr = MemoryBuffer::getFileOrSTDIN(Path);
+  if (!BufOrErr)
+    return createFileError(Path, BufOrErr.getError());
+
+  Expected<json::Value> Root = json::parse((*BufOrErr)->getBuffer());
+  if (!Root)
+    return createFileError(Path, Root.takeError());
+
+  const json::Object *O = Root->getAsObject();
+  const json::Array *Events = O ? O->getArray("traceEvents") : nullptr;
+  if (!Events)
+    return createFileError(
+        Path, createStringError(inconvertibleErrorCode(),
+                                "expected an object with a traceEvents array"));
+
+  for (const json::Value &EventValue : *Events) {
+    const json::Object *Event = EventValue.getAsObject();
+    if (!Event)
+      continue;
+    Optional<StringRef> Ph = Event->getString("ph");
+    if (!Ph || *Ph != "X")
+      continue;
+    Optional<StringRef> Name = Event->getString("name");
+    Optional<double> DurUs = Event->getNumber("dur");
+    if (!Name || !DurUs)
+      continue;
+    // The "Total ..." pseudo events written by the profiler summarize the
+    // events they accompany; skip them rather than double count, and recompute
+    // totals over the whole build below.
+    if (Name->startswith("Total "))
+      continue;
+
+    EventStats &Stats = ByName[*Name];
+    Stats.DurUs += *DurUs;
+    ++Stats.Count;
+
+    if (!ReportDetails)
+      continue;
+    if (const json::Object *Args = Event->getObject("args"))
+      if (Optional<StringRef> Detail = Args->getString("detail")) {
+        EventStats &DetailStats = ByDetail[(*Name + ": " + *Detail).str()];
+        DetailStats.DurUs += *DurUs;
+        ++DetailStats.Count;
+      }
+  }
+  return Error::success();
+}
+
+static void printTable(raw_ostream &OS, StringRef Title,
+                       const StringMap<EventStats> &Stats) {
+  std::vector<std::pair<StringRef, EventStats>> Rows;
+  Rows.reserve(Stats.size());
+  for (const auto &Entry : Stats)
+    Rows.emplace_back(Entry.getKey(), Entry.getValue());
+  llvm::sort(Rows, [](const auto &A, const auto &B) {
+    return A.second.DurUs > B.second.DurUs;
+  });
+  if (Top != 0 && Rows.size() > Top)
+    Rows.resize(Top);
+
+  OS << Title << ":\n";
+  OS << "     Time (ms)      Count  Name\n";
+  for (const auto &Row : Rows)
+    OS << format("%14.1f %10" PRIu64 "  ", Row.second.DurUs / 1000.0,
+                 Row.second.Count)
+       << Row.first << '\n';
+  OS << '\n';
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  cl::HideUnrelatedOptions(TimeTraceMergeCategory);
+  cl::ParseCommandLineOptions(
+      argc, argv, "Aggregate -ftime-trace JSON files across a build\n");
+
+  StringMap<EventStats> ByName;
+  StringMap<EventStats> ByDetail;
+  for (const std::string &Filename : InputFilenames) {
+    if (Error E = aggregateFile(Filename, ByName, ByDetail)) {
+      WithColor::error(errs(), "llvm-time-trace-merge")
+          << toString(std::move(E)) << '\n';
+      return 1;
+    }
+  }
+
+  std::error_code EC;
+  ToolOutputFile Out(OutputFilename, EC, sys::fs::OF_Text);
+  if (EC) {
+    WithColor::error(errs(), "llvm-time-trace-merge")
+        << "could not open '" << OutputFilename << "': " << EC.message()
+        << '\n';
+    return 1;
+  }
+
+  Out.os() << "Aggregated " << InputFilenames.size() << " trace file"
+           << (InputFilenames.size() == 1 ? "" : "s") << "\n\n";
+  printTable(Out.os(), "Time by section", ByName);
+  if (ReportDetails)
+    printTable(Out.os(), "Time by event", ByDetail);
+  Out.keep();
+  return 0;
+}
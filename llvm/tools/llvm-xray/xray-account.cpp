@@ -470,48 +470,55 @@ static CommandRegistration Unused(&Account, []() -> Error {
                                                   FunctionAddresses);
   xray::LatencyAccountant FCA(FuncIdHelper, AccountRecursiveCallsOnly,
                               AccountDeduceSiblingCalls);
-  auto TraceOrErr = loadTraceFile(AccountInput);
-  if (!TraceOrErr)
-    return joinErrors(
-        make_error<StringError>(
-            Twine("Failed loading input file '") + AccountInput + "'",
-            std::make_error_code(std::errc::executable_format_error)),
-        TraceOrErr.takeError());
-
-  auto &T = *TraceOrErr;
-  for (const auto &Record : T) {
-    if (FCA.accountRecord(Record))
-      continue;
-    errs()
-        << "Error processing record: "
-        << llvm::formatv(
-               R"({{type: {0}; cpu: {1}; record-type: {2}; function-id: {3}; tsc: {4}; thread-id: {5}; process-id: {6}}})",
-               Record.RecordType, Record.CPU, Record.Type, Record.FuncId,
-               Record.TSC, Record.TId, Record.PId)
-        << '\n';
-    for (const auto &ThreadStack : FCA.getPerThreadFunctionStack()) {
-      errs() << "Thread ID: " << ThreadStack.first << "\n";
-      if (ThreadStack.second.Stack.empty()) {
-        errs() << "  (empty stack)\n";
+  XRayFileHeader Header;
+  {
+    auto TraceOrErr = loadTraceFile(AccountInput);
+    if (!TraceOrErr)
+      return joinErrors(
+          make_error<StringError>(
+              Twine("Failed loading input file '") + AccountInput + "'",
+              std::make_error_code(std::errc::executable_format_error)),
+          TraceOrErr.takeError());
+
+    auto &T = *TraceOrErr;
+    Header = T.getFileHeader();
+    for (const auto &Record : T) {
+      if (FCA.accountRecord(Record))
         continue;
+      errs()
+          << "Error processing record: "
+          << llvm::formatv(
+                 R"({{type: {0}; cpu: {1}; record-type: {2}; function-id: {3}; tsc: {4}; thread-id: {5}; process-id: {6}}})",
+                 Record.RecordType, Record.CPU, Record.Type, Record.FuncId,
+                 Record.TSC, Record.TId, Record.PId)
+          << '\n';
+      for (const auto &ThreadStack : FCA.getPerThreadFunctionStack()) {
+        errs() << "Thread ID: " << ThreadStack.first << "\n";
+        if (ThreadStack.second.Stack.empty()) {
+          errs() << "  (empty stack)\n";
+          continue;
+        }
+        auto Level = ThreadStack.second.Stack.size();
+        for (const auto &Entry : llvm::reverse(ThreadStack.second.Stack))
+          errs() << "  #" << Level-- << "\t"
+                 << FuncIdHelper.SymbolOrNumber(Entry.first) << '\n';
       }
-      auto Level = ThreadStack.second.Stack.size();
-      for (const auto &Entry : llvm::reverse(ThreadStack.second.Stack))
-        errs() << "  #" << Level-- << "\t"
-               << FuncIdHelper.SymbolOrNumber(Entry.first) << '\n';
+      if (!AccountKeepGoing)
+        return make_error<StringError>(
+            Twine("Failed accounting function calls in file '") + AccountInput +
+                "'.",
+            std::make_error_code(std::errc::executable_format_error));
     }
-    if (!AccountKeepGoing)
-      return make_error<StringError>(
-          Twine("Failed accounting function calls in file '") + AccountInput +
-              "'.",
-          std::make_error_code(std::errc::executable_format_error));
   }
+  // The trace records are no longer needed once the latencies are accounted;
+  // the scope above drops them so peak memory does not stack the record
+  // vector on top of the per-function report tables built below.
   switch (AccountOutputFormat) {
   case AccountOutputFormats::TEXT:
-    FCA.exportStatsAsText(OS, T.getFileHeader());
+    FCA.exportStatsAsText(OS, Header);
     break;
   case AccountOutputFormats::CSV:
-    FCA.exportStatsAsCSV(OS, T.getFileHeader());
+    FCA.exportStatsAsCSV(OS, Header);
     break;
   }
 
@@ -0,0 +1,125 @@
+//==- ImmutableHashedMapTest.cpp - ImmutableHashedMap unit tests -----------==//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/ImmutableHashedMap.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+// Maps every key to one hash so that all entries land in collision nodes.
+struct CollidingKeyInfo : ImutHashedKeyValueInfo<int, int> {
+  static uint32_t getHash(key_type_ref) { return 42; }
+};
+
+TEST(ImmutableHashedMapTest, EmptyIntMapTest) {
+  ImmutableHashedMap<int, int>::Factory f;
+
+  EXPECT_TRUE(f.getEmptyMap() == f.getEmptyMap());
+  EXPECT_FALSE(f.getEmptyMap() != f.getEmptyMap());
+  EXPECT_TRUE(f.getEmptyMap().isEmpty());
+
+  ImmutableHashedMap<int, int> S = f.getEmptyMap();
+  EXPECT_TRUE(S.begin() == S.end());
+  EXPECT_FALSE(S.begin() != S.end());
+}
+
+TEST(ImmutableHashedMapTest, MultiElemIntMapTest) {
+  ImmutableHashedMap<int, int>::Factory f;
+  ImmutableHashedMap<int, int> S = f.getEmptyMap();
+
+  ImmutableHashedMap<int, int> S2 = f.add(f.add(f.add(S, 3, 10), 4, 11), 5, 12);
+
+  EXPECT_TRUE(S.isEmpty());
+  EXPECT_FALSE(S2.isEmpty());
+
+  EXPECT_EQ(nullptr, S.lookup(3));
+  EXPECT_EQ(nullptr, S.lookup(9));
+
+  EXPECT_EQ(10, *S2.lookup(3));
+  EXPECT_EQ(11, *S2.lookup(4));
+  EXPECT_EQ(12, *S2.lookup(5));
+  EXPECT_TRUE(S2.contains(4));
+  EXPECT_FALSE(S2.contains(9));
+}
+
+TEST(ImmutableHashedMapTest, CanonicalAcrossOperationOrder) {
+  ImmutableHashedMap<int, int>::Factory f;
+  ImmutableHashedMap<int, int> E = f.getEmptyMap();
+
+  // Equal contents share one root no matter how they were built, so map
+  // equality is pointer equality.
+  ImmutableHashedMap<int, int> A = f.add(f.add(f.add(E, 1, 10), 2, 20), 3, 30);
+  ImmutableHashedMap<int, int> B = f.add(f.add(f.add(E, 3, 30), 1, 10), 2, 20);
+  EXPECT_EQ(A.getRoot(), B.getRoot());
+  EXPECT_TRUE(A == B);
+
+  // Adding an already-present binding is the identity.
+  EXPECT_EQ(A.getRoot(), f.add(A, 2, 20).getRoot());
+
+  // Overwriting makes a different map; overwriting back converges.
+  ImmutableHashedMap<int, int> C = f.add(A, 2, 99);
+  EXPECT_TRUE(C != A);
+  EXPECT_TRUE(f.add(C, 2, 20) == A);
+
+  // Removal reproduces the exact root an insertion-only history would build.
+  EXPECT_TRUE(f.remove(A, 3) == f.add(f.add(E, 1, 10), 2, 20));
+  EXPECT_TRUE(f.remove(f.remove(f.remove(A, 2), 3), 1).isEmpty());
+  EXPECT_TRUE(f.remove(A, 77) == A);
+}
+
+TEST(ImmutableHashedMapTest, LargeMapIterationAndRemoval) {
+  ImmutableHashedMap<int, int>::Factory f;
+  ImmutableHashedMap<int, int> M = f.getEmptyMap();
+  for (int K = 0; K < 1000; ++K)
+    M = f.add(M, K, K + 1);
+
+  int Count = 0;
+  long KeySum = 0;
+  for (auto I = M.begin(), E = M.end(); I != E; ++I) {
+    EXPECT_EQ(I.getKey() + 1, I.getData());
+    ++Count;
+    KeySum += I.getKey();
+  }
+  EXPECT_EQ(1000, Count);
+  EXPECT_EQ(999 * 1000 / 2, KeySum);
+
+  for (int K = 0; K < 1000; ++K)
+    EXPECT_EQ(K + 1, *M.lookup(K));
+
+  ImmutableHashedMap<int, int> Pruned = M;
+  for (int K = 999; K >= 500; --K)
+    Pruned = f.remove(Pruned, K);
+  ImmutableHashedMap<int, int> Half = f.getEmptyMap();
+  for (int K = 499; K >= 0; --K)
+    Half = f.add(Half, K, K + 1);
+  EXPECT_EQ(Half.getRoot(), Pruned.getRoot());
+}
+
+TEST(ImmutableHashedMapTest, HashCollisionsTest) {
+  ImmutableHashedMap<int, int, CollidingKeyInfo>::Factory f;
+  auto E = f.getEmptyMap();
+
+  auto A = f.add(f.add(f.add(E, 1, 1), 2, 2), 3, 3);
+  auto B = f.add(f.add(f.add(E, 3, 3), 2, 2), 1, 1);
+  EXPECT_EQ(A.getRoot(), B.getRoot());
+
+  for (int K = 1; K <= 3; ++K)
+    EXPECT_EQ(K, *A.lookup(K));
+  EXPECT_EQ(nullptr, A.lookup(4));
+
+  EXPECT_TRUE(f.remove(f.remove(A, 2), 3) == f.add(E, 1, 1));
+
+  int Count = 0;
+  for (auto I = A.begin(), En = A.end(); I != En; ++I)
+    ++Count;
+  EXPECT_EQ(3, Count);
+}
+
+} // end anonymous namespace
@@ -635,4 +635,71 @@ TEST(StringMapCustomTest, StringMapEntrySize) {
   EXPECT_EQ(LargeValue, Key.size());
 }
 
+using GroupedStringMap =
+    StringMap<uint32_t, MallocAllocator, StringMapGroupProbing>;
+
+// Exercise insertion, lookup, and iteration with the group-probing policy.
+// Enough keys to force several rehashes.
+TEST(StringMapCustomTest, GroupProbingBasic) {
+  GroupedStringMap Map;
+  for (uint32_t I = 0; I != 1024; ++I)
+    EXPECT_TRUE(Map.insert({("key_" + Twine(I)).str(), I}).second);
+  EXPECT_EQ(1024u, Map.size());
+
+  for (uint32_t I = 0; I != 1024; ++I) {
+    auto It = Map.find(("key_" + Twine(I)).str());
+    ASSERT_TRUE(It != Map.end());
+    EXPECT_EQ(I, It->second);
+  }
+  EXPECT_TRUE(Map.find("not_a_key") == Map.end());
+
+  uint32_t Sum = 0;
+  for (const auto &KV : Map)
+    Sum += KV.second;
+  EXPECT_EQ(1024u * 1023u / 2, Sum);
+}
+
+// Erasure leaves tombstones behind; make sure grouped probing still finds the
+// remaining keys and that tombstones are reused on reinsertion.
+TEST(StringMapCustomTest, GroupProbingErase) {
+  GroupedStringMap Map;
+  for (uint32_t I = 0; I != 256; ++I)
+    Map[("key_" + Twine(I)).str()] = I;
+
+  for (uint32_t I = 0; I != 256; I += 2)
+    EXPECT_TRUE(Map.erase(("key_" + Twine(I)).str()));
+  EXPECT_EQ(128u, Map.size());
+
+  for (uint32_t I = 0; I != 256; ++I) {
+    auto It = Map.find(("key_" + Twine(I)).str());
+    if (I % 2)
+      EXPECT_EQ(I, It->second);
+    else
+      EXPECT_TRUE(It == Map.end());
+  }
+
+  for (uint32_t I = 0; I != 256; I += 2)
+    EXPECT_TRUE(Map.insert({("key_" + Twine(I)).str(), I}).second);
+  EXPECT_EQ(256u, Map.size());
+  for (uint32_t I = 0; I != 256; ++I)
+    EXPECT_EQ(I, Map.lookup(("key_" + Twine(I)).str()));
+}
+
+TEST(StringMapCustomTest, GroupProbingCopyAndClear) {
+  GroupedStringMap Map;
+  for (uint32_t I = 0; I != 64; ++I)
+    Map[("key_" + Twine(I)).str()] = I;
+
+  GroupedStringMap Copy(Map);
+  EXPECT_EQ(64u, Copy.size());
+  for (uint32_t I = 0; I != 64; ++I)
+    EXPECT_EQ(I, Copy.lookup(("key_" + Twine(I)).str()));
+
+  Map.clear();
+  EXPECT_TRUE(Map.empty());
+  EXPECT_TRUE(Map.find("key_0") == Map.end());
+  Map["key_0"] = 42;
+  EXPECT_EQ(42u, Map.lookup("key_0"));
+}
+
 } // end anonymous namespace
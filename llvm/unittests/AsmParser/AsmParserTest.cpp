@@ -10,8 +10,11 @@
 #include "llvm/AsmParser/Parser.h"
 #include "llvm/AsmParser/SlotMapping.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
 #include "gtest/gtest.h"
 
@@ -400,4 +403,83 @@ TEST(AsmParserTest, TypeAtBeginningWithSlotMappingParsing) {
   ASSERT_TRUE(Read == 4);
 }
 
+TEST(AsmParserTest, LazyFunctionBodyParsing) {
+  LLVMContext Ctx;
+  StringRef Source = "define i32 @foo(i32 %x) {\n"
+                     "entry:\n"
+                     "  %r = add i32 %x, 1\n"
+                     "  ret i32 %r\n"
+                     "}\n"
+                     "define void @bar() {\n"
+                     "  call i32 @foo(i32 0)\n"
+                     "  ret void\n"
+                     "}\n";
+  SMDiagnostic Error;
+  auto Mod = parseAssemblyLazy(MemoryBuffer::getMemBufferCopy(Source), Error,
+                               Ctx);
+  ASSERT_TRUE(Mod != nullptr);
+  EXPECT_TRUE(Error.getMessage().empty());
+
+  // Both bodies should have been skipped.
+  Function *Foo = Mod->getFunction("foo");
+  Function *Bar = Mod->getFunction("bar");
+  ASSERT_TRUE(Foo && Bar);
+  EXPECT_TRUE(Foo->isMaterializable());
+  EXPECT_TRUE(Foo->empty());
+  EXPECT_TRUE(Bar->isMaterializable());
+  EXPECT_TRUE(Bar->empty());
+
+  // Materialize a single body on demand.
+  ASSERT_FALSE(errorToBool(Foo->materialize()));
+  EXPECT_FALSE(Foo->isMaterializable());
+  EXPECT_EQ(Foo->size(), 1u);
+  EXPECT_TRUE(Bar->empty());
+
+  // Materializing the whole module parses the rest.
+  ASSERT_FALSE(errorToBool(Mod->materializeAll()));
+  EXPECT_EQ(Bar->size(), 1u);
+  EXPECT_EQ(cast<CallInst>(&Bar->front().front())->getCalledFunction(), Foo);
+}
+
+TEST(AsmParserTest, LazyFunctionBodyParsingBlockAddress) {
+  LLVMContext Ctx;
+  StringRef Source = "@addr = global ptr blockaddress(@foo, %bb)\n"
+                     "define void @foo() {\n"
+                     "entry:\n"
+                     "  br label %bb\n"
+                     "bb:\n"
+                     "  ret void\n"
+                     "}\n";
+  SMDiagnostic Error;
+  auto Mod = parseAssemblyLazy(MemoryBuffer::getMemBufferCopy(Source), Error,
+                               Ctx);
+  ASSERT_TRUE(Mod != nullptr);
+  EXPECT_TRUE(Error.getMessage().empty());
+
+  // The blockaddress reference forces @foo to be materialized eagerly.
+  Function *Foo = Mod->getFunction("foo");
+  ASSERT_TRUE(Foo);
+  EXPECT_FALSE(Foo->isMaterializable());
+  EXPECT_EQ(Foo->size(), 2u);
+
+  auto *Addr = Mod->getGlobalVariable("addr");
+  ASSERT_TRUE(Addr);
+  auto *BA = dyn_cast<BlockAddress>(Addr->getInitializer());
+  ASSERT_TRUE(BA);
+  EXPECT_EQ(BA->getFunction(), Foo);
+}
+
+TEST(AsmParserTest, LazyFunctionBodyParsingError) {
+  LLVMContext Ctx;
+  StringRef Source = "define void @broken() {\n"
+                     "  ret i32 0\n"
+                     "}\n";
+  SMDiagnostic Error;
+  auto Mod = parseAssemblyLazy(MemoryBuffer::getMemBufferCopy(Source), Error,
+                               Ctx);
+  // The error is only diagnosed when the body is parsed.
+  ASSERT_TRUE(Mod != nullptr);
+  EXPECT_TRUE(errorToBool(Mod->materializeAll()));
+}
+
 } // end anonymous namespace
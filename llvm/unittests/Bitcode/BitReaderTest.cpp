@@ -14,6 +14,7 @@
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/ModuleSummaryIndex.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
@@ -255,4 +256,43 @@ TEST(BitReaderTest, MaterializeFunctionsForBlockAddrInFunctionAfter) {
   EXPECT_FALSE(verifyModule(*M, &dbgs()));
 }
 
+// Tests that a GUID filter passed to getModuleSummaryIndex materializes only
+// the summaries whose GUID it accepts.
+TEST(BitReaderTest, GetSummaryWithGUIDFilter) {
+  SMDiagnostic Err;
+  std::unique_ptr<ModuleSummaryIndex> Index = parseSummaryIndexAssembly(
+      MemoryBufferRef(
+          "^0 = module: (path: \"main.o\", hash: (0, 0, 0, 0, 0))\n"
+          "^1 = gv: (guid: 1, summaries: (function: (module: ^0, flags: "
+          "(linkage: external, notEligibleToImport: 0, live: 1, dsoLocal: 0), "
+          "insts: 10)))\n"
+          "^2 = gv: (guid: 2, summaries: (function: (module: ^0, flags: "
+          "(linkage: external, notEligibleToImport: 0, live: 1, dsoLocal: 0), "
+          "insts: 5)))\n",
+          "test"),
+      Err);
+  ASSERT_TRUE(Index);
+
+  SmallString<1024> Mem;
+  raw_svector_ostream OS(Mem);
+  writeIndexToFile(*Index, OS);
+  MemoryBufferRef Buffer(Mem.str(), "test");
+
+  // Without a filter both summaries are materialized.
+  Expected<std::unique_ptr<ModuleSummaryIndex>> FullOrErr =
+      getModuleSummaryIndex(Buffer);
+  ASSERT_TRUE(bool(FullOrErr));
+  EXPECT_EQ(1u, (*FullOrErr)->getValueInfo(1).getSummaryList().size());
+  EXPECT_EQ(1u, (*FullOrErr)->getValueInfo(2).getSummaryList().size());
+
+  // With a filter only the accepted GUID's summary is materialized; the
+  // rejected GUID at most keeps an empty value entry.
+  Expected<std::unique_ptr<ModuleSummaryIndex>> FilteredOrErr =
+      getModuleSummaryIndex(Buffer, [](uint64_t GUID) { return GUID == 1; });
+  ASSERT_TRUE(bool(FilteredOrErr));
+  EXPECT_EQ(1u, (*FilteredOrErr)->getValueInfo(1).getSummaryList().size());
+  ValueInfo Rejected = (*FilteredOrErr)->getValueInfo(2);
+  EXPECT_TRUE(!Rejected || Rejected.getSummaryList().empty());
+}
+
 } // end namespace
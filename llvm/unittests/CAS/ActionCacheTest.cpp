@@ -52,6 +52,39 @@ TEST_P(CASTest, ActionCacheMiss) {
   ASSERT_EQ(*ID1, *Result2);
 }
 
+TEST_P(CASTest, ActionCacheBatch) {
+  std::unique_ptr<ObjectStore> CAS = createObjectStore();
+  std::unique_ptr<ActionCache> Cache = createActionCache(*CAS);
+
+  Optional<ObjectProxy> ID1, ID2, ID3;
+  ASSERT_THAT_ERROR(CAS->createProxy(None, "1").moveInto(ID1), Succeeded());
+  ASSERT_THAT_ERROR(CAS->createProxy(None, "2").moveInto(ID2), Succeeded());
+  ASSERT_THAT_ERROR(CAS->createProxy(None, "3").moveInto(ID3), Succeeded());
+
+  SmallVector<CacheKey> Keys{CacheKey(*ID1), CacheKey(*ID2)};
+  SmallVector<ObjectRef> Results{ID2->getRef(), ID3->getRef()};
+  ASSERT_THAT_ERROR(Cache->putBatch(Keys, Results), Succeeded());
+
+  // One hit per key, in order; unknown keys come back as misses.
+  Keys.push_back(CacheKey(*ID3));
+  Optional<SmallVector<Optional<ObjectRef>, 0>> Lookups;
+  ASSERT_THAT_ERROR(Cache->getBatch(Keys).moveInto(Lookups), Succeeded());
+  ASSERT_EQ(3u, Lookups->size());
+  ASSERT_TRUE((*Lookups)[0]);
+  ASSERT_EQ(ID2->getRef(), *(*Lookups)[0]);
+  ASSERT_TRUE((*Lookups)[1]);
+  ASSERT_EQ(ID3->getRef(), *(*Lookups)[1]);
+  ASSERT_FALSE((*Lookups)[2]);
+
+  // The async flavor completes with success for a well-formed batch.
+  bool Called = false;
+  Cache->putBatchAsync(Keys[2], Results.pop_back_val(), [&](Error E) {
+    Called = true;
+    EXPECT_THAT_ERROR(std::move(E), Succeeded());
+  });
+  ASSERT_TRUE(Called);
+}
+
 TEST_P(CASTest, ActionCacheRewrite) {
   std::unique_ptr<ObjectStore> CAS = createObjectStore();
   std::unique_ptr<ActionCache> Cache = createActionCache(*CAS);
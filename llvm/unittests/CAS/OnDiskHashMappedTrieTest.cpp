@@ -143,6 +143,72 @@ TEST(OnDiskHashMappedTrieTest, Insertion) {
   }
 }
 
+TEST(OnDiskHashMappedTrieTest, ShardedInsertion) {
+  unittest::TempDir Temp("sharded-on-disk-hash-mapped-trie", /*Unique=*/true);
+
+  constexpr size_t MB = 1024u * 1024u;
+  constexpr size_t DataSize = 8;
+  constexpr size_t NumHashBytes = 8;
+  constexpr size_t NumShardBits = 2;
+
+  auto createTrie = [&]() {
+    return ShardedOnDiskHashMappedTrie::create(
+        Temp.path("sharded"), "index", NumShardBits,
+        /*NumHashBits=*/NumHashBytes * 8, DataSize, /*MaxFileSize=*/MB,
+        /*NewFileInitialSize=*/None);
+  };
+
+  Optional<ShardedOnDiskHashMappedTrie> Trie1;
+  ASSERT_THAT_ERROR(createTrie().moveInto(Trie1), Succeeded());
+  EXPECT_EQ(4u, Trie1->getNumShards());
+
+  // Top byte selects the shard; pick hashes that land in all four shards.
+  uint8_t HashBytes[4][8] = {
+      {0x00, 1, 2, 3, 4, 5, 6, 7},
+      {0x55, 1, 2, 3, 4, 5, 6, 7},
+      {0xaa, 1, 2, 3, 4, 5, 6, 7},
+      {0xff, 1, 2, 3, 4, 5, 6, 7},
+  };
+  constexpr StringLiteral DataBytes[4] = {"data0...", "data1...", "data2...",
+                                          "data3..."};
+
+  for (int I = 0; I != 4; ++I) {
+    auto Hash = makeArrayRef(HashBytes[I]);
+    ArrayRef<char> Data(DataBytes[I].data(), DataBytes[I].size());
+    EXPECT_FALSE(Trie1->find(Hash));
+    auto Insertion = Trie1->insert({Hash, Data});
+    ASSERT_TRUE(Insertion);
+    EXPECT_EQ(Hash, Insertion->Hash);
+    EXPECT_EQ(Data, Insertion->Data);
+  }
+
+  // Hashes with distinct top bits went to distinct shards.
+  for (int I = 0; I != 4; ++I) {
+    auto Hash = makeArrayRef(HashBytes[I]);
+    EXPECT_EQ(&Trie1->getShard(Hash), &Trie1->getShard((size_t)I));
+    EXPECT_TRUE(Trie1->getShard((size_t)I).find(Hash));
+  }
+
+  // Find through a new instance of the same on-disk layout, and recover from
+  // a shard-local offset.
+  Optional<ShardedOnDiskHashMappedTrie> Trie2;
+  ASSERT_THAT_ERROR(createTrie().moveInto(Trie2), Succeeded());
+  for (int I = 0; I != 4; ++I) {
+    auto Hash = makeArrayRef(HashBytes[I]);
+    ArrayRef<char> Data(DataBytes[I].data(), DataBytes[I].size());
+    auto Lookup = Trie2->find(Hash);
+    ASSERT_TRUE(Lookup);
+    EXPECT_EQ(Hash, Lookup->Hash);
+    EXPECT_EQ(Data, Lookup->Data);
+
+    auto Recovered =
+        Trie2->getShard(Hash).recoverFromFileOffset(Lookup.getOffset());
+    ASSERT_TRUE(Recovered);
+    EXPECT_EQ(Hash, Recovered->Hash);
+    EXPECT_EQ(Data, Recovered->Data);
+  }
+}
+
 } // namespace
 
 #endif
@@ -0,0 +1,94 @@
+//===- WriteThroughCASTest.cpp --------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/CAS/ObjectStore.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::cas;
+
+TEST(WriteThroughCASTest, StoreWritesThrough) {
+  std::shared_ptr<ObjectStore> Local = createInMemoryCAS();
+  std::shared_ptr<ObjectStore> Upstream = createInMemoryCAS();
+  Optional<std::unique_ptr<ObjectStore>> CAS;
+  ASSERT_THAT_ERROR(createWriteThroughCAS(Local, Upstream).moveInto(CAS),
+                    Succeeded());
+
+  Optional<ObjectProxy> Child1, Child2, Root;
+  ASSERT_THAT_ERROR((*CAS)->createProxy(None, "child1").moveInto(Child1),
+                    Succeeded());
+  ASSERT_THAT_ERROR((*CAS)->createProxy(None, "child2").moveInto(Child2),
+                    Succeeded());
+  ASSERT_THAT_ERROR((*CAS)
+                        ->createProxy({Child1->getRef(), Child2->getRef()},
+                                      "root")
+                        .moveInto(Root),
+                    Succeeded());
+
+  // Everything should be visible in both layers.
+  for (const ObjectProxy &Node : {*Child1, *Child2, *Root}) {
+    EXPECT_TRUE(Local->getReference(Node.getID()));
+    EXPECT_TRUE(Upstream->getReference(Node.getID()));
+  }
+}
+
+TEST(WriteThroughCASTest, ColdLoadIngestsClosure) {
+  std::shared_ptr<ObjectStore> Local = createInMemoryCAS();
+  std::shared_ptr<ObjectStore> Upstream = createInMemoryCAS();
+
+  // Populate only the upstream.
+  Optional<ObjectProxy> Child, Root;
+  ASSERT_THAT_ERROR(Upstream->createProxy(None, "child").moveInto(Child),
+                    Succeeded());
+  ASSERT_THAT_ERROR(
+      Upstream->createProxy({Child->getRef()}, "root").moveInto(Root),
+      Succeeded());
+
+  Optional<std::unique_ptr<ObjectStore>> CAS;
+  ASSERT_THAT_ERROR(createWriteThroughCAS(Local, Upstream).moveInto(CAS),
+                    Succeeded());
+
+  // The layered CAS sees the upstream object even though the local CAS is
+  // cold...
+  EXPECT_FALSE(Local->getReference(Root->getID()));
+  Optional<ObjectRef> Ref = (*CAS)->getReference(Root->getID());
+  ASSERT_TRUE(Ref);
+  EXPECT_EQ((*CAS)->getID(*Ref), Root->getID());
+
+  // ... and loading it pulls the transitive closure into the local CAS.
+  Optional<ObjectProxy> Loaded;
+  ASSERT_THAT_ERROR((*CAS)->getProxy(*Ref).moveInto(Loaded), Succeeded());
+  EXPECT_EQ(Loaded->getData(), "root");
+  ASSERT_EQ(Loaded->getNumReferences(), 1u);
+  EXPECT_EQ(Loaded->getReferenceID(0), Child->getID());
+  EXPECT_TRUE(Local->getReference(Root->getID()));
+  EXPECT_TRUE(Local->getReference(Child->getID()));
+
+  // The child loads too, now served locally.
+  Optional<ObjectProxy> LoadedChild;
+  ASSERT_THAT_ERROR(
+      (*CAS)->getProxy(Loaded->getReference(0)).moveInto(LoadedChild),
+      Succeeded());
+  EXPECT_EQ(LoadedChild->getData(), "child");
+}
+
+TEST(WriteThroughCASTest, MissingObject) {
+  std::shared_ptr<ObjectStore> Local = createInMemoryCAS();
+  std::shared_ptr<ObjectStore> Upstream = createInMemoryCAS();
+  Optional<std::unique_ptr<ObjectStore>> CAS;
+  ASSERT_THAT_ERROR(createWriteThroughCAS(Local, Upstream).moveInto(CAS),
+                    Succeeded());
+
+  // An object in neither layer has no reference.
+  std::unique_ptr<ObjectStore> OtherCAS = createInMemoryCAS();
+  Optional<ObjectProxy> Other;
+  ASSERT_THAT_ERROR(OtherCAS->createProxy(None, "missing").moveInto(Other),
+                    Succeeded());
+  EXPECT_FALSE((*CAS)->getReference(Other->getID()));
+}
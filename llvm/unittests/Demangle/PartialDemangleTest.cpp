@@ -85,6 +85,34 @@ TEST(PartialDemanglerTest, TestNameChopping) {
   std::free(Buf);
 }
 
+TEST(PartialDemanglerTest, TestNameChoppingWithoutParams) {
+  size_t Size = 1;
+  char *Buf = static_cast<char *>(std::malloc(Size));
+
+  llvm::ItaniumPartialDemangler D;
+
+  // Without parsing the signature, the name queries still give the same
+  // answers, while the parameter and return type queries come back empty.
+  for (ChoppedName &N : NamesToTest) {
+    EXPECT_FALSE(D.partialDemangle(N.Mangled, /*ParseParams=*/false));
+    EXPECT_TRUE(D.isFunction());
+
+    Buf = D.getFunctionDeclContextName(Buf, &Size);
+    EXPECT_STREQ(Buf, N.ContextName);
+
+    Buf = D.getFunctionBaseName(Buf, &Size);
+    EXPECT_STREQ(Buf, N.BaseName);
+
+    Buf = D.getFunctionReturnType(Buf, &Size);
+    EXPECT_STREQ(Buf, "");
+
+    Buf = D.getFunctionParameters(Buf, &Size);
+    EXPECT_STREQ(Buf, "()");
+  }
+
+  std::free(Buf);
+}
+
 TEST(PartialDemanglerTest, TestNameMeta) {
   llvm::ItaniumPartialDemangler Demangler;
 
@@ -59,6 +59,36 @@ TEST_F(CoreAPIsStandardTest, BasicSuccessfulLookup) {
   EXPECT_TRUE(OnCompletionRun) << "Should have been marked ready";
 }
 
+TEST_F(CoreAPIsStandardTest, BasicSuccessfulLookupAsync) {
+  std::unique_ptr<MaterializationResponsibility> FooMR;
+
+  cantFail(JD.define(std::make_unique<SimpleMaterializationUnit>(
+      SymbolFlagsMap({{Foo, FooSym.getFlags()}}),
+      [&](std::unique_ptr<MaterializationResponsibility> R) {
+        FooMR = std::move(R);
+      })));
+
+  auto ResultF =
+      ES.lookupAsync(makeJITDylibSearchOrder(&JD), SymbolLookupSet(Foo));
+
+  EXPECT_EQ(ResultF.wait_for(std::chrono::seconds(0)),
+            std::future_status::timeout)
+      << "Future should not be ready until Foo is emitted";
+
+  cantFail(FooMR->notifyResolved({{Foo, FooSym}}));
+  cantFail(FooMR->notifyEmitted());
+
+  EXPECT_EQ(ResultF.wait_for(std::chrono::seconds(0)),
+            std::future_status::ready)
+      << "Future should be ready once Foo is emitted";
+
+  auto Result = cantFail(ResultF.get());
+  auto I = Result.find(Foo);
+  EXPECT_NE(I, Result.end()) << "Could not find symbol definition";
+  EXPECT_EQ(I->second.getAddress(), FooAddr)
+      << "Resolution returned incorrect result";
+}
+
 TEST_F(CoreAPIsStandardTest, EmptyLookup) {
   bool OnCompletionRun = false;
 
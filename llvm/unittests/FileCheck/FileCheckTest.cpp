@@ -1365,6 +1365,58 @@ TEST_F(FileCheckTest, ParsePattern) {
   EXPECT_TRUE(Tester.parsePattern("[[@LINE+0x3]]"));
 }
 
+TEST_F(FileCheckTest, FixedStringIndex) {
+  SourceMgr SM;
+  FileCheckRequest Req;
+  FileCheckPatternContext Context;
+
+  // Enough fixed string patterns to reach the indexing threshold. The string
+  // literals outlive the index since each pattern's fixed string points into
+  // the parsed text.
+  static const char *const Strs[] = {"foo", "oba", "bar", "f00", "f01", "f02",
+                                     "f03", "f04", "f05", "f06", "f07", "f08",
+                                     "f09", "f10", "f11", "f12"};
+  std::vector<FileCheckString> CheckStrings;
+  for (const char *Str : Strs) {
+    Pattern Pat(Check::CheckPlain, &Context, 1);
+    ASSERT_FALSE(Pat.parsePattern(Str, "CHECK", SM, Req));
+    ASSERT_EQ(Pat.getFixedStr(), Str);
+    CheckStrings.emplace_back(Pat, "CHECK", SMLoc());
+  }
+
+  StringRef Input = "xx foo yy foobar end";
+  std::unique_ptr<FixedStringIndex> Index =
+      FixedStringIndex::build(CheckStrings, Input);
+  ASSERT_TRUE(Index);
+
+  size_t Pos;
+  // First occurrences from the start of the input.
+  EXPECT_TRUE(Index->findFirst("foo", Input, Pos));
+  EXPECT_EQ(Pos, 3u);
+  // Overlapping matches inside "foobar" must all be found.
+  EXPECT_TRUE(Index->findFirst("oba", Input, Pos));
+  EXPECT_EQ(Pos, 12u);
+  EXPECT_TRUE(Index->findFirst("bar", Input, Pos));
+  EXPECT_EQ(Pos, 13u);
+  // Lookups are relative to the given window into the input.
+  EXPECT_TRUE(Index->findFirst("foo", Input.substr(4), Pos));
+  EXPECT_EQ(Pos, 6u);
+  // A match must lie entirely within the window.
+  EXPECT_TRUE(Index->findFirst("bar", Input.substr(0, 15), Pos));
+  EXPECT_EQ(Pos, StringRef::npos);
+  EXPECT_TRUE(Index->findFirst("foo", Input.substr(11), Pos));
+  EXPECT_EQ(Pos, StringRef::npos);
+  // Patterns absent from the input are covered but have no occurrence.
+  EXPECT_TRUE(Index->findFirst("f00", Input, Pos));
+  EXPECT_EQ(Pos, StringRef::npos);
+  // Strings that are not part of any pattern are not covered by the index.
+  EXPECT_FALSE(Index->findFirst("yy", Input, Pos));
+
+  // Below the threshold no index is built.
+  CheckStrings.erase(CheckStrings.begin() + 2, CheckStrings.end());
+  EXPECT_FALSE(FixedStringIndex::build(CheckStrings, Input));
+}
+
 TEST_F(FileCheckTest, Match) {
   PatternTester Tester;
 
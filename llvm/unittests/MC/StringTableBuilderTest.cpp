@@ -11,6 +11,7 @@
 #include "llvm/Support/Endian.h"
 #include "gtest/gtest.h"
 #include <string>
+#include <vector>
 
 using namespace llvm;
 
@@ -236,4 +237,41 @@ TEST(StringTableBuilderTest, MachO64LinkedInOrder) {
   EXPECT_EQ(6U, B.getOffset("ba"));
   EXPECT_EQ(9U, B.getOffset("f"));
 }
+
+TEST(StringTableBuilderTest, ELFLargeParallel) {
+  // Large tables take the sharded, parallel sort and suffix-merge path.
+  StringTableBuilder B(StringTableBuilder::ELF);
+
+  std::vector<std::string> Storage;
+  std::vector<CachedHashStringRef> Shard;
+  for (int I = 0; I < 5000; ++I) {
+    Storage.push_back("prefix" + std::to_string(I) + "suffix" +
+                      std::to_string(I % 7));
+    // Half of the strings are proper suffixes of the other half.
+    Storage.push_back(Storage.back().substr(6));
+  }
+  for (const std::string &S : Storage)
+    Shard.push_back(CachedHashStringRef(S));
+  B.add(Shard);
+  B.add("");
+
+  B.finalize();
+
+  SmallString<0> Data;
+  Data.resize(B.getSize());
+  B.write((uint8_t *)Data.data());
+
+  // Every string must appear null-terminated at its reported offset, and the
+  // suffix halves must have been merged into their superstrings.
+  EXPECT_EQ(0U, B.getOffset(""));
+  size_t MergedBudget = 0;
+  for (const std::string &S : Storage) {
+    size_t Offset = B.getOffset(S);
+    ASSERT_LE(Offset + S.size() + 1, Data.size());
+    EXPECT_EQ(StringRef(Data.data() + Offset, S.size()), S);
+    EXPECT_EQ(Data[Offset + S.size()], '\x00');
+    MergedBudget += S.size() + 1;
+  }
+  EXPECT_LT(B.getSize(), MergedBudget);
+}
 }
@@ -36,6 +36,33 @@ TEST(ObjectYAML, BinaryRef) {
   EXPECT_NE(OS.str().find("''"), StringRef::npos);
 }
 
+TEST(ObjectYAML, BinaryRefHexConversion) {
+  // Cover sizes below, at, and above the internal chunking and parallel
+  // conversion thresholds.
+  for (size_t Size : {size_t(1), size_t(4095), size_t(4096), size_t(4101),
+                      size_t((1 << 20) + 3)}) {
+    std::vector<uint8_t> Bytes(Size);
+    for (size_t I = 0; I < Size; ++I)
+      Bytes[I] = static_cast<uint8_t>(I * 7 + 13);
+
+    std::string Hex;
+    {
+      raw_string_ostream OS(Hex);
+      yaml::BinaryRef(Bytes).writeAsHex(OS);
+    }
+    EXPECT_EQ(Hex.size(), 2 * Size);
+
+    std::string Binary;
+    {
+      raw_string_ostream OS(Binary);
+      yaml::BinaryRef(Hex).writeAsBinary(OS);
+    }
+    ASSERT_EQ(Binary.size(), Size);
+    EXPECT_TRUE(std::equal(Bytes.begin(), Bytes.end(),
+                           reinterpret_cast<const uint8_t *>(Binary.data())));
+  }
+}
+
 TEST(ObjectYAML, UnknownOption) {
   StringRef InputYAML = "InvalidKey: InvalidValue\n"
                         "Binary: AAAA\n";
@@ -16,6 +16,7 @@
 #include "llvm/Config/config.h"
 #include "llvm/Support/Error.h"
 #include "gtest/gtest.h"
+#include <string>
 
 using namespace llvm;
 using namespace llvm::compression;
@@ -110,5 +111,41 @@ TEST(CompressionTest, Zstd) {
   testZstdCompression(BinaryDataStr, zstd::BestSpeedCompression);
   testZstdCompression(BinaryDataStr, zstd::DefaultCompression);
 }
+
+TEST(CompressionTest, ZstdDictionary) {
+  // Train a dictionary on a corpus of small, similar samples, then round-trip
+  // a fresh input against it.
+  SmallVector<uint8_t, 0> SampleData;
+  SmallVector<size_t, 0> SampleSizes;
+  for (int I = 0; I < 128; ++I) {
+    std::string Sample = "the quick brown fox jumps over the lazy dog " +
+                         std::to_string(I) + " times";
+    SampleData.append(Sample.begin(), Sample.end());
+    SampleSizes.push_back(Sample.size());
+  }
+
+  SmallVector<uint8_t, 0> DictData;
+  Error E = zstd::trainDictionary(SampleData, SampleSizes, 4096, DictData);
+  EXPECT_FALSE(std::move(E));
+  EXPECT_FALSE(DictData.empty());
+
+  zstd::Dictionary Dict(DictData);
+  EXPECT_EQ(toStringRef(DictData), toStringRef(Dict.data()));
+
+  StringRef Input = "the quick brown fox jumps over the lazy dog 999 times";
+  SmallVector<uint8_t, 0> Compressed;
+  SmallVector<uint8_t, 0> Uncompressed;
+  zstd::compress(arrayRefFromStringRef(Input), Compressed, Dict);
+
+  E = zstd::uncompress(Compressed, Uncompressed, Input.size(), Dict);
+  EXPECT_FALSE(std::move(E));
+  EXPECT_EQ(Input, toStringRef(Uncompressed));
+
+  // Decompressing against no dictionary must fail rather than produce
+  // garbage.
+  E = zstd::uncompress(Compressed, Uncompressed, Input.size());
+  EXPECT_TRUE((bool)E);
+  consumeError(std::move(E));
+}
 #endif
 }
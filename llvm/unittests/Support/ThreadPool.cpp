@@ -198,6 +198,48 @@ TEST_F(ThreadPoolTest, GetFutureWithResultAndArgs) {
   ASSERT_EQ(2, F2.get());
 }
 
+TEST_F(ThreadPoolTest, WorkStealing) {
+  CHECK_UNSUPPORTED();
+  // Run many small tasks through the work-stealing mode, including tasks
+  // submitted from worker threads (which push onto their own deque, so other
+  // workers have to steal them).
+  ThreadPool Pool(work_stealing_concurrency(4));
+  std::atomic_int checked_in{0};
+  for (size_t i = 0; i < 1000; ++i)
+    Pool.async([&checked_in] { ++checked_in; });
+  for (size_t i = 0; i < 10; ++i)
+    Pool.async([&Pool, &checked_in] {
+      for (size_t j = 0; j < 10; ++j)
+        Pool.async([&checked_in] { ++checked_in; });
+    });
+  Pool.wait();
+  ASSERT_EQ(1100, checked_in);
+}
+
+TEST_F(ThreadPoolTest, WorkStealingGroups) {
+  CHECK_UNSUPPORTED();
+  ThreadPoolStrategy S = work_stealing_concurrency(2);
+  if (S.compute_thread_count() < 2)
+    GTEST_SKIP();
+  ThreadPool Pool(S);
+  // Check waiting for a group, including from inside a task of another group.
+  ThreadPoolTaskGroup Group1(Pool);
+  ThreadPoolTaskGroup Group2(Pool);
+  std::atomic_int count1{0};
+  std::atomic_int count2{0};
+  for (size_t i = 0; i < 100; ++i)
+    Group1.async([&count1] { ++count1; });
+  Group2.async([&] {
+    Group1.wait();
+    ASSERT_EQ(100, count1);
+    ++count2;
+  });
+  Group2.wait();
+  ASSERT_EQ(1, count2);
+  Group1.wait();
+  ASSERT_EQ(100, count1);
+}
+
 TEST_F(ThreadPoolTest, PoolDestruction) {
   CHECK_UNSUPPORTED();
   // Test that we are waiting on destruction
@@ -934,6 +934,40 @@ TEST(ProxyFileSystemTest, Basic) {
   EXPECT_FALSE(Local);
 }
 
+TEST(StatCachingFileSystemTest, Basic) {
+  struct CountingFileSystem : public DummyFileSystem {
+    unsigned StatusCalls = 0;
+    ErrorOr<vfs::Status> status(const Twine &Path) override {
+      ++StatusCalls;
+      return DummyFileSystem::status(Path);
+    }
+  };
+  IntrusiveRefCntPtr<CountingFileSystem> Counting(new CountingFileSystem());
+  Counting->addRegularFile("/a");
+  IntrusiveRefCntPtr<vfs::FileSystem> FS =
+      vfs::createStatCachingFileSystem(Counting);
+
+  auto Stat = FS->status("/a");
+  ASSERT_FALSE(Stat.getError());
+  EXPECT_EQ(1u, Counting->StatusCalls);
+
+  // A repeated query is served from the cache.
+  auto Stat2 = FS->status("/a");
+  ASSERT_FALSE(Stat2.getError());
+  EXPECT_EQ(Stat->getUniqueID(), Stat2->getUniqueID());
+  EXPECT_EQ(1u, Counting->StatusCalls);
+
+  // Failed queries are cached too.
+  EXPECT_EQ(errc::no_such_file_or_directory, FS->status("/b").getError());
+  EXPECT_EQ(errc::no_such_file_or_directory, FS->status("/b").getError());
+  EXPECT_EQ(2u, Counting->StatusCalls);
+
+  // Entries are never invalidated, even if the underlying file appears.
+  Counting->addRegularFile("/b");
+  EXPECT_EQ(errc::no_such_file_or_directory, FS->status("/b").getError());
+  EXPECT_EQ(2u, Counting->StatusCalls);
+}
+
 class InMemoryFileSystemTest : public ::testing::Test {
 protected:
   llvm::vfs::InMemoryFileSystem FS;
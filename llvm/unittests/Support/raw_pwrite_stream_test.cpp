@@ -10,6 +10,7 @@
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
 
@@ -80,6 +81,42 @@ TEST(raw_pwrite_ostreamTest, TestFD) {
 #endif
 }
 
+TEST(raw_pwrite_ostreamTest, TestFlipFD) {
+  SmallString<64> Path;
+  int FD;
+  ASSERT_NO_ERROR(sys::fs::createTemporaryFile("foo", "bar", FD, Path));
+  FileRemover Cleanup(Path);
+
+  // Enough data to force several buffer handoffs to the background flusher.
+  std::string Chunk(4096 + 123, 'x');
+  for (size_t I = 0, E = Chunk.size(); I != E; ++I)
+    Chunk[I] = char(I * 7 + 13);
+
+  size_t Total = 0;
+  {
+    raw_fd_flip_ostream OS(FD, true);
+    for (unsigned I = 0; I != 1024; ++I) {
+      OS.write(Chunk.data(), Chunk.size());
+      Total += Chunk.size();
+    }
+    StringRef Test = "test";
+    OS.pwrite(Test.data(), Test.size(), 0);
+    // More sequential output after the positioned write.
+    OS.write(Chunk.data(), Chunk.size());
+    Total += Chunk.size();
+    OS.close();
+    ASSERT_FALSE(OS.has_error());
+  }
+
+  auto BufferOrErr = MemoryBuffer::getFile(Path);
+  ASSERT_NO_ERROR(BufferOrErr.getError());
+  StringRef Data = (*BufferOrErr)->getBuffer();
+  ASSERT_EQ(Total, Data.size());
+  EXPECT_TRUE(Data.startswith("test"));
+  for (size_t I = 4, E = Data.size(); I != E; ++I)
+    ASSERT_EQ(Chunk[I % Chunk.size()], Data[I]);
+}
+
 #ifdef LLVM_ON_UNIX
 TEST(raw_pwrite_ostreamTest, TestDevNull) {
   int FD;
@@ -23,6 +23,7 @@
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TypeSize.h"
 #include "llvm/TableGen/Error.h"
 #include "llvm/TableGen/Record.h"
@@ -4739,28 +4740,35 @@ void CodeGenDAGPatterns::GenerateVariants() {
   // intentionally do not reconsider these.  Any variants of added patterns have
   // already been added.
   //
-  for (unsigned i = 0, e = PatternsToMatch.size(); i != e; ++i) {
-    MultipleUseVarSet DepVars;
-    std::vector<TreePatternNodePtr> Variants;
-    FindDepVars(PatternsToMatch[i].getSrcPattern(), DepVars);
+  // Expanding the variants of one pattern only reads that pattern and the
+  // target info, so the expansion runs in parallel.  The scan for existing
+  // isomorphic patterns and the UID assignment below stay sequential so that
+  // the resulting PatternsToMatch list is identical to a serial run.
+  std::vector<MultipleUseVarSet> DepVars(PatternsToMatch.size());
+  std::vector<std::vector<TreePatternNodePtr>> Variants(PatternsToMatch.size());
+  parallelFor(0, PatternsToMatch.size(), [&](size_t i) {
+    FindDepVars(PatternsToMatch[i].getSrcPattern(), DepVars[i]);
+    GenerateVariantsOf(PatternsToMatch[i].getSrcPatternShared(), Variants[i],
+                       *this, DepVars[i]);
+  });
+
+  for (unsigned i = 0, e = Variants.size(); i != e; ++i) {
     LLVM_DEBUG(errs() << "Dependent/multiply used variables: ");
-    LLVM_DEBUG(DumpDepVars(DepVars));
+    LLVM_DEBUG(DumpDepVars(DepVars[i]));
     LLVM_DEBUG(errs() << "\n");
-    GenerateVariantsOf(PatternsToMatch[i].getSrcPatternShared(), Variants,
-                       *this, DepVars);
 
     assert(PatternsToMatch[i].getHwModeFeatures().empty() &&
            "HwModes should not have been expanded yet!");
 
-    assert(!Variants.empty() && "Must create at least original variant!");
-    if (Variants.size() == 1) // No additional variants for this pattern.
+    assert(!Variants[i].empty() && "Must create at least original variant!");
+    if (Variants[i].size() == 1) // No additional variants for this pattern.
       continue;
 
     LLVM_DEBUG(errs() << "FOUND VARIANTS OF: ";
                PatternsToMatch[i].getSrcPattern()->dump(); errs() << "\n");
 
-    for (unsigned v = 0, e = Variants.size(); v != e; ++v) {
-      TreePatternNodePtr Variant = Variants[v];
+    for (unsigned v = 0, e = Variants[i].size(); v != e; ++v) {
+      TreePatternNodePtr Variant = Variants[i][v];
 
       LLVM_DEBUG(errs() << "  VAR#" << v << ": "; Variant->dump();
                  errs() << "\n");
@@ -4774,7 +4782,7 @@ void CodeGenDAGPatterns::GenerateVariants() {
           continue;
         // Check to see if this variant already exists.
         if (Variant->isIsomorphicTo(PatternsToMatch[p].getSrcPattern(),
-                                    DepVars)) {
+                                    DepVars[i])) {
           LLVM_DEBUG(errs() << "  *** ALREADY EXISTS, ignoring variant.\n");
           AlreadyExists = true;
           break;
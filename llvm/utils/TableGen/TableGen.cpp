@@ -288,7 +288,7 @@ int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
   cl::ParseCommandLineOptions(argc, argv);
 
-  return TableGenMain(argv[0], &LLVMTableGenMain);
+  return TableGenMain(argc, argv, &LLVMTableGenMain);
 }
 
 #ifndef __has_feature
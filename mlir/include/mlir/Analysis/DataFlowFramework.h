@@ -20,6 +20,7 @@
 #include "mlir/Support/StorageUniquer.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Support/TypeName.h"
+#include <mutex>
 #include <queue>
 
 namespace mlir {
@@ -194,6 +195,23 @@ class DataFlowAnalysis;
 /// TODO: Optimize the internal implementation of the solver.
 class DataFlowSolver {
 public:
+  /// Create a solver. When `enableRegionSharding` is set, the fixed-point
+  /// iteration partitions the worklist by the nearest `IsolatedFromAbove`
+  /// ancestor of each program point and processes the partitions in parallel,
+  /// with the same thread pool the pass manager uses. Work items whose program
+  /// point does not belong to an isolated region (e.g. generic program points
+  /// or the isolated operations themselves) form a synchronized frontier that
+  /// is processed serially between parallel rounds, as are items that cross
+  /// from one region into another.
+  ///
+  /// Sharding is only sound for analyses whose transfer functions write
+  /// exclusively to states attached to points within the same isolated region
+  /// as the visited point; cross-region information must flow through states
+  /// attached to frontier points. The loaded analyses must be monotonic, so
+  /// the fixpoint is independent of the (non-deterministic) visitation order.
+  explicit DataFlowSolver(bool enableRegionSharding = false)
+      : enableRegionSharding(enableRegionSharding) {}
+
   /// Load an analysis into the solver. Return the analysis instance.
   template <typename AnalysisT, typename... Args>
   AnalysisT *load(Args &&...args);
@@ -223,8 +241,10 @@ public:
   /// Each item is processed by invoking the child analysis at the program
   /// point.
   using WorkItem = std::pair<ProgramPoint, DataFlowAnalysis *>;
-  /// Push a work item onto the worklist.
-  void enqueue(WorkItem item) { worklist.push(std::move(item)); }
+  /// Push a work item onto the worklist. During a sharded parallel round, the
+  /// item is routed to the local shard when it belongs to the region being
+  /// processed, and to the synchronized cross-region frontier otherwise.
+  void enqueue(WorkItem item);
 
   /// Get the state associated with the given program point. If it does not
   /// exist, create an uninitialized state.
@@ -242,11 +262,32 @@ public:
                      ProgramPoint point);
 
 private:
+  /// Run the fixed-point iteration with the worklist sharded per isolated
+  /// region.
+  LogicalResult runSharded(Operation *top);
+
   /// The solver's work queue. Work items can be inserted to the front of the
   /// queue to be processed greedily, speeding up computations that otherwise
   /// quickly degenerate to quadratic due to propagation of state updates.
   std::queue<WorkItem> worklist;
 
+  /// Whether to shard the worklist per isolated region and run the shards in
+  /// parallel.
+  bool enableRegionSharding;
+
+  /// Work items produced during a parallel round that target a point outside
+  /// the producing shard. They are folded back into the main worklist between
+  /// rounds.
+  std::vector<WorkItem> crossRegionFrontier;
+
+  /// Guards the cross-region frontier during parallel rounds.
+  std::mutex frontierMutex;
+
+  /// Guards the analysis state map and dependency lists during parallel
+  /// rounds. Uncontended in serial execution, where it is only taken when
+  /// region sharding is enabled.
+  std::mutex stateMutex;
+
   /// Type-erased instances of the children analyses.
   SmallVector<std::unique_ptr<DataFlowAnalysis>> childAnalyses;
 
@@ -442,6 +483,11 @@ AnalysisT *DataFlowSolver::load(Args &&...args) {
 
 template <typename StateT, typename PointT>
 StateT *DataFlowSolver::getOrCreateState(PointT point) {
+  // Shards create states for points of other regions, e.g. when reading a
+  // state across a call edge, so the map itself must be synchronized.
+  std::unique_lock<std::mutex> lock(stateMutex, std::defer_lock);
+  if (enableRegionSharding)
+    lock.lock();
   std::unique_ptr<AnalysisState> &state =
       analysisStates[{ProgramPoint(point), TypeID::get<StateT>()}];
   if (!state) {
@@ -15,9 +15,11 @@
 
 #include "mlir/IR/AsmState.h"
 #include "mlir/Support/LLVM.h"
+#include <memory>
 
 namespace llvm {
 class MemoryBufferRef;
+class SourceMgr;
 } // namespace llvm
 
 namespace mlir {
@@ -29,6 +31,63 @@ bool isBytecode(llvm::MemoryBufferRef buffer);
 /// bytecode, into the provided block.
 LogicalResult readBytecodeFile(llvm::MemoryBufferRef buffer, Block *block,
                                const ParserConfig &config);
+/// An overload with a source manager whose main file contains MLIR bytecode.
+/// Ownership of the source manager is shared with the parsed IR: resource
+/// blobs whose alignment is satisfied in place reference the buffer directly
+/// instead of being copied out of it, and keep the source manager (and thus a
+/// potentially mmap'd file) alive for as long as they live. Such blobs are
+/// immutable; consumers that want to mutate the data must take a copy.
+LogicalResult
+readBytecodeFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                 Block *block, const ParserConfig &config);
+
+/// A stateful bytecode reader that supports lazily materializing the regions
+/// of isolated-from-above operations (e.g. functions). This makes it possible
+/// to load very large bytecode modules and only pay the deserialization cost
+/// for the operations that are actually inspected.
+class BytecodeReader {
+public:
+  /// Create a reader for the given bytecode buffer. If `lazyLoading` is true,
+  /// the regions of isolated-from-above operations are left empty when
+  /// reading and recorded for later materialization; the buffer and the
+  /// reader must outlive every operation read through it. Lazy loading
+  /// requires a bytecode file of version `kLazyLoadableRegionsVersion` or
+  /// newer; older files are silently read eagerly. While operations are
+  /// pending, verification is deferred: each lazily loaded subtree is
+  /// verified once it (and everything nested under it) is materialized.
+  /// `bufferOwnerRef`, if provided, shares ownership of the buffer with the
+  /// parsed IR and enables zero-copy resource blobs as described on
+  /// `readBytecodeFile` above.
+  BytecodeReader(llvm::MemoryBufferRef buffer, const ParserConfig &config,
+                 bool lazyLoading,
+                 const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef = {});
+  ~BytecodeReader();
+
+  /// Read the top-level operations of the bytecode buffer into the provided
+  /// block.
+  LogicalResult readTopLevel(Block *block);
+
+  /// Return whether the provided operation has regions that were skipped
+  /// during reading and can be materialized.
+  bool isMaterializable(Operation *op) const;
+
+  /// Materialize the regions of the provided operation. The operation must be
+  /// materializable.
+  LogicalResult materialize(Operation *op);
+
+  /// Materialize the regions of every operation that is still pending,
+  /// including operations discovered while materializing.
+  LogicalResult materializeAll();
+
+  /// Return the number of operations whose regions are still pending
+  /// materialization.
+  int64_t getNumOpsToMaterialize() const;
+
+  class Impl;
+
+private:
+  std::unique_ptr<Impl> impl;
+};
 } // namespace mlir
 
 #endif // MLIR_BYTECODE_BYTECODEREADER_H
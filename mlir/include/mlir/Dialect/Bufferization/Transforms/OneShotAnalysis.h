@@ -10,7 +10,7 @@
 #define MLIR_DIALECT_BUFFERIZATION_TRANSFORMS_ONESHOTANALYSIS_H
 
 #include "mlir/Dialect/Bufferization/IR/BufferizableOpInterface.h"
-#include "llvm/ADT/EquivalenceClasses.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace mlir {
 namespace bufferization {
@@ -19,6 +19,12 @@ struct OneShotBufferizationOptions;
 class BufferizationAliasInfo;
 class OneShotAnalysisState;
 
+/// Statistics gathered by One-Shot Bufferize, for display as pass statistics.
+struct BufferizationStatistics {
+  /// Wall time spent in the bufferization analysis, in milliseconds.
+  int64_t analysisTimeMs = 0;
+};
+
 /// Options for analysis-enabled bufferization.
 struct OneShotBufferizationOptions : public BufferizationOptions {
   OneShotBufferizationOptions() = default;
@@ -87,19 +93,85 @@ public:
   bool isInPlace(OpOperand &opOperand) const;
 
 private:
-  /// llvm::EquivalenceClasses wants comparable elements. This comparator uses
-  /// uses pointer comparison on the defining op. This is a poor man's
-  /// comparison but it's not like UnionFind needs ordering anyway.
-  struct ValueComparator {
-    bool operator()(const Value &lhs, const Value &rhs) const {
-      return lhs.getImpl() < rhs.getImpl();
+  /// A union-find over SSA values. Values are interned into a flat index
+  /// space on insertion; the per-value state lives in plain vectors indexed
+  /// by these ids, so unions and queries do not allocate per-element nodes.
+  /// Each class additionally threads its members on a circular singly-linked
+  /// list, making member enumeration linear in the class size and list
+  /// splicing during unions O(1).
+  class ValueUnionFind {
+  public:
+    /// Insert `v` as a singleton class. No-op if `v` is already present.
+    void insert(Value v) { (void)getOrInsert(v); }
+
+    /// Return true if `v1` and `v2` are in the same class.
+    bool isEquivalent(Value v1, Value v2) const {
+      return findLeader(lookup(v1)) == findLeader(lookup(v2));
+    }
+
+    /// Union the classes of `v1` and `v2`, inserting them if needed.
+    void unionSets(Value v1, Value v2) {
+      unsigned r1 = findLeader(getOrInsert(v1));
+      unsigned r2 = findLeader(getOrInsert(v2));
+      if (r1 == r2)
+        return;
+      // Union by rank.
+      if (rank[r1] < rank[r2])
+        std::swap(r1, r2);
+      else if (rank[r1] == rank[r2])
+        ++rank[r1];
+      parent[r2] = r1;
+      // Splice the circular member lists of the two classes.
+      std::swap(next[r1], next[r2]);
+    }
+
+    /// Apply `fun` to every member of the class of `v`, including `v`.
+    void applyOnClass(Value v, function_ref<void(Value)> fun) const {
+      unsigned start = lookup(v);
+      unsigned id = start;
+      do {
+        fun(values[id]);
+        id = next[id];
+      } while (id != start);
     }
-  };
 
-  using EquivalenceClassRangeType = llvm::iterator_range<
-      llvm::EquivalenceClasses<Value, ValueComparator>::member_iterator>;
-  /// Check that aliasInfo for `v` exists and return a reference to it.
-  EquivalenceClassRangeType getAliases(Value v) const;
+  private:
+    /// Return the id of `v`, interning `v` if it has none yet.
+    unsigned getOrInsert(Value v) {
+      unsigned id = values.size();
+      auto inserted = ids.try_emplace(v, id);
+      if (!inserted.second)
+        return inserted.first->second;
+      values.push_back(v);
+      parent.push_back(id);
+      rank.push_back(0);
+      next.push_back(id);
+      return id;
+    }
+
+    /// Return the id of `v`, which must have been inserted.
+    unsigned lookup(Value v) const {
+      auto it = ids.find(v);
+      assert(it != ids.end() && "value has no alias info entry");
+      return it->second;
+    }
+
+    /// Return the class representative of `id`, compressing the path by
+    /// halving along the way.
+    unsigned findLeader(unsigned id) const {
+      while (parent[id] != id) {
+        parent[id] = parent[parent[id]];
+        id = parent[id];
+      }
+      return id;
+    }
+
+    DenseMap<Value, unsigned> ids;
+    SmallVector<Value, 0> values;
+    mutable SmallVector<unsigned, 0> parent;
+    SmallVector<unsigned, 0> rank;
+    SmallVector<unsigned, 0> next;
+  };
 
   /// Set of all OpResults that were decided to bufferize in-place.
   llvm::DenseSet<OpOperand *> inplaceBufferized;
@@ -109,7 +181,7 @@ private:
   /// value may alias with one of multiple other values. The concrete aliasing
   /// value may not even be known at compile time. All such values are
   /// considered to be aliases.
-  llvm::EquivalenceClasses<Value, ValueComparator> aliasInfo;
+  ValueUnionFind aliasInfo;
 
   /// Auxiliary structure to store all the equivalent buffer classes. Equivalent
   /// buffer information is "must be" conservative: Only if two values are
@@ -117,7 +189,7 @@ private:
   /// possible that, in the presence of branches, it cannot be determined
   /// statically if two values are equivalent. In that case, the values are
   /// considered to be not equivalent.
-  llvm::EquivalenceClasses<Value, ValueComparator> equivalentInfo;
+  ValueUnionFind equivalentInfo;
 };
 
 /// State for analysis-enabled bufferization. This class keeps track of alias
@@ -185,7 +257,8 @@ LogicalResult analyzeOp(Operation *op, OneShotAnalysisState &state);
 
 /// Run One-Shot Bufferize on the given op: Analysis + Bufferization
 LogicalResult runOneShotBufferize(Operation *op,
-                                  const OneShotBufferizationOptions &options);
+                                  const OneShotBufferizationOptions &options,
+                                  BufferizationStatistics *statistics = nullptr);
 
 } // namespace bufferization
 } // namespace mlir
@@ -16,6 +16,7 @@ class ModuleOp;
 
 namespace bufferization {
 class OneShotAnalysisState;
+struct BufferizationStatistics;
 struct OneShotBufferizationOptions;
 
 /// Analyze `moduleOp` and its nested ops. Bufferization decisions are stored in
@@ -36,7 +37,8 @@ LogicalResult bufferizeModuleOp(ModuleOp moduleOp,
 /// Bufferize.
 LogicalResult runOneShotModuleBufferize(
     ModuleOp moduleOp,
-    const bufferization::OneShotBufferizationOptions &options);
+    const bufferization::OneShotBufferizationOptions &options,
+    BufferizationStatistics *statistics = nullptr);
 
 } // namespace bufferization
 } // namespace mlir
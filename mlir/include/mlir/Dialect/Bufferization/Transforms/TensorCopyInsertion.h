@@ -14,10 +14,12 @@
 namespace mlir {
 namespace bufferization {
 class AnalysisState;
+struct BufferizationStatistics;
 struct OneShotBufferizationOptions;
 
 LogicalResult insertTensorCopies(Operation *op,
-                                 const OneShotBufferizationOptions &options);
+                                 const OneShotBufferizationOptions &options,
+                                 BufferizationStatistics *statistics = nullptr);
 
 LogicalResult insertTensorCopies(Operation *op, const AnalysisState &state);
 } // namespace bufferization
@@ -201,8 +201,19 @@ public:
   /// Returns true if the expensive checks are requested.
   bool getExpensiveChecksEnabled() const { return expensiveChecksEnabled; }
 
+  /// Provides a hint on the number of transform IR values expected to be live
+  /// simultaneously so that the state can preallocate its handle storage.
+  TransformOptions &setExpectedNumHandles(unsigned num) {
+    expectedNumHandles = num;
+    return *this;
+  }
+
+  /// Returns the expected number of simultaneously live handles.
+  unsigned getExpectedNumHandles() const { return expectedNumHandles; }
+
 private:
   bool expensiveChecksEnabled = true;
+  unsigned expectedNumHandles = 0;
 };
 
 /// The state maintained across applications of various ops implementing the
@@ -15,11 +15,53 @@
 #include "mlir/IR/OpImplementation.h"
 #include "mlir/IR/SymbolTable.h"
 #include "mlir/Interfaces/ControlFlowInterfaces.h"
+#include "mlir/Rewrite/FrozenRewritePatternSet.h"
+#include "llvm/ADT/StringMap.h"
 
 namespace mlir {
 namespace transform {
 enum class FailurePropagationMode : uint32_t;
 class FailurePropagationModeAttr;
+
+/// A transform script lowered into a directly applicable form. The list of
+/// top-level transform ops is recorded once and the PDL patterns nested under
+/// `transform.with_pdl_patterns` ops are compiled down to bytecode eagerly, so
+/// that repeated applications of the same script, e.g. by an autotuner trying
+/// many candidates, skip the per-application bookkeeping and pattern
+/// compilation. Compiling consumes the `pdl.pattern` ops. The region
+/// containing the transform ops must outlive the script and must not be
+/// modified while the script is in use. A script must not be applied from
+/// several threads at the same time.
+class PrecompiledTransformScript {
+public:
+  /// Lowers the transform ops directly contained in the single block of
+  /// `region` into a reusable script, compiling all nested PDL patterns.
+  static FailureOr<PrecompiledTransformScript> compile(Region &region);
+
+  /// Applies the script to the payload IR rooted at the given operation.
+  DiagnosedSilenceableFailure
+  apply(Operation *payloadRoot,
+        const TransformOptions &options = TransformOptions());
+
+private:
+  explicit PrecompiledTransformScript(Region &region) : region(&region) {}
+
+  /// The region holding the transform ops.
+  Region *region;
+
+  /// The top-level transform ops to apply, in order.
+  SmallVector<TransformOpInterface> transforms;
+
+  /// Upper bound on the number of simultaneously live transform IR values,
+  /// used to preallocate the state's handle storage.
+  unsigned numHandles = 0;
+
+  /// Compiled PDL patterns, keyed by the pattern container operation and then
+  /// by the pattern symbol name. Shared with the transform states created by
+  /// `apply`.
+  std::shared_ptr<DenseMap<Operation *, llvm::StringMap<FrozenRewritePatternSet>>>
+      compiledPatterns;
+};
 } // namespace transform
 } // namespace mlir
 
@@ -0,0 +1,69 @@
+//===- CASObjectCache.h - CAS-backed object cache for the JIT ---*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file provides a persistent, content-addressed object cache that can be
+// plugged into the MLIR execution engine to skip LLVM code generation on warm
+// starts.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef MLIR_EXECUTIONENGINE_CASOBJECTCACHE_H_
+#define MLIR_EXECUTIONENGINE_CASOBJECTCACHE_H_
+
+#include "mlir/Support/LLVM.h"
+#include "llvm/CAS/ActionCache.h"
+#include "llvm/CAS/ObjectStore.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/Error.h"
+
+#include <memory>
+#include <string>
+
+namespace mlir {
+
+/// An object cache backed by an LLVM content-addressable store. Compiled
+/// objects are stored as CAS blobs and associated, through an action cache,
+/// with a key derived from the module's bitcode (which covers the target
+/// triple and data layout) and a caller-provided configuration string that
+/// should capture everything else influencing the produced object, such as
+/// the code generation optimization level. With an on-disk store the cache
+/// is persistent and safe to share across processes: warm starts map the
+/// previously compiled object back in and skip LLVM codegen entirely.
+///
+/// Cache failures are not fatal; they merely degrade into a recompilation.
+class CASObjectCache : public llvm::ObjectCache {
+public:
+  CASObjectCache(std::shared_ptr<llvm::cas::ObjectStore> cas,
+                 std::shared_ptr<llvm::cas::ActionCache> actionCache,
+                 StringRef codeGenConfig = "")
+      : cas(std::move(cas)), actionCache(std::move(actionCache)),
+        codeGenConfig(codeGenConfig.str()) {}
+
+  /// Creates a cache over the on-disk CAS and action cache rooted at `path`,
+  /// or over the default on-disk instances for the current user when `path`
+  /// is empty.
+  static llvm::Expected<std::unique_ptr<CASObjectCache>>
+  createOnDisk(StringRef path = "", StringRef codeGenConfig = "");
+
+  void notifyObjectCompiled(const llvm::Module *m,
+                            llvm::MemoryBufferRef objBuffer) override;
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *m) override;
+
+private:
+  /// Computes the action cache key for `m` by ingesting its bitcode and the
+  /// configuration string into the CAS.
+  llvm::Expected<llvm::cas::CacheKey> computeKey(const llvm::Module *m);
+
+  std::shared_ptr<llvm::cas::ObjectStore> cas;
+  std::shared_ptr<llvm::cas::ActionCache> actionCache;
+  std::string codeGenConfig;
+};
+
+} // namespace mlir
+
+#endif // MLIR_EXECUTIONENGINE_CASOBJECTCACHE_H_
@@ -80,6 +80,13 @@ struct ExecutionEngineOptions {
   /// be dumped to a file via the `dumpToObjectfile` method.
   bool enableObjectCache = false;
 
+  /// If `objectCache` is provided, the JIT compiler consults it before code
+  /// generation and stores newly compiled objects into it, taking precedence
+  /// over the internal cache created for `enableObjectCache`. Pass a
+  /// persistent implementation such as `CASObjectCache` to reuse compiled
+  /// objects across processes. The cache must outlive the engine.
+  llvm::ObjectCache *objectCache = nullptr;
+
   /// If enable `enableGDBNotificationListener` is set, the JIT compiler will
   /// notify the llvm's global GDB notification listener.
   bool enableGDBNotificationListener = true;
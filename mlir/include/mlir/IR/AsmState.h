@@ -212,19 +212,23 @@ public:
 class UnmanagedAsmResourceBlob {
 public:
   /// Create a new unmanaged resource directly referencing the provided data.
-  /// `dataIsMutable` indicates if the allocated data can be mutated. By
-  /// default, we treat unmanaged blobs as immutable.
-  static AsmResourceBlob allocateWithAlign(ArrayRef<char> data, size_t align,
-                                           bool dataIsMutable = false) {
-    return AsmResourceBlob(data, align, /*deleter=*/{},
+  /// Unmanaged blobs are always immutable. An optional `deleter` may be
+  /// provided; it is not expected to free the data, but may release whatever
+  /// is keeping the referenced data alive, e.g. a shared reference to an
+  /// mmap'd file.
+  static AsmResourceBlob
+  allocateWithAlign(ArrayRef<char> data, size_t align,
+                    AsmResourceBlob::DeleterFn deleter = {}) {
+    return AsmResourceBlob(data, align, std::move(deleter),
                            /*dataIsMutable=*/false);
   }
   template <typename T>
-  static AsmResourceBlob allocateInferAlign(ArrayRef<T> data,
-                                            bool dataIsMutable = false) {
+  static AsmResourceBlob
+  allocateInferAlign(ArrayRef<T> data,
+                     AsmResourceBlob::DeleterFn deleter = {}) {
     return allocateWithAlign(
         ArrayRef<char>((const char *)data.data(), data.size() * sizeof(T)),
-        alignof(T));
+        alignof(T), std::move(deleter));
   }
 };
 
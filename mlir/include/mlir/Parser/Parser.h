@@ -17,6 +17,7 @@
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/OwningOpRef.h"
 #include <cstddef>
+#include <memory>
 
 namespace llvm {
 class SourceMgr;
@@ -83,6 +84,16 @@ LogicalResult parseSourceFile(const llvm::SourceMgr &sourceMgr, Block *block,
                               const ParserConfig &config,
                               LocationAttr *sourceFileLoc = nullptr);
 
+/// An overload with a shared source manager. Ownership of the source manager
+/// is shared with the parsed IR, which allows bytecode resource blobs to
+/// reference the input buffer directly instead of being copied out of it;
+/// such blobs keep the source manager (and thus a potentially mmap'd file)
+/// alive for as long as they live. Prefer this overload when loading large
+/// resource-heavy bytecode files.
+LogicalResult parseSourceFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                              Block *block, const ParserConfig &config,
+                              LocationAttr *sourceFileLoc = nullptr);
+
 /// This parses the file specified by the indicated filename and appends parsed
 /// operations to the given block. If the block is non-empty, the operations are
 /// placed before the current terminator. If parsing is successful, success is
@@ -147,6 +158,15 @@ parseSourceFile(const llvm::SourceMgr &sourceMgr, const ParserConfig &config) {
   return detail::parseSourceFile<ContainerOpT>(config, sourceMgr);
 }
 
+/// An overload with a shared source manager; see the non-templated overload
+/// above for the ownership implications.
+template <typename ContainerOpT>
+inline OwningOpRef<ContainerOpT>
+parseSourceFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                const ParserConfig &config) {
+  return detail::parseSourceFile<ContainerOpT>(config, sourceMgr);
+}
+
 /// This parses the file specified by the indicated filename. If the source IR
 /// contained a single instance of `ContainerOpT`, it is returned. Otherwise, a
 /// new instance of `ContainerOpT` is constructed containing all of the parsed
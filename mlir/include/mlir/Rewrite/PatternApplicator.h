@@ -66,10 +66,13 @@ public:
 private:
   /// The list that owns the patterns used within this applicator.
   const FrozenRewritePatternSet &frozenPatternList;
-  /// The set of patterns to match for each operation, stable sorted by benefit.
+  /// The set of patterns to match for each operation, stable sorted by
+  /// benefit. The operation agnostic patterns are fused into each list so that
+  /// a single lookup yields the full dispatch order for an operation.
   DenseMap<OperationName, SmallVector<const RewritePattern *, 2>> patterns;
   /// The set of patterns that may match against any operation type, stable
-  /// sorted by benefit.
+  /// sorted by benefit. Used directly for operations without any operation
+  /// specific patterns.
   SmallVector<const RewritePattern *, 1> anyOpPatterns;
   /// The mutable state used during execution of the PDL bytecode.
   std::unique_ptr<detail::PDLByteCodeMutableState> mutableByteCodeState;
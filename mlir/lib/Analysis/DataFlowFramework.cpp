@@ -7,6 +7,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Analysis/DataFlowFramework.h"
+#include "mlir/IR/OpDefinition.h"
+#include "mlir/IR/Threading.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/Support/Debug.h"
 
 #define DEBUG_TYPE "dataflow"
@@ -62,6 +65,55 @@ Location ProgramPoint::getLoc() const {
 // DataFlowSolver
 //===----------------------------------------------------------------------===//
 
+namespace {
+/// A per-region slice of the worklist. During a parallel round each shard is
+/// exhausted by a single thread.
+struct WorklistShard {
+  /// The isolated operation whose regions own the points of this shard.
+  Operation *root;
+  /// The shard-local work queue.
+  std::queue<DataFlowSolver::WorkItem> queue;
+};
+} // end anonymous namespace
+
+/// The shard being exhausted by the current thread, if any. Used to route
+/// items enqueued from within transfer functions during a parallel round.
+static thread_local WorklistShard *activeShard = nullptr;
+
+/// Return the nearest `IsolatedFromAbove` ancestor owning the given program
+/// point, or null for points that are not nested in an isolated region, such
+/// as generic program points and the top-level operation itself. Null-rooted
+/// points are processed serially.
+static Operation *getShardRoot(ProgramPoint point) {
+  auto rootFromBlock = [](Block *block) -> Operation * {
+    Operation *parent = block->getParentOp();
+    if (!parent || parent->hasTrait<OpTrait::IsIsolatedFromAbove>())
+      return parent;
+    return parent->getParentWithTrait<OpTrait::IsIsolatedFromAbove>();
+  };
+  if (auto *op = point.dyn_cast<Operation *>())
+    return op->getParentWithTrait<OpTrait::IsIsolatedFromAbove>();
+  if (auto *block = point.dyn_cast<Block *>())
+    return rootFromBlock(block);
+  if (auto value = point.dyn_cast<Value>())
+    if (Block *block = value.getParentBlock())
+      return rootFromBlock(block);
+  return nullptr;
+}
+
+void DataFlowSolver::enqueue(WorkItem item) {
+  if (WorklistShard *shard = activeShard) {
+    if (getShardRoot(item.first) == shard->root) {
+      shard->queue.push(std::move(item));
+      return;
+    }
+    std::lock_guard<std::mutex> lock(frontierMutex);
+    crossRegionFrontier.push_back(std::move(item));
+    return;
+  }
+  worklist.push(std::move(item));
+}
+
 LogicalResult DataFlowSolver::initializeAndRun(Operation *top) {
   // Initialize the analyses.
   for (DataFlowAnalysis &analysis : llvm::make_pointee_range(childAnalyses)) {
@@ -71,6 +123,9 @@ LogicalResult DataFlowSolver::initializeAndRun(Operation *top) {
       return failure();
   }
 
+  if (enableRegionSharding && top->getContext()->isMultithreadingEnabled())
+    return runSharded(top);
+
   // Run the analysis until fixpoint.
   do {
     // Exhaust the worklist.
@@ -91,14 +146,79 @@ LogicalResult DataFlowSolver::initializeAndRun(Operation *top) {
   return success();
 }
 
+LogicalResult DataFlowSolver::runSharded(Operation *top) {
+  MLIRContext *ctx = top->getContext();
+  while (!worklist.empty()) {
+    // Drain the queue, peeling region-local items off into per-region shards.
+    // Items without a shard root are the frontier through which cross-region
+    // information flows; visit them serially right away. They may enqueue
+    // further work of either kind, which this loop picks up again.
+    std::vector<WorklistShard> shards;
+    DenseMap<Operation *, size_t> shardIndex;
+    while (!worklist.empty()) {
+      WorkItem item = std::move(worklist.front());
+      worklist.pop();
+      if (Operation *root = getShardRoot(item.first)) {
+        auto inserted = shardIndex.try_emplace(root, shards.size());
+        if (inserted.second)
+          shards.push_back(WorklistShard{root, {}});
+        shards[inserted.first->second].queue.push(std::move(item));
+        continue;
+      }
+      auto [point, analysis] = item;
+      DATAFLOW_DEBUG(llvm::dbgs() << "Invoking '" << analysis->debugName
+                                  << "' on: " << point << "\n");
+      if (failed(analysis->visit(point)))
+        return failure();
+    }
+
+    // Exhaust the shards in parallel. Items enqueued for a point outside the
+    // producing shard land on the synchronized frontier and are picked up in
+    // the next round.
+    if (failed(failableParallelForEach(ctx, shards, [&](WorklistShard &shard) {
+          activeShard = &shard;
+          auto restore = llvm::make_scope_exit([] { activeShard = nullptr; });
+          while (!shard.queue.empty()) {
+            auto [point, analysis] = shard.queue.front();
+            shard.queue.pop();
+
+            DATAFLOW_DEBUG(llvm::dbgs() << "Invoking '" << analysis->debugName
+                                        << "' on: " << point << "\n");
+            if (failed(analysis->visit(point)))
+              return failure();
+          }
+          return success();
+        })))
+      return failure();
+
+    // Fold the frontier back into the main queue for the next round.
+    for (WorkItem &item : crossRegionFrontier)
+      worklist.push(std::move(item));
+    crossRegionFrontier.clear();
+  }
+  return success();
+}
+
 void DataFlowSolver::propagateIfChanged(AnalysisState *state,
                                         ChangeResult changed) {
   if (changed == ChangeResult::Change) {
     DATAFLOW_DEBUG(llvm::dbgs() << "Propagating update to " << state->debugName
                                 << " of " << state->point << "\n"
                                 << "Value: " << *state << "\n");
-    for (const WorkItem &item : state->dependents)
-      enqueue(item);
+    if (!enableRegionSharding) {
+      for (const WorkItem &item : state->dependents)
+        enqueue(item);
+    } else {
+      // Snapshot the dependents under the lock; enqueueing may need the
+      // frontier lock and must not hold the state lock while taking it.
+      SmallVector<WorkItem, 4> items;
+      {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        items.assign(state->dependents.begin(), state->dependents.end());
+      }
+      for (const WorkItem &item : items)
+        enqueue(item);
+    }
     state->onUpdate(this);
   }
 }
@@ -106,6 +226,9 @@ void DataFlowSolver::propagateIfChanged(AnalysisState *state,
 void DataFlowSolver::addDependency(AnalysisState *state,
                                    DataFlowAnalysis *analysis,
                                    ProgramPoint point) {
+  std::unique_lock<std::mutex> lock(stateMutex, std::defer_lock);
+  if (enableRegionSharding)
+    lock.lock();
   auto inserted = state->dependents.insert({point, analysis});
   (void)inserted;
   DATAFLOW_DEBUG({
@@ -19,6 +19,7 @@
 #include "mlir/IR/AsmState.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/Dialect.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/IR/Verifier.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/ScopeExit.h"
@@ -784,18 +785,43 @@ ParseResult OperationParser::finalize() {
     return success();
   };
 
-  auto walkRes = topLevelOp->walk([&](Operation *op) {
-    if (failed(resolveLocation(*op)))
-      return WalkResult::interrupt();
-    for (Region &region : op->getRegions())
-      for (Block &block : region.getBlocks())
+  // Only walk the operations if deferred locations were seen; the walk visits
+  // every operation and block argument of the module.
+  if (!deferredLocsReferences.empty()) {
+    auto resolveSubtree = [&](Operation *root) -> LogicalResult {
+      auto walkRes = root->walk([&](Operation *op) {
+        if (failed(resolveLocation(*op)))
+          return WalkResult::interrupt();
+        for (Region &region : op->getRegions())
+          for (Block &block : region.getBlocks())
+            for (BlockArgument arg : block.getArguments())
+              if (failed(resolveLocation(arg)))
+                return WalkResult::interrupt();
+        return WalkResult::advance();
+      });
+      return failure(walkRes.wasInterrupted());
+    };
+
+    // Resolve the top-level operation and its block arguments directly. The
+    // subtrees rooted at its direct children are disjoint, so they can be
+    // resolved on the context's thread pool, mirroring how the verifier
+    // traverses the module below.
+    if (failed(resolveLocation(*topLevelOp)))
+      return failure();
+    SmallVector<Operation *> topLevelChildren;
+    for (Region &region : topLevelOp->getRegions()) {
+      for (Block &block : region.getBlocks()) {
         for (BlockArgument arg : block.getArguments())
           if (failed(resolveLocation(arg)))
-            return WalkResult::interrupt();
-    return WalkResult::advance();
-  });
-  if (walkRes.wasInterrupted())
-    return failure();
+            return failure();
+        for (Operation &op : block)
+          topLevelChildren.push_back(&op);
+      }
+    }
+    if (failed(failableParallelForEach(getContext(), topLevelChildren,
+                                       resolveSubtree)))
+      return failure();
+  }
 
   // Pop the top level name scope.
   if (failed(popSSANameScope()))
@@ -23,8 +23,14 @@ namespace bytecode {
 //===----------------------------------------------------------------------===//
 
 enum {
+  /// The bytecode version in which the regions of isolated-from-above
+  /// operations became prefixed with their encoded byte size, enabling lazy
+  /// deserialization. Older files remain readable, but cannot be lazily
+  /// loaded.
+  kLazyLoadableRegionsVersion = 1,
+
   /// The current bytecode version.
-  kVersion = 0,
+  kVersion = 1,
 
   /// An arbitrary value used to fill alignment padding.
   kAlignmentByte = 0xCB,
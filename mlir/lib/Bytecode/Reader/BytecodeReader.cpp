@@ -23,6 +23,7 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/MemoryBufferRef.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include "llvm/Support/SourceMgr.h"
 
 #define DEBUG_TYPE "mlir-bytecode-reader"
 
@@ -484,11 +485,14 @@ namespace {
 class ResourceSectionReader {
 public:
   /// Initialize the resource section reader with the given section data.
+  /// `bufferOwnerRef`, if non-null, shares ownership of the buffer containing
+  /// the section data and enables zero-copy blob parsing.
   LogicalResult initialize(Location fileLoc, const ParserConfig &config,
                            MutableArrayRef<BytecodeDialect> dialects,
                            StringSectionReader &stringReader,
                            ArrayRef<uint8_t> sectionData,
-                           ArrayRef<uint8_t> offsetSectionData);
+                           ArrayRef<uint8_t> offsetSectionData,
+                           const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef);
 
   /// Parse a dialect resource handle from the resource section.
   LogicalResult parseResourceHandle(EncodingReader &reader,
@@ -504,8 +508,10 @@ private:
 class ParsedResourceEntry : public AsmParsedResourceEntry {
 public:
   ParsedResourceEntry(StringRef key, AsmResourceEntryKind kind,
-                      EncodingReader &reader, StringSectionReader &stringReader)
-      : key(key), kind(kind), reader(reader), stringReader(stringReader) {}
+                      EncodingReader &reader, StringSectionReader &stringReader,
+                      const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef)
+      : key(key), kind(kind), reader(reader), stringReader(stringReader),
+        bufferOwnerRef(bufferOwnerRef) {}
   ~ParsedResourceEntry() override = default;
 
   StringRef getKey() const final { return key; }
@@ -546,11 +552,22 @@ public:
     if (failed(reader.parseBlobAndAlignment(data, alignment)))
       return failure();
 
-    // Allocate memory for the blob using the provided allocator and copy the
-    // data into it.
-    // FIXME: If the current holder of the bytecode can ensure its lifetime
-    // (e.g. when mmap'd), we should not copy the data. We should use the data
-    // from the bytecode directly.
+    // If the owner of the bytecode buffer shares its ownership with us and
+    // the data happens to satisfy the requested alignment in place, reference
+    // the data directly instead of copying it; the blob keeps the buffer (and
+    // thus a potentially mmap'd file) alive for as long as it lives. Entries
+    // written without padding by older producers fall back to a copy.
+    if (bufferOwnerRef &&
+        llvm::isAddrAligned(llvm::Align(alignment), data.data())) {
+      return UnmanagedAsmResourceBlob::allocateWithAlign(
+          ArrayRef<char>(reinterpret_cast<const char *>(data.data()),
+                         data.size()),
+          alignment,
+          [bufferOwnerRef = bufferOwnerRef](void *, size_t, size_t) {});
+    }
+
+    // Otherwise, allocate memory for the blob using the provided allocator and
+    // copy the data into it.
     AsmResourceBlob blob = allocator(data.size(), alignment);
     assert(llvm::isAddrAligned(llvm::Align(alignment), blob.getData().data()) &&
            blob.isMutable() &&
@@ -564,6 +581,10 @@ private:
   AsmResourceEntryKind kind;
   EncodingReader &reader;
   StringSectionReader &stringReader;
+
+  /// Shared ownership of the buffer the resource data points into, if the
+  /// client provided it. Null when blobs must be copied.
+  const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef;
 };
 } // namespace
 
@@ -572,6 +593,7 @@ static LogicalResult
 parseResourceGroup(Location fileLoc, bool allowEmpty,
                    EncodingReader &offsetReader, EncodingReader &resourceReader,
                    StringSectionReader &stringReader, T *handler,
+                   const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef,
                    function_ref<LogicalResult(StringRef)> processKeyFn = {}) {
   uint64_t numResources;
   if (failed(offsetReader.parseVarInt(numResources)))
@@ -603,7 +625,8 @@ parseResourceGroup(Location fileLoc, bool allowEmpty,
 
     // Otherwise, parse the resource value.
     EncodingReader entryReader(data, fileLoc);
-    ParsedResourceEntry entry(key, kind, entryReader, stringReader);
+    ParsedResourceEntry entry(key, kind, entryReader, stringReader,
+                              bufferOwnerRef);
     if (failed(handler->parseResource(entry)))
       return failure();
     if (!entryReader.empty()) {
@@ -614,12 +637,12 @@ parseResourceGroup(Location fileLoc, bool allowEmpty,
   return success();
 }
 
-LogicalResult
-ResourceSectionReader::initialize(Location fileLoc, const ParserConfig &config,
-                                  MutableArrayRef<BytecodeDialect> dialects,
-                                  StringSectionReader &stringReader,
-                                  ArrayRef<uint8_t> sectionData,
-                                  ArrayRef<uint8_t> offsetSectionData) {
+LogicalResult ResourceSectionReader::initialize(
+    Location fileLoc, const ParserConfig &config,
+    MutableArrayRef<BytecodeDialect> dialects,
+    StringSectionReader &stringReader, ArrayRef<uint8_t> sectionData,
+    ArrayRef<uint8_t> offsetSectionData,
+    const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef) {
   EncodingReader resourceReader(sectionData, fileLoc);
   EncodingReader offsetReader(offsetSectionData, fileLoc);
 
@@ -633,7 +656,7 @@ ResourceSectionReader::initialize(Location fileLoc, const ParserConfig &config,
   auto parseGroup = [&](auto *handler, bool allowEmpty = false,
                         function_ref<LogicalResult(StringRef)> keyFn = {}) {
     return parseResourceGroup(fileLoc, allowEmpty, offsetReader, resourceReader,
-                              stringReader, handler, keyFn);
+                              stringReader, handler, bufferOwnerRef, keyFn);
   };
 
   // Read the external resources from the bytecode.
@@ -1046,12 +1069,14 @@ LogicalResult AttrTypeReader::parseCustomEntry(Entry<T> &entry,
 // Bytecode Reader
 //===----------------------------------------------------------------------===//
 
-namespace {
 /// This class is used to read a bytecode buffer and translate it into MLIR.
-class BytecodeReader {
+class BytecodeReader::Impl {
 public:
-  BytecodeReader(Location fileLoc, const ParserConfig &config)
-      : config(config), fileLoc(fileLoc),
+  Impl(Location fileLoc, const ParserConfig &config, bool lazyLoading,
+       llvm::MemoryBufferRef buffer,
+       const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef)
+      : config(config), fileLoc(fileLoc), lazyLoading(lazyLoading),
+        buffer(buffer), bufferOwnerRef(bufferOwnerRef),
         attrTypeReader(stringReader, resourceReader, fileLoc),
         // Use the builtin unrealized conversion cast operation to represent
         // forward references to values that aren't yet defined.
@@ -1059,8 +1084,30 @@ public:
                           "builtin.unrealized_conversion_cast", ValueRange(),
                           NoneType::get(config.getContext())) {}
 
-  /// Read the bytecode defined within `buffer` into the given block.
-  LogicalResult read(llvm::MemoryBufferRef buffer, Block *block);
+  /// Read the bytecode buffer into the given block.
+  LogicalResult read(Block *block);
+
+  /// Return whether the provided operation's regions were skipped during
+  /// reading and can be materialized.
+  bool isMaterializable(Operation *op) const {
+    return lazyLoadableOps.count(op);
+  }
+
+  /// Materialize the regions of the provided operation.
+  LogicalResult materialize(Operation *op);
+
+  /// Materialize the regions of every pending operation, including operations
+  /// discovered while materializing.
+  LogicalResult materializeAll() {
+    while (!lazyLoadableOps.empty())
+      if (failed(materialize(lazyLoadableOps.begin()->first)))
+        return failure();
+    return success();
+  }
+
+  /// Return the number of operations whose regions are still pending
+  /// materialization.
+  int64_t getNumOpsToMaterialize() const { return lazyLoadableOps.size(); }
 
 private:
   /// Return the context for this config.
@@ -1132,7 +1179,8 @@ private:
                              RegionReadState &readState);
   FailureOr<Operation *> parseOpWithoutRegions(EncodingReader &reader,
                                                RegionReadState &readState,
-                                               bool &isIsolatedFromAbove);
+                                               bool &isIsolatedFromAbove,
+                                               uint64_t &isolatedRegionsSize);
 
   LogicalResult parseRegion(EncodingReader &reader, RegionReadState &readState);
   LogicalResult parseBlock(EncodingReader &reader, RegionReadState &readState);
@@ -1185,6 +1233,23 @@ private:
   /// A location to use when emitting errors.
   Location fileLoc;
 
+  /// Whether the regions of isolated operations should be skipped when
+  /// reading and materialized on demand.
+  bool lazyLoading;
+
+  /// The bytecode buffer being read. It must remain alive as long as lazily
+  /// loadable operations are pending.
+  llvm::MemoryBufferRef buffer;
+
+  /// Shared ownership of the bytecode buffer, if the client provided it.
+  /// When set, resource blobs may reference the buffer directly instead of
+  /// copying out of it.
+  std::shared_ptr<llvm::SourceMgr> bufferOwnerRef;
+
+  /// The set of operations whose regions were skipped during reading, mapped
+  /// to the encoded bytes of those regions.
+  llvm::MapVector<Operation *, ArrayRef<uint8_t>> lazyLoadableOps;
+
   /// The reader used to process attribute and types within the bytecode.
   AttrTypeReader attrTypeReader;
 
@@ -1215,12 +1280,13 @@ private:
   /// An operation state used when instantiating forward references.
   OperationState forwardRefOpState;
 };
-} // namespace
 
-LogicalResult BytecodeReader::read(llvm::MemoryBufferRef buffer, Block *block) {
+LogicalResult BytecodeReader::Impl::read(Block *block) {
   EncodingReader reader(buffer.getBuffer(), fileLoc);
 
-  // Skip over the bytecode header, this should have already been checked.
+  // Skip over the bytecode header.
+  if (!isBytecode(buffer))
+    return emitError(fileLoc, "input buffer is not an MLIR bytecode file");
   if (failed(reader.skipBytes(StringRef("ML\xefR").size())))
     return failure();
   // Parse the bytecode version and producer.
@@ -1286,17 +1352,15 @@ LogicalResult BytecodeReader::read(llvm::MemoryBufferRef buffer, Block *block) {
   return parseIRSection(*sectionDatas[bytecode::Section::kIR], block);
 }
 
-LogicalResult BytecodeReader::parseVersion(EncodingReader &reader) {
+LogicalResult BytecodeReader::Impl::parseVersion(EncodingReader &reader) {
   if (failed(reader.parseVarInt(version)))
     return failure();
 
-  // Validate the bytecode version.
+  // Validate the bytecode version. Versions older than
+  // `kLazyLoadableRegionsVersion` differ only in that the regions of isolated
+  // operations are not size-prefixed; they remain readable, but cannot be
+  // lazily loaded.
   uint64_t currentVersion = bytecode::kVersion;
-  if (version < currentVersion) {
-    return reader.emitError("bytecode version ", version,
-                            " is older than the current version of ",
-                            currentVersion, ", and upgrade is not supported");
-  }
   if (version > currentVersion) {
     return reader.emitError("bytecode version ", version,
                             " is newer than the current version ",
@@ -1309,7 +1373,7 @@ LogicalResult BytecodeReader::parseVersion(EncodingReader &reader) {
 // Dialect Section
 
 LogicalResult
-BytecodeReader::parseDialectSection(ArrayRef<uint8_t> sectionData) {
+BytecodeReader::Impl::parseDialectSection(ArrayRef<uint8_t> sectionData) {
   EncodingReader sectionReader(sectionData, fileLoc);
 
   // Parse the number of dialects in the section.
@@ -1337,7 +1401,8 @@ BytecodeReader::parseDialectSection(ArrayRef<uint8_t> sectionData) {
   return success();
 }
 
-FailureOr<OperationName> BytecodeReader::parseOpName(EncodingReader &reader) {
+FailureOr<OperationName>
+BytecodeReader::Impl::parseOpName(EncodingReader &reader) {
   BytecodeOperationName *opName = nullptr;
   if (failed(parseEntry(reader, opNames, opName, "operation name")))
     return failure();
@@ -1356,7 +1421,7 @@ FailureOr<OperationName> BytecodeReader::parseOpName(EncodingReader &reader) {
 //===----------------------------------------------------------------------===//
 // Resource Section
 
-LogicalResult BytecodeReader::parseResourceSection(
+LogicalResult BytecodeReader::Impl::parseResourceSection(
     Optional<ArrayRef<uint8_t>> resourceData,
     Optional<ArrayRef<uint8_t>> resourceOffsetData) {
   // Ensure both sections are either present or not.
@@ -1375,14 +1440,16 @@ LogicalResult BytecodeReader::parseResourceSection(
 
   // Initialize the resource reader with the resource sections.
   return resourceReader.initialize(fileLoc, config, dialects, stringReader,
-                                   *resourceData, *resourceOffsetData);
+                                   *resourceData, *resourceOffsetData,
+                                   bufferOwnerRef);
 }
 
 //===----------------------------------------------------------------------===//
 // IR Section
 
-LogicalResult BytecodeReader::parseIRSection(ArrayRef<uint8_t> sectionData,
-                                             Block *block) {
+LogicalResult
+BytecodeReader::Impl::parseIRSection(ArrayRef<uint8_t> sectionData,
+                                     Block *block) {
   EncodingReader reader(sectionData, fileLoc);
 
   // A stack of operation regions currently being read from the bytecode.
@@ -1407,8 +1474,10 @@ LogicalResult BytecodeReader::parseIRSection(ArrayRef<uint8_t> sectionData,
         "not all forward unresolved forward operand references");
   }
 
-  // Verify that the parsed operations are valid.
-  if (failed(verify(*moduleOp)))
+  // Verify that the parsed operations are valid. When lazily loading, the
+  // regions of deferred operations may not yet satisfy their invariants, so
+  // verification instead happens when those operations are materialized.
+  if (lazyLoadableOps.empty() && failed(verify(*moduleOp)))
     return failure();
 
   // Splice the parsed operations over to the provided top-level block.
@@ -1419,10 +1488,42 @@ LogicalResult BytecodeReader::parseIRSection(ArrayRef<uint8_t> sectionData,
   return success();
 }
 
+LogicalResult BytecodeReader::Impl::materialize(Operation *op) {
+  auto it = lazyLoadableOps.find(op);
+  assert(it != lazyLoadableOps.end() &&
+         "provided operation is not lazily loadable");
+  ArrayRef<uint8_t> regionData = it->second;
+  lazyLoadableOps.erase(it);
+
+  // Parse the region data the same way the regions would have been parsed
+  // eagerly: the operation is isolated from above, so it gets a fresh value
+  // scope. Nested isolated operations are recorded for lazy materialization
+  // in turn.
+  EncodingReader reader(regionData, fileLoc);
+  std::vector<RegionReadState> regionStack;
+  regionStack.emplace_back(op, /*isIsolatedFromAbove=*/true);
+  valueScopes.emplace_back();
+  size_t numPendingBefore = lazyLoadableOps.size();
+  while (!regionStack.empty())
+    if (failed(parseRegions(reader, regionStack, regionStack.back())))
+      return failure();
+  if (!forwardRefOps.empty()) {
+    return reader.emitError(
+        "not all forward unresolved forward operand references");
+  }
+
+  // Verify the materialized operations, unless nested operations were
+  // themselves deferred; their region invariants may not hold until they are
+  // materialized.
+  if (lazyLoadableOps.size() == numPendingBefore)
+    return verify(op);
+  return success();
+}
+
 LogicalResult
-BytecodeReader::parseRegions(EncodingReader &reader,
-                             std::vector<RegionReadState> &regionStack,
-                             RegionReadState &readState) {
+BytecodeReader::Impl::parseRegions(EncodingReader &reader,
+                                   std::vector<RegionReadState> &regionStack,
+                                   RegionReadState &readState) {
   // Read the regions of this operation.
   for (; readState.curRegion != readState.endRegion; ++readState.curRegion) {
     // If the current block hasn't been setup yet, parse the header for this
@@ -1442,13 +1543,24 @@ BytecodeReader::parseRegions(EncodingReader &reader,
         // Read in the next operation. We don't read its regions directly, we
         // handle those afterwards as necessary.
         bool isIsolatedFromAbove = false;
-        FailureOr<Operation *> op =
-            parseOpWithoutRegions(reader, readState, isIsolatedFromAbove);
+        uint64_t isolatedRegionsSize = 0;
+        FailureOr<Operation *> op = parseOpWithoutRegions(
+            reader, readState, isIsolatedFromAbove, isolatedRegionsSize);
         if (failed(op))
           return failure();
 
         // If the op has regions, add it to the stack for processing.
         if ((*op)->getNumRegions()) {
+          // When lazily loading, skip over the region bytes of isolated
+          // operations and record them for on-demand materialization.
+          if (lazyLoading && isolatedRegionsSize) {
+            ArrayRef<uint8_t> regionData;
+            if (failed(reader.parseBytes(isolatedRegionsSize, regionData)))
+              return failure();
+            lazyLoadableOps.insert({*op, regionData});
+            continue;
+          }
+
           regionStack.emplace_back(*op, isIsolatedFromAbove);
 
           // If the op is isolated from above, push a new value scope.
@@ -1479,9 +1591,10 @@ BytecodeReader::parseRegions(EncodingReader &reader,
 }
 
 FailureOr<Operation *>
-BytecodeReader::parseOpWithoutRegions(EncodingReader &reader,
-                                      RegionReadState &readState,
-                                      bool &isIsolatedFromAbove) {
+BytecodeReader::Impl::parseOpWithoutRegions(EncodingReader &reader,
+                                            RegionReadState &readState,
+                                            bool &isIsolatedFromAbove,
+                                            uint64_t &isolatedRegionsSize) {
   // Parse the name of the operation.
   FailureOr<OperationName> opName = parseOpName(reader);
   if (failed(opName))
@@ -1551,6 +1664,13 @@ BytecodeReader::parseOpWithoutRegions(EncodingReader &reader,
     if (failed(reader.parseVarIntWithFlag(numRegions, isIsolatedFromAbove)))
       return failure();
 
+    // The regions of isolated operations are prefixed with their encoded byte
+    // size, so that they can be skipped over and materialized lazily.
+    if (isIsolatedFromAbove &&
+        version >= bytecode::kLazyLoadableRegionsVersion &&
+        failed(reader.parseVarInt(isolatedRegionsSize)))
+      return failure();
+
     opState.regions.reserve(numRegions);
     for (int i = 0, e = numRegions; i < e; ++i)
       opState.regions.push_back(std::make_unique<Region>());
@@ -1567,8 +1687,8 @@ BytecodeReader::parseOpWithoutRegions(EncodingReader &reader,
   return op;
 }
 
-LogicalResult BytecodeReader::parseRegion(EncodingReader &reader,
-                                          RegionReadState &readState) {
+LogicalResult BytecodeReader::Impl::parseRegion(EncodingReader &reader,
+                                                RegionReadState &readState) {
   // Parse the number of blocks in the region.
   uint64_t numBlocks;
   if (failed(reader.parseVarInt(numBlocks)))
@@ -1601,8 +1721,8 @@ LogicalResult BytecodeReader::parseRegion(EncodingReader &reader,
   return parseBlock(reader, readState);
 }
 
-LogicalResult BytecodeReader::parseBlock(EncodingReader &reader,
-                                         RegionReadState &readState) {
+LogicalResult BytecodeReader::Impl::parseBlock(EncodingReader &reader,
+                                               RegionReadState &readState) {
   bool hasArgs;
   if (failed(reader.parseVarIntWithFlag(readState.numOpsRemaining, hasArgs)))
     return failure();
@@ -1615,8 +1735,8 @@ LogicalResult BytecodeReader::parseBlock(EncodingReader &reader,
   return success();
 }
 
-LogicalResult BytecodeReader::parseBlockArguments(EncodingReader &reader,
-                                                  Block *block) {
+LogicalResult BytecodeReader::Impl::parseBlockArguments(EncodingReader &reader,
+                                                        Block *block) {
   // Parse the value ID for the first argument, and the number of arguments.
   uint64_t numArgs;
   if (failed(reader.parseVarInt(numArgs)))
@@ -1644,7 +1764,7 @@ LogicalResult BytecodeReader::parseBlockArguments(EncodingReader &reader,
 //===----------------------------------------------------------------------===//
 // Value Processing
 
-Value BytecodeReader::parseOperand(EncodingReader &reader) {
+Value BytecodeReader::Impl::parseOperand(EncodingReader &reader) {
   std::vector<Value> &values = valueScopes.back().values;
   Value *value = nullptr;
   if (failed(parseEntry(reader, values, value, "value")))
@@ -1656,7 +1776,7 @@ Value BytecodeReader::parseOperand(EncodingReader &reader) {
   return *value;
 }
 
-LogicalResult BytecodeReader::defineValues(EncodingReader &reader,
+LogicalResult BytecodeReader::Impl::defineValues(EncodingReader &reader,
                                            ValueRange newValues) {
   ValueScope &valueScope = valueScopes.back();
   std::vector<Value> &values = valueScope.values;
@@ -1692,7 +1812,7 @@ LogicalResult BytecodeReader::defineValues(EncodingReader &reader,
   return success();
 }
 
-Value BytecodeReader::createForwardRef() {
+Value BytecodeReader::Impl::createForwardRef() {
   // Check for an avaliable existing operation to use. Otherwise, create a new
   // fake operation to use for the reference.
   if (!openForwardRefOps.empty()) {
@@ -1712,16 +1832,48 @@ bool mlir::isBytecode(llvm::MemoryBufferRef buffer) {
   return buffer.getBuffer().startswith("ML\xefR");
 }
 
-LogicalResult mlir::readBytecodeFile(llvm::MemoryBufferRef buffer, Block *block,
-                                     const ParserConfig &config) {
+BytecodeReader::BytecodeReader(
+    llvm::MemoryBufferRef buffer, const ParserConfig &config, bool lazyLoading,
+    const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef) {
   Location sourceFileLoc =
       FileLineColLoc::get(config.getContext(), buffer.getBufferIdentifier(),
                           /*line=*/0, /*column=*/0);
-  if (!isBytecode(buffer)) {
-    return emitError(sourceFileLoc,
-                     "input buffer is not an MLIR bytecode file");
-  }
+  impl = std::make_unique<Impl>(sourceFileLoc, config, lazyLoading, buffer,
+                                bufferOwnerRef);
+}
+BytecodeReader::~BytecodeReader() = default;
 
-  BytecodeReader reader(sourceFileLoc, config);
-  return reader.read(buffer, block);
+LogicalResult BytecodeReader::readTopLevel(Block *block) {
+  return impl->read(block);
+}
+
+bool BytecodeReader::isMaterializable(Operation *op) const {
+  return impl->isMaterializable(op);
+}
+
+LogicalResult BytecodeReader::materialize(Operation *op) {
+  return impl->materialize(op);
+}
+
+LogicalResult BytecodeReader::materializeAll() {
+  return impl->materializeAll();
+}
+
+int64_t BytecodeReader::getNumOpsToMaterialize() const {
+  return impl->getNumOpsToMaterialize();
+}
+
+LogicalResult mlir::readBytecodeFile(llvm::MemoryBufferRef buffer, Block *block,
+                                     const ParserConfig &config) {
+  BytecodeReader reader(buffer, config, /*lazyLoading=*/false);
+  return reader.readTopLevel(block);
+}
+
+LogicalResult
+mlir::readBytecodeFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                       Block *block, const ParserConfig &config) {
+  BytecodeReader reader(
+      *sourceMgr->getMemoryBuffer(sourceMgr->getMainFileID()), config,
+      /*lazyLoading=*/false, sourceMgr);
+  return reader.readTopLevel(block);
 }
@@ -213,14 +213,19 @@ public:
       }
     }
 
-    // Push our current buffer and then merge the provided section body into
-    // ours.
+    // Merge the provided section body into ours.
+    emitEmitter(std::move(emitter));
+  }
+
+  /// Append the contents of the given emitter to this one.
+  void emitEmitter(EncodingEmitter &&emitter) {
     appendResult(std::move(currentResult));
     for (std::vector<uint8_t> &result : emitter.prevResultStorage)
       prevResultStorage.push_back(std::move(result));
     llvm::append_range(prevResultList, emitter.prevResultList);
     prevResultSize += emitter.prevResultSize;
     appendResult(std::move(emitter.currentResult));
+    requiredAlignment = std::max(requiredAlignment, emitter.requiredAlignment);
   }
 
 private:
@@ -699,8 +704,19 @@ void BytecodeWriter::writeOp(EncodingEmitter &emitter, Operation *op) {
     bool isIsolatedFromAbove = op->hasTrait<OpTrait::IsIsolatedFromAbove>();
     emitter.emitVarIntWithFlag(numRegions, isIsolatedFromAbove);
 
-    for (Region &region : op->getRegions())
-      writeRegion(emitter, &region);
+    // The regions of isolated operations are emitted into their own buffer
+    // and prefixed with their byte size, so that readers can skip over them
+    // and materialize them lazily.
+    if (isIsolatedFromAbove) {
+      EncodingEmitter regionEmitter;
+      for (Region &region : op->getRegions())
+        writeRegion(regionEmitter, &region);
+      emitter.emitVarInt(regionEmitter.size());
+      emitter.emitEmitter(std::move(regionEmitter));
+    } else {
+      for (Region &region : op->getRegions())
+        writeRegion(emitter, &region);
+    }
   }
 }
 
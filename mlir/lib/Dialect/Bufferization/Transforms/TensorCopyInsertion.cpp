@@ -15,6 +15,7 @@
 #include "mlir/Dialect/Bufferization/Transforms/OneShotModuleBufferize.h"
 #include "mlir/Dialect/Bufferization/Transforms/TensorCopyInsertion.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "llvm/Support/Timer.h"
 
 namespace mlir {
 namespace bufferization {
@@ -97,22 +98,34 @@ resolveUsesInRepetitiveRegions(Operation *op,
 }
 
 LogicalResult mlir::bufferization::insertTensorCopies(
-    Operation *op, const OneShotBufferizationOptions &options) {
+    Operation *op, const OneShotBufferizationOptions &options,
+    BufferizationStatistics *statistics) {
   // Preprocessing: Resolve currently unsupported bufferization cases.
   resolveUsesInRepetitiveRegions(op, options);
 
+  llvm::TimeRecord analysisStart;
+  if (statistics)
+    analysisStart = llvm::TimeRecord::getCurrentTime(/*Start=*/true);
+
   OneShotAnalysisState state(op, options);
   // Run normal One-Shot Bufferize analysis or One-Shot Module Bufferize
   // analysis depending on whether function boundary bufferization is enabled or
   // not.
-  if (options.bufferizeFunctionBoundaries) {
-    if (failed(analyzeModuleOp(cast<ModuleOp>(op), state)))
-      return failure();
-  } else {
-    if (failed(analyzeOp(op, state)))
-      return failure();
+  LogicalResult analysisStatus = options.bufferizeFunctionBoundaries
+                                     ? analyzeModuleOp(cast<ModuleOp>(op), state)
+                                     : analyzeOp(op, state);
+
+  if (statistics) {
+    llvm::TimeRecord analysisTime =
+        llvm::TimeRecord::getCurrentTime(/*Start=*/false);
+    analysisTime -= analysisStart;
+    statistics->analysisTimeMs +=
+        static_cast<int64_t>(analysisTime.getWallTime() * 1000.0);
   }
 
+  if (failed(analysisStatus))
+    return failure();
+
   if (options.testAnalysisOnly)
     return success();
 
@@ -29,6 +29,8 @@ transform::TransformState::TransformState(Region &region, Operation *root,
     : topLevel(root), options(options) {
   auto result = mappings.try_emplace(&region);
   assert(result.second && "the region scope is already present");
+  if (unsigned numHandles = options.getExpectedNumHandles())
+    result.first->second.direct.reserve(numHandles);
   (void)result;
 #if LLVM_ENABLE_ABI_BREAKING_CHECKS
   regionStack.push_back(&region);
@@ -53,15 +53,22 @@ public:
 /// This is intended to be used along the WithPDLPatterns op. The extension
 /// can be constructed given an operation that has a SymbolTable trait and
 /// contains pdl::PatternOp instances. The patterns are compiled lazily and one
-/// by one when requested; this behavior is subject to change.
+/// by one when requested; this behavior is subject to change. When an external
+/// pattern storage is provided, compiled patterns persist in it beyond the
+/// lifetime of the extension, allowing them to be reused across repeated
+/// applications of the same transform script.
 class PatternApplicatorExtension : public transform::TransformState::Extension {
 public:
   MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(PatternApplicatorExtension)
 
-  /// Creates the extension for patterns contained in `patternContainer`.
-  explicit PatternApplicatorExtension(transform::TransformState &state,
-                                      Operation *patternContainer)
-      : Extension(state), patterns(patternContainer) {}
+  /// Creates the extension for patterns contained in `patternContainer`,
+  /// optionally storing the compiled patterns in `externalPatterns`.
+  explicit PatternApplicatorExtension(
+      transform::TransformState &state, Operation *patternContainer,
+      llvm::StringMap<FrozenRewritePatternSet> *externalPatterns = nullptr)
+      : Extension(state), patterns(patternContainer),
+        compiledPatterns(externalPatterns ? *externalPatterns : localPatterns) {
+  }
 
   /// Appends to `results` the operations contained in `root` that matched the
   /// PDL pattern with the given name. Note that `root` may or may not be the
@@ -72,19 +79,70 @@ public:
                                SmallVectorImpl<Operation *> &results);
 
 private:
+  /// Default storage for the compiled patterns when no external storage is
+  /// provided.
+  llvm::StringMap<FrozenRewritePatternSet> localPatterns;
+
   /// Map from the pattern name to a singleton set of rewrite patterns that only
   /// contains the pattern with this name. Populated when the pattern is first
-  /// requested.
+  /// requested, unless already present in external storage.
   // TODO: reconsider the efficiency of this storage when more usage data is
   // available. Storing individual patterns in a set and triggering compilation
   // for each of them has overhead. So does compiling a large set of patterns
   // only to apply a handlful of them.
-  llvm::StringMap<FrozenRewritePatternSet> compiledPatterns;
+  llvm::StringMap<FrozenRewritePatternSet> &compiledPatterns;
 
   /// A symbol table operation containing the relevant PDL patterns.
   SymbolTable patterns;
 };
 
+/// A TransformState extension attached by PrecompiledTransformScript to expose
+/// its persistent pattern storage to WithPDLPatternsOp applications.
+class PatternCacheExtension : public transform::TransformState::Extension {
+public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(PatternCacheExtension)
+
+  PatternCacheExtension(
+      transform::TransformState &state,
+      DenseMap<Operation *, llvm::StringMap<FrozenRewritePatternSet>> &cache)
+      : Extension(state), cache(cache) {}
+
+  /// Returns the persistent pattern storage for the given pattern container
+  /// operation.
+  llvm::StringMap<FrozenRewritePatternSet> &
+  getContainerPatterns(Operation *container) {
+    return cache[container];
+  }
+
+private:
+  /// Back-reference to the script's pattern storage.
+  DenseMap<Operation *, llvm::StringMap<FrozenRewritePatternSet>> &cache;
+};
+
+/// Compiles the given PDL pattern down to bytecode and stores the resulting
+/// singleton frozen pattern set in `compiledPatterns`, keyed by the pattern
+/// symbol name. This consumes the pattern operation.
+static void
+compilePDLPattern(pdl::PatternOp patternOp, MLIRContext *context,
+                  llvm::StringMap<FrozenRewritePatternSet> &compiledPatterns) {
+  OwningOpRef<ModuleOp> pdlModuleOp = ModuleOp::create(patternOp.getLoc());
+  patternOp->moveBefore(pdlModuleOp->getBody(), pdlModuleOp->getBody()->end());
+  PDLPatternModule patternModule(std::move(pdlModuleOp));
+
+  // Merge in the hooks owned by the dialect. Make a copy as they may be
+  // also used by the following operations.
+  auto *dialect = context->getLoadedDialect<transform::TransformDialect>();
+  for (const auto &pair : dialect->getPDLConstraintHooks())
+    patternModule.registerConstraintFunction(pair.first(), pair.second);
+
+  // Register a noop rewriter because PDL requires patterns to end with some
+  // rewrite call.
+  patternModule.registerRewriteFunction(
+      "transform.dialect", [](PatternRewriter &, Operation *) {});
+
+  compiledPatterns.try_emplace(patternOp.getName(), std::move(patternModule));
+}
+
 LogicalResult PatternApplicatorExtension::findAllMatches(
     StringRef patternName, Operation *root,
     SmallVectorImpl<Operation *> &results) {
@@ -94,26 +152,8 @@ LogicalResult PatternApplicatorExtension::findAllMatches(
     if (!patternOp)
       return failure();
 
-    OwningOpRef<ModuleOp> pdlModuleOp = ModuleOp::create(patternOp.getLoc());
-    patternOp->moveBefore(pdlModuleOp->getBody(),
-                          pdlModuleOp->getBody()->end());
-    PDLPatternModule patternModule(std::move(pdlModuleOp));
-
-    // Merge in the hooks owned by the dialect. Make a copy as they may be
-    // also used by the following operations.
-    auto *dialect =
-        root->getContext()->getLoadedDialect<transform::TransformDialect>();
-    for (const auto &pair : dialect->getPDLConstraintHooks())
-      patternModule.registerConstraintFunction(pair.first(), pair.second);
-
-    // Register a noop rewriter because PDL requires patterns to end with some
-    // rewrite call.
-    patternModule.registerRewriteFunction(
-        "transform.dialect", [](PatternRewriter &, Operation *) {});
-
-    it = compiledPatterns
-             .try_emplace(patternOp.getName(), std::move(patternModule))
-             .first;
+    compilePDLPattern(patternOp, root->getContext(), compiledPatterns);
+    it = compiledPatterns.find(patternName);
   }
 
   PatternApplicator applicator(it->second);
@@ -128,6 +168,66 @@ LogicalResult PatternApplicatorExtension::findAllMatches(
 }
 } // namespace
 
+//===----------------------------------------------------------------------===//
+// PrecompiledTransformScript
+//===----------------------------------------------------------------------===//
+
+FailureOr<transform::PrecompiledTransformScript>
+transform::PrecompiledTransformScript::compile(Region &region) {
+  PrecompiledTransformScript script(region);
+  script.compiledPatterns = std::make_shared<
+      DenseMap<Operation *, llvm::StringMap<FrozenRewritePatternSet>>>();
+
+  // Non-transform ops at the top level, e.g. the payload IR the transform ops
+  // are embedded next to, are ignored just like in op-by-op interpretation.
+  for (auto transform : region.front().getOps<TransformOpInterface>())
+    script.transforms.push_back(transform);
+
+  // Size the handle storage for the worst case where all transform IR values
+  // are live simultaneously.
+  region.walk([&](Operation *op) {
+    if (isa<TransformOpInterface>(op))
+      script.numHandles += op->getNumResults();
+  });
+
+  // Compile all patterns down to bytecode once. Compilation consumes the
+  // pattern ops, so collect them before iterating.
+  SmallVector<WithPDLPatternsOp> patternContainers;
+  region.walk(
+      [&](WithPDLPatternsOp container) { patternContainers.push_back(container); });
+  for (WithPDLPatternsOp container : patternContainers) {
+    llvm::StringMap<FrozenRewritePatternSet> &containerPatterns =
+        (*script.compiledPatterns)[container.getOperation()];
+    SmallVector<pdl::PatternOp> patternOps(
+        container.getBody().front().getOps<pdl::PatternOp>());
+    for (pdl::PatternOp patternOp : patternOps) {
+      // Unnamed patterns cannot be referenced by the transform ops.
+      if (!patternOp.getSymNameAttr())
+        continue;
+      compilePDLPattern(patternOp, region.getContext(), containerPatterns);
+    }
+  }
+  return script;
+}
+
+DiagnosedSilenceableFailure transform::PrecompiledTransformScript::apply(
+    Operation *payloadRoot, const TransformOptions &options) {
+  TransformOptions scriptOptions(options);
+  scriptOptions.setExpectedNumHandles(numHandles);
+  TransformState state(*region, payloadRoot, scriptOptions);
+
+  state.addExtension<PatternCacheExtension>(*compiledPatterns);
+  auto guard = llvm::make_scope_exit(
+      [&]() { state.removeExtension<PatternCacheExtension>(); });
+
+  for (TransformOpInterface transform : transforms) {
+    DiagnosedSilenceableFailure result = state.applyTransform(transform);
+    if (!result.succeeded())
+      return result;
+  }
+  return DiagnosedSilenceableFailure::success();
+}
+
 //===----------------------------------------------------------------------===//
 // AlternativesOp
 //===----------------------------------------------------------------------===//
@@ -672,7 +772,14 @@ transform::WithPDLPatternsOp::apply(transform::TransformResults &results,
     }
   }
 
-  state.addExtension<PatternApplicatorExtension>(getOperation());
+  // When running under a precompiled script, compiled patterns persist in the
+  // script's storage across applications.
+  llvm::StringMap<FrozenRewritePatternSet> *externalPatterns = nullptr;
+  if (auto *cacheExtension = state.getExtension<PatternCacheExtension>())
+    externalPatterns = &cacheExtension->getContainerPatterns(getOperation());
+
+  state.addExtension<PatternApplicatorExtension>(getOperation(),
+                                                 externalPatterns);
   auto guard = llvm::make_scope_exit(
       [&]() { state.removeExtension<PatternApplicatorExtension>(); });
 
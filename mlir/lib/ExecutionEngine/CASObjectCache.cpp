@@ -0,0 +1,123 @@
+//===- CASObjectCache.cpp - CAS-backed object cache for the JIT -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a content-addressed object cache for the MLIR
+// execution engine on top of llvm::cas::ObjectStore and
+// llvm::cas::ActionCache.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/ExecutionEngine/CASObjectCache.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#define DEBUG_TYPE "execution-engine"
+
+using namespace mlir;
+using llvm::dbgs;
+using llvm::Expected;
+using llvm::MemoryBuffer;
+using llvm::MemoryBufferRef;
+using llvm::Module;
+using llvm::StringRef;
+using llvm::cas::ActionCache;
+using llvm::cas::CacheKey;
+using llvm::cas::ObjectProxy;
+using llvm::cas::ObjectRef;
+using llvm::cas::ObjectStore;
+
+/// Consume `err`, reporting it only in debug output. A broken or unavailable
+/// cache must never fail the compilation itself.
+static void reportCacheError(llvm::Error err, const Twine &context) {
+  LLVM_DEBUG(dbgs() << "CASObjectCache: " << context << ": "
+                    << llvm::toString(std::move(err)) << "\n");
+  llvm::consumeError(std::move(err));
+}
+
+Expected<std::unique_ptr<CASObjectCache>>
+CASObjectCache::createOnDisk(StringRef path, StringRef codeGenConfig) {
+  Expected<std::unique_ptr<ObjectStore>> cas =
+      path.empty() ? llvm::cas::createOnDiskCAS(
+                         llvm::cas::getDefaultOnDiskCASPath())
+                   : llvm::cas::createOnDiskCAS(path);
+  if (!cas)
+    return cas.takeError();
+  std::shared_ptr<ObjectStore> sharedCAS = std::move(*cas);
+  Expected<std::unique_ptr<ActionCache>> actionCache =
+      llvm::cas::createOnDiskActionCache(
+          *sharedCAS, path.empty()
+                          ? StringRef(llvm::cas::getDefaultOnDiskActionCachePath())
+                          : path);
+  if (!actionCache)
+    return actionCache.takeError();
+  return std::make_unique<CASObjectCache>(
+      std::move(sharedCAS), std::move(*actionCache), codeGenConfig);
+}
+
+Expected<CacheKey> CASObjectCache::computeKey(const Module *m) {
+  // The bitcode covers everything the IR contributes to code generation,
+  // including the target triple and data layout; the configuration string
+  // accounts for the rest. Ingesting the serialized module into the CAS
+  // both hashes it and makes the key self-describing.
+  llvm::SmallString<0> keyData;
+  llvm::raw_svector_ostream os(keyData);
+  llvm::WriteBitcodeToFile(*m, os);
+  os << codeGenConfig;
+  Expected<ObjectRef> keyRef = cas->storeFromString({}, keyData);
+  if (!keyRef)
+    return keyRef.takeError();
+  return CacheKey(*cas, *keyRef);
+}
+
+void CASObjectCache::notifyObjectCompiled(const Module *m,
+                                          MemoryBufferRef objBuffer) {
+  Expected<CacheKey> key = computeKey(m);
+  if (!key)
+    return reportCacheError(key.takeError(), "cannot compute key");
+  Expected<ObjectRef> object = cas->storeFromString({}, objBuffer.getBuffer());
+  if (!object)
+    return reportCacheError(object.takeError(), "cannot store object");
+  if (llvm::Error err = actionCache->put(*key, *object))
+    return reportCacheError(std::move(err), "cannot cache object");
+  LLVM_DEBUG(dbgs() << "Stored object for " << m->getModuleIdentifier()
+                    << " in the CAS.\n");
+}
+
+std::unique_ptr<MemoryBuffer> CASObjectCache::getObject(const Module *m) {
+  Expected<CacheKey> key = computeKey(m);
+  if (!key) {
+    reportCacheError(key.takeError(), "cannot compute key");
+    return nullptr;
+  }
+  Expected<llvm::Optional<ObjectRef>> object = actionCache->get(*key);
+  if (!object) {
+    reportCacheError(object.takeError(), "cannot query cache");
+    return nullptr;
+  }
+  if (!*object) {
+    LLVM_DEBUG(dbgs() << "No object for " << m->getModuleIdentifier()
+                      << " in cache. Compiling.\n");
+    return nullptr;
+  }
+  Expected<ObjectProxy> proxy = cas->getProxy(**object);
+  if (!proxy) {
+    reportCacheError(proxy.takeError(), "cannot load object");
+    return nullptr;
+  }
+  LLVM_DEBUG(dbgs() << "Object for " << m->getModuleIdentifier()
+                    << " loaded from the CAS.\n");
+  // The buffer aliases CAS-owned memory (mapped from disk for on-disk
+  // stores); this cache keeps the store alive for the engine's lifetime.
+  return proxy->getMemoryBuffer(m->getModuleIdentifier(),
+                                /*RequiresNullTerminator=*/false);
+}
@@ -307,8 +307,10 @@ ExecutionEngine::create(ModuleOp m, const ExecutionEngineOptions &options) {
     auto tm = jtmb.createTargetMachine();
     if (!tm)
       return tm.takeError();
+    llvm::ObjectCache *objectCache =
+        options.objectCache ? options.objectCache : engine->cache.get();
     return std::make_unique<TMOwningSimpleCompiler>(std::move(*tm),
-                                                    engine->cache.get());
+                                                    objectCache);
   };
 
   // Create the LLJIT by calling the LLJITBuilder with 2 callbacks.
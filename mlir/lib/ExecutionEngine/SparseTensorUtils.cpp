@@ -180,6 +180,8 @@ public:
     // TODO: we may want to cache an `isSorted` bit, to avoid
     // unnecessary/redundant sorting.
     uint64_t rank = getRank();
+    if (radixSort())
+      return;
     std::sort(elements.begin(), elements.end(),
               [rank](const Element<V> &e1, const Element<V> &e2) {
                 for (uint64_t r = 0; r < rank; r++) {
@@ -234,6 +236,53 @@ public:
   }
 
 private:
+  /// Attempts to sort the elements with a stable LSD radix sort over the
+  /// index tuples, one byte per pass.  The counting-sort passes replace the
+  /// rank-deep branchy comparator of `std::sort` with straight-line loops
+  /// over the element array, which makes a big difference when converting
+  /// large tensors between formats.  Passes over index bytes that are zero
+  /// or identical throughout are skipped, so the number of passes adapts to
+  /// the actual magnitude of the indices rather than to the full 64 bits.
+  /// Returns false (leaving the elements untouched) when the element count
+  /// is too small for the setup cost to pay off.
+  bool radixSort() {
+    static constexpr uint64_t kMinRadixSortElements = 1024;
+    const uint64_t n = elements.size();
+    if (n < kMinRadixSortElements)
+      return false;
+    std::vector<Element<V>> buffer(n, elements[0]);
+    Element<V> *src = elements.data();
+    Element<V> *dst = buffer.data();
+    // Lexicographic order: radix-sort from the last dimension to the first,
+    // relying on the stability of the counting-sort passes.
+    for (uint64_t r = getRank(); r-- > 0;) {
+      // OR-ing the indices of this dimension together identifies the bytes
+      // in which any two of them can possibly differ.
+      uint64_t bitsInUse = 0;
+      for (uint64_t i = 0; i < n; i++)
+        bitsInUse |= src[i].indices[r];
+      for (uint64_t shift = 0; bitsInUse >> shift; shift += 8) {
+        if (((bitsInUse >> shift) & 0xFF) == 0)
+          continue; // all elements agree on this byte
+        uint64_t count[256] = {0};
+        for (uint64_t i = 0; i < n; i++)
+          ++count[(src[i].indices[r] >> shift) & 0xFF];
+        uint64_t pos = 0;
+        for (uint64_t b = 0; b < 256; b++) {
+          uint64_t c = count[b];
+          count[b] = pos;
+          pos += c;
+        }
+        for (uint64_t i = 0; i < n; i++)
+          dst[count[(src[i].indices[r] >> shift) & 0xFF]++] = src[i];
+        std::swap(src, dst);
+      }
+    }
+    if (src != elements.data())
+      std::copy(src, src + n, elements.data());
+    return true;
+  }
+
   const std::vector<uint64_t> dimSizes; // per-dimension sizes
   std::vector<Element<V>> elements;     // all COO elements
   std::vector<uint64_t> indices;        // shared index pool
@@ -108,6 +108,28 @@ void PatternApplicator::applyCostModel(CostModel model) {
   for (auto &it : patterns)
     processPatternList(it.second);
   processPatternList(anyOpPatterns);
+
+  // Fuse the operation agnostic patterns into each operation specific list
+  // ahead of time, so that matchAndRewrite does not have to merge the two
+  // lists by benefit for every operation it visits. The merge mirrors the
+  // per-operation selection order: operation specific patterns are preferred
+  // when benefits are equal.
+  for (auto &it : patterns) {
+    SmallVector<const RewritePattern *, 2> &list = it.second;
+    SmallVector<const RewritePattern *, 2> fused;
+    fused.reserve(list.size() + anyOpPatterns.size());
+    unsigned opIt = 0, opE = list.size();
+    unsigned anyIt = 0, anyE = anyOpPatterns.size();
+    while (opIt != opE || anyIt != anyE) {
+      if (anyIt != anyE &&
+          (opIt == opE ||
+           list[opIt]->getBenefit() < anyOpPatterns[anyIt]->getBenefit()))
+        fused.push_back(anyOpPatterns[anyIt++]);
+      else
+        fused.push_back(list[opIt++]);
+    }
+    list = std::move(fused);
+  }
 }
 
 void PatternApplicator::walkAllPatterns(
@@ -137,15 +159,15 @@ LogicalResult PatternApplicator::matchAndRewrite(
     bytecode->match(op, rewriter, pdlMatches, *mutableByteCodeState);
 
   // Check to see if there are patterns matching this specific operation type.
-  MutableArrayRef<const RewritePattern *> opPatterns;
+  // The lists in `patterns` already have the operation agnostic patterns fused
+  // in, so on a hit those do not need to be considered separately.
+  MutableArrayRef<const RewritePattern *> opPatterns = anyOpPatterns;
   auto patternIt = patterns.find(op->getName());
   if (patternIt != patterns.end())
     opPatterns = patternIt->second;
 
-  // Process the patterns for that match the specific operation type, and any
-  // operation type in an interleaved fashion.
+  // Process the native patterns and the PDL matches in an interleaved fashion.
   unsigned opIt = 0, opE = opPatterns.size();
-  unsigned anyIt = 0, anyE = anyOpPatterns.size();
   unsigned pdlIt = 0, pdlE = pdlMatches.size();
   LogicalResult result = failure();
   do {
@@ -154,16 +176,9 @@ LogicalResult PatternApplicator::matchAndRewrite(
     unsigned *bestPatternIt = &opIt;
     const PDLByteCode::MatchResult *pdlMatch = nullptr;
 
-    /// Operation specific patterns.
+    /// Native patterns.
     if (opIt < opE)
       bestPattern = opPatterns[opIt];
-    /// Operation agnostic patterns.
-    if (anyIt < anyE &&
-        (!bestPattern ||
-         bestPattern->getBenefit() < anyOpPatterns[anyIt]->getBenefit())) {
-      bestPatternIt = &anyIt;
-      bestPattern = anyOpPatterns[anyIt];
-    }
     /// PDL patterns.
     if (pdlIt < pdlE && (!bestPattern || bestPattern->getBenefit() <
                                              pdlMatches[pdlIt].benefit)) {
@@ -115,9 +115,11 @@ public:
 #if LLVM_ENABLE_THREADS != 0
   /// Initialize the storage uniquer with a given number of storage shards to
   /// use. The provided shard number is required to be a valid power of 2. The
-  /// destructor function is used to destroy any allocated storage instances.
+  /// default is sized for wide pass managers; shards are lazily initialized,
+  /// so unused shards only cost an atomic pointer each. The destructor
+  /// function is used to destroy any allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 8)
+                           size_t numShards = 64)
       : shards(new std::atomic<Shard *>[numShards]), numShards(numShards),
         destructorFn(destructorFn) {
     assert(llvm::isPowerOf2_64(numShards) &&
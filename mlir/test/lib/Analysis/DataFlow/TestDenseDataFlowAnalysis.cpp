@@ -232,10 +232,16 @@ struct TestLastModifiedPass
 
   StringRef getArgument() const override { return "test-last-modified"; }
 
+  Option<bool> shardRegions{
+      *this, "shard-regions",
+      llvm::cl::desc("Shard the solver worklist per isolated region and run "
+                     "the shards in parallel"),
+      llvm::cl::init(false)};
+
   void runOnOperation() override {
     Operation *op = getOperation();
 
-    DataFlowSolver solver;
+    DataFlowSolver solver(/*enableRegionSharding=*/shardRegions);
     solver.load<DeadCodeAnalysis>();
     solver.load<SparseConstantPropagation>();
     solver.load<LastModifiedAnalysis>();
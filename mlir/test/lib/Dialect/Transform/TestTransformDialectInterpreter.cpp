@@ -12,6 +12,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Dialect/Transform/IR/TransformInterfaces.h"
+#include "mlir/Dialect/Transform/IR/TransformOps.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/Pass/Pass.h"
 
@@ -41,10 +42,20 @@ public:
 
   void runOnOperation() override {
     ModuleOp module = getOperation();
-    transform::TransformState state(
-        module.getBodyRegion(), module,
-        transform::TransformOptions().enableExpensiveChecks(
-            enableExpensiveChecks));
+    transform::TransformOptions options;
+    options.enableExpensiveChecks(enableExpensiveChecks);
+
+    if (precompile) {
+      FailureOr<transform::PrecompiledTransformScript> script =
+          transform::PrecompiledTransformScript::compile(
+              module.getBodyRegion());
+      if (failed(script) ||
+          failed(script->apply(module, options).checkAndReport()))
+        return signalPassFailure();
+      return;
+    }
+
+    transform::TransformState state(module.getBodyRegion(), module, options);
     for (auto op :
          module.getBody()->getOps<transform::TransformOpInterface>()) {
       if (failed(state.applyTransform(op).checkAndReport()))
@@ -56,6 +67,11 @@ public:
       *this, "enable-expensive-checks", llvm::cl::init(false),
       llvm::cl::desc("perform expensive checks to better report errors in the "
                      "transform IR")};
+
+  Option<bool> precompile{
+      *this, "precompile", llvm::cl::init(false),
+      llvm::cl::desc("lower the transform ops to a precompiled script and "
+                     "apply it instead of interpreting op by op")};
 };
 } // namespace
 
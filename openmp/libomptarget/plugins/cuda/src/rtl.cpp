@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <cuda.h>
 #include <list>
 #include <memory>
@@ -322,6 +323,62 @@ public:
   }
 };
 
+/// Per-device pinned host staging slots used to pipeline large host-to-device
+/// copies of pageable memory. A pageable source forces the driver to stage the
+/// copy internally and block the calling thread, serializing the transfer with
+/// any compute already enqueued on the stream. Instead, large submissions are
+/// chunked through two pinned slots: while the DMA engine drains one slot, the
+/// host memcpys the next chunk into the other, so staging and DMA overlap and
+/// the copies stay fully asynchronous with respect to kernel launches.
+struct PinnedStagingTy {
+  static constexpr const int NumSlots = 2;
+
+  /// Pinned host buffer backing each slot, allocated lazily on first use.
+  void *SlotPtr[NumSlots] = {};
+  /// Event recorded after the DMA reading each slot; synchronizing on it
+  /// guarantees the slot can be overwritten. Synchronizing on a never-recorded
+  /// event succeeds immediately, so fresh slots need no special casing.
+  CUevent SlotEvent[NumSlots] = {};
+  /// Set when lazy allocation failed so we do not retry on every transfer.
+  bool AllocFailed = false;
+  /// Serializes use of the slots. Contending threads fall back to a direct
+  /// copy instead of waiting.
+  std::mutex Mutex;
+
+  /// Allocate the slots on first use. Returns false if staging is unusable.
+  /// The caller must hold \p Mutex and have made the device context current.
+  bool ready(size_t SlotSize) {
+    if (AllocFailed)
+      return false;
+    if (SlotPtr[NumSlots - 1])
+      return true;
+    for (int I = 0; I < NumSlots; ++I) {
+      if (!checkResult(cuMemAllocHost(&SlotPtr[I], SlotSize),
+                       "Error returned from cuMemAllocHost\n") ||
+          !checkResult(cuEventCreate(&SlotEvent[I], CU_EVENT_DEFAULT),
+                       "Error returned from cuEventCreate\n")) {
+        AllocFailed = true;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Release the slots. The device context must be current.
+  void clear() {
+    for (int I = 0; I < NumSlots; ++I) {
+      if (SlotPtr[I])
+        (void)checkResult(cuMemFreeHost(SlotPtr[I]),
+                          "Error returned from cuMemFreeHost\n");
+      if (SlotEvent[I])
+        (void)checkResult(cuEventDestroy(SlotEvent[I]),
+                          "Error returned from cuEventDestroy\n");
+      SlotPtr[I] = nullptr;
+      SlotEvent[I] = nullptr;
+    }
+  }
+};
+
 } // namespace
 
 class DeviceRTLTy {
@@ -341,6 +398,11 @@ class DeviceRTLTy {
   /// Number of initial events for each device.
   int NumInitialEvents = 8;
 
+  /// Size in bytes of each pinned staging slot. Host-to-device submissions
+  /// larger than a slot are pipelined through the slots in dataSubmit();
+  /// smaller ones are issued directly. Zero disables staging entirely.
+  size_t PinnedStagingSlotSize = 1 << 22;
+
   static constexpr const int32_t HardThreadLimit = 1024;
   static constexpr const int32_t DefaultNumTeams = 128;
   static constexpr const int32_t DefaultNumThreads = 128;
@@ -351,6 +413,9 @@ class DeviceRTLTy {
   using EventPoolTy = ResourcePoolTy<EventAllocatorTy>;
   std::vector<std::unique_ptr<EventPoolTy>> EventPool;
 
+  /// Pinned staging slots for each device, see PinnedStagingTy.
+  std::vector<std::unique_ptr<PinnedStagingTy>> PinnedStaging;
+
   std::vector<DeviceDataTy> DeviceData;
   std::vector<std::vector<CUmodule>> Modules;
 
@@ -524,6 +589,8 @@ public:
     Modules.resize(NumberOfDevices);
     StreamPool.resize(NumberOfDevices);
     EventPool.resize(NumberOfDevices);
+    for (int I = 0; I < NumberOfDevices; ++I)
+      PinnedStaging.emplace_back(std::make_unique<PinnedStagingTy>());
     PeerAccessMatrix.resize(NumberOfDevices);
     for (auto &V : PeerAccessMatrix)
       V.resize(NumberOfDevices, PeerAccessState::Unkown);
@@ -555,6 +622,12 @@ public:
       NumInitialStreams = std::stoi(EnvStr);
       DP("Parsed LIBOMPTARGET_NUM_INITIAL_STREAMS=%d\n", NumInitialStreams);
     }
+    if (const char *EnvStr = getenv("LIBOMPTARGET_CUDA_PINNED_STAGING_SIZE")) {
+      // LIBOMPTARGET_CUDA_PINNED_STAGING_SIZE has been set
+      PinnedStagingSlotSize = std::stoul(EnvStr);
+      DP("Parsed LIBOMPTARGET_CUDA_PINNED_STAGING_SIZE=%zu\n",
+         PinnedStagingSlotSize);
+    }
 
     for (int I = 0; I < NumberOfDevices; ++I)
       DeviceAllocators.emplace_back();
@@ -776,6 +849,9 @@ public:
                      "Error returned from cuCtxSetCurrent\n"))
       return OFFLOAD_FAIL;
 
+    // Release the pinned staging slots.
+    PinnedStaging[DeviceId]->clear();
+
     // Unload all modules.
     for (auto &M : Modules[DeviceId])
       if (!checkResult(cuModuleUnload(M),
@@ -992,6 +1068,48 @@ public:
     assert(AsyncInfo && "AsyncInfo is nullptr");
 
     CUstream Stream = getStream(DeviceId, AsyncInfo);
+
+    // Pipeline large submissions through the pinned staging slots so the
+    // transfer stays asynchronous even for pageable host memory and host
+    // staging overlaps with in-flight DMA. If another thread holds the slots,
+    // or they cannot be allocated, fall back to the direct copy below.
+    if (PinnedStagingSlotSize && (uint64_t)Size > PinnedStagingSlotSize) {
+      PinnedStagingTy &Staging = *PinnedStaging[DeviceId];
+      std::unique_lock<std::mutex> UL(Staging.Mutex, std::try_to_lock);
+      if (UL.owns_lock() && Staging.ready(PinnedStagingSlotSize)) {
+        const char *Src = static_cast<const char *>(HstPtr);
+        CUdeviceptr Dst = (CUdeviceptr)TgtPtr;
+        int64_t Left = Size;
+        int Slot = 0;
+        while (Left > 0) {
+          int64_t Chunk = std::min<int64_t>(Left, PinnedStagingSlotSize);
+          // Make sure the previous DMA out of this slot has finished before
+          // overwriting it. This only blocks the host, not the stream.
+          if (!checkResult(cuEventSynchronize(Staging.SlotEvent[Slot]),
+                           "Error returned from cuEventSynchronize\n"))
+            return OFFLOAD_FAIL;
+          memcpy(Staging.SlotPtr[Slot], Src, Chunk);
+          CUresult Err =
+              cuMemcpyHtoDAsync(Dst, Staging.SlotPtr[Slot], Chunk, Stream);
+          if (Err != CUDA_SUCCESS) {
+            DP("Error when copying data from host to device. Pointers: host "
+               "= " DPxMOD ", device = " DPxMOD ", size = %" PRId64 "\n",
+               DPxPTR(Src), DPxPTR(Dst), Chunk);
+            CUDA_ERR_STRING(Err);
+            return OFFLOAD_FAIL;
+          }
+          if (!checkResult(cuEventRecord(Staging.SlotEvent[Slot], Stream),
+                           "Error returned from cuEventRecord\n"))
+            return OFFLOAD_FAIL;
+          Src += Chunk;
+          Dst += Chunk;
+          Left -= Chunk;
+          Slot = (Slot + 1) % PinnedStagingTy::NumSlots;
+        }
+        return OFFLOAD_SUCCESS;
+      }
+    }
+
     CUresult Err = cuMemcpyHtoDAsync((CUdeviceptr)TgtPtr, HstPtr, Size, Stream);
     if (Err != CUDA_SUCCESS) {
       DP("Error when copying data from host to device. Pointers: host "
@@ -2261,6 +2261,12 @@ typedef enum kmp_tasking_mode {
 extern kmp_tasking_mode_t
     __kmp_tasking_mode; /* determines how/when to execute tasks */
 extern int __kmp_task_stealing_constraint;
+// Victim selection used when stealing tasks, set via KMP_TASK_STEALING.
+typedef enum kmp_task_stealing_t {
+  task_stealing_random = 0, // pick victims uniformly at random (default)
+  task_stealing_nearest = 1 // prefer victims from this thread's socket domain
+} kmp_task_stealing_t;
+extern kmp_task_stealing_t __kmp_task_stealing_policy;
 extern int __kmp_enable_task_throttling;
 extern kmp_int32 __kmp_default_device; // Set via OMP_DEFAULT_DEVICE if
 // specified, defaults to 0 otherwise
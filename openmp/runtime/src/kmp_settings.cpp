@@ -1331,6 +1331,26 @@ static void __kmp_stg_print_task_stealing(kmp_str_buf_t *buffer,
   __kmp_stg_print_int(buffer, name, __kmp_task_stealing_constraint);
 } // __kmp_stg_print_task_stealing
 
+static void __kmp_stg_parse_task_stealing_policy(char const *name,
+                                                 char const *value,
+                                                 void *data) {
+  if (__kmp_str_match("random", 1, value)) {
+    __kmp_task_stealing_policy = task_stealing_random;
+  } else if (__kmp_str_match("nearest", 1, value)) {
+    __kmp_task_stealing_policy = task_stealing_nearest;
+  } else {
+    KMP_WARNING(StgInvalidValue, name, value);
+  }
+} // __kmp_stg_parse_task_stealing_policy
+
+static void __kmp_stg_print_task_stealing_policy(kmp_str_buf_t *buffer,
+                                                 char const *name, void *data) {
+  __kmp_stg_print_str(buffer, name,
+                      (__kmp_task_stealing_policy == task_stealing_nearest)
+                          ? "nearest"
+                          : "random");
+} // __kmp_stg_print_task_stealing_policy
+
 static void __kmp_stg_parse_max_active_levels(char const *name,
                                               char const *value, void *data) {
   kmp_uint64 tmp_dflt = 0;
@@ -5362,6 +5382,8 @@ static kmp_setting_t __kmp_stg_table[] = {
      0},
     {"KMP_TASK_STEALING_CONSTRAINT", __kmp_stg_parse_task_stealing,
      __kmp_stg_print_task_stealing, NULL, 0, 0},
+    {"KMP_TASK_STEALING", __kmp_stg_parse_task_stealing_policy,
+     __kmp_stg_print_task_stealing_policy, NULL, 0, 0},
     {"OMP_MAX_ACTIVE_LEVELS", __kmp_stg_parse_max_active_levels,
      __kmp_stg_print_max_active_levels, NULL, 0, 0},
     {"OMP_DEFAULT_DEVICE", __kmp_stg_parse_default_device,
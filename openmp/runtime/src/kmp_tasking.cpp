@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "kmp.h"
+#include "kmp_affinity.h"
 #include "kmp_i18n.h"
 #include "kmp_itt.h"
 #include "kmp_stats.h"
@@ -3147,6 +3148,28 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
 //
 // final_spin is TRUE if this is the spin at the release barrier.
 // thread_finished indicates whether the thread is finished executing all
+#if KMP_AFFINITY_SUPPORTED
+// __kmp_task_steal_domain: map a thread to the socket-level domain used by
+// KMP_TASK_STEALING=nearest victim selection. Places are created in topology
+// order, so dividing the place list evenly by the number of sockets
+// approximates the socket each bound thread runs on. Returns -1 when the
+// thread is unbound or no multi-socket topology information is available, in
+// which case victim selection falls back to uniform random.
+static kmp_int32 __kmp_task_steal_domain(kmp_info_t *thr) {
+  int place = thr->th.th_current_place;
+  if (place < 0 || __kmp_topology == NULL || __kmp_affinity_num_masks == 0)
+    return -1;
+  int socket_level = __kmp_topology->get_level(KMP_HW_SOCKET);
+  if (socket_level < 0)
+    return -1;
+  int nsockets = __kmp_topology->get_count(socket_level);
+  if (nsockets <= 1)
+    return -1;
+  return (kmp_int32)(((kmp_uint64)place * nsockets) /
+                     __kmp_affinity_num_masks);
+}
+#endif // KMP_AFFINITY_SUPPORTED
+
 // the tasks it has on its deque, and is at the release barrier.
 // spinner is the location on which to spin.
 // spinner == NULL means only execute a single task and return.
@@ -3210,6 +3233,12 @@ static inline int __kmp_execute_tasks_template(
           asleep = 0;
         } else if (!new_victim) { // no recent steals and we haven't already
           // used a new victim; select a random thread
+#if KMP_AFFINITY_SUPPORTED
+          kmp_int32 my_domain = -1;
+          kmp_int32 near_tries = 0;
+          if (__kmp_task_stealing_policy == task_stealing_nearest)
+            my_domain = __kmp_task_steal_domain(thread);
+#endif
           do { // Find a different thread to steal work from.
             // Pick a random thread. Initial plan was to cycle through all the
             // threads, and only return if we tried to steal from every thread,
@@ -3220,6 +3249,18 @@ static inline int __kmp_execute_tasks_template(
             }
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
+#if KMP_AFFINITY_SUPPORTED
+            // Under KMP_TASK_STEALING=nearest, re-pick a bounded number of
+            // times until the candidate shares this thread's socket domain.
+            // Cross-domain victims are still accepted once the tries are
+            // exhausted, so remote tasks never become unreachable.
+            if (my_domain >= 0 && near_tries < nthreads &&
+                __kmp_task_steal_domain(other_thread) != my_domain) {
+              ++near_tries;
+              asleep = 1; // retry with a different victim
+              continue;
+            }
+#endif
             // There is a slight chance that __kmp_enable_tasking() did not wake
             // up all threads waiting at the barrier.  If victim is sleeping,
             // then wake it up. Since we were going to pay the cache miss
@@ -52,6 +52,7 @@
 #include "polly/MatmulOptimizer.h"
 #include "polly/Options.h"
 #include "polly/ScheduleTreeTransform.h"
+#include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
@@ -107,6 +108,12 @@ static cl::opt<std::string> OuterCoincidence(
              "satisfies the coincidence constraints (yes/no)"),
     cl::Hidden, cl::init("no"), cl::cat(PollyCategory));
 
+static cl::opt<int> ScheduleComputeOut(
+    "polly-schedule-computeout",
+    cl::desc("Bound the scheduler by a maximal amount of computational steps "
+             "(0 means no bound)"),
+    cl::Hidden, cl::init(300000), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<int> PrevectorWidth(
     "polly-prevect-width",
     cl::desc(
@@ -193,6 +200,8 @@ static cl::opt<bool> OptimizedScops(
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
+STATISTIC(ScheduleOutOfQuota,
+          "Schedules not computed because max_operations was reached");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
 STATISTIC(NumBoxedLoopsOptimized, "Number of boxed loops optimized");
@@ -865,7 +874,27 @@ static void runIslScheduleOptimizer(
     SC = SC.set_proximity(Proximity);
     SC = SC.set_validity(Validity);
     SC = SC.set_coincidence(Validity);
-    Schedule = SC.compute_schedule();
+
+    // Bound the time the scheduler spends in ISL. When the budget is
+    // exhausted, compute_schedule returns a null schedule and the SCoP is
+    // left with its original schedule, so a pathological loop nest only
+    // costs the budget instead of unbounded scheduler time.
+    {
+      IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+      Schedule = SC.compute_schedule();
+
+      if (MaxOpGuard.hasQuotaExceeded()) {
+        ScheduleOutOfQuota++;
+        LLVM_DEBUG(dbgs() << "Schedule computation exceeded max_operations\n");
+        DebugLoc Begin, End;
+        getDebugLocations(getBBPairForRegion(&S.getRegion()), Begin, End);
+        OptimizationRemarkAnalysis R(DEBUG_TYPE, "OutOfQuota", Begin,
+                                     S.getEntry());
+        R << "maximal number of operations exceeded during schedule "
+             "computation";
+        S.getFunction().getContext().diagnose(R);
+      }
+    }
     isl_options_set_on_error(Ctx, OnErrorStatus);
 
     ScopsRescheduled++;
@@ -0,0 +1,661 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _PSTL_PARALLEL_BACKEND_THREAD_H
+#define _PSTL_PARALLEL_BACKEND_THREAD_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pstl_config.h"
+#include "parallel_backend_utils.h"
+#include "utils.h"
+
+_PSTL_HIDE_FROM_ABI_PUSH
+
+namespace __pstl
+{
+namespace __std_thread_backend
+{
+
+//------------------------------------------------------------------------
+// use to cancel execution
+//------------------------------------------------------------------------
+inline void
+__cancel_execution()
+{
+    // TODO: Figure out how to make cancelation work.
+}
+
+//------------------------------------------------------------------------
+// raw buffer
+//------------------------------------------------------------------------
+
+template <typename _Tp>
+class __buffer
+{
+    std::allocator<_Tp> __allocator_;
+    _Tp* __ptr_;
+    const std::size_t __buf_size_;
+    __buffer(const __buffer&) = delete;
+    void
+    operator=(const __buffer&) = delete;
+
+  public:
+    __buffer(std::size_t __n) : __allocator_(), __ptr_(__allocator_.allocate(__n)), __buf_size_(__n) {}
+
+    operator bool() const { return __ptr_ != nullptr; }
+
+    _Tp*
+    get() const
+    {
+        return __ptr_;
+    }
+    ~__buffer() { __allocator_.deallocate(__ptr_, __buf_size_); }
+};
+
+// Preliminary size of each chunk: requires further discussion
+inline constexpr std::size_t __default_chunk_size = 2048;
+
+// Convenience function to determine when we should run serial.
+template <typename _Iterator, std::enable_if_t<!std::is_integral<_Iterator>::value, bool> = true>
+constexpr auto
+__should_run_serial(_Iterator __first, _Iterator __last) -> bool
+{
+    using _difference_type = typename std::iterator_traits<_Iterator>::difference_type;
+    auto __size = std::distance(__first, __last);
+    return __size <= static_cast<_difference_type>(__default_chunk_size);
+}
+
+template <typename _Index, std::enable_if_t<std::is_integral<_Index>::value, bool> = true>
+constexpr auto
+__should_run_serial(_Index __first, _Index __last) -> bool
+{
+    using _difference_type = _Index;
+    auto __size = __last - __first;
+    return __size <= static_cast<_difference_type>(__default_chunk_size);
+}
+
+struct __chunk_metrics
+{
+    std::size_t __n_chunks;
+    std::size_t __chunk_size;
+    std::size_t __first_chunk_size;
+};
+
+// The iteration space partitioner according to __requested_chunk_size
+template <class _RandomAccessIterator, class _Size = std::size_t>
+auto
+__chunk_partitioner(_RandomAccessIterator __first, _RandomAccessIterator __last,
+                    _Size __requested_chunk_size = __default_chunk_size) -> __chunk_metrics
+{
+    /*
+     * This algorithm improves distribution of elements in chunks by avoiding
+     * small tail chunks. The leftover elements that do not fit neatly into
+     * the chunk size are redistributed to early chunks. This improves
+     * utilization of the processor's prefetch and reduces the number of
+     * tasks needed by 1.
+     */
+
+    const _Size __n = __last - __first;
+    _Size __n_chunks = 0;
+    _Size __chunk_size = 0;
+    _Size __first_chunk_size = 0;
+    if (__n < __requested_chunk_size)
+    {
+        __chunk_size = __n;
+        __first_chunk_size = __n;
+        __n_chunks = 1;
+        return __chunk_metrics{__n_chunks, __chunk_size, __first_chunk_size};
+    }
+
+    __n_chunks = (__n / __requested_chunk_size) + 1;
+    __chunk_size = __n / __n_chunks;
+    __first_chunk_size = __chunk_size;
+    const _Size __n_leftover_items = __n - (__n_chunks * __chunk_size);
+
+    if (__n_leftover_items == __chunk_size)
+    {
+        __n_chunks += 1;
+        return __chunk_metrics{__n_chunks, __chunk_size, __first_chunk_size};
+    }
+    else if (__n_leftover_items == 0)
+    {
+        __first_chunk_size = __chunk_size;
+        return __chunk_metrics{__n_chunks, __chunk_size, __first_chunk_size};
+    }
+
+    const _Size __n_extra_items_per_chunk = __n_leftover_items / __n_chunks;
+    const _Size __n_final_leftover_items = __n_leftover_items - (__n_extra_items_per_chunk * __n_chunks);
+
+    __chunk_size += __n_extra_items_per_chunk;
+    __first_chunk_size = __chunk_size + __n_final_leftover_items;
+
+    return __chunk_metrics{__n_chunks, __chunk_size, __first_chunk_size};
+}
+
+template <typename _Iterator, typename _Index, typename _Func>
+void
+__process_chunk(const __chunk_metrics& __metrics, _Iterator __base, _Index __chunk_index, _Func __f)
+{
+    auto __this_chunk_size = __chunk_index == 0 ? __metrics.__first_chunk_size : __metrics.__chunk_size;
+    auto __index = __chunk_index == 0 ? 0
+                                      : (__chunk_index * __metrics.__chunk_size) +
+                                            (__metrics.__first_chunk_size - __metrics.__chunk_size);
+    auto __first = __base + __index;
+    auto __last = __first + __this_chunk_size;
+    __f(__first, __last);
+}
+
+//------------------------------------------------------------------------
+// thread pool
+//
+// A single process-wide pool of std::threads, created lazily on the first
+// parallel call and joined on program exit. Tasks submitted from a pool
+// worker run inline in the submitter, so a worker never blocks waiting on
+// the pool and nested parallelism cannot deadlock. Exceptions escaping a
+// task terminate the program, matching the semantics of the parallel
+// execution policies.
+//------------------------------------------------------------------------
+
+class __thread_pool
+{
+  public:
+    static __thread_pool&
+    __instance()
+    {
+        static __thread_pool __pool;
+        return __pool;
+    }
+
+    static bool
+    __on_worker_thread()
+    {
+        return __worker_flag();
+    }
+
+    // Number of threads a parallel region can occupy: the workers plus the
+    // thread that submitted the work and waits for it.
+    std::size_t
+    __concurrency() const
+    {
+        return __n_workers_ + 1;
+    }
+
+    void
+    __submit(std::function<void()> __task)
+    {
+        {
+            std::lock_guard<std::mutex> __lock(__mutex_);
+            __tasks_.push_back(std::move(__task));
+        }
+        __cv_.notify_one();
+    }
+
+    // Pop and execute one queued task. Used by waiting threads to help the
+    // workers along; on a single-core machine the pool has no workers at all
+    // and the submitter runs everything through this path.
+    bool
+    __try_run_one()
+    {
+        std::function<void()> __task;
+        {
+            std::lock_guard<std::mutex> __lock(__mutex_);
+            if (__tasks_.empty())
+                return false;
+            __task = std::move(__tasks_.front());
+            __tasks_.pop_front();
+        }
+        __task();
+        return true;
+    }
+
+  private:
+    __thread_pool()
+    {
+        const unsigned __hw = std::thread::hardware_concurrency();
+        __n_workers_ = __hw > 1 ? __hw - 1 : 0;
+        __threads_.reserve(__n_workers_);
+        for (std::size_t __i = 0; __i < __n_workers_; ++__i)
+        {
+            __threads_.emplace_back(
+                [this]
+                {
+                    __worker_flag() = true;
+                    __work_loop();
+                });
+        }
+    }
+
+    ~__thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> __lock(__mutex_);
+            __done_ = true;
+        }
+        __cv_.notify_all();
+        for (auto& __worker : __threads_)
+            __worker.join();
+    }
+
+    static bool&
+    __worker_flag()
+    {
+        static thread_local bool __is_worker = false;
+        return __is_worker;
+    }
+
+    void
+    __work_loop()
+    {
+        for (;;)
+        {
+            std::unique_lock<std::mutex> __lock(__mutex_);
+            __cv_.wait(__lock, [this] { return __done_ || !__tasks_.empty(); });
+            if (__tasks_.empty())
+                return; // __done_ and the queue is drained
+            auto __task = std::move(__tasks_.front());
+            __tasks_.pop_front();
+            __lock.unlock();
+            __task();
+        }
+    }
+
+    std::vector<std::thread> __threads_;
+    std::deque<std::function<void()>> __tasks_;
+    std::mutex __mutex_;
+    std::condition_variable __cv_;
+    std::size_t __n_workers_ = 0;
+    bool __done_ = false;
+};
+
+// A fork-join scope: __run() hands a task to the pool (or runs it inline
+// when called from a pool worker), __wait() blocks until every task handed
+// out through this group has finished.
+class __task_group
+{
+  public:
+    template <typename _Fp>
+    void
+    __run(_Fp __f)
+    {
+        if (__thread_pool::__on_worker_thread())
+        {
+            __f();
+            return;
+        }
+        __pending_.fetch_add(1, std::memory_order_relaxed);
+        __thread_pool::__instance().__submit(
+            [this, __f]() mutable
+            {
+                __f();
+                if (__pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    std::lock_guard<std::mutex> __lock(__mutex_);
+                    __cv_.notify_one();
+                }
+            });
+    }
+
+    void
+    __wait()
+    {
+        // Work on queued tasks (not necessarily this group's) while waiting,
+        // and only block once the queue is drained; the remaining tasks are
+        // then running on workers, which notify on the last completion.
+        auto& __pool = __thread_pool::__instance();
+        while (__pending_.load(std::memory_order_acquire) != 0)
+        {
+            if (__pool.__try_run_one())
+                continue;
+            std::unique_lock<std::mutex> __lock(__mutex_);
+            __cv_.wait(__lock, [this] { return __pending_.load(std::memory_order_acquire) == 0; });
+        }
+    }
+
+  private:
+    std::atomic<std::size_t> __pending_{0};
+    std::mutex __mutex_;
+    std::condition_variable __cv_;
+};
+
+//------------------------------------------------------------------------
+// parallel_for
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, class _Index, class _Fp>
+void
+__parallel_for(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __first, _Index __last,
+               _Fp __f)
+{
+    if (__std_thread_backend::__should_run_serial(__first, __last))
+    {
+        __f(__first, __last);
+        return;
+    }
+
+    auto __policy = __std_thread_backend::__chunk_partitioner(__first, __last);
+    __task_group __group;
+    for (std::size_t __chunk = 0; __chunk < __policy.__n_chunks; ++__chunk)
+    {
+        __group.__run([__policy, __first, __chunk, __f]
+                      { __std_thread_backend::__process_chunk(__policy, __first, __chunk, __f); });
+    }
+    __group.__wait();
+}
+
+//------------------------------------------------------------------------
+// parallel_reduce
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, class _Value, class _Index, typename _RealBody, typename _Reduction>
+_Value
+__parallel_reduce(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __first, _Index __last,
+                  const _Value& __identity, const _RealBody& __real_body, const _Reduction& __reduction)
+{
+    if (__first == __last)
+        return __identity;
+    if (__std_thread_backend::__should_run_serial(__first, __last))
+        return __real_body(__first, __last, __identity);
+
+    auto __policy = __std_thread_backend::__chunk_partitioner(__first, __last);
+    std::vector<_Value> __partials(__policy.__n_chunks, __identity);
+    __task_group __group;
+    for (std::size_t __chunk = 0; __chunk < __policy.__n_chunks; ++__chunk)
+    {
+        __group.__run(
+            [__policy, __first, __chunk, &__partials, &__identity, &__real_body]
+            {
+                __std_thread_backend::__process_chunk(__policy, __first, __chunk,
+                                                      [&](auto __chunk_first, auto __chunk_last) {
+                                                          __partials[__chunk] =
+                                                              __real_body(__chunk_first, __chunk_last, __identity);
+                                                      });
+            });
+    }
+    __group.__wait();
+
+    _Value __result = __partials[0];
+    for (std::size_t __i = 1; __i < __partials.size(); ++__i)
+        __result = __reduction(__result, __partials[__i]);
+    return __result;
+}
+
+//------------------------------------------------------------------------
+// parallel_transform_reduce
+//
+// Notation:
+//      r(i,j,init) returns reduction of init with reduction over [i,j)
+//      u(i) returns f(i,i+1,identity) for a hypothetical left identity element
+//      of r c(x,y) combines values x and y that were the result of r or u
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, class _Index, class _UnaryOp, class _Tp, class _BinaryOp, class _Reduce>
+_Tp
+__parallel_transform_reduce(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __first,
+                            _Index __last, _UnaryOp __unary_op, _Tp __init, _BinaryOp __combiner, _Reduce __reduce)
+{
+    if (__std_thread_backend::__should_run_serial(__first, __last))
+        return __reduce(__first, __last, __init);
+
+    // Each chunk seeds its accumulator with u() of its first element, so no
+    // identity element of the combiner is needed.
+    auto __policy = __std_thread_backend::__chunk_partitioner(__first, __last);
+    std::vector<_Tp> __partials(__policy.__n_chunks, __init);
+    __task_group __group;
+    for (std::size_t __chunk = 0; __chunk < __policy.__n_chunks; ++__chunk)
+    {
+        __group.__run(
+            [__policy, __first, __chunk, &__partials, &__unary_op, &__reduce]
+            {
+                __std_thread_backend::__process_chunk(
+                    __policy, __first, __chunk, [&](auto __chunk_first, auto __chunk_last)
+                    { __partials[__chunk] = __reduce(__chunk_first + 1, __chunk_last, __unary_op(__chunk_first)); });
+            });
+    }
+    __group.__wait();
+
+    _Tp __result = __init;
+    for (std::size_t __i = 0; __i < __partials.size(); ++__i)
+        __result = __combiner(__result, __partials[__i]);
+    return __result;
+}
+
+//------------------------------------------------------------------------
+// parallel_scan
+//
+// Classic two-pass scan: tile sums are reduced in parallel, combined in a
+// single serial pass over the (few) tiles, and the per-tile scans then run
+// in parallel with their exclusive prefixes.
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, typename _Index, typename _Tp, typename _Rp, typename _Cp, typename _Sp, typename _Ap>
+void
+__parallel_strict_scan(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __n, _Tp __initial,
+                       _Rp __reduce, _Cp __combine, _Sp __scan, _Ap __apex)
+{
+    if (__n <= static_cast<_Index>(__default_chunk_size))
+    {
+        _Tp __sum = __initial;
+        if (__n)
+            __sum = __combine(__sum, __reduce(_Index(0), __n));
+        __apex(__sum);
+        if (__n)
+            __scan(_Index(0), __n, __initial);
+        return;
+    }
+
+    const _Index __slack = 4;
+    const _Index __concurrency = static_cast<_Index>(__thread_pool::__instance().__concurrency());
+    _Index __tilesize = (__n - 1) / (__slack * __concurrency) + 1;
+    const _Index __m = (__n - 1) / __tilesize + 1; // number of tiles
+
+    __buffer<_Tp> __buf(__m);
+    _Tp* __r = __buf.get();
+
+    __task_group __upsweep;
+    for (_Index __i = 0; __i < __m; ++__i)
+    {
+        __upsweep.__run(
+            [__i, __m, __n, __tilesize, __r, &__reduce]
+            {
+                const _Index __size = __i == __m - 1 ? __n - __i * __tilesize : __tilesize;
+                ::new (__r + __i) _Tp(__reduce(__i * __tilesize, __size));
+            });
+    }
+    __upsweep.__wait();
+
+    // Turn the tile sums into exclusive prefixes of the initial value.
+    _Tp __sum = __initial;
+    for (_Index __i = 0; __i < __m; ++__i)
+    {
+        _Tp __next = __combine(__sum, __r[__i]);
+        __r[__i] = __sum;
+        __sum = std::move(__next);
+    }
+    __apex(__sum);
+
+    __task_group __downsweep;
+    for (_Index __i = 0; __i < __m; ++__i)
+    {
+        __downsweep.__run(
+            [__i, __m, __n, __tilesize, __r, &__scan]
+            {
+                const _Index __size = __i == __m - 1 ? __n - __i * __tilesize : __tilesize;
+                __scan(__i * __tilesize, __size, __r[__i]);
+            });
+    }
+    __downsweep.__wait();
+
+    __utils::__serial_destroy()(__r, __r + __m);
+}
+
+template <class _ExecutionPolicy, class _Index, class _UnaryOp, class _Tp, class _BinaryOp, class _Reduce, class _Scan>
+_Tp
+__parallel_transform_scan(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __n, _UnaryOp,
+                          _Tp __init, _BinaryOp, _Reduce, _Scan __scan)
+{
+    // TODO: parallelize this function.
+    return __scan(_Index(0), __n, __init);
+}
+
+//------------------------------------------------------------------------
+// parallel_stable_sort
+//
+// Sorted runs of __default_chunk_size elements are produced with the leaf
+// sort in parallel, then merged pairwise in parallel passes that ping-pong
+// between the input range and a temporary buffer.
+//------------------------------------------------------------------------
+
+template <typename _RandomAccessIterator1, typename _RandomAccessIterator2, typename _Compare>
+void
+__merge_sorted_runs(_RandomAccessIterator1 __src, _RandomAccessIterator2 __dst, std::size_t __n, std::size_t __width,
+                    _Compare __comp, __task_group& __group)
+{
+    for (std::size_t __offset = 0; __offset < __n; __offset += 2 * __width)
+    {
+        const std::size_t __mid = std::min(__offset + __width, __n);
+        const std::size_t __end = std::min(__offset + 2 * __width, __n);
+        __group.__run(
+            [__src, __dst, __offset, __mid, __end, __comp]
+            {
+                std::merge(std::make_move_iterator(__src + __offset), std::make_move_iterator(__src + __mid),
+                           std::make_move_iterator(__src + __mid), std::make_move_iterator(__src + __end),
+                           __dst + __offset, __comp);
+            });
+    }
+    __group.__wait();
+}
+
+template <class _ExecutionPolicy, typename _RandomAccessIterator, typename _Compare, typename _LeafSort>
+void
+__parallel_stable_sort(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _RandomAccessIterator __xs,
+                       _RandomAccessIterator __xe, _Compare __comp, _LeafSort __leaf_sort, std::size_t __nsort = 0)
+{
+    using _ValueType = typename std::iterator_traits<_RandomAccessIterator>::value_type;
+
+    const std::size_t __n = static_cast<std::size_t>(__xe - __xs);
+    // Partial sorts (0 < __nsort < __n) are rare enough that the leaf sort,
+    // which already handles them, is used directly.
+    if (__n <= 2 * __default_chunk_size || (__nsort != 0 && __nsort < __n))
+    {
+        __leaf_sort(__xs, __xe, __comp);
+        return;
+    }
+
+    __task_group __group;
+    for (std::size_t __offset = 0; __offset < __n; __offset += __default_chunk_size)
+    {
+        const std::size_t __end = std::min(__offset + __default_chunk_size, __n);
+        __group.__run([__xs, __offset, __end, __comp, __leaf_sort]
+                      { __leaf_sort(__xs + __offset, __xs + __end, __comp); });
+    }
+    __group.__wait();
+
+    std::vector<_ValueType> __scratch(__n);
+    bool __in_scratch = false;
+    for (std::size_t __width = __default_chunk_size; __width < __n; __width *= 2)
+    {
+        if (__in_scratch)
+            __std_thread_backend::__merge_sorted_runs(__scratch.begin(), __xs, __n, __width, __comp, __group);
+        else
+            __std_thread_backend::__merge_sorted_runs(__xs, __scratch.begin(), __n, __width, __comp, __group);
+        __in_scratch = !__in_scratch;
+    }
+
+    if (__in_scratch)
+    {
+        for (std::size_t __offset = 0; __offset < __n; __offset += __default_chunk_size)
+        {
+            const std::size_t __end = std::min(__offset + __default_chunk_size, __n);
+            __group.__run([&__scratch, __xs, __offset, __end]
+                          { std::move(__scratch.begin() + __offset, __scratch.begin() + __end, __xs + __offset); });
+        }
+        __group.__wait();
+    }
+}
+
+//------------------------------------------------------------------------
+// parallel_merge
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+          typename _RandomAccessIterator3, typename _Compare, typename _LeafMerge>
+void
+__parallel_merge(__pstl::__internal::__std_thread_backend_tag __tag, _ExecutionPolicy&& __exec,
+                 _RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2,
+                 _RandomAccessIterator2 __last2, _RandomAccessIterator3 __outit, _Compare __comp,
+                 _LeafMerge __leaf_merge)
+{
+    const std::size_t __size = (__last1 - __first1) + (__last2 - __first2);
+    if (__size <= 2 * __default_chunk_size)
+    {
+        __leaf_merge(__first1, __last1, __first2, __last2, __outit, __comp);
+        return;
+    }
+
+    // Split the larger sequence in half and the smaller one at the
+    // corresponding position, then merge the two halves independently.
+    _RandomAccessIterator1 __mid1;
+    _RandomAccessIterator2 __mid2;
+    if (__last1 - __first1 < __last2 - __first2)
+    {
+        __mid2 = __first2 + (__last2 - __first2) / 2;
+        __mid1 = std::upper_bound(__first1, __last1, *__mid2, __comp);
+    }
+    else
+    {
+        __mid1 = __first1 + (__last1 - __first1) / 2;
+        __mid2 = std::lower_bound(__first2, __last2, *__mid1, __comp);
+    }
+
+    __task_group __group;
+    __group.__run(
+        [=, &__exec]() mutable
+        {
+            __std_thread_backend::__parallel_merge(__tag, __exec, __first1, __mid1, __first2, __mid2, __outit, __comp,
+                                                   __leaf_merge);
+        });
+    _RandomAccessIterator3 __outmid = __outit + (__mid1 - __first1) + (__mid2 - __first2);
+    __std_thread_backend::__parallel_merge(__tag, std::forward<_ExecutionPolicy>(__exec), __mid1, __last1, __mid2,
+                                           __last2, __outmid, __comp, __leaf_merge);
+    __group.__wait();
+}
+
+//------------------------------------------------------------------------
+// parallel_invoke
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, typename _F1, typename _F2>
+void
+__parallel_invoke(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _F1&& __f1, _F2&& __f2)
+{
+    __task_group __group;
+    __group.__run(std::forward<_F1>(__f1));
+    std::forward<_F2>(__f2)();
+    __group.__wait();
+}
+
+} // namespace __std_thread_backend
+} // namespace __pstl
+
+_PSTL_HIDE_FROM_ABI_POP
+
+#endif /* _PSTL_PARALLEL_BACKEND_THREAD_H */